@@ -31,6 +31,9 @@
 #include "Osc.h"
 #include "cinder/Log.h"
 
+#include <algorithm>
+#include <map>
+
 using namespace std;
 using namespace asio;
 using namespace asio::ip;
@@ -1104,6 +1107,122 @@ void SenderTcp::closeImpl()
 	
 /////////////////////////////////////////////////////////////////////////////////////////
 //// ReceiverBase
+
+namespace {
+
+//! Refers to one '/' separated segment of an address without copying it.
+struct AddressSegment {
+	const char	*mData;
+	size_t		mLength;
+};
+
+//! Allows trie nodes keyed by std::string to be looked up with an AddressSegment.
+struct AddressSegmentLess {
+	using is_transparent = void;
+	
+	bool operator()( const std::string &lhs, const std::string &rhs ) const { return lhs < rhs; }
+	bool operator()( const std::string &lhs, const AddressSegment &rhs ) const { return lhs.compare( 0, std::string::npos, rhs.mData, rhs.mLength ) < 0; }
+	bool operator()( const AddressSegment &lhs, const std::string &rhs ) const { return rhs.compare( 0, std::string::npos, lhs.mData, lhs.mLength ) > 0; }
+};
+
+//! Returns whether the segment [begin, end) contains a character that patternMatch() treats as a wildcard.
+bool isPatternSegment( const char *begin, const char *end )
+{
+	return std::find_if( begin, end, []( char c ) {
+		return c == '?' || c == '*' || c == '[' || c == '{';
+	} ) != end;
+}
+	
+} // anonymous namespace
+
+//! Trie of listener addresses, split at '/'. A literal address is stored at the node of its last segment, so
+//! matching it only costs one lookup per segment of the incoming address. An address containing wildcards is
+//! stored at the node of its literal prefix and is tested with patternMatch() against every incoming address
+//! that passes through that node.
+class ReceiverBase::ListenerTable {
+  public:
+	ListenerTable( const Listeners &listeners );
+	
+	//! Fills \a result with the indices of the listeners whose address matches \a address, in the order they were set.
+	void				match( const ReceiverBase &receiver, const std::string &address, std::vector<size_t> &result ) const;
+	const ListenerFn&	getListenerFn( size_t index ) const		{ return mListeners[index].second; }
+	
+  private:
+	struct Node {
+		std::map<std::string, Node, AddressSegmentLess>	mChildren;
+		//! Index of the listener whose literal address ends at this node, or -1.
+		int												mLiteral = -1;
+		//! Indices of the listeners whose address has wildcards after this node's literal prefix.
+		std::vector<size_t>								mPatterns;
+	};
+	
+	Listeners	mListeners;
+	Node		mRoot;
+};
+
+ReceiverBase::ListenerTable::ListenerTable( const Listeners &listeners )
+: mListeners( listeners )
+{
+	for( size_t i = 0; i < mListeners.size(); i++ ) {
+		const auto &address = mListeners[i].first;
+		Node *node = &mRoot;
+		size_t segmentBegin = 0;
+		while( true ) {
+			size_t segmentEnd = address.find( '/', segmentBegin );
+			bool isLastSegment = segmentEnd == std::string::npos;
+			if( isLastSegment )
+				segmentEnd = address.size();
+			
+			if( isPatternSegment( address.data() + segmentBegin, address.data() + segmentEnd ) ) {
+				node->mPatterns.push_back( i );
+				break;
+			}
+			
+			node = &node->mChildren[address.substr( segmentBegin, segmentEnd - segmentBegin )];
+			if( isLastSegment ) {
+				node->mLiteral = (int)i;
+				break;
+			}
+			segmentBegin = segmentEnd + 1;
+		}
+	}
+}
+
+void ReceiverBase::ListenerTable::match( const ReceiverBase &receiver, const std::string &address, std::vector<size_t> &result ) const
+{
+	result.clear();
+	
+	const Node *node = &mRoot;
+	size_t segmentBegin = 0;
+	while( true ) {
+		// the address continues past this node's literal prefix, so wildcard listeners stored here may match it
+		for( size_t index : node->mPatterns ) {
+			if( receiver.patternMatch( address, mListeners[index].first ) )
+				result.push_back( index );
+		}
+		
+		size_t segmentEnd = address.find( '/', segmentBegin );
+		bool isLastSegment = segmentEnd == std::string::npos;
+		if( isLastSegment )
+			segmentEnd = address.size();
+		
+		auto child = node->mChildren.find( AddressSegment{ address.data() + segmentBegin, segmentEnd - segmentBegin } );
+		if( child == node->mChildren.end() )
+			break;
+		
+		node = &child->second;
+		if( isLastSegment ) {
+			if( node->mLiteral >= 0 )
+				result.push_back( (size_t)node->mLiteral );
+			break;
+		}
+		segmentBegin = segmentEnd + 1;
+	}
+	
+	// listeners are called in the order they were set, regardless of where they live in the trie
+	if( result.size() > 1 )
+		std::sort( result.begin(), result.end() );
+}
 	
 void ReceiverBase::setListener( const std::string &address, ListenerFn listener )
 {
@@ -1116,6 +1235,8 @@ void ReceiverBase::setListener( const std::string &address, ListenerFn listener
 		foundListener->second = listener;
 	else
 		mListeners.push_back( { address, listener } );
+	
+	updateListenerTable();
 }
 
 void ReceiverBase::removeListener( const std::string &address )
@@ -1125,8 +1246,19 @@ void ReceiverBase::removeListener( const std::string &address )
 	[address]( const std::pair<std::string, ListenerFn> &listener ) {
 		  return address == listener.first;
 	});
-	if( foundListener != mListeners.end() )
+	if( foundListener != mListeners.end() ) {
 		mListeners.erase( foundListener );
+		updateListenerTable();
+	}
+}
+	
+void ReceiverBase::updateListenerTable()
+{
+	// copy-on-write: dispatchMethods() keeps using the table it loaded until it is done with it
+	std::shared_ptr<const ListenerTable> listenerTable;
+	if( ! mListeners.empty() )
+		listenerTable = std::make_shared<ListenerTable>( mListeners );
+	std::atomic_store( &mListenerTable, listenerTable );
 }
 
 void ReceiverBase::dispatchMethods( uint8_t *data, uint32_t size, const asio::ip::address &senderIpAddress )
@@ -1136,19 +1268,19 @@ void ReceiverBase::dispatchMethods( uint8_t *data, uint32_t size, const asio::ip
 	if( messages.empty() )
 		return;
 	
-	std::lock_guard<std::mutex> lock( mListenerMutex );
+	auto listenerTable = std::atomic_load( &mListenerTable );
+	std::vector<size_t> matches;
 	// iterate through all the messages and find matches with registered methods
 	for( auto & message : messages ) {
-		bool dispatchedOnce = false;
 		auto &address = message.getAddress();
 		message.mSenderIpAddress = senderIpAddress;
-		for( auto & listener : mListeners ) {
-			if( patternMatch( address, listener.first ) ) {
-				listener.second( message );
-				dispatchedOnce = true;
-			}
+		if( listenerTable ) {
+			listenerTable->match( *this, address, matches );
+			for( size_t index : matches )
+				listenerTable->getListenerFn( index )( message );
 		}
-		if( ! dispatchedOnce ) {
+		if( ! listenerTable || matches.empty() ) {
+			std::lock_guard<std::mutex> lock( mDisregardedAddressesMutex );
 			if( mDisregardedAddresses.count( address ) == 0 ) {
 				mDisregardedAddresses.insert( address );
 				CI_LOG_W("Message: " << address << " doesn't have a listener. Disregarding.");
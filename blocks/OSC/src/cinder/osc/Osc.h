@@ -35,6 +35,7 @@
 #include "asio/asio.hpp"
 
 #include <set>
+#include <memory>
 #include <mutex>
 
 #include "cinder/Buffer.h"
@@ -639,7 +640,8 @@ public:
 	
 	//! Sets a callback, \a listener, to be called when receiving a message with \a address. If a ListenerFn
 	//! does not exist for a specific address, any messages with that address will be disregarded. If a ListenerFn
-	//! already exists for this address, \a listener will replace it.
+	//! already exists for this address, \a listener will replace it. Safe to call from within a ListenerFn; messages
+	//! that are already being dispatched still go to the previous set of listeners.
 	void		setListener( const std::string &address, ListenerFn listener );
 	//! Removes the listener associated with \a address.
 	void		removeListener( const std::string &address );
@@ -656,7 +658,8 @@ public:
 	ReceiverBase& operator=( ReceiverBase &&other ) = delete;
 	
 	//! Decodes and routes messages from the networking layer stream. Dispatches all messages with
-	//! an address that has an associated listener.
+	//! an address that has an associated listener. Doesn't lock mListenerMutex, listeners are looked up
+	//! in the current ListenerTable snapshot.
 	void dispatchMethods( uint8_t *data, uint32_t size, const asio::ip::address &senderIpAddress );
 	//! Decodes a complete OSC Packet into it's individual parts. \a timetag is ignored within the
 	//! below implementations.
@@ -671,9 +674,16 @@ public:
 	//! Abstract close implementation function.
 	virtual void closeImpl() = 0;
 	
-	Listeners				mListeners;
-	std::mutex				mListenerMutex;
-	std::set<std::string>	mDisregardedAddresses;
+	//! Immutable lookup structure compiled from mListeners, which is replaced as a whole whenever the listeners change.
+	class ListenerTable;
+	//! Rebuilds mListenerTable from mListeners. Expects mListenerMutex to be locked.
+	void updateListenerTable();
+	
+	Listeners								mListeners;
+	std::mutex								mListenerMutex;
+	std::shared_ptr<const ListenerTable>	mListenerTable;
+	std::set<std::string>					mDisregardedAddresses;
+	std::mutex								mDisregardedAddressesMutex;
 };
 	
 //! Represents an OSC Receiver(called a \a client in the OSC spec) and implements the UDP transport
@@ -0,0 +1,158 @@
+// Measures how many messages per second a ReceiverUdp dispatches over the loopback interface while hundreds of
+// listeners are registered, a mix of literal addresses and wildcard patterns. Messages are sent in bundles so that
+// decoding and dispatching, rather than the socket, dominate. Results are printed to the console and drawn.
+
+#include "cinder/app/App.h"
+#include "cinder/app/RendererGl.h"
+#include "cinder/gl/gl.h"
+
+#include "cinder/Log.h"
+#include "cinder/Timer.h"
+#include "cinder/osc/Osc.h"
+
+#include <atomic>
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+using protocol = asio::ip::udp;
+
+const uint16_t	localPort = 10001;
+const uint16_t	senderPort = 10000;
+const int		NUM_LISTENERS = 500;
+const int		NUM_BUNDLES = 4000;
+const int		MESSAGES_PER_BUNDLE = 32;
+// bundles that may be in flight before the sender waits for the receiver, which keeps the socket buffer from overflowing.
+const int		MAX_BUNDLES_IN_FLIGHT = 16;
+
+class DispatchBenchmarkApp : public App {
+  public:
+	DispatchBenchmarkApp();
+	void setup() override;
+	void draw() override;
+	void cleanup() override;
+
+	void runBenchmark();
+
+	std::shared_ptr<asio::io_service>		mIoService;
+	std::shared_ptr<asio::io_service::work>	mWork;
+	std::thread								mThread;
+
+	osc::ReceiverUdp	mReceiver;
+	osc::SenderUdp		mSender;
+	vector<osc::Bundle>	mBundles;
+	std::atomic<int>	mNumReceived;
+	vector<string>		mResults;
+};
+
+DispatchBenchmarkApp::DispatchBenchmarkApp()
+: mIoService( new asio::io_service ), mWork( new asio::io_service::work( *mIoService ) ),
+	mReceiver( localPort, protocol::v4(), *mIoService ),
+	mSender( senderPort, "127.0.0.1", localPort, protocol::v4(), *mIoService ),
+	mNumReceived( 0 )
+{
+}
+
+void DispatchBenchmarkApp::setup()
+{
+	// mostly literal addresses, as sent by a sensor rig, plus a few patterns that have to be tested on every message
+	for( int i = 0; i < NUM_LISTENERS; i++ ) {
+		mReceiver.setListener( "/rig/sensor/" + to_string( i ) + "/value",
+		[&]( const osc::Message &msg ) {
+			mNumReceived++;
+		});
+	}
+	mReceiver.setListener( "/rig/sensor/1?/value", []( const osc::Message &msg ) {} );
+	mReceiver.setListener( "/rig/sensor/[0-9]/*", []( const osc::Message &msg ) {} );
+	mReceiver.setListener( "/rig/{status,heartbeat}", []( const osc::Message &msg ) {} );
+
+	try {
+		mReceiver.bind();
+		mSender.bind();
+	}
+	catch( const osc::Exception &ex ) {
+		CI_LOG_E( "Error binding: " << ex.what() << " val: " << ex.value() );
+		quit();
+		return;
+	}
+
+	mReceiver.listen(
+	[]( asio::error_code error, protocol::endpoint endpoint ) -> bool {
+		if( error ) {
+			CI_LOG_E( "Error Listening: " << error.message() << " val: " << error.value() << " endpoint: " << endpoint );
+			return false;
+		}
+		else
+			return true;
+	});
+
+	mThread = std::thread( std::bind(
+	[]( std::shared_ptr<asio::io_service> &service ){
+		service->run();
+	}, mIoService ));
+
+	runBenchmark();
+}
+
+void DispatchBenchmarkApp::runBenchmark()
+{
+	mBundles.resize( 64 );
+	int messageIndex = 0;
+	for( auto &bundle : mBundles ) {
+		for( int i = 0; i < MESSAGES_PER_BUNDLE; i++ ) {
+			osc::Message msg( "/rig/sensor/" + to_string( messageIndex++ % NUM_LISTENERS ) + "/value" );
+			msg.append( 0.5f );
+			bundle.append( msg );
+		}
+	}
+
+	const int numExpected = NUM_BUNDLES * MESSAGES_PER_BUNDLE;
+	Timer timer( true );
+	for( int b = 0; b < NUM_BUNDLES; b++ ) {
+		while( b * MESSAGES_PER_BUNDLE - mNumReceived > MAX_BUNDLES_IN_FLIGHT * MESSAGES_PER_BUNDLE && timer.getSeconds() < 30 )
+			std::this_thread::yield();
+
+		// sockets aren't thread-safe, so sends are issued from the io_service thread
+		const auto &bundle = mBundles[b % mBundles.size()];
+		mIoService->post( [this, &bundle] {
+			mSender.send( bundle );
+		});
+	}
+	while( mNumReceived < numExpected && timer.getSeconds() < 30 )
+		std::this_thread::yield();
+
+	double seconds = timer.getSeconds();
+	mResults.push_back( to_string( NUM_LISTENERS + 3 ) + " listeners, " + to_string( mNumReceived ) + " / " + to_string( numExpected ) + " messages received" );
+	mResults.push_back( to_string( int( mNumReceived / seconds ) ) + " messages / second" );
+	for( const auto &result : mResults )
+		console() << result << endl;
+}
+
+void DispatchBenchmarkApp::draw()
+{
+	gl::clear();
+	gl::setMatricesWindow( getWindowSize() );
+
+	vec2 pos( 20, 20 );
+	for( const auto &result : mResults ) {
+		gl::drawString( result, pos );
+		pos.y += 20;
+	}
+}
+
+void DispatchBenchmarkApp::cleanup()
+{
+	mWork.reset();
+	mIoService->stop();
+	if( mThread.joinable() )
+		mThread.join();
+}
+
+auto settingsFunc = []( App::Settings *settings ) {
+#if defined( CINDER_MSW )
+	settings->setConsoleWindowEnabled();
+#endif
+};
+
+CINDER_APP( DispatchBenchmarkApp, RendererGl, settingsFunc )
@@ -26,9 +26,14 @@
 #pragma once
 
 #include "circular/circular.h"
+#include "cinder/CinderAssert.h"
 #include "cinder/Noncopyable.h"
 #include "cinder/Thread.h"
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
 namespace cinder {
 
 template<typename T>
@@ -123,4 +128,177 @@ class ConcurrentCircularBuffer : private Noncopyable {
 	bool					mCanceled;
 };
 
+//! \brief Bounded multi-producer, multi-consumer queue with the same interface as ConcurrentCircularBuffer, that pushes and pops without taking a lock.
+//!
+//! Each slot carries a sequence number that tells producers and consumers whether it is theirs on the current lap around the ring,
+//! so threads only contend on an atomic position. pushFront() and popBack() spin briefly while the buffer is full or empty and then
+//! sleep until woken. The mutex is only taken by threads that have gone to sleep and by those waking them; when nothing is sleeping,
+//! tryPushFront() and tryPopBack() never touch it.
+template<typename T>
+class LockFreeConcurrentCircularBuffer : private Noncopyable {
+  public:
+	typedef size_t size_type;
+
+	explicit LockFreeConcurrentCircularBuffer( size_type capacity )
+		: mCapacity( capacity ), mCells( new Cell[capacity] ), mPushPos( 0 ), mPopPos( 0 ), mNumWaitingToPush( 0 ), mNumWaitingToPop( 0 ), mCanceled( false )
+	{
+		CI_ASSERT( capacity > 0 );
+
+		for( size_type i = 0; i < capacity; i++ )
+			mCells[i].mSequence.store( i, std::memory_order_relaxed );
+	}
+
+	//! Pushes \a item to the front of the buffer, waiting while the buffer is full. Returns without pushing if cancel() has been called.
+	void pushFront( const T &item ) {
+		for( size_t numSpins = 0; ! mCanceled.load( std::memory_order_acquire ); numSpins++ ) {
+			if( tryPushFront( item ) )
+				return;
+
+			if( numSpins < SPIN_COUNT ) {
+				std::this_thread::yield();
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock( mMutex );
+			mNumWaitingToPush.fetch_add( 1 );
+			std::atomic_thread_fence( std::memory_order_seq_cst );
+			if( is_full_impl() && ! mCanceled.load() )
+				mNotFullCond.wait( lock );
+			mNumWaitingToPush.fetch_sub( 1 );
+		}
+	}
+
+	//! Pops an item from the back of the buffer into \a pItem, waiting while the buffer is empty. Returns without popping if cancel() has been called.
+	void popBack( T *pItem ) {
+		for( size_t numSpins = 0; ! mCanceled.load( std::memory_order_acquire ); numSpins++ ) {
+			if( tryPopBack( pItem ) )
+				return;
+
+			if( numSpins < SPIN_COUNT ) {
+				std::this_thread::yield();
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock( mMutex );
+			mNumWaitingToPop.fetch_add( 1 );
+			std::atomic_thread_fence( std::memory_order_seq_cst );
+			if( is_empty_impl() && ! mCanceled.load() )
+				mNotEmptyCond.wait( lock );
+			mNumWaitingToPop.fetch_sub( 1 );
+		}
+	}
+
+	//! Attempts to push \a item to the front of the buffer, but does not wait for an availability. Returns success as true or false.
+	bool tryPushFront( const T &item ) {
+		uint64_t pos = mPushPos.load( std::memory_order_relaxed );
+		Cell *cell;
+		while( true ) {
+			cell = &mCells[pos % mCapacity];
+			int64_t diff = int64_t( cell->mSequence.load( std::memory_order_acquire ) - pos );
+			if( diff == 0 ) {
+				if( mPushPos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+					break;
+			}
+			else if( diff < 0 )
+				return false; // the slot still holds an item from the previous lap
+			else
+				pos = mPushPos.load( std::memory_order_relaxed );
+		}
+
+		cell->mValue = item;
+		cell->mSequence.store( pos + 1, std::memory_order_release );
+		notifyWaiting( mNumWaitingToPop, mNotEmptyCond );
+		return true;
+	}
+
+	//! Attempts to pop an item from the back of the buffer, but does not wait for an availability. Returns success as true or false.
+	bool tryPopBack( T *pItem ) {
+		uint64_t pos = mPopPos.load( std::memory_order_relaxed );
+		Cell *cell;
+		while( true ) {
+			cell = &mCells[pos % mCapacity];
+			int64_t diff = int64_t( cell->mSequence.load( std::memory_order_acquire ) - ( pos + 1 ) );
+			if( diff == 0 ) {
+				if( mPopPos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+					break;
+			}
+			else if( diff < 0 )
+				return false; // the slot hasn't been pushed to on this lap
+			else
+				pos = mPopPos.load( std::memory_order_relaxed );
+		}
+
+		*pItem = std::move( cell->mValue );
+		cell->mSequence.store( pos + mCapacity, std::memory_order_release );
+		notifyWaiting( mNumWaitingToPush, mNotFullCond );
+		return true;
+	}
+
+	bool isNotEmpty() const		{ return ! is_empty_impl(); }
+	bool isNotFull() const		{ return ! is_full_impl(); }
+
+	//! Wakes all threads waiting in pushFront() or popBack(), and causes all future calls to them to return immediately.
+	void cancel() {
+		mCanceled.store( true );
+		std::lock_guard<std::mutex> lock( mMutex );
+		mNotFullCond.notify_all();
+		mNotEmptyCond.notify_all();
+	}
+
+	//! Returns the number of items the buffer can hold
+	size_t getCapacity() const { return mCapacity; }
+
+	//! Returns the number of items the buffer is currently holding. This is a snapshot that other threads may have changed by the time it returns.
+	size_t getSize() const {
+		uint64_t popPos = mPopPos.load( std::memory_order_acquire );
+		uint64_t pushPos = mPushPos.load( std::memory_order_acquire );
+		return pushPos > popPos ? (size_t)std::min<uint64_t>( pushPos - popPos, mCapacity ) : 0;
+	}
+
+  private:
+	// Positions and sequence numbers are 64-bit on all platforms, so that they never wrap around in practice.
+	struct Cell {
+		std::atomic<uint64_t>	mSequence;
+		T						mValue;
+	};
+
+	// Number of times a blocking call retries, yielding in between, before it sleeps.
+	static const size_t	SPIN_COUNT = 64;
+	static const size_t	CACHE_LINE_SIZE = 64;
+
+	bool is_empty_impl() const {
+		uint64_t pos = mPopPos.load( std::memory_order_relaxed );
+		return int64_t( mCells[pos % mCapacity].mSequence.load( std::memory_order_acquire ) - ( pos + 1 ) ) < 0;
+	}
+
+	bool is_full_impl() const {
+		uint64_t pos = mPushPos.load( std::memory_order_relaxed );
+		return int64_t( mCells[pos % mCapacity].mSequence.load( std::memory_order_acquire ) - pos ) < 0;
+	}
+
+	// Pairs with the fence in pushFront() and popBack(): either the sleeping thread sees the slot this thread just released,
+	// or this thread sees it waiting and wakes it once it is inside wait().
+	void notifyWaiting( const std::atomic<size_t> &numWaiting, std::condition_variable &cond ) {
+		std::atomic_thread_fence( std::memory_order_seq_cst );
+		if( numWaiting.load( std::memory_order_relaxed ) != 0 ) {
+			std::lock_guard<std::mutex> lock( mMutex );
+			cond.notify_one();
+		}
+	}
+
+	const size_type				mCapacity;
+	std::unique_ptr<Cell[]>		mCells;
+	// producers and consumers each update their own position, so they're kept on separate cache lines
+	char						mPadding0[CACHE_LINE_SIZE];
+	std::atomic<uint64_t>		mPushPos;
+	char						mPadding1[CACHE_LINE_SIZE];
+	std::atomic<uint64_t>		mPopPos;
+	char						mPadding2[CACHE_LINE_SIZE];
+	std::atomic<size_t>			mNumWaitingToPush, mNumWaitingToPop;
+	std::atomic<bool>			mCanceled;
+	std::mutex					mMutex;
+	std::condition_variable		mNotEmptyCond;
+	std::condition_variable		mNotFullCond;
+};
+
 } // namespace cinder
\ No newline at end of file
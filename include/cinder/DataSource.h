@@ -82,6 +82,44 @@ class CI_API DataSourcePath : public DataSource {
 	IStreamFileRef	mStream;	
 };
 
+typedef std::shared_ptr<class DataSourceMapped>	DataSourceMappedRef;
+
+//! DataSource for a file that is memory-mapped rather than read. getBuffer() and createStream() return views of the mapping, so no copy
+//! of the file is made and pages are only read from disk as they're touched. Where memory mapping isn't available the file is read in whole instead.
+class CI_API DataSourceMapped : public DataSource {
+  public:
+	//! Hints to the OS about the order the mapping will be read in, which tunes its read-ahead.
+	enum AccessPattern { NORMAL, SEQUENTIAL, RANDOM };
+
+	//! Maps the file at \a path. Throws StreamExc if it can't be opened or mapped.
+	static DataSourceMappedRef	create( const fs::path &path, AccessPattern accessPattern = SEQUENTIAL );
+
+	virtual bool	isFilePath() { return true; }
+	virtual bool	isUrl() { return false; }
+
+	//! Returns a stream that reads directly from the mapping. The stream keeps the mapping alive.
+	virtual IStreamRef	createStream();
+
+	//! Returns the mapped contents of the file, which are valid for the lifetime of this DataSourceMapped.
+	const void*		getData() const;
+	//! Returns the size of the file in bytes.
+	size_t			getSize() const;
+
+	//! Sets the read-ahead hint for the whole mapping. Ignored on platforms that don't support it.
+	void	setAccessPattern( AccessPattern accessPattern );
+	//! Asks the OS to start reading \a size bytes at \a offset in the background, ahead of them being touched. Ignored on platforms that don't support it.
+	void	prefetch( size_t offset = 0, size_t size = SIZE_MAX );
+
+  protected:
+	DataSourceMapped( const fs::path &path, AccessPattern accessPattern );
+
+	//! Wraps the mapping in a Buffer that doesn't own it but keeps it alive. Writes to the Buffer are copy-on-write and never reach the file.
+	virtual	void	createBuffer();
+
+	class Mapping;
+	std::shared_ptr<Mapping>	mMapping;
+};
+
 
 #if defined( CINDER_ANDROID )
 typedef std::shared_ptr<class DataSourceAndroidAsset>	DataSourceAndroidAssetRef;
@@ -107,6 +145,8 @@ class DataSourceAndroidAsset : public DataSource {
 
 
 CI_API DataSourceRef loadFile( const fs::path &path );
+//! Returns a DataSourceMapped for \a path, which avoids copying the file when its Buffer is requested. Throws StreamExc if the file can't be mapped.
+CI_API DataSourceRef loadFileMapped( const fs::path &path, DataSourceMapped::AccessPattern accessPattern = DataSourceMapped::SEQUENTIAL );
 
 #if ! defined( CINDER_UWP )
 typedef std::shared_ptr<class DataSourceUrl>	DataSourceUrlRef;
@@ -24,6 +24,7 @@
 #pragma once
 
 #include "cinder/Cinder.h"
+#include "cinder/CinderAssert.h"
 #include "cinder/Exception.h"
 #include "cinder/Frustum.h"
 #include "cinder/Vector.h"
@@ -37,6 +38,7 @@
 #include <map>
 #include <algorithm>
 #include <array>
+#include <utility>
 
 // Forward declarations in cinder::
 namespace cinder {
@@ -163,6 +165,9 @@ class CI_API Target {
 
 	virtual void	copyAttrib( Attrib attr, uint8_t dims, size_t strideBytes, const float *srcData, size_t count ) = 0;
 	virtual void	copyIndices( Primitive primitive, const uint32_t *source, size_t numIndices, uint8_t requiredBytesPerIndex ) = 0;
+	//! Returns storage the Source can write \a count elements of \a attr into directly, in place of calling copyAttrib(), with the stride between elements written to \a resultStrideBytes.
+	//! The storage is write-only and must be complete once loadInto() returns. Returns \c nullptr when the Target has no such storage for \a attr and \a dims, in which case the Source calls copyAttrib() as usual.
+	virtual float*	acquireAttribBuffer( Attrib /*attr*/, uint8_t /*dims*/, size_t /*count*/, size_t * /*resultStrideBytes*/ )	{ return nullptr; }
 
 	//! For non-indexed geometry, this generates appropriate indices and then calls the copyIndices() virtual method.
 	void	generateIndices( Primitive sourcePrimitive, size_t sourceNumIndices );
@@ -182,6 +187,55 @@ class CI_API Target {
 	void copyIndexData( const uint32_t *source, size_t numIndices, uint16_t *target );
 };
 
+//! Storage a Source writes the elements of one attribute into. Uses the storage returned by Target::acquireAttribBuffer() when there is some, and otherwise a temporary that commit() passes to Target::copyAttrib().
+//! When the attribute wasn't requested it holds no storage, but push_back() still counts elements so that size() can be used as the vertex count.
+template<typename T>
+class AttribBuffer {
+  public:
+	//! \a readable forces a tightly packed temporary, for attributes the Source reads back (to calculate tangents, for example) or needs whether or not it was \a requested.
+	AttribBuffer( Target *target, Attrib attr, size_t count, bool requested, bool readable = false )
+		: mTarget( target ), mAttrib( attr ), mCount( count ), mSize( 0 ), mRequested( requested ), mData( nullptr ), mStrideBytes( sizeof(T) )
+	{
+		if( requested && ! readable )
+			mData = reinterpret_cast<uint8_t*>( target->acquireAttribBuffer( attr, getDims(), count, &mStrideBytes ) );
+		if( ! mData && ( requested || readable ) ) {
+			mTemporary.resize( count );
+			mData = reinterpret_cast<uint8_t*>( mTemporary.data() );
+			mStrideBytes = sizeof(T);
+		}
+	}
+
+	//! Returns whether this buffer has storage, which is the case when the attribute was requested or is readable
+	explicit operator bool() const		{ return mData != nullptr; }
+
+	T&			operator[]( size_t i )			{ CI_ASSERT( mData && i < mCount ); return *reinterpret_cast<T*>( mData + i * mStrideBytes ); }
+	//! Writes \a value after the last element written with push_back(), or only counts it when there's no storage.
+	void		push_back( const T &value )		{ if( mData ) (*this)[mSize] = value; ++mSize; }
+	template<typename... Args>
+	void		emplace_back( Args&&... args )	{ if( mData ) (*this)[mSize] = T( std::forward<Args>( args )... ); ++mSize; }
+	//! Returns the number of elements written with push_back()
+	size_t		size() const					{ return mSize; }
+	//! Returns the tightly packed elements of a readable buffer
+	const T*	data() const					{ CI_ASSERT( mTemporary.data() == reinterpret_cast<const T*>( mData ) ); return mTemporary.data(); }
+	uint8_t		getDims() const					{ return uint8_t( sizeof(T) / sizeof(float) ); }
+
+	//! Passes the temporary to the Target when the attribute was requested. Call once all elements have been written.
+	void commit()
+	{
+		if( mRequested && ! mTemporary.empty() )
+			mTarget->copyAttrib( mAttrib, getDims(), 0, reinterpret_cast<const float*>( mTemporary.data() ), mCount );
+	}
+
+  private:
+	Target			*mTarget;
+	Attrib			mAttrib;
+	size_t			mCount, mSize;
+	bool			mRequested;
+	uint8_t			*mData;
+	size_t			mStrideBytes;
+	std::vector<T>	mTemporary;
+};
+
 class CI_API Modifier {
   public:
 	//! Expresses the upstream parameters for a Modifier such as # vertices
@@ -377,14 +431,14 @@ class CI_API Teapot : public Source {
 	Teapot*		clone() const override { return new Teapot( *this ); }
 
   protected:
-	void			calculate( std::vector<float> *positions, std::vector<float> *normals, std::vector<float> *texCoords, std::vector<uint32_t> *indices ) const;
+	void			calculate( AttribBuffer<vec3> *positions, AttribBuffer<vec3> *normals, AttribBuffer<vec2> *texCoords, std::vector<uint32_t> *indices ) const;
 	void			updateVertexCounts();
 
-	static void		generatePatches( float *v, float *n, float *tc, uint32_t *el, int grid );
-	static void		buildPatchReflect( int patchNum, float *B, float *dB, float *v, float *n, float *tc, unsigned int *el,
-										int &index, int &elIndex, int &tcIndex, int grid, bool reflectX, bool reflectY );
-	static void		buildPatch( vec3 patch[][4], float *B, float *dB, float *v, float *n, float *tc, 
-										unsigned int *el, int &index, int &elIndex, int &tcIndex, int grid, const mat3 reflect, bool invertNormal );
+	static void		generatePatches( AttribBuffer<vec3> *v, AttribBuffer<vec3> *n, AttribBuffer<vec2> *tc, uint32_t *el, int grid );
+	static void		buildPatchReflect( int patchNum, float *B, float *dB, AttribBuffer<vec3> *v, AttribBuffer<vec3> *n, AttribBuffer<vec2> *tc, unsigned int *el,
+										int &index, int &elIndex, int grid, bool reflectX, bool reflectY );
+	static void		buildPatch( vec3 patch[][4], float *B, float *dB, AttribBuffer<vec3> *v, AttribBuffer<vec3> *n, AttribBuffer<vec2> *tc,
+										unsigned int *el, int &index, int &elIndex, int grid, const mat3 reflect, bool invertNormal );
 	static void		getPatch( int patchNum, vec3 patch[][4], bool reverseV );
 	static void		computeBasisFunctions( float *B, float *dB, int grid );
 	static vec3		evaluate( int gridU, int gridV, const float *B, const vec3 patch[][4] );
@@ -504,9 +558,9 @@ class CI_API Capsule : public Source {
 
   private:
 	void	updateCounts();
-	void	calculate( std::vector<vec3> *positions, std::vector<vec3> *normals, std::vector<vec2> *texCoords, std::vector<vec3> *colors, std::vector<uint32_t> *indices ) const;
-	void	calculateRing( size_t segments, float radius, float y, float dy, std::vector<vec3> *positions,
-							std::vector<vec3> *normals, std::vector<vec2> *texCoords, std::vector<vec3> *colors ) const;
+	void	calculate( AttribBuffer<vec3> *positions, AttribBuffer<vec3> *normals, AttribBuffer<vec2> *texCoords, AttribBuffer<vec3> *colors, std::vector<uint32_t> *indices ) const;
+	void	calculateRing( size_t segments, float radius, float y, float dy, AttribBuffer<vec3> *positions,
+							AttribBuffer<vec3> *normals, AttribBuffer<vec2> *texCoords, AttribBuffer<vec3> *colors ) const;
 
 	vec3		mDirection, mCenter;
 	float		mLength, mRadius;
@@ -542,7 +596,7 @@ class CI_API Torus : public Source {
 
   protected:
 	void		updateCounts();
-	void		calculate( std::vector<vec3> *positions, std::vector<vec3> *normals, std::vector<vec2> *texCoords, std::vector<vec3> *colors, std::vector<uint32_t> *indices ) const;
+	void		calculate( AttribBuffer<vec3> *positions, AttribBuffer<vec3> *normals, AttribBuffer<vec2> *texCoords, AttribBuffer<vec3> *colors, std::vector<uint32_t> *indices ) const;
 
 	vec3		mCenter;
 	float		mRadiusMajor;
@@ -583,7 +637,7 @@ public:
 	TorusKnot*	clone() const override { return new TorusKnot( *this ); }
 
 protected:
-	void		calculate( std::vector<vec3> *positions, std::vector<vec3> *normals, std::vector<vec2> *texCoords, std::vector<vec3> *colors, std::vector<vec3> *tangents, std::vector<uint32_t> *indices ) const;
+	void		calculate( AttribBuffer<vec3> *positions, AttribBuffer<vec3> *normals, AttribBuffer<vec2> *texCoords, AttribBuffer<vec3> *colors, AttribBuffer<vec3> *tangents, std::vector<uint32_t> *indices ) const;
 
 	inline int	gcd( int a, int b ) const
 	{
@@ -669,9 +723,9 @@ class CI_API Cylinder : public Source {
 
   protected:
 	void	updateCounts();
-	void	calculate( std::vector<vec3> *positions, std::vector<vec3> *normals, std::vector<vec2> *texCoords, std::vector<vec3> *colors, std::vector<uint32_t> *indices ) const;
-	void	calculateCap( bool flip, float height, float radius, std::vector<vec3> *positions, std::vector<vec3> *normals,
-								std::vector<vec2> *texCoords, std::vector<vec3> *colors, std::vector<uint32_t> *indices ) const;
+	void	calculate( AttribBuffer<vec3> *positions, AttribBuffer<vec3> *normals, AttribBuffer<vec2> *texCoords, AttribBuffer<vec3> *colors, std::vector<uint32_t> *indices ) const;
+	void	calculateCap( bool flip, float height, float radius, AttribBuffer<vec3> *positions, AttribBuffer<vec3> *normals,
+								AttribBuffer<vec2> *texCoords, AttribBuffer<vec3> *colors, std::vector<uint32_t> *indices ) const;
 
 	vec3		mOrigin;
 	float		mHeight;
@@ -1445,6 +1499,7 @@ class CI_API SourceModsContext : public Target {
 	uint8_t			getAttribDims( Attrib attr ) const override;
 	void			copyAttrib( Attrib attr, uint8_t dims, size_t strideBytes, const float *srcData, size_t count ) override;
 	void			copyIndices( Primitive primitive, const uint32_t *source, size_t numIndices, uint8_t requiredBytesPerIndex ) override;
+	float*			acquireAttribBuffer( Attrib attr, uint8_t dims, size_t count, size_t *resultStrideBytes ) override;
 	
 	//! Appends vertex data to existing data for \a attr. \a dims must match existing data.
 	void			appendAttrib( Attrib attr, uint8_t dims, const float *srcData, size_t count );
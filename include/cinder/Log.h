@@ -30,6 +30,7 @@
 #include "cinder/Noncopyable.h"
 #include "cinder/System.h"
 
+#include <atomic>
 #include <sstream>
 #include <fstream>
 #include <vector>
@@ -191,12 +192,19 @@ protected:
 //! \brief LogManager manages a stack of all active Loggers.
 //!
 //! LogManager's default state contains a single LoggerConsole.  LogManager allows for adding and removing Loggers via their pointer values.
+//! By default log records are written to the Loggers on the calling thread. enableAsync() instead queues them to be written on a background thread.
 class CI_API LogManager {
 public:
+	//! Determines what a thread does when its asynchronous logging queue is full.
+	enum class QueueFullPolicy {
+		BLOCK,	//!< Wait until the background thread has made room for the record.
+		DROP	//!< Discard the record. The number of discarded records is available from getNumDroppedRecords().
+	};
+
 	// Returns a pointer to the shared instance. To enable logging during shutdown, this instance is leaked at shutdown.
 	static LogManager* instance()	{ return sInstance; }
 	//! Destroys the shared instance. Useful to remove false positives with leak detectors like valgrind.
-	static void destroyInstance()	{ delete sInstance; }
+	static void destroyInstance()	{ delete sInstance; sInstance = nullptr; }
 	//! Restores LogManager to its default state - a single LoggerConsole.
 	void restoreToDefault();
 
@@ -217,7 +225,20 @@ public:
 	std::mutex& getMutex() const			{ return mMutex; }
 	
 	void write( const Metadata &meta, const std::string &text );
-	
+
+	//! Enables asynchronous logging. Each thread that logs pushes its records into its own lock-free queue of \a queueSize records,
+	//! which a background thread drains into the Loggers. \a policy determines what happens when a queue is full.
+	//! Records from different threads may be written out of order. Pending records are flushed at exit and before any LEVEL_FATAL record returns.
+	void enableAsync( size_t queueSize = 1024, QueueFullPolicy policy = QueueFullPolicy::BLOCK );
+	//! Writes all pending records, stops the background thread and returns to logging on the calling thread.
+	void disableAsync();
+	//! Returns whether records are written to the Loggers on a background thread.
+	bool isAsyncEnabled() const		{ return mAsyncEnabled; }
+	//! Blocks until all records that the calling thread queued so far, and all records queued by other threads before this call, have been written. Does nothing when logging synchronously.
+	void flush();
+	//! Returns the number of records discarded by asynchronous logging with QueueFullPolicy::DROP.
+	uint64_t getNumDroppedRecords() const;
+
 	template<typename LoggerT, typename... Args>
 	std::shared_ptr<LoggerT> makeLogger( Args&&... args );
 
@@ -226,10 +247,24 @@ public:
 	
 protected:
 	LogManager();
+	~LogManager();
+
+	//! Writes \a meta and \a text to all Loggers on the calling thread.
+	void writeToLoggers( const Metadata &meta, const std::string &text );
+	//! Stops and destroys the AsyncWriter, if any. mAsyncMutex must be held.
+	void destroyAsyncWriter();
+
+	class AsyncWriter;
 
 	std::vector<LoggerRef>			mLoggers;
 	
 	mutable std::mutex				mMutex;
+
+	std::unique_ptr<AsyncWriter>	mAsyncWriter;
+	mutable std::mutex				mAsyncMutex;		// serializes enableAsync() and disableAsync()
+	std::atomic<bool>				mAsyncEnabled;
+	std::atomic<int>				mNumAsyncWrites;	// threads currently inside an asynchronous write()
+	uint64_t						mNumDroppedRecords;	// dropped by previous AsyncWriters
 	
 	static LogManager 				*sInstance;
 };
@@ -29,7 +29,6 @@
 #include "cinder/DataTarget.h"
 #include "cinder/GeomIo.h"
 
-#include <tuple>
 #include <map>
 
 namespace cinder {
@@ -52,7 +51,7 @@ class CI_API ObjLoader : public geom::Source {
 	 * \param includeTexCoords if false normals will be skipped, which can provide a faster load time
 	**/
 	ObjLoader( std::shared_ptr<IStreamCinder> stream, bool includeNormals = true, bool includeTexCoords = true, bool optimize = true );
-	/**Constructs and does the parsing of the file
+	/**Constructs and does the parsing of the file. Files are memory-mapped and parsed in place, in parallel for large files.
 	 * \param includeNormals if false texture coordinates will be skipped, which can provide a faster load time
 	 * \param includeTexCoords if false normals will be skipped, which can provide a faster load time
 	**/
@@ -122,19 +121,25 @@ class CI_API ObjLoader : public geom::Source {
 	Source*			clone() const override { return new ObjLoader( *this ); }
 
   private:
-	typedef std::tuple<int,int> VertexPair;
-	typedef std::tuple<int,int,int> VertexTriple;
+	struct ParsedData;
+	class VertexIndexMap;
 
+	//! Parses line by line from mStream, used for streams that can't be accessed as a single block of memory.
 	void	parse( bool includeNormals, bool includeTexCoords );
- 	void	parseFace( Group *group, const Material *material, const std::string &s, bool includeNormals, bool includeTexCoords );
-    void    parseMaterial( std::shared_ptr<IStreamCinder> material );
+	//! Parses \a dataSource in place, memory-mapping it if it is a file.
+	void	parse( const DataSourceRef &dataSource, bool includeNormals, bool includeTexCoords );
+	//! Parses \a dataSize bytes at \a data in place, splitting large inputs into chunks that are parsed in parallel.
+	void	parse( const char *data, size_t dataSize, bool includeNormals, bool includeTexCoords );
+	//! Appends the attributes of \a chunks in order and builds mGroups from their faces.
+	void	mergeParsedData( const std::vector<ParsedData> &chunks );
+	void	parseMaterial( std::shared_ptr<IStreamCinder> material );
 
 	void	load() const;
 
-	void	loadGroupNormalsTextures( const Group &group, std::map<VertexTriple,int> &uniqueVerts ) const;
-	void	loadGroupNormals( const Group &group, std::map<VertexPair,int> &uniqueVerts ) const;
-	void	loadGroupTextures( const Group &group, std::map<VertexPair,int> &uniqueVerts ) const;
-	void	loadGroup( const Group &group, std::map<int,int> &uniqueVerts ) const;
+	void	loadGroupNormalsTextures( const Group &group, VertexIndexMap &uniqueVerts ) const;
+	void	loadGroupNormals( const Group &group, VertexIndexMap &uniqueVerts ) const;
+	void	loadGroupTextures( const Group &group, VertexIndexMap &uniqueVerts ) const;
+	void	loadGroup( const Group &group, VertexIndexMap &uniqueVerts ) const;
 
 	std::shared_ptr<IStreamCinder>	mStream;
 
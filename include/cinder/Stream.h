@@ -31,6 +31,7 @@
   #include "cinder/app/android/AssetFileSystem.h"
 #endif
 
+#include <iterator>
 #include <string>
 
 namespace cinder {
@@ -122,7 +123,10 @@ class CI_API IStreamCinder : public virtual StreamBase {
 	void		read( fs::path *p );
 	void		readFixedString( char *t, size_t maxSize, bool nullTerminate );
 	void		readFixedString( std::string *t, size_t size );
+	//! Reads characters until the end of the line and returns them without the line ending. "\n", "\r\n" and "\r" are treated as line endings.
 	std::string	readLine();
+	//! Reads characters until the end of the line into \a line, without the line ending and reusing its capacity. Returns false if the stream was already at its end.
+	bool		readLine( std::string &line );
 	
 	void			readData( void *dest, size_t size );
 	virtual size_t	readDataAvailable( void *dest, size_t maxSize ) = 0;
@@ -134,7 +138,13 @@ class CI_API IStreamCinder : public virtual StreamBase {
 	IStreamCinder() = default;
 
 	virtual void		IORead( void *t, size_t size ) = 0;
-		
+
+	//! Exposes the bytes which can be read at the current position without further IO, refilling an internal read-ahead buffer if it is exhausted.
+	//! \a size is set to 0 at the end of the stream. Returns false if the stream has no such buffer, in which case readers fall back to IORead().
+	virtual bool		peekBuffered( const uint8_t ** /*data*/, size_t * /*size*/ ) { return false; }
+	//! Advances the current position by \a size bytes, which must not exceed the size last returned by peekBuffered().
+	virtual void		skipBuffered( size_t /*size*/ ) {}
+
 	static const int	MINIMUM_BUFFER_SIZE = 8; // minimum bytes of random access a stream must offer relative to the file start
 };
 typedef std::shared_ptr<IStreamCinder>		IStreamRef;
@@ -172,6 +182,8 @@ class CI_API IStreamFile : public IStreamCinder {
 
 	virtual void		IORead( void *t, size_t size );
 	size_t				readDataImpl( void *dest, size_t maxSize );
+	bool				peekBuffered( const uint8_t **data, size_t *size ) override;
+	void				skipBuffered( size_t size ) override;
  
 	FILE						*mFile;
 	bool						mOwnsFile;
@@ -308,6 +320,8 @@ class CI_API IStreamMem : public IStreamCinder {
  	IStreamMem( const void *aData, size_t aDataSize );
 
 	virtual void	IORead( void *t, size_t size );
+	bool			peekBuffered( const uint8_t **data, size_t *size ) override;
+	void			skipBuffered( size_t size ) override;
  
 	const uint8_t	*mData;
 	size_t			mDataSize;
@@ -315,6 +329,71 @@ class CI_API IStreamMem : public IStreamCinder {
 };
 
 
+//! Iterates over the lines of text in a block of memory, such as a memory-mapped file or the data of an IStreamMem, without copying them.
+//! "\n", "\r\n" and "\r" are treated as line endings like IStreamCinder::readLine(), and text after the last line ending is a line of its own.
+class CI_API LineIterator {
+  public:
+	//! Non-owning view of a single line, excluding its line ending.
+	class Line {
+	  public:
+		const char*		begin() const	{ return mBegin; }
+		const char*		end() const		{ return mEnd; }
+		size_t			size() const	{ return static_cast<size_t>( mEnd - mBegin ); }
+		bool			empty() const	{ return mBegin == mEnd; }
+		std::string		str() const		{ return std::string( mBegin, mEnd ); }
+
+	  private:
+		const char	*mBegin, *mEnd;
+
+		friend class LineIterator;
+	};
+
+	typedef std::forward_iterator_tag	iterator_category;
+	typedef Line						value_type;
+	typedef std::ptrdiff_t				difference_type;
+	typedef const Line*					pointer;
+	typedef const Line&					reference;
+
+	//! Creates an iterator at the first line of the \a size bytes at \a data.
+	LineIterator( const void *data, size_t size );
+	//! Creates an end iterator for the \a size bytes at \a data.
+	static LineIterator	end( const void *data, size_t size )	{ return LineIterator( static_cast<const char*>( data ) + size, 0 ); }
+
+	const Line&		operator*() const	{ return mLine; }
+	const Line*		operator->() const	{ return &mLine; }
+
+	LineIterator&	operator++();
+	LineIterator	operator++( int )	{ LineIterator result( *this ); ++( *this ); return result; }
+
+	bool	operator==( const LineIterator &rhs ) const	{ return mLine.mBegin == rhs.mLine.mBegin; }
+	bool	operator!=( const LineIterator &rhs ) const	{ return mLine.mBegin != rhs.mLine.mBegin; }
+
+  private:
+	//! Sets the line to start at \a begin and finds its end and the start of the following line.
+	void	setLine( const char *begin );
+
+	Line		mLine;
+	const char	*mNext, *mDataEnd;
+};
+
+//! Range of the lines of text in a block of memory for use with range-based for loops, see LineIterator.
+//! \code
+//! for( const auto &line : LineRange( buffer->getData(), buffer->getSize() ) )
+//!		console() << line.str() << std::endl;
+//! \endcode
+class CI_API LineRange {
+  public:
+	LineRange( const void *data, size_t size ) : mData( data ), mSize( size ) {}
+
+	LineIterator	begin() const	{ return LineIterator( mData, mSize ); }
+	LineIterator	end() const		{ return LineIterator::end( mData, mSize ); }
+
+  private:
+	const void	*mData;
+	size_t		mSize;
+};
+
+
 typedef std::shared_ptr<class OStreamMem>		OStreamMemRef;
 
 class CI_API OStreamMem : public OStream {
@@ -0,0 +1,89 @@
+/*
+ Copyright (c) 2016, The Cinder Project, All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/Cinder.h"
+#include "cinder/Noncopyable.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cinder {
+
+//! Fixed-size pool of worker threads for splitting CPU-bound work into parallel tasks.
+//!
+//! Tasks are executed in FIFO order. A thread that waits on parallelFor() runs the call's sub-ranges that no worker has started yet,
+//! so it is safe to call parallelFor() from within a task running on the same pool.
+class CI_API ThreadPool : private Noncopyable {
+  public:
+	//! Creates a pool with \a numThreads workers. If \a numThreads is 0, one less than the number of hardware threads is used (the calling thread makes up the difference).
+	explicit ThreadPool( size_t numThreads = 0 );
+	~ThreadPool();
+
+	//! Returns the global ThreadPool, which is created on first use.
+	static ThreadPool*	get();
+
+	//! Returns the number of worker threads owned by this pool.
+	size_t	getNumThreads() const	{ return mThreads.size(); }
+
+	//! Enqueues \a task to be executed on one of the worker threads.
+	void	submit( const std::function<void ()> &task );
+	//! Splits the range [\a begin, \a end) into contiguous sub-ranges of at least \a minGrain elements and calls \a fn( rangeBegin, rangeEnd ) for each one, using both the workers and the calling thread. Returns once all sub-ranges have completed.
+	//! If \a fn throws, the sub-ranges that haven't started are skipped and the first exception is rethrown once the others have finished.
+	void	parallelFor( size_t begin, size_t end, size_t minGrain, const std::function<void ( size_t, size_t )> &fn );
+
+  private:
+	//! The sub-ranges of one parallelFor() call, which the calling thread and the tasks it submits claim in turn.
+	struct ParallelForState {
+		ParallelForState() : mNextChunk( 0 ), mFailed( false ), mNumDone( 0 ) {}
+
+		//! Claims and runs sub-ranges until there are none left.
+		void	runChunks();
+
+		size_t										mBegin, mChunkSize, mRemainder, mNumChunks;
+		const std::function<void ( size_t, size_t )>	*mFn;
+		std::atomic<size_t>							mNextChunk;
+		std::atomic<bool>							mFailed;
+		std::exception_ptr							mException;
+		size_t										mNumDone;
+		std::mutex									mMutex;
+		std::condition_variable						mDoneCondition;
+	};
+
+	void	threadEntry();
+
+	std::vector<std::thread>			mThreads;
+	std::deque<std::function<void ()>>	mTasks;
+	std::mutex							mMutex;
+	std::condition_variable				mCondition;
+	bool								mShouldQuit;
+};
+
+} // namespace cinder
@@ -28,6 +28,7 @@
 #include "cinder/TimelineItem.h"
 #include "cinder/Easing.h"
 #include "cinder/Tween.h"
+#include "cinder/TweenBatch.h"
 
 #include <vector>
 #include <list>
@@ -126,6 +127,48 @@ class CI_API Timeline : public TimelineItem {
 		return typename Tween<T>::Options( newTween, thisRef() );
 	}
 
+	//! Replaces any existing tweens on the \a target with a batched tween at the timeline's current time. Batched tweens of the same type and easing function are stored
+	//! and evaluated together, which is considerably faster when animating many targets. They always auto-remove on completion and don't support TweenBase::Options,
+	//! reversing or looping. Avoid mixing batched and regular tweens on the same \a target.
+	template<typename T>
+	void applyBatched( Anim<T> *target, T endValue, float duration, const EaseFn &easeFunction = easeNone )
+	{
+		target->setParentTimeline( thisRef() );
+		removeTarget( target->ptr() );
+		getTweenBatch<T>( easeFunction )->add( target->ptr(), T(), endValue, true, mCurrentTime, duration, easeFunction, mNextBatchedTweenOrder++ );
+		setDurationDirty();
+	}
+
+	//! Replaces any existing tweens on the \a target with a batched tween at the timeline's current time. See applyBatched() for the limitations of batched tweens.
+	template<typename T>
+	void applyBatched( Anim<T> *target, T startValue, T endValue, float duration, const EaseFn &easeFunction = easeNone )
+	{
+		target->setParentTimeline( thisRef() );
+		removeTarget( target->ptr() );
+		getTweenBatch<T>( easeFunction )->add( target->ptr(), startValue, endValue, false, mCurrentTime, duration, easeFunction, mNextBatchedTweenOrder++ );
+		setDurationDirty();
+	}
+
+	//! Creates a new batched tween and adds it to the end of the last tween on \a target, or if no existing tween matches the target, the current time. See applyBatched() for the limitations of batched tweens.
+	template<typename T>
+	void appendToBatched( Anim<T> *target, T endValue, float duration, const EaseFn &easeFunction = easeNone )
+	{
+		target->setParentTimeline( thisRef() );
+		float startTime = std::max( mCurrentTime, findEndTimeOf( target->ptr() ) );
+		getTweenBatch<T>( easeFunction )->add( target->ptr(), T(), endValue, true, startTime, duration, easeFunction, mNextBatchedTweenOrder++ );
+		setDurationDirty();
+	}
+
+	//! Creates a new batched tween and adds it to the end of the last tween on \a target, or if no existing tween matches the target, the current time. See applyBatched() for the limitations of batched tweens.
+	template<typename T>
+	void appendToBatched( Anim<T> *target, T startValue, T endValue, float duration, const EaseFn &easeFunction = easeNone )
+	{
+		target->setParentTimeline( thisRef() );
+		float startTime = std::max( mCurrentTime, findEndTimeOf( target->ptr() ) );
+		getTweenBatch<T>( easeFunction )->add( target->ptr(), startValue, endValue, false, startTime, duration, easeFunction, mNextBatchedTweenOrder++ );
+		setDurationDirty();
+	}
+
 	//! add a cue to the Timeline add the start-time \a atTime
 	CueRef add( const std::function<void ()> &action, float atTime );
 
@@ -153,8 +196,10 @@ class CI_API Timeline : public TimelineItem {
 
 	//! Returns the number of items in the Timeline
 	size_t				getNumItems() const { return mItems.size(); }
-	//! Returns true if there are no items in the Timeline
-	bool				empty() const { return mItems.empty(); }
+	//! Returns the number of pending or running batched tweens in the Timeline
+	size_t				getNumBatchedTweens() const;
+	//! Returns true if there are no items or batched tweens in the Timeline
+	bool				empty() const { return mItems.empty() && getNumBatchedTweens() == 0; }
 	//! Returns the first item in the timeline the target of which matches \a target
 	TimelineItemRef		find( void *target ) const;
 	//! Returns the latest-starting item in the timeline the target of which matches \a target
@@ -163,6 +208,8 @@ class CI_API Timeline : public TimelineItem {
 	TimelineItemRef		findLastEnd( void *target ) const;
 	//! Returns the end of the latest-ending item in the timeline the target of which matches \a target, or the current time if it's not found. \a found can store whether a related item was found.
 	float				findEndTimeOf( void *target, bool *found = NULL ) const;
+	//! Returns whether any pending or running batched tweens target \a target
+	bool				hasBatchedTweens( void *target ) const;
 	//! Removes the TimelineItem \a item from the Timeline. Safe to use from callback fn's.
 	void				remove( TimelineItemRef item );
 	//! Removes all TimelineItems whose target matches \a target
@@ -208,14 +255,33 @@ class CI_API Timeline : public TimelineItem {
 	virtual void complete( bool /*reverse*/ ) {} // no-op
 
 	void						eraseMarked();
+	void						stepTweenBatches();
 	virtual float				calcDuration() const;
 
 	bool						mDefaultAutoRemove;
 	float						mCurrentTime;
 	
 	std::multimap<void*,TimelineItemRef>		mItems;
+	std::vector<std::unique_ptr<detail::TweenBatchBase>>	mTweenBatches;
+	uint64_t												mNextBatchedTweenOrder;
 	
   private:
+	//! Returns the batch that stores tweens of type \a T eased by \a easeFunction, creating it if necessary.
+	template<typename T>
+	detail::TweenBatch<T>* getTweenBatch( const EaseFn &easeFunction )
+	{
+		detail::EaseArrayFn easeArrayFn = detail::findEaseArrayFn( easeFunction );
+		for( auto &batch : mTweenBatches ) {
+			auto typedBatch = dynamic_cast<detail::TweenBatch<T>*>( batch.get() );
+			if( typedBatch && typedBatch->getEaseArrayFn() == easeArrayFn )
+				return typedBatch;
+		}
+
+		mTweenBatches.emplace_back( new detail::TweenBatch<T>( easeArrayFn ) );
+		return static_cast<detail::TweenBatch<T>*>( mTweenBatches.back().get() );
+	}
+
+
 	Timeline( const Timeline &rhs ); // private to prevent copying; use clone() method instead
 	Timeline& operator=( const Timeline &rhs ); // not defined to prevent copying
 };
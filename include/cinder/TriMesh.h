@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include <cfloat>
 #include <vector>
 #include "cinder/Vector.h"
 #include "cinder/AxisAlignedBox.h"
@@ -308,15 +309,21 @@ class CI_API TriMesh : public geom::Source {
 	void		write( const DataTargetRef &dataTarget, const std::set<geom::Attrib> &attribs ) const;
 
 	/*! Adds or replaces normals by calculating them from the vertices and faces. If \a smooth is TRUE,
-		similar vertices are grouped together to calculate their average. This will not change the mesh,
-		nor will it affect texture mapping. If \a weighted is TRUE, larger polygons contribute more to
-		the calculated normal. Renormalization requires 3D vertices. */
-	bool		recalculateNormals( bool smooth = false, bool weighted = false );
-	//! Adds or replaces tangents by calculating them from the normals and texture coordinates. Requires 3D normals and 2D texture coordinates.
+		vertices whose positions are within \a smoothEpsilon of each other are grouped together to calculate their average.
+		This will not change the mesh, nor will it affect texture mapping. If \a weighted is TRUE, larger polygons
+		contribute more to the calculated normal. Renormalization requires 3D vertices. Large meshes are processed in
+		parallel on the ThreadPool. */
+	bool		recalculateNormals( bool smooth = false, bool weighted = false, float smoothEpsilon = std::sqrt( FLT_EPSILON ) );
+	//! Adds or replaces tangents by calculating them from the normals and texture coordinates. Requires 3D normals and 2D texture coordinates. Large meshes are processed in parallel on the ThreadPool.
 	bool		recalculateTangents();
 	//! Adds or replaces bitangents by calculating them from the normals and tangents. Requires 3D normals and tangents.
 	bool		recalculateBitangents();
 
+	/*! Merges vertices whose positions are within \a epsilon of each other and whose other attributes are the same, and
+		updates the indices to match. The first of each group of merged vertices is kept. Returns the number of vertices removed.
+		Requires 3D vertices. */
+	size_t		weld( float epsilon = std::sqrt( FLT_EPSILON ) );
+
 	/*! Subdivide each triangle of the TriMesh into \a division times division triangles. Division less than 2 leaves the mesh unaltered.
 		Optionally, vertices are normalized if \a normalize is TRUE. */
 	void		subdivide( int division = 2, bool normalize = false );
@@ -340,6 +347,8 @@ class CI_API TriMesh : public geom::Source {
 
 	//! Returns whether or not the vertex, color etc. at both indices is the same.
 	bool		verticesEqual( uint32_t indexA, uint32_t indexB ) const;
+	//! Returns whether or not everything but the position at both indices is the same.
+	bool		attributesEqual( uint32_t indexA, uint32_t indexB ) const;
 
 	void		readImplV2( const IStreamRef &in );
 	void		readImplV1( const IStreamRef &in );
@@ -368,4 +377,15 @@ class CI_API TriMesh : public geom::Source {
 	friend class TriMeshGeomTarget;
 };
 
+namespace detail {
+
+//! Vertices are only split into parallel chunks of at least this many.
+const size_t MIN_VERTICES_PER_CHUNK = 16384;
+
+//! Returns how many chunks to split \a numTriangles into for parallel processing, at most one for each ThreadPool worker plus the calling thread.
+//! Shared by TriMesh::recalculateNormals() and geom::calculateTangents().
+CI_API size_t calcNumTriangleChunks( size_t numTriangles );
+
+} // namespace detail
+
 } // namespace cinder
@@ -0,0 +1,477 @@
+/*
+ Copyright (c) 2016, The Cinder Project, All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/Cinder.h"
+#include "cinder/Tween.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace cinder { namespace detail {
+
+//! Applies an easing function in place to \a count values.
+typedef void (*EaseArrayFn)( float *values, size_t count );
+
+//! Returns an EaseArrayFn equivalent to \a easeFn, or nullptr if \a easeFn isn't easeNone or one of the Quad, Cubic, Quart,
+//! Quint or Sine easing functions from Easing.h (either the function or its functor edition).
+CI_API EaseArrayFn findEaseArrayFn( const EaseFn &easeFn );
+
+//! Orders tweens that haven't started yet by start time, and tweens with equal start times by the order they were added.
+struct TweenBatchPendingKey {
+	bool operator<( const TweenBatchPendingKey &rhs ) const	{ return mStartTime < rhs.mStartTime || ( mStartTime == rhs.mStartTime && mOrder < rhs.mOrder ); }
+
+	float		mStartTime;
+	uint64_t	mOrder;
+};
+
+//! Interface used by Timeline to drive its batched tweens, see Timeline::applyBatched().
+class CI_API TweenBatchBase {
+  public:
+	virtual ~TweenBatchBase() {}
+
+	virtual std::unique_ptr<TweenBatchBase>	clone() const = 0;
+
+	//! Updates the targets of the tweens that have already started and removes the ones that complete at \a time.
+	virtual void	updateStarted( float time ) = 0;
+	//! Returns whether any tweens haven't started yet, and if so stores the key of the first one in \a key.
+	virtual bool	peekPending( TweenBatchPendingKey *key ) const = 0;
+	//! Starts the first tween that hasn't started yet and updates its target at \a time. Timeline starts tweens across all
+	//! of its batches in key order, so that a tween appended to another one starts from the previous tween's end value.
+	virtual void	startPending( float time ) = 0;
+
+	virtual void	removeTarget( void *target ) = 0;
+	virtual void	cloneAndReplaceTarget( void *target, void *replacementTarget ) = 0;
+	virtual void	replaceTarget( void *target, void *replacementTarget ) = 0;
+	//! Returns whether any tweens refer to \a target, and if so stores the end time of the latest-ending one in \a endTime.
+	virtual bool	findEndTimeOf( void *target, float *endTime ) const = 0;
+
+	//! Returns the number of tweens that are pending or running.
+	virtual size_t	getNumTweens() const = 0;
+	//! Returns the end time of the latest-ending tween, or 0 if there are none.
+	virtual float	calcEndTime() const = 0;
+};
+
+//! Stores tweens of type \a T that share an easing function as a structure of arrays. Tweens that haven't started wait in
+//! a heap ordered by start time, and only the started tweens are stored contiguously and evaluated each step, so the cost
+//! of a step is proportional to the number of running tweens.
+template<typename T>
+class TweenBatch : public TweenBatchBase {
+  public:
+	//! If \a easeArrayFn is nullptr, each tween keeps its own EaseFn and is eased individually.
+	TweenBatch( EaseArrayFn easeArrayFn )
+		: mEaseArrayFn( easeArrayFn )
+	{
+		mActive.mStoreEaseFns = ( easeArrayFn == nullptr );
+	}
+
+	EaseArrayFn		getEaseArrayFn() const	{ return mEaseArrayFn; }
+
+	//! Adds a tween on \a target. If \a copyStartValue is true, the start value is read from \a target when the tween starts.
+	//! \a order breaks ties between tweens with the same start time.
+	void add( T *target, const T &startValue, const T &endValue, bool copyStartValue, float startTime, float duration, const EaseFn &easeFn, uint64_t order )
+	{
+		uint32_t slotIndex = allocateSlot();
+		Slot &slot = mSlots[slotIndex];
+		slot.mTarget = target;
+		slot.mStartValue = startValue;
+		slot.mEndValue = endValue;
+		slot.mStartTime = startTime;
+		slot.mDuration = duration;
+		slot.mCopyStartValue = copyStartValue;
+		slot.mOrder = order;
+		slot.mState = Slot::PENDING;
+		if( ! mEaseArrayFn )
+			slot.mEaseFn = easeFn;
+
+		mTargetSlots[target].push_back( slotIndex );
+		pushPending( slotIndex );
+	}
+
+	//! Returns whether any tweens refer to \a target, and if so stores the end value of the latest-ending one in \a endValue.
+	bool findEndValueOf( void *target, T *endValue ) const
+	{
+		auto targetIt = mTargetSlots.find( target );
+		if( targetIt == mTargetSlots.end() )
+			return false;
+
+		const Slot *last = nullptr;
+		for( uint32_t slotIndex : targetIt->second ) {
+			const Slot &slot = mSlots[slotIndex];
+			if( ! last || slot.getEndTime() > last->getEndTime() )
+				last = &slot;
+		}
+		*endValue = last->mEndValue;
+		return true;
+	}
+
+	std::unique_ptr<TweenBatchBase>	clone() const override
+	{
+		return std::unique_ptr<TweenBatchBase>( new TweenBatch<T>( *this ) );
+	}
+
+	void updateStarted( float time ) override
+	{
+		update( time, 0 );
+	}
+
+	bool peekPending( TweenBatchPendingKey *key ) const override
+	{
+		if( mPending.empty() )
+			return false;
+
+		*key = mPending.front().mKey;
+		return true;
+	}
+
+	void startPending( float time ) override
+	{
+		uint32_t slotIndex = mPending.front().mSlot;
+		std::pop_heap( mPending.begin(), mPending.end(), PendingLater() );
+		mPending.pop_back();
+
+		// the tween is evaluated right away as the next one to start may copy its target's value
+		if( start( slotIndex ) )
+			update( time, mActive.mTargets.size() - 1 );
+	}
+
+	void removeTarget( void *target ) override
+	{
+		auto targetIt = mTargetSlots.find( target );
+		if( targetIt == mTargetSlots.end() )
+			return;
+
+		for( uint32_t slotIndex : targetIt->second ) {
+			Slot &slot = mSlots[slotIndex];
+			if( slot.mState == Slot::ACTIVE ) {
+				removeActive( slot.mActiveIndex );
+				freeSlot( slotIndex );
+			}
+			else { // the slot is still referenced by mPending, it is freed once it is popped
+				slot.mState = Slot::PENDING_REMOVED;
+				mNumPendingRemoved++;
+			}
+		}
+		mTargetSlots.erase( targetIt );
+	}
+
+	void cloneAndReplaceTarget( void *target, void *replacementTarget ) override
+	{
+		auto targetIt = mTargetSlots.find( target );
+		if( targetIt == mTargetSlots.end() )
+			return;
+
+		// copied because allocating slots below can invalidate references into mSlots and mTargetSlots
+		const std::vector<uint32_t> slotIndices = targetIt->second;
+		for( uint32_t slotIndex : slotIndices ) {
+			const Slot source = mSlots[slotIndex];
+			uint32_t cloneIndex = allocateSlot();
+			Slot &clone = mSlots[cloneIndex];
+			clone = source;
+			clone.mTarget = static_cast<T*>( replacementTarget );
+			if( source.mState == Slot::ACTIVE ) {
+				clone.mActiveIndex = (uint32_t)mActive.mTargets.size();
+				mActive.pushCopy( source.mActiveIndex, clone.mTarget, cloneIndex );
+			}
+			else
+				pushPending( cloneIndex );
+
+			mTargetSlots[replacementTarget].push_back( cloneIndex );
+		}
+	}
+
+	void replaceTarget( void *target, void *replacementTarget ) override
+	{
+		auto targetIt = mTargetSlots.find( target );
+		if( targetIt == mTargetSlots.end() )
+			return;
+
+		std::vector<uint32_t> slotIndices = std::move( targetIt->second );
+		mTargetSlots.erase( targetIt );
+		for( uint32_t slotIndex : slotIndices ) {
+			Slot &slot = mSlots[slotIndex];
+			slot.mTarget = static_cast<T*>( replacementTarget );
+			if( slot.mState == Slot::ACTIVE )
+				mActive.mTargets[slot.mActiveIndex] = slot.mTarget;
+		}
+
+		auto &replacementSlots = mTargetSlots[replacementTarget];
+		replacementSlots.insert( replacementSlots.end(), slotIndices.begin(), slotIndices.end() );
+	}
+
+	bool findEndTimeOf( void *target, float *endTime ) const override
+	{
+		auto targetIt = mTargetSlots.find( target );
+		if( targetIt == mTargetSlots.end() )
+			return false;
+
+		float result = mSlots[targetIt->second.front()].getEndTime();
+		for( uint32_t slotIndex : targetIt->second )
+			result = std::max( result, mSlots[slotIndex].getEndTime() );
+		*endTime = result;
+		return true;
+	}
+
+	size_t getNumTweens() const override
+	{
+		return mSlots.size() - mFreeSlots.size() - mNumPendingRemoved;
+	}
+
+	float calcEndTime() const override
+	{
+		float result = 0;
+		for( const auto &target : mTargetSlots ) {
+			for( uint32_t slotIndex : target.second )
+				result = std::max( result, mSlots[slotIndex].getEndTime() );
+		}
+		return result;
+	}
+
+  private:
+	//! Bookkeeping for a single tween. Once the tween starts, the values used for evaluation live in mActive.
+	struct Slot {
+		enum State { FREE, PENDING, PENDING_REMOVED, ACTIVE };
+
+		float	getEndTime() const	{ return mStartTime + std::max( mDuration, 0.0f ); }
+
+		T			*mTarget = nullptr;
+		T			mStartValue, mEndValue;
+		float		mStartTime = 0, mDuration = 0;
+		bool		mCopyStartValue = false;
+		uint64_t	mOrder = 0;
+		State		mState = FREE;
+		uint32_t	mActiveIndex = 0;
+		EaseFn		mEaseFn;
+	};
+
+	struct Pending {
+		TweenBatchPendingKey	mKey;
+		uint32_t				mSlot;
+	};
+
+	//! Orders mPending as a min-heap.
+	struct PendingLater {
+		bool operator()( const Pending &lhs, const Pending &rhs ) const { return rhs.mKey < lhs.mKey; }
+	};
+
+	//! The started tweens, one element per tween in each array.
+	struct ActiveArrays {
+		void push( T *target, const T &startValue, const T &endValue, float startTime, float duration, const EaseFn &easeFn, uint32_t slot )
+		{
+			mTargets.push_back( target );
+			mStartValues.push_back( startValue );
+			mEndValues.push_back( endValue );
+			mStartTimes.push_back( startTime );
+			mEndTimes.push_back( startTime + duration );
+			mInvDurations.push_back( 1 / duration );
+			if( mStoreEaseFns )
+				mEaseFns.push_back( easeFn );
+			mSlots.push_back( slot );
+		}
+
+		void pushCopy( size_t index, T *target, uint32_t slot )
+		{
+			mTargets.push_back( target );
+			mStartValues.push_back( mStartValues[index] );
+			mEndValues.push_back( mEndValues[index] );
+			mStartTimes.push_back( mStartTimes[index] );
+			mEndTimes.push_back( mEndTimes[index] );
+			mInvDurations.push_back( mInvDurations[index] );
+			if( mStoreEaseFns )
+				mEaseFns.push_back( mEaseFns[index] );
+			mSlots.push_back( slot );
+		}
+
+		//! Moves the last element to \a index and shrinks the arrays by one.
+		void removeSwapBack( size_t index )
+		{
+			const size_t last = mTargets.size() - 1;
+			if( index != last ) {
+				mTargets[index] = mTargets[last];
+				mStartValues[index] = mStartValues[last];
+				mEndValues[index] = mEndValues[last];
+				mStartTimes[index] = mStartTimes[last];
+				mEndTimes[index] = mEndTimes[last];
+				mInvDurations[index] = mInvDurations[last];
+				if( mStoreEaseFns )
+					mEaseFns[index] = std::move( mEaseFns[last] );
+				mSlots[index] = mSlots[last];
+			}
+			mTargets.pop_back();
+			mStartValues.pop_back();
+			mEndValues.pop_back();
+			mStartTimes.pop_back();
+			mEndTimes.pop_back();
+			mInvDurations.pop_back();
+			if( mStoreEaseFns )
+				mEaseFns.pop_back();
+			mSlots.pop_back();
+		}
+
+		std::vector<T*>			mTargets;
+		std::vector<T>			mStartValues, mEndValues;
+		std::vector<float>		mStartTimes, mEndTimes, mInvDurations;
+		//! Only populated when mStoreEaseFns is true, which is when the batch has no EaseArrayFn.
+		std::vector<EaseFn>		mEaseFns;
+		std::vector<uint32_t>	mSlots;
+		bool					mStoreEaseFns = true;
+	};
+
+	uint32_t allocateSlot()
+	{
+		if( ! mFreeSlots.empty() ) {
+			uint32_t result = mFreeSlots.back();
+			mFreeSlots.pop_back();
+			return result;
+		}
+
+		mSlots.emplace_back();
+		return (uint32_t)( mSlots.size() - 1 );
+	}
+
+	void freeSlot( uint32_t slotIndex )
+	{
+		mSlots[slotIndex] = Slot();
+		mFreeSlots.push_back( slotIndex );
+	}
+
+	void pushPending( uint32_t slotIndex )
+	{
+		const Slot &slot = mSlots[slotIndex];
+		mPending.push_back( { { slot.mStartTime, slot.mOrder }, slotIndex } );
+		std::push_heap( mPending.begin(), mPending.end(), PendingLater() );
+	}
+
+	//! Removes \a slotIndex from the slots of its target, erasing the target once it has no tweens left.
+	void detachFromTarget( uint32_t slotIndex )
+	{
+		auto targetIt = mTargetSlots.find( mSlots[slotIndex].mTarget );
+		auto &slotIndices = targetIt->second;
+		slotIndices.erase( std::find( slotIndices.begin(), slotIndices.end(), slotIndex ) );
+		if( slotIndices.empty() )
+			mTargetSlots.erase( targetIt );
+	}
+
+	void removeActive( size_t activeIndex )
+	{
+		mActive.removeSwapBack( activeIndex );
+		if( activeIndex < mActive.mSlots.size() )
+			mSlots[mActive.mSlots[activeIndex]].mActiveIndex = (uint32_t)activeIndex;
+	}
+
+	//! Returns whether the tween in \a slotIndex was added to mActive.
+	bool start( uint32_t slotIndex )
+	{
+		Slot &slot = mSlots[slotIndex];
+		if( slot.mState == Slot::PENDING_REMOVED ) {
+			mNumPendingRemoved--;
+			freeSlot( slotIndex );
+			return false;
+		}
+
+		if( slot.mCopyStartValue )
+			slot.mStartValue = *slot.mTarget;
+
+		// like Tween, a tween without a duration jumps straight to its end value
+		if( slot.mDuration <= 0 ) {
+			float time = 1;
+			if( mEaseArrayFn )
+				mEaseArrayFn( &time, 1 );
+			else
+				time = slot.mEaseFn( time );
+			*slot.mTarget = tweenLerp<T>( slot.mStartValue, slot.mEndValue, time );
+			detachFromTarget( slotIndex );
+			freeSlot( slotIndex );
+			return false;
+		}
+
+		slot.mState = Slot::ACTIVE;
+		slot.mActiveIndex = (uint32_t)mActive.mTargets.size();
+		mActive.push( slot.mTarget, slot.mStartValue, slot.mEndValue, slot.mStartTime, slot.mDuration, slot.mEaseFn, slotIndex );
+		return true;
+	}
+
+	//! Evaluates the active tweens from \a begin onwards at \a time, then removes the ones that have completed.
+	void update( float time, size_t begin )
+	{
+		const size_t count = mActive.mTargets.size() - begin;
+		if( count == 0 )
+			return;
+
+		mEasedTimes.resize( count );
+		float *easedTimes = mEasedTimes.data();
+		const float *startTimes = mActive.mStartTimes.data() + begin;
+		const float *endTimes = mActive.mEndTimes.data() + begin;
+		const float *invDurations = mActive.mInvDurations.data() + begin;
+
+		// same relative time as TimelineItem::stepTo(), clamped at 0 for when the Timeline steps backwards
+		size_t numCompleted = 0;
+		for( size_t i = 0; i < count; i++ ) {
+			easedTimes[i] = std::min( std::max( ( time - startTimes[i] ) * invDurations[i], 0.0f ), 1.0f );
+			numCompleted += ( time >= endTimes[i] ) ? 1 : 0;
+		}
+
+		if( mEaseArrayFn )
+			mEaseArrayFn( easedTimes, count );
+		else {
+			const EaseFn *easeFns = mActive.mEaseFns.data() + begin;
+			for( size_t i = 0; i < count; i++ )
+				easedTimes[i] = easeFns[i]( easedTimes[i] );
+		}
+
+		T * const *targets = mActive.mTargets.data() + begin;
+		const T *startValues = mActive.mStartValues.data() + begin;
+		const T *endValues = mActive.mEndValues.data() + begin;
+		for( size_t i = 0; i < count; i++ )
+			*targets[i] = tweenLerp<T>( startValues[i], endValues[i], easedTimes[i] );
+
+		if( numCompleted == 0 )
+			return;
+
+		// walk backwards so that the element swapped into place has already been visited
+		for( size_t i = mActive.mTargets.size(); i > begin; i-- ) {
+			const size_t activeIndex = i - 1;
+			if( time >= mActive.mEndTimes[activeIndex] ) {
+				uint32_t slotIndex = mActive.mSlots[activeIndex];
+				removeActive( activeIndex );
+				detachFromTarget( slotIndex );
+				freeSlot( slotIndex );
+			}
+		}
+	}
+
+	EaseArrayFn		mEaseArrayFn;
+
+	std::vector<Slot>		mSlots;
+	std::vector<uint32_t>	mFreeSlots;
+	std::vector<Pending>	mPending;
+	size_t					mNumPendingRemoved = 0;
+	ActiveArrays			mActive;
+	std::vector<float>		mEasedTimes;
+
+	std::unordered_map<void*, std::vector<uint32_t>>	mTargetSlots;
+};
+
+} } // namespace cinder::detail
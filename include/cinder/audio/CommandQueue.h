@@ -0,0 +1,68 @@
+/*
+ Copyright (c) 2016, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/Cinder.h"
+#include "cinder/Export.h"
+#include "cinder/Noncopyable.h"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+
+namespace cinder { namespace audio {
+
+//! \brief Lock-free queue of commands that are posted from any number of threads and called in order by a single consumer, typically the audio thread.
+//!
+//! post() and process() never block on each other. The consumer only relinks commands that were allocated by post(), so calling them doesn't
+//! allocate or free memory. Commands that have been called are destroyed, along with anything they captured, by the next call to post().
+class CI_API CommandQueue : private Noncopyable {
+  public:
+	typedef std::function<void ()>	Command;
+
+	CommandQueue();
+	~CommandQueue();
+
+	//! Adds \a command to the end of the queue. Safe to call from any thread, concurrently with other calls to post() and with process().
+	void	post( const Command &command );
+	//! Calls every command that was posted before this call, in the order they were posted, and returns how many were called. Must not be called by more than one thread at a time.
+	size_t	process();
+	//! Returns true if there are no commands waiting to be processed.
+	bool	isEmpty() const		{ return mPosted.load( std::memory_order_relaxed ) == nullptr; }
+
+  private:
+	struct Item {
+		Command	mCommand;
+		Item*	mNext;
+	};
+
+	//! Pushes the linked items \a first through \a last onto \a stack.
+	static void	push( std::atomic<Item *> &stack, Item *first, Item *last );
+	static void	destroyAll( Item *item );
+
+	std::atomic<Item *>	mPosted;	// most recently posted first
+	std::atomic<Item *>	mProcessed;	// called commands, waiting to be destroyed by post()
+};
+
+} } // namespace cinder::audio
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include "cinder/audio/CommandQueue.h"
 #include "cinder/audio/Node.h"
 #include "cinder/audio/InputNode.h"
 #include "cinder/audio/OutputNode.h"
@@ -36,6 +37,7 @@
 namespace cinder { namespace audio {
 
 class DeviceManager;
+class GraphScheduler;
 
 //! \brief Manages the creation, connections, and lifecycle of audio::Node's.
 
@@ -81,9 +83,18 @@ class CI_API Context : public std::enable_shared_from_this<Context> {
 	//! Returns whether or not this \a Context is current enabled and processing audio.
 	bool isEnabled() const		{ return mEnabled; }
 
-	//! Called by \a node when it's connections have changed. Default implementation is empty.
+	//! Called by \a node when it's connections have changed. Default implementation rebuilds the parallel processing schedule if there are worker threads.
 	virtual void connectionsDidChange( const NodeRef &node );
 
+	//! \brief Sets the number of worker threads that process independent branches of the Node graph in parallel with the audio thread.
+	//!
+	//! The default of 0 pulls the whole graph on the audio thread. With worker threads, summing Node's are processed level by level before the OutputNode
+	//! is pulled, and the rendered output is identical to the serial path. Node's whose process() shares state with Node's in other branches aren't safe to process this way.
+	//! \see GraphScheduler
+	void	setNumWorkerThreads( size_t numThreads );
+	//! Returns the number of worker threads set with setNumWorkerThreads().
+	size_t	getNumWorkerThreads() const;
+
 	//! Returns the samplerate of this Context, which is governed by the current OutputNode.
 	size_t		getSampleRate()				{ return getOutput()->getOutputSampleRate(); }
 	//! Returns the number of frames processed in one block by this Node, which is governed by the current OutputNode.
@@ -115,15 +126,26 @@ class CI_API Context : public std::enable_shared_from_this<Context> {
 	//! Schedule \a node to be enabled or disabled with with \a func on the audio thread, to be called at \a when seconds measured against getNumProcessedSeconds().
 	//! If \a \a callFuncBeforeProcess is true, then `func` will be called at the beginning of the processing block, if false will be called at the end.
 	//! \note Should be called from the user thread. Currently only one event can be scheduled on a node at a time. \a node is owned until the scheduled event completes.
+	//! The event is handed to the audio thread with postCommand(), so this doesn't block on getMutex().
 	void scheduleEvent( double when, const NodeRef &node, bool callFuncBeforeProcess, const std::function<void ()> &func );
-	//! Immediately cancels any events scheduled with scheduleEvent().
+	//! Cancels any events scheduled with scheduleEvent() for \a node, so that none of them are called after this method returns. Blocks on getMutex() unless called on the audio thread.
 	void cancelScheduledEvents( const NodeRef &node );
 	//! \deprecated  use scheduleEvent() instead.
 	void schedule( double when, const NodeRef &node, bool callFuncBeforeProcess, const std::function<void ()> &func )	{ scheduleEvent( when, node, callFuncBeforeProcess, func ); }
 
+	//! \brief Posts \a command to be called on the audio thread at the beginning of the next processing block, without blocking on getMutex().
+	//!
+	//! Meant for changes that don't alter the connections of the Node graph, such as Param automation, so that a thread making many of them
+	//! never contends with the audio thread. Commands are called in the order they were posted, while the audio thread holds getMutex().
+	//! If called on the audio thread, \a command is called immediately. If this Context isn't enabled, \a command is called before this method returns.
+	//! \note \a command shouldn't allocate or free memory, or post other commands. Objects it captures are destroyed on a non-audio thread.
+	void postCommand( const std::function<void ()> &command );
+	//! Calls any commands posted with postCommand() that haven't been processed yet, blocking on getMutex(). Useful when their result must be observed before the next processing block.
+	void flushCommands();
+
 	//! Returns the mutex used to synchronize the audio thread. This is also used internally by the Node class when making connections.
 	std::mutex& getMutex() const			{ return mMutex; }
-	//! Returns true if the current thread is the thread used for audio processing, false otherwise.
+	//! Returns true if the current thread is the thread used for audio processing or one of its worker threads, false otherwise.
 	bool isAudioThread() const;
 
 	//! OutputNode implementations should call this before each rendering block.
@@ -139,6 +161,11 @@ class CI_API Context : public std::enable_shared_from_this<Context> {
   protected:
 	Context();
 
+	//! Returns the thread that preProcess() was last called on.
+	std::thread::id	getAudioThreadId() const					{ return mAudioThreadId; }
+	//! Sets the thread that isAudioThread() compares against, for Contexts that only process on the calling thread while rendering. Must be synchronized with getMutex().
+	void			setAudioThreadId( std::thread::id threadId )	{ mAudioThreadId = threadId; }
+
   private:
 	struct ScheduledEvent {
 		ScheduledEvent( uint64_t eventFrameThreshold, const NodeRef &node, bool callFuncBeforeProcess, const std::function<void ()> &fn )
@@ -159,7 +186,11 @@ class CI_API Context : public std::enable_shared_from_this<Context> {
 	void	processAutoPulledNodes();
 	void	preProcessScheduledEvents();
 	void	postProcessScheduledEvents();
+	//! Moves \a node's scheduled event, if any, into \a canceledEvents. Must be called on the audio thread or synchronized with mMutex.
+	void	removeScheduledEvent( const NodeRef &node, std::list<ScheduledEvent> *canceledEvents );
 	void	incrementFrameCount();
+	//! Called by Node's when their inputs change, so that a stale schedule isn't processed before connectionsDidChange() rebuilds it.
+	void	invalidateGraphSchedule();
 
 	static void registerClearStatics();
 
@@ -167,6 +198,7 @@ class CI_API Context : public std::enable_shared_from_this<Context> {
 	std::atomic<uint64_t>		mNumProcessedFrames;
 	OutputNodeRef				mOutput;
 	std::list<ScheduledEvent>	mScheduledEvents;
+	CommandQueue				mCommandQueue;
 	ci::Timer					mProcessTimer;
 	std::atomic<double>			mTimeDuringLastProcessLoop;
 
@@ -179,9 +211,13 @@ class CI_API Context : public std::enable_shared_from_this<Context> {
 	mutable std::mutex		mMutex;
 	std::thread::id			mAudioThreadId;
 
+	std::unique_ptr<GraphScheduler>	mGraphScheduler;
+
 	// - Context is stored in Node classes as a weak_ptr, so it needs to (for now) be created as a shared_ptr
 	static std::shared_ptr<Context>			sMasterContext;
 	static std::unique_ptr<DeviceManager>	sDeviceManager; // TODO: consider turning DeviceManager into a HardwareContext class
+
+	friend class Node;
 };
 
 template<typename NodeT>
@@ -0,0 +1,132 @@
+/*
+ Copyright (c) 2016, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/audio/Context.h"
+#include "cinder/audio/Target.h"
+
+namespace cinder { namespace audio {
+
+typedef std::shared_ptr<class ContextOffline>		ContextOfflineRef;
+typedef std::shared_ptr<class OutputNodeOffline>	OutputNodeOfflineRef;
+
+//! \brief OutputNode that is not attached to any hardware. Each processing block is pulled by ContextOffline::render() on the calling thread.
+//!
+//! The rendered samples can be recorded into an internal Buffer (see setRecordingEnabled()) and / or written to a TargetFile (see setTargetFile()).
+//! If number of channels hasn't been specified via Node::Format, defaults to 2.
+class CI_API OutputNodeOffline : public OutputNode {
+  public:
+	OutputNodeOffline( size_t sampleRate = 44100, size_t framesPerBlock = 512, const Format &format = Format() );
+
+	//! Returns the samplerate that this OutputNodeOffline was constructed with.
+	size_t getOutputSampleRate() override		{ return mSampleRate; }
+	//! Returns the frames per block that this OutputNodeOffline was constructed with.
+	size_t getOutputFramesPerBlock() override	{ return mFramesPerBlock; }
+
+	//! Sets whether rendered samples are appended to an internal Buffer, which can be retrieved with getRecordedCopy(). Default is false.
+	void		setRecordingEnabled( bool enable = true );
+	//! Returns whether rendered samples are appended to an internal Buffer.
+	bool		isRecordingEnabled() const		{ return mRecordingEnabled; }
+	//! Returns the number of frames that have been recorded since recording was enabled or clearRecording() was called.
+	size_t		getNumRecordedFrames() const	{ return mNumRecordedFrames; }
+	//! Returns a copy of the recorded samples.
+	BufferRef	getRecordedCopy() const;
+	//! Discards any recorded samples, keeping the allocated memory for reuse.
+	void		clearRecording();
+
+	//! Sets a TargetFile that every rendered block is written to. Pass an empty TargetFileRef to stop writing. \note \a targetFile must have the same number of channels as this OutputNodeOffline.
+	void					setTargetFile( const TargetFileRef &targetFile );
+	//! Returns the TargetFile that rendered blocks are written to, which may be empty.
+	const TargetFileRef&	getTargetFile() const		{ return mTargetFile; }
+
+  protected:
+	void initialize()					override;
+	bool supportsProcessInPlace() const	override	{ return false; }
+
+  private:
+	//! Pulls the graph for one processing block and delivers the first \a numFrames frames to the recording Buffer and TargetFile. The rest of the block is kept for the next render().
+	void renderBlock( size_t numFrames );
+	//! Delivers up to \a numFrames of the frames left over from the last block, returning how many were delivered.
+	size_t renderLeftoverFrames( size_t numFrames );
+	void deliverFrames( size_t numFrames, size_t frameOffset );
+	void appendToRecording( const Buffer *buffer, size_t numFrames, size_t frameOffset );
+
+	size_t			mSampleRate, mFramesPerBlock;
+	size_t			mNumLeftoverFrames;
+	bool			mRecordingEnabled;
+	BufferDynamic	mRecordedBuffer;
+	size_t			mNumRecordedFrames;
+	TargetFileRef	mTargetFile;
+
+	friend class ContextOffline;
+};
+
+//! \brief Context that renders its Node graph faster than realtime, without an audio device.
+//!
+//! Processing only happens when render() is called, on the calling thread, which is treated as the audio thread for the duration of the call.
+//! getNumProcessedSeconds() and therefore scheduleEvent() are measured against the virtual time of the rendered frames.
+//! As with other Context's, the ContextOffline must be owned by a shared_ptr and must be enabled before it will produce anything.
+//!
+//! \code
+//! auto ctx = std::make_shared<audio::ContextOffline>( 48000 );
+//! auto gen = ctx->makeNode( new audio::GenSineNode( 440 ) );
+//! gen >> ctx->getOutput();
+//! gen->enable();
+//! ctx->getOutputOffline()->setTargetFile( audio::TargetFile::create( "sine.wav", 48000, 2 ) );
+//! ctx->enable();
+//! ctx->renderSeconds( 10 );
+//! \endcode
+class CI_API ContextOffline : public Context {
+  public:
+	//! Constructs a ContextOffline whose default output will render \a numChannels channels at \a sampleRate, \a framesPerBlock frames at a time.
+	ContextOffline( size_t sampleRate = 44100, size_t framesPerBlock = 512, size_t numChannels = 2 );
+	virtual ~ContextOffline();
+
+	//! Not supported, throws AudioContextExc.
+	OutputDeviceNodeRef	createOutputDeviceNode( const DeviceRef &device = Device::getDefaultOutput(), const Node::Format &format = Node::Format() ) override;
+	//! Not supported, throws AudioContextExc.
+	InputDeviceNodeRef	createInputDeviceNode( const DeviceRef &device = Device::getDefaultInput(), const Node::Format &format = Node::Format() ) override;
+
+	//! Overridden to require an OutputNodeOffline. Throws AudioContextExc if \a output is of any other type.
+	void					setOutput( const OutputNodeRef &output ) override;
+	//! Returns the OutputNode for the Context, which is created with the parameters passed to the constructor if it hasn't been set.
+	const OutputNodeRef&	getOutput() override;
+	//! Returns the current output as an OutputNodeOffline.
+	const OutputNodeOfflineRef&	getOutputOffline();
+
+	//! Renders \a numFrames frames through the Node graph as fast as possible. Returns the number of frames rendered, which is 0 if the Context isn't enabled.
+	//! The graph always processes whole blocks. If \a numFrames isn't a multiple of getFramesPerBlock(), the unused end of the last block is returned first by the next call, so consecutive renders are contiguous.
+	size_t render( size_t numFrames );
+	//! Renders \a seconds worth of frames through the Node graph. \see render()
+	size_t renderSeconds( double seconds );
+	//! Returns the total number of frames returned by render(). Unlike getNumProcessedFrames(), which counts whole blocks, this doesn't include frames that were processed but are still waiting for the next render().
+	uint64_t getNumRenderedFrames() const	{ return mNumRenderedFrames; }
+
+  private:
+	size_t					mDefaultSampleRate, mDefaultFramesPerBlock, mDefaultNumChannels;
+	uint64_t				mNumRenderedFrames;
+	OutputNodeOfflineRef	mOutputOffline;
+};
+
+} } // namespace cinder::audio
@@ -0,0 +1,95 @@
+/*
+ Copyright (c) 2016, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include "cinder/audio/Node.h"
+#include "cinder/audio/Source.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace cinder { namespace audio {
+
+typedef std::shared_ptr<class ConvolutionNode>		ConvolutionNodeRef;
+
+//! \brief Convolves its input with an impulse response, for example to apply the reverb of a recorded space.
+//!
+//! Uses partitioned overlap-save FFT convolution, which adds no latency. The first part of the impulse response is split into partitions
+//! of getFramesPerBlock() frames that are all applied every block. The rest of a long response is split into partitions that are
+//! TAIL_PARTITION_RATIO times larger. Their spectral multiply-adds are spread evenly across the blocks they span, while the forward
+//! transform of the tail's input runs in the first of those blocks and the inverse transform in the last. This keeps most blocks far
+//! cheaper than with uniform partitions for responses that are several seconds long, though those two blocks each pay for one transform
+//! of 2 * TAIL_PARTITION_RATIO * getFramesPerBlock() frames per channel. The spectra are multiplied with dsp::complexMulAdd(), which uses
+//! the current dsp::SimdLevel.
+//!
+//! Each channel is convolved with the impulse response channel of the same index, or the last one if the response has fewer channels.
+//! The Context's frames per block must be a power of two. Until an impulse response is set, input passes through unchanged.
+class CI_API ConvolutionNode : public Node {
+  public:
+	//! The tail of a long impulse response is split into partitions this many times larger than getFramesPerBlock().
+	static const size_t TAIL_PARTITION_RATIO = 16;
+
+	//! Constructs a ConvolutionNode with an optional \a format. Set the impulse response with setImpulseResponse() or loadImpulseResponse().
+	ConvolutionNode( const Format &format = Format() );
+	//! Constructs a ConvolutionNode that applies \a impulseResponse, with an optional \a format.
+	ConvolutionNode( const BufferRef &impulseResponse, const Format &format = Format() );
+	virtual ~ConvolutionNode();
+
+	//! \brief Sets the impulse response to \a impulseResponse, which is expected to be at the Context's samplerate.
+	//!
+	//! The partitions are transformed on the calling thread, which can take a while for long responses (see loadImpulseResponse()).
+	//! The result is handed to the audio thread without blocking it, and replaces the current response at the beginning of the next processing block.
+	void		setImpulseResponse( const BufferRef &impulseResponse );
+	//! Loads the impulse response from \a sourceFile, resampled to the Context's samplerate, and transforms it on a worker thread of
+	//! ThreadPool::get(). Returns immediately, and the current response keeps being applied until the new one is ready.
+	void		loadImpulseResponse( const SourceFileRef &sourceFile );
+	//! Returns the most recently set or loaded impulse response, or null if there is none yet.
+	BufferRef	getImpulseResponse() const;
+	//! Returns whether any impulse responses are still being loaded by loadImpulseResponse().
+	bool		isLoading() const	{ return mNumPendingLoads > 0; }
+
+  protected:
+	void initialize()				override;
+	void uninitialize()				override;
+	void process( Buffer *buffer )	override;
+
+  private:
+	struct Engine;
+
+	//! Builds the partitions and state for convolving with \a impulseResponse at the current channel count and frames per block.
+	std::shared_ptr<Engine>	makeEngine( const BufferRef &impulseResponse ) const;
+	//! Records \a impulseResponse as the response of request \a requestId, unless a later request has already set one, and hands it to the audio thread if initialized.
+	void					applyImpulseResponse( const BufferRef &impulseResponse, uint64_t requestId );
+
+	std::shared_ptr<Engine>	mEngine;				// only used on the audio thread, replaced by posted commands and initialize()
+	uint64_t				mEngineRequestId;		// request that mEngine was built for
+	BufferRef				mImpulseResponse;
+	uint64_t				mImpulseResponseRequestId;
+	mutable std::mutex		mImpulseResponseMutex;	// guards mImpulseResponse and mImpulseResponseRequestId
+	std::atomic<uint64_t>	mNumRequests;			// each call to setImpulseResponse() and loadImpulseResponse() is a request
+	std::atomic<size_t>		mNumPendingLoads;
+};
+
+} } // namespace cinder::audio
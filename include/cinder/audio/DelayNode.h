@@ -39,7 +39,7 @@ class CI_API DelayNode : public Node {
 	//! Constructs a DelayNode with an optional \a format.
 	DelayNode( const Format &format = Format() );
 
-	//! Sets the maximimum delay in seconds.
+	//! Sets the maximimum delay in seconds. The delay buffer is allocated on the calling thread and replaces the current one at the beginning of the next processing block.
 	void	setMaxDelaySeconds( float seconds );
 	//! Returns the maximum delay in seconds.
 	float	getMaxDelaySeconds() const		{ return mMaxDelaySeconds; }
@@ -0,0 +1,91 @@
+/*
+ Copyright (c) 2016, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/audio/Node.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cinder { namespace audio {
+
+//! \brief Processes independent branches of a Node graph in parallel, used by Context when it has worker threads (see Context::setNumWorkerThreads()).
+//!
+//! The schedule holds every summing (not in-place) Node in the graph except the OutputNode, sorted into levels so that a Node only
+//! depends on Node's in lower levels. Summing Node's only process once per block, so when the schedule is processed at the start of
+//! a block, the regular depth-first pull from the OutputNode finds their results already computed. Each Node is processed with exactly
+//! the same inputs, in the same order, as when the graph is pulled serially, so the rendered output is identical.
+//!
+//! To expose parallelism, in-place inputs of a summing Node with more than one input are switched to summing themselves, which gives each
+//! of those branches its own buffer. Graphs containing cycles (feedback through a DelayNode) are processed serially.
+//!
+//! Worker threads never allocate or lock while processing. Between blocks they spin, then yield, and eventually sleep until the
+//! next block is processed.
+class CI_API GraphScheduler : private Noncopyable {
+  public:
+	//! Creates a scheduler with \a numWorkerThreads threads, which run alongside the audio thread.
+	explicit GraphScheduler( size_t numWorkerThreads );
+	~GraphScheduler();
+
+	//! Rebuilds the schedule for the graph pulled by \a output and \a autoPulledNodes. Must be called on a non-audio thread while holding the Context's mutex.
+	void	build( const NodeRef &output, const std::set<NodeRef> &autoPulledNodes );
+	//! Marks the schedule as stale, after which process() does nothing until build() is called again. Called when the graph's connections change.
+	void	invalidate()						{ mValid = false; }
+	//! Returns whether the schedule matches the graph.
+	bool	isValid() const						{ return mValid; }
+
+	//! Processes every scheduled Node for the current block. Must be called on the audio thread while holding the Context's mutex, before the OutputNode is pulled.
+	void	process();
+
+	//! Returns the number of worker threads, not counting the audio thread.
+	size_t	getNumWorkerThreads() const			{ return mThreads.size(); }
+	//! Returns the number of Node's that are processed by the schedule.
+	size_t	getNumScheduledNodes() const		{ return mNodes.size(); }
+	//! Returns the number of levels in the schedule, each of which must complete before the next can start.
+	size_t	getNumLevels() const				{ return mLevelOffsets.empty() ? 0 : mLevelOffsets.size() - 1; }
+	//! Returns true if called from one of this scheduler's worker threads.
+	bool	isWorkerThread() const;
+
+  private:
+	void	threadEntry();
+	//! Claims and processes one Node from the current level. Returns false if there were none left.
+	bool	processNextNode();
+	void	clear();
+
+	std::vector<NodeRef>		mNodes;			// sorted by level
+	std::vector<size_t>			mLevelOffsets;	// index of the first Node in each level, plus one past the last
+	std::atomic<bool>			mValid;
+
+	std::vector<std::thread>	mThreads;
+	std::atomic<uint64_t>		mWork;			// ( end << 32 ) | next, indices into mNodes of the level being processed
+	std::atomic<size_t>			mNumPending;	// Node's in the current level that haven't finished
+	std::atomic<size_t>			mNumSleeping;
+	std::atomic<bool>			mShouldQuit;
+	std::mutex					mSleepMutex;
+	std::condition_variable		mSleepCondition;
+};
+
+} } // namespace cinder::audio
@@ -29,6 +29,7 @@
 
 #include <memory>
 #include <atomic>
+#include <functional>
 #include <set>
 
 namespace cinder { namespace audio {
@@ -221,6 +222,10 @@ class CI_API Node : public std::enable_shared_from_this<Node>, private Noncopyab
 	//! Unless scheduled (with Context::schedule()), this will be [0, getFramesPerBlock()]
 	const std::pair<size_t, size_t>& getProcessFramesRange() const	{ return mProcessFramesRange; }
 
+	//! Posts \a command with Context::postCommand(), keeping this Node alive until it has been called. The reference is released right
+	//! after the call, while anything else \a command captures is still destroyed on a non-audio thread.
+	void postCommand( const std::function<void ()> &command );
+
 	void initializeImpl();
 	void uninitializeImpl();
 
@@ -233,7 +238,7 @@ class CI_API Node : public std::enable_shared_from_this<Node>, private Noncopyab
 
 	std::weak_ptr<Context>	mContext;
 	std::atomic<bool>		mEnabled;
-	std::atomic<bool>		mEventScheduled;
+	std::atomic<size_t>		mNumScheduledEvents; // incremented when an event is scheduled, decremented on the audio thread when it completes or is canceled
 	bool					mInitialized;
 	bool					mAutoEnabled;
 	bool					mProcessInPlace;
@@ -251,6 +256,7 @@ class CI_API Node : public std::enable_shared_from_this<Node>, private Noncopyab
 
 	friend class Context;
 	friend class Param;
+	friend class GraphScheduler;
 };
 
 //! Enable connection syntax: `input >> output`, which is equivelant to `input->connect( output )`. Enables chaining.  \return the connected \a output
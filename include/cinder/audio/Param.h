@@ -89,7 +89,8 @@ class CI_API Event {
 //! You can also set a Node as the 'processor' with Param::setProcessor(), enabling you to control it with an arbitrary signal.
 //!
 //! A Param is owned by a parent Node, from which it gains access to the current Context.  This is a necessary step in making it sample
-//! accurate yet still controllable in a thread-safe manager on the user thread.
+//! accurate yet still controllable in a thread-safe manager on the user thread. Changes made on the user thread are handed to the audio thread
+//! with Context::postCommand() and take effect at the beginning of the next processing block, so automating a Param never blocks on the audio thread.
 //!
 //! \note Ramp Events should not overlap, or you may get discontinuities in the evaluated curve. This could potentially happen when
 //! using multiple appendRamp() calls. Instead, use applyRamp() and set Options::beginTime() accordingly, which will remove any
@@ -154,7 +155,7 @@ class CI_API Param {
 
 	//! Resets Param, blowing away any Event's or processing Node. \note Must be called from a non-audio thread.
 	void reset();
-	//! Returns the number of Event's that are currently scheduled.
+	//! Returns the number of Event's that are currently scheduled. \note Blocks on the Context's mutex, in order to apply changes that haven't been processed yet.
 	size_t getNumEvents() const;
 
 	//! Evaluates the Param for the current processing block, with current time determined from the parent Node's Context.
@@ -173,13 +174,20 @@ class CI_API Param {
 
   protected:
 
-	// non-locking protected methods
+	//! Posts \a command to the Context with Context::postCommand(), keeping the parent Node alive until it has been called.
+	void		postCommand( const std::function<void ()> &command );
+	//! Posts a command that adds \a event after any scheduled Event's. If \a replace is true, Event's that begin after \a event does and any processing Node are removed first.
+	void		postEvent( const EventRef &event, bool replace );
+
+	// non-locking protected methods, called on the audio thread
 	void		initInternalBuffer();
-	void		resetImpl();
+	//! Cancels all Event's and removes the processing Node, moving them into \a removedEvents and \a removedProcessor so that they aren't destroyed on the audio thread.
+	void		resetImpl( std::list<EventRef> *removedEvents, NodeRef *removedProcessor );
 	void		removeEventsAt( double time );
 	ContextRef	getContext() const;
 
 	std::list<EventRef>	mEvents;
+	EventRef			mLastEvent; // the most recently scheduled Event, accessed atomically from non-audio threads
 	std::atomic<float>	mValue;
 	bool				mIsVaryingThisBlock;
 	Node*				mParentNode;
@@ -25,11 +25,10 @@
 
 #include "cinder/audio/InputNode.h"
 #include "cinder/audio/Source.h"
+#include "cinder/audio/StreamScheduler.h"
 #include "cinder/audio/dsp/RingBuffer.h"
 
-#include <thread>
 #include <mutex>
-#include <condition_variable>
 
 namespace cinder { namespace audio {
 
@@ -125,7 +124,11 @@ class CI_API BufferPlayerNode : public SamplePlayerNode {
 	BufferRef mBuffer;
 };
 
-//! File-based SamplePlayerNode, where samples are constantly streamed from file. Suitable for large audio files.
+//! \brief File-based SamplePlayerNode, where samples are constantly streamed from file. Suitable for large audio files.
+//!
+//! When reading asynchronously, the file is read by the worker threads of StreamScheduler::get(), which are shared by all FilePlayerNode's.
+//! While the FilePlayerNode isn't playing, its buffers are filled from the current read position ahead of time, so that start() (or
+//! seek() followed by enable()) can play without waiting on the file.
 class CI_API FilePlayerNode : public SamplePlayerNode {
   public:
 	//! Constructs a FilePlayerNode with optional \a format.
@@ -137,7 +140,7 @@ class CI_API FilePlayerNode : public SamplePlayerNode {
 	void stop() override;
 	void seek( size_t readPositionFrames ) override;
 
-	//! Returns whether reading occurs asynchronously (default is false). If true, file reading is done from an internal thread, if false it is done directly on the audio thread.
+	//! Returns whether reading occurs asynchronously (default is true). If true, file reading is done by StreamScheduler's worker threads, if false it is done directly on the audio thread.
 	bool isReadAsync() const	{ return mIsReadAsync; }
 
 	//! \note \a sourceFile's samplerate is forced to match this Node's Context. Resets the loop points to 0:getNumFrames()).
@@ -156,11 +159,15 @@ class CI_API FilePlayerNode : public SamplePlayerNode {
 	void disableProcessing()		override;
 	void process( Buffer *buffer )	override;
 
-	void readAsyncImpl();
-	void readImpl();
-	void seekImpl( size_t readPos );
-	void stopImpl();
-	void destroyReadThreadImpl();
+	//! Called by a StreamScheduler worker thread. Reads until the ring buffers are full, so that a single request covers everything consumed since the last one.
+	void	readAsyncImpl();
+	//! Reads one chunk from the file into the ring buffers and returns the number of frames read.
+	size_t	readImpl();
+	void	seekImpl( size_t readPos );
+	void	stopImpl();
+	//! Asks for a read that must complete before the \a numFramesBuffered frames left in the ring buffers have been played.
+	void	requestAsyncRead( size_t numFramesBuffered );
+	void	removeStreamImpl();
 
 	std::vector<dsp::RingBuffer>				mRingBuffers;	// used to transfer samples from io to audio thread, one ring buffer per channel
 	BufferDynamic								mIoBuffer;		// used to read samples from the file on read thread, resizeable so the ringbuffer can be filled
@@ -169,10 +176,11 @@ class CI_API FilePlayerNode : public SamplePlayerNode {
 	size_t										mBufferFramesThreshold, mRingBufferPaddingFactor;
 	std::atomic<uint64_t>						mLastUnderrun, mLastOverrun;
 
-	std::unique_ptr<std::thread>				mReadThread;
+	StreamSchedulerRef							mStreamScheduler;
+	StreamScheduler::StreamRef					mStream;
 	std::mutex									mAsyncReadMutex;
-	std::condition_variable						mIssueAsyncReadCond;
-	bool										mIsReadAsync, mAsyncReadShouldQuit;
+	std::atomic<size_t>							mCuedReadPos;	// read position the ring buffers were filled from while not playing, or -1 if they may have been consumed
+	bool										mIsReadAsync;
 };
 
 } } // namespace cinder::audio
@@ -24,6 +24,7 @@
 #pragma once
 
 #include "cinder/audio/Buffer.h"
+#include "cinder/audio/dsp/Converter.h"
 #include "cinder/DataSource.h"
 #include "cinder/Noncopyable.h"
 
@@ -107,6 +108,14 @@ class CI_API SourceFile : public Source {
 	//! Returns the length in seconds.
 	double	getNumSeconds() const						{ return (double)getNumFrames() / (double)getSampleRate(); }
 
+	//! \brief Sets the samplerate converter that is used when the output samplerate differs from the file's, trading quality for speed. Default is dsp::ConverterType::DEFAULT.
+	//!
+	//! Resets the conversion state, so it is best called before reading. The type is carried over to clone() and cloneWithSampleRate(). Ignored by
+	//! implementations that convert samplerates themselves (Core Audio on OS X and iOS).
+	void				setConverterType( dsp::ConverterType type );
+	//! Returns the samplerate converter that is used when the output samplerate differs from the file's.
+	dsp::ConverterType	getConverterType() const		{ return mConverterType; }
+
 	//! Returns a vector of extensions that SourceFile support for loading. Suitable for the \a extensions parameter of getOpenFilePath().
 	static std::vector<std::string>	getSupportedExtensions();
 
@@ -118,7 +127,8 @@ class CI_API SourceFile : public Source {
 	//! Sets up samplerate conversion if needed. Can be overridden by implementation if they handle samplerate conversion in a specific way, else it is handled generically with a dsp::Converter.
 	virtual void setupSampleRateConversion();
 
-	size_t mNumFrames, mFileNumFrames, mReadPos;
+	size_t				mNumFrames, mFileNumFrames, mReadPos;
+	dsp::ConverterType	mConverterType;
 };
 
 //! Convenience method for loading a SourceFile from \a dataSource. \return SourceFileRef. \see SourceFile::create()
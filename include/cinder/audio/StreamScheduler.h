@@ -0,0 +1,102 @@
+/*
+ Copyright (c) 2016, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/Cinder.h"
+#include "cinder/Export.h"
+#include "cinder/Noncopyable.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cinder { namespace audio {
+
+typedef std::shared_ptr<class StreamScheduler>	StreamSchedulerRef;
+
+//! \brief Small pool of threads shared by every streaming Node (such as FilePlayerNode) that refills their buffers, most urgent first.
+//!
+//! Each stream is registered with a read function and requests reads from the audio thread when its buffer runs low, along with a deadline of
+//! when the buffer would run dry. Worker threads always service the pending request with the earliest deadline. A stream that requests again
+//! before it has been serviced still gets only one read (with the earlier of the two deadlines), which is expected to fill its whole buffer.
+class CI_API StreamScheduler : private Noncopyable {
+  public:
+	typedef std::chrono::steady_clock	Clock;
+	typedef std::function<void ()>		ReadFn;
+
+	//! A stream registered with addStream().
+	class CI_API Stream : private Noncopyable {
+	  public:
+		//! Requests that the stream's read function be called on a worker thread before \a deadline. Safe to call from the audio thread, as it doesn't block or allocate.
+		void	requestRead( Clock::time_point deadline );
+
+	  private:
+		Stream( StreamScheduler *scheduler, const ReadFn &readFn );
+
+		StreamScheduler*				mScheduler;
+		ReadFn							mReadFn;
+		std::atomic<bool>				mReadRequested;
+		std::atomic<Clock::rep>			mDeadline;		// time_since_epoch() of the earliest pending deadline
+		bool							mReading;		// guarded by the scheduler's mutex
+
+		friend class StreamScheduler;
+	};
+
+	typedef std::shared_ptr<Stream>	StreamRef;
+
+	//! Returns the scheduler shared by all streaming Node's, creating it with the default number of threads the first time it is called.
+	static const StreamSchedulerRef&	get();
+
+	//! Creates a scheduler with \a numThreads worker threads.
+	explicit StreamScheduler( size_t numThreads = 2 );
+	~StreamScheduler();
+
+	//! Registers a stream that will call \a readFn on a worker thread whenever it requests a read.
+	StreamRef	addStream( const ReadFn &readFn );
+	//! Unregisters \a stream, blocking until its read function has returned if a worker thread is currently calling it. Must not be called from within a read function.
+	void		removeStream( const StreamRef &stream );
+
+	//! Returns the number of worker threads.
+	size_t		getNumThreads() const	{ return mThreads.size(); }
+	//! Returns the number of registered streams.
+	size_t		getNumStreams() const;
+
+  private:
+	void		threadEntry();
+	//! Returns the requested stream with the earliest deadline that isn't already being read, or null if there are none. Must be called with mMutex held.
+	Stream*		findNextStream() const;
+
+	std::vector<StreamRef>		mStreams;
+	std::vector<std::thread>	mThreads;
+	mutable std::mutex			mMutex;
+	std::condition_variable		mRequestCondition, mReadFinishedCondition;
+	std::atomic<uint64_t>		mNumRequests;
+	bool						mShouldQuit;
+};
+
+} } // namespace cinder::audio
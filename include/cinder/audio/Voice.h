@@ -26,6 +26,7 @@
 #include "cinder/audio/InputNode.h"
 #include "cinder/audio/SamplePlayerNode.h"
 #include "cinder/audio/Source.h"
+#include "cinder/audio/VoicePoolNode.h"
 
 #include <memory>
 
@@ -44,6 +45,8 @@ typedef std::shared_ptr<class VoiceSamplePlayerNode> VoiceSamplePlayerNodeRef;
 //! Underneath, playback is managed by a Node, which can be retrieved via the virtual getNode() method to
 //! perform more complex tasks.
 //!
+//! Each Voice creates and connects its own Node's, so for many short one-shot sounds use getVoicePool() instead.
+//!
 class CI_API Voice {
   public:
 	//! Optional parameters passed into Voice::create() methods.
@@ -85,6 +88,13 @@ class CI_API Voice {
 	static VoiceRef create( const CallbackProcessorFn &callbackFn, const Options &options = Options() );
 	//! Clears all audio file buffers that that are cached in the Mixer
 	static void clearBufferCache();
+	//! Returns the Buffer holding the contents of \a sourceFile, loading it into the cache the first time. Safe to call from any thread.
+	static BufferRef loadBuffer( const SourceFileRef &sourceFile );
+	//! Returns the Buffer holding the contents of \a sourceFile resampled to \a sampleRate, loading it into the cache the first time.
+	//! The cache is keyed by \a sourceFile itself, so unlike loading a SourceFile::cloneWithSampleRate() it is only decoded once, unless several threads miss the cache at the same time. \a sourceFile is never read from, it is cloned for decoding.
+	static BufferRef loadBuffer( const SourceFileRef &sourceFile, size_t sampleRate );
+	//! Returns a VoicePoolNode connected to master()->getOutput(), which plays one-shot sounds without creating a Node for each. \see VoicePoolNode::play()
+	static const VoicePoolNodeRef& getVoicePool();
 
 	//! Starts the Voice. Does nothing if currently playing. \note In the case of a VoiceSamplePlayerNode and the sample has reached EOF, start() will start from the beginning.
 	virtual void start();
@@ -0,0 +1,119 @@
+/*
+ Copyright (c) 2016, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include "cinder/audio/InputNode.h"
+#include "cinder/audio/Source.h"
+
+#include <mutex>
+#include <vector>
+
+namespace cinder { namespace audio {
+
+typedef std::shared_ptr<class VoicePoolNode>	VoicePoolNodeRef;
+
+//! \brief InputNode that mixes a fixed number of preallocated voices, each playing an in-memory Buffer, in a single process() call.
+//!
+//! Suited to triggering many short one-shot sounds: play() doesn't allocate Node's, make connections or block on the Context's mutex,
+//! as the voice state is handed to the audio thread with Context::postCommand(). When all voices are busy, play() steals the voice
+//! that was started longest ago. Output is stereo. Mono Buffers are placed with equal power panning, while the channels of stereo Buffers
+//! are balanced. A pitch other than 1 resamples the Buffer with linear interpolation.
+//!
+//! The pool is enabled when it is created, and voices only produce sound while it is enabled.
+class CI_API VoicePoolNode : public InputNode {
+  public:
+	//! Identifies a sound started with play(). Ids aren't reused, so controlling a sound that has finished or was stolen does nothing.
+	typedef uint64_t VoiceId;
+
+	//! Constructs a VoicePoolNode with \a numVoices voices. \a format's channels are ignored, output is always stereo.
+	VoicePoolNode( size_t numVoices = 32, const Format &format = Format() );
+	virtual ~VoicePoolNode();
+
+	//! \brief Plays \a buffer on a free voice (or the oldest one, if all are busy) and returns the id of the sound.
+	//!
+	//! \a buffer is expected to be at the Context's samplerate and have one or two channels. \a pan ranges from 0 (left) to 1 (right).
+	//! \a pitch scales the playback rate. If \a when is greater than getContext()->getNumProcessedSeconds(), playback begins on the
+	//! exact frame at \a when seconds, otherwise it begins at the next processing block.
+	VoiceId	play( const BufferRef &buffer, float gain = 1, float pan = 0.5f, float pitch = 1, double when = 0 );
+	//! Plays the contents of \a sourceFile, which are loaded into the Buffer cache shared with Voice the first time. \see Voice::loadBuffer()
+	VoiceId	play( const SourceFileRef &sourceFile, float gain = 1, float pan = 0.5f, float pitch = 1, double when = 0 );
+
+	//! Stops the sound identified by \a id.
+	void	stop( VoiceId id );
+	//! Stops every voice.
+	void	stopAll();
+	//! Sets the gain of the sound identified by \a id.
+	void	setGain( VoiceId id, float gain );
+	//! Sets the pan of the sound identified by \a id, from 0 (left) to 1 (right).
+	void	setPan( VoiceId id, float pan );
+	//! Sets the playback rate of the sound identified by \a id.
+	void	setPitch( VoiceId id, float pitch );
+
+	//! Returns whether the sound identified by \a id is playing or waiting to start. Sounds that have finished, were stolen or were stopped (as of the last processing block) are not playing.
+	bool	isPlaying( VoiceId id ) const;
+	//! Returns the number of voices in the pool.
+	size_t	getNumVoices() const	{ return mSlots.size(); }
+	//! Returns the number of voices that are playing or waiting to start.
+	size_t	getNumPlayingVoices() const;
+	//! Returns the number of times play() had to steal a busy voice.
+	uint64_t getNumStolenVoices() const	{ return mNumStolenVoices; }
+
+  protected:
+	void process( Buffer *buffer ) override;
+
+  private:
+	// Voice as seen from the calling threads, guarded by mSlotsMutex.
+	struct Slot {
+		BufferRef	mBuffer;		// keeps the Buffer played by the audio thread alive
+		VoiceId		mId;
+		uint64_t	mStartOrder;	// used to find the oldest voice to steal
+	};
+
+	// Voice as seen from the audio thread, only modified by posted commands and process().
+	struct VoiceState {
+		const Buffer*	mBuffer;
+		VoiceId			mId;
+		double			mReadPos;
+		uint64_t		mStartFrame;
+		float			mGain, mPan, mPitch;
+		bool			mPlaying;
+	};
+
+	//! Posts \a command for the voice in \a id's slot, which is only called if that voice is still playing the sound identified by \a id.
+	void	postVoiceCommand( VoiceId id, const std::function<void ( VoiceState & )> &command );
+	//! Mixes \a numFrames frames of \a voice into \a buffer, starting at \a offset. Returns false when the voice has reached the end of its Buffer.
+	bool	mixVoice( VoiceState &voice, Buffer *buffer, size_t offset, size_t numFrames );
+	void	finishVoice( size_t slotIndex );
+
+	std::vector<Slot>					mSlots;
+	mutable std::mutex					mSlotsMutex;
+	uint64_t							mNumPlayCalls;
+	std::atomic<uint64_t>				mNumStolenVoices;
+
+	std::vector<VoiceState>				mVoiceStates;
+	std::vector<std::atomic<VoiceId>>	mFinishedIds;	// id of the last sound each voice finished, written by the audio thread
+};
+
+} } // namespace cinder::audio
@@ -84,6 +84,8 @@ class CI_API Biquad {
     void getFrequencyResponse( int nFrequencies, const float *frequency, float *magResponse, float *phaseResponse );
 	//! Resets filter state
     void reset();
+	//! Returns the normalized coefficients of the difference equation y[n] = b0 * x[n] + b1 * x[n-1] + b2 * x[n-2] - a1 * y[n-1] - a2 * y[n-2].
+	void getCoefficients( double *b0, double *b1, double *b2, double *a1, double *a2 ) const;
 
   private:
     void setNormalizedCoefficients( double b0, double b1, double b2, double a0, double a1, double a2 );
@@ -0,0 +1,114 @@
+/*
+ Copyright (c) 2016, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include "cinder/Export.h"
+#include "cinder/audio/Buffer.h"
+
+#include <vector>
+
+namespace cinder { namespace audio { namespace dsp {
+
+class Biquad;
+
+namespace detail {
+
+//! Number of channels that BiquadBank processes together, one per SIMD lane.
+const size_t BIQUAD_LANES = 8;
+
+//! One cascade section for a group of BIQUAD_LANES channels, laid out so that each field fills a SIMD register. Used internally by BiquadBank.
+struct BiquadLanes {
+	float b0[BIQUAD_LANES], b1[BIQUAD_LANES], b2[BIQUAD_LANES], a1[BIQUAD_LANES], a2[BIQUAD_LANES];
+	//! Added to the coefficients after each frame while they are being interpolated.
+	float db0[BIQUAD_LANES], db1[BIQUAD_LANES], db2[BIQUAD_LANES], da1[BIQUAD_LANES], da2[BIQUAD_LANES];
+	//! Transposed direct form II state.
+	float z1[BIQUAD_LANES], z2[BIQUAD_LANES];
+};
+
+} // namespace detail
+
+//! \brief Processes many channels through cascades of biquad (two-pole, two-zero) sections at once.
+//!
+//! Channels are processed in groups of eight, one per SIMD lane (see getSimdLevel()), in single precision and in transposed direct form II,
+//! which keeps round-off error low in float. Each channel can have different coefficients for each section. Coefficient changes can
+//! optionally be interpolated across the next call to process(), so that modulating a filter doesn't produce zipper noise.
+//!
+//! Not thread-safe; setting coefficients and processing are expected to happen on the same (audio) thread.
+class CI_API BiquadBank {
+  public:
+	//! Normalized coefficients of one section, for the difference equation y[n] = b0 * x[n] + b1 * x[n-1] + b2 * x[n-2] - a1 * y[n-1] - a2 * y[n-2].
+	struct Coefficients {
+		//! Constructs pass-through coefficients.
+		Coefficients() : b0( 1 ), b1( 0 ), b2( 0 ), a1( 0 ), a2( 0 )	{}
+		Coefficients( float b0, float b1, float b2, float a1, float a2 ) : b0( b0 ), b1( b1 ), b2( b2 ), a1( a1 ), a2( a2 )	{}
+		//! Copies the coefficients of \a biquad.
+		explicit Coefficients( const Biquad &biquad );
+
+		bool operator==( const Coefficients &rhs ) const	{ return b0 == rhs.b0 && b1 == rhs.b1 && b2 == rhs.b2 && a1 == rhs.a1 && a2 == rhs.a2; }
+		bool operator!=( const Coefficients &rhs ) const	{ return ! ( *this == rhs ); }
+
+		float b0, b1, b2, a1, a2;
+	};
+
+	//! Constructs a BiquadBank with \a numChannels channels, each a cascade of \a numSections pass-through sections.
+	BiquadBank( size_t numChannels = 0, size_t numSections = 1 );
+
+	//! Resizes to \a numChannels channels of \a numSections sections, resetting all coefficients to pass-through and clearing the filter state. Allocates.
+	void	setSize( size_t numChannels, size_t numSections );
+	//! Returns the number of channels.
+	size_t	getNumChannels() const		{ return mNumChannels; }
+	//! Returns the number of sections that each channel is processed through, in series.
+	size_t	getNumSections() const		{ return mNumSections; }
+
+	//! Sets the coefficients of \a section for \a channel. If interpolation is enabled, they are reached by the end of the next call to process().
+	void	setCoefficients( size_t channel, size_t section, const Coefficients &coefficients );
+	//! Sets the coefficients of \a section for every channel.
+	void	setCoefficients( size_t section, const Coefficients &coefficients );
+	//! Returns the coefficients of \a section for \a channel, which may still be being interpolated towards.
+	const Coefficients&	getCoefficients( size_t channel, size_t section ) const	{ return mCoefficients[channel * mNumSections + section]; }
+
+	//! Sets whether coefficient changes are interpolated linearly, per frame, across the next call to process(). Default is false. Changes made before
+	//! the first call to process() after setSize() or reset() are applied immediately, as there is no previous output for them to be continuous with.
+	void	setInterpolationEnabled( bool enable = true )	{ mInterpolationEnabled = enable; }
+	//! Returns whether coefficient changes are interpolated.
+	bool	isInterpolationEnabled() const					{ return mInterpolationEnabled; }
+
+	//! Processes every channel of \a buffer in place. \a buffer must have getNumChannels() channels.
+	void	process( Buffer *buffer );
+	//! Clears the filter state of every section.
+	void	reset();
+
+  private:
+	//! Copies mCoefficients into the sections, or if \a interpolate is true, sets the increments that reach them over \a numFrames.
+	void	updateLanes( bool interpolate, size_t numFrames );
+
+	size_t								mNumChannels, mNumSections;
+	std::vector<detail::BiquadLanes>	mLanes;				// group * mNumSections + section
+	std::vector<Coefficients>			mCoefficients;		// channel * mNumSections + section
+	std::vector<float>					mFrames;			// a chunk of one group's frames, interleaved
+	bool								mCoefficientsDirty, mInterpolationEnabled, mHasProcessed;
+};
+
+} } } // namespace cinder::audio::dsp
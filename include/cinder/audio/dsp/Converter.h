@@ -31,11 +31,19 @@
 
 namespace cinder { namespace audio { namespace dsp {
 
+//! Selects the samplerate converter that Converter::create() returns. The polyphase presets trade quality for speed and latency, see ConverterImplPolyphase.
+enum class ConverterType {
+	DEFAULT,			//!< the platform's converter: Core Audio on OS X and iOS, r8brain elsewhere. Highest quality.
+	POLYPHASE_FAST,		//!< ConverterImplPolyphase with a 16 tap filter, about 50 dB of stopband attenuation.
+	POLYPHASE_MEDIUM,	//!< ConverterImplPolyphase with a 32 tap filter, about 70 dB of stopband attenuation.
+	POLYPHASE_HIGH		//!< ConverterImplPolyphase with a 64 tap filter, about 90 dB of stopband attenuation.
+};
+
 //! A platform-specific converter that supports samplerate and channel conversion.
 class CI_API Converter {
   public:
 	//! If \a destSampleRate is 0, it is set to match \a sourceSampleRate. If \a destNumChannels is 0, it is set to match \a sourceNumChannels.
-	static std::unique_ptr<Converter> create( size_t sourceSampleRate, size_t destSampleRate, size_t sourceNumChannels, size_t destNumChannels, size_t sourceMaxFramesPerBlock );
+	static std::unique_ptr<Converter> create( size_t sourceSampleRate, size_t destSampleRate, size_t sourceNumChannels, size_t destNumChannels, size_t sourceMaxFramesPerBlock, ConverterType type = ConverterType::DEFAULT );
 
 	virtual ~Converter() {}
 
@@ -45,6 +53,10 @@ class CI_API Converter {
 
 	//! Clears the state of the converter, discarding / flushing accumulated samples. Optional for implementations.
 	virtual void clear()	{}
+	//! \brief Writes frames that the converter is still holding back into \a destBuffer, as if the source were followed by silence. Returns the number of frames written.
+	//!
+	//! Call once the source has ended, until it returns 0, so that the output is as long as the source. Call clear() before converting again. The default implementation writes nothing.
+	virtual size_t flush( Buffer *destBuffer )	{ return 0; }
 
 	size_t getSourceSampleRate()		const		{ return mSourceSampleRate; }
 	size_t getDestSampleRate()			const		{ return mDestSampleRate; }
@@ -84,9 +96,12 @@ void convert( const FloatT *sourceArray, int16_t *destArray, size_t length )
 	const FloatT intNormalizer = 32768;
 
 	for( size_t i = 0; i < length; i++ )
-		destArray[i] = int16_t( sourceArray[i] * intNormalizer );
+		destArray[i] = int16_t( std::max( std::min( sourceArray[i] * intNormalizer, (FloatT)32767 ), -intNormalizer ) );
 }
 
+//! Converts a float array to int16_t, using SIMD instructions when available (see getSimdLevel()). Values outside of [-1, 1) are clamped.
+CI_API void convert( const float *sourceArray, int16_t *destArray, size_t length );
+
 //! Converts an int16_t array to float or double
 template<typename FloatT>
 void convert( const int16_t *sourceArray, FloatT *destArray, size_t length )
@@ -97,6 +112,9 @@ void convert( const int16_t *sourceArray, FloatT *destArray, size_t length )
 		destArray[i] = (FloatT)sourceArray[i] * floatNormalizer;
 }
 
+//! Converts an int16_t array to float, using SIMD instructions when available (see getSimdLevel()).
+CI_API void convert( const int16_t *sourceArray, float *destArray, size_t length );
+
 //! Converts between two BufferT's of different precision (ex. float to double).  The number of frames converted is the lesser of the two. The number of channels converted is the lesser of the two.
 template <typename SourceT, typename DestT>
 void convertBuffer( const BufferT<SourceT> *sourceBuffer, BufferT<DestT> *destBuffer )
@@ -121,6 +139,9 @@ void convertInt24ToFloat( const char *sourceArray, FloatT *destArray, size_t len
 	}
 }
 
+//! Converts the 24-bit int \a sourceArray to float, using SIMD instructions when available (see getSimdLevel()).
+CI_API void convertInt24ToFloat( const char *sourceArray, float *destArray, size_t length );
+
 //! Converts the floating point \a sourceArray to 24-bit int precision, placing the result in \a destArray. \a length samples are converted.
 template<typename FloatT>
 void convertFloatToInt24( const FloatT *sourceArray, char *destArray, size_t length )
@@ -135,6 +156,9 @@ void convertFloatToInt24( const FloatT *sourceArray, char *destArray, size_t len
 	}
 }
 
+//! Converts the float \a sourceArray to 24-bit int precision, using SIMD instructions when available (see getSimdLevel()).
+CI_API void convertFloatToInt24( const float *sourceArray, char *destArray, size_t length );
+
 //! Interleaves \a numCopyFrames of \a nonInterleavedSourceArray, placing the result in \a interleavedDestArray. \a numFramesPerChannel and \a numChannels describe the layout of the non-interleaved array.
 template<typename T>
 void interleave( const T *nonInterleavedSourceArray, T *interleavedDestArray, size_t numFramesPerChannel, size_t numChannels, size_t numCopyFrames )
@@ -149,6 +173,9 @@ void interleave( const T *nonInterleavedSourceArray, T *interleavedDestArray, si
 	}
 }
 
+//! Interleaves float samples as above. Mono and stereo layouts use SIMD instructions when available (see getSimdLevel()).
+CI_API void interleave( const float *nonInterleavedSourceArray, float *interleavedDestArray, size_t numFramesPerChannel, size_t numChannels, size_t numCopyFrames );
+
 //! Interleaves \a numCopyFrames of \a nonInterleavedFloatSourceArray and converts from floating point to 16-bit int precision at the same time, placing the result in \a interleavedInt16DestArray. \a numFramesPerChannel and \a numChannels describe the layout of the non-interleaved array.
 template<typename FloatT>
 void interleave( const FloatT *nonInterleavedFloatSourceArray, int16_t *interleavedInt16DestArray, size_t numFramesPerChannel, size_t numChannels, size_t numCopyFrames )
@@ -159,12 +186,15 @@ void interleave( const FloatT *nonInterleavedFloatSourceArray, int16_t *interlea
 		size_t x = ch;
 		const FloatT *sourceChannel = &nonInterleavedFloatSourceArray[ch * numFramesPerChannel];
 		for( size_t i = 0; i < numCopyFrames; i++ ) {
-			interleavedInt16DestArray[x] = int16_t( sourceChannel[i] * intNormalizer );
+			interleavedInt16DestArray[x] = int16_t( std::max( std::min( sourceChannel[i] * intNormalizer, (FloatT)32767 ), -intNormalizer ) );
 			x += numChannels;
 		}
 	}
 }
 
+//! Interleaves and converts float samples to 16-bit int as above. Mono and stereo layouts use SIMD instructions when available (see getSimdLevel()).
+CI_API void interleave( const float *nonInterleavedFloatSourceArray, int16_t *interleavedInt16DestArray, size_t numFramesPerChannel, size_t numChannels, size_t numCopyFrames );
+
 //! De-interleaves \a numCopyFrames of \a interleavedSourceArray, placing the result in \a nonInterleavedDestArray. \a numFramesPerChannel and \a numChannels describe the layout of the non-interleaved array.
 template<typename T>
 void deinterleave( const T *interleavedSourceArray, T *nonInterleavedDestArray, size_t numFramesPerChannel, size_t numChannels, size_t numCopyFrames )
@@ -179,6 +209,9 @@ void deinterleave( const T *interleavedSourceArray, T *nonInterleavedDestArray,
 	}
 }
 
+//! De-interleaves float samples as above. Mono and stereo layouts use SIMD instructions when available (see getSimdLevel()).
+CI_API void deinterleave( const float *interleavedSourceArray, float *nonInterleavedDestArray, size_t numFramesPerChannel, size_t numChannels, size_t numCopyFrames );
+
 //! De-interleaves \a numCopyFrames of \a interleavedInt16SourceArray and converts from 16-bit int to floating point precision at the same time, placing the result in \a nonInterleavedFloatDestArray. \a numFramesPerChannel and \a numChannels describe the layout of the non-interleaved array.
 template<typename FloatT>
 void deinterleave( const int16_t *interleavedInt16SourceArray, FloatT *nonInterleavedFloatDestArray, size_t numFramesPerChannel, size_t numChannels, size_t numCopyFrames )
@@ -195,6 +228,9 @@ void deinterleave( const int16_t *interleavedInt16SourceArray, FloatT *nonInterl
 	}
 }
 
+//! De-interleaves and converts 16-bit int samples to float as above. Mono and stereo layouts use SIMD instructions when available (see getSimdLevel()).
+CI_API void deinterleave( const int16_t *interleavedInt16SourceArray, float *nonInterleavedFloatDestArray, size_t numFramesPerChannel, size_t numChannels, size_t numCopyFrames );
+
 //! De-interleaves \a numCopyFrames of \a interleavedInt24SourceArray and converts from 24-bit int to floating point precision at the same time, placing the result in \a nonInterleavedFloatDestArray. \a numFramesPerChannel and \a numChannels describe the layout of the non-interleaved array.
 template<typename FloatT>
 void deinterleaveInt24ToFloat( const char *interleavedInt24SourceArray, FloatT *nonInterleavedFloatDestArray, size_t numFramesPerChannel, size_t numChannels, size_t numCopyFrames )
@@ -205,12 +241,17 @@ void deinterleaveInt24ToFloat( const char *interleavedInt24SourceArray, FloatT *
 		size_t x = ch;
 		FloatT *destChannel = &nonInterleavedFloatDestArray[ch * numFramesPerChannel];
 		for( size_t i = 0; i < numCopyFrames; i++ ) {
-			int32_t sample = (int32_t)( ( (int32_t)interleavedInt24SourceArray[2] ) << 16 ) | ( ( (int32_t)(uint8_t)interleavedInt24SourceArray[1] ) << 8 ) | ( (int32_t)(uint8_t)interleavedInt24SourceArray[0] );
+			const char *sourceSample = &interleavedInt24SourceArray[x * 3];
+			int32_t sample = (int32_t)( ( (int32_t)sourceSample[2] ) << 16 ) | ( ( (int32_t)(uint8_t)sourceSample[1] ) << 8 ) | ( (int32_t)(uint8_t)sourceSample[0] );
 			destChannel[i] = (FloatT)sample * floatNormalizer;
 			x += numChannels;
 		}
 	}
 }
+
+//! De-interleaves and converts 24-bit int samples to float as above. Mono layouts use SIMD instructions when available (see getSimdLevel()).
+CI_API void deinterleaveInt24ToFloat( const char *interleavedInt24SourceArray, float *nonInterleavedFloatDestArray, size_t numFramesPerChannel, size_t numChannels, size_t numCopyFrames );
+
 //! Interleaves \a nonInterleavedSource, placing the result in \a interleavedDest.
 template<typename T>
 void interleaveBuffer( const BufferT<T> *nonInterleavedSource, BufferInterleavedT<T> *interleavedDest )
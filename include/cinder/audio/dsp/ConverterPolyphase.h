@@ -0,0 +1,81 @@
+/*
+ Copyright (c) 2016, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/audio/dsp/Converter.h"
+
+#include <vector>
+
+namespace cinder { namespace audio { namespace dsp {
+
+//! \brief \a Converter implementation using a polyphase windowed-sinc filter, selected with one of the ConverterType::POLYPHASE presets.
+//!
+//! The ratio between samplerates is reduced to upsample / downsample factors L / M, and the filter is stored as a table of L phases, each
+//! a short FIR filter that is applied to the source with a SIMD dot product (see dsp::dot()). When L is larger than MAX_NUM_PHASES, the
+//! table holds MAX_NUM_PHASES phases and outputs are interpolated between the two nearest ones. Longer presets have sharper cutoffs and
+//! more stopband attenuation, at the cost of more work per output frame and more latency.
+//!
+//! Output doesn't depend on how the source is split into blocks. Output frames are aligned with the source (there is no delay), but each
+//! one is only written once half a filter length of source frames past it has been converted, which is the latency: 8, 16 or 32 source
+//! frames for the FAST, MEDIUM and HIGH presets when upsampling, and proportionally more when downsampling. flush() writes the frames held back at the end.
+class ConverterImplPolyphase : public Converter {
+  public:
+	//! The largest number of filter phases that are stored. Conversions between common samplerates (ex. 44100 to 48000, which is 160 / 147) need fewer.
+	static const size_t MAX_NUM_PHASES = 1024;
+
+	//! \a type must be one of the ConverterType::POLYPHASE presets.
+	ConverterImplPolyphase( size_t sourceSampleRate, size_t destSampleRate, size_t sourceNumChannels, size_t destNumChannels, size_t sourceMaxFramesPerBlock, ConverterType type );
+
+	std::pair<size_t, size_t>	convert( const Buffer *sourceBuffer, Buffer *destBuffer )	override;
+	void						clear()														override;
+	size_t						flush( Buffer *destBuffer )									override;
+
+	//! Returns the number of taps in each phase of the filter.
+	size_t	getNumTaps() const				{ return mNumTaps; }
+	//! Returns the number of filter phases that are stored.
+	size_t	getNumPhases() const			{ return mNumPhases; }
+
+  private:
+	void	designFilter( size_t halfLength, float beta, float cutoff );
+	//! Appends \a numFrames of \a buffer (which has the resampled channel count) to the history.
+	void	appendHistory( const Buffer *buffer, size_t numFrames );
+	//! Writes up to \a maxFrames output frames to \a destBuffer, stopping once the history runs out or mHistoryPos reaches \a endPos.
+	size_t	resample( Buffer *destBuffer, size_t maxFrames, size_t endPos );
+	//! Discards history frames that no further output depends on.
+	void	compactHistory();
+
+	size_t				mUpsampleFactor, mDownsampleFactor;	// L and M
+	size_t				mNumTaps, mHalfLength, mNumPhases;
+	std::vector<float>	mCoefficients;						// ( mNumPhases + 1 ) rows of mNumTaps, one per fractional position
+
+	Buffer				mHistory;							// source frames that are still needed, one channel per resampler
+	size_t				mNumHistoryFrames;
+	size_t				mHistoryPos;						// first history frame under the filter for the next output
+	uint64_t			mPhase;								// fractional position of the next output, in units of 1 / mUpsampleFactor source frames
+	bool				mFlushing;
+	size_t				mFlushEndPos;						// while flushing, the mHistoryPos of the first output that is past the end of the source
+	Buffer				mMixingBuffer;
+};
+
+} } } // namespace cinder::audio::dsp
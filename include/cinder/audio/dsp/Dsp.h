@@ -58,6 +58,21 @@ CI_API void generateWindow( WindowType windowType, float *window, size_t length
 
 // Vector based math routines.
 
+//! Instruction sets that the vector based math routines below and the sample format conversions in Converter.h can be dispatched to.
+enum class SimdLevel {
+	SCALAR,		//!< plain loops, the reference for the other levels
+	SSE2,
+	AVX2,
+	NEON		//!< only available when compiled for ARM with NEON enabled
+};
+
+//! Returns the instruction set used by the vector based math routines. Defaults to the best one that both the compiler and the CPU support (see System::hasAvx2()). \note When CINDER_AUDIO_VDSP is defined, the math routines use the Accelerate framework regardless and only the conversions in Converter.h are affected.
+CI_API SimdLevel getSimdLevel();
+//! Sets the instruction set used by the vector based math routines, which is useful for comparing against SimdLevel::SCALAR. Returns false and does nothing if \a level isn't supported.
+CI_API bool setSimdLevel( SimdLevel level );
+//! Returns whether \a level is supported by both the compiler and the CPU.
+CI_API bool isSimdLevelSupported( SimdLevel level );
+
 //! fills \a array with value \a value
 CI_API void fill( float value, float *array, size_t length );
 //! add \a scalar to \a array of length \a length, into \a result.
@@ -78,8 +93,14 @@ CI_API void divide( const float *array, float scalar, float *result, size_t leng
 CI_API void divide( const float *arrayA, const float *arrayB, float *result, size_t length );
 //! sums \a length elements of \a arrayA by \a arrayB (element-wise), then scales by \a scalar and places the result at \a result.
 CI_API void addMul( const float *arrayA, const float *arrayB, float scalar, float *result, size_t length );
+//! multiplies \a length elements of \a array by \a scalar, then adds \a addend (element-wise) and places the result at \a result. \a result may be the same as \a addend, for mixing into it.
+CI_API void mulAdd( const float *array, float scalar, const float *addend, float *result, size_t length );
+//! multiplies \a length complex elements of \a realA and \a imagA by those of \a realB and \a imagB (element-wise) and adds the products to \a realResult and \a imagResult. Useful for accumulating products of spectra held in split complex form, as in BufferSpectral.
+CI_API void complexMulAdd( const float *realA, const float *imagA, const float *realB, const float *imagB, float *realResult, float *imagResult, size_t length );
 //! returns the sum of \a array
 CI_API float sum( const float *array, size_t length );
+//! returns the dot product of \a arrayA and \a arrayB, the sum of their element-wise products. Useful for FIR filters, where one array holds the coefficients.
+CI_API float dot( const float *arrayA, const float *arrayB, size_t length );
 //! returns the Root-Mean-Squared value of \a array
 CI_API float rms( const float *array, size_t length );
 //! normalizes \a array to \a maxValue (default = 1)
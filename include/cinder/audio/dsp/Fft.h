@@ -1,71 +1,95 @@
-/*
- Copyright (c) 2014, The Cinder Project
-
- This code is intended to be used with the Cinder C++ library, http://libcinder.org
-
- Redistribution and use in source and binary forms, with or without modification, are permitted provided that
- the following conditions are met:
-
-    * Redistributions of source code must retain the above copyright notice, this list of conditions and
-	the following disclaimer.
-    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
-	the following disclaimer in the documentation and/or other materials provided with the distribution.
-
- THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
- WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
- PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
- ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
- TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
- HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
- NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
- POSSIBILITY OF SUCH DAMAGE.
-*/
-
-#pragma once
-
-#include "cinder/audio/Buffer.h"
-#include "cinder/audio/dsp/Dsp.h"
-
-#include "cinder/Cinder.h"
-
-#include <vector>
-
-#if defined( CINDER_AUDIO_VDSP )
-	#include <Accelerate/Accelerate.h>
-#else
-	#define CINDER_AUDIO_FFT_OOURA
-#endif
-
-namespace cinder { namespace audio { namespace dsp {
-
-//! Real Discrete Fourier Transform (DFT).
-class CI_API Fft {
-  public:
-	//! Constructs an Fft object. \a fftSize must be a power of two and greater than two.
-	Fft( size_t fftSize );
-	~Fft();
-
-	//! Computes the Forward DFT of \a waveform, filling \a spectral with freqency-domain audio data
-	void forward( const Buffer *waveform, BufferSpectral *spectral );
-	//! Computes the Inverse DFT of \a spectral, filling \a waveform with time-domain audio data
-	void inverse( const BufferSpectral *spectral, Buffer *waveform );
-	//! Returns the size of the FFT.
-	size_t getSize() const	{ return mSize; }
-
-  protected:
-	void init();
-
-	size_t				mSize, mSizeOverTwo;
-
-#if defined( CINDER_AUDIO_VDSP )
-	size_t				mLog2FftSize;
-	::FFTSetup			mFftSetup;
-	::DSPSplitComplex	mSplitComplexSignal, mSplitComplexResult;
-#elif defined( CINDER_AUDIO_FFT_OOURA )
-	Buffer				mBufferCopy;
-	int					*mOouraIp;
-	float				*mOouraW;
-#endif
-};
-
-} } } // namespace cinder::audio::dsp
+/*
+ Copyright (c) 2014, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/audio/Buffer.h"
+#include "cinder/audio/dsp/Dsp.h"
+
+#include "cinder/Cinder.h"
+
+#include <memory>
+#include <vector>
+
+#if defined( CINDER_AUDIO_VDSP )
+	#include <Accelerate/Accelerate.h>
+#else
+	#define CINDER_AUDIO_FFT_OOURA
+#endif
+
+namespace cinder {
+
+class ThreadPool;
+
+namespace audio { namespace dsp {
+
+namespace detail {
+
+//! Twiddle factors and other tables for one FFT size, which are created once and shared by every Fft of that size. They are not modified after creation, so any number of threads can transform with them at once.
+struct FftPlan;
+
+} // namespace detail
+
+//! \brief Real Discrete Fourier Transform (DFT).
+//!
+//! The tables for each size are cached, so constructing more than one Fft of the same size (for example one per channel) is cheap. The forward()
+//! overload that transforms a series of overlapping frames (a short-time Fourier transform) can split its work across a ThreadPool.
+class CI_API Fft {
+  public:
+	//! Constructs an Fft object. \a fftSize must be a power of two and greater than two.
+	Fft( size_t fftSize );
+	~Fft();
+
+	//! Computes the Forward DFT of \a waveform, filling \a spectral with freqency-domain audio data
+	void forward( const Buffer *waveform, BufferSpectral *spectral );
+	//! \brief Computes the Forward DFT of \a count frames of \a samples, each one starting \a hop samples after the previous one, filling \a spectrogram.
+	//!
+	//! Frame i is the getSize() samples starting at `samples + i * hop`, multiplied by \a window if it isn't null (getSize() values, see generateWindow()).
+	//! Its spectrum is written to `spectrogram + i * getSize()` with the layout of a BufferSpectral: getSize() / 2 real components followed by
+	//! getSize() / 2 imaginary components. If \a threadPool isn't null, batches of frames are transformed in parallel on it.
+	void forward( const float *samples, size_t hop, size_t count, float *spectrogram, const float *window = nullptr, ThreadPool *threadPool = nullptr );
+	//! Computes the Inverse DFT of \a spectral, filling \a waveform with time-domain audio data
+	void inverse( const BufferSpectral *spectral, Buffer *waveform );
+	//! Returns the size of the FFT.
+	size_t getSize() const	{ return mSize; }
+
+	//! Releases the cached tables of every size. Existing Fft's keep the tables they use, which are released when the last one using them is destroyed.
+	static void clearPlanCache();
+
+  protected:
+	void init();
+	//! Transforms the frame at \a samples, multiplied by \a window if it isn't null, into \a real and \a imag. \a scratch holds getSize() floats. Only reads the plan (except at size 2), so it is safe to call from several threads at once with different \a scratch.
+	void forwardFrame( const float *samples, const float *window, float *scratch, float *real, float *imag ) const;
+
+	size_t								mSize, mSizeOverTwo;
+	std::shared_ptr<detail::FftPlan>	mPlan;
+
+#if defined( CINDER_AUDIO_VDSP )
+	size_t				mLog2FftSize;
+	::DSPSplitComplex	mSplitComplexSignal, mSplitComplexResult;
+#elif defined( CINDER_AUDIO_FFT_OOURA )
+	Buffer				mBufferCopy;
+#endif
+};
+
+} } } // namespace cinder::audio::dsp
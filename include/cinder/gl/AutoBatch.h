@@ -0,0 +1,128 @@
+/*
+ Copyright (c) 2016, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include "cinder/gl/platform.h"
+#include "cinder/Color.h"
+#include "cinder/Matrix.h"
+#include "cinder/Noncopyable.h"
+#include "cinder/Vector.h"
+
+#include <vector>
+
+namespace cinder { namespace gl {
+
+class Context;
+class GlslProg;
+typedef std::shared_ptr<class Vao>	VaoRef;
+typedef std::shared_ptr<class Vbo>	VboRef;
+
+//! Collects the vertices of consecutive convenience draws, such as drawSolidRect() and drawLine(), and issues them with as few draw calls as possible.
+//! A draw is appended to the pending ones when it uses the same GlslProg, GL_TEXTURE_2D bindings on units 0 to NUM_TEXTURE_UNITS - 1, blending,
+//! depth test, mask and function, culling, front face, polygon mode, stencil test, line width, viewport, scissor, framebuffer, view and
+//! projection matrices; otherwise the pending draws are flushed first. Pending draws are uploaded together and issued with their state restored
+//! once, using one draw call for each run of triangles or lines. They are also flushed by any other draw through the Context, gl::clear(),
+//! gl::colorMask(), gl::stencilFunc(), gl::stencilOp(), gl::stencilMask(), a change to any other texture binding, updating the contents of a
+//! Texture, a change to a uniform of their GlslProg, and deleting a Texture, GlslProg or Fbo. State changed with direct GL calls isn't
+//! detected, so call Context::flushAutoBatch() before making them.
+//! Positions and normals are transformed by the model matrix and colored by the current color on the CPU as they are appended, so a batched
+//! GlslProg sees ciModelMatrix as identity. Draws without normals aren't merged with draws that have them, and leave the normal attribute
+//! unspecified as they would outside of an AutoBatch.
+//! Owned by the Context, and generally enabled with ScopedAutoBatch rather than used directly.
+class CI_API AutoBatch : private Noncopyable {
+  public:
+	AutoBatch();
+
+	//! The number of texture units, starting from 0, whose \c GL_TEXTURE_2D binding is captured with each draw.
+	static const uint8_t NUM_TEXTURE_UNITS = 4;
+	//! Returns whether the binding of \a target on \a textureUnit is captured with each draw. Changing any other binding flushes.
+	static bool	capturesTextureBinding( GLenum target, uint8_t textureUnit )	{ return target == GL_TEXTURE_2D && textureUnit < NUM_TEXTURE_UNITS; }
+
+	//! Appends \a numVertices vertices drawn with \a mode, which may be \c GL_TRIANGLES, \c GL_TRIANGLE_STRIP, \c GL_TRIANGLE_FAN, \c GL_LINES, \c GL_LINE_STRIP or \c GL_LINE_LOOP. \a texCoords and \a normals may be \c nullptr.
+	void	append( GLenum mode, const vec2 *positions, const vec2 *texCoords, const vec3 *normals, size_t numVertices );
+	//! Appends \a numVertices vertices drawn with \a mode, which may be \c GL_TRIANGLES, \c GL_TRIANGLE_STRIP, \c GL_TRIANGLE_FAN, \c GL_LINES, \c GL_LINE_STRIP or \c GL_LINE_LOOP. \a texCoords and \a normals may be \c nullptr.
+	void	append( GLenum mode, const vec3 *positions, const vec2 *texCoords, const vec3 *normals, size_t numVertices );
+	//! Issues the pending draws, with the GL state they were appended with.
+	void	flush();
+	//! Flushes if the pending draws use \a glslProg. Returns whether anything was flushed.
+	bool	flushIfUsing( const GlslProg *glslProg );
+
+	//! Returns whether there are draws waiting to be flushed.
+	bool	isPending() const	{ return ! mVertices.empty(); }
+	//! Returns the total number of draw calls issued by flush().
+	size_t	getNumDrawsIssued() const	{ return mNumDrawsIssued; }
+	//! Returns the total number of draws which were merged into the draw call of the preceding one rather than needing their own.
+	size_t	getNumDrawsMerged() const	{ return mNumDrawsMerged; }
+
+  private:
+	//! Consecutive pending vertices drawn with one draw call, as \c GL_TRIANGLES or \c GL_LINES.
+	struct Run {
+		GLenum		mPrimitive;
+		GLsizei		mCount;
+	};
+
+	struct Vertex {
+		vec3		mPosition;
+		ColorAf		mColor;
+		vec2		mTexCoord;
+		vec3		mNormal;
+	};
+
+	//! The GL state a draw depends on, captured when it is appended.
+	struct State {
+		bool operator==( const State &rhs ) const;
+		bool operator!=( const State &rhs ) const	{ return ! ( *this == rhs ); }
+
+		const GlslProg			*mGlslProg;
+		GLuint					mTextures2d[NUM_TEXTURE_UNITS], mFramebuffer;
+		GLboolean				mBlend, mDepthTest, mDepthMask, mCullFace, mScissorTest, mStencilTest;
+		GLenum					mBlendSrcRgb, mBlendDstRgb, mBlendSrcAlpha, mBlendDstAlpha;
+		GLenum					mDepthFunc, mCullFaceMode, mFrontFace;
+#if ! defined( CINDER_GL_ES )
+		GLenum					mPolygonMode;
+#endif
+		std::pair<ivec2, ivec2>	mViewport, mScissor;
+		float					mLineWidth;
+		mat4					mViewMatrix, mProjectionMatrix;
+	};
+
+	template<typename VecT>
+	void	appendImpl( GLenum mode, const VecT *positions, const vec2 *texCoords, const vec3 *normals, size_t numVertices );
+	void	captureState( Context *ctx, State *result ) const;
+	//! Copies the pending vertices into mVbo, returning the index of the first one.
+	GLint	upload();
+
+	std::vector<Vertex>		mVertices, mTransformed;
+	std::vector<Run>		mRuns;
+	State					mState;
+	bool					mHasNormals;
+	VaoRef					mVao;
+	VboRef					mVbo;
+	size_t					mVboOffset;
+	bool					mFlushing;
+	size_t					mNumDrawsIssued, mNumDrawsMerged;
+};
+
+} } // namespace cinder::gl
@@ -76,7 +76,8 @@ class CI_API BufferObj {
 #endif
 
 #if defined( CINDER_GL_HAS_MAP_BUFFER ) || defined( CINDER_GL_HAS_MAP_BUFFER_RANGE )
-	void				unmap() const;
+	//! Analogous to glUnmapBuffer(). Returns \c false if the Buffer's contents were lost while it was mapped, in which case they must be specified again.
+	bool				unmap() const;
 #endif
 	
 	GLuint				getId() const { return mId; }
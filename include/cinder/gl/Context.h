@@ -52,6 +52,8 @@ class Fbo;
 typedef std::shared_ptr<Fbo>			FboRef;
 class VertBatch;
 typedef std::shared_ptr<VertBatch>		VertBatchRef;
+class AutoBatch;
+typedef std::shared_ptr<AutoBatch>		AutoBatchRef;
 class Renderbuffer;
 
 class TextureBase;
@@ -85,16 +87,16 @@ class CI_API Context {
 	//! Set thread's local storage to reflect \a context as the active Context
 	static void		reflectCurrent( Context *context );
 
-	//! Returns a reference to the stack of Model matrices
-	std::vector<mat4>&			getModelMatrixStack() { return mModelMatrixStack; }
+	//! Returns a reference to the stack of Model matrices. Marks the Model matrix as changed, so use the const variant for reading and don't hold on to the reference across draws.
+	std::vector<mat4>&			getModelMatrixStack() { mModelMatrixChanged = true; return mModelMatrixStack; }
 	//! Returns a const reference to the stack of Model matrices
 	const std::vector<mat4>&	getModelMatrixStack() const { return mModelMatrixStack; }
-	//! Returns a reference to the stack of View matrices
-	std::vector<mat4>&			getViewMatrixStack() { return mViewMatrixStack; }
+	//! Returns a reference to the stack of View matrices. Marks the View matrix as changed, so use the const variant for reading and don't hold on to the reference across draws.
+	std::vector<mat4>&			getViewMatrixStack() { mViewMatrixChanged = true; return mViewMatrixStack; }
 	//! Returns a const reference to the stack of Model matrices
 	const std::vector<mat4>&	getViewMatrixStack() const { return mViewMatrixStack; }
-	//! Returns a reference to the stack of Projection matrices
-	std::vector<mat4>&			getProjectionMatrixStack() { return mProjectionMatrixStack; }
+	//! Returns a reference to the stack of Projection matrices. Marks the Projection matrix as changed, so use the const variant for reading and don't hold on to the reference across draws.
+	std::vector<mat4>&			getProjectionMatrixStack() { mProjectionMatrixChanged = true; return mProjectionMatrixStack; }
 	//! Returns a const reference to the stack of Projection matrices
 	const std::vector<mat4>&	getProjectionMatrixStack() const { return mProjectionMatrixStack; }
 	
@@ -474,6 +476,18 @@ class CI_API Context {
 	//! Returns a reference to the immediate mode emulation structure. Generally use gl::begin() and friends instead.
 	VertBatch&		immediate() { return *mImmediateMode; }
 
+	//! Begins merging convenience draws such as drawSolidRect() into the AutoBatch. Nests. Generally use ScopedAutoBatch instead.
+	void			pushAutoBatch();
+	//! Ends a pushAutoBatch(), flushing the AutoBatch when the outermost one ends.
+	void			popAutoBatch();
+	//! Returns the AutoBatch that convenience draws are merged into, or \c nullptr outside of pushAutoBatch() / popAutoBatch().
+	AutoBatch*		getAutoBatch() { return mAutoBatchDepth > 0 ? mAutoBatch.get() : nullptr; }
+	//! Issues any draws pending in the AutoBatch. Needed before changing state the AutoBatch doesn't track, such as with direct GL calls.
+	void			flushAutoBatch();
+
+	//! Returns the number of matrix uniforms such as ciModelViewProjection that setDefaultShaderVars() has set. Matrices whose stacks haven't changed since the GlslProg last received them are skipped and not counted.
+	size_t			getNumMatrixUniformsSet() const { return mNumMatrixUniformsSet; }
+
 #if defined( CINDER_GL_HAS_DEBUG_OUTPUT )
   #if defined( CINDER_MSW )
 	static void __stdcall 	debugMessageCallback( GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar *message, void *userParam );
@@ -550,11 +564,15 @@ class CI_API Context {
 	VertBatchRef				mImmediateMode;
 	VaoRef						mDrawTextureVao;
 	VboRef						mDrawTextureVbo;
+	AutoBatchRef				mAutoBatch;
+	int							mAutoBatchDepth;
 
   private:
 	Context( const std::shared_ptr<PlatformData> &platformData );
 
 	void	allocateDrawTextureVboAndVao();
+	//! Returns the matrix for the matrix uniform \a semantic, computing it from the matrix stacks if they've changed since it was last needed. 3x3 matrices are returned in the upper left.
+	const mat4&	getDerivedMatrix( UniformSemantic semantic );
 
 	std::shared_ptr<PlatformData>	mPlatformData;
 	
@@ -570,6 +588,13 @@ class CI_API Context {
 	std::vector<mat4>		mProjectionMatrixStack;
 	std::vector<float>		mLineWidthStack;
 
+	// set by the non-const matrix stack accessors. setDefaultShaderVars() gives a changed stack a new generation, which GlslProgs record
+	bool					mModelMatrixChanged, mViewMatrixChanged, mProjectionMatrixChanged;
+	uint64_t				mMatrixGenerations[3]; // model, view, projection
+	uint32_t				mDerivedMatricesValid; // bit per UniformSemantic
+	mat4					mDerivedMatrices[UNIFORM_USER_DEFINED];
+	size_t					mNumMatrixUniformsSet;
+
 	// Debug
 	GLenum						mDebugLogSeverity;
 	GLenum						mDebugBreakSeverity;
@@ -107,6 +107,27 @@ class CI_API GlslProg {
 		
 		friend class GlslProg;
 	};
+
+	//! Reference to an active Uniform that has been resolved once with getUniformHandle(). Passing it to uniform() skips the
+	//! name lookup done by the string variants while still validating the type and skipping redundant values. Only valid
+	//! for the GlslProg that returned it.
+	class CI_API UniformHandle {
+	  public:
+		UniformHandle() = default;
+
+		//! Returns whether this handle refers to an active uniform. Setting an invalid handle is a no-op.
+		bool		isValid() const				{ return mUniformIndex >= 0; }
+		explicit operator bool() const			{ return isValid(); }
+		//! Returns the uniform location, including the index offset for names like "example[2]". Returns -1 if invalid.
+		GLint		getLocation() const			{ return mLocation; }
+
+	  private:
+		int32_t		mUniformIndex = -1;
+		GLint		mLocation = -1;
+		GLuint		mProgramHandle = 0;
+
+		friend class GlslProg;
+	};
 	
 #if defined( CINDER_GL_HAS_UNIFORM_BLOCKS )
 
@@ -413,6 +434,43 @@ class CI_API GlslProg {
 	void	uniform( int location, const mat2 *data, int count, bool transpose = false ) const;
 	void	uniform( int location, const mat3 *data, int count, bool transpose = false ) const;
 	void	uniform( int location, const mat4 *data, int count, bool transpose = false ) const;
+
+	//! Returns a UniformHandle for the active uniform matching \a name, which may be indexed like "example[2]". Logs a warning and returns an invalid handle if the uniform doesn't exist.
+	UniformHandle	getUniformHandle( const std::string &name ) const;
+
+	void	uniform( const UniformHandle &handle, bool data ) const;
+	void	uniform( const UniformHandle &handle, int data ) const;
+	void	uniform( const UniformHandle &handle, float data ) const;
+#if ! defined( CINDER_GL_ES_2 )
+	void	uniform( const UniformHandle &handle, uint32_t data ) const;
+#endif
+	void	uniform( const UniformHandle &handle, const vec2 &data ) const;
+	void	uniform( const UniformHandle &handle, const vec3 &data ) const;
+	void	uniform( const UniformHandle &handle, const vec4 &data ) const;
+	void	uniform( const UniformHandle &handle, const ivec2 &data ) const;
+	void	uniform( const UniformHandle &handle, const ivec3 &data ) const;
+	void	uniform( const UniformHandle &handle, const ivec4 &data ) const;
+#if ! defined( CINDER_GL_ES_2 )
+	void	uniform( const UniformHandle &handle, const uvec2 &data ) const;
+	void	uniform( const UniformHandle &handle, const uvec3 &data ) const;
+	void	uniform( const UniformHandle &handle, const uvec4 &data ) const;
+#endif // ! defined( CINDER_GL_ES_2 )
+	void	uniform( const UniformHandle &handle, const mat2 &data, bool transpose = false ) const;
+	void	uniform( const UniformHandle &handle, const mat3 &data, bool transpose = false ) const;
+	void	uniform( const UniformHandle &handle, const mat4 &data, bool transpose = false ) const;
+
+#if ! defined( CINDER_GL_ES_2 )
+	void	uniform( const UniformHandle &handle, const uint32_t *data, int count ) const;
+#endif // ! defined( CINDER_GL_ES_2 )
+	void	uniform( const UniformHandle &handle, const int *data, int count ) const;
+	void	uniform( const UniformHandle &handle, const float *data, int count ) const;
+	void	uniform( const UniformHandle &handle, const ivec2 *data, int count ) const;
+	void	uniform( const UniformHandle &handle, const vec2 *data, int count ) const;
+	void	uniform( const UniformHandle &handle, const vec3 *data, int count ) const;
+	void	uniform( const UniformHandle &handle, const vec4 *data, int count ) const;
+	void	uniform( const UniformHandle &handle, const mat2 *data, int count, bool transpose = false ) const;
+	void	uniform( const UniformHandle &handle, const mat3 *data, int count, bool transpose = false ) const;
+	void	uniform( const UniformHandle &handle, const mat4 *data, int count, bool transpose = false ) const;
 	
 	bool	hasAttribSemantic( geom::Attrib semantic ) const;
 	GLint	getAttribSemanticLocation( geom::Attrib semantic ) const;
@@ -483,6 +541,8 @@ class CI_API GlslProg {
 	void			cacheActiveUniforms();
 	//! Returns a pointer to the Uniform that matches \a location. Returns nullptr if the uniform doesn't exist.
 	const Uniform*	findUniform( int location, int *resultLocation ) const;
+	//! Returns a pointer to the Uniform referenced by \a handle without a name lookup. Returns nullptr if the handle is invalid.
+	const Uniform*	findUniform( const UniformHandle &handle, int *resultLocation ) const;
 	
 	//! Performs the finding, validation, and implementation of single uniform variables. Ends by calling the location
 	//! variant uniform function.
@@ -513,6 +573,8 @@ class CI_API GlslProg {
 	void			logMissingUniform( const std::string &name ) const;
 	//! Logs an error and caches the name.
 	void			logMissingUniform( int location ) const;
+	//! Does nothing, missing uniforms are logged when the UniformHandle is created.
+	void			logMissingUniform( const UniformHandle &handle ) const;
 	//! Logs a warning and caches the name.
 	void			logUniformWrongType( const std::string &name, GLenum uniformType, const std::string &userType ) const;
 	//! Checks the validity of the settings on this uniform, specifically type and value
@@ -550,6 +612,8 @@ class CI_API GlslProg {
 	std::vector<Attribute>						mAttributes;
 	std::vector<Uniform>						mUniforms;
 	mutable std::unique_ptr<UniformValueCache>	mUniformValueCache;
+	// generations of the model, view and projection matrix stacks that Context::setDefaultShaderVars() last set the matrix uniforms from
+	mutable uint64_t							mDefaultMatrixGenerations[3];
 #if defined( CINDER_GL_HAS_UNIFORM_BLOCKS )
 	std::vector<UniformBlock>				mUniformBlocks;
 #endif
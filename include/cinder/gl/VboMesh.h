@@ -25,12 +25,14 @@
 #include "cinder/gl/Vao.h"
 #include "cinder/gl/Vbo.h"
 #include "cinder/gl/GlslProg.h"
+#include "cinder/gl/Sync.h"
 
 #include "cinder/Color.h"
 #include "cinder/Vector.h"
 #include "cinder/TriMesh.h"
 #include "cinder/GeomIo.h"
 
+#include <future>
 #include <iosfwd>
 #include <vector>
 
@@ -38,6 +40,7 @@ namespace cinder { namespace gl {
 
 class VboMesh;
 typedef std::shared_ptr<VboMesh> VboMeshRef;
+class VboMeshGeomTarget;
 	
 class CI_API VboMesh {
   public:
@@ -88,6 +91,46 @@ class CI_API VboMesh {
 	//! Creates a VboMesh which represents the user's vertex buffer objects. Allows optional \a indexVbo to enable indexed vertices; creates a static index VBO if none provided.
 	static VboMeshRef	create( uint32_t numVertices, GLenum glPrimitive, const std::vector<Layout> &vertexArrayLayouts, uint32_t numIndices = 0, GLenum indexType = GL_UNSIGNED_SHORT, const VboRef &indexVbo = VboRef() );
 
+#if ! defined( CINDER_GL_ES ) || defined( CINDER_GL_ES_3 )
+	//! A VboMesh whose vertex data is generated from a geom::Source on a worker thread. Returned by VboMesh::createAsync(). Must be used and destroyed on the thread that created it.
+	class CI_API AsyncLoad {
+	  public:
+		//! Blocks until the worker thread is done with the Source, since it writes into staging buffers which can only be unmapped on this thread.
+		//! Keep the AsyncLoad alive until isReady() returns \c true to avoid stalling the thread that destroys it.
+		~AsyncLoad();
+
+		//! Returns whether the VboMesh can be drawn without stalling. Finishes the upload once the worker thread is done, and reports \c true when the GPU has completed it. Never \c true if the Source threw.
+		bool		isReady();
+		//! Returns whether the Source threw, which is known once isReady() or getVboMesh() has seen the worker thread finish. The VboMesh is then left without data.
+		bool		hasFailed() const	{ return (bool)mException; }
+		//! Blocks until the worker thread is done, finishes the upload and returns the VboMesh. Rethrows any exception thrown by the Source.
+		VboMeshRef	getVboMesh();
+
+	  protected:
+		AsyncLoad( const geom::Source &source, std::vector<std::pair<Layout,VboRef>> vertexArrayBuffers );
+
+		//! Unmaps the staging buffers and copies them into the VboMesh's VBOs, followed by a fence. Records the Source's exception instead if it threw.
+		void		finishUpload();
+
+		geom::SourceRef							mSource;
+		geom::AttribSet							mRequestedAttribs;
+		VboMeshRef								mVboMesh;
+		std::vector<VboRef>						mStagingVbos;
+		std::unique_ptr<VboMeshGeomTarget>		mTarget;
+		std::future<void>						mLoaded;
+		SyncRef									mFence;
+		std::exception_ptr						mException;
+
+		friend class VboMesh;
+	};
+	typedef std::shared_ptr<AsyncLoad>	AsyncLoadRef;
+
+	//! Creates a VboMesh which represents the geom::Source \a source, generating and writing its vertex data into mapped staging buffers on the global ThreadPool. Layout is derived from the contents of \a source, which is cloned and may be modified afterwards.
+	static AsyncLoadRef	createAsync( const geom::Source &source );
+	//! Creates a VboMesh which represents the geom::Source \a source using 1 or more VboMesh::Layouts for vertex data, generating and writing its vertex data into mapped staging buffers on the global ThreadPool.
+	static AsyncLoadRef	createAsync( const geom::Source &source, const std::vector<VboMesh::Layout> &vertexArrayLayouts );
+#endif
+
 	//! Maps a geom::Attrib to a named attribute in the GlslProg
 	typedef std::map<geom::Attrib,std::string> AttribGlslMap;
 	//! Constructs a VAO (in the currently bound VAO) that matches \a this to GlslProg \a shader, overriding the mapping of a geom::Attrib to a named attribute via the 'a attributeMapping std::map
@@ -269,10 +312,13 @@ class CI_API VboMesh {
 #endif
 
   protected:
+	VboMesh() : mNumVertices( 0 ), mNumIndices( 0 ) {}
 	VboMesh( const geom::Source &source, std::vector<std::pair<Layout,VboRef>> vertexArrayBuffers, const VboRef &indexArrayVbo );
 	VboMesh( uint32_t numVertices, uint32_t numIndices, GLenum glPrimitive, GLenum indexType, const std::vector<std::pair<geom::BufferLayout,VboRef>> &vertexArrayBuffers, const VboRef &indexVbo );
 	VboMesh( uint32_t numVertices, uint32_t numIndices, GLenum glPrimitive, GLenum indexType, const std::vector<Layout> &vertexArrayLayouts, const VboRef &indexVbo );
 
+	//! Resolves the dims of \a vertexArrayBuffers against \a source and allocates the VBOs. Returns the attributes to request from \a source.
+	geom::AttribSet	allocateVertexArrayVbos( const geom::Source &source, std::vector<std::pair<Layout,VboRef>> vertexArrayBuffers );
 	void	allocateIndexVbo();
 
 	void	echoVertices( std::ostream &os, const std::vector<uint32_t> &indices, bool printElements );
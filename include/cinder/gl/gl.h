@@ -27,6 +27,7 @@
 #include "cinder/gl/draw.h"
 #include "cinder/gl/scoped.h"
 
+#include "cinder/gl/AutoBatch.h"
 #include "cinder/gl/Batch.h"
 #include "cinder/gl/BufferTexture.h"
 #include "cinder/gl/Context.h"
@@ -340,6 +340,23 @@ struct CI_API ScopedFrontFace : private Noncopyable {
 	Context		*mCtx;
 };
 
+//! Merges consecutive convenience draws such as drawSolidRect(), drawLine() and drawSolidCircle() that share state into single draw calls. See AutoBatch for what is tracked.
+struct CI_API ScopedAutoBatch : private Noncopyable {
+	ScopedAutoBatch();
+	~ScopedAutoBatch();
+
+	//! Issues any pending draws. Needed before changing state the AutoBatch doesn't track, such as with direct GL calls.
+	void	flush();
+	//! Returns the number of draw calls issued since the scope began, not counting pending draws.
+	size_t	getNumDrawsIssued() const;
+	//! Returns the number of draws merged into another draw call since the scope began.
+	size_t	getNumDrawsMerged() const;
+
+  private:
+	Context		*mCtx;
+	size_t		mNumDrawsIssuedStart, mNumDrawsMergedStart;
+};
+
 #if defined( CINDER_GL_HAS_KHR_DEBUG )
 
 //! Scopes debug group message
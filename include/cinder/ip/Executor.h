@@ -0,0 +1,186 @@
+/*
+ Copyright (c) 2016, The Cinder Project, All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/Cinder.h"
+#include "cinder/CinderAssert.h"
+#include "cinder/Surface.h"
+#include "cinder/ThreadPool.h"
+#include "cinder/ip/Blend.h"
+#include "cinder/ip/Blur.h"
+#include "cinder/ip/EdgeDetect.h"
+#include "cinder/ip/Grayscale.h"
+#include "cinder/ip/Premultiply.h"
+#include "cinder/ip/Threshold.h"
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+namespace cinder { namespace ip {
+
+//! Runs a chain of operations over a Surface or Channel in horizontal bands on a ThreadPool.
+//!
+//! Each band is copied into a tile together with the rows around it that the chained operations read (its halo), every
+//! operation is applied to the tile in turn while it is cache-resident, and the band is then copied to the destination.
+//! \a ImageT is one of the SurfaceT or ChannelT types.
+//! \code
+//! ip::Executor<Surface8u> executor;
+//! executor.grayscale().stackBlur( 4 ).edgeDetectSobel();
+//! executor.run( &surface );
+//! \endcode
+template<typename ImageT>
+class Executor {
+  public:
+	//! Operation applied to a tile. The tile may be replaced by an image of the same size.
+	typedef std::function<void ( ImageT *tile )>	OpFn;
+	//! Operation applied to a tile which also receives \a tileArea, the Area of the image that the tile was copied from.
+	typedef std::function<void ( ImageT *tile, const Area &tileArea )>	TileAreaOpFn;
+
+	//! Creates an Executor with no operations which schedules bands on \a threadPool.
+	Executor( ThreadPool *threadPool = ThreadPool::get() )
+		: mThreadPool( threadPool ), mBandHeight( 0 ), mHalo( 0 )
+	{}
+
+	//! Appends \a fn to the chain. \a halo is the number of rows above and below an output row which \a fn reads. Pixels in
+	//! the outermost \a halo rows of a tile (apart from those on the image's edges) are not expected to be valid afterwards.
+	Executor&	add( const OpFn &fn, int32_t halo = 0 )
+	{
+		return addWithArea( [fn]( ImageT *tile, const Area & ) { fn( tile ); }, halo );
+	}
+
+	//! Appends \a fn to the chain, for operations that depend on where the tile is in the image. \sa add()
+	Executor&	addWithArea( const TileAreaOpFn &fn, int32_t halo = 0 )
+	{
+		mOps.push_back( fn );
+		mHalo += halo;
+		return *this;
+	}
+
+	//! Appends ip::threshold() with \a value.
+	template<typename T>
+	Executor&	threshold( T value )	{ return add( [value]( ImageT *tile ) { ip::threshold( *tile, value, tile ); } ); }
+	//! Appends ip::grayscale(). Surfaces only.
+	Executor&	grayscale()				{ return add( []( ImageT *tile ) { ip::grayscale( *tile, tile ); } ); }
+	//! Appends ip::premultiply(). Surfaces only.
+	Executor&	premultiply()			{ return add( []( ImageT *tile ) { ip::premultiply( tile ); } ); }
+	//! Appends ip::unpremultiply(). Surfaces only.
+	Executor&	unpremultiply()			{ return add( []( ImageT *tile ) { ip::unpremultiply( tile ); } ); }
+	//! Appends ip::stackBlur() with \a radius.
+	Executor&	stackBlur( int radius )	{ return add( [radius]( ImageT *tile ) { ip::stackBlur( tile, radius ); }, radius + 1 ); }
+	//! Appends ip::blend() of \a foreground, which must be the same size as the image. Surface8u and Surface32f only.
+	Executor&	blend( const ImageT &foreground )
+	{
+		// copying a Surface shares its pixels
+		return addWithArea( [foreground]( ImageT *tile, const Area &tileArea ) { ip::blend( tile, foreground, tileArea, -tileArea.getUL() ); } );
+	}
+	//! Appends ip::adaptiveThreshold() with \a windowSize and \a percentageDelta. Channel8u only.
+	Executor&	adaptiveThreshold( int32_t windowSize, float percentageDelta )
+	{
+		// the window is clamped to the tile rather than the image, so the rows within half a window of a band have to be in its tile
+		return add( [windowSize, percentageDelta]( ImageT *tile ) { ip::adaptiveThreshold( tile, windowSize, percentageDelta ); }, windowSize / 2 );
+	}
+	//! Appends ip::edgeDetectSobel(). Unlike calling ip::edgeDetectSobel() with an uninitialized destination, the pixels on the image's edges keep their values.
+	Executor&	edgeDetectSobel()
+	{
+		return add( []( ImageT *tile ) {
+			ImageT result = tile->clone();
+			ip::edgeDetectSobel( *tile, &result );
+			*tile = result;
+		}, 1 );
+	}
+
+	//! Removes all operations.
+	void	clear()						{ mOps.clear(); mHalo = 0; }
+	//! Returns the number of rows above and below each band which are copied into its tile.
+	int32_t	getHalo() const				{ return mHalo; }
+
+	//! Sets the number of rows in each band. The default of 0 picks a height so that tiles fit in a typical L2 cache while keeping every thread busy.
+	void	setBandHeight( int32_t bandHeight )	{ mBandHeight = bandHeight; }
+	//! Returns the number of rows in each band, or 0 if it is picked automatically.
+	int32_t	getBandHeight() const				{ return mBandHeight; }
+
+	//! Applies the operations to \a image in place.
+	void	run( ImageT *image ) const
+	{
+		// a band would otherwise read rows that its neighbours have already written
+		if( mHalo > 0 )
+			run( image->clone(), image );
+		else
+			run( *image, image );
+	}
+
+	//! Applies the operations to \a src and stores the result in \a dst, which must be the same size and must not share pixels with \a src unless there is no halo.
+	void	run( const ImageT &src, ImageT *dst ) const
+	{
+		CI_ASSERT( src.getSize() == dst->getSize() );
+
+		const int32_t width = src.getWidth();
+		const int32_t height = src.getHeight();
+		const int32_t bandHeight = ( mBandHeight > 0 ) ? mBandHeight : calcBandHeight( src );
+		const size_t numBands = ( height + bandHeight - 1 ) / bandHeight;
+
+		mThreadPool->parallelFor( 0, numBands, 1, [&]( size_t firstBand, size_t lastBand ) {
+			for( size_t band = firstBand; band < lastBand; ++band ) {
+				const int32_t bandTop = (int32_t)band * bandHeight;
+				const int32_t bandBottom = std::min( height, bandTop + bandHeight );
+				const int32_t tileTop = std::max( 0, bandTop - mHalo );
+				const int32_t tileBottom = std::min( height, bandBottom + mHalo );
+
+				const Area tileArea( 0, tileTop, width, tileBottom );
+				ImageT tile = src.clone( tileArea );
+				for( const auto &op : mOps )
+					op( &tile, tileArea );
+				dst->copyFrom( tile, Area( 0, bandTop - tileTop, width, bandBottom - tileTop ), ivec2( 0, tileTop ) );
+			}
+		} );
+	}
+
+  private:
+	int32_t calcBandHeight( const ImageT &image ) const
+	{
+		const size_t tileBytes = 1024 * 1024;
+		const int32_t numThreads = (int32_t)mThreadPool->getNumThreads() + 1;
+		const int32_t rowBytes = std::max<int32_t>( 1, image.getWidth() * (int32_t)sizeof( *image.getData() ) * getPixelIncrement( image ) );
+
+		int32_t result = std::max<int32_t>( 16, (int32_t)( tileBytes / rowBytes ) );
+		// at least a few bands per thread so that uneven bands balance out
+		result = std::min( result, ( image.getHeight() + numThreads * 4 - 1 ) / ( numThreads * 4 ) );
+		// keep the rows copied for the halo from dominating
+		return std::max( result, std::max<int32_t>( 1, 8 * mHalo ) );
+	}
+
+	template<typename T>
+	static uint8_t	getPixelIncrement( const SurfaceT<T> &surface )	{ return surface.getPixelInc(); }
+	//! Tiles cloned from a Channel are always planar
+	template<typename T>
+	static uint8_t	getPixelIncrement( const ChannelT<T> & )		{ return 1; }
+
+	ThreadPool					*mThreadPool;
+	std::vector<TileAreaOpFn>	mOps;
+	int32_t						mBandHeight;
+	int32_t						mHalo;
+};
+
+} } // namespace cinder::ip
@@ -50,12 +50,14 @@ list( APPEND SRC_SET_CINDER
 	${CINDER_SRC_DIR}/cinder/Surface.cpp
 	${CINDER_SRC_DIR}/cinder/System.cpp
 	${CINDER_SRC_DIR}/cinder/Text.cpp
+	${CINDER_SRC_DIR}/cinder/ThreadPool.cpp
 	${CINDER_SRC_DIR}/cinder/Timeline.cpp
 	${CINDER_SRC_DIR}/cinder/TimelineItem.cpp
 	${CINDER_SRC_DIR}/cinder/Timer.cpp
 	${CINDER_SRC_DIR}/cinder/Triangulate.cpp
 	${CINDER_SRC_DIR}/cinder/TriMesh.cpp
 	${CINDER_SRC_DIR}/cinder/Tween.cpp
+	${CINDER_SRC_DIR}/cinder/TweenBatch.cpp
 	${CINDER_SRC_DIR}/cinder/Unicode.cpp
 	${CINDER_SRC_DIR}/cinder/Url.cpp
 	${CINDER_SRC_DIR}/cinder/Utilities.cpp
@@ -94,12 +96,16 @@ source_group( "cinder\\app" FILES   ${SRC_SET_CINDER_APP} )
 
 list( APPEND SRC_SET_CINDER_AUDIO
 	${CINDER_SRC_DIR}/cinder/audio/ChannelRouterNode.cpp
+	${CINDER_SRC_DIR}/cinder/audio/CommandQueue.cpp
 	${CINDER_SRC_DIR}/cinder/audio/Context.cpp
+	${CINDER_SRC_DIR}/cinder/audio/ContextOffline.cpp
+	${CINDER_SRC_DIR}/cinder/audio/ConvolutionNode.cpp
 	${CINDER_SRC_DIR}/cinder/audio/DelayNode.cpp
 	${CINDER_SRC_DIR}/cinder/audio/Device.cpp
 	${CINDER_SRC_DIR}/cinder/audio/FileOggVorbis.cpp
 	${CINDER_SRC_DIR}/cinder/audio/FilterNode.cpp
 	${CINDER_SRC_DIR}/cinder/audio/GenNode.cpp
+	${CINDER_SRC_DIR}/cinder/audio/GraphScheduler.cpp
 	${CINDER_SRC_DIR}/cinder/audio/InputNode.cpp
 	${CINDER_SRC_DIR}/cinder/audio/Node.cpp
 	${CINDER_SRC_DIR}/cinder/audio/NodeMath.cpp
@@ -110,16 +116,21 @@ list( APPEND SRC_SET_CINDER_AUDIO
 	${CINDER_SRC_DIR}/cinder/audio/SamplePlayerNode.cpp
 	${CINDER_SRC_DIR}/cinder/audio/SampleRecorderNode.cpp
 	${CINDER_SRC_DIR}/cinder/audio/Source.cpp
+	${CINDER_SRC_DIR}/cinder/audio/StreamScheduler.cpp
 	${CINDER_SRC_DIR}/cinder/audio/Target.cpp
 	${CINDER_SRC_DIR}/cinder/audio/Utilities.cpp
 	${CINDER_SRC_DIR}/cinder/audio/Voice.cpp
+	${CINDER_SRC_DIR}/cinder/audio/VoicePoolNode.cpp
 	${CINDER_SRC_DIR}/cinder/audio/WaveTable.cpp
 )
 
 list( APPEND SRC_SET_CINDER_AUDIO_DSP
 	${CINDER_SRC_DIR}/cinder/audio/dsp/Biquad.cpp
+	${CINDER_SRC_DIR}/cinder/audio/dsp/BiquadBank.cpp
 	${CINDER_SRC_DIR}/cinder/audio/dsp/Converter.cpp
+	${CINDER_SRC_DIR}/cinder/audio/dsp/ConverterPolyphase.cpp
 	${CINDER_SRC_DIR}/cinder/audio/dsp/Dsp.cpp
+	${CINDER_SRC_DIR}/cinder/audio/dsp/DspKernels.cpp
 	${CINDER_SRC_DIR}/cinder/audio/dsp/Fft.cpp
 )
 
@@ -134,6 +145,7 @@ source_group( "cinder\\audio\\dsp" FILES    ${SRC_SET_CINDER_AUDIO_DSP} )
 # ----------------------------------------------------------------------------------------------------------------------
 
 list( APPEND SRC_SET_CINDER_GL
+	${CINDER_SRC_DIR}/cinder/gl/AutoBatch.cpp
 	${CINDER_SRC_DIR}/cinder/gl/Batch.cpp
 	${CINDER_SRC_DIR}/cinder/gl/BufferObj.cpp
 	${CINDER_SRC_DIR}/cinder/gl/BufferTexture.cpp
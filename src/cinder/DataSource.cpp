@@ -23,11 +23,23 @@
 */
 
 #include "cinder/DataSource.h"
+#include "cinder/Noncopyable.h"
 #if defined( CINDER_ANDROID )
   #include "cinder/app/android/AssetFileSystem.h"
   #include "cinder/app/android/PlatformAndroid.h"
 #endif
 
+#if defined( CINDER_MSW_DESKTOP )
+	#include <windows.h>
+#elif defined( CINDER_POSIX )
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+#include <algorithm>
+
 namespace cinder {
 
 /////////////////////////////////////////////////////////////////////////////
@@ -89,6 +101,220 @@ IStreamRef DataSourcePath::createStream()
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+// DataSourceMapped::Mapping
+//! Copy-on-write view of a file, memory-mapped on platforms that support it and read into memory elsewhere.
+class DataSourceMapped::Mapping : private Noncopyable {
+  public:
+	explicit Mapping( const fs::path &path );
+	~Mapping();
+
+	//! Returns false if the file could not be opened or mapped.
+	bool	isValid() const		{ return mValid; }
+	void*	getData() const		{ return mData; }
+	size_t	getSize() const		{ return mSize; }
+
+	void	setAccessPattern( AccessPattern accessPattern );
+	void	prefetch( size_t offset, size_t size );
+
+  private:
+	void		*mData;
+	size_t		mSize;
+	bool		mValid;
+#if defined( CINDER_MSW_DESKTOP )
+	HANDLE		mFile, mMapping;
+#elif ! defined( CINDER_POSIX )
+	BufferRef	mBuffer;
+#endif
+};
+
+#if defined( CINDER_MSW_DESKTOP )
+
+DataSourceMapped::Mapping::Mapping( const fs::path &path )
+	: mData( nullptr ), mSize( 0 ), mValid( false ), mMapping( NULL )
+{
+	mFile = ::CreateFileW( path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+	if( mFile == INVALID_HANDLE_VALUE )
+		return;
+
+	LARGE_INTEGER fileSize;
+	if( ! ::GetFileSizeEx( mFile, &fileSize ) )
+		return;
+
+	mSize = static_cast<size_t>( fileSize.QuadPart );
+	if( mSize == 0 ) { // empty files can't be mapped
+		mValid = true;
+		return;
+	}
+
+	mMapping = ::CreateFileMappingW( mFile, NULL, PAGE_WRITECOPY, 0, 0, NULL );
+	if( mMapping )
+		mData = ::MapViewOfFile( mMapping, FILE_MAP_COPY, 0, 0, 0 );
+
+	mValid = ( mData != nullptr );
+}
+
+DataSourceMapped::Mapping::~Mapping()
+{
+	if( mData )
+		::UnmapViewOfFile( mData );
+	if( mMapping )
+		::CloseHandle( mMapping );
+	if( mFile != INVALID_HANDLE_VALUE )
+		::CloseHandle( mFile );
+}
+
+void DataSourceMapped::Mapping::setAccessPattern( AccessPattern /*accessPattern*/ )
+{
+}
+
+void DataSourceMapped::Mapping::prefetch( size_t /*offset*/, size_t /*size*/ )
+{
+}
+
+#elif defined( CINDER_POSIX )
+
+DataSourceMapped::Mapping::Mapping( const fs::path &path )
+	: mData( nullptr ), mSize( 0 ), mValid( false )
+{
+	int fd = ::open( path.string().c_str(), O_RDONLY );
+	if( fd < 0 )
+		return;
+
+	struct stat fileStat;
+	if( ::fstat( fd, &fileStat ) == 0 && S_ISREG( fileStat.st_mode ) ) {
+		size_t size = static_cast<size_t>( fileStat.st_size );
+		if( size == 0 ) // empty files can't be mapped
+			mValid = true;
+		else {
+			// private writable pages are copy-on-write, so writes through the Buffer never reach the file
+			void *data = ::mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+			if( data != MAP_FAILED ) {
+				mData = data;
+				mSize = size;
+				mValid = true;
+			}
+		}
+	}
+
+	::close( fd );
+}
+
+DataSourceMapped::Mapping::~Mapping()
+{
+	if( mData )
+		::munmap( mData, mSize );
+}
+
+void DataSourceMapped::Mapping::setAccessPattern( AccessPattern accessPattern )
+{
+	if( ! mData )
+		return;
+
+	int advice = MADV_NORMAL;
+	if( accessPattern == SEQUENTIAL )
+		advice = MADV_SEQUENTIAL;
+	else if( accessPattern == RANDOM )
+		advice = MADV_RANDOM;
+
+	::madvise( mData, mSize, advice );
+}
+
+void DataSourceMapped::Mapping::prefetch( size_t offset, size_t size )
+{
+	if( ! mData || offset >= mSize )
+		return;
+
+	// madvise() requires a page-aligned address
+	static const size_t pageSize = static_cast<size_t>( ::sysconf( _SC_PAGESIZE ) );
+	size_t begin = offset - offset % pageSize;
+	size_t end = offset + std::min( size, mSize - offset );
+	::madvise( static_cast<char*>( mData ) + begin, end - begin, MADV_WILLNEED );
+}
+
+#else
+
+DataSourceMapped::Mapping::Mapping( const fs::path &path )
+	: mData( nullptr ), mSize( 0 ), mValid( false )
+{
+	IStreamFileRef stream = loadFileStream( path );
+	if( ! stream )
+		return;
+
+	mBuffer = loadStreamBuffer( stream );
+	mData = mBuffer->getData();
+	mSize = mBuffer->getSize();
+	mValid = true;
+}
+
+DataSourceMapped::Mapping::~Mapping()
+{
+}
+
+void DataSourceMapped::Mapping::setAccessPattern( AccessPattern /*accessPattern*/ )
+{
+}
+
+void DataSourceMapped::Mapping::prefetch( size_t /*offset*/, size_t /*size*/ )
+{
+}
+
+#endif
+
+/////////////////////////////////////////////////////////////////////////////
+// DataSourceMapped
+DataSourceMappedRef DataSourceMapped::create( const fs::path &path, AccessPattern accessPattern )
+{
+	return DataSourceMappedRef( new DataSourceMapped( path, accessPattern ) );
+}
+
+DataSourceMapped::DataSourceMapped( const fs::path &path, AccessPattern accessPattern )
+	: DataSource( path, Url() ), mMapping( new Mapping( path ) )
+{
+	if( ! mMapping->isValid() )
+		throw StreamExc( "Failed to map file: " + path.string() );
+
+	setFilePathHint( path );
+	mMapping->setAccessPattern( accessPattern );
+}
+
+const void* DataSourceMapped::getData() const
+{
+	return mMapping->getData();
+}
+
+size_t DataSourceMapped::getSize() const
+{
+	return mMapping->getSize();
+}
+
+void DataSourceMapped::setAccessPattern( AccessPattern accessPattern )
+{
+	mMapping->setAccessPattern( accessPattern );
+}
+
+void DataSourceMapped::prefetch( size_t offset, size_t size )
+{
+	mMapping->prefetch( offset, size );
+}
+
+void DataSourceMapped::createBuffer()
+{
+	// the Buffer doesn't own the mapped memory, its deleter keeps the mapping alive for as long as the Buffer is
+	std::shared_ptr<Mapping> mapping = mMapping;
+	mBuffer = BufferRef( new Buffer( mapping->getData(), mapping->getSize() ), [mapping]( Buffer *buffer ) { delete buffer; } );
+}
+
+IStreamRef DataSourceMapped::createStream()
+{
+	IStreamMemRef stream = IStreamMem::create( mMapping->getData(), mMapping->getSize() );
+	stream->setFileName( mFilePath );
+
+	std::shared_ptr<Mapping> mapping = mMapping;
+	return IStreamRef( stream.get(), [stream, mapping]( IStreamCinder * ) {} );
+}
+
+
 #if defined( CINDER_ANDROID )
 /////////////////////////////////////////////////////////////////////////////
 // DataSourceAndroidAsset
@@ -136,6 +362,15 @@ DataSourceRef loadFile( const fs::path &path )
 #endif	
 }
 
+DataSourceRef loadFileMapped( const fs::path &path, DataSourceMapped::AccessPattern accessPattern )
+{
+#if defined( CINDER_ANDROID )
+	if( ci::app::PlatformAndroid::isAssetPath( path ) )
+		return DataSourceAndroidAsset::create( path );
+#endif
+	return DataSourceMapped::create( path, accessPattern );
+}
+
 
 #if ! defined( CINDER_UWP )
 /////////////////////////////////////////////////////////////////////////////
@@ -31,6 +31,7 @@
 #include "cinder/BSpline.h"
 #include "cinder/Matrix.h"
 #include "cinder/Sphere.h"
+#include "cinder/ThreadPool.h"
 #include <algorithm>
 
 #if defined( CINDER_ANDROID )
@@ -399,52 +400,81 @@ void calculateTangentsImpl( size_t numIndices, const uint32_t *indices, size_t n
 	if( resultTangents )
 		resultTangents->assign( numVertices, vec3( 0 ) );
 
-	size_t numTriangles = numIndices / 3;
-	for( size_t i = 0; i < numTriangles; ++i ) {
-		uint32_t index0 = indices[i * 3];
-		uint32_t index1 = indices[i * 3 + 1];
-		uint32_t index2 = indices[i * 3 + 2];
+	auto accumulateTangents = [&]( size_t beginTriangle, size_t endTriangle, vec3 *tangents ) {
+		for( size_t i = beginTriangle; i < endTriangle; ++i ) {
+			uint32_t index0 = indices[i * 3];
+			uint32_t index1 = indices[i * 3 + 1];
+			uint32_t index2 = indices[i * 3 + 2];
 
-		const vec3 &v0 = positions[index0];
-		const vec3 &v1 = positions[index1];
-		const vec3 &v2 = positions[index2];
+			const vec3 &v0 = positions[index0];
+			const vec3 &v1 = positions[index1];
+			const vec3 &v2 = positions[index2];
 
-		const vec2 &w0 = vec2( texCoords[index0] );
-		const vec2 &w1 = vec2( texCoords[index1] );
-		const vec2 &w2 = vec2( texCoords[index2] );
+			const vec2 &w0 = vec2( texCoords[index0] );
+			const vec2 &w1 = vec2( texCoords[index1] );
+			const vec2 &w2 = vec2( texCoords[index2] );
 
-		float x1 = v1.x - v0.x;
-		float x2 = v2.x - v0.x;
-		float y1 = v1.y - v0.y;
-		float y2 = v2.y - v0.y;
-		float z1 = v1.z - v0.z;
-		float z2 = v2.z - v0.z;
+			float x1 = v1.x - v0.x;
+			float x2 = v2.x - v0.x;
+			float y1 = v1.y - v0.y;
+			float y2 = v2.y - v0.y;
+			float z1 = v1.z - v0.z;
+			float z2 = v2.z - v0.z;
 
-		float s1 = w1.x - w0.x;
-		float s2 = w2.x - w0.x;
-		float t1 = w1.y - w0.y;
-		float t2 = w2.y - w0.y;
+			float s1 = w1.x - w0.x;
+			float s2 = w2.x - w0.x;
+			float t1 = w1.y - w0.y;
+			float t2 = w2.y - w0.y;
 
-		float r = (s1 * t2 - s2 * t1);
-		if( r != 0.0f ) r = 1.0f / r;
+			float r = (s1 * t2 - s2 * t1);
+			if( r != 0.0f ) r = 1.0f / r;
 
-		vec3 tangent( (t2 * x1 - t1 * x2) * r, (t2 * y1 - t1 * y2) * r, (t2 * z1 - t1 * z2) * r );
+			vec3 tangent( (t2 * x1 - t1 * x2) * r, (t2 * y1 - t1 * y2) * r, (t2 * z1 - t1 * z2) * r );
 
-		(*resultTangents)[index0] += tangent;
-		(*resultTangents)[index1] += tangent;
-		(*resultTangents)[index2] += tangent;
-	}
+			tangents[index0] += tangent;
+			tangents[index1] += tangent;
+			tangents[index2] += tangent;
+		}
+	};
 
-	for( size_t i = 0; i < numVertices; ++i ) {
-		vec3 normal = normals[i];
-		vec3 tangent = (*resultTangents)[i];
-		(*resultTangents)[i] = ( tangent - normal * dot( normal, tangent ) );
+	// each chunk of triangles sums into its own copy of the tangents, so that no two threads write to the same one. The first chunk uses resultTangents.
+	const size_t numTriangles = numIndices / 3;
+	const size_t numChunks = detail::calcNumTriangleChunks( numTriangles );
 
-		float len = length2( (*resultTangents)[i] );
-		if( len > 0.0f )
-			(*resultTangents)[i] /= sqrt( len );
+	vector<vector<vec3>> partialTangents( numChunks - 1 );
+	if( numChunks == 1 )
+		accumulateTangents( 0, numTriangles, resultTangents->data() );
+	else {
+		ThreadPool::get()->parallelFor( 0, numChunks, 1, [&]( size_t begin, size_t end ) {
+			for( size_t chunk = begin; chunk < end; ++chunk ) {
+				vec3 *tangents = resultTangents->data();
+				if( chunk > 0 ) {
+					partialTangents[chunk - 1].assign( numVertices, vec3( 0 ) );
+					tangents = partialTangents[chunk - 1].data();
+				}
+				accumulateTangents( numTriangles * chunk / numChunks, numTriangles * ( chunk + 1 ) / numChunks, tangents );
+			}
+		} );
 	}
 
+	auto orthogonalize = [&]( size_t begin, size_t end ) {
+		for( size_t i = begin; i < end; ++i ) {
+			vec3 normal = normals[i];
+			vec3 tangent = (*resultTangents)[i];
+			for( const auto &partial : partialTangents )
+				tangent += partial[i];
+			(*resultTangents)[i] = ( tangent - normal * dot( normal, tangent ) );
+
+			float len = length2( (*resultTangents)[i] );
+			if( len > 0.0f )
+				(*resultTangents)[i] /= sqrt( len );
+		}
+	};
+	if( numChunks == 1 )
+		orthogonalize( 0, numVertices );
+	else
+		ThreadPool::get()->parallelFor( 0, numVertices, detail::MIN_VERTICES_PER_CHUNK, orthogonalize );
+
 	if( resultBitangents ) {
 		resultBitangents->reserve( numVertices );
 		for( size_t i = 0; i < numVertices; ++i )
@@ -792,30 +822,20 @@ AttribSet RoundedRect::getAvailableAttribs() const
 	
 void RoundedRect::loadInto( cinder::geom::Target *target, const AttribSet &requestedAttribs ) const
 {
-	std::vector<vec2> positions;
-	if( requestedAttribs.count( geom::Attrib::POSITION ) )
-		positions.resize( mNumVertices );
-	std::vector<vec2> texCoords;
-	if( requestedAttribs.count( geom::Attrib::TEX_COORD_0 ) )
-		texCoords.resize( mNumVertices );
-	std::vector<vec4> colors;
-	if( requestedAttribs.count( geom::Attrib::COLOR ) )
-		colors.resize( mNumVertices );
-	std::vector<vec3> normals;
-	if( requestedAttribs.count( geom::Attrib::NORMAL ) )
-		normals.resize( mNumVertices );
-	std::vector<vec3> tangents;
-	if( requestedAttribs.count( geom::Attrib::TANGENT ) )
-		tangents.resize( mNumVertices );
+	AttribBuffer<vec2> positions( target, geom::Attrib::POSITION, mNumVertices, requestedAttribs.count( geom::Attrib::POSITION ) > 0 );
+	AttribBuffer<vec2> texCoords( target, geom::Attrib::TEX_COORD_0, mNumVertices, requestedAttribs.count( geom::Attrib::TEX_COORD_0 ) > 0 );
+	AttribBuffer<vec4> colors( target, geom::Attrib::COLOR, mNumVertices, requestedAttribs.count( geom::Attrib::COLOR ) > 0 );
+	AttribBuffer<vec3> normals( target, geom::Attrib::NORMAL, mNumVertices, requestedAttribs.count( geom::Attrib::NORMAL ) > 0 );
+	AttribBuffer<vec3> tangents( target, geom::Attrib::TANGENT, mNumVertices, requestedAttribs.count( geom::Attrib::TANGENT ) > 0 );
 	
 	auto posCenter = mRectPositions.getCenter();
 	auto texCenter = mRectTexCoords.getCenter();
 	
-	auto bufferPositions = ! positions.empty();
-	auto bufferTexCoords = ! texCoords.empty();
-	auto bufferNormals = ! normals.empty();
-	auto bufferTangents = ! tangents.empty();
-	auto bufferColors = ! colors.empty();
+	auto bufferPositions = bool( positions );
+	auto bufferTexCoords = bool( texCoords );
+	auto bufferNormals = bool( normals );
+	auto bufferTangents = bool( tangents );
+	auto bufferColors = bool( colors );
 	
 	if( bufferPositions )
 		positions[0] = posCenter;
@@ -890,16 +910,11 @@ void RoundedRect::loadInto( cinder::geom::Target *target, const AttribSet &reque
 		colors[tri] = lerp( colorU0, colorU1, currentTexCoord.y / mRectTexCoords.getHeight() );
 	}
 	
-	if( bufferPositions )
-		target->copyAttrib( geom::Attrib::POSITION, 2, 0, value_ptr( *positions.data() ), positions.size() );
-	if( bufferTexCoords )
-		target->copyAttrib( geom::Attrib::TEX_COORD_0, 2, 0, value_ptr( *texCoords.data() ), texCoords.size() );
-	if( bufferNormals )
-		target->copyAttrib( geom::Attrib::NORMAL, 3, 0, value_ptr( *normals.data() ), normals.size() );
-	if( bufferTangents )
-		target->copyAttrib( geom::Attrib::TANGENT, 3, 0, value_ptr( *tangents.data() ), tangents.size() );
-	if( bufferColors )
-		target->copyAttrib( geom::Attrib::COLOR, 4, 0, value_ptr( *colors.data() ), colors.size() );
+	positions.commit();
+	texCoords.commit();
+	normals.commit();
+	tangents.commit();
+	colors.commit();
 }
 	
 void RoundedRect::setDefaultColors()
@@ -973,12 +988,13 @@ AttribSet Cube::getAvailableAttribs() const
 }
 
 void generateFace( const vec3 &faceCenter, const vec3 &uAxis, const vec3 &vAxis, int subdivU, int subdivV,
-					vector<vec3> *positions, vector<vec3> *normals,
-					const ColorA &color, vector<ColorA> *colors, vector<vec2> *texCoords,
+					AttribBuffer<vec3> *positions, AttribBuffer<vec3> *normals,
+					const ColorA &color, AttribBuffer<ColorA> *colors, AttribBuffer<vec2> *texCoords,
 					vector<uint32_t> *indices )
 {
 	const vec3 normal = normalize( faceCenter );
 
+	// 'positions' counts the vertices even when it has no storage
 	const uint32_t baseIdx = (uint32_t)positions->size();
 
 	// fill vertex data
@@ -989,11 +1005,11 @@ void generateFace( const vec3 &faceCenter, const vec3 &uAxis, const vec3 &vAxis,
 
 			positions->emplace_back( faceCenter + ( u - 0.5f ) * 2.0f * uAxis + ( v - 0.5f ) * 2.0f * vAxis );
 
-			if( normals )
+			if( *normals )
 				normals->emplace_back( normal );
-			if( colors )
+			if( *colors )
 				colors->emplace_back( color );
-			if( texCoords )
+			if( *texCoords )
 				texCoords->emplace_back( u, v );
 		}
 	}
@@ -1018,69 +1034,48 @@ void generateFace( const vec3 &faceCenter, const vec3 &uAxis, const vec3 &vAxis,
 
 void Cube::loadInto( Target *target, const AttribSet &requestedAttribs ) const
 {
-	vector<vec3> positions;
-	vector<uint32_t> indices;
-	vector<vec3> normals;
-	vector<ColorA> colors;
-	vector<vec2> texCoords;
-	vector<vec3> *normalsPtr = nullptr;
-	vector<ColorA> *colorsPtr = nullptr;
-	vector<vec2> *texCoordsPtr = nullptr;
-	
 	const size_t numVertices = getNumVertices();
-	
-	// reserve room in vectors and set pointers to non-null for normals, texcoords and colors as appropriate
-	positions.reserve( numVertices );
+	// tangents are calculated from the positions, normals and tex coords, which then need to be readable
+	const bool calcTangents = requestedAttribs.count( Attrib::TANGENT ) > 0;
+
+	AttribBuffer<vec3> positions( target, Attrib::POSITION, numVertices, requestedAttribs.count( Attrib::POSITION ) > 0, calcTangents );
+	AttribBuffer<vec3> normals( target, Attrib::NORMAL, numVertices, requestedAttribs.count( Attrib::NORMAL ) > 0, calcTangents );
+	AttribBuffer<ColorA> colors( target, Attrib::COLOR, numVertices, requestedAttribs.count( Attrib::COLOR ) > 0 );
+	AttribBuffer<vec2> texCoords( target, Attrib::TEX_COORD_0, numVertices, requestedAttribs.count( Attrib::TEX_COORD_0 ) > 0, calcTangents );
+	vector<uint32_t> indices;
 	indices.reserve( getNumIndices() );
-	if( requestedAttribs.count( Attrib::NORMAL ) || requestedAttribs.count( Attrib::TANGENT ) ) {
-		normals.reserve( numVertices );
-		normalsPtr = &normals;
-	}
-	if( requestedAttribs.count( Attrib::COLOR ) > 0 ) {
-		colors.reserve( numVertices );
-		colorsPtr = &colors;
-	}
-	if( requestedAttribs.count( Attrib::TEX_COORD_0 ) || requestedAttribs.count( Attrib::TANGENT ) ) {
-		texCoords.reserve( numVertices );
-		texCoordsPtr = &texCoords;
-	}
 
 	vec3 sz = 0.5f * mSize;
 	
 	// +X
 	generateFace( vec3(sz.x,0,0), vec3(0,0,sz.z), vec3(0,sz.y,0), mSubdivisions.z, mSubdivisions.y, &positions,
-		normalsPtr, mColors[0], colorsPtr, texCoordsPtr, &indices );
+		&normals, mColors[0], &colors, &texCoords, &indices );
 	// +Y
 	generateFace( vec3(0,sz.y,0), vec3(sz.x,0,0), vec3(0,0,sz.z), mSubdivisions.x, mSubdivisions.z, &positions,
-		normalsPtr, mColors[2], colorsPtr, texCoordsPtr, &indices );
+		&normals, mColors[2], &colors, &texCoords, &indices );
 	// +Z
 	generateFace( vec3(0,0,sz.z), vec3(0,sz.y,0), vec3(sz.x,0,0), mSubdivisions.y, mSubdivisions.x, &positions,
-		normalsPtr, mColors[4], colorsPtr, texCoordsPtr, &indices );
+		&normals, mColors[4], &colors, &texCoords, &indices );
 	// -X
 	generateFace( vec3(-sz.x,0,0), vec3(0,sz.y,0), vec3(0,0,sz.z), mSubdivisions.y, mSubdivisions.z, &positions,
-		normalsPtr, mColors[1], colorsPtr, texCoordsPtr, &indices );
+		&normals, mColors[1], &colors, &texCoords, &indices );
 	// -Y
 	generateFace( vec3(0,-sz.y,0), vec3(0,0,sz.z), vec3(sz.x,0,0), mSubdivisions.z, mSubdivisions.x, &positions,
-		normalsPtr, mColors[3], colorsPtr, texCoordsPtr, &indices );
+		&normals, mColors[3], &colors, &texCoords, &indices );
 	// -Z
 	generateFace( vec3(0,0,-sz.z), vec3(sz.x,0,0), vec3(0,sz.y,0), mSubdivisions.x, mSubdivisions.y, &positions,
-		normalsPtr, mColors[5], colorsPtr, texCoordsPtr, &indices );
+		&normals, mColors[5], &colors, &texCoords, &indices );
 
-	target->copyAttrib( Attrib::POSITION, 3, 0, (const float*)positions.data(), numVertices );
-	if( normalsPtr )
-		target->copyAttrib( Attrib::NORMAL, 3, 0, (const float*)normals.data(), numVertices );
-	if( texCoordsPtr )
-		target->copyAttrib( Attrib::TEX_COORD_0, 2, 0, (const float*)texCoords.data(), numVertices );
-	if( colorsPtr )
-		target->copyAttrib( Attrib::COLOR, 4, 0, (const float*)colors.data(), numVertices );
+	positions.commit();
+	normals.commit();
+	texCoords.commit();
+	colors.commit();
 
 	// generate tangents
-	if( requestedAttribs.count( geom::TANGENT ) ) {
+	if( calcTangents ) {
 		vector<vec3> tangents;
 		calculateTangents( getNumIndices(), indices.data(), numVertices, positions.data(), normals.data(), texCoords.data(), &tangents, nullptr );
-		
-		if( requestedAttribs.count( geom::TANGENT ) )
-			target->copyAttrib( Attrib::TANGENT, 3, 0, (const float*)tangents.data(), numVertices );
+		target->copyAttrib( Attrib::TANGENT, 3, 0, (const float*)tangents.data(), numVertices );
 	}
 
 	target->copyIndices( Primitive::TRIANGLES, indices.data(), getNumIndices(), calcIndicesRequiredBytes( getNumIndices() ) );
@@ -1197,7 +1192,7 @@ AttribSet Icosahedron::getAvailableAttribs() const
 	return { Attrib::POSITION, Attrib::NORMAL, Attrib::COLOR, Attrib::TEX_COORD_0 };
 }
 
-void Icosahedron::loadInto( Target *target, const AttribSet & /*requestedAttribs*/ ) const
+void Icosahedron::loadInto( Target *target, const AttribSet &requestedAttribs ) const
 {
 	vector<vec3> positions, normals, colors;
 	vector<vec2> texcoords;
@@ -1205,10 +1200,14 @@ void Icosahedron::loadInto( Target *target, const AttribSet & /*requestedAttribs
 	
 	calculate( &positions, &normals, &colors, &texcoords, &indices );
 
-	target->copyAttrib( Attrib::POSITION, 3, 0, value_ptr( *positions.data() ), positions.size() );
-	target->copyAttrib( Attrib::NORMAL, 3, 0, value_ptr( *normals.data() ), normals.size() );
-	target->copyAttrib( Attrib::COLOR, 3, 0, value_ptr( *colors.data() ), colors.size() );
-	target->copyAttrib( Attrib::TEX_COORD_0, 2, 0, value_ptr( *texcoords.data() ), texcoords.size() );
+	if( requestedAttribs.count( Attrib::POSITION ) )
+		target->copyAttrib( Attrib::POSITION, 3, 0, value_ptr( *positions.data() ), positions.size() );
+	if( requestedAttribs.count( Attrib::NORMAL ) )
+		target->copyAttrib( Attrib::NORMAL, 3, 0, value_ptr( *normals.data() ), normals.size() );
+	if( requestedAttribs.count( Attrib::COLOR ) )
+		target->copyAttrib( Attrib::COLOR, 3, 0, value_ptr( *colors.data() ), colors.size() );
+	if( requestedAttribs.count( Attrib::TEX_COORD_0 ) )
+		target->copyAttrib( Attrib::TEX_COORD_0, 2, 0, value_ptr( *texcoords.data() ), texcoords.size() );
 
 	target->copyIndices( Primitive::TRIANGLES, indices.data(), indices.size(), 1 );
 }
@@ -1361,10 +1360,15 @@ void Icosphere::loadInto( Target *target, const AttribSet &requestedAttribs ) co
 {
 	calculate();
 
-	target->copyAttrib( Attrib::POSITION, 3, 0, value_ptr( *mPositions.data() ), mPositions.size() );
-	target->copyAttrib( Attrib::NORMAL, 3, 0, value_ptr( *mNormals.data() ), mNormals.size() );
-	target->copyAttrib( Attrib::TEX_COORD_0, 2, 0, value_ptr( *mTexCoords.data() ), mTexCoords.size() );
-	target->copyAttrib( Attrib::COLOR, 3, 0, value_ptr( *mColors.data() ), mColors.size() );
+	// the calculations are cached, so there's nothing to gain from writing into the target's storage directly
+	if( requestedAttribs.count( Attrib::POSITION ) )
+		target->copyAttrib( Attrib::POSITION, 3, 0, value_ptr( *mPositions.data() ), mPositions.size() );
+	if( requestedAttribs.count( Attrib::NORMAL ) )
+		target->copyAttrib( Attrib::NORMAL, 3, 0, value_ptr( *mNormals.data() ), mNormals.size() );
+	if( requestedAttribs.count( Attrib::TEX_COORD_0 ) )
+		target->copyAttrib( Attrib::TEX_COORD_0, 2, 0, value_ptr( *mTexCoords.data() ), mTexCoords.size() );
+	if( requestedAttribs.count( Attrib::COLOR ) )
+		target->copyAttrib( Attrib::COLOR, 3, 0, value_ptr( *mColors.data() ), mColors.size() );
 
 	if( requestedAttribs.count( Attrib::TANGENT ) ) {
 		vector<vec3> tangents;
@@ -1470,21 +1474,18 @@ void Teapot::updateVertexCounts()
 	mNumVertices = 32 * (mSubdivision + 1) * (mSubdivision + 1);
 }
 
-void Teapot::calculate( vector<float> *positions, vector<float> *normals, vector<float> *texCoords, vector<uint32_t> *indices ) const
+void Teapot::calculate( AttribBuffer<vec3> *positions, AttribBuffer<vec3> *normals, AttribBuffer<vec2> *texCoords, vector<uint32_t> *indices ) const
 {
-	positions->resize( mNumVertices * 3 );
-	texCoords->resize( mNumVertices * 2 );
-	normals->resize( mNumVertices * 3 );
 	indices->resize( mNumIndices );
 
-	generatePatches( positions->data(), normals->data(), texCoords->data(), indices->data(), mSubdivision );
+	generatePatches( positions, normals, texCoords, indices->data(), mSubdivision );
 }
 
-void Teapot::generatePatches( float *v, float *n, float *tc, uint32_t *el, int grid )
+void Teapot::generatePatches( AttribBuffer<vec3> *v, AttribBuffer<vec3> *n, AttribBuffer<vec2> *tc, uint32_t *el, int grid )
 {
 	unique_ptr<float[]> B( new float[4*(grid+1)] );  // Pre-computed Bernstein basis functions
 	unique_ptr<float[]> dB( new float[4*(grid+1)] ); // Pre-computed derivitives of basis functions
-	int idx = 0, elIndex = 0, tcIndex = 0;
+	int idx = 0, elIndex = 0;
 
 	// Pre-compute the basis functions  (Bernstein polynomials)
 	// and their derivatives
@@ -1492,25 +1493,25 @@ void Teapot::generatePatches( float *v, float *n, float *tc, uint32_t *el, int g
 
 	// Build each patch
 	// The rim
-	buildPatchReflect( 0, B.get(), dB.get(), v, n, tc, el, idx, elIndex, tcIndex, grid, true, true );
+	buildPatchReflect( 0, B.get(), dB.get(), v, n, tc, el, idx, elIndex, grid, true, true );
 	// The body
-	buildPatchReflect( 1, B.get(), dB.get(), v, n, tc, el, idx, elIndex, tcIndex, grid, true, true );
-	buildPatchReflect( 2, B.get(), dB.get(), v, n, tc, el, idx, elIndex, tcIndex, grid, true, true );
+	buildPatchReflect( 1, B.get(), dB.get(), v, n, tc, el, idx, elIndex, grid, true, true );
+	buildPatchReflect( 2, B.get(), dB.get(), v, n, tc, el, idx, elIndex, grid, true, true );
 	// The lid
-	buildPatchReflect( 3, B.get(), dB.get(), v, n, tc, el, idx, elIndex, tcIndex, grid, true, true );
-	buildPatchReflect( 4, B.get(), dB.get(), v, n, tc, el, idx, elIndex, tcIndex, grid, true, true );
+	buildPatchReflect( 3, B.get(), dB.get(), v, n, tc, el, idx, elIndex, grid, true, true );
+	buildPatchReflect( 4, B.get(), dB.get(), v, n, tc, el, idx, elIndex, grid, true, true );
 	// The bottom
-	buildPatchReflect( 5, B.get(), dB.get(), v, n, tc, el, idx, elIndex, tcIndex, grid, true, true );
+	buildPatchReflect( 5, B.get(), dB.get(), v, n, tc, el, idx, elIndex, grid, true, true );
 	// The handle
-	buildPatchReflect( 6, B.get(), dB.get(), v, n, tc, el, idx, elIndex, tcIndex, grid, false, true );
-	buildPatchReflect( 7, B.get(), dB.get(), v, n, tc, el, idx, elIndex, tcIndex, grid, false, true );
+	buildPatchReflect( 6, B.get(), dB.get(), v, n, tc, el, idx, elIndex, grid, false, true );
+	buildPatchReflect( 7, B.get(), dB.get(), v, n, tc, el, idx, elIndex, grid, false, true );
 	// The spout
-	buildPatchReflect( 8, B.get(), dB.get(), v, n, tc, el, idx, elIndex, tcIndex, grid, false, true );
-	buildPatchReflect( 9, B.get(), dB.get(), v, n, tc, el, idx, elIndex, tcIndex, grid, false, true );
+	buildPatchReflect( 8, B.get(), dB.get(), v, n, tc, el, idx, elIndex, grid, false, true );
+	buildPatchReflect( 9, B.get(), dB.get(), v, n, tc, el, idx, elIndex, grid, false, true );
 }
 
-void Teapot::buildPatchReflect( int patchNum, float *B, float *dB, float *v, float *n, float *tc, unsigned int *el,
-								int &index, int &elIndex, int &tcIndex, int grid, bool reflectX, bool reflectY )
+void Teapot::buildPatchReflect( int patchNum, float *B, float *dB, AttribBuffer<vec3> *v, AttribBuffer<vec3> *n, AttribBuffer<vec2> *tc, unsigned int *el,
+								int &index, int &elIndex, int grid, bool reflectX, bool reflectY )
 {
 	vec3 patch[4][4];
 	vec3 patchRevV[4][4];
@@ -1518,50 +1519,55 @@ void Teapot::buildPatchReflect( int patchNum, float *B, float *dB, float *v, flo
 	getPatch( patchNum, patchRevV, true );
 
 	// Patch without modification
-	buildPatch( patchRevV, B, dB, v, n, tc, el, index, elIndex, tcIndex, grid, mat3(), false );
+	buildPatch( patchRevV, B, dB, v, n, tc, el, index, elIndex, grid, mat3(), false );
 
 	// Patch reflected in x
 	if( reflectX ) {
 		mat3 reflect( glm::scale( vec3( -1, 1, 1 ) ) );
-		buildPatch( patch, B, dB, v, n, tc, el, index, elIndex, tcIndex, grid, reflect, true );
+		buildPatch( patch, B, dB, v, n, tc, el, index, elIndex, grid, reflect, true );
 	}
 
 	// Patch reflected in y
 	if( reflectY ) {
 		mat3 reflect( glm::scale( vec3( 1, -1, 1 ) ) );
-		buildPatch( patch, B, dB, v, n, tc, el, index, elIndex, tcIndex, grid, reflect, true );
+		buildPatch( patch, B, dB, v, n, tc, el, index, elIndex, grid, reflect, true );
 	}
 
 	// Patch reflected in x and y
 	if( reflectX && reflectY ) {
 		mat3 reflect( glm::scale( vec3( -1, -1, 1 ) ) );
-		buildPatch( patchRevV, B, dB, v, n, tc, el, index, elIndex, tcIndex, grid, reflect, false );
+		buildPatch( patchRevV, B, dB, v, n, tc, el, index, elIndex, grid, reflect, false );
 	}
 }
 
-void Teapot::buildPatch( vec3 patch[][4], float *B, float *dB, float *v, float *n, float *tc,
-						unsigned int *el, int &index, int &elIndex, int &tcIndex, int grid, mat3 reflect, bool invertNormal )
+void Teapot::buildPatch( vec3 patch[][4], float *B, float *dB, AttribBuffer<vec3> *v, AttribBuffer<vec3> *n, AttribBuffer<vec2> *tc,
+						unsigned int *el, int &index, int &elIndex, int grid, mat3 reflect, bool invertNormal )
 {
-	int startIndex = index / 3;
+	int startIndex = index;
 	float tcFactor = 1.0f / grid;
 
 	float scale = 2.0f / 6.42813f; // awful hack to keep it within unit cube
 
 	for( int i = 0; i <= grid; i++ ) {
 		for( int j = 0 ; j <= grid; j++) {
-			vec3 pt = reflect * evaluate( i, j, B, patch );
-			vec3 norm = reflect * evaluateNormal( i, j, B, dB, patch );
-			if( invertNormal )
-				norm = -norm;
-			// awful hack due to normals discontinuity
-			if( abs( pt.x ) < 0.01f && abs( pt.y ) < 0.01f )
-				norm = ( pt.z < 1 ) ? vec3( 0, 0, -1 ) : vec3( 0, 0, 1 );
-
-			v[index] = pt.x * scale; v[index+1] = pt.z * scale; v[index+2] = pt.y * scale;
-			n[index] = norm.x; n[index+1] = norm.z; n[index+2] = norm.y;
-			tc[tcIndex] = i * tcFactor; tc[tcIndex+1] = j * tcFactor;
-			index += 3;
-			tcIndex += 2;
+			// the normal depends on the position because of the hack below
+			if( *v || *n ) {
+				vec3 pt = reflect * evaluate( i, j, B, patch );
+				if( *v )
+					(*v)[index] = vec3( pt.x, pt.z, pt.y ) * scale;
+				if( *n ) {
+					vec3 norm = reflect * evaluateNormal( i, j, B, dB, patch );
+					if( invertNormal )
+						norm = -norm;
+					// awful hack due to normals discontinuity
+					if( abs( pt.x ) < 0.01f && abs( pt.y ) < 0.01f )
+						norm = ( pt.z < 1 ) ? vec3( 0, 0, -1 ) : vec3( 0, 0, 1 );
+					(*n)[index] = vec3( norm.x, norm.z, norm.y );
+				}
+			}
+			if( *tc )
+				(*tc)[index] = vec2( i * tcFactor, j * tcFactor );
+			index++;
 		}
 	}
 
@@ -1652,18 +1658,21 @@ vec3 Teapot::evaluateNormal( int gridU, int gridV, const float *B, const float *
 
 void Teapot::loadInto( Target *target, const AttribSet &requestedAttribs ) const
 {
-	vector<float> positions, normals, texCoords;
+	const bool calcTangents = requestedAttribs.count( Attrib::TANGENT ) > 0;
+	AttribBuffer<vec3> positions( target, Attrib::POSITION, mNumVertices, requestedAttribs.count( Attrib::POSITION ) > 0, calcTangents );
+	AttribBuffer<vec3> normals( target, Attrib::NORMAL, mNumVertices, requestedAttribs.count( Attrib::NORMAL ) > 0, calcTangents );
+	AttribBuffer<vec2> texCoords( target, Attrib::TEX_COORD_0, mNumVertices, requestedAttribs.count( Attrib::TEX_COORD_0 ) > 0, calcTangents );
 	vector<uint32_t> indices;
 	
 	calculate( &positions, &normals, &texCoords, &indices );
 
-	target->copyAttrib( Attrib::POSITION, 3, 0, positions.data(), mNumVertices );
-	target->copyAttrib( Attrib::NORMAL, 3, 0, normals.data(), mNumVertices );
-	target->copyAttrib( Attrib::TEX_COORD_0, 2, 0, texCoords.data(), mNumVertices );
+	positions.commit();
+	normals.commit();
+	texCoords.commit();
 
-	if( requestedAttribs.count( Attrib::TANGENT ) ) {
+	if( calcTangents ) {
 		vector<vec3> tangents;
-		calculateTangents( indices.size(), indices.data(), positions.size() / 3, (const vec3*)positions.data(), (const vec3*)normals.data(), (const vec2*)texCoords.data(), &tangents, nullptr );
+		calculateTangents( indices.size(), indices.data(), mNumVertices, positions.data(), normals.data(), texCoords.data(), &tangents, nullptr );
 		target->copyAttrib( Attrib::TANGENT, 3, 0, value_ptr( *tangents.data() ), tangents.size() );
 	}
 
@@ -1725,14 +1734,11 @@ AttribSet Circle::getAvailableAttribs() const
 	return { Attrib::POSITION, Attrib::NORMAL, Attrib::TEX_COORD_0 };
 }
 
-void Circle::loadInto( Target *target, const AttribSet &/*requestedAttribs*/ ) const
+void Circle::loadInto( Target *target, const AttribSet &requestedAttribs ) const
 {
-	std::vector<vec2> positions, texCoords;
-	std::vector<vec3> normals;
-
-	positions.reserve( mNumVertices );
-	texCoords.reserve( mNumVertices );
-	normals.reserve( mNumVertices );
+	AttribBuffer<vec2> positions( target, Attrib::POSITION, mNumVertices, requestedAttribs.count( Attrib::POSITION ) > 0 );
+	AttribBuffer<vec2> texCoords( target, Attrib::TEX_COORD_0, mNumVertices, requestedAttribs.count( Attrib::TEX_COORD_0 ) > 0 );
+	AttribBuffer<vec3> normals( target, Attrib::NORMAL, mNumVertices, requestedAttribs.count( Attrib::NORMAL ) > 0 );
 
 	// center
 	positions.emplace_back( mCenter );
@@ -1750,9 +1756,9 @@ void Circle::loadInto( Target *target, const AttribSet &/*requestedAttribs*/ ) c
 		t += tDelta;
 	}
 
-	target->copyAttrib( Attrib::POSITION, 2, 0, (const float*)positions.data(), mNumVertices );
-	target->copyAttrib( Attrib::NORMAL, 3, 0, (const float*)normals.data(), mNumVertices );
-	target->copyAttrib( Attrib::TEX_COORD_0, 2, 0, (const float*)texCoords.data(), mNumVertices );
+	positions.commit();
+	normals.commit();
+	texCoords.commit();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -1816,14 +1822,11 @@ AttribSet Ring::getAvailableAttribs() const
 	return{ Attrib::POSITION, Attrib::NORMAL, Attrib::TEX_COORD_0 };
 }
 
-void Ring::loadInto( Target *target, const AttribSet &/*requestedAttribs*/ ) const
+void Ring::loadInto( Target *target, const AttribSet &requestedAttribs ) const
 {
-	std::vector<vec2> positions, texCoords;
-	std::vector<vec3> normals;
-
-	positions.reserve( mNumVertices );
-	texCoords.reserve( mNumVertices );
-	normals.reserve( mNumVertices );
+	AttribBuffer<vec2> positions( target, Attrib::POSITION, mNumVertices, requestedAttribs.count( Attrib::POSITION ) > 0 );
+	AttribBuffer<vec2> texCoords( target, Attrib::TEX_COORD_0, mNumVertices, requestedAttribs.count( Attrib::TEX_COORD_0 ) > 0 );
+	AttribBuffer<vec3> normals( target, Attrib::NORMAL, mNumVertices, requestedAttribs.count( Attrib::NORMAL ) > 0 );
 
 	float innerRadius = mRadius - 0.5f * mWidth;
 	float outerRadius = mRadius + 0.5f * mWidth;
@@ -1842,9 +1845,9 @@ void Ring::loadInto( Target *target, const AttribSet &/*requestedAttribs*/ ) con
 		t += tDelta;
 	}
 
-	target->copyAttrib( Attrib::POSITION, 2, 0, (const float*) positions.data(), mNumVertices );
-	target->copyAttrib( Attrib::NORMAL, 3, 0, (const float*) normals.data(), mNumVertices );
-	target->copyAttrib( Attrib::TEX_COORD_0, 2, 0, (const float*) texCoords.data(), mNumVertices );
+	positions.commit();
+	normals.commit();
+	texCoords.commit();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -1907,26 +1910,20 @@ void Sphere::loadInto( Target *target, const AttribSet &requestedAttribs ) const
 	int numRings, numSegments;
 	numRingsAndSegments( &numRings, &numSegments );
 
-	std::vector<vec3> positions;
-	std::vector<vec2> texCoords;
-	std::vector<vec3> normals;
-	std::vector<vec3> colors;
-	std::vector<uint32_t> indices;
+	const size_t numVertices = numSegments * numRings;
+	// tangents are calculated from the positions, normals and tex coords, which then need to be readable
+	const bool calcTangents = requestedAttribs.count( Attrib::TANGENT ) > 0;
 
-	positions.resize( numSegments * numRings );
-	normals.resize( numSegments * numRings );
-	texCoords.resize( numSegments * numRings );
-	colors.resize( numSegments * numRings );
-	indices.resize( (numSegments - 1) * (numRings - 1) * 6 );
+	AttribBuffer<vec3> positions( target, Attrib::POSITION, numVertices, requestedAttribs.count( Attrib::POSITION ) > 0, calcTangents );
+	AttribBuffer<vec3> normals( target, Attrib::NORMAL, numVertices, requestedAttribs.count( Attrib::NORMAL ) > 0, calcTangents );
+	AttribBuffer<vec2> texCoords( target, Attrib::TEX_COORD_0, numVertices, requestedAttribs.count( Attrib::TEX_COORD_0 ) > 0, calcTangents );
+	AttribBuffer<vec3> colors( target, Attrib::COLOR, numVertices, requestedAttribs.count( Attrib::COLOR ) > 0 );
+	std::vector<uint32_t> indices( (numSegments - 1) * (numRings - 1) * 6 );
 
 	float ringIncr = 1.0f / (float)( numRings - 1 );
 	float segIncr = 1.0f / (float)( numSegments - 1 );
 	float radius = mRadius;
 
-	auto vertIt = positions.begin();
-	auto normIt = normals.begin();
-	auto texIt = texCoords.begin();
-	auto colorIt = colors.begin();
 	for( int r = 0; r < numRings; r++ ) {
 		float v = r * ringIncr;
 		for( int s = 0; s < numSegments; s++ ) {
@@ -1935,11 +1932,10 @@ void Sphere::loadInto( Target *target, const AttribSet &requestedAttribs ) const
 			float y = math<float>::sin( float(M_PI) * (v - 0.5f) );
 			float z = math<float>::cos( float(M_PI * 2) * u ) * math<float>::sin( float(M_PI) * v );
 
-			*vertIt++ = vec3( x * radius + mCenter.x, y * radius + mCenter.y, z * radius + mCenter.z );
-
-			*normIt++ = vec3( x, y, z );
-			*texIt++ = vec2( u, v );
-			*colorIt++ = vec3( x * 0.5f + 0.5f, y * 0.5f + 0.5f, z * 0.5f + 0.5f );
+			positions.emplace_back( x * radius + mCenter.x, y * radius + mCenter.y, z * radius + mCenter.z );
+			normals.emplace_back( x, y, z );
+			texCoords.emplace_back( u, v );
+			colors.emplace_back( x * 0.5f + 0.5f, y * 0.5f + 0.5f, z * 0.5f + 0.5f );
 		}
 	}
 
@@ -1956,17 +1952,15 @@ void Sphere::loadInto( Target *target, const AttribSet &requestedAttribs ) const
 		}
 	}
 	
-	target->copyAttrib( Attrib::POSITION, 3, 0, value_ptr( *positions.data() ), positions.size() );
-	target->copyAttrib( Attrib::NORMAL, 3, 0, value_ptr( *normals.data() ), normals.size() );
-	target->copyAttrib( Attrib::TEX_COORD_0, 2, 0, value_ptr( *texCoords.data() ), texCoords.size() );
-	target->copyAttrib( Attrib::COLOR, 3, 0, value_ptr( *colors.data() ), colors.size() );
+	positions.commit();
+	normals.commit();
+	texCoords.commit();
+	colors.commit();
 
-	if( requestedAttribs.count( geom::TANGENT ) ) {
+	if( calcTangents ) {
 		vector<vec3> tangents;
-		calculateTangents( indices.size(), indices.data(), positions.size(), positions.data(), normals.data(), texCoords.data(), &tangents, nullptr );
-		
-		if( requestedAttribs.count( geom::TANGENT ) )
-			target->copyAttrib( Attrib::TANGENT, 3, 0, (const float*)tangents.data(), tangents.size() );
+		calculateTangents( indices.size(), indices.data(), numVertices, positions.data(), normals.data(), texCoords.data(), &tangents, nullptr );
+		target->copyAttrib( Attrib::TANGENT, 3, 0, (const float*)tangents.data(), tangents.size() );
 	}
 
 	target->copyIndices( Primitive::TRIANGLES, indices.data(), indices.size(), 4 );
@@ -1998,18 +1992,11 @@ void Capsule::updateCounts()
 	mSubdivisionsHeight = std::max( mSubdivisionsHeight, 2 );
 }
 
-void Capsule::calculate( vector<vec3> *positions, vector<vec3> *normals, vector<vec2> *texCoords, vector<vec3> *colors, vector<uint32_t> *indices ) const
+void Capsule::calculate( AttribBuffer<vec3> *positions, AttribBuffer<vec3> *normals, AttribBuffer<vec2> *texCoords, AttribBuffer<vec3> *colors, vector<uint32_t> *indices ) const
 {
 	size_t ringsBody = mSubdivisionsHeight + 1;
 	size_t ringsTotal = mSubdivisionsHeight + ringsBody;
 
-	positions->reserve( mNumSegments * ringsTotal );
-	if( normals )
-		normals->reserve( mNumSegments * ringsTotal );
-	if( texCoords )
-		texCoords->reserve( mNumSegments * ringsTotal );
-	if( colors )
-		colors->reserve( mNumSegments * ringsTotal );
 	indices->reserve( ( mNumSegments - 1 ) * ( ringsTotal - 1 ) * 6 );
 
 	float bodyIncr = 1.0f / (float)( ringsBody - 1 );
@@ -2038,7 +2025,7 @@ void Capsule::calculate( vector<vec3> *positions, vector<vec3> *normals, vector<
 }
 
 void Capsule::calculateRing( size_t segments, float radius, float y, float dy,
-								vector<vec3> *positions, vector<vec3> *normals, vector<vec2> *texCoords, vector<vec3> *colors ) const
+								AttribBuffer<vec3> *positions, AttribBuffer<vec3> *normals, AttribBuffer<vec2> *texCoords, AttribBuffer<vec3> *colors ) const
 {
 	const quat quaternion( vec3( 0, 1, 0 ), mDirection );
 
@@ -2049,16 +2036,16 @@ void Capsule::calculateRing( size_t segments, float radius, float y, float dy,
 
 		positions->emplace_back( mCenter + ( quaternion * glm::vec3( mRadius * x, mRadius * y + mLength * dy, mRadius * z ) ) );
 
-		if( normals )
+		if( *normals )
 			normals->emplace_back( quaternion * glm::vec3( x, y, z ) );
 		// perform cylindrical projection
-		if( texCoords ) {
+		if( *texCoords ) {
 			float u = 1.0f - (s * segIncr);
 			float v = 0.5f - ((mRadius * y + mLength * dy) / (2.0f * mRadius + mLength));
 			texCoords->emplace_back( u, v );
 		}
 		
-		if( colors ) {
+		if( *colors ) {
 			float g = 0.5f + ((mRadius * y + mLength * dy) / (2.0f * mRadius + mLength));
 			colors->emplace_back( x * 0.5f + 0.5f, g, z * 0.5f + 0.5f );
 		}
@@ -2095,31 +2082,27 @@ AttribSet Capsule::getAvailableAttribs() const
 
 void Capsule::loadInto( Target *target, const AttribSet &requestedAttribs ) const
 {
-	std::vector<vec3> positions, normals;
-	std::vector<vec2> texCoords;
-	std::vector<vec3> colors;
-	std::vector<uint32_t> indices;
+	const size_t numVertices = getNumVertices();
+	// tangents are calculated from the positions, normals and tex coords, which then need to be readable
+	const bool calcTangents = requestedAttribs.count( Attrib::TANGENT ) > 0;
 
-	vector<vec3> *normalsPtr = ( requestedAttribs.count( Attrib::NORMAL ) || requestedAttribs.count( Attrib::TANGENT ) ) ? &normals : nullptr;
-	vector<vec2> *texCoordsPtr = ( requestedAttribs.count( Attrib::TEX_COORD_0 ) || requestedAttribs.count( Attrib::TANGENT ) ) ? &texCoords : nullptr;
-	vector<vec3> *colorsPtr = ( requestedAttribs.count( Attrib::COLOR ) ) ? &colors : nullptr;
+	AttribBuffer<vec3> positions( target, Attrib::POSITION, numVertices, requestedAttribs.count( Attrib::POSITION ) > 0, calcTangents );
+	AttribBuffer<vec3> normals( target, Attrib::NORMAL, numVertices, requestedAttribs.count( Attrib::NORMAL ) > 0, calcTangents );
+	AttribBuffer<vec2> texCoords( target, Attrib::TEX_COORD_0, numVertices, requestedAttribs.count( Attrib::TEX_COORD_0 ) > 0, calcTangents );
+	AttribBuffer<vec3> colors( target, Attrib::COLOR, numVertices, requestedAttribs.count( Attrib::COLOR ) > 0 );
+	std::vector<uint32_t> indices;
 
-	calculate( &positions, normalsPtr, texCoordsPtr, colorsPtr, &indices );
+	calculate( &positions, &normals, &texCoords, &colors, &indices );
 
-	target->copyAttrib( Attrib::POSITION, 3, 0, value_ptr( *positions.data() ), positions.size() );
-	if( normalsPtr )
-		target->copyAttrib( Attrib::NORMAL, 3, 0, value_ptr( *normals.data() ), normals.size() );
-	if( texCoordsPtr )
-		target->copyAttrib( Attrib::TEX_COORD_0, 2, 0, value_ptr( *texCoords.data() ), texCoords.size() );
-	if( colorsPtr )
-		target->copyAttrib( Attrib::COLOR, 3, 0, value_ptr( *colors.data() ), colors.size() );
+	positions.commit();
+	normals.commit();
+	texCoords.commit();
+	colors.commit();
 
-	if( requestedAttribs.count( geom::TANGENT ) ) {
+	if( calcTangents ) {
 		vector<vec3> tangents;
-		calculateTangents( indices.size(), indices.data(), positions.size(), positions.data(), normals.data(), texCoords.data(), &tangents, nullptr );
-		
-		if( requestedAttribs.count( geom::TANGENT ) )
-			target->copyAttrib( Attrib::TANGENT, 3, 0, (const float*)tangents.data(), tangents.size() );
+		calculateTangents( indices.size(), indices.data(), numVertices, positions.data(), normals.data(), texCoords.data(), &tangents, nullptr );
+		target->copyAttrib( Attrib::TANGENT, 3, 0, (const float*)tangents.data(), tangents.size() );
 	}
 
 	target->copyIndices( Primitive::TRIANGLES, indices.data(), indices.size(), 4 );
@@ -2158,13 +2141,8 @@ size_t Torus::getNumIndices() const
 	return (mNumAxis - 1) * (mNumRings - 1) * 6;
 }
 
-void Torus::calculate( vector<vec3> *positions, vector<vec3> *normals, vector<vec2> *texCoords, vector<vec3> *colors, vector<uint32_t> *indices ) const
+void Torus::calculate( AttribBuffer<vec3> *positions, AttribBuffer<vec3> *normals, AttribBuffer<vec2> *texCoords, AttribBuffer<vec3> *colors, vector<uint32_t> *indices ) const
 {
-	positions->reserve( mNumAxis * mNumRings );
-	normals->reserve( mNumAxis * mNumRings );
-	texCoords->reserve( mNumAxis * mNumRings );
-	if( colors )
-		colors->reserve( mNumAxis * mNumRings );
 	indices->reserve( (mNumAxis - 1) * (mNumRings - 1) * 6 );
 
 	float majorIncr = 1.0f / (mNumAxis - 1);
@@ -2189,13 +2167,12 @@ void Torus::calculate( vector<vec3> *positions, vector<vec3> *normals, vector<ve
 			float y = i * majorIncr * mHeight + sinTheta * radiusDiff;
 			float z = r * sinPhi;
 
+			const vec3 n( cosPhi * cosTheta, sinTheta, sinPhi * cosTheta );
+
 			positions->emplace_back( mCenter + vec3( x, y, z ) );
 			texCoords->emplace_back( i * majorIncr, j * minorIncr );
-			normals->emplace_back( cosPhi * cosTheta, sinTheta, sinPhi * cosTheta );
-
-			const vec3 &n = normals->back();
-			if( colors )
-				colors->emplace_back( n.x * 0.5f + 0.5f, n.y * 0.5f + 0.5f, n.z * 0.5f + 0.5f );
+			normals->emplace_back( n );
+			colors->emplace_back( n.x * 0.5f + 0.5f, n.y * 0.5f + 0.5f, n.z * 0.5f + 0.5f );
 		}
 	}
 
@@ -2233,27 +2210,27 @@ AttribSet Torus::getAvailableAttribs() const
 
 void Torus::loadInto( Target *target, const AttribSet &requestedAttribs ) const
 {
-	std::vector<vec3> positions, normals;
-	std::vector<vec2> texCoords;
-	std::vector<vec3> colors;
-	std::vector<uint32_t> indices;
+	const size_t numVertices = getNumVertices();
+	// tangents are calculated from the positions, normals and tex coords, which then need to be readable
+	const bool calcTangents = requestedAttribs.count( Attrib::TANGENT ) > 0;
 
-	vector<vec3> *colorsPtr = ( requestedAttribs.count( Attrib::COLOR ) ) ? &colors : nullptr;
+	AttribBuffer<vec3> positions( target, Attrib::POSITION, numVertices, requestedAttribs.count( Attrib::POSITION ) > 0, calcTangents );
+	AttribBuffer<vec3> normals( target, Attrib::NORMAL, numVertices, requestedAttribs.count( Attrib::NORMAL ) > 0, calcTangents );
+	AttribBuffer<vec2> texCoords( target, Attrib::TEX_COORD_0, numVertices, requestedAttribs.count( Attrib::TEX_COORD_0 ) > 0, calcTangents );
+	AttribBuffer<vec3> colors( target, Attrib::COLOR, numVertices, requestedAttribs.count( Attrib::COLOR ) > 0 );
+	std::vector<uint32_t> indices;
 
-	calculate( &positions, &normals, &texCoords, colorsPtr, &indices );
+	calculate( &positions, &normals, &texCoords, &colors, &indices );
 
-	target->copyAttrib( Attrib::POSITION, 3, 0, value_ptr( *positions.data() ), positions.size() );
-	target->copyAttrib( Attrib::NORMAL, 3, 0, value_ptr( *normals.data() ), normals.size() );
-	target->copyAttrib( Attrib::TEX_COORD_0, 2, 0, value_ptr( *texCoords.data() ), texCoords.size() );
-	if( requestedAttribs.count( Attrib::COLOR ) )
-		target->copyAttrib( Attrib::COLOR, 3, 0, value_ptr( *colors.data() ), colors.size() );
+	positions.commit();
+	normals.commit();
+	texCoords.commit();
+	colors.commit();
 
-	if( requestedAttribs.count( geom::TANGENT ) ) {
+	if( calcTangents ) {
 		vector<vec3> tangents;
-		calculateTangents( indices.size(), indices.data(), positions.size(), positions.data(), normals.data(), texCoords.data(), &tangents, nullptr );
-		
-		if( requestedAttribs.count( geom::TANGENT ) )
-			target->copyAttrib( Attrib::TANGENT, 3, 0, (const float*)tangents.data(), tangents.size() );
+		calculateTangents( indices.size(), indices.data(), numVertices, positions.data(), normals.data(), texCoords.data(), &tangents, nullptr );
+		target->copyAttrib( Attrib::TANGENT, 3, 0, (const float*)tangents.data(), tangents.size() );
 	}
 
 	target->copyIndices( Primitive::TRIANGLES, indices.data(), indices.size(), 4 );
@@ -2299,30 +2276,26 @@ void TorusKnot::loadInto( Target *target, const AttribSet &requestedAttribs ) co
 	auto numVertices = getNumVertices();
 	auto numIndices = getNumIndices();
 
-	std::vector<vec3> positions( numVertices ), normals( numVertices );
-	std::vector<vec2> texCoords( numVertices );
-	std::vector<vec3> colors( numVertices );
-	std::vector<vec3> tangents( numVertices );
+	// the tangents are calculated analytically, so every attribute can be written into the target directly
+	AttribBuffer<vec3> positions( target, Attrib::POSITION, numVertices, requestedAttribs.count( Attrib::POSITION ) > 0 );
+	AttribBuffer<vec3> normals( target, Attrib::NORMAL, numVertices, requestedAttribs.count( Attrib::NORMAL ) > 0 );
+	AttribBuffer<vec2> texCoords( target, Attrib::TEX_COORD_0, numVertices, requestedAttribs.count( Attrib::TEX_COORD_0 ) > 0 );
+	AttribBuffer<vec3> colors( target, Attrib::COLOR, numVertices, requestedAttribs.count( Attrib::COLOR ) > 0 );
+	AttribBuffer<vec3> tangents( target, Attrib::TANGENT, numVertices, requestedAttribs.count( Attrib::TANGENT ) > 0 );
 	std::vector<uint32_t> indices( numIndices );
 
-	std::vector<vec3> *colorsPtr = ( requestedAttribs.count( Attrib::COLOR ) ) ? &colors : nullptr;
-	std::vector<vec3> *tangentsPtr = ( requestedAttribs.count( Attrib::TANGENT ) ) ? &tangents : nullptr;
+	calculate( &positions, &normals, &texCoords, &colors, &tangents, &indices );
 
-	calculate( &positions, &normals, &texCoords, colorsPtr, tangentsPtr, &indices );
-
-	target->copyAttrib( Attrib::POSITION, 3, 0, value_ptr( *positions.data() ), positions.size() );
-	target->copyAttrib( Attrib::NORMAL, 3, 0, value_ptr( *normals.data() ), normals.size() );
-	target->copyAttrib( Attrib::TEX_COORD_0, 2, 0, value_ptr( *texCoords.data() ), texCoords.size() );
-
-	if( requestedAttribs.count( Attrib::COLOR ) )
-		target->copyAttrib( Attrib::COLOR, 3, 0, value_ptr( *colors.data() ), colors.size() );
-	if( requestedAttribs.count( geom::TANGENT ) )
-		target->copyAttrib( Attrib::TANGENT, 3, 0, value_ptr( *tangents.data() ), tangents.size() );
+	positions.commit();
+	normals.commit();
+	texCoords.commit();
+	colors.commit();
+	tangents.commit();
 
 	target->copyIndices( Primitive::TRIANGLES, indices.data(), indices.size(), 4 );
 }
 
-void TorusKnot::calculate( std::vector<vec3> *positions, std::vector<vec3> *normals, std::vector<vec2> *texCoords, std::vector<vec3> *colors, std::vector<vec3> *tangents, std::vector<uint32_t> *indices ) const
+void TorusKnot::calculate( AttribBuffer<vec3> *positions, AttribBuffer<vec3> *normals, AttribBuffer<vec2> *texCoords, AttribBuffer<vec3> *colors, AttribBuffer<vec3> *tangents, std::vector<uint32_t> *indices ) const
 {
 	float stepHeight = float( 2.0 * M_PI ) / mSubdivisionsHeight;
 	float stepAxis = float( 2.0 * M_PI ) / mSubdivisionsAxis;
@@ -2352,17 +2325,18 @@ void TorusKnot::calculate( std::vector<vec3> *positions, std::vector<vec3> *norm
 			float y = glm::sin( j * stepAxis ) * mRadius;
 
 			int idx = i * ( mSubdivisionsAxis + 1 ) + j;
-			( *normals )[idx] = B * x + N * y;
-			( *positions )[idx] = ( *normals )[idx] + center;
-			( *normals )[idx] = glm::normalize( ( *normals )[idx] );
-			( *texCoords )[idx].y = float( j ) / mSubdivisionsAxis;
-			( *texCoords )[idx].x = float( i ) / mSubdivisionsHeight;
-
-			if( tangents )
+			const vec3 offset = B * x + N * y;
+			const vec3 normal = glm::normalize( offset );
+			if( *positions )
+				( *positions )[idx] = offset + center;
+			if( *normals )
+				( *normals )[idx] = normal;
+			if( *texCoords )
+				( *texCoords )[idx] = vec2( float( i ) / mSubdivisionsHeight, float( j ) / mSubdivisionsAxis );
+			if( *tangents )
 				( *tangents )[idx] = T; 
-			
-			if( colors )
-				( *colors )[idx] = ( *normals )[idx] * 0.5f + 0.5f;
+			if( *colors )
+				( *colors )[idx] = normal * 0.5f + 0.5f;
 		}
 	}
 
@@ -2428,14 +2402,9 @@ size_t Cylinder::getNumIndices() const
 	return result;
 }
 
-void Cylinder::calculate( vector<vec3> *positions, vector<vec3> *normals, vector<vec2> *texCoords, vector<vec3> *colors, vector<uint32_t> *indices ) const
+void Cylinder::calculate( AttribBuffer<vec3> *positions, AttribBuffer<vec3> *normals, AttribBuffer<vec2> *texCoords, AttribBuffer<vec3> *colors, vector<uint32_t> *indices ) const
 {
-	positions->reserve( mNumSegments * mNumSlices );
-	normals->reserve( mNumSegments * mNumSlices );
-	texCoords->reserve( mNumSegments * mNumSlices );
-	indices->reserve( (mNumSegments - 1) * (mNumSlices - 1) * 6 );
-
-	colors->reserve( mNumSegments * mNumSlices );
+	indices->reserve( getNumIndices() );
 
 	const float segmentIncr = 1.0f / (mNumSegments - 1);
 	const float ringIncr = 1.0f / (mNumSlices - 1);
@@ -2481,13 +2450,16 @@ void Cylinder::calculate( vector<vec3> *positions, vector<vec3> *normals, vector
 		calculateCap( false, mHeight, mRadiusApex, positions, normals, texCoords, colors, indices );
 }
 
-void Cylinder::calculateCap( bool flip, float height, float radius, vector<vec3> *positions, vector<vec3> *normals,
-								vector<vec2> *texCoords, vector<vec3> *colors, vector<uint32_t> *indices ) const
+void Cylinder::calculateCap( bool flip, float height, float radius, AttribBuffer<vec3> *positions, AttribBuffer<vec3> *normals,
+								AttribBuffer<vec2> *texCoords, AttribBuffer<vec3> *colors, vector<uint32_t> *indices ) const
 {
+	// 'positions' counts the vertices even when it has no storage
 	const size_t index = positions->size();
 	const vec3 n = flip ? -mDirection : mDirection;
-	normals->resize( index + mSubdivisionsCap * mNumSegments * 2, n );
-	colors->resize( index + mSubdivisionsCap *mNumSegments * 2, vec3( n.x * 0.5f + 0.5f, n.y * 0.5f + 0.5f, n.z * 0.5f + 0.5f ) );
+	for( int i = 0; i < mSubdivisionsCap * mNumSegments * 2; ++i ) {
+		normals->push_back( n );
+		colors->emplace_back( n.x * 0.5f + 0.5f, n.y * 0.5f + 0.5f, n.z * 0.5f + 0.5f );
+	}
 
 	const quat axis = glm::rotation( vec3( 0, 1, 0 ), mDirection );
 
@@ -2517,8 +2489,6 @@ void Cylinder::calculateCap( bool flip, float height, float radius, vector<vec3>
 	}
 
 	// index buffer
-	indices->reserve( indices->size() + 6 * mNumSegments * mSubdivisionsCap );
-
 	for( int r = 0; r < mSubdivisionsCap; ++r ) {
 		for( int i = 0; i < ( mNumSegments - 1 ); ++i ) {
 			if( flip ) {
@@ -2563,23 +2533,27 @@ AttribSet Cylinder::getAvailableAttribs() const
 
 void Cylinder::loadInto( Target *target, const AttribSet &requestedAttribs ) const
 {
-	vector<vec3> positions, normals, colors;
-	vector<vec2> texCoords;
+	const size_t numVertices = getNumVertices();
+	// tangents are calculated from the positions, normals and tex coords, which then need to be readable
+	const bool calcTangents = requestedAttribs.count( Attrib::TANGENT ) > 0;
+
+	AttribBuffer<vec3> positions( target, Attrib::POSITION, numVertices, requestedAttribs.count( Attrib::POSITION ) > 0, calcTangents );
+	AttribBuffer<vec3> normals( target, Attrib::NORMAL, numVertices, requestedAttribs.count( Attrib::NORMAL ) > 0, calcTangents );
+	AttribBuffer<vec2> texCoords( target, Attrib::TEX_COORD_0, numVertices, requestedAttribs.count( Attrib::TEX_COORD_0 ) > 0, calcTangents );
+	AttribBuffer<vec3> colors( target, Attrib::COLOR, numVertices, requestedAttribs.count( Attrib::COLOR ) > 0 );
 	vector<uint32_t> indices;
 
 	calculate( &positions, &normals, &texCoords, &colors, &indices );
 
-	target->copyAttrib( Attrib::POSITION, 3, 0, value_ptr( *positions.data() ), positions.size() );
-	target->copyAttrib( Attrib::NORMAL, 3, 0, value_ptr( *normals.data() ), normals.size() );
-	target->copyAttrib( Attrib::TEX_COORD_0, 2, 0, value_ptr( *texCoords.data() ), texCoords.size() );
-	target->copyAttrib( Attrib::COLOR, 3, 0, value_ptr( *colors.data() ), colors.size() );
+	positions.commit();
+	normals.commit();
+	texCoords.commit();
+	colors.commit();
 
-	if( requestedAttribs.count( geom::TANGENT ) ) {
+	if( calcTangents ) {
 		vector<vec3> tangents;
-		calculateTangents( indices.size(), indices.data(), positions.size(), positions.data(), normals.data(), texCoords.data(), &tangents, nullptr );
-		
-		if( requestedAttribs.count( geom::TANGENT ) )
-			target->copyAttrib( Attrib::TANGENT, 3, 0, (const float*)tangents.data(), tangents.size() );
+		calculateTangents( indices.size(), indices.data(), numVertices, positions.data(), normals.data(), texCoords.data(), &tangents, nullptr );
+		target->copyAttrib( Attrib::TANGENT, 3, 0, (const float*)tangents.data(), tangents.size() );
 	}
 
 	target->copyIndices( Primitive::TRIANGLES, indices.data(), indices.size(), 4 );
@@ -2643,14 +2617,15 @@ AttribSet Plane::getAvailableAttribs() const
 
 void Plane::loadInto( Target *target, const AttribSet &requestedAttribs ) const
 {
-	std::vector<vec3> positions, normals;
-	std::vector<vec2> texCoords;
-	std::vector<uint32_t> indices;
-
 	const size_t numVerts = ( mSubdivisions.x + 1 ) * ( mSubdivisions.y + 1 );
-	positions.reserve( numVerts );
-	normals.reserve( numVerts );
-	texCoords.reserve( numVerts );
+	// tangents are calculated from the positions, normals and tex coords, which then need to be readable
+	const bool calcTangents = requestedAttribs.count( Attrib::TANGENT ) > 0;
+
+	AttribBuffer<vec3> positions( target, Attrib::POSITION, numVerts, requestedAttribs.count( Attrib::POSITION ) > 0, calcTangents );
+	AttribBuffer<vec3> normals( target, Attrib::NORMAL, numVerts, requestedAttribs.count( Attrib::NORMAL ) > 0, calcTangents );
+	AttribBuffer<vec2> texCoords( target, Attrib::TEX_COORD_0, numVerts, requestedAttribs.count( Attrib::TEX_COORD_0 ) > 0, calcTangents );
+	std::vector<uint32_t> indices;
+	indices.reserve( getNumIndices() );
 
 	const vec2 stepIncr = vec2( 1, 1 ) / vec2( mSubdivisions );
 	const vec3 normal = cross( mAxisV, mAxisU );
@@ -2682,17 +2657,15 @@ void Plane::loadInto( Target *target, const AttribSet &requestedAttribs ) const
 	}
 
 
-	target->copyAttrib( Attrib::POSITION, 3, 0, value_ptr( *positions.data() ), positions.size() );
-	target->copyAttrib( Attrib::NORMAL, 3, 0, value_ptr( *normals.data() ), normals.size() );
-	target->copyAttrib( Attrib::TEX_COORD_0, 2, 0, value_ptr( *texCoords.data() ), texCoords.size() );
+	positions.commit();
+	normals.commit();
+	texCoords.commit();
 
 	// generate tangents
-	if( requestedAttribs.count( geom::TANGENT ) ) {
+	if( calcTangents ) {
 		vector<vec3> tangents;
-		calculateTangents( getNumIndices(), indices.data(), positions.size(), positions.data(), normals.data(), texCoords.data(), &tangents, nullptr );
-		
-		if( requestedAttribs.count( geom::TANGENT ) )
-			target->copyAttrib( Attrib::TANGENT, 3, 0, (const float*)tangents.data(), tangents.size() );
+		calculateTangents( getNumIndices(), indices.data(), numVerts, positions.data(), normals.data(), texCoords.data(), &tangents, nullptr );
+		target->copyAttrib( Attrib::TANGENT, 3, 0, (const float*)tangents.data(), tangents.size() );
 	}
 	
 	target->copyIndices( Primitive::TRIANGLES, indices.data(), indices.size(), 4 );
@@ -3297,19 +3270,21 @@ void Extrude::loadInto( Target *target, const AttribSet &requestedAttribs ) cons
 	vector<vec3> positions, normals, texCoords;
 	vector<uint32_t> indices;
 
+	// the vertex count is only known once the contours have been triangulated, so this can't write into the target's storage directly
 	calculate( &positions, &normals, &texCoords, &indices );
 
-	target->copyAttrib( Attrib::POSITION, 3, 0, (const float*)positions.data(), positions.size() );
-	target->copyAttrib( Attrib::NORMAL, 3, 0, (const float*)normals.data(), normals.size() );
-	target->copyAttrib( Attrib::TEX_COORD_0, 3, 0, (const float*)texCoords.data(), texCoords.size() );
+	if( requestedAttribs.count( Attrib::POSITION ) )
+		target->copyAttrib( Attrib::POSITION, 3, 0, (const float*)positions.data(), positions.size() );
+	if( requestedAttribs.count( Attrib::NORMAL ) )
+		target->copyAttrib( Attrib::NORMAL, 3, 0, (const float*)normals.data(), normals.size() );
+	if( requestedAttribs.count( Attrib::TEX_COORD_0 ) )
+		target->copyAttrib( Attrib::TEX_COORD_0, 3, 0, (const float*)texCoords.data(), texCoords.size() );
 
 	// generate tangents
 	if( requestedAttribs.count( geom::TANGENT ) ) {
 		vector<vec3> tangents;
 		calculateTangents( getNumIndices(), indices.data(), positions.size(), positions.data(), normals.data(), texCoords.data(), &tangents, nullptr );
-		
-		if( requestedAttribs.count( geom::TANGENT ) )
-			target->copyAttrib( Attrib::TANGENT, 3, 0, (const float*)tangents.data(), tangents.size() );
+		target->copyAttrib( Attrib::TANGENT, 3, 0, (const float*)tangents.data(), tangents.size() );
 	}
 
 	target->copyIndices( Primitive::TRIANGLES, indices.data(), indices.size(), calcIndicesRequiredBytes( indices.size() ) );
@@ -3503,19 +3478,21 @@ void ExtrudeSpline::loadInto( Target *target, const AttribSet &requestedAttribs
 	vector<vec3> positions, normals, texCoords;
 	vector<uint32_t> indices;
 
+	// the vertex count is only known once the contours have been triangulated, so this can't write into the target's storage directly
 	calculate( &positions, &normals, &texCoords, &indices );
 
-	target->copyAttrib( Attrib::POSITION, 3, 0, (const float*)positions.data(), positions.size() );
-	target->copyAttrib( Attrib::NORMAL, 3, 0, (const float*)normals.data(), normals.size() );
-	target->copyAttrib( Attrib::TEX_COORD_0, 3, 0, (const float*)texCoords.data(), texCoords.size() );
+	if( requestedAttribs.count( Attrib::POSITION ) )
+		target->copyAttrib( Attrib::POSITION, 3, 0, (const float*)positions.data(), positions.size() );
+	if( requestedAttribs.count( Attrib::NORMAL ) )
+		target->copyAttrib( Attrib::NORMAL, 3, 0, (const float*)normals.data(), normals.size() );
+	if( requestedAttribs.count( Attrib::TEX_COORD_0 ) )
+		target->copyAttrib( Attrib::TEX_COORD_0, 3, 0, (const float*)texCoords.data(), texCoords.size() );
 
 	// generate tangents
 	if( requestedAttribs.count( geom::TANGENT ) ) {
 		vector<vec3> tangents;
 		calculateTangents( getNumIndices(), indices.data(), positions.size(), positions.data(), normals.data(), texCoords.data(), &tangents, nullptr );
-		
-		if( requestedAttribs.count( geom::TANGENT ) )
-			target->copyAttrib( Attrib::TANGENT, 3, 0, (const float*)tangents.data(), tangents.size() );
+		target->copyAttrib( Attrib::TANGENT, 3, 0, (const float*)tangents.data(), tangents.size() );
 	}
 
 	target->copyIndices( Primitive::TRIANGLES, indices.data(), indices.size(), calcIndicesRequiredBytes( indices.size() ) );
@@ -3593,10 +3570,12 @@ AttribSet BSpline::getAvailableAttribs() const
 	return { Attrib::POSITION, Attrib::NORMAL };
 }
 
-void BSpline::loadInto( Target *target, const AttribSet & /*requestedAttribs*/ ) const
+void BSpline::loadInto( Target *target, const AttribSet &requestedAttribs ) const
 {
-	target->copyAttrib( Attrib::POSITION, mPositionDims, 0, mPositions.data(), mNumVertices );
-	target->copyAttrib( Attrib::NORMAL, 3, 0, (const float*)mNormals.data(), mNumVertices );
+	if( requestedAttribs.count( Attrib::POSITION ) )
+		target->copyAttrib( Attrib::POSITION, mPositionDims, 0, mPositions.data(), mNumVertices );
+	if( requestedAttribs.count( Attrib::NORMAL ) )
+		target->copyAttrib( Attrib::NORMAL, 3, 0, (const float*)mNormals.data(), mNumVertices );
 }
 
 template CI_API BSpline::BSpline( const ci::BSpline<2, float>&, int );
@@ -5083,6 +5062,32 @@ void SourceModsContext::copyAttrib( Attrib attr, uint8_t dims, size_t strideByte
 	copyData( dims, strideBytes, srcData, count, dims, 0, mAttribData.at( attr ).get() );
 }
 
+float* SourceModsContext::acquireAttribBuffer( Attrib attr, uint8_t dims, size_t count, size_t *resultStrideBytes )
+{
+	// see copyAttrib() regarding the attribMask; the Source will send this attribute to copyAttrib(), which ignores it
+	if( mAttribMask && mAttribMask->count( attr ) == 0 )
+		return nullptr;
+
+	mNumVertices = count;
+
+	// reuse the existing allocation when its parameters match, as copyAttrib() does
+	bool needsAllocation = ( mAttribCount.count( attr ) == 0 ) || ( mAttribData.count( attr ) == 0 ) || ( mAttribInfo.count( attr ) == 0 );
+	if( ! needsAllocation ) {
+		const AttribInfo &attribInfo = mAttribInfo.at( attr );
+		needsAllocation = ( attribInfo.getDims() != dims ) || ( count != mAttribCount[attr] );
+	}
+
+	if( needsAllocation ) {
+		mAttribData[attr] = unique_ptr<float[]>( new float[dims * count] );
+		mAttribCount[attr] = count;
+		auto it = mAttribInfo.insert( make_pair( attr, AttribInfo( attr, dims, dims * sizeof(float), (size_t)0 ) ) ).first;
+		it->second = AttribInfo( attr, dims, dims * sizeof(float), (size_t)0 );
+	}
+
+	*resultStrideBytes = dims * sizeof(float);
+	return mAttribData.at( attr ).get();
+}
+
 void SourceModsContext::appendAttrib( Attrib attr, uint8_t dims, const float *srcData, size_t count )
 {
 	// if we don't have any data for this attribute, just call copyAttrib
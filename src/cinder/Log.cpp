@@ -46,9 +46,19 @@
 	#error "This file must be compiled as Objective-C++ on the Mac"
 #endif
 
+#include "cinder/Thread.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
 #include <mutex>
+#include <thread>
 #include <time.h>
 
+#if defined( CINDER_POSIX )
+	#include <pthread.h>
+#endif
+
 using namespace std;
 
 namespace cinder { namespace log {
@@ -88,6 +98,312 @@ const std::string getDailyLogString( const std::string& format )
 
 } // anonymous namespace
 
+// ----------------------------------------------------------------------------------------------------
+// LogManager::AsyncWriter
+// ----------------------------------------------------------------------------------------------------
+
+namespace {
+
+struct AsyncRecord {
+	Metadata	mMeta;
+	string		mText;
+};
+
+//! Ring of records with a single producer (the logging thread that owns it) and a single consumer (the AsyncWriter thread).
+//! Records are copied into preallocated slots, so once a slot's strings have grown large enough pushing doesn't allocate.
+struct AsyncQueue {
+	AsyncQueue( size_t capacity, uint64_t writerId )
+		: mRecords( capacity ), mMask( capacity - 1 ), mWriterId( writerId ), mHead( 0 ), mTail( 0 ), mProducerExited( false )
+	{}
+
+	vector<AsyncRecord>		mRecords;
+	const uint64_t			mMask;
+	const uint64_t			mWriterId;
+	atomic<uint64_t>		mHead;			// written by the producer
+	char					mPadding[64];	// keeps mHead and mTail on separate cache lines
+	atomic<uint64_t>		mTail;			// written by the consumer
+	atomic<bool>			mProducerExited;
+};
+
+// Each thread holds on to its own queue. When the thread exits its queue is marked so that the AsyncWriter can release it once drained.
+#if defined( CINDER_POSIX )
+pthread_key_t	sThreadQueueKey;
+pthread_once_t	sThreadQueueKeyOnce = PTHREAD_ONCE_INIT;
+
+void releaseThreadQueue( void *value )
+{
+	auto queue = static_cast<shared_ptr<AsyncQueue>*>( value );
+	if( *queue )
+		(*queue)->mProducerExited = true;
+	delete queue;
+}
+
+void createThreadQueueKey()
+{
+	pthread_key_create( &sThreadQueueKey, releaseThreadQueue );
+}
+
+shared_ptr<AsyncQueue>* getThreadQueue()
+{
+	pthread_once( &sThreadQueueKeyOnce, createThreadQueueKey );
+	auto queue = static_cast<shared_ptr<AsyncQueue>*>( pthread_getspecific( sThreadQueueKey ) );
+	if( ! queue ) {
+		queue = new shared_ptr<AsyncQueue>;
+		pthread_setspecific( sThreadQueueKey, queue );
+	}
+	return queue;
+}
+#else
+struct ThreadQueue {
+	~ThreadQueue()
+	{
+		if( mQueue )
+			mQueue->mProducerExited = true;
+	}
+
+	shared_ptr<AsyncQueue>	mQueue;
+};
+
+thread_local ThreadQueue sThreadQueue;
+
+shared_ptr<AsyncQueue>* getThreadQueue()
+{
+	return &sThreadQueue.mQueue;
+}
+#endif
+
+uint64_t nextAsyncWriterId()
+{
+	static atomic<uint64_t> sNextId( 1 );
+	return sNextId++;
+}
+
+size_t nextPowerOfTwo( size_t value )
+{
+	size_t result = 2;
+	while( result < value )
+		result *= 2;
+	return result;
+}
+
+} // anonymous namespace
+
+class LogManager::AsyncWriter : private Noncopyable {
+  public:
+	AsyncWriter( LogManager *manager, size_t queueSize, QueueFullPolicy policy );
+	//! Writes all pending records before the background thread exits. No thread may push() once this has been called.
+	~AsyncWriter();
+
+	//! Queues a copy of \a meta and \a text on the calling thread's queue.
+	void		push( const Metadata &meta, const string &text );
+	//! Blocks until every queue has been drained up to the point it was at when flush() was called.
+	void		flush();
+	bool		isWriterThread() const			{ return this_thread::get_id() == mThread.get_id(); }
+	uint64_t	getNumDroppedRecords() const	{ return mNumDroppedRecords; }
+
+  private:
+	AsyncQueue*	getQueue();
+	void		wake();
+	void		threadEntry();
+	//! Writes all queued records to the Loggers. Returns true if there were any.
+	bool		drain();
+	bool		hasPendingRecords();
+
+	LogManager				*mManager;
+	const size_t			mQueueSize;
+	const QueueFullPolicy	mPolicy;
+	const uint64_t			mId;
+
+	mutex							mQueuesMutex;
+	vector<shared_ptr<AsyncQueue>>	mQueues;			// guarded by mQueuesMutex
+	atomic<uint64_t>				mQueuesVersion;
+	vector<shared_ptr<AsyncQueue>>	mDrainQueues;		// the writer thread's copy of mQueues
+	uint64_t						mDrainQueuesVersion;
+
+	mutex					mWakeMutex;
+	condition_variable		mWakeCondition, mDrainedCondition;
+	bool					mWakeRequested;		// guarded by mWakeMutex
+	atomic<bool>			mSleeping, mShouldQuit;
+	atomic<uint64_t>		mNumDroppedRecords;
+
+	thread					mThread;
+};
+
+LogManager::AsyncWriter::AsyncWriter( LogManager *manager, size_t queueSize, QueueFullPolicy policy )
+	: mManager( manager ), mQueueSize( nextPowerOfTwo( queueSize ) ), mPolicy( policy ), mId( nextAsyncWriterId() ), mQueuesVersion( 0 ), mDrainQueuesVersion( 0 ),
+		mWakeRequested( false ), mSleeping( false ), mShouldQuit( false ), mNumDroppedRecords( 0 )
+{
+	mThread = thread( &AsyncWriter::threadEntry, this );
+}
+
+LogManager::AsyncWriter::~AsyncWriter()
+{
+	mShouldQuit = true;
+	wake();
+	mThread.join();
+}
+
+AsyncQueue* LogManager::AsyncWriter::getQueue()
+{
+	// a thread's queue is replaced when it was created for a previous AsyncWriter
+	auto queue = getThreadQueue();
+	if( ! *queue || (*queue)->mWriterId != mId ) {
+		auto newQueue = make_shared<AsyncQueue>( mQueueSize, mId );
+		{
+			lock_guard<mutex> lock( mQueuesMutex );
+			mQueues.push_back( newQueue );
+			mQueuesVersion++;
+		}
+		*queue = newQueue;
+	}
+
+	return queue->get();
+}
+
+void LogManager::AsyncWriter::push( const Metadata &meta, const string &text )
+{
+	AsyncQueue *queue = getQueue();
+
+	const uint64_t head = queue->mHead.load( memory_order_relaxed );
+	while( head - queue->mTail.load( memory_order_acquire ) > queue->mMask ) {
+		if( mPolicy == QueueFullPolicy::DROP ) {
+			mNumDroppedRecords++;
+			return;
+		}
+
+		if( mSleeping )
+			wake();
+		this_thread::yield();
+	}
+
+	AsyncRecord &record = queue->mRecords[head & queue->mMask];
+	record.mMeta = meta;
+	record.mText.assign( text );
+
+	// sequentially consistent with the writer thread setting mSleeping before it checks for pending records, so either it sees this record or we wake it.
+	queue->mHead.store( head + 1 );
+	if( mSleeping )
+		wake();
+}
+
+void LogManager::AsyncWriter::flush()
+{
+	if( isWriterThread() )
+		return;
+
+	vector<pair<shared_ptr<AsyncQueue>, uint64_t>> targets;
+	{
+		lock_guard<mutex> lock( mQueuesMutex );
+		for( const auto &queue : mQueues )
+			targets.emplace_back( queue, queue->mHead.load() );
+	}
+
+	auto isFlushed = [&targets] {
+		for( const auto &target : targets ) {
+			if( target.first->mTail.load() < target.second )
+				return false;
+		}
+		return true;
+	};
+
+	wake();
+	unique_lock<mutex> lock( mWakeMutex );
+	mDrainedCondition.wait( lock, isFlushed );
+}
+
+void LogManager::AsyncWriter::wake()
+{
+	{
+		lock_guard<mutex> lock( mWakeMutex );
+		mWakeRequested = true;
+	}
+	mWakeCondition.notify_one();
+}
+
+void LogManager::AsyncWriter::threadEntry()
+{
+	ThreadSetup threadSetup;
+
+	while( true ) {
+		if( drain() )
+			continue;
+
+		if( mShouldQuit ) {
+			// all pushes happened before mShouldQuit was set, but possibly after the last drain()
+			while( drain() )
+				;
+			break;
+		}
+
+		mSleeping = true;
+		if( ! hasPendingRecords() ) {
+			unique_lock<mutex> lock( mWakeMutex );
+			mWakeCondition.wait_for( lock, chrono::milliseconds( 100 ), [this] { return mWakeRequested; } );
+			mWakeRequested = false;
+		}
+		mSleeping = false;
+	}
+}
+
+bool LogManager::AsyncWriter::drain()
+{
+	if( mDrainQueuesVersion != mQueuesVersion ) {
+		lock_guard<mutex> lock( mQueuesMutex );
+		mDrainQueues = mQueues;
+		mDrainQueuesVersion = mQueuesVersion;
+	}
+
+	bool wroteRecords = false;
+	bool hasExitedQueues = false;
+	for( const auto &queue : mDrainQueues ) {
+		const bool producerExited = queue->mProducerExited;
+		uint64_t tail = queue->mTail.load( memory_order_relaxed );
+		const uint64_t head = queue->mHead.load( memory_order_acquire );
+		if( tail == head ) {
+			hasExitedQueues |= producerExited;
+			continue;
+		}
+
+		lock_guard<mutex> lock( mManager->mMutex );
+		for( ; tail != head; ++tail ) {
+			const AsyncRecord &record = queue->mRecords[tail & queue->mMask];
+			for( auto &logger : mManager->mLoggers )
+				logger->write( record.mMeta, record.mText );
+
+			queue->mTail.store( tail + 1, memory_order_release );
+		}
+		wroteRecords = true;
+	}
+
+	if( hasExitedQueues ) {
+		lock_guard<mutex> lock( mQueuesMutex );
+		mQueues.erase( remove_if( mQueues.begin(), mQueues.end(), []( const shared_ptr<AsyncQueue> &queue ) {
+			return queue->mProducerExited && queue->mTail == queue->mHead;
+		} ), mQueues.end() );
+		mQueuesVersion++;
+	}
+
+	if( wroteRecords ) {
+		// taking the lock ensures a flush() that just found its queues not yet drained is waiting before being notified
+		{
+			lock_guard<mutex> lock( mWakeMutex );
+		}
+		mDrainedCondition.notify_all();
+	}
+
+	return wroteRecords;
+}
+
+bool LogManager::AsyncWriter::hasPendingRecords()
+{
+	lock_guard<mutex> lock( mQueuesMutex );
+	for( const auto &queue : mQueues ) {
+		if( queue->mTail.load() != queue->mHead.load() )
+			return true;
+	}
+	return false;
+}
+
 // ----------------------------------------------------------------------------------------------------
 // LogManager
 // ----------------------------------------------------------------------------------------------------
@@ -100,10 +416,16 @@ LogManager* manager()
 }
 
 LogManager::LogManager()
+	: mAsyncEnabled( false ), mNumAsyncWrites( 0 ), mNumDroppedRecords( 0 )
 {
 	restoreToDefault();
 }
 
+LogManager::~LogManager()
+{
+	disableAsync();
+}
+
 void LogManager::clearLoggers()
 {
 	lock_guard<mutex> lock( mMutex );
@@ -152,6 +474,25 @@ void LogManager::restoreToDefault()
 }
 	
 void LogManager::write( const Metadata &meta, const std::string &text )
+{
+	if( mAsyncEnabled ) {
+		// mNumAsyncWrites keeps mAsyncWriter alive until this thread is done with it
+		mNumAsyncWrites++;
+		if( mAsyncEnabled && ! mAsyncWriter->isWriterThread() ) {
+			mAsyncWriter->push( meta, text );
+			if( meta.mLevel == LEVEL_FATAL )
+				mAsyncWriter->flush();
+
+			mNumAsyncWrites--;
+			return;
+		}
+		mNumAsyncWrites--;
+	}
+
+	writeToLoggers( meta, text );
+}
+
+void LogManager::writeToLoggers( const Metadata &meta, const std::string &text )
 {
 	// TODO move this to a shared_lock_timed with c++14 support
 	lock_guard<mutex> lock( mMutex );
@@ -161,6 +502,61 @@ void LogManager::write( const Metadata &meta, const std::string &text )
 	}
 }
 
+void LogManager::enableAsync( size_t queueSize, QueueFullPolicy policy )
+{
+	// the shared LogManager is leaked at shutdown, so make sure pending records are written before the process exits
+	static once_flag sFlushAtExitFlag;
+	call_once( sFlushAtExitFlag, [] {
+		atexit( [] {
+			if( LogManager::instance() )
+				LogManager::instance()->disableAsync();
+		} );
+	} );
+
+	// the previous AsyncWriter is replaced under one hold of the mutex, so a concurrent enableAsync() or disableAsync() can't come in between
+	lock_guard<mutex> lock( mAsyncMutex );
+	destroyAsyncWriter();
+	mAsyncWriter.reset( new AsyncWriter( this, queueSize, policy ) );
+	mAsyncEnabled = true;
+}
+
+void LogManager::disableAsync()
+{
+	lock_guard<mutex> lock( mAsyncMutex );
+	destroyAsyncWriter();
+}
+
+void LogManager::destroyAsyncWriter()
+{
+	if( ! mAsyncWriter )
+		return;
+
+	// new records go straight to the Loggers from here on. Wait for the ones that are still being pushed, the AsyncWriter writes them all before its thread exits.
+	mAsyncEnabled = false;
+	while( mNumAsyncWrites > 0 )
+		this_thread::yield();
+
+	mNumDroppedRecords += mAsyncWriter->getNumDroppedRecords();
+	mAsyncWriter.reset();
+}
+
+void LogManager::flush()
+{
+	if( ! mAsyncEnabled )
+		return;
+
+	mNumAsyncWrites++;
+	if( mAsyncEnabled )
+		mAsyncWriter->flush();
+	mNumAsyncWrites--;
+}
+
+uint64_t LogManager::getNumDroppedRecords() const
+{
+	lock_guard<mutex> lock( mAsyncMutex );
+	return mNumDroppedRecords + ( mAsyncWriter ? mAsyncWriter->getNumDroppedRecords() : 0 );
+}
+
 // ----------------------------------------------------------------------------------------------------
 // Entry
 // ----------------------------------------------------------------------------------------------------
@@ -24,34 +24,434 @@
 */
 
 #include "cinder/ObjLoader.h"
+#include "cinder/ThreadPool.h"
 
+#include <cfloat>
+#include <cstdlib>
+#include <cstring>
 #include <sstream>
-using namespace std;
 
-// For stoi
-#if defined( CINDER_ANDROID )
-	#include "cinder/android/CinderAndroid.h"
-#endif
+using namespace std;
 
 namespace cinder {
 
+namespace {
+
+// Inputs are only split into parallel chunks of at least this many bytes
+const size_t MIN_PARSE_CHUNK_SIZE = 1 << 20;
+
+inline bool isSpace( char c )
+{
+	return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+inline bool isDigit( char c )
+{
+	return c >= '0' && c <= '9';
+}
+
+inline const char* skipSpace( const char *p, const char *end )
+{
+	while( p < end && isSpace( *p ) )
+		++p;
+	return p;
+}
+
+inline const char* skipToken( const char *p, const char *end )
+{
+	while( p < end && ! isSpace( *p ) )
+		++p;
+	return p;
+}
+
+//! Returns the start of the line following the one that ends at \a lineEnd, treating "\n", "\r\n" and "\r" as line endings like IStreamCinder::readLine().
+inline const char* nextLine( const char *lineEnd, const char *end )
+{
+	if( lineEnd == end )
+		return end;
+	if( *lineEnd == '\r' && lineEnd + 1 < end && lineEnd[1] == '\n' )
+		return lineEnd + 2;
+	return lineEnd + 1;
+}
+
+//! Parses an optionally signed decimal integer at \a p and advances past it. Returns false if \a p doesn't start with a number.
+bool parseInt( const char *&p, const char *end, int32_t *result )
+{
+	const char *s = p;
+	bool negative = false;
+	if( s < end && ( *s == '-' || *s == '+' ) ) {
+		negative = ( *s == '-' );
+		++s;
+	}
+	if( s == end || ! isDigit( *s ) )
+		return false;
+
+	int64_t value = 0;
+	for( ; s < end && isDigit( *s ); ++s ) {
+		if( value <= numeric_limits<int32_t>::max() )
+			value = value * 10 + ( *s - '0' );
+	}
+
+	value = std::min<int64_t>( value, numeric_limits<int32_t>::max() );
+	*result = static_cast<int32_t>( negative ? -value : value );
+	p = s;
+	return true;
+}
+
+//! Returns true if \a d lies exactly halfway between two adjacent normal floats, where rounding it to float could differ from rounding the decimal it came from.
+inline bool isFloatMidpoint( double d )
+{
+	uint64_t bits;
+	memcpy( &bits, &d, sizeof( bits ) );
+	return ( bits & 0x1FFFFFFF ) == 0x10000000;
+}
+
+//! Skips whitespace and parses a floating point number at \a p, advancing past it. The result is correctly rounded like strtof(),
+//! which is used directly for the rare input that can't be converted exactly from a 64-bit mantissa and a small power of ten.
+//! Returns false if there is no number at \a p.
+bool parseFloat( const char *&p, const char *end, float *result )
+{
+	static const double sPowersOf10[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+
+	const char *start = skipSpace( p, end );
+	const char *s = start;
+	bool negative = false;
+	if( s < end && ( *s == '-' || *s == '+' ) ) {
+		negative = ( *s == '-' );
+		++s;
+	}
+
+	uint64_t mantissa = 0;
+	int numSignificantDigits = 0, exponent = 0;
+	bool hasDigits = false, exact = true;
+	for( ; s < end && isDigit( *s ); ++s ) {
+		hasDigits = true;
+		if( mantissa == 0 && *s == '0' )
+			continue;
+		if( numSignificantDigits++ < 19 )
+			mantissa = mantissa * 10 + ( *s - '0' );
+		else
+			exact = false;
+	}
+	if( s < end && *s == '.' ) {
+		for( ++s; s < end && isDigit( *s ); ++s ) {
+			hasDigits = true;
+			if( mantissa == 0 && *s == '0' ) {
+				--exponent;
+				continue;
+			}
+			if( numSignificantDigits++ < 19 ) {
+				mantissa = mantissa * 10 + ( *s - '0' );
+				--exponent;
+			}
+			else
+				exact = false;
+		}
+	}
+	if( ! hasDigits )
+		return false;
+
+	if( s < end && ( *s == 'e' || *s == 'E' ) ) {
+		const char *e = s + 1;
+		bool negativeExponent = false;
+		if( e < end && ( *e == '-' || *e == '+' ) ) {
+			negativeExponent = ( *e == '-' );
+			++e;
+		}
+		if( e < end && isDigit( *e ) ) {
+			int exponentValue = 0;
+			for( ; e < end && isDigit( *e ); ++e ) {
+				if( exponentValue < 10000 )
+					exponentValue = exponentValue * 10 + ( *e - '0' );
+			}
+			exponent += negativeExponent ? -exponentValue : exponentValue;
+			s = e;
+		}
+	}
+
+	float value;
+	bool converted = false;
+	if( mantissa == 0 ) {
+		value = 0;
+		converted = true;
+	}
+	else if( exact && mantissa < ( 1ULL << 53 ) && exponent >= -22 && exponent <= 22 ) {
+		// both operands are exact doubles, so d is the correctly rounded double of the decimal value
+		double d = ( exponent < 0 ) ? double( mantissa ) / sPowersOf10[-exponent] : double( mantissa ) * sPowersOf10[exponent];
+		if( d >= FLT_MIN && d <= FLT_MAX && ! isFloatMidpoint( d ) ) {
+			value = static_cast<float>( d );
+			converted = true;
+		}
+	}
+
+	if( ! converted ) {
+		string token( negative ? start + 1 : start, s );
+		value = strtof( token.c_str(), nullptr );
+	}
+
+	*result = negative ? -value : value;
+	p = s;
+	return true;
+}
+
+//! Parses up to \a count floats into \a result, stopping at the first one that fails like extracting from a std::istream would.
+inline void parseFloats( const char *p, const char *end, float *result, int count )
+{
+	for( int i = 0; i < count; i++ ) {
+		if( ! parseFloat( p, end, &result[i] ) )
+			break;
+	}
+}
+
+} // anonymous namespace
+
+//! Intermediate result of parsing a contiguous range of lines. Faces keep their indices as written and are resolved into Groups by mergeParsedData().
+struct ObjLoader::ParsedData {
+	enum FaceVertexFlags : uint8_t { HAS_SLASH = 1, HAS_TEX_COORD = 2, HAS_NORMAL = 4 };
+
+	struct FaceVertex {
+		int32_t		mVertex, mTexCoord, mNormal;
+		uint8_t		mFlags;
+	};
+
+	//! A 'g' or 'usemtl' statement, along with the number of faces and attributes that preceded it in the same range.
+	struct Statement {
+		enum Type { GROUP, MATERIAL };
+
+		Type		mType;
+		size_t		mNumFaces, mNumVertices, mNumTexCoords, mNumNormals;
+		string		mName;
+	};
+
+	ParsedData( bool includeNormals, bool includeTexCoords )
+		: mIncludeNormals( includeNormals ), mIncludeTexCoords( includeTexCoords )
+	{}
+
+	//! Parses all lines in [\a begin, \a end), which must not split a line continuation.
+	void	parseLines( const char *begin, const char *end );
+	//! Parses a single line, excluding its line ending.
+	void	parseLine( const char *begin, const char *end );
+	void	parseFace( const char *p, const char *end );
+	void	addStatement( Statement::Type type, const char *nameBegin, const char *nameEnd );
+
+	bool				mIncludeNormals, mIncludeTexCoords;
+	vector<vec3>		mVertices, mNormals;
+	vector<vec2>		mTexCoords;
+	vector<FaceVertex>	mFaceVertices;
+	vector<uint32_t>	mFaceSizes;
+	vector<Statement>	mStatements;
+};
+
+void ObjLoader::ParsedData::parseLines( const char *begin, const char *end )
+{
+	string joinedLine;
+	const char *p = begin;
+	while( p < end ) {
+		const char *lineEnd = p;
+		while( lineEnd < end && *lineEnd != '\n' && *lineEnd != '\r' )
+			++lineEnd;
+		const char *next = nextLine( lineEnd, end );
+
+		if( lineEnd == p || *p == '#' ) {
+			p = next;
+			continue;
+		}
+
+		if( lineEnd[-1] == '\\' && next < end ) {
+			// continuations are rare, so it's fine to join them into a temporary
+			joinedLine.assign( p, lineEnd );
+			while( ! joinedLine.empty() && joinedLine.back() == '\\' && next < end ) {
+				const char *continuation = next;
+				lineEnd = continuation;
+				while( lineEnd < end && *lineEnd != '\n' && *lineEnd != '\r' )
+					++lineEnd;
+				next = nextLine( lineEnd, end );
+
+				joinedLine.pop_back();
+				joinedLine.append( continuation, lineEnd );
+			}
+			parseLine( joinedLine.data(), joinedLine.data() + joinedLine.size() );
+		}
+		else
+			parseLine( p, lineEnd );
+
+		p = next;
+	}
+}
+
+void ObjLoader::ParsedData::parseLine( const char *begin, const char *end )
+{
+	const char *tag = skipSpace( begin, end );
+	const char *p = skipToken( tag, end );
+	const size_t tagLength = p - tag;
+
+	if( tagLength == 1 && tag[0] == 'v' ) { // vertex
+		vec3 v;
+		parseFloats( p, end, &v.x, 3 );
+		mVertices.push_back( v );
+	}
+	else if( tagLength == 2 && tag[0] == 'v' && tag[1] == 't' ) { // vertex texture coordinates
+		if( mIncludeTexCoords ) {
+			vec2 tex;
+			parseFloats( p, end, &tex.x, 2 );
+			mTexCoords.push_back( tex );
+		}
+	}
+	else if( tagLength == 2 && tag[0] == 'v' && tag[1] == 'n' ) { // vertex normals
+		if( mIncludeNormals ) {
+			vec3 v;
+			parseFloats( p, end, &v.x, 3 );
+			mNormals.push_back( normalize( v ) );
+		}
+	}
+	else if( tagLength == 1 && tag[0] == 'f' ) { // face
+		parseFace( p, end );
+	}
+	else if( tagLength == 1 && tag[0] == 'g' ) { // group, named by everything after the first space
+		const char *space = find( begin, end, ' ' );
+		addStatement( Statement::GROUP, ( space == end ) ? begin : space + 1, end );
+	}
+	else if( tagLength == 6 && memcmp( tag, "usemtl", 6 ) == 0 ) { // material
+		const char *name = skipSpace( p, end );
+		addStatement( Statement::MATERIAL, name, skipToken( name, end ) );
+	}
+}
+
+void ObjLoader::ParsedData::parseFace( const char *p, const char *end )
+{
+	// each vertex is "v", "v/vt", "v//vn" or "v/vt/vn"
+	uint32_t numVertices = 0;
+	while( ( p = skipSpace( p, end ) ) < end ) {
+		FaceVertex vertex = { 0, 0, 0, 0 };
+		if( parseInt( p, end, &vertex.mVertex ) ) {
+			if( p < end && *p == '/' ) {
+				vertex.mFlags |= HAS_SLASH;
+				if( parseInt( ++p, end, &vertex.mTexCoord ) )
+					vertex.mFlags |= HAS_TEX_COORD;
+				if( p < end && *p == '/' && parseInt( ++p, end, &vertex.mNormal ) )
+					vertex.mFlags |= HAS_NORMAL;
+			}
+
+			mFaceVertices.push_back( vertex );
+			numVertices++;
+		}
+
+		p = skipToken( p, end );
+	}
+
+	// faces with less than three vertices are kept, they produce no triangles but still count towards the group's attributes
+	mFaceSizes.push_back( numVertices );
+}
+
+void ObjLoader::ParsedData::addStatement( Statement::Type type, const char *nameBegin, const char *nameEnd )
+{
+	Statement statement;
+	statement.mType = type;
+	statement.mNumFaces = mFaceSizes.size();
+	statement.mNumVertices = mVertices.size();
+	statement.mNumTexCoords = mTexCoords.size();
+	statement.mNumNormals = mNormals.size();
+	statement.mName.assign( nameBegin, nameEnd );
+
+	mStatements.push_back( move( statement ) );
+}
+
+//! Open addressing hash table that maps a vertex's position, tex coord and normal indices to its index in the output.
+class ObjLoader::VertexIndexMap {
+  public:
+	VertexIndexMap()
+		: mSize( 0 )
+	{}
+
+	//! Returns the output index of the vertex ( \a a, \a b, \a c ), mapping it to \a index if it isn't present yet. The second member of the result is true if the vertex was inserted.
+	pair<uint32_t, bool> insert( int32_t a, int32_t b, int32_t c, uint32_t index )
+	{
+		if( ( mSize + 1 ) * 2 > mSlots.size() )
+			grow();
+
+		const size_t mask = mSlots.size() - 1;
+		for( size_t i = hash( a, b, c ) & mask; ; i = ( i + 1 ) & mask ) {
+			Slot &slot = mSlots[i];
+			if( slot.mIndex == EMPTY ) {
+				slot.mKey[0] = a;
+				slot.mKey[1] = b;
+				slot.mKey[2] = c;
+				slot.mIndex = index;
+				mSize++;
+				return make_pair( index, true );
+			}
+			if( slot.mKey[0] == a && slot.mKey[1] == b && slot.mKey[2] == c )
+				return make_pair( slot.mIndex, false );
+		}
+	}
+
+  private:
+	static const uint32_t EMPTY = 0xFFFFFFFF;
+
+	struct Slot {
+		int32_t		mKey[3];
+		uint32_t	mIndex;
+	};
+
+	static size_t hash( int32_t a, int32_t b, int32_t c )
+	{
+		uint64_t h = uint32_t( a ) * 0x9E3779B97F4A7C15ULL;
+		h = ( h ^ uint32_t( b ) ) * 0xC2B2AE3D27D4EB4FULL;
+		h = ( h ^ uint32_t( c ) ) * 0x165667B19E3779F9ULL;
+		return size_t( h ^ ( h >> 32 ) );
+	}
+
+	void grow()
+	{
+		vector<Slot> slots( std::max<size_t>( 64, mSlots.size() * 2 ) );
+		for( auto &slot : slots )
+			slot.mIndex = EMPTY;
+		mSlots.swap( slots );
+
+		const size_t mask = mSlots.size() - 1;
+		for( const auto &slot : slots ) {
+			if( slot.mIndex == EMPTY )
+				continue;
+
+			size_t i = hash( slot.mKey[0], slot.mKey[1], slot.mKey[2] ) & mask;
+			while( mSlots[i].mIndex != EMPTY )
+				i = ( i + 1 ) & mask;
+			mSlots[i] = slot;
+		}
+	}
+
+	vector<Slot>	mSlots;
+	size_t			mSize;
+};
+
 ObjLoader::ObjLoader( shared_ptr<IStreamCinder> stream, bool includeNormals, bool includeTexCoords, bool optimize )
 	: mStream( stream ), mOutputCached( false ), mOptimizeVertices( optimize ), mGroupIndex( numeric_limits<size_t>::max() )
 {
-	parse( includeNormals, includeTexCoords );
+	// memory streams can be parsed in place
+	auto memStream = dynamic_pointer_cast<IStreamMem>( stream );
+	if( memStream ) {
+		const size_t offset = static_cast<size_t>( memStream->tell() );
+		parse( static_cast<const char*>( memStream->getData() ) + offset, static_cast<size_t>( memStream->size() ) - offset, includeNormals, includeTexCoords );
+		memStream->seekAbsolute( memStream->size() );
+	}
+	else
+		parse( includeNormals, includeTexCoords );
 }
 
 ObjLoader::ObjLoader( DataSourceRef dataSource, bool includeNormals, bool includeTexCoords, bool optimize )
-	: mStream( dataSource->createStream() ), mOutputCached( false ), mOptimizeVertices( optimize ), mGroupIndex( numeric_limits<size_t>::max() )
+	: mOutputCached( false ), mOptimizeVertices( optimize ), mGroupIndex( numeric_limits<size_t>::max() )
 {
-	parse( includeNormals, includeTexCoords );
+	parse( dataSource, includeNormals, includeTexCoords );
 }
 
 ObjLoader::ObjLoader( DataSourceRef dataSource, DataSourceRef materialSource, bool includeNormals, bool includeTexCoords, bool optimize )
-	: mStream( dataSource->createStream() ), mOutputCached( false ), mOptimizeVertices( optimize ), mGroupIndex( numeric_limits<size_t>::max() )
+	: mOutputCached( false ), mOptimizeVertices( optimize ), mGroupIndex( numeric_limits<size_t>::max() )
 {
 	parseMaterial( materialSource->createStream() );
-	parse( includeNormals, includeTexCoords );
+	parse( dataSource, includeNormals, includeTexCoords );
 }
 
 ObjLoader& ObjLoader::groupIndex( size_t groupIndex )
@@ -149,14 +549,14 @@ void ObjLoader::parseMaterial( std::shared_ptr<IStreamCinder> material )
     m.Ka[0] = m.Ka[1] = m.Ka[2] = 1.0f;
     m.Kd[0] = m.Kd[1] = m.Kd[2] = 1.0f;
 
-    while( ! material->isEof() ) {
-        string line = material->readLine();
+    string line, next;
+    while( material->readLine( line ) ) {
         if( line.empty() || line[0] == '#' )
             continue;
 
-		while( line.back() == '\\' && ! material->isEof() ) {
-			auto next = material->readLine();
-			line = line.substr( 0, line.size() - 1 ) + next;
+		while( ! line.empty() && line.back() == '\\' && material->readLine( next ) ) {
+			line.pop_back();
+			line += next;
 		}
 
         string tag;
@@ -183,139 +583,189 @@ void ObjLoader::parseMaterial( std::shared_ptr<IStreamCinder> material )
 
 void ObjLoader::parse( bool includeNormals, bool includeTexCoords )
 {
-	Group *currentGroup;
-	mGroups.push_back( Group() );
-	currentGroup = &mGroups[mGroups.size()-1];
-	currentGroup->mBaseVertexOffset = currentGroup->mBaseTexCoordOffset = currentGroup->mBaseNormalOffset = 0;
-
-    const Material *currentMaterial = 0;
+	vector<ParsedData> chunks( 1, ParsedData( includeNormals, includeTexCoords ) );
+	ParsedData &data = chunks.front();
 
-	size_t lineNumber = 0;
-	while( ! mStream->isEof() ) {
-		lineNumber++;
-		string line = mStream->readLine(), tag;
-        if( line.empty() || line[0] == '#' )
-            continue;
+	string line, next;
+	while( mStream->readLine( line ) ) {
+		if( line.empty() || line[0] == '#' )
+			continue;
 
-		while( line.back() == '\\' && ! mStream->isEof() ) {
-			auto next = mStream->readLine();
-			line = line.substr( 0, line.size() - 1 ) + next;
+		while( ! line.empty() && line.back() == '\\' && mStream->readLine( next ) ) {
+			line.pop_back();
+			line += next;
 		}
 
-		stringstream ss( line );
-		ss >> tag;
-		if( tag == "v" ) { // vertex
-			vec3 v;
-			ss >> v.x >> v.y >> v.z;
-			mInternalVertices.push_back( v );
-		}
-		else if( tag == "vt" ) { // vertex texture coordinates
-			if( includeTexCoords ) {
-				vec2 tex;
-				ss >> tex.x >> tex.y;
-				mInternalTexCoords.push_back( tex );
-			}
+		data.parseLine( line.data(), line.data() + line.size() );
+	}
+
+	mergeParsedData( chunks );
+}
+
+void ObjLoader::parse( const DataSourceRef &dataSource, bool includeNormals, bool includeTexCoords )
+{
+	DataSourceMappedRef mapped = dynamic_pointer_cast<DataSourceMapped>( dataSource );
+	if( ! mapped && dataSource->isFilePath() ) {
+		try {
+			mapped = DataSourceMapped::create( dataSource->getFilePath() );
+		}
+		catch( const StreamExc & ) {
+			// fall back to the DataSource's own buffer, e.g. for Android assets
 		}
-		else if( tag == "vn" ) { // vertex normals
-			if ( includeNormals ) {
-				vec3 v;
-				ss >> v.x >> v.y >> v.z;
-				mInternalNormals.push_back( normalize( v ) );
+	}
+
+	if( mapped ) {
+		parse( static_cast<const char*>( mapped->getData() ), mapped->getSize(), includeNormals, includeTexCoords );
+		return;
+	}
+
+	BufferRef buffer = dataSource->getBuffer();
+	parse( static_cast<const char*>( buffer->getData() ), buffer->getSize(), includeNormals, includeTexCoords );
+}
+
+void ObjLoader::parse( const char *data, size_t dataSize, bool includeNormals, bool includeTexCoords )
+{
+	const char *end = data + dataSize;
+
+	size_t numChunks = dataSize / MIN_PARSE_CHUNK_SIZE;
+	if( numChunks > 1 )
+		numChunks = std::min( numChunks, ThreadPool::get()->getNumThreads() + 1 );
+	else
+		numChunks = 1;
+
+	// split at line boundaries, but never after a line that is continued on the next one
+	vector<const char*> boundaries( 1, data );
+	for( size_t i = 1; i < numChunks; i++ ) {
+		const char *p = std::max( boundaries.back(), data + dataSize * i / numChunks );
+		while( p < end ) {
+			p = static_cast<const char*>( memchr( p, '\n', end - p ) );
+			if( ! p ) {
+				p = end;
+				break;
 			}
+
+			const char *lastChar = p++ - 1;
+			if( lastChar >= data && *lastChar == '\r' )
+				--lastChar;
+			if( lastChar < data || *lastChar != '\\' )
+				break;
 		}
-		else if( tag == "f" ) { // face
-			parseFace( currentGroup, currentMaterial, line, includeNormals, includeTexCoords );
-		}
-		else if( tag == "g" ) { // group
-			if( ! currentGroup->mFaces.empty() )
-				mGroups.push_back( Group() );
-			currentGroup = &mGroups[mGroups.size()-1];
-			currentGroup->mBaseVertexOffset = (int32_t)mInternalVertices.size();
-			currentGroup->mBaseTexCoordOffset = (int32_t)mInternalTexCoords.size();
-			currentGroup->mBaseNormalOffset = (int32_t)mInternalNormals.size();
-			currentGroup->mName = line.substr( line.find( ' ' ) + 1 );
-		}
-        else if( tag == "usemtl") { // material
-            string tag;
-            ss >> tag;
-            std::map<std::string, Material>::const_iterator m = mMaterials.find(tag);
-            if( m != mMaterials.end() ) {
-                currentMaterial = &m->second;
-            }
-        }
+		boundaries.push_back( p );
 	}
+	boundaries.push_back( end );
+
+	vector<ParsedData> chunks( numChunks, ParsedData( includeNormals, includeTexCoords ) );
+	if( numChunks == 1 )
+		chunks.front().parseLines( data, end );
+	else {
+		ThreadPool::get()->parallelFor( 0, numChunks, 1, [&]( size_t begin, size_t end ) {
+			for( size_t i = begin; i < end; i++ )
+				chunks[i].parseLines( boundaries[i], boundaries[i + 1] );
+		} );
+	}
+
+	mergeParsedData( chunks );
 }
 
-void ObjLoader::parseFace( Group *group, const Material *material, const std::string &s, bool includeNormals, bool includeTexCoords )
+void ObjLoader::mergeParsedData( const vector<ParsedData> &chunks )
 {
-	ObjLoader::Face result;
-	result.mNumVertices = 0;
-    result.mMaterial = material;
+	size_t numVertices = 0, numTexCoords = 0, numNormals = 0;
+	for( const auto &chunk : chunks ) {
+		numVertices += chunk.mVertices.size();
+		numTexCoords += chunk.mTexCoords.size();
+		numNormals += chunk.mNormals.size();
+	}
 
-	size_t offset = 2; // account for "f "
-	size_t length = s.length();
-	while( offset < length ) {
-		size_t endOfTriple, firstSlashOffset, secondSlashOffset;
+	mInternalVertices.reserve( numVertices );
+	mInternalTexCoords.reserve( numTexCoords );
+	mInternalNormals.reserve( numNormals );
+	for( const auto &chunk : chunks ) {
+		mInternalVertices.insert( mInternalVertices.end(), chunk.mVertices.begin(), chunk.mVertices.end() );
+		mInternalTexCoords.insert( mInternalTexCoords.end(), chunk.mTexCoords.begin(), chunk.mTexCoords.end() );
+		mInternalNormals.insert( mInternalNormals.end(), chunk.mNormals.begin(), chunk.mNormals.end() );
+	}
 
-		while( s[offset] == ' ' )
-			++offset;
+	Group *currentGroup;
+	mGroups.push_back( Group() );
+	currentGroup = &mGroups[mGroups.size()-1];
+	currentGroup->mBaseVertexOffset = currentGroup->mBaseTexCoordOffset = currentGroup->mBaseNormalOffset = 0;
 
-		// find the end of this triple "v/vt/vn"
-		endOfTriple = s.find( ' ', offset );
-		if( endOfTriple == string::npos ) endOfTriple = length;
-		firstSlashOffset = s.find( '/', offset );
-		if( firstSlashOffset != string::npos ) {
-			secondSlashOffset = s.find( '/', firstSlashOffset + 1 );
-			if( secondSlashOffset > endOfTriple ) secondSlashOffset = string::npos;
-		}
-		else
-			secondSlashOffset = string::npos;
+	const Material *currentMaterial = 0;
+
+	// attribute counts of all preceding chunks
+	size_t vertexOffset = 0, texCoordOffset = 0, normalOffset = 0;
+	for( const auto &chunk : chunks ) {
+		const bool includeTexCoords = chunk.mIncludeTexCoords;
+		const bool includeNormals = chunk.mIncludeNormals;
+		const ParsedData::FaceVertex *faceVertex = chunk.mFaceVertices.data();
+		auto statementIt = chunk.mStatements.begin();
+
+		for( size_t f = 0; f <= chunk.mFaceSizes.size(); ++f ) {
+			for( ; statementIt != chunk.mStatements.end() && statementIt->mNumFaces == f; ++statementIt ) {
+				if( statementIt->mType == ParsedData::Statement::GROUP ) {
+					if( ! currentGroup->mFaces.empty() )
+						mGroups.push_back( Group() );
+					currentGroup = &mGroups[mGroups.size()-1];
+					currentGroup->mBaseVertexOffset = (int32_t)( vertexOffset + statementIt->mNumVertices );
+					currentGroup->mBaseTexCoordOffset = (int32_t)( texCoordOffset + statementIt->mNumTexCoords );
+					currentGroup->mBaseNormalOffset = (int32_t)( normalOffset + statementIt->mNumNormals );
+					currentGroup->mName = statementIt->mName;
+				}
+				else {
+					auto m = mMaterials.find( statementIt->mName );
+					if( m != mMaterials.end() )
+						currentMaterial = &m->second;
+				}
+			}
 
-		// process the vertex index
-		int vertexIndex = (firstSlashOffset != string::npos) ?
-            stoi( s.substr( offset, firstSlashOffset - offset ) ) :
-            stoi( s.substr( offset, endOfTriple - offset));
+			if( f == chunk.mFaceSizes.size() )
+				break;
 
-		if( vertexIndex < 0 )
-			result.mVertexIndices.push_back( group->mBaseVertexOffset + vertexIndex );
-		else
-			result.mVertexIndices.push_back( vertexIndex - 1 );
-
-		// process the tex coord index
-		if( includeTexCoords && ( firstSlashOffset != string::npos ) ) {
-			size_t numSize = ( secondSlashOffset == string::npos ) ? ( endOfTriple - firstSlashOffset - 1 ) : secondSlashOffset - firstSlashOffset - 1;
-			if( numSize > 0 ) {
-				int texCoordIndex = stoi( s.substr( firstSlashOffset + 1, numSize ) );
-				if( texCoordIndex < 0 )
-					result.mTexCoordIndices.push_back( group->mBaseTexCoordOffset + texCoordIndex );
+			Face face;
+			face.mNumVertices = (int)chunk.mFaceSizes[f];
+			face.mMaterial = currentMaterial;
+			face.mVertexIndices.reserve( face.mNumVertices );
+
+			for( int v = 0; v < face.mNumVertices; ++v, ++faceVertex ) {
+				// negative indices are relative to the start of the group
+				if( faceVertex->mVertex < 0 )
+					face.mVertexIndices.push_back( currentGroup->mBaseVertexOffset + faceVertex->mVertex );
 				else
-					result.mTexCoordIndices.push_back( texCoordIndex - 1 );
-				if( group->mFaces.empty() )
-					group->mHasTexCoords = true;
+					face.mVertexIndices.push_back( faceVertex->mVertex - 1 );
+
+				if( includeTexCoords && ( faceVertex->mFlags & ParsedData::HAS_SLASH ) ) {
+					if( faceVertex->mFlags & ParsedData::HAS_TEX_COORD ) {
+						if( faceVertex->mTexCoord < 0 )
+							face.mTexCoordIndices.push_back( currentGroup->mBaseTexCoordOffset + faceVertex->mTexCoord );
+						else
+							face.mTexCoordIndices.push_back( faceVertex->mTexCoord - 1 );
+						if( currentGroup->mFaces.empty() )
+							currentGroup->mHasTexCoords = true;
+					}
+					else
+						currentGroup->mHasTexCoords = false;
+				}
+				else if( currentGroup->mFaces.empty() ) // if this is the first face, let's note that this group has no tex coords
+					currentGroup->mHasTexCoords = false;
+
+				if( includeNormals && ( faceVertex->mFlags & ParsedData::HAS_NORMAL ) ) {
+					if( faceVertex->mNormal < 0 )
+						face.mNormalIndices.push_back( currentGroup->mBaseNormalOffset + faceVertex->mNormal );
+					else
+						face.mNormalIndices.push_back( faceVertex->mNormal - 1 );
+					currentGroup->mHasNormals = true;
+				}
+				else if( currentGroup->mFaces.empty() ) // if this is the first face, let's note that this group has no normals
+					currentGroup->mHasNormals = false;
 			}
-			else
-				group->mHasTexCoords = false;
-		}
-		else if( group->mFaces.empty() ) // if this is the first face, let's note that this group has no tex coords
-			group->mHasTexCoords = false;
 
-		// process the normal index
-		if( includeNormals && ( secondSlashOffset != string::npos ) ) {
-			int normalIndex = stoi( s.substr( secondSlashOffset + 1, endOfTriple - secondSlashOffset - 1 ) );
-			if( normalIndex < 0 )
-				result.mNormalIndices.push_back( group->mBaseNormalOffset + normalIndex );
-			else
-				result.mNormalIndices.push_back( normalIndex - 1 );
-			group->mHasNormals = true;
+			currentGroup->mFaces.push_back( move( face ) );
 		}
-		else if( group->mFaces.empty() ) // if this is the first face, let's note that this group has no normals
-			group->mHasNormals = false;
 
-		offset = endOfTriple + 1;
-		result.mNumVertices++;
+		vertexOffset += chunk.mVertices.size();
+		texCoordOffset += chunk.mTexCoords.size();
+		normalOffset += chunk.mNormals.size();
 	}
-
-	group->mFaces.push_back( result );
 }
 
 void ObjLoader::load() const
@@ -361,44 +811,44 @@ void ObjLoader::load() const
 
 	if( normals && texCoords ) {
 		if( hasGroupIndex ) {
-			map<VertexTriple,int> uniqueVerts;
+			VertexIndexMap uniqueVerts;
 			loadGroupNormalsTextures( mGroups[mGroupIndex], uniqueVerts );
 		}
 		else {
-			map<VertexTriple,int> uniqueVerts;
+			VertexIndexMap uniqueVerts;
 			for( vector<Group>::const_iterator groupIt = mGroups.begin(); groupIt != mGroups.end(); ++groupIt )
 				loadGroupNormalsTextures( *groupIt, uniqueVerts );
 		}
 	}
 	else if( normals ) {
 		if( hasGroupIndex ) {
-			map<VertexPair,int> uniqueVerts;
+			VertexIndexMap uniqueVerts;
 			loadGroupNormals( mGroups[mGroupIndex], uniqueVerts );
 		}
 		else {
-			map<VertexPair,int> uniqueVerts;
+			VertexIndexMap uniqueVerts;
 			for( vector<Group>::const_iterator groupIt = mGroups.begin(); groupIt != mGroups.end(); ++groupIt )
 				loadGroupNormals( *groupIt, uniqueVerts );
 		}
 	}
 	else if( texCoords ) {
 		if( hasGroupIndex ) {
-			map<VertexPair,int> uniqueVerts;
+			VertexIndexMap uniqueVerts;
 			loadGroupTextures( mGroups[mGroupIndex], uniqueVerts );
 		}
 		else {
-			map<VertexPair,int> uniqueVerts;
+			VertexIndexMap uniqueVerts;
 			for( vector<Group>::const_iterator groupIt = mGroups.begin(); groupIt != mGroups.end(); ++groupIt )
 				loadGroupTextures( *groupIt, uniqueVerts );
 		}
 	}
 	else {
 		if( hasGroupIndex ) {
-			map<int,int> uniqueVerts;
+			VertexIndexMap uniqueVerts;
 			loadGroup( mGroups[mGroupIndex], uniqueVerts );
 		}
 		else {
-			map<int,int> uniqueVerts;
+			VertexIndexMap uniqueVerts;
 			for( vector<Group>::const_iterator groupIt = mGroups.begin(); groupIt != mGroups.end(); ++groupIt )
 				loadGroup( *groupIt, uniqueVerts );
 		}
@@ -407,7 +857,7 @@ void ObjLoader::load() const
 	mOutputCached = true;
 }
 
-void ObjLoader::loadGroupNormalsTextures( const Group &group, map<VertexTriple,int> &uniqueVerts ) const
+void ObjLoader::loadGroupNormalsTextures( const Group &group, VertexIndexMap &uniqueVerts ) const
 {
     bool hasColors = mMaterials.size() > 0;
 	for( size_t f = 0; f < group.mFaces.size(); ++f ) {
@@ -428,9 +878,12 @@ void ObjLoader::loadGroupNormalsTextures( const Group &group, map<VertexTriple,i
 			}
 		}
 		if( group.mFaces[f].mNormalIndices.empty() ) { // we'll have to derive it from two edges
-			vec3 edge1 = mInternalVertices[group.mFaces[f].mVertexIndices[1]] - mInternalVertices[group.mFaces[f].mVertexIndices[0]];
-			vec3 edge2 = mInternalVertices[group.mFaces[f].mVertexIndices[2]] - mInternalVertices[group.mFaces[f].mVertexIndices[0]];
-			inferredNormal = normalize( cross( edge1, edge2 ) );
+			// points and lines don't have two edges, but they don't produce any triangles either
+			if( group.mFaces[f].mNumVertices >= 3 ) {
+				vec3 edge1 = mInternalVertices[group.mFaces[f].mVertexIndices[1]] - mInternalVertices[group.mFaces[f].mVertexIndices[0]];
+				vec3 edge2 = mInternalVertices[group.mFaces[f].mVertexIndices[2]] - mInternalVertices[group.mFaces[f].mVertexIndices[0]];
+				inferredNormal = normalize( cross( edge1, edge2 ) );
+			}
 			forceUnique = true;
 		}
 
@@ -441,8 +894,7 @@ void ObjLoader::loadGroupNormalsTextures( const Group &group, map<VertexTriple,i
 		faceIndices.reserve( group.mFaces[f].mNumVertices );
 		for( int v = 0; v < group.mFaces[f].mNumVertices; ++v ) {
 			if( ! forceUnique ) {
-				VertexTriple vTriple = make_tuple( group.mFaces[f].mVertexIndices[v], group.mFaces[f].mTexCoordIndices[v], group.mFaces[f].mNormalIndices[v] );
-				pair<map<VertexTriple,int>::iterator,bool> result = uniqueVerts.insert( make_pair( vTriple, mOutputVertices.size() ) );
+				pair<uint32_t,bool> result = uniqueVerts.insert( group.mFaces[f].mVertexIndices[v], group.mFaces[f].mTexCoordIndices[v], group.mFaces[f].mNormalIndices[v], (uint32_t)mOutputVertices.size() );
 				if( result.second ) { // we've got a new, unique vertex here, so let's append it
 					mOutputVertices.push_back( mInternalVertices[group.mFaces[f].mVertexIndices[v]] );
 					mOutputNormals.push_back( mInternalNormals[group.mFaces[f].mNormalIndices[v]] );
@@ -451,7 +903,7 @@ void ObjLoader::loadGroupNormalsTextures( const Group &group, map<VertexTriple,i
 						mOutputColors.push_back( rgb );
 				}
 				// the unique ID of the vertex is appended for this vert
-				faceIndices.push_back( result.first->second );
+				faceIndices.push_back( result.first );
 			}
 			else { // have to force unique because this group lacks either normals or texCoords
 				faceIndices.push_back( (int32_t)mOutputVertices.size() );
@@ -477,7 +929,7 @@ void ObjLoader::loadGroupNormalsTextures( const Group &group, map<VertexTriple,i
 	}
 }
 
-void ObjLoader::loadGroupNormals( const Group &group, map<VertexPair,int> &uniqueVerts ) const
+void ObjLoader::loadGroupNormals( const Group &group, VertexIndexMap &uniqueVerts ) const
 {
     bool hasColors = mMaterials.size() > 0;
 	for( size_t f = 0; f < group.mFaces.size(); ++f ) {
@@ -498,9 +950,12 @@ void ObjLoader::loadGroupNormals( const Group &group, map<VertexPair,int> &uniqu
 		vec3 inferredNormal;
 		bool forceUnique = ! mOptimizeVertices;
 		if( group.mFaces[f].mNormalIndices.empty() ) { // we'll have to derive it from two edges
-			vec3 edge1 = mInternalVertices[group.mFaces[f].mVertexIndices[1]] - mInternalVertices[group.mFaces[f].mVertexIndices[0]];
-			vec3 edge2 = mInternalVertices[group.mFaces[f].mVertexIndices[2]] - mInternalVertices[group.mFaces[f].mVertexIndices[0]];
-			inferredNormal = normalize( cross( edge1, edge2 ) );
+			// points and lines don't have two edges, but they don't produce any triangles either
+			if( group.mFaces[f].mNumVertices >= 3 ) {
+				vec3 edge1 = mInternalVertices[group.mFaces[f].mVertexIndices[1]] - mInternalVertices[group.mFaces[f].mVertexIndices[0]];
+				vec3 edge2 = mInternalVertices[group.mFaces[f].mVertexIndices[2]] - mInternalVertices[group.mFaces[f].mVertexIndices[0]];
+				inferredNormal = normalize( cross( edge1, edge2 ) );
+			}
 			forceUnique = true;
 		}
 
@@ -508,8 +963,7 @@ void ObjLoader::loadGroupNormals( const Group &group, map<VertexPair,int> &uniqu
 		faceIndices.reserve( group.mFaces[f].mNumVertices );
 		for( int v = 0; v < group.mFaces[f].mNumVertices; ++v ) {
 			if( ! forceUnique ) {
-				VertexPair vPair = make_tuple( group.mFaces[f].mVertexIndices[v], group.mFaces[f].mNormalIndices[v] );
-				pair<map<VertexPair,int>::iterator,bool> result = uniqueVerts.insert( make_pair( vPair, mOutputVertices.size() ) );
+				pair<uint32_t,bool> result = uniqueVerts.insert( group.mFaces[f].mVertexIndices[v], 0, group.mFaces[f].mNormalIndices[v], (uint32_t)mOutputVertices.size() );
 				if( result.second ) { // we've got a new, unique vertex here, so let's append it
 					mOutputVertices.push_back( mInternalVertices[group.mFaces[f].mVertexIndices[v]] );
 					mOutputNormals.push_back( mInternalNormals[group.mFaces[f].mNormalIndices[v]] );
@@ -517,7 +971,7 @@ void ObjLoader::loadGroupNormals( const Group &group, map<VertexPair,int> &uniqu
                         mOutputColors.push_back( rgb );
 				}
 				// the unique ID of the vertex is appended for this vert
-				faceIndices.push_back( result.first->second );
+				faceIndices.push_back( result.first );
 			}
 			else { // have to force unique because this group lacks normals
 				faceIndices.push_back( (int32_t)mOutputVertices.size() );
@@ -539,7 +993,7 @@ void ObjLoader::loadGroupNormals( const Group &group, map<VertexPair,int> &uniqu
 	}
 }
 
-void ObjLoader::loadGroupTextures( const Group &group, map<VertexPair,int> &uniqueVerts ) const
+void ObjLoader::loadGroupTextures( const Group &group, VertexIndexMap &uniqueVerts ) const
 {
     bool hasColors = mMaterials.size() > 0;
 	for( size_t f = 0; f < group.mFaces.size(); ++f ) {
@@ -565,8 +1019,7 @@ void ObjLoader::loadGroupTextures( const Group &group, map<VertexPair,int> &uniq
 		faceIndices.reserve( group.mFaces[f].mNumVertices );
 		for( int v = 0; v < group.mFaces[f].mNumVertices; ++v ) {
 			if( ! forceUnique ) {
-				VertexPair vPair = make_tuple( group.mFaces[f].mVertexIndices[v], group.mFaces[f].mTexCoordIndices[v] );
-				pair<map<VertexPair,int>::iterator,bool> result = uniqueVerts.insert( make_pair( vPair, mOutputVertices.size() ) );
+				pair<uint32_t,bool> result = uniqueVerts.insert( group.mFaces[f].mVertexIndices[v], group.mFaces[f].mTexCoordIndices[v], 0, (uint32_t)mOutputVertices.size() );
 				if( result.second ) { // we've got a new, unique vertex here, so let's append it
 					mOutputVertices.push_back( mInternalVertices[group.mFaces[f].mVertexIndices[v]] );
 					mOutputTexCoords.push_back( mInternalTexCoords[group.mFaces[f].mTexCoordIndices[v]] );
@@ -574,7 +1027,7 @@ void ObjLoader::loadGroupTextures( const Group &group, map<VertexPair,int> &uniq
                         mOutputColors.push_back( rgb );
 				}
 				// the unique ID of the vertex is appended for this vert
-				faceIndices.push_back( result.first->second );
+				faceIndices.push_back( result.first );
 			}
 			else { // have to force unique because this group lacks texCoords
 				faceIndices.push_back( (int32_t)mOutputVertices.size() );
@@ -596,7 +1049,7 @@ void ObjLoader::loadGroupTextures( const Group &group, map<VertexPair,int> &uniq
 	}
 }
 
-void ObjLoader::loadGroup( const Group &group, map<int,int> &uniqueVerts ) const
+void ObjLoader::loadGroup( const Group &group, VertexIndexMap &uniqueVerts ) const
 {
     bool hasColors = mMaterials.size() > 0;
 	for( size_t f = 0; f < group.mFaces.size(); ++f ) {
@@ -617,14 +1070,14 @@ void ObjLoader::loadGroup( const Group &group, map<int,int> &uniqueVerts ) const
 		vector<int> faceIndices;
 		faceIndices.reserve( group.mFaces[f].mNumVertices );
 		for( int v = 0; v < group.mFaces[f].mNumVertices; ++v ) {
-			pair<map<int,int>::iterator,bool> result = uniqueVerts.insert( make_pair( group.mFaces[f].mVertexIndices[v], mOutputVertices.size() ) );
+			pair<uint32_t,bool> result = uniqueVerts.insert( group.mFaces[f].mVertexIndices[v], 0, 0, (uint32_t)mOutputVertices.size() );
 			if( result.second ) { // we've got a new, unique vertex here, so let's append it
 				mOutputVertices.push_back( mInternalVertices[group.mFaces[f].mVertexIndices[v]] );
                 if( hasColors )
                     mOutputColors.push_back( rgb );
 			}
 			// the unique ID of the vertex is appended for this vert
-			faceIndices.push_back( result.first->second );
+			faceIndices.push_back( result.first );
 		}
 
 		int32_t triangles = (int32_t)faceIndices.size() - 2;
@@ -27,6 +27,7 @@
 #include "cinder/Utilities.h"
 
 #include <stdio.h>
+#include <cstring>
 #include <limits>
 #include <iostream>
 using std::string;
@@ -63,13 +64,31 @@ void OStream::writeLittle( T t )
 //////////////////////////////////////////////////////////////////////////
 void IStreamCinder::read( std::string *s )
 {
-	std::vector<char> chars;
+	s->clear();
+	const uint8_t *data;
+	size_t size;
+	if( peekBuffered( &data, &size ) ) {
+		while( size > 0 ) {
+			const uint8_t *terminator = static_cast<const uint8_t*>( memchr( data, 0, size ) );
+			if( terminator ) {
+				s->append( reinterpret_cast<const char*>( data ), terminator - data );
+				skipBuffered( terminator - data + 1 );
+				return;
+			}
+			s->append( reinterpret_cast<const char*>( data ), size );
+			skipBuffered( size );
+			peekBuffered( &data, &size );
+		}
+		throw StreamExc(); // no terminator before the end of the stream, like IORead()
+	}
+
 	char c;
-	do {
+	while( true ) {
 		read( &c );
-		chars.push_back( c );
-	} while( c != 0 );
-	*s = string( &chars[0] );
+		if( c == 0 )
+			break;
+		s->push_back( c );
+	}
 }
 
 void IStreamCinder::read( fs::path *p )
@@ -122,22 +141,64 @@ void IStreamCinder::readFixedString( std::string *t, size_t size )
 std::string IStreamCinder::readLine()
 {
 	string result;
-	int8_t ch;
-	while( ! isEof() ) {
-		read( &ch );
-		if( ch == 0x0A )
-			break;
-		else if( ch == 0x0D ) {
+	readLine( result );
+	return result;
+}
+
+bool IStreamCinder::readLine( std::string &line )
+{
+	line.clear();
+
+	const uint8_t *data;
+	size_t size;
+	if( ! peekBuffered( &data, &size ) ) {
+		// streams without a read-ahead buffer are read a byte at a time
+		if( isEof() )
+			return false;
+		int8_t ch;
+		while( ! isEof() ) {
 			read( &ch );
-			if( ch != 0x0A )
-				seekRelative( -1 );
-			break;
+			if( ch == 0x0A )
+				break;
+			else if( ch == 0x0D ) {
+				if( ! isEof() ) {
+					read( &ch );
+					if( ch != 0x0A )
+						seekRelative( -1 );
+				}
+				break;
+			}
+			else
+				line += ch;
 		}
-		else
-			result += ch;
+		return true;
 	}
 
-	return result;
+	if( size == 0 )
+		return false;
+
+	// scan the buffered bytes for the line ending, appending whole runs and refilling as needed
+	while( size > 0 ) {
+		const uint8_t *lineEnd = data;
+		const uint8_t *end = data + size;
+		while( lineEnd < end && *lineEnd != 0x0A && *lineEnd != 0x0D )
+			++lineEnd;
+
+		line.append( reinterpret_cast<const char*>( data ), lineEnd - data );
+		if( lineEnd == end ) {
+			skipBuffered( size );
+			peekBuffered( &data, &size );
+			continue;
+		}
+
+		const bool carriageReturn = ( *lineEnd == 0x0D );
+		skipBuffered( lineEnd - data + 1 );
+		if( carriageReturn && peekBuffered( &data, &size ) && size > 0 && *data == 0x0A )
+			skipBuffered( 1 );
+		break;
+	}
+
+	return true;
 }
 
 void IStreamCinder::readData( void *t, size_t size )
@@ -229,6 +290,24 @@ void IStreamFile::seekRelative( off_t relativeOffset )
 	mBufferOffset = ftell( mFile );
 }
 
+bool IStreamFile::peekBuffered( const uint8_t **data, size_t *size )
+{
+	if( ( mBufferOffset < mBufferFileOffset ) || ( mBufferOffset >= mBufferFileOffset + (off_t)mBufferSize ) ) {
+		fseek( mFile, static_cast<long>( mBufferOffset ), SEEK_SET );
+		mBufferFileOffset = mBufferOffset;
+		mBufferSize = fread( mBuffer.get(), 1, mDefaultBufferSize, mFile );
+	}
+
+	*data = mBuffer.get() + ( mBufferOffset - mBufferFileOffset );
+	*size = static_cast<size_t>( mBufferFileOffset + (off_t)mBufferSize - mBufferOffset );
+	return true;
+}
+
+void IStreamFile::skipBuffered( size_t size )
+{
+	mBufferOffset += size;
+}
+
 off_t IStreamFile::tell() const
 {
 	return mBufferOffset;
@@ -612,6 +691,51 @@ void IStreamMem::IORead( void *t, size_t size )
 	mOffset += size;
 }
 
+bool IStreamMem::peekBuffered( const uint8_t **data, size_t *size )
+{
+	*data = mData + mOffset;
+	*size = ( mOffset < mDataSize ) ? mDataSize - mOffset : 0;
+	return true;
+}
+
+void IStreamMem::skipBuffered( size_t size )
+{
+	mOffset += size;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// LineIterator
+LineIterator::LineIterator( const void *data, size_t size )
+	: mDataEnd( static_cast<const char*>( data ) + size )
+{
+	setLine( static_cast<const char*>( data ) );
+}
+
+LineIterator& LineIterator::operator++()
+{
+	setLine( mNext );
+	return *this;
+}
+
+void LineIterator::setLine( const char *begin )
+{
+	mLine.mBegin = mLine.mEnd = mNext = begin;
+	if( begin == mDataEnd )
+		return;
+
+	const char *lineEnd = begin;
+	while( lineEnd < mDataEnd && *lineEnd != '\n' && *lineEnd != '\r' )
+		++lineEnd;
+	mLine.mEnd = lineEnd;
+
+	if( lineEnd == mDataEnd )
+		mNext = mDataEnd;
+	else if( *lineEnd == '\r' && lineEnd + 1 < mDataEnd && lineEnd[1] == '\n' )
+		mNext = lineEnd + 2;
+	else
+		mNext = lineEnd + 1;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////
 // OStreamMem
 OStreamMem::OStreamMem( size_t bufferSizeHint )
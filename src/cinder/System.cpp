@@ -46,6 +46,7 @@
 	#include <windows.h>
 	#include <windowsx.h>
 	#include <iphlpapi.h>
+	#include <intrin.h>
 	#pragma comment(lib, "IPHLPAPI.lib")
 	namespace cinder {
 		void cpuidwrap( int *p, unsigned int param );
@@ -65,6 +66,11 @@
 	#include <cxxabi.h>
 #endif
 
+// Platforms without a system query for the x86 instruction sets (such as Linux) ask the CPU through the compiler
+#if ( defined( __clang__ ) || defined( __GNUC__ ) ) && ( defined( __i386__ ) || defined( __x86_64__ ) )
+	#define CINDER_SYSTEM_GCC_X86
+#endif
+
 #include <string>
 
 using namespace std;
@@ -261,6 +267,8 @@ bool System::hasSse2()
 		instance()->mHasSSE2 = ( instance()->mCPUID_EDX & 0x04000000 ) != 0;
 #elif defined( CINDER_UWP )
 		instance()->mHasSSE2 = IsProcessorFeaturePresent(PF_XMMI64_INSTRUCTIONS_AVAILABLE) != 0;
+#elif defined( CINDER_SYSTEM_GCC_X86 )
+		instance()->mHasSSE2 = __builtin_cpu_supports( "sse2" ) != 0;
 #else
 	throw Exception( "Not implemented" );
 #endif
@@ -281,6 +289,8 @@ bool System::hasSse3()
 		instance()->mHasSSE3 = ( instance()->mCPUID_ECX & 0x00000001 ) != 0;
 #elif defined( CINDER_UWP )
 		instance()->mHasSSE3 = IsProcessorFeaturePresent(PF_SSE3_INSTRUCTIONS_AVAILABLE) != 0;
+#elif defined( CINDER_SYSTEM_GCC_X86 )
+		instance()->mHasSSE3 = __builtin_cpu_supports( "sse3" ) != 0;
 #else
 		throw Exception( "Not implemented" );
 #endif
@@ -299,6 +309,8 @@ bool System::hasSse4_1()
 		instance()->mHasSSE4_1 = true; // TODO: this is not being tested
 #elif defined( CINDER_MSW_DESKTOP )
 		instance()->mHasSSE4_1 = ( instance()->mCPUID_ECX & ( 1 << 19 ) ) != 0;
+#elif defined( CINDER_SYSTEM_GCC_X86 )
+		instance()->mHasSSE4_1 = __builtin_cpu_supports( "sse4.1" ) != 0;
 #else
 		throw Exception( "Not implemented" );
 #endif
@@ -317,6 +329,8 @@ bool System::hasSse4_2()
 		instance()->mHasSSE4_2 = true; // TODO: this is not being tested
 #elif defined( CINDER_MSW_DESKTOP )
 		instance()->mHasSSE4_2 = ( instance()->mCPUID_ECX & ( 1 << 20 ) ) != 0;
+#elif defined( CINDER_SYSTEM_GCC_X86 )
+		instance()->mHasSSE4_2 = __builtin_cpu_supports( "sse4.2" ) != 0;
 #else
 		throw Exception( "Not implemented" );
 #endif		
@@ -326,6 +340,29 @@ bool System::hasSse4_2()
 	return instance()->mHasSSE4_2;
 }
 
+bool System::hasAvx2()
+{
+	if( ! instance()->mCachedValues[HAS_AVX2] ) {
+#if defined( CINDER_COCOA )
+		instance()->mHasAVX2 = ( getSysCtlValue<int>( "hw.optional.avx2_0" ) == 1 );
+#elif defined( CINDER_MSW_DESKTOP )
+		// besides the CPUID bit, the OS must save the ymm registers (OSXSAVE set and XCR0 enabling SSE and AVX state)
+		int info[4];
+		__cpuid( info, 1 );
+		bool osSavesYmm = ( info[2] & ( 1 << 27 ) ) != 0 && ( _xgetbv( 0 ) & 6 ) == 6;
+		__cpuidex( info, 7, 0 );
+		instance()->mHasAVX2 = osSavesYmm && ( info[1] & ( 1 << 5 ) ) != 0;
+#elif defined( CINDER_SYSTEM_GCC_X86 )
+		instance()->mHasAVX2 = __builtin_cpu_supports( "avx2" ) != 0;
+#else
+		instance()->mHasAVX2 = false;
+#endif
+		instance()->mCachedValues[HAS_AVX2] = true;
+	}
+
+	return instance()->mHasAVX2;
+}
+
 bool System::hasArm()
 {
 	if( ! instance()->mCachedValues[HAS_ARM] ) {
@@ -333,7 +370,7 @@ bool System::hasArm()
 		SYSTEM_INFO info;
 		::GetNativeSystemInfo(&info);
 		instance()->mHasArm = info.wProcessorArchitecture == PROCESSOR_ARCHITECTURE_ARM;
-#elif defined( CINDER_COCOA_TOUCH )
+#elif defined( CINDER_COCOA_TOUCH ) || defined( __arm__ ) || defined( __aarch64__ )
 		instance()->mHasArm = true;
 #else
 		instance()->mHasArm = false;
@@ -356,6 +393,10 @@ bool System::hasX86_64()
 		SYSTEM_INFO info;
 		::GetNativeSystemInfo(&info);
 		instance()->mHasX86_64 = info.wProcessorArchitecture == PROCESSOR_ARCHITECTURE_AMD64;
+#elif defined( CINDER_SYSTEM_GCC_X86 ) && defined( __x86_64__ )
+		instance()->mHasX86_64 = true;
+#elif defined( CINDER_SYSTEM_GCC_X86 )
+		instance()->mHasX86_64 = false;
 #else
 		throw Exception( "Not implemented" );
 #endif		
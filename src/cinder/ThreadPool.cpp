@@ -0,0 +1,157 @@
+/*
+ Copyright (c) 2016, The Cinder Project, All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cinder/ThreadPool.h"
+#include "cinder/Thread.h"
+
+#include <algorithm>
+#include <memory>
+
+using namespace std;
+
+namespace cinder {
+
+ThreadPool::ThreadPool( size_t numThreads )
+	: mShouldQuit( false )
+{
+	if( numThreads == 0 ) {
+		size_t hardwareThreads = thread::hardware_concurrency();
+		numThreads = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+	}
+
+	for( size_t i = 0; i < numThreads; i++ )
+		mThreads.emplace_back( &ThreadPool::threadEntry, this );
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard<mutex> lock( mMutex );
+		mShouldQuit = true;
+	}
+	mCondition.notify_all();
+
+	for( auto &t : mThreads )
+		t.join();
+}
+
+ThreadPool* ThreadPool::get()
+{
+	static ThreadPool sInstance;
+	return &sInstance;
+}
+
+void ThreadPool::submit( const function<void ()> &task )
+{
+	{
+		lock_guard<mutex> lock( mMutex );
+		mTasks.push_back( task );
+	}
+	mCondition.notify_one();
+}
+
+void ThreadPool::parallelFor( size_t begin, size_t end, size_t minGrain, const function<void ( size_t, size_t )> &fn )
+{
+	if( end <= begin )
+		return;
+
+	const size_t count = end - begin;
+	const size_t maxChunks = mThreads.size() + 1;
+	const size_t numChunks = std::max<size_t>( 1, std::min( maxChunks, count / std::max<size_t>( 1, minGrain ) ) );
+	if( numChunks == 1 ) {
+		fn( begin, end );
+		return;
+	}
+
+	// shared with the submitted tasks, which may only start once this call has returned
+	auto state = make_shared<ParallelForState>();
+	state->mBegin = begin;
+	state->mChunkSize = count / numChunks;
+	state->mRemainder = count % numChunks;
+	state->mNumChunks = numChunks;
+	state->mFn = &fn;
+
+	// each task runs whichever chunks are left when it starts, so no chunk waits on a task stuck behind others in the queue
+	for( size_t i = 1; i < numChunks; i++ )
+		submit( [state] { state->runChunks(); } );
+
+	// while waiting, the calling thread only runs chunks of this call rather than other queued tasks, which could take far longer
+	state->runChunks();
+	{
+		unique_lock<mutex> lock( state->mMutex );
+		state->mDoneCondition.wait( lock, [&] { return state->mNumDone == numChunks; } );
+	}
+
+	if( state->mException )
+		rethrow_exception( state->mException );
+}
+
+void ThreadPool::ParallelForState::runChunks()
+{
+	while( true ) {
+		const size_t i = mNextChunk++;
+		if( i >= mNumChunks )
+			return;
+
+		// once a chunk has thrown, the rest are skipped
+		if( ! mFailed ) {
+			const size_t chunkBegin = mBegin + i * mChunkSize + std::min( i, mRemainder );
+			const size_t chunkEnd = chunkBegin + mChunkSize + ( i < mRemainder ? 1 : 0 );
+			try {
+				( *mFn )( chunkBegin, chunkEnd );
+			}
+			catch( ... ) {
+				lock_guard<mutex> lock( mMutex );
+				if( ! mException )
+					mException = current_exception();
+				mFailed = true;
+			}
+		}
+
+		lock_guard<mutex> lock( mMutex );
+		if( ++mNumDone == mNumChunks )
+			mDoneCondition.notify_all();
+	}
+}
+
+void ThreadPool::threadEntry()
+{
+	ThreadSetup threadSetup;
+
+	while( true ) {
+		function<void ()> task;
+		{
+			unique_lock<mutex> lock( mMutex );
+			mCondition.wait( lock, [this] { return mShouldQuit || ! mTasks.empty(); } );
+			if( mShouldQuit && mTasks.empty() )
+				return;
+
+			task = move( mTasks.front() );
+			mTasks.pop_front();
+		}
+
+		task();
+	}
+}
+
+} // namespace cinder
@@ -37,17 +37,19 @@ typedef std::multimap<void*,TimelineItemRef>::iterator s_iter;
 typedef std::multimap<void*,TimelineItemRef>::const_iterator s_const_iter;
 
 Timeline::Timeline()
-	: TimelineItem( 0, 0, 0, 0 ), mDefaultAutoRemove( true ), mCurrentTime( 0 )
+	: TimelineItem( 0, 0, 0, 0 ), mDefaultAutoRemove( true ), mCurrentTime( 0 ), mNextBatchedTweenOrder( 0 )
 {
 	mUseAbsoluteTime = true;
 }
 
 Timeline::Timeline( const Timeline &rhs )
-	: TimelineItem( rhs ), mDefaultAutoRemove( rhs.mDefaultAutoRemove ), mCurrentTime( rhs.mCurrentTime )
+	: TimelineItem( rhs ), mDefaultAutoRemove( rhs.mDefaultAutoRemove ), mCurrentTime( rhs.mCurrentTime ), mNextBatchedTweenOrder( rhs.mNextBatchedTweenOrder )
 {
 	for( s_const_iter iter = rhs.mItems.begin(); iter != rhs.mItems.end(); ++iter ) {
 		mItems.insert( make_pair( iter->first, iter->second->clone() ) );
 	}
+	for( const auto &batch : rhs.mTweenBatches )
+		mTweenBatches.push_back( batch->clone() );
 }
 
 void Timeline::step( float timestep )
@@ -72,10 +74,37 @@ void Timeline::stepTo( float absoluteTime )
 		if( iter->second->isComplete() && iter->second->getAutoRemove() )
 			iter->second->mMarkedForRemoval = true;
 	}
+
+	if( ! mTweenBatches.empty() )
+		stepTweenBatches();
 	
 	eraseMarked();	
 }
 
+void Timeline::stepTweenBatches()
+{
+	// every batch finishes its running tweens before any batch starts new ones, so that appended tweens start from the final value of their predecessors
+	for( auto &batch : mTweenBatches )
+		batch->updateStarted( mCurrentTime );
+
+	// tweens start in order across batches, as consecutive tweens on a target can use different easing functions
+	while( true ) {
+		detail::TweenBatchBase *nextBatch = nullptr;
+		detail::TweenBatchPendingKey nextKey;
+		for( auto &batch : mTweenBatches ) {
+			detail::TweenBatchPendingKey key;
+			if( batch->peekPending( &key ) && key.mStartTime <= mCurrentTime && ( ! nextBatch || key < nextKey ) ) {
+				nextBatch = batch.get();
+				nextKey = key;
+			}
+		}
+
+		if( ! nextBatch )
+			break;
+		nextBatch->startPending( mCurrentTime );
+	}
+}
+
 CueRef Timeline::add( const std::function<void ()> &action, float atTime )
 {
 	CueRef newCue( new Cue( action, atTime ) );
@@ -87,6 +116,7 @@ CueRef Timeline::add( const std::function<void ()> &action, float atTime )
 void Timeline::clear()
 {
 	mItems.clear();	
+	mTweenBatches.clear();
 }
 
 void Timeline::appendPingPong()
@@ -153,6 +183,8 @@ float Timeline::calcDuration() const
 	for( s_const_iter iter = mItems.begin(); iter != mItems.end(); ++iter ) {
 		duration = std::max( iter->second->getEndTime(), duration );
 	}
+	for( const auto &batch : mTweenBatches )
+		duration = std::max( batch->calcEndTime(), duration );
 	
 	return duration;
 }
@@ -218,10 +250,25 @@ float Timeline::findEndTimeOf( void *target, bool *found ) const
 		}
 	}
 	
-	if( result != mItems.end() ) {
+	bool batchFound = false;
+	float batchEndTime = 0;
+	for( const auto &batch : mTweenBatches ) {
+		float endTime;
+		if( batch->findEndTimeOf( target, &endTime ) ) {
+			batchEndTime = batchFound ? std::max( batchEndTime, endTime ) : endTime;
+			batchFound = true;
+		}
+	}
+
+	if( result != mItems.end() || batchFound ) {
 		if( found )
 			*found = true;
-		return result->second->getEndTime();
+		if( result == mItems.end() )
+			return batchEndTime;
+		else if( batchFound )
+			return std::max( result->second->getEndTime(), batchEndTime );
+		else
+			return result->second->getEndTime();
 	}
 	else {
 		if( found )
@@ -230,6 +277,24 @@ float Timeline::findEndTimeOf( void *target, bool *found ) const
 	}
 }
 
+size_t Timeline::getNumBatchedTweens() const
+{
+	size_t result = 0;
+	for( const auto &batch : mTweenBatches )
+		result += batch->getNumTweens();
+	return result;
+}
+
+bool Timeline::hasBatchedTweens( void *target ) const
+{
+	float endTime;
+	for( const auto &batch : mTweenBatches ) {
+		if( batch->findEndTimeOf( target, &endTime ) )
+			return true;
+	}
+	return false;
+}
+
 void Timeline::remove( TimelineItemRef item )
 {
 	for( s_iter iter = mItems.begin(); iter != mItems.end(); ++iter ) {
@@ -248,6 +313,8 @@ void Timeline::removeTarget( void *target )
 	pair<s_iter,s_iter> range = mItems.equal_range( target );
 	for( s_iter iter = range.first; iter != range.second; ++iter )
 		iter->second->mMarkedForRemoval = true;
+	for( auto &batch : mTweenBatches )
+		batch->removeTarget( target );
 
 	setDurationDirty();
 }
@@ -268,6 +335,8 @@ void Timeline::cloneAndReplaceTarget( void *target, void *replacementTarget )
 
 	for( vector<TimelineItemRef>::iterator newItemIt = newItems.begin(); newItemIt != newItems.end(); ++newItemIt )
 		mItems.insert( make_pair( replacementTarget, *newItemIt ) );
+	for( auto &batch : mTweenBatches )
+		batch->cloneAndReplaceTarget( target, replacementTarget );
 
 	setDurationDirty();
 }
@@ -283,6 +352,8 @@ void Timeline::replaceTarget( void *target, void *replacementTarget )
 		mItems.insert( make_pair( replacementTarget, iter->second ) );
 		iter = mItems.erase( iter );
 	}
+	for( auto &batch : mTweenBatches )
+		batch->replaceTarget( target, replacementTarget );
 }
 
 void Timeline::reset( bool unsetStarted )
@@ -25,14 +25,127 @@
 
 #include "cinder/TriMesh.h"
 #include "cinder/Exception.h"
+#include "cinder/ThreadPool.h"
 #if defined( CINDER_ANDROID )
 	#include "cinder/android/CinderAndroid.h"
 #endif 
 
+#include <limits>
+
 using namespace std;
 
 namespace cinder {
 
+namespace detail {
+
+size_t calcNumTriangleChunks( size_t numTriangles )
+{
+	// triangles are only split into parallel chunks of at least this many
+	const size_t MIN_TRIANGLES_PER_CHUNK = 16384;
+
+	size_t result = numTriangles / MIN_TRIANGLES_PER_CHUNK;
+	if( result > 1 )
+		return std::min( result, ThreadPool::get()->getNumThreads() + 1 );
+	else
+		return 1;
+}
+
+} // namespace detail
+
+namespace {
+
+// A cell of the grid that findWeldTargets() hashes positions into.
+struct WeldCell {
+	bool operator==( const WeldCell &rhs ) const	{ return x == rhs.x && y == rhs.y && z == rhs.z; }
+
+	int64_t x, y, z;
+};
+
+inline size_t hashWeldCell( const WeldCell &cell )
+{
+	uint64_t h = uint64_t( cell.x ) * 0x9E3779B97F4A7C15ull ^ uint64_t( cell.y ) * 0xC2B2AE3D27D4EB4Full ^ uint64_t( cell.z ) * 0x165667B19E3779F9ull;
+	return size_t( h ^ ( h >> 32 ) );
+}
+
+/* Returns, for each position, the index of the first earlier position within epsilon of it that it can be merged with,
+	or its own index if there is none. canMerge( target, index ) decides whether the vertex at index can be merged into target.
+	Positions are hashed into cells twice epsilon wide, so only the cells overlapping the box within epsilon of a position
+	(at most 2x2x2) have to be searched, rather than every position before it. */
+template<typename CanMergeFn>
+vector<uint32_t> findWeldTargets( const vec3 *positions, size_t numPositions, float epsilon, const CanMergeFn &canMerge )
+{
+	const uint32_t NONE = numeric_limits<uint32_t>::max();
+
+	epsilon = std::max( epsilon, 0.0f );
+	const float epsilon2 = epsilon * epsilon;
+	const float cellSize = epsilon > 0 ? 2 * epsilon : 1.0f;
+	auto cellCoord = [cellSize]( float x ) { return (int64_t)floor( x / cellSize ); };
+	auto cellOf = [&]( const vec3 &p ) { return WeldCell{ cellCoord( p.x ), cellCoord( p.y ), cellCoord( p.z ) }; };
+
+	// Open addressing table holding the last position kept in each cell. The cell isn't stored, it is recomputed from that position.
+	// The rest of the positions kept in the cell are linked through nextInCell.
+	size_t tableSize = 16;
+	while( tableSize < numPositions * 2 )
+		tableSize *= 2;
+	const size_t mask = tableSize - 1;
+	vector<uint32_t> cellHeads( tableSize, NONE );
+	vector<uint32_t> nextInCell( numPositions, NONE );
+	auto findCellHead = [&]( const WeldCell &cell ) -> uint32_t& {
+		for( size_t i = hashWeldCell( cell ) & mask; ; i = ( i + 1 ) & mask ) {
+			uint32_t head = cellHeads[i];
+			if( head == NONE || cellOf( positions[head] ) == cell )
+				return cellHeads[i];
+		}
+	};
+
+	vector<uint32_t> result( numPositions );
+	for( uint32_t i = 0; i < numPositions; ++i ) {
+		const vec3 &p = positions[i];
+		uint32_t target = i;
+		for( int64_t x = cellCoord( p.x - epsilon ); x <= cellCoord( p.x + epsilon ); ++x ) {
+			for( int64_t y = cellCoord( p.y - epsilon ); y <= cellCoord( p.y + epsilon ); ++y ) {
+				for( int64_t z = cellCoord( p.z - epsilon ); z <= cellCoord( p.z + epsilon ); ++z ) {
+					for( uint32_t j = findCellHead( WeldCell{ x, y, z } ); j != NONE; j = nextInCell[j] ) {
+						if( j < target && distance2( positions[j], p ) <= epsilon2 && canMerge( j, i ) )
+							target = j;
+					}
+				}
+			}
+		}
+
+		result[i] = target;
+		if( target == i ) {
+			uint32_t &head = findCellHead( cellOf( p ) );
+			nextInCell[i] = head;
+			head = i;
+		}
+	}
+
+	return result;
+}
+
+// Removes the elements of every vertex that isn't its own weld target, moving the rest down to fill the gaps.
+template<typename T>
+void compactAttrib( vector<T> *attrib, size_t elementsPerVertex, const vector<uint32_t> &weldTargets )
+{
+	if( attrib->size() < weldTargets.size() * elementsPerVertex )
+		return;
+
+	size_t numKept = 0;
+	for( size_t i = 0; i < weldTargets.size(); ++i ) {
+		if( weldTargets[i] != i )
+			continue;
+
+		if( numKept != i )
+			copy( attrib->begin() + i * elementsPerVertex, attrib->begin() + ( i + 1 ) * elementsPerVertex, attrib->begin() + numKept * elementsPerVertex );
+		numKept++;
+	}
+
+	attrib->resize( numKept * elementsPerVertex );
+}
+
+} // anonymous namespace
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 // TriMeshGeomTarget
 class TriMeshGeomTarget : public geom::Target {
@@ -44,6 +157,7 @@ class TriMeshGeomTarget : public geom::Target {
 	uint8_t	getAttribDims( geom::Attrib attr ) const override;
 	void copyAttrib( geom::Attrib attr, uint8_t dims, size_t strideBytes, const float *srcData, size_t count ) override;
 	void copyIndices( geom::Primitive primitive, const uint32_t *source, size_t numIndices, uint8_t requiredBytesPerIndex ) override;
+	float*	acquireAttribBuffer( geom::Attrib attr, uint8_t dims, size_t count, size_t *resultStrideBytes ) override;
 	
   protected:
 	TriMesh		*mMesh;
@@ -60,6 +174,52 @@ void TriMeshGeomTarget::copyAttrib( geom::Attrib attr, uint8_t dims, size_t stri
 	mMesh->copyAttrib( attr, dims, strideBytes, srcData, count );
 }
 
+float* TriMeshGeomTarget::acquireAttribBuffer( geom::Attrib attr, uint8_t dims, size_t count, size_t *resultStrideBytes )
+{
+	// the Source can only write into our storage directly when no conversion between dimensions is needed
+	if( dims == 0 || dims != mMesh->getAttribDims( attr ) )
+		return nullptr;
+
+	*resultStrideBytes = dims * sizeof(float);
+	switch( attr ) {
+		case geom::Attrib::POSITION:
+			mMesh->mPositions.resize( dims * count );
+			return mMesh->mPositions.data();
+		case geom::Attrib::COLOR:
+			mMesh->mColors.resize( dims * count );
+			return mMesh->mColors.data();
+		case geom::Attrib::TEX_COORD_0:
+			mMesh->mTexCoords0.resize( dims * count );
+			return mMesh->mTexCoords0.data();
+		case geom::Attrib::TEX_COORD_1:
+			mMesh->mTexCoords1.resize( dims * count );
+			return mMesh->mTexCoords1.data();
+		case geom::Attrib::TEX_COORD_2:
+			mMesh->mTexCoords2.resize( dims * count );
+			return mMesh->mTexCoords2.data();
+		case geom::Attrib::TEX_COORD_3:
+			mMesh->mTexCoords3.resize( dims * count );
+			return mMesh->mTexCoords3.data();
+		case geom::Attrib::NORMAL:
+			if( dims != 3 )
+				return nullptr;
+			mMesh->mNormals.resize( count );
+			return (float*)mMesh->mNormals.data();
+		case geom::Attrib::TANGENT:
+			if( dims != 3 )
+				return nullptr;
+			mMesh->mTangents.resize( count );
+			return (float*)mMesh->mTangents.data();
+		case geom::Attrib::BITANGENT:
+			if( dims != 3 )
+				return nullptr;
+			mMesh->mBitangents.resize( count );
+			return (float*)mMesh->mBitangents.data();
+		default:
+			return nullptr;
+	}
+}
+
 void TriMeshGeomTarget::copyIndices( geom::Primitive primitive, const uint32_t *source, size_t numIndices, uint8_t /*requiredBytesPerIndex*/ )
 {
 	size_t targetNumIndices = numIndices;
@@ -631,83 +791,99 @@ void TriMesh::readImplV1( const IStreamRef &in )
 	mTexCoords0Dims = 2;
 }
 
-bool TriMesh::recalculateNormals( bool smooth, bool weighted )
+bool TriMesh::recalculateNormals( bool smooth, bool weighted, float smoothEpsilon )
 {
 	// requires valid indices and 3D vertices
 	if( mIndices.empty() || mPositions.empty() || mPositionsDims != 3 )
 		return false;
 
 	size_t numPositions = mPositions.size() / 3;
-	mNormals.assign( numPositions, vec3() );
+	const vec3 *positions = reinterpret_cast<const vec3*>( mPositions.data() );
 
-	// for smooth renormalization, we first find all unique vertices and keep track of them
-	std::vector<uint32_t> uniquePositions;
-	if( smooth ) {
-		uniquePositions.assign( numPositions, 0 );
-
-		for( uint32_t i = 0; i < numPositions; ++i ) {
-			if( uniquePositions[i] == 0 ) {
-				uniquePositions[i] = i + 1;
-				const vec3 &v0 = *(const vec3*)(&mPositions[i * 3]);
-				for( size_t j = i + 1; j < numPositions; ++j ) {
-					const vec3 &v1 = *(const vec3*)(&mPositions[j * 3]);
-					if( length2( v1 - v0 ) < FLT_EPSILON )
-						uniquePositions[j] = uniquePositions[i];
-				}
-			}
-		}
-	}
+	// for smooth renormalization, every vertex is mapped to the first one at the same position, which collects the normals for all of them
+	std::vector<uint32_t> weldTargets;
+	if( smooth )
+		weldTargets = findWeldTargets( positions, numPositions, smoothEpsilon, []( uint32_t, uint32_t ) { return true; } );
 
 	// perform surface normalization
-	uint32_t index0, index1, index2;
-	size_t numTriangles = getNumTriangles();
-	for( size_t i = 0; i < numTriangles; ++i ) {
-		if( smooth ) {
-			index0 = uniquePositions[mIndices[i * 3 + 0]] - 1;
-			index1 = uniquePositions[mIndices[i * 3 + 1]] - 1;
-			index2 = uniquePositions[mIndices[i * 3 + 2]] - 1;
-		}
-		else {
-			index0 = mIndices[i*3+0];
-			index1 = mIndices[i*3+1];
-			index2 = mIndices[i*3+2];
-		}
+	auto accumulateNormals = [&]( size_t beginTriangle, size_t endTriangle, vec3 *normals ) {
+		uint32_t index0, index1, index2;
+		for( size_t i = beginTriangle; i < endTriangle; ++i ) {
+			if( smooth ) {
+				index0 = weldTargets[mIndices[i * 3 + 0]];
+				index1 = weldTargets[mIndices[i * 3 + 1]];
+				index2 = weldTargets[mIndices[i * 3 + 2]];
+			}
+			else {
+				index0 = mIndices[i*3+0];
+				index1 = mIndices[i*3+1];
+				index2 = mIndices[i*3+2];
+			}
 
-		const vec3 &v0 = *(const vec3*)(&mPositions[index0 * 3]);
-		const vec3 &v1 = *(const vec3*)(&mPositions[index1 * 3]);
-		const vec3 &v2 = *(const vec3*)(&mPositions[index2 * 3]);
+			const vec3 &v0 = positions[index0];
+			const vec3 &v1 = positions[index1];
+			const vec3 &v2 = positions[index2];
 
-		vec3 e0 = v1 - v0;
-		vec3 e1 = v2 - v0;
-		vec3 e2 = v2 - v1;
+			vec3 e0 = v1 - v0;
+			vec3 e1 = v2 - v0;
+			vec3 e2 = v2 - v1;
 
-		if( length2( e0 ) < FLT_EPSILON )
-			continue;
-		if( length2( e1 ) < FLT_EPSILON )
-			continue;
-		if( length2( e2 ) < FLT_EPSILON )
-			continue;
+			if( length2( e0 ) < FLT_EPSILON )
+				continue;
+			if( length2( e1 ) < FLT_EPSILON )
+				continue;
+			if( length2( e2 ) < FLT_EPSILON )
+				continue;
 
-		vec3 normal = cross( e0, e1 );
+			vec3 normal = cross( e0, e1 );
 
-		// if not weighted, every normal has an equal contribution
-		if( ! weighted )
-			normal = normalize( normal );
+			// if not weighted, every normal has an equal contribution
+			if( ! weighted )
+				normal = normalize( normal );
 
-		mNormals[ index0 ] += normal;
-		mNormals[ index1 ] += normal;
-		mNormals[ index2 ] += normal;
-	}
+			normals[ index0 ] += normal;
+			normals[ index1 ] += normal;
+			normals[ index2 ] += normal;
+		}
+	};
 
-	// now normalize the summed normals
-	for( auto &normal : mNormals ) {
-		normal = normalize( normal );
+	// each chunk of triangles sums into its own copy of the normals, so that no two threads write to the same one. The first chunk uses mNormals.
+	const size_t numTriangles = getNumTriangles();
+	const size_t numChunks = detail::calcNumTriangleChunks( numTriangles );
+	std::vector<std::vector<vec3>> partialNormals( numChunks - 1 );
+	mNormals.assign( numPositions, vec3() );
+	if( numChunks == 1 )
+		accumulateNormals( 0, numTriangles, mNormals.data() );
+	else {
+		ThreadPool::get()->parallelFor( 0, numChunks, 1, [&]( size_t begin, size_t end ) {
+			for( size_t chunk = begin; chunk < end; ++chunk ) {
+				vec3 *normals = mNormals.data();
+				if( chunk > 0 ) {
+					partialNormals[chunk - 1].assign( numPositions, vec3() );
+					normals = partialNormals[chunk - 1].data();
+				}
+				accumulateNormals( numTriangles * chunk / numChunks, numTriangles * ( chunk + 1 ) / numChunks, normals );
+			}
+		} );
 	}
 
+	// now add up and normalize the summed normals
+	auto sumNormals = [&]( size_t begin, size_t end ) {
+		for( size_t i = begin; i < end; ++i ) {
+			for( const auto &partial : partialNormals )
+				mNormals[i] += partial[i];
+			mNormals[i] = normalize( mNormals[i] );
+		}
+	};
+	if( numChunks == 1 )
+		sumNormals( 0, numPositions );
+	else
+		ThreadPool::get()->parallelFor( 0, numPositions, detail::MIN_VERTICES_PER_CHUNK, sumNormals );
+
 	// copy normals to corresponding non-unique vertices
 	if( smooth ) {
 		for( size_t i = 0; i < numPositions; ++i ) {
-			mNormals[i] = mNormals[uniquePositions[i]-1];
+			mNormals[i] = mNormals[weldTargets[i]];
 		}
 	}
 
@@ -754,6 +930,45 @@ bool TriMesh::recalculateBitangents()
 	return true;
 }
 
+size_t TriMesh::weld( float epsilon )
+{
+	// requires 3D vertices
+	if( mPositions.empty() || mPositionsDims != 3 )
+		return 0;
+
+	const size_t numVertices = getNumVertices();
+	const vec3 *positions = reinterpret_cast<const vec3*>( mPositions.data() );
+	auto weldTargets = findWeldTargets( positions, numVertices, epsilon, [this]( uint32_t target, uint32_t index ) { return attributesEqual( target, index ); } );
+
+	// kept vertices stay in the same order, so each one's new index is the number kept before it
+	vector<uint32_t> newIndices( numVertices );
+	uint32_t numKept = 0;
+	for( size_t i = 0; i < numVertices; ++i ) {
+		if( weldTargets[i] == i )
+			newIndices[i] = numKept++;
+		else
+			newIndices[i] = newIndices[weldTargets[i]];
+	}
+
+	if( numKept == numVertices )
+		return 0;
+
+	compactAttrib( &mPositions, mPositionsDims, weldTargets );
+	compactAttrib( &mColors, mColorsDims, weldTargets );
+	compactAttrib( &mNormals, 1, weldTargets );
+	compactAttrib( &mTangents, 1, weldTargets );
+	compactAttrib( &mBitangents, 1, weldTargets );
+	compactAttrib( &mTexCoords0, mTexCoords0Dims, weldTargets );
+	compactAttrib( &mTexCoords1, mTexCoords1Dims, weldTargets );
+	compactAttrib( &mTexCoords2, mTexCoords2Dims, weldTargets );
+	compactAttrib( &mTexCoords3, mTexCoords3Dims, weldTargets );
+
+	for( auto &index : mIndices )
+		index = newIndices[index];
+
+	return numVertices - numKept;
+}
+
 //! TODO: optimize memory allocations
 void TriMesh::subdivide( int division, bool normalize )
 {
@@ -1113,6 +1328,11 @@ bool TriMesh::verticesEqual( uint32_t indexA, uint32_t indexB ) const
 			return false;
 	}
 
+	return attributesEqual( indexA, indexB );
+}
+
+bool TriMesh::attributesEqual( uint32_t indexA, uint32_t indexB ) const
+{
 	if( mColorsDims > 0 ) {
 		if( mColorsDims == 3 ) {
 			const vec3 &a = *reinterpret_cast<const vec3*>(&mColors[indexA*mColorsDims]);
@@ -1129,8 +1349,8 @@ bool TriMesh::verticesEqual( uint32_t indexA, uint32_t indexB ) const
 	}
 
 	if( mNormalsDims > 0 ) {
-		const vec3 &a = *reinterpret_cast<const vec3*>(&mNormals[indexA*mNormalsDims]);
-		const vec3 &b = *reinterpret_cast<const vec3*>(&mNormals[indexB*mNormalsDims]);
+		const vec3 &a = mNormals[indexA];
+		const vec3 &b = mNormals[indexB];
 		if( distance2( a, b ) > FLT_EPSILON )
 		return false;
 	}
@@ -1220,15 +1440,15 @@ bool TriMesh::verticesEqual( uint32_t indexA, uint32_t indexB ) const
 	}
 
 	if( mTangentsDims > 0 ) {
-		const vec3 &a = *reinterpret_cast<const vec3*>(&mTangents[indexA*mTangentsDims]);
-		const vec3 &b = *reinterpret_cast<const vec3*>(&mTangents[indexB*mTangentsDims]);
+		const vec3 &a = mTangents[indexA];
+		const vec3 &b = mTangents[indexB];
 		if( distance2( a, b ) > FLT_EPSILON )
 		return false;
 	}
 
 	if( mBitangentsDims > 0 ) {
-		const vec3 &a = *reinterpret_cast<const vec3*>(&mBitangents[indexA*mBitangentsDims]);
-		const vec3 &b = *reinterpret_cast<const vec3*>(&mBitangents[indexB*mBitangentsDims]);
+		const vec3 &a = mBitangents[indexA];
+		const vec3 &b = mBitangents[indexB];
 		if( distance2( a, b ) > FLT_EPSILON )
 		return false;
 	}
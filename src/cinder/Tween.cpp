@@ -96,8 +96,8 @@ bool AnimBase::isComplete() const
 		TimelineItemRef lastTween = mParentTimeline->findLastEnd( mVoidPtr );
 		if( lastTween )
 			return lastTween->isComplete();
-		else
-			return true;
+		else // batched tweens are removed as soon as they complete
+			return ! mParentTimeline->hasBatchedTweens( mVoidPtr );
 	}
 }
 
@@ -0,0 +1,80 @@
+/*
+ Copyright (c) 2016, The Cinder Project, All rights reserved.
+
+ This code is intended for use with the Cinder C++ library: http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cinder/TweenBatch.h"
+
+namespace cinder { namespace detail {
+
+namespace {
+
+// Easing.h's functions are inline and branch-light, so these loops are unrolled and vectorized by the compiler
+template<float (*EASE)( float )>
+void easeArray( float *values, size_t count )
+{
+	for( size_t i = 0; i < count; i++ )
+		values[i] = EASE( values[i] );
+}
+
+template<typename EaseT, float (*EASE)( float )>
+bool matchEase( const EaseFn &easeFn, EaseArrayFn *result )
+{
+	auto fnPtr = easeFn.target<float (*)( float )>();
+	if( ( fnPtr && *fnPtr == EASE ) || easeFn.target<EaseT>() ) {
+		*result = &easeArray<EASE>;
+		return true;
+	}
+
+	return false;
+}
+
+} // anonymous namespace
+
+EaseArrayFn findEaseArrayFn( const EaseFn &easeFn )
+{
+	EaseArrayFn result = nullptr;
+	matchEase<EaseNone, &easeNone>( easeFn, &result )
+		|| matchEase<EaseInQuad, &easeInQuad>( easeFn, &result )
+		|| matchEase<EaseOutQuad, &easeOutQuad>( easeFn, &result )
+		|| matchEase<EaseInOutQuad, &easeInOutQuad>( easeFn, &result )
+		|| matchEase<EaseOutInQuad, &easeOutInQuad>( easeFn, &result )
+		|| matchEase<EaseInCubic, &easeInCubic>( easeFn, &result )
+		|| matchEase<EaseOutCubic, &easeOutCubic>( easeFn, &result )
+		|| matchEase<EaseInOutCubic, &easeInOutCubic>( easeFn, &result )
+		|| matchEase<EaseOutInCubic, &easeOutInCubic>( easeFn, &result )
+		|| matchEase<EaseInQuart, &easeInQuart>( easeFn, &result )
+		|| matchEase<EaseOutQuart, &easeOutQuart>( easeFn, &result )
+		|| matchEase<EaseInOutQuart, &easeInOutQuart>( easeFn, &result )
+		|| matchEase<EaseOutInQuart, &easeOutInQuart>( easeFn, &result )
+		|| matchEase<EaseInQuint, &easeInQuint>( easeFn, &result )
+		|| matchEase<EaseOutQuint, &easeOutQuint>( easeFn, &result )
+		|| matchEase<EaseInOutQuint, &easeInOutQuint>( easeFn, &result )
+		|| matchEase<EaseOutInQuint, &easeOutInQuint>( easeFn, &result )
+		|| matchEase<EaseInSine, &easeInSine>( easeFn, &result )
+		|| matchEase<EaseOutSine, &easeOutSine>( easeFn, &result )
+		|| matchEase<EaseInOutSine, &easeInOutSine>( easeFn, &result )
+		|| matchEase<EaseOutInSine, &easeOutInSine>( easeFn, &result );
+
+	return result;
+}
+
+} } // namespace cinder::detail
@@ -0,0 +1,95 @@
+/*
+ Copyright (c) 2016, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cinder/audio/CommandQueue.h"
+
+using namespace std;
+
+namespace cinder { namespace audio {
+
+CommandQueue::CommandQueue()
+	: mPosted( nullptr ), mProcessed( nullptr )
+{
+}
+
+CommandQueue::~CommandQueue()
+{
+	destroyAll( mPosted.exchange( nullptr ) );
+	destroyAll( mProcessed.exchange( nullptr ) );
+}
+
+void CommandQueue::post( const Command &command )
+{
+	// reclaim commands the consumer is finished with, so that they're never freed on its thread
+	destroyAll( mProcessed.exchange( nullptr, memory_order_acquire ) );
+
+	Item *item = new Item{ command, nullptr };
+	push( mPosted, item, item );
+}
+
+size_t CommandQueue::process()
+{
+	// Taking the whole stack at once means items are never popped individually, which avoids the ABA problem.
+	Item *posted = mPosted.exchange( nullptr, memory_order_acquire );
+	if( ! posted )
+		return 0;
+
+	// reverse into the order that the commands were posted
+	Item *first = nullptr;
+	Item *last = posted;
+	size_t count = 0;
+	while( posted ) {
+		Item *next = posted->mNext;
+		posted->mNext = first;
+		first = posted;
+		posted = next;
+		count++;
+	}
+
+	for( Item *item = first; item; item = item->mNext )
+		item->mCommand();
+
+	push( mProcessed, first, last );
+	return count;
+}
+
+// static
+void CommandQueue::push( atomic<Item *> &stack, Item *first, Item *last )
+{
+	Item *head = stack.load( memory_order_relaxed );
+	do {
+		last->mNext = head;
+	} while( ! stack.compare_exchange_weak( head, first, memory_order_release, memory_order_relaxed ) );
+}
+
+// static
+void CommandQueue::destroyAll( Item *item )
+{
+	while( item ) {
+		Item *next = item->mNext;
+		delete item;
+		item = next;
+	}
+}
+
+} } // namespace cinder::audio
@@ -22,6 +22,7 @@
 */
 
 #include "cinder/audio/Context.h"
+#include "cinder/audio/GraphScheduler.h"
 #include "cinder/audio/InputNode.h"
 #include "cinder/audio/Utilities.h"
 #include "cinder/audio/dsp/Converter.h"
@@ -145,6 +146,7 @@ Context::~Context()
 {
 	disable();
 	lock_guard<mutex> lock( mMutex );
+	mGraphScheduler.reset();
 	uninitializeAllNodes();
 }
 
@@ -172,6 +174,9 @@ void Context::disable()
 	auto output = getOutput();
 	if( output )
 		getOutput()->disable();
+
+	// commands are no longer processed, so apply any that are still waiting
+	flushCommands();
 }
 
 void Context::setEnabled( bool b )
@@ -184,6 +189,40 @@ void Context::setEnabled( bool b )
 
 void Context::connectionsDidChange( const NodeRef & /*node*/ )
 {
+	if( mGraphScheduler ) {
+		lock_guard<mutex> lock( mMutex );
+		mGraphScheduler->build( mOutput, mAutoPulledNodes );
+	}
+}
+
+void Context::setNumWorkerThreads( size_t numThreads )
+{
+	if( numThreads == getNumWorkerThreads() )
+		return;
+
+	// threads are started and joined outside of the lock, so that the audio thread isn't blocked on them
+	unique_ptr<GraphScheduler> scheduler;
+	if( numThreads )
+		scheduler.reset( new GraphScheduler( numThreads ) );
+
+	lock_guard<mutex> lock( mMutex );
+	mGraphScheduler.swap( scheduler );
+
+	if( mGraphScheduler )
+		mGraphScheduler->build( mOutput, mAutoPulledNodes );
+	else
+		initializeAllNodes(); // reconfigures Node's that the scheduler switched to summing
+}
+
+size_t Context::getNumWorkerThreads() const
+{
+	return mGraphScheduler ? mGraphScheduler->getNumWorkerThreads() : 0;
+}
+
+void Context::invalidateGraphSchedule()
+{
+	if( mGraphScheduler )
+		mGraphScheduler->invalidate();
 }
 
 void Context::initializeAllNodes()
@@ -227,6 +266,7 @@ void Context::setOutput( const OutputNodeRef &output )
 	}
 
 	mOutput = output;
+	invalidateGraphSchedule();
 
 	if( mOutput )
 		initializeAllNodes();
@@ -289,9 +329,31 @@ void Context::uninitRecursive( const NodeRef &node, set<NodeRef> &traversedNodes
 	node->uninitializeImpl();
 }
 
+void Context::postCommand( const std::function<void ()> &command )
+{
+	if( isAudioThread() ) {
+		command();
+		return;
+	}
+
+	mCommandQueue.post( command );
+
+	if( ! mEnabled )
+		flushCommands();
+}
+
+void Context::flushCommands()
+{
+	if( mCommandQueue.isEmpty() )
+		return;
+
+	lock_guard<mutex> lock( mMutex );
+	mCommandQueue.process();
+}
+
 bool Context::isAudioThread() const
 {
-	return mAudioThreadId == std::this_thread::get_id();
+	return mAudioThreadId == std::this_thread::get_id() || ( mGraphScheduler && mGraphScheduler->isWorkerThread() );
 }
 
 void Context::preProcess()
@@ -299,7 +361,11 @@ void Context::preProcess()
 	mProcessTimer.start();
 	mAudioThreadId = std::this_thread::get_id();
 
+	mCommandQueue.process();
 	preProcessScheduledEvents();
+
+	if( mGraphScheduler )
+		mGraphScheduler->process();
 }
 
 void Context::postProcess()
@@ -324,6 +390,7 @@ void Context::incrementFrameCount()
 void Context::addAutoPulledNode( const NodeRef &node )
 {
 	mAutoPulledNodes.insert( node );
+	invalidateGraphSchedule();
 	mAutoPullRequired = true;
 	mAutoPullCacheDirty = true;
 
@@ -337,6 +404,7 @@ void Context::removeAutoPulledNode( const NodeRef &node )
 {
 	size_t result = mAutoPulledNodes.erase( node );
 	CI_VERIFY( result );
+	invalidateGraphSchedule();
 
 	mAutoPullCacheDirty = true;
 	if( mAutoPulledNodes.empty() )
@@ -380,19 +448,46 @@ void Context::scheduleEvent( double when, const NodeRef &node, bool callFuncBefo
 		eventFrameThreshold -= framesPerBlock;
 
 	// TODO: support multiple events, at the moment only supporting one per node.
-	if( node->mEventScheduled ) {
-		cancelScheduledEvents( node );
-	}
+	// A previous event is removed by the same command that splices in the new one, so that this still doesn't block on mMutex.
+	const bool replacesEvent = node->mNumScheduledEvents > 0;
+
+	node->mNumScheduledEvents++;
+
+	// the list node is allocated here and spliced in on the audio thread. A replaced event is moved into the command, so that it is destroyed off of the audio thread.
+	list<ScheduledEvent> events;
+	events.push_back( ScheduledEvent( eventFrameThreshold, node, callFuncBeforeProcess, func ) );
+	list<ScheduledEvent> canceledEvents;
+	NodeRef eventNode = node;
+	postCommand( [this, events, canceledEvents, eventNode, replacesEvent]() mutable {
+		if( replacesEvent ) {
+			removeScheduledEvent( eventNode, &canceledEvents );
+			// so that the executed command doesn't keep the Node alive, the rest of the replaced event is destroyed along with it
+			for( auto &event : canceledEvents )
+				event.mNode.reset();
+		}
+		eventNode.reset();
 
-	lock_guard<mutex> lock( mMutex );
-	node->mEventScheduled = true;
-	mScheduledEvents.push_back( ScheduledEvent( eventFrameThreshold, node, callFuncBeforeProcess, func ) );
+		mScheduledEvents.splice( mScheduledEvents.end(), events );
+	} );
 }
 
 void Context::cancelScheduledEvents( const NodeRef &node )
 {
-	lock_guard<mutex> lock( mMutex );
+	list<ScheduledEvent> canceledEvents;
+	if( isAudioThread() )
+		removeScheduledEvent( node, &canceledEvents );
+	else {
+		lock_guard<mutex> lock( mMutex );
+		// an event that is still waiting in the command queue has to be spliced in before it can be removed
+		mCommandQueue.process();
+		removeScheduledEvent( node, &canceledEvents );
+	}
 
+	// canceledEvents is destroyed here, after mMutex has been released
+}
+
+void Context::removeScheduledEvent( const NodeRef &node, std::list<ScheduledEvent> *canceledEvents )
+{
 	for( auto eventIt = mScheduledEvents.begin(); eventIt != mScheduledEvents.end(); ++eventIt ) {
 		if( eventIt->mNode == node ) {
 			// reset process frame range to an entire block
@@ -400,8 +495,8 @@ void Context::cancelScheduledEvents( const NodeRef &node )
 			range.first = 0;
 			range.second = getFramesPerBlock();
 
-			eventIt->mNode->mEventScheduled = false;
-			mScheduledEvents.erase( eventIt );
+			eventIt->mNode->mNumScheduledEvents--;
+			canceledEvents->splice( canceledEvents->end(), mScheduledEvents, eventIt );
 			break;
 		}
 	}
@@ -441,7 +536,7 @@ void Context::postProcessScheduledEvents()
 			range.first = 0;
 			range.second = getFramesPerBlock();
 
-			eventIt->mNode->mEventScheduled = false;
+			eventIt->mNode->mNumScheduledEvents--;
 			eventIt = mScheduledEvents.erase( eventIt );
 		}
 		else
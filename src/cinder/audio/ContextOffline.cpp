@@ -0,0 +1,237 @@
+/*
+ Copyright (c) 2016, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cinder/audio/ContextOffline.h"
+#include "cinder/audio/Exception.h"
+#include "cinder/audio/Utilities.h"
+
+using namespace std;
+
+namespace cinder { namespace audio {
+
+// ----------------------------------------------------------------------------------------------------
+// OutputNodeOffline
+// ----------------------------------------------------------------------------------------------------
+
+OutputNodeOffline::OutputNodeOffline( size_t sampleRate, size_t framesPerBlock, const Format &format )
+	: OutputNode( format ), mSampleRate( sampleRate ), mFramesPerBlock( framesPerBlock ), mNumLeftoverFrames( 0 ), mRecordingEnabled( false ), mNumRecordedFrames( 0 )
+{
+	CI_ASSERT( mSampleRate > 0 && mFramesPerBlock > 0 );
+
+	if( getChannelMode() != ChannelMode::SPECIFIED ) {
+		setChannelMode( ChannelMode::SPECIFIED );
+		setNumChannels( 2 );
+	}
+}
+
+void OutputNodeOffline::initialize()
+{
+	// the internal buffer may have been reallocated, so any frames left over from the last block are gone.
+	mNumLeftoverFrames = 0;
+
+	// keep any recorded frames, but make sure the channel count matches since it may have changed since construction.
+	if( mRecordedBuffer.getNumChannels() != getNumChannels() ) {
+		mRecordedBuffer.setSize( mRecordedBuffer.getNumFrames(), getNumChannels() );
+		mNumRecordedFrames = 0; // the Context's mutex is already held while initializing
+	}
+}
+
+void OutputNodeOffline::setRecordingEnabled( bool enable )
+{
+	lock_guard<mutex> lock( getContext()->getMutex() );
+	mRecordingEnabled = enable;
+}
+
+void OutputNodeOffline::clearRecording()
+{
+	lock_guard<mutex> lock( getContext()->getMutex() );
+	mNumRecordedFrames = 0;
+}
+
+BufferRef OutputNodeOffline::getRecordedCopy() const
+{
+	lock_guard<mutex> lock( getContext()->getMutex() );
+	auto result = make_shared<Buffer>( mNumRecordedFrames, getNumChannels() );
+	if( mNumRecordedFrames )
+		result->copy( mRecordedBuffer, mNumRecordedFrames );
+
+	return result;
+}
+
+void OutputNodeOffline::setTargetFile( const TargetFileRef &targetFile )
+{
+	if( targetFile && targetFile->getNumChannels() != getNumChannels() )
+		throw AudioFormatExc( "TargetFile has " + to_string( targetFile->getNumChannels() ) + " channels, expected " + to_string( getNumChannels() ) );
+
+	lock_guard<mutex> lock( getContext()->getMutex() );
+	mTargetFile = targetFile;
+}
+
+void OutputNodeOffline::renderBlock( size_t numFrames )
+{
+	auto ctx = getContext();
+	lock_guard<mutex> lock( ctx->getMutex() );
+
+	ctx->preProcess();
+
+	auto internalBuffer = getInternalBuffer();
+	internalBuffer->zero();
+	pullInputs( internalBuffer );
+
+	if( checkNotClipping() )
+		internalBuffer->zero();
+
+	deliverFrames( numFrames, 0 );
+	mNumLeftoverFrames = mFramesPerBlock - numFrames;
+
+	ctx->postProcess();
+}
+
+size_t OutputNodeOffline::renderLeftoverFrames( size_t numFrames )
+{
+	lock_guard<mutex> lock( getContext()->getMutex() );
+
+	const size_t numLeftover = std::min( numFrames, mNumLeftoverFrames );
+	deliverFrames( numLeftover, mFramesPerBlock - mNumLeftoverFrames );
+	mNumLeftoverFrames -= numLeftover;
+
+	return numLeftover;
+}
+
+void OutputNodeOffline::deliverFrames( size_t numFrames, size_t frameOffset )
+{
+	if( ! numFrames )
+		return;
+
+	if( mRecordingEnabled )
+		appendToRecording( getInternalBuffer(), numFrames, frameOffset );
+	if( mTargetFile )
+		mTargetFile->write( getInternalBuffer(), numFrames, frameOffset );
+}
+
+void OutputNodeOffline::appendToRecording( const Buffer *buffer, size_t numFrames, size_t frameOffset )
+{
+	// Not on a realtime thread, so allocating here is fine. Capacity is doubled to keep appends amortized O(1).
+	const size_t requiredFrames = mNumRecordedFrames + numFrames;
+	if( requiredFrames > mRecordedBuffer.getNumFrames() || mRecordedBuffer.getNumChannels() != buffer->getNumChannels() ) {
+		BufferDynamic grown( std::max( requiredFrames, mRecordedBuffer.getNumFrames() * 2 ), buffer->getNumChannels() );
+		if( mNumRecordedFrames )
+			grown.copy( mRecordedBuffer, mNumRecordedFrames );
+
+		mRecordedBuffer = std::move( grown );
+	}
+
+	mRecordedBuffer.copyOffset( *buffer, numFrames, mNumRecordedFrames, frameOffset );
+	mNumRecordedFrames = requiredFrames;
+}
+
+// ----------------------------------------------------------------------------------------------------
+// ContextOffline
+// ----------------------------------------------------------------------------------------------------
+
+ContextOffline::ContextOffline( size_t sampleRate, size_t framesPerBlock, size_t numChannels )
+	: mDefaultSampleRate( sampleRate ), mDefaultFramesPerBlock( framesPerBlock ), mDefaultNumChannels( numChannels ), mNumRenderedFrames( 0 )
+{
+}
+
+ContextOffline::~ContextOffline()
+{
+	// disable while getOutput() still resolves to this class, the base destructor can't create an output.
+	disable();
+}
+
+OutputDeviceNodeRef ContextOffline::createOutputDeviceNode( const DeviceRef & /*device*/, const Node::Format & /*format*/ )
+{
+	throw AudioContextExc( "ContextOffline does not support hardware output, use OutputNodeOffline instead." );
+}
+
+InputDeviceNodeRef ContextOffline::createInputDeviceNode( const DeviceRef & /*device*/, const Node::Format & /*format*/ )
+{
+	throw AudioContextExc( "ContextOffline does not support hardware input." );
+}
+
+void ContextOffline::setOutput( const OutputNodeRef &output )
+{
+	if( output && ! dynamic_pointer_cast<OutputNodeOffline>( output ) )
+		throw AudioContextExc( "ContextOffline requires an OutputNodeOffline." );
+
+	// assigned first, initializing the graph in Context::setOutput() calls back into getOutput().
+	mOutputOffline = static_pointer_cast<OutputNodeOffline>( output );
+	Context::setOutput( output );
+}
+
+const OutputNodeRef& ContextOffline::getOutput()
+{
+	if( ! mOutputOffline )
+		setOutput( makeNode( new OutputNodeOffline( mDefaultSampleRate, mDefaultFramesPerBlock, Node::Format().channels( mDefaultNumChannels ) ) ) );
+
+	return Context::getOutput();
+}
+
+const OutputNodeOfflineRef& ContextOffline::getOutputOffline()
+{
+	getOutput();
+	return mOutputOffline;
+}
+
+size_t ContextOffline::render( size_t numFrames )
+{
+	if( ! isEnabled() )
+		return 0;
+
+	const auto &output = getOutputOffline();
+	const size_t framesPerBlock = getFramesPerBlock();
+
+	// Each block marks the calling thread as the audio thread, which is only true while this method runs. Afterwards the
+	// previous audio thread is restored, so that changes made from the calling thread are posted again.
+	const thread::id prevAudioThreadId = getAudioThreadId();
+	auto restoreAudioThread = [&] {
+		lock_guard<mutex> lock( getMutex() );
+		setAudioThreadId( prevAudioThreadId );
+	};
+
+	// the end of the last block rendered by the previous call comes first.
+	size_t numFramesRendered = output->renderLeftoverFrames( numFrames );
+	try {
+		while( numFramesRendered < numFrames && isEnabled() ) {
+			const size_t blockFrames = std::min( framesPerBlock, numFrames - numFramesRendered );
+			output->renderBlock( blockFrames );
+			numFramesRendered += blockFrames;
+		}
+	}
+	catch( ... ) {
+		restoreAudioThread();
+		throw;
+	}
+	restoreAudioThread();
+
+	mNumRenderedFrames += numFramesRendered;
+	return numFramesRendered;
+}
+
+size_t ContextOffline::renderSeconds( double seconds )
+{
+	return render( timeToFrame( seconds, static_cast<double>( getSampleRate() ) ) );
+}
+
+} } // namespace cinder::audio
@@ -0,0 +1,345 @@
+/*
+ Copyright (c) 2016, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "cinder/audio/ConvolutionNode.h"
+#include "cinder/audio/Context.h"
+#include "cinder/audio/dsp/Dsp.h"
+#include "cinder/audio/dsp/Fft.h"
+#include "cinder/CinderMath.h"
+#include "cinder/Log.h"
+#include "cinder/ThreadPool.h"
+
+#include <cstring>
+
+using namespace std;
+
+namespace cinder { namespace audio {
+
+namespace {
+
+// Returns the factor that Fft::forward() scales spectra by, which depends on the implementation (vDSP's is 2). Products of two spectra
+// carry it twice, so it is divided out of the impulse response's spectra.
+float measureForwardScale( dsp::Fft *fft )
+{
+	Buffer impulse( fft->getSize() );
+	impulse[0] = 1;
+
+	BufferSpectral spectrum( fft->getSize() );
+	fft->forward( &impulse, &spectrum );
+	return spectrum.getReal()[1];
+}
+
+// Adds the product of the spectra a and b to result. Bin 0 packs the DC and nyquist components, which are both real, into its real and imaginary parts.
+void multiplyAccumulate( const BufferSpectral &a, const BufferSpectral &b, BufferSpectral *result )
+{
+	float *resultReal = result->getReal();
+	float *resultImag = result->getImag();
+	resultReal[0] += a.getReal()[0] * b.getReal()[0];
+	resultImag[0] += a.getImag()[0] * b.getImag()[0];
+
+	dsp::complexMulAdd( a.getReal() + 1, a.getImag() + 1, b.getReal() + 1, b.getImag() + 1, resultReal + 1, resultImag + 1, result->getNumFrames() - 1 );
+}
+
+// Spectra of numPartitions consecutive partitions of partitionSize frames, starting at offset, each zero padded to fft's size.
+vector<BufferSpectral> transformPartitions( const float *impulseResponse, size_t numFrames, size_t offset, size_t partitionSize, size_t numPartitions, dsp::Fft *fft )
+{
+	const float normalizer = 1 / measureForwardScale( fft );
+
+	vector<BufferSpectral> result;
+	Buffer padded( fft->getSize() );
+	for( size_t i = 0; i < numPartitions; i++ ) {
+		const size_t start = offset + i * partitionSize;
+		const size_t length = min( partitionSize, numFrames - start );
+		padded.zero();
+		memcpy( padded.getData(), impulseResponse + start, length * sizeof( float ) );
+
+		result.emplace_back( fft->getSize() );
+		auto &spectrum = result.back();
+		fft->forward( &padded, &spectrum );
+		dsp::mul( spectrum.getData(), normalizer, spectrum.getData(), spectrum.getSize() );
+	}
+
+	return result;
+}
+
+// Uniformly partitioned overlap-save convolution of one channel. The spectra of past input windows are kept in a frequency-domain delay
+// line, so that each window is only transformed once and is then multiplied with every partition of the impulse response as it ages.
+class PartitionedConvolver {
+  public:
+	PartitionedConvolver( size_t partitionSize, const vector<BufferSpectral> *partitions )
+		: mPartitionSize( partitionSize ), mPartitions( partitions ), mInput( partitionSize * 2 ), mOutput( partitionSize * 2 ),
+			mDelayLine( partitions->size(), BufferSpectral( partitionSize * 2 ) ), mDelayLinePos( 0 ), mAccumulator( partitionSize * 2 )
+	{}
+
+	//! Returns the input window, which holds the previous partition of input followed by the current one.
+	float*			getInput()					{ return mInput.getData(); }
+	//! Returns the second half of the last inverse transform, which is the output for the partition after the one it was computed from.
+	const float*	getOutput() const			{ return mOutput.getData() + mPartitionSize; }
+	size_t			getNumPartitions() const	{ return mPartitions->size(); }
+
+	//! Moves the current partition of input to the front of the window.
+	void shiftInput()
+	{
+		memcpy( mInput.getData(), mInput.getData() + mPartitionSize, mPartitionSize * sizeof( float ) );
+	}
+
+	//! Transforms the input window and makes it the newest entry of the delay line.
+	void pushInput( dsp::Fft *fft )
+	{
+		mDelayLinePos = ( mDelayLinePos + 1 ) % mDelayLine.size();
+		fft->forward( &mInput, &mDelayLine[mDelayLinePos] );
+	}
+
+	//! Accumulates the products of the impulse response partitions in [begin, end) with the input spectra of matching age.
+	void accumulate( size_t begin, size_t end )
+	{
+		const size_t delayLineSize = mDelayLine.size();
+		for( size_t i = begin; i < end; i++ ) {
+			const size_t pos = ( mDelayLinePos + delayLineSize - i ) % delayLineSize;
+			multiplyAccumulate( mDelayLine[pos], (*mPartitions)[i], &mAccumulator );
+		}
+	}
+
+	//! Transforms the accumulated spectrum into mOutput and clears it for the next partition.
+	void computeOutput( dsp::Fft *fft )
+	{
+		fft->inverse( &mAccumulator, &mOutput );
+		mAccumulator.zero();
+	}
+
+  private:
+	size_t							mPartitionSize;
+	const vector<BufferSpectral>	*mPartitions;
+	Buffer							mInput, mOutput;
+	vector<BufferSpectral>			mDelayLine;
+	size_t							mDelayLinePos;
+	BufferSpectral					mAccumulator;
+};
+
+} // anonymous namespace
+
+// The head convolves with the first ( 2 * TAIL_PARTITION_RATIO ) partitions of the impulse response, one block at a time. The tail covers
+// the rest with partitions of TAIL_PARTITION_RATIO blocks, starting two tail partitions in. That offset means the output for a tail period only
+// depends on input that was complete by the end of the period before last, so it can be computed during the whole preceding period: the
+// first block of each period transforms the input, every block accumulates an equal share of the partitions, and the last block transforms
+// the result back for the next period. Only the products are spread, each transform still runs within a single block.
+struct ConvolutionNode::Engine {
+	size_t								mBlockSize;
+	size_t								mNumChannels;
+	size_t								mTailBlockIndex;	// position of the current block in the tail period
+	unique_ptr<dsp::Fft>				mHeadFft, mTailFft;
+	vector<vector<BufferSpectral>>		mHeadPartitions, mTailPartitions;	// per impulse response channel
+	vector<PartitionedConvolver>		mHeads, mTails;		// per channel, mTails is empty for short responses
+};
+
+ConvolutionNode::ConvolutionNode( const Format &format )
+	: Node( format ), mEngineRequestId( 0 ), mImpulseResponseRequestId( 0 ), mNumRequests( 0 ), mNumPendingLoads( 0 )
+{
+}
+
+ConvolutionNode::ConvolutionNode( const BufferRef &impulseResponse, const Format &format )
+	: ConvolutionNode( format )
+{
+	setImpulseResponse( impulseResponse );
+}
+
+ConvolutionNode::~ConvolutionNode()
+{
+}
+
+void ConvolutionNode::setImpulseResponse( const BufferRef &impulseResponse )
+{
+	applyImpulseResponse( impulseResponse, ++mNumRequests );
+}
+
+void ConvolutionNode::loadImpulseResponse( const SourceFileRef &sourceFile )
+{
+	const uint64_t requestId = ++mNumRequests;
+	const size_t sampleRate = getSampleRate();
+	mNumPendingLoads++;
+
+	// the load doesn't keep the Node alive, if it is destroyed in the meantime the result is dropped
+	weak_ptr<ConvolutionNode> weakThis = static_pointer_cast<ConvolutionNode>( shared_from_this() );
+	ThreadPool::get()->submit( [weakThis, sourceFile, sampleRate, requestId] {
+		BufferRef impulseResponse;
+		try {
+			auto source = sourceFile->getSampleRate() == sampleRate ? sourceFile->clone() : sourceFile->cloneWithSampleRate( sampleRate );
+			impulseResponse = source->loadBuffer();
+		}
+		catch( exception &exc ) {
+			CI_LOG_EXCEPTION( "failed to load impulse response", exc );
+		}
+
+		auto node = weakThis.lock();
+		if( ! node )
+			return;
+
+		// building the Engine can also throw, which mustn't leave isLoading() stuck at true
+		try {
+			if( impulseResponse && impulseResponse->getNumFrames() > 0 )
+				node->applyImpulseResponse( impulseResponse, requestId );
+		}
+		catch( exception &exc ) {
+			CI_LOG_EXCEPTION( "failed to apply impulse response", exc );
+		}
+
+		node->mNumPendingLoads--;
+	} );
+}
+
+BufferRef ConvolutionNode::getImpulseResponse() const
+{
+	lock_guard<mutex> lock( mImpulseResponseMutex );
+	return mImpulseResponse;
+}
+
+void ConvolutionNode::applyImpulseResponse( const BufferRef &impulseResponse, uint64_t requestId )
+{
+	CI_ASSERT( impulseResponse && impulseResponse->getNumFrames() > 0 );
+
+	{
+		lock_guard<mutex> lock( mImpulseResponseMutex );
+		if( requestId < mImpulseResponseRequestId )
+			return;
+
+		mImpulseResponse = impulseResponse;
+		mImpulseResponseRequestId = requestId;
+	}
+
+	// if not initialized, the Engine is built by initialize()
+	if( ! isInitialized() )
+		return;
+
+	auto engine = makeEngine( impulseResponse );
+
+	// The old Engine is swapped into the command, so it is destroyed along with it on a non-audio thread. An Engine built for a
+	// different channel count or block size than the Node now has is dropped, initialize() has already built one from the latest response.
+	postCommand( [this, engine, requestId]() mutable {
+		if( requestId < mEngineRequestId || engine->mNumChannels != getNumChannels() || engine->mBlockSize != getFramesPerBlock() )
+			return;
+
+		mEngine.swap( engine );
+		mEngineRequestId = requestId;
+	} );
+}
+
+shared_ptr<ConvolutionNode::Engine> ConvolutionNode::makeEngine( const BufferRef &impulseResponse ) const
+{
+	const size_t blockSize = getFramesPerBlock();
+	const size_t tailPartitionSize = blockSize * TAIL_PARTITION_RATIO;
+	const size_t headFrames = tailPartitionSize * 2;
+	const size_t numFrames = impulseResponse->getNumFrames();
+	const size_t numHeadPartitions = ( min( numFrames, headFrames ) + blockSize - 1 ) / blockSize;
+	const size_t numTailPartitions = numFrames > headFrames ? ( numFrames - headFrames + tailPartitionSize - 1 ) / tailPartitionSize : 0;
+
+	CI_ASSERT_MSG( isPowerOf2( blockSize ), "frames per block must be a power of two" );
+
+	auto result = make_shared<Engine>();
+	result->mBlockSize = blockSize;
+	result->mNumChannels = getNumChannels();
+	result->mTailBlockIndex = 0;
+	result->mHeadFft.reset( new dsp::Fft( blockSize * 2 ) );
+	if( numTailPartitions )
+		result->mTailFft.reset( new dsp::Fft( tailPartitionSize * 2 ) );
+
+	for( size_t ch = 0; ch < impulseResponse->getNumChannels(); ch++ ) {
+		const float *channel = impulseResponse->getChannel( ch );
+		result->mHeadPartitions.push_back( transformPartitions( channel, numFrames, 0, blockSize, numHeadPartitions, result->mHeadFft.get() ) );
+		if( numTailPartitions )
+			result->mTailPartitions.push_back( transformPartitions( channel, numFrames, headFrames, tailPartitionSize, numTailPartitions, result->mTailFft.get() ) );
+	}
+
+	for( size_t ch = 0; ch < result->mNumChannels; ch++ ) {
+		const size_t partitionsChannel = min( ch, impulseResponse->getNumChannels() - 1 );
+		result->mHeads.emplace_back( blockSize, &result->mHeadPartitions[partitionsChannel] );
+		if( numTailPartitions )
+			result->mTails.emplace_back( tailPartitionSize, &result->mTailPartitions[partitionsChannel] );
+	}
+
+	return result;
+}
+
+void ConvolutionNode::initialize()
+{
+	lock_guard<mutex> lock( mImpulseResponseMutex );
+	if( ! mImpulseResponse )
+		return;
+
+	mEngine = makeEngine( mImpulseResponse );
+	mEngineRequestId = mImpulseResponseRequestId;
+}
+
+void ConvolutionNode::uninitialize()
+{
+	mEngine.reset();
+}
+
+void ConvolutionNode::process( Buffer *buffer )
+{
+	Engine *engine = mEngine.get();
+	if( ! engine )
+		return;
+
+	const size_t blockSize = engine->mBlockSize;
+	const size_t tailBlockIndex = engine->mTailBlockIndex;
+	const size_t tailOffset = blockSize * ( TAIL_PARTITION_RATIO + tailBlockIndex );
+
+	for( size_t ch = 0; ch < engine->mNumChannels; ch++ ) {
+		float *channel = buffer->getChannel( ch );
+
+		// The tail transforms the window of the two previous periods at the start of a period, before this one's input is added.
+		if( ! engine->mTails.empty() ) {
+			auto &tail = engine->mTails[ch];
+			if( tailBlockIndex == 0 ) {
+				tail.pushInput( engine->mTailFft.get() );
+				tail.shiftInput();
+			}
+			memcpy( tail.getInput() + tailOffset, channel, blockSize * sizeof( float ) );
+		}
+
+		auto &head = engine->mHeads[ch];
+		head.shiftInput();
+		memcpy( head.getInput() + blockSize, channel, blockSize * sizeof( float ) );
+		head.pushInput( engine->mHeadFft.get() );
+		head.accumulate( 0, head.getNumPartitions() );
+		head.computeOutput( engine->mHeadFft.get() );
+		memcpy( channel, head.getOutput(), blockSize * sizeof( float ) );
+
+		if( ! engine->mTails.empty() ) {
+			// the output for this period was computed during the last one, and is read before it is overwritten by the last block of this one
+			auto &tail = engine->mTails[ch];
+			const float *tailOutput = tail.getOutput() + tailBlockIndex * blockSize;
+			dsp::add( channel, tailOutput, channel, blockSize );
+
+			const size_t numTailPartitions = tail.getNumPartitions();
+			tail.accumulate( tailBlockIndex * numTailPartitions / TAIL_PARTITION_RATIO, ( tailBlockIndex + 1 ) * numTailPartitions / TAIL_PARTITION_RATIO );
+			if( tailBlockIndex == TAIL_PARTITION_RATIO - 1 )
+				tail.computeOutput( engine->mTailFft.get() );
+		}
+	}
+
+	engine->mTailBlockIndex = ( tailBlockIndex + 1 ) % TAIL_PARTITION_RATIO;
+}
+
+} } // namespace cinder::audio
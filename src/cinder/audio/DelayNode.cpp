@@ -69,18 +69,21 @@ void DelayNode::setMaxDelaySeconds( float seconds )
 
 	size_t delayBufferFrames = max( getFramesPerBlock(), delayFrames ) + 1;
 
-	mDelayBuffer.setSize( delayBufferFrames, getNumChannels() );
-	mDelayBuffer.zero();
-
+	// The new buffer is allocated here and swapped in on the audio thread. The old one is then destroyed along with the command.
+	auto delayBuffer = make_shared<BufferDynamic>( delayBufferFrames, getNumChannels() );
 	mMaxDelaySeconds = seconds;
-	mWriteIndex = 0;
+
+	postCommand( [this, delayBuffer] {
+		swap( mDelayBuffer, *delayBuffer );
+		mWriteIndex = 0;
+	} );
 }
 
 void DelayNode::clearBuffer()
 {
-	lock_guard<mutex> lock( getContext()->getMutex() );
-
-	mDelayBuffer.zero();
+	postCommand( [this] {
+		mDelayBuffer.zero();
+	} );
 }
 
 void DelayNode::initialize()
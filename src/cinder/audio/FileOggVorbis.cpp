@@ -51,6 +51,7 @@ SourceFileOggVorbis::SourceFileOggVorbis( const DataSourceRef &dataSource, size_
 SourceFileRef SourceFileOggVorbis::cloneWithSampleRate( size_t sampleRate ) const
 {
 	auto result = make_shared<SourceFileOggVorbis>( mDataSource, sampleRate );
+	result->setConverterType( mConverterType );
 	result->setupSampleRateConversion();
 
 	return result;
@@ -22,14 +22,16 @@
  */
 
 #include "cinder/audio/FilterNode.h"
+#include "cinder/audio/Context.h"
 
 using namespace std;
 
 namespace cinder { namespace audio {
 
 FilterBiquadNode::FilterBiquadNode( Mode mode, const Format &format )
-	: Node( format ), mMode( mode ), mCoeffsDirty( true ), mFreq( 200.0f ), mQ( 1.0f ), mGain( 0.0f )
+	: Node( format ), mMode( mode ), mCoeffsDirty( true ), mNumCascadeSections( 0 ), mFreq( 200.0f ), mQ( 1.0f ), mGain( 0.0f )
 {
+	mBiquadBank.setInterpolationEnabled();
 }
 
 void FilterBiquadNode::initialize()
@@ -40,7 +42,9 @@ void FilterBiquadNode::initialize()
 	mBufferd = BufferT<double>( getFramesPerBlock(), getNumChannels() );
 	mBiquads.resize( getNumChannels() );
 
-	if( mCoeffsDirty )
+	if( mNumCascadeSections )
+		setupBiquadBank();
+	else
 		updateBiquadParams();
 }
 
@@ -49,11 +53,55 @@ void FilterBiquadNode::uninitialize()
 	mBiquads.clear();
 }
 
+void FilterBiquadNode::enableCascade( size_t numSections )
+{
+	CI_ASSERT( numSections > 0 );
+
+	// allocated here rather than on the audio thread. The command holds on to the previous bank, so it is released on a non-audio thread too.
+	auto bank = make_shared<dsp::BiquadBank>( getNumChannels(), numSections );
+	bank->setInterpolationEnabled();
+	postCommand( [this, numSections, bank] {
+		mNumCascadeSections = numSections;
+		if( ! isInitialized() )
+			return; // initialize() sets up the bank
+
+		if( bank->getNumChannels() == getNumChannels() ) {
+			swap( mBiquadBank, *bank );
+			updateBiquadParams();
+		}
+		else
+			setupBiquadBank(); // the channel count changed after the bank was allocated
+	} );
+}
+
+void FilterBiquadNode::disableCascade()
+{
+	auto emptyBank = make_shared<dsp::BiquadBank>();
+	emptyBank->setInterpolationEnabled();
+	postCommand( [this, emptyBank] {
+		mNumCascadeSections = 0;
+		swap( mBiquadBank, *emptyBank );
+		for( auto &biquad : mBiquads )
+			biquad.reset();
+	} );
+}
+
+void FilterBiquadNode::setupBiquadBank()
+{
+	mBiquadBank.setSize( getNumChannels(), mNumCascadeSections );
+	updateBiquadParams();
+}
+
 void FilterBiquadNode::process( Buffer *buffer )
 {
 	if( mCoeffsDirty )
 		updateBiquadParams();
 
+	if( mNumCascadeSections ) {
+		mBiquadBank.process( buffer );
+		return;
+	}
+
 	size_t numFrames = buffer->getNumFrames();
 
 	for( size_t ch = 0; ch < getNumChannels(); ch++ ) {
@@ -103,6 +151,13 @@ void FilterBiquadNode::updateBiquadParams()
 		default:
 			break;
 	}
+
+	// every channel has the same response, so the bank's sections are all copied from the first
+	if( mNumCascadeSections ) {
+		dsp::BiquadBank::Coefficients coefficients( mBiquads[0] );
+		for( size_t section = 0; section < mNumCascadeSections; section++ )
+			mBiquadBank.setCoefficients( section, coefficients );
+	}
 }
 
 } } // namespace cinder::audio
@@ -63,9 +63,9 @@ void GenNode::initialize()
 
 void GenNode::setPhase( float phase )
 {
-	lock_guard<mutex> lock( getContext()->getMutex() );
-
-	mPhase = phase;
+	postCommand( [this, phase] {
+		mPhase = phase;
+	} );
 }
 
 // ----------------------------------------------------------------------------------------------------
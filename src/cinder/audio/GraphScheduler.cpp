@@ -0,0 +1,247 @@
+/*
+ Copyright (c) 2016, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cinder/audio/GraphScheduler.h"
+#include "cinder/audio/ChannelRouterNode.h"
+#include "cinder/CinderAssert.h"
+
+#include <algorithm>
+#include <chrono>
+#include <unordered_map>
+
+using namespace std;
+
+namespace cinder { namespace audio {
+
+namespace {
+
+// Idle workers spin for this many checks, then yield until they've been idle for SLEEP_AFTER_IDLE, after which they sleep.
+const size_t						SPIN_COUNT = 1000;
+const chrono::microseconds			SLEEP_AFTER_IDLE( 1000 );
+// Sleeping workers are woken without taking mSleepMutex on the audio thread, so a wake-up can be missed. This bounds how late it can be.
+const chrono::milliseconds			MAX_SLEEP( 2 );
+
+thread_local const GraphScheduler	*sWorkerScheduler = nullptr;
+
+enum class VisitState { VISITING, VISITED };
+
+// Appends every Node that node pulls to nodes, inputs before outputs. Returns false if the graph contains a cycle.
+bool collectNodes( Node *node, unordered_map<Node *, VisitState> &states, vector<Node *> &nodes )
+{
+	auto stateIt = states.find( node );
+	if( stateIt != states.end() )
+		return stateIt->second == VisitState::VISITED;
+
+	states[node] = VisitState::VISITING;
+	for( const auto &input : node->getInputs() ) {
+		if( ! collectNodes( input.get(), states, nodes ) )
+			return false;
+	}
+
+	states[node] = VisitState::VISITED;
+	nodes.push_back( node );
+	return true;
+}
+
+// Returns the highest level of the scheduled Node's that node pulls, or -1 if there are none. In-place Node's are
+// processed by whoever pulls them, so they are looked through.
+int findInputLevel( const Node *node, const unordered_map<const Node *, int> &levels )
+{
+	int result = -1;
+	for( const auto &input : node->getInputs() ) {
+		auto levelIt = levels.find( input.get() );
+		result = max( result, levelIt != levels.end() ? levelIt->second : findInputLevel( input.get(), levels ) );
+	}
+
+	return result;
+}
+
+inline void processNode( Node *node )
+{
+	// Summing Node's ignore the buffer and cache their result until the next block. The check guards against a
+	// Node having been reconfigured to process in-place since the schedule was built.
+	if( ! node->getProcessesInPlace() )
+		node->pullInputs( nullptr );
+}
+
+} // anonymous namespace
+
+GraphScheduler::GraphScheduler( size_t numWorkerThreads )
+	: mValid( false ), mWork( 0 ), mNumPending( 0 ), mNumSleeping( 0 ), mShouldQuit( false )
+{
+	CI_ASSERT( numWorkerThreads > 0 );
+
+	for( size_t i = 0; i < numWorkerThreads; i++ )
+		mThreads.emplace_back( &GraphScheduler::threadEntry, this );
+}
+
+GraphScheduler::~GraphScheduler()
+{
+	{
+		lock_guard<mutex> lock( mSleepMutex );
+		mShouldQuit = true;
+	}
+	mSleepCondition.notify_all();
+
+	for( auto &thread : mThreads )
+		thread.join();
+}
+
+void GraphScheduler::clear()
+{
+	mNodes.clear();
+	mLevelOffsets.clear();
+	mWork = 0;
+}
+
+void GraphScheduler::build( const NodeRef &output, const std::set<NodeRef> &autoPulledNodes )
+{
+	clear();
+	mValid = true;
+
+	unordered_map<Node *, VisitState> states;
+	vector<Node *> nodes;
+	bool acyclic = ! output || collectNodes( output.get(), states, nodes );
+	for( const auto &node : autoPulledNodes )
+		acyclic = acyclic && collectNodes( node.get(), states, nodes );
+
+	// feedback depends on the order that the cycle is pulled in, so it is left to the serial pull.
+	if( ! acyclic )
+		return;
+
+	// Give each input of a Node that sums several inputs its own buffer, so that they can be processed independently.
+	// ChannelRouterNode pulls once per route, which can be more than once per input, so its inputs are left as they are.
+	for( Node *node : nodes ) {
+		if( node->getProcessesInPlace() || node->getNumConnectedInputs() < 2 || dynamic_cast<ChannelRouterNode *>( node ) )
+			continue;
+
+		for( const auto &input : node->getInputs() ) {
+			if( input->getProcessesInPlace() )
+				input->setupProcessWithSumming();
+		}
+	}
+
+	// nodes is ordered inputs first, so levels of a Node's inputs are known by the time it is reached.
+	unordered_map<const Node *, int> levels;
+	vector<pair<int, Node *>> scheduled;
+	for( Node *node : nodes ) {
+		if( node->getProcessesInPlace() || node == output.get() )
+			continue;
+
+		int level = findInputLevel( node, levels ) + 1;
+		levels[node] = level;
+		scheduled.push_back( make_pair( level, node ) );
+	}
+
+	stable_sort( scheduled.begin(), scheduled.end(), []( const pair<int, Node *> &a, const pair<int, Node *> &b ) { return a.first < b.first; } );
+
+	for( size_t i = 0; i < scheduled.size(); i++ ) {
+		if( i == 0 || scheduled[i].first != scheduled[i - 1].first )
+			mLevelOffsets.push_back( i );
+
+		mNodes.push_back( scheduled[i].second->shared_from_this() );
+	}
+	mLevelOffsets.push_back( mNodes.size() );
+}
+
+void GraphScheduler::process()
+{
+	if( ! mValid )
+		return;
+
+	for( size_t level = 0; level + 1 < mLevelOffsets.size(); level++ ) {
+		const size_t begin = mLevelOffsets[level];
+		const size_t end = mLevelOffsets[level + 1];
+		if( end - begin == 1 ) {
+			processNode( mNodes[begin].get() );
+			continue;
+		}
+
+		mNumPending.store( end - begin, memory_order_relaxed );
+		mWork.store( ( uint64_t( end ) << 32 ) | begin, memory_order_release );
+		if( mNumSleeping.load() )
+			mSleepCondition.notify_all();
+
+		// help out, then wait for the Node's claimed by workers to finish
+		while( processNextNode() )
+			;
+		while( mNumPending.load( memory_order_acquire ) != 0 )
+			;
+	}
+}
+
+bool GraphScheduler::processNextNode()
+{
+	uint64_t work = mWork.load( memory_order_acquire );
+	while( true ) {
+		const uint32_t next = uint32_t( work );
+		const uint32_t end = uint32_t( work >> 32 );
+		if( next >= end )
+			return false;
+
+		if( mWork.compare_exchange_weak( work, work + 1, memory_order_acq_rel, memory_order_acquire ) ) {
+			processNode( mNodes[next].get() );
+			mNumPending.fetch_sub( 1, memory_order_release );
+			return true;
+		}
+	}
+}
+
+bool GraphScheduler::isWorkerThread() const
+{
+	return sWorkerScheduler == this;
+}
+
+void GraphScheduler::threadEntry()
+{
+	sWorkerScheduler = this;
+
+	auto hasWork = [this] {
+		uint64_t work = mWork.load( memory_order_acquire );
+		return uint32_t( work ) < uint32_t( work >> 32 );
+	};
+
+	size_t numSpins = 0;
+	auto idleStart = chrono::steady_clock::now();
+	while( ! mShouldQuit.load( memory_order_relaxed ) ) {
+		if( processNextNode() ) {
+			numSpins = 0;
+			continue;
+		}
+
+		if( numSpins < SPIN_COUNT ) {
+			if( numSpins++ == 0 )
+				idleStart = chrono::steady_clock::now();
+		}
+		else if( chrono::steady_clock::now() - idleStart < SLEEP_AFTER_IDLE )
+			this_thread::yield();
+		else {
+			unique_lock<mutex> lock( mSleepMutex );
+			mNumSleeping++;
+			mSleepCondition.wait_for( lock, MAX_SLEEP, [&] { return mShouldQuit.load() || hasWork(); } );
+			mNumSleeping--;
+		}
+	}
+}
+
+} } // namespace cinder::audio
@@ -41,7 +41,7 @@ namespace cinder { namespace audio {
 // ----------------------------------------------------------------------------------------------------
 
 Node::Node( const Format &format )
-	: mInitialized( false ), mEnabled( false ), mEventScheduled( false ), mChannelMode( format.getChannelMode() ),
+	: mInitialized( false ), mEnabled( false ), mNumScheduledEvents( 0 ), mChannelMode( format.getChannelMode() ),
 		mNumChannels( 1 ), mAutoEnabled( true ), mProcessInPlace( true ), mLastProcessedFrame( numeric_limits<uint64_t>::max() )
 {
 	if( format.getChannels() ) {
@@ -113,6 +113,10 @@ void Node::disconnectAllInputs()
 	for( auto &input : mInputs )
 		input->disconnectOutput( thisRef );
 
+	auto ctx = getContext();
+	if( ctx )
+		ctx->invalidateGraphSchedule();
+
 	mInputs.clear();
 	notifyConnectionsDidChange();
 }
@@ -126,6 +130,7 @@ void Node::connectInput( const NodeRef &input )
 	lock_guard<mutex> lock( ctx->getMutex() );
 
 	mInputs.insert( input );
+	ctx->invalidateGraphSchedule();
 	configureConnections();
 }
 
@@ -140,6 +145,7 @@ void Node::disconnectInput( const NodeRef &input )
 	for( auto inIt = mInputs.begin(); inIt != mInputs.end(); ++inIt ) {
 		if( *inIt == input ) {
 			mInputs.erase( inIt );
+			ctx->invalidateGraphSchedule();
 			break;
 		}
 	}
@@ -173,13 +179,23 @@ vector<NodeRef> Node::getOutputs() const
 	return result;
 }
 
+void Node::postCommand( const function<void ()> &command )
+{
+	// released as soon as the command has been called, otherwise it would keep this Node alive until the CommandQueue retires the command
+	NodeRef thisRef = shared_from_this();
+	getContext()->postCommand( [thisRef, command]() mutable {
+		command();
+		thisRef.reset();
+	} );
+}
+
 void Node::enable()
 {
 	if( ! mInitialized )
 		initializeImpl();
 
 	// Need to cancel events regardless if node is already enabled as one might be disabling us
-	if( mEventScheduled && ! getContext()->isAudioThread() ) {
+	if( mNumScheduledEvents && ! getContext()->isAudioThread() ) {
 		getContext()->cancelScheduledEvents( shared_from_this() );
 	}
 
@@ -193,7 +209,7 @@ void Node::enable()
 void Node::disable()
 {
 	// Need to cancel events regardless if node is already disabled as one might be enabling us
-	if( mEventScheduled && ! getContext()->isAudioThread() ) {
+	if( mNumScheduledEvents && ! getContext()->isAudioThread() ) {
 		getContext()->cancelScheduledEvents( shared_from_this() );
 	}
 
@@ -568,6 +584,7 @@ void NodeAutoPullable::disconnectAllOutputs()
 	if( mIsPulledByContext ) {
 		mIsPulledByContext = false;
 		getContext()->removeAutoPulledNode( shared_from_this() );
+		notifyConnectionsDidChange();
 	}
 }
 
@@ -577,10 +594,12 @@ void NodeAutoPullable::updatePullMethod()
 	if( ! hasOutputs && ! mIsPulledByContext ) {
 		mIsPulledByContext = true;
 		getContext()->addAutoPulledNode( shared_from_this() );
+		notifyConnectionsDidChange();
 	}
 	else if( hasOutputs && mIsPulledByContext ) {
 		mIsPulledByContext = false;
 		getContext()->removeAutoPulledNode( shared_from_this() );
+		notifyConnectionsDidChange();
 	}
 }
 
@@ -71,9 +71,15 @@ Param::Param( Node *parentNode, float initialValue )
 
 void Param::setValue( float value )
 {
-	lock_guard<mutex> lock( getContext()->getMutex() );
-	resetImpl();
 	mValue = value;
+	atomic_store( &mLastEvent, EventRef() );
+
+	list<EventRef> removedEvents;
+	NodeRef removedProcessor;
+	postCommand( [this, value, removedEvents, removedProcessor]() mutable {
+		resetImpl( &removedEvents, &removedProcessor );
+		mValue = value;
+	} );
 }
 
 EventRef Param::applyRamp( float valueEnd, double rampSeconds, const Options &options )
@@ -89,13 +95,7 @@ EventRef Param::applyRamp( float valueEnd, double rampSeconds, const Options &op
 	if( ! options.getLabel().empty() )
 		event->mLabel = options.getLabel();
 
-	lock_guard<mutex> lock( ctx->getMutex() );
-
-	removeEventsAt( timeBegin );
-	if( mProcessor )
-		mProcessor.reset();
-
-	mEvents.push_back( event );
+	postEvent( event, true );
 	return event;
 }
 
@@ -112,13 +112,7 @@ EventRef Param::applyRamp( float valueBegin, float valueEnd, double rampSeconds,
 	if( ! options.getLabel().empty() )
 		event->mLabel = options.getLabel();
 
-	lock_guard<mutex> lock( ctx->getMutex() );
-
-	removeEventsAt( timeBegin );
-	if( mProcessor )
-		mProcessor.reset();
-
-	mEvents.push_back( event );
+	postEvent( event, true );
 	return event;
 }
 
@@ -126,7 +120,6 @@ EventRef Param::appendRamp( float valueEnd, double rampSeconds, const Options &o
 {
 	initInternalBuffer();
 
-	auto ctx = getContext();
 	auto endTimeAndValue = findEndTimeAndValue();
 	double timeBegin = ( options.getBeginTime() >= 0 ? options.getBeginTime() : endTimeAndValue.first + options.getDelay() );
 	double timeEnd = timeBegin + rampSeconds;
@@ -136,8 +129,7 @@ EventRef Param::appendRamp( float valueEnd, double rampSeconds, const Options &o
 	if( ! options.getLabel().empty() )
 		event->mLabel = options.getLabel();
 
-	lock_guard<mutex> lock( ctx->getMutex() );
-	mEvents.push_back( event );
+	postEvent( event, false );
 	return event;
 }
 
@@ -145,7 +137,6 @@ EventRef Param::appendRamp( float valueBegin, float valueEnd, double rampSeconds
 {
 	initInternalBuffer();
 
-	auto ctx = getContext();
 	auto endTimeAndValue = findEndTimeAndValue();
 	double timeBegin = ( options.getBeginTime() >= 0 ? options.getBeginTime() : endTimeAndValue.first + options.getDelay() );
 	double timeEnd = timeBegin + rampSeconds;
@@ -155,8 +146,7 @@ EventRef Param::appendRamp( float valueBegin, float valueEnd, double rampSeconds
 	if( ! options.getLabel().empty() )
 		event->mLabel = options.getLabel();
 
-	lock_guard<mutex> lock( ctx->getMutex() );
-	mEvents.push_back( event );
+	postEvent( event, false );
 	return event;
 }
 
@@ -167,55 +157,62 @@ void Param::setProcessor( const NodeRef &node )
 
 	initInternalBuffer();
 
-	lock_guard<mutex> lock( getContext()->getMutex() );
+	{
+		lock_guard<mutex> lock( getContext()->getMutex() );
 
-	resetImpl();
+		// force node to be mono and initialize it
+		node->setNumChannels( 1 );
+		node->initializeImpl();
+	}
 
-	// force node to be mono and initialize it
-	node->setNumChannels( 1 );
-	node->initializeImpl();
+	atomic_store( &mLastEvent, EventRef() );
 
-	mProcessor = node;
-	mIsVaryingThisBlock = true; // stays true until there is no more processor and eval() sets this to false.
+	list<EventRef> removedEvents;
+	NodeRef removedProcessor;
+	postCommand( [this, node, removedEvents, removedProcessor]() mutable {
+		resetImpl( &removedEvents, &removedProcessor );
+		mProcessor = node;
+		mIsVaryingThisBlock = true; // stays true until there is no more processor and eval() sets this to false.
+	} );
 }
 
 void Param::reset()
 {
-	lock_guard<mutex> lock( getContext()->getMutex() );
-	resetImpl();
+	atomic_store( &mLastEvent, EventRef() );
+
+	list<EventRef> removedEvents;
+	NodeRef removedProcessor;
+	postCommand( [this, removedEvents, removedProcessor]() mutable {
+		resetImpl( &removedEvents, &removedProcessor );
+	} );
 }
 
 
 size_t Param::getNumEvents() const
 {
-	lock_guard<mutex> lock( getContext()->getMutex() );
+	auto ctx = getContext();
+	ctx->flushCommands();
+
+	lock_guard<mutex> lock( ctx->getMutex() );
 	return mEvents.size();
 }
 
 float Param::findDuration() const
 {
-	auto ctx = getContext();
-	lock_guard<mutex> lock( ctx->getMutex() );
-
-	if( mEvents.empty() )
-		return 0;
-	else {
-		const EventRef &event = mEvents.back();
-		return static_cast<float>(event->mTimeEnd - ctx->getNumProcessedSeconds());
-	}
+	auto endTimeAndValue = findEndTimeAndValue();
+	return static_cast<float>( endTimeAndValue.first - getContext()->getNumProcessedSeconds() );
 }
 
 pair<double, float> Param::findEndTimeAndValue() const
 {
-	auto ctx = getContext();
-	lock_guard<mutex> lock( ctx->getMutex() );
+	const double currentTime = getContext()->getNumProcessedSeconds();
 
-	if( mEvents.empty() )
-		return make_pair( ctx->getNumProcessedSeconds(), mValue.load() );
-	else {
-		const EventRef &event = mEvents.back();
+	// Scheduled Event's are tracked here rather than read from mEvents, which only has them once the audio thread processes the posted commands.
+	EventRef event = atomic_load( &mLastEvent );
+	if( event && ! event->mIsCanceled && event->mTimeEnd > currentTime )
 		return make_pair( event->mTimeEnd, event->mValueEnd );
-	}
+	else
+		return make_pair( currentTime, mValue.load() );
 }
 
 const float* Param::getValueArray()
@@ -331,16 +328,36 @@ bool Param::eval( double timeBegin, float *array, size_t arrayLength, size_t sam
 // Protected
 // ----------------------------------------------------------------------------------------------------
 
-void Param::resetImpl()
+void Param::postCommand( const function<void ()> &command )
 {
-	if( ! mEvents.empty() ) {
-		for( auto &event : mEvents )
-			event->cancel();
+	// the parent Node is kept alive until the command has been called
+	mParentNode->postCommand( command );
+}
 
-		mEvents.clear();
-	}
+void Param::postEvent( const EventRef &event, bool replace )
+{
+	atomic_store( &mLastEvent, event );
+
+	// the list node is allocated here and spliced into mEvents on the audio thread
+	list<EventRef> events( 1, event );
+	NodeRef removedProcessor;
+	postCommand( [this, replace, events, removedProcessor]() mutable {
+		if( replace ) {
+			removeEventsAt( events.front()->getTimeBegin() );
+			swap( mProcessor, removedProcessor );
+		}
+
+		mEvents.splice( mEvents.end(), events );
+	} );
+}
+
+void Param::resetImpl( list<EventRef> *removedEvents, NodeRef *removedProcessor )
+{
+	for( auto &event : mEvents )
+		event->cancel();
 
-	mProcessor.reset();
+	removedEvents->splice( removedEvents->end(), mEvents );
+	swap( mProcessor, *removedProcessor );
 }
 
 void Param::removeEventsAt( double time )
@@ -25,11 +25,19 @@
 #include "cinder/audio/Context.h"
 #include "cinder/CinderMath.h"
 
+#include <limits>
+
 using namespace ci;
 using namespace std;
 
 namespace cinder { namespace audio {
 
+namespace {
+
+const size_t NOT_CUED = numeric_limits<size_t>::max();
+
+} // anonymous namespace
+
 // ----------------------------------------------------------------------------------------------------
 // SamplePlayerNode
 // ----------------------------------------------------------------------------------------------------
@@ -217,13 +225,13 @@ void BufferPlayerNode::process( Buffer *buffer )
 // ----------------------------------------------------------------------------------------------------
 
 FilePlayerNode::FilePlayerNode( const Format &format )
-	: SamplePlayerNode( format ), mRingBufferPaddingFactor( 2 ), mLastUnderrun( 0 ), mLastOverrun( 0 ), mIsReadAsync( true )
+	: SamplePlayerNode( format ), mRingBufferPaddingFactor( 2 ), mLastUnderrun( 0 ), mLastOverrun( 0 ), mCuedReadPos( NOT_CUED ), mIsReadAsync( true )
 {
 }
 
 FilePlayerNode::FilePlayerNode( const SourceFileRef &sourceFile, bool isReadAsync, const Format &format )
 	: SamplePlayerNode( format ), mSourceFile( sourceFile ), mIsReadAsync( isReadAsync ), mRingBufferPaddingFactor( 2 ),
-		mLastUnderrun( 0 ), mLastOverrun( 0 )
+		mLastUnderrun( 0 ), mLastOverrun( 0 ), mCuedReadPos( NOT_CUED )
 {
 	if( mSourceFile ) {
 		mNumFrames = mSourceFile->getNumFrames();
@@ -236,7 +244,7 @@ FilePlayerNode::FilePlayerNode( const SourceFileRef &sourceFile, bool isReadAsyn
 FilePlayerNode::~FilePlayerNode()
 {
 	if( isInitialized() )
-		destroyReadThreadImpl();
+		removeStreamImpl();
 }
 
 void FilePlayerNode::initialize()
@@ -261,14 +269,19 @@ void FilePlayerNode::initialize()
 		mLoopEnd = mNumFrames;
 
 	if( mIsReadAsync ) {
-		mAsyncReadShouldQuit = false;
-		mReadThread = unique_ptr<thread>( new thread( bind( &FilePlayerNode::readAsyncImpl, this ) ) );
+		mStreamScheduler = StreamScheduler::get();
+		mStream = mStreamScheduler->addStream( bind( &FilePlayerNode::readAsyncImpl, this ) );
+
+		// cue the current read position
+		lock_guard<mutex> lock( mAsyncReadMutex );
+		mCuedReadPos = NOT_CUED;
+		seekImpl( mReadPos );
 	}
 }
 
 void FilePlayerNode::uninitialize()
 {
-	destroyReadThreadImpl();
+	removeStreamImpl();
 	mRingBuffers.clear();
 }
 
@@ -280,6 +293,7 @@ void FilePlayerNode::enableProcessing()
 	}
 
 	mIsEof = false;
+	mCuedReadPos = NOT_CUED; // the ring buffers are consumed from here on
 }
 
 void FilePlayerNode::disableProcessing()
@@ -340,6 +354,7 @@ void FilePlayerNode::setSourceFile( const SourceFileRef &sourceFile )
 
 	// reset num frames and loop markers
 	mNumFrames = mSourceFile->getNumFrames();
+	mCuedReadPos = NOT_CUED;
 	mLoopBegin = 0;
 	mLoopEnd = mNumFrames;
 
@@ -374,7 +389,7 @@ void FilePlayerNode::process( Buffer *buffer )
 
 	if( numReadAvail < mBufferFramesThreshold ) {
 		if( mIsReadAsync )
-			mIssueAsyncReadCond.notify_one();
+			requestAsyncRead( numReadAvail );
 		else
 			readImpl();
 	}
@@ -402,24 +417,23 @@ void FilePlayerNode::process( Buffer *buffer )
 
 void FilePlayerNode::readAsyncImpl()
 {
-	size_t lastReadPos = mReadPos;
-	while( true ) {
-		unique_lock<mutex> lock( mAsyncReadMutex );
-		mIssueAsyncReadCond.wait( lock );
+	lock_guard<mutex> lock( mAsyncReadMutex );
 
-		if( mAsyncReadShouldQuit )
-			return;
+	if( ! mSourceFile || mRingBuffers.empty() )
+		return;
 
-		size_t readPos = mReadPos;
-		if( readPos != lastReadPos )
-			mSourceFile->seek( readPos );
+	// readImpl() seeks the SourceFile if mReadPos was changed by seek() since the last read
+	while( mRingBuffers[0].getAvailableWrite() && readImpl() )
+		;
+}
 
-		readImpl();
-		lastReadPos = mReadPos;
-	}
+void FilePlayerNode::requestAsyncRead( size_t numFramesBuffered )
+{
+	auto timeUntilEmpty = chrono::duration<double>( (double)numFramesBuffered / (double)getSampleRate() );
+	mStream->requestRead( StreamScheduler::Clock::now() + chrono::duration_cast<StreamScheduler::Clock::duration>( timeUntilEmpty ) );
 }
 
-void FilePlayerNode::readImpl()
+size_t FilePlayerNode::readImpl()
 {
 	size_t readPos = mReadPos;
 	size_t availableWrite = mRingBuffers[0].getAvailableWrite();
@@ -428,7 +442,7 @@ void FilePlayerNode::readImpl()
 
 	if( ! numFramesToRead ) {
 		mLastOverrun = getContext()->getNumProcessedFrames();
-		return;
+		return 0;
 	}
 
 	// safety check that the SourceFile is on the correct read position, which could happen if two users are simultaneously reading from the same file.
@@ -443,9 +457,11 @@ void FilePlayerNode::readImpl()
 	for( size_t ch = 0; ch < getNumChannels(); ch++ ) {
 		if( ! mRingBuffers[ch].write( mIoBuffer.getChannel( ch ), numRead ) ) {
 			mLastOverrun = getContext()->getNumProcessedFrames();
-			return;
+			return 0;
 		}
 	}
+
+	return numRead;
 }
 
 void FilePlayerNode::seekImpl( size_t readPos )
@@ -454,11 +470,28 @@ void FilePlayerNode::seekImpl( size_t readPos )
 		return;
 
 	mIsEof = false;
-	mReadPos = math<size_t>::clamp( readPos, 0, mNumFrames );
+	readPos = math<size_t>::clamp( readPos, 0, mNumFrames );
 
-	// if async mode, readAsyncImpl() will notice mReadPos was updated and do the seek there.
-	if( ! mIsReadAsync )
+	if( ! mIsReadAsync ) {
+		mReadPos = readPos;
 		mSourceFile->seek( mReadPos );
+	}
+	else if( mStream && ! isEnabled() ) {
+		// Nothing consumes the ring buffers while disabled, so they are refilled from the new position ahead of playback.
+		// Cueing is less urgent than keeping playing streams fed, so the read is requested as if the ring buffers were full.
+		if( readPos != mCuedReadPos ) {
+			for( auto &ringBuffer : mRingBuffers )
+				ringBuffer.clear();
+
+			mReadPos = readPos;
+			mCuedReadPos = readPos;
+			requestAsyncRead( mRingBuffers[0].getSize() );
+		}
+	}
+	else {
+		// readAsyncImpl() will notice mReadPos was updated and do the seek there.
+		mReadPos = readPos;
+	}
 }
 
 void FilePlayerNode::stopImpl()
@@ -468,15 +501,15 @@ void FilePlayerNode::stopImpl()
 	for( auto &ringBuffer : mRingBuffers )
 		ringBuffer.clear();
 
+	mCuedReadPos = NOT_CUED;
 	seekImpl( 0 );
 }
 
-void FilePlayerNode::destroyReadThreadImpl()
+void FilePlayerNode::removeStreamImpl()
 {
-	if( mIsReadAsync && mReadThread ) {
-		mAsyncReadShouldQuit = true;
-		mIssueAsyncReadCond.notify_one();
-		mReadThread->join();
+	if( mStream ) {
+		mStreamScheduler->removeStream( mStream );
+		mStream.reset();
 	}
 }
 
@@ -99,10 +99,20 @@ Source::~Source()
 }
 
 SourceFile::SourceFile( size_t sampleRate )
-	: Source( sampleRate ), mNumFrames( 0 ), mFileNumFrames( 0 ), mReadPos( 0 )
+	: Source( sampleRate ), mNumFrames( 0 ), mFileNumFrames( 0 ), mReadPos( 0 ), mConverterType( dsp::ConverterType::DEFAULT )
 {
 }
 
+void SourceFile::setConverterType( dsp::ConverterType type )
+{
+	if( mConverterType == type )
+		return;
+
+	mConverterType = type;
+	if( mConverter )
+		setupSampleRateConversion();
+}
+
 void SourceFile::setupSampleRateConversion()
 {
 	size_t nativeSampleRate = getSampleRateNative();
@@ -116,7 +126,7 @@ void SourceFile::setupSampleRateConversion()
 
 		if( ! supportsConversion() ) {
 			size_t numChannels = getNumChannels();
-			mConverter = audio::dsp::Converter::create( nativeSampleRate, outputSampleRate, numChannels, numChannels, getMaxFramesPerRead() );
+			mConverter = audio::dsp::Converter::create( nativeSampleRate, outputSampleRate, numChannels, numChannels, getMaxFramesPerRead(), mConverterType );
 			mConverterReadBuffer.setSize( getMaxFramesPerRead(), numChannels );
 		}
 	}
@@ -179,6 +189,17 @@ BufferRef SourceFile::loadBuffer()
 			readCount += outNumFrames;
 			mReadPos += count.second;
 		}
+
+		// collect the frames that the converter held back waiting for more of the file
+		while( mReadPos < mNumFrames ) {
+			size_t numFlushed = std::min( mConverter->flush( &converterDestBuffer ), mNumFrames - mReadPos );
+			if( numFlushed == 0 )
+				break;
+
+			result->copyOffset( converterDestBuffer, numFlushed, mReadPos, 0 );
+			mReadPos += numFlushed;
+		}
+		mConverter->clear();
 	}
 	else {
 		size_t readCount = performRead( result.get(), 0, mNumFrames );
@@ -0,0 +1,168 @@
+/*
+ Copyright (c) 2016, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cinder/audio/StreamScheduler.h"
+#include "cinder/CinderAssert.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+
+namespace cinder { namespace audio {
+
+namespace {
+
+const StreamScheduler::Clock::rep	NO_DEADLINE = numeric_limits<StreamScheduler::Clock::rep>::max();
+// Requests are signaled without taking the mutex so that the audio thread never blocks on it, which means a worker can miss one
+// while it is about to wait. This bounds how late such a request is noticed.
+const chrono::milliseconds			MAX_WAIT( 10 );
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------------------------------
+// StreamScheduler::Stream
+// ----------------------------------------------------------------------------------------------------
+
+StreamScheduler::Stream::Stream( StreamScheduler *scheduler, const ReadFn &readFn )
+	: mScheduler( scheduler ), mReadFn( readFn ), mReadRequested( false ), mDeadline( NO_DEADLINE ), mReading( false )
+{
+}
+
+void StreamScheduler::Stream::requestRead( Clock::time_point deadline )
+{
+	// keep the earliest deadline of the requests made since the last read
+	const Clock::rep requested = deadline.time_since_epoch().count();
+	Clock::rep current = mDeadline.load( memory_order_relaxed );
+	while( requested < current && ! mDeadline.compare_exchange_weak( current, requested, memory_order_relaxed ) )
+		;
+
+	if( ! mReadRequested.exchange( true, memory_order_release ) ) {
+		mScheduler->mNumRequests++;
+		mScheduler->mRequestCondition.notify_one();
+	}
+}
+
+// ----------------------------------------------------------------------------------------------------
+// StreamScheduler
+// ----------------------------------------------------------------------------------------------------
+
+// static
+const StreamSchedulerRef& StreamScheduler::get()
+{
+	static StreamSchedulerRef sInstance = make_shared<StreamScheduler>();
+	return sInstance;
+}
+
+StreamScheduler::StreamScheduler( size_t numThreads )
+	: mNumRequests( 0 ), mShouldQuit( false )
+{
+	CI_ASSERT( numThreads > 0 );
+
+	for( size_t i = 0; i < numThreads; i++ )
+		mThreads.emplace_back( &StreamScheduler::threadEntry, this );
+}
+
+StreamScheduler::~StreamScheduler()
+{
+	{
+		lock_guard<mutex> lock( mMutex );
+		mShouldQuit = true;
+	}
+	mRequestCondition.notify_all();
+
+	for( auto &thread : mThreads )
+		thread.join();
+}
+
+StreamScheduler::StreamRef StreamScheduler::addStream( const ReadFn &readFn )
+{
+	StreamRef result( new Stream( this, readFn ) );
+
+	lock_guard<mutex> lock( mMutex );
+	mStreams.push_back( result );
+	return result;
+}
+
+void StreamScheduler::removeStream( const StreamRef &stream )
+{
+	unique_lock<mutex> lock( mMutex );
+
+	auto streamIt = find( mStreams.begin(), mStreams.end(), stream );
+	if( streamIt == mStreams.end() )
+		return;
+
+	mStreams.erase( streamIt );
+	mReadFinishedCondition.wait( lock, [&stream] { return ! stream->mReading; } );
+}
+
+size_t StreamScheduler::getNumStreams() const
+{
+	lock_guard<mutex> lock( mMutex );
+	return mStreams.size();
+}
+
+StreamScheduler::Stream* StreamScheduler::findNextStream() const
+{
+	Stream *result = nullptr;
+	Clock::rep earliestDeadline = NO_DEADLINE;
+	for( const auto &stream : mStreams ) {
+		if( stream->mReading || ! stream->mReadRequested.load( memory_order_acquire ) )
+			continue;
+
+		Clock::rep deadline = stream->mDeadline.load( memory_order_relaxed );
+		if( ! result || deadline < earliestDeadline ) {
+			result = stream.get();
+			earliestDeadline = deadline;
+		}
+	}
+
+	return result;
+}
+
+void StreamScheduler::threadEntry()
+{
+	unique_lock<mutex> lock( mMutex );
+	while( ! mShouldQuit ) {
+		const uint64_t numRequests = mNumRequests;
+		Stream *stream = findNextStream();
+		if( ! stream ) {
+			mRequestCondition.wait_for( lock, MAX_WAIT, [&] { return mShouldQuit || mNumRequests != numRequests; } );
+			continue;
+		}
+
+		// Claim every request made so far. One made while reading is picked up once the read has finished.
+		stream->mReading = true;
+		stream->mDeadline.store( NO_DEADLINE, memory_order_relaxed );
+		stream->mReadRequested.store( false, memory_order_relaxed );
+
+		lock.unlock();
+		stream->mReadFn();
+		lock.lock();
+
+		stream->mReading = false;
+		mReadFinishedCondition.notify_all();
+	}
+}
+
+} } // namespace cinder::audio
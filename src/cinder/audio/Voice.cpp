@@ -27,6 +27,7 @@
 #include "cinder/audio/PanNode.h"
 
 #include <map>
+#include <mutex>
 
 using namespace std;
 using namespace ci;
@@ -56,9 +57,7 @@ public:
 	void	addVoice( const VoiceRef &source, const Voice::Options &options );
 	void	removeVoice( size_t busId );
 
-	BufferRef loadBuffer( const SourceFileRef &sourceFile );
-	// clears the cache of all previously loaded audio file buffers stored in mBufferCache
-	void clearBufferCache();
+	const VoicePoolNodeRef& getVoicePool();
 
 private:
 	MixerImpl();
@@ -72,9 +71,29 @@ private:
 	size_t getFirstAvailableBusId() const;
 
 	map<size_t, Bus> mBusses;							// key is bus id
-	map<SourceFileRef, BufferRef> mBufferCache;		// key is the source file
+	VoicePoolNodeRef mVoicePool;
 };
 
+namespace {
+
+// The buffer cache doesn't live in MixerImpl, so that VoicePoolNode's on other Context's can use it without enabling master().
+// The key is the SourceFile the user passed in and the samplerate it was loaded at, rather than the resampling clone, which is new every time.
+typedef map<pair<SourceFileRef, size_t>, BufferRef>	BufferCache;
+
+BufferCache& getBufferCache()
+{
+	static BufferCache sBufferCache;
+	return sBufferCache;
+}
+
+mutex& getBufferCacheMutex()
+{
+	static mutex sBufferCacheMutex;
+	return sBufferCacheMutex;
+}
+
+} // anonymous namespace
+
 MixerImpl* MixerImpl::get()
 {
 	static unique_ptr<MixerImpl> sMixer;
@@ -116,21 +135,15 @@ void MixerImpl::removeVoice( size_t busId )
 	mBusses.erase( it );
 }
 
-BufferRef MixerImpl::loadBuffer( const SourceFileRef &sourceFile )
+const VoicePoolNodeRef& MixerImpl::getVoicePool()
 {
-	auto cached = mBufferCache.find( sourceFile );
-	if( cached != mBufferCache.end() )
-		return cached->second;
-	else {
-		BufferRef result = sourceFile->loadBuffer();
-		mBufferCache.insert( make_pair( sourceFile, result ) );
-		return result;
+	if( ! mVoicePool ) {
+		Context *ctx = Context::master();
+		mVoicePool = ctx->makeNode( new VoicePoolNode( 64 ) );
+		mVoicePool >> ctx->getOutput();
 	}
-}
-	
-void MixerImpl::clearBufferCache()
-{
-	mBufferCache.clear();
+
+	return mVoicePool;
 }
 
 size_t MixerImpl::getFirstAvailableBusId() const
@@ -209,7 +222,39 @@ Voice::~Voice()
 	
 void Voice::clearBufferCache()
 {
-	MixerImpl::get()->clearBufferCache();
+	BufferCache bufferCache;
+	{
+		lock_guard<mutex> lock( getBufferCacheMutex() );
+		bufferCache.swap( getBufferCache() );
+	}
+}
+
+BufferRef Voice::loadBuffer( const SourceFileRef &sourceFile )
+{
+	return loadBuffer( sourceFile, sourceFile->getSampleRate() );
+}
+
+BufferRef Voice::loadBuffer( const SourceFileRef &sourceFile, size_t sampleRate )
+{
+	auto key = make_pair( sourceFile, sampleRate );
+	{
+		lock_guard<mutex> lock( getBufferCacheMutex() );
+		auto cached = getBufferCache().find( key );
+		if( cached != getBufferCache().end() )
+			return cached->second;
+	}
+
+	// Decoded without holding the lock, from a clone since SourceFile isn't safe to read from several threads and another
+	// thread may miss the cache for the same file. If that thread loaded it first, its Buffer is kept.
+	BufferRef result = sourceFile->cloneWithSampleRate( sampleRate )->loadBuffer();
+
+	lock_guard<mutex> lock( getBufferCacheMutex() );
+	return getBufferCache().insert( make_pair( key, result ) ).first->second;
+}
+
+const VoicePoolNodeRef& Voice::getVoicePool()
+{
+	return MixerImpl::get()->getVoicePool();
 }
 
 float Voice::getVolume() const
@@ -268,7 +313,7 @@ VoiceSamplePlayerNode::VoiceSamplePlayerNode( const SourceFileRef &sourceFile, c
 	SourceFileRef sf = requiredSampleRate == sourceFile->getSampleRate() ? sourceFile : sourceFile->cloneWithSampleRate( requiredSampleRate );
 
 	if( sf->getNumFrames() <= options.getMaxFramesForBufferPlayback() ) {
-		BufferRef buffer = MixerImpl::get()->loadBuffer( sf );
+		BufferRef buffer = loadBuffer( sourceFile, requiredSampleRate );
 		mNode = Context::master()->makeNode( new BufferPlayerNode( buffer ) );
 	} else
 		mNode = Context::master()->makeNode( new FilePlayerNode( sf ) );
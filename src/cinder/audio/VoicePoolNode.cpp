@@ -0,0 +1,274 @@
+/*
+ Copyright (c) 2016, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "cinder/audio/VoicePoolNode.h"
+#include "cinder/audio/Context.h"
+#include "cinder/audio/Voice.h"
+#include "cinder/audio/dsp/Dsp.h"
+#include "cinder/CinderMath.h"
+
+using namespace std;
+
+namespace cinder { namespace audio {
+
+VoicePoolNode::VoicePoolNode( size_t numVoices, const Format &format )
+	: InputNode( format ), mSlots( numVoices ), mNumPlayCalls( 0 ), mNumStolenVoices( 0 ), mVoiceStates( numVoices ), mFinishedIds( numVoices )
+{
+	CI_ASSERT( numVoices > 0 );
+
+	setChannelMode( ChannelMode::SPECIFIED );
+	setNumChannels( 2 );
+	if( ! format.isAutoEnableSet() )
+		setAutoEnabled();
+
+	for( size_t i = 0; i < numVoices; i++ ) {
+		mSlots[i].mId = 0;
+		mSlots[i].mStartOrder = 0;
+		mVoiceStates[i].mBuffer = nullptr;
+		mVoiceStates[i].mId = 0;
+		mVoiceStates[i].mPlaying = false;
+		mFinishedIds[i] = 0;
+	}
+}
+
+VoicePoolNode::~VoicePoolNode()
+{
+}
+
+VoicePoolNode::VoiceId VoicePoolNode::play( const BufferRef &buffer, float gain, float pan, float pitch, double when )
+{
+	CI_ASSERT( buffer && buffer->getNumChannels() > 0 );
+
+	lock_guard<mutex> lock( mSlotsMutex );
+
+	// use the first free voice, or steal the one that was started longest ago
+	size_t slotIndex = 0;
+	bool isFree = false;
+	for( size_t i = 0; i < mSlots.size(); i++ ) {
+		if( mSlots[i].mId == mFinishedIds[i].load() ) {
+			slotIndex = i;
+			isFree = true;
+			break;
+		}
+		if( mSlots[i].mStartOrder < mSlots[slotIndex].mStartOrder )
+			slotIndex = i;
+	}
+
+	if( ! isFree )
+		mNumStolenVoices++;
+
+	auto &slot = mSlots[slotIndex];
+	BufferRef previousBuffer = slot.mBuffer;
+	slot.mBuffer = buffer;
+	slot.mId = ++mNumPlayCalls * mSlots.size() + slotIndex;
+	slot.mStartOrder = mNumPlayCalls;
+
+	VoiceState state;
+	state.mBuffer = buffer.get();
+	state.mId = slot.mId;
+	state.mReadPos = 0;
+	state.mStartFrame = when > 0 ? uint64_t( when * (double)getSampleRate() ) : 0;
+	state.mGain = gain;
+	state.mPan = pan;
+	state.mPitch = pitch;
+	state.mPlaying = true;
+
+	// previousBuffer may still be playing until the command is processed. Captured by the command, it is released on a non-audio thread.
+	postCommand( [this, slotIndex, state, previousBuffer] {
+		mVoiceStates[slotIndex] = state;
+	} );
+
+	return slot.mId;
+}
+
+VoicePoolNode::VoiceId VoicePoolNode::play( const SourceFileRef &sourceFile, float gain, float pan, float pitch, double when )
+{
+	return play( Voice::loadBuffer( sourceFile, getSampleRate() ), gain, pan, pitch, when );
+}
+
+void VoicePoolNode::stop( VoiceId id )
+{
+	postVoiceCommand( id, []( VoiceState &voice ) {
+		voice.mPlaying = false;
+	} );
+}
+
+void VoicePoolNode::stopAll()
+{
+	postCommand( [this] {
+		for( size_t i = 0; i < mVoiceStates.size(); i++ ) {
+			if( mVoiceStates[i].mPlaying )
+				finishVoice( i );
+		}
+	} );
+}
+
+void VoicePoolNode::setGain( VoiceId id, float gain )
+{
+	postVoiceCommand( id, [gain]( VoiceState &voice ) {
+		voice.mGain = gain;
+	} );
+}
+
+void VoicePoolNode::setPan( VoiceId id, float pan )
+{
+	postVoiceCommand( id, [pan]( VoiceState &voice ) {
+		voice.mPan = pan;
+	} );
+}
+
+void VoicePoolNode::setPitch( VoiceId id, float pitch )
+{
+	postVoiceCommand( id, [pitch]( VoiceState &voice ) {
+		voice.mPitch = pitch;
+	} );
+}
+
+void VoicePoolNode::postVoiceCommand( VoiceId id, const function<void ( VoiceState & )> &command )
+{
+	size_t slotIndex = size_t( id % mSlots.size() );
+	postCommand( [this, id, slotIndex, command] {
+		auto &voice = mVoiceStates[slotIndex];
+		if( voice.mId != id || ! voice.mPlaying )
+			return;
+
+		command( voice );
+		if( ! voice.mPlaying )
+			finishVoice( slotIndex );
+	} );
+}
+
+bool VoicePoolNode::isPlaying( VoiceId id ) const
+{
+	size_t slotIndex = size_t( id % mSlots.size() );
+
+	lock_guard<mutex> lock( mSlotsMutex );
+	return id != 0 && mSlots[slotIndex].mId == id && mFinishedIds[slotIndex].load() != id;
+}
+
+size_t VoicePoolNode::getNumPlayingVoices() const
+{
+	lock_guard<mutex> lock( mSlotsMutex );
+
+	size_t result = 0;
+	for( size_t i = 0; i < mSlots.size(); i++ ) {
+		if( mSlots[i].mId != mFinishedIds[i].load() )
+			result++;
+	}
+
+	return result;
+}
+
+void VoicePoolNode::finishVoice( size_t slotIndex )
+{
+	auto &voice = mVoiceStates[slotIndex];
+	voice.mPlaying = false;
+	mFinishedIds[slotIndex] = voice.mId;
+}
+
+void VoicePoolNode::process( Buffer *buffer )
+{
+	const size_t numFrames = buffer->getNumFrames();
+	const uint64_t blockStartFrame = getContext()->getNumProcessedFrames();
+
+	buffer->zero();
+
+	for( size_t i = 0; i < mVoiceStates.size(); i++ ) {
+		auto &voice = mVoiceStates[i];
+		if( ! voice.mPlaying )
+			continue;
+
+		// voices scheduled within this block start on their exact frame
+		size_t offset = 0;
+		if( voice.mStartFrame > blockStartFrame ) {
+			if( voice.mStartFrame >= blockStartFrame + numFrames )
+				continue;
+
+			offset = size_t( voice.mStartFrame - blockStartFrame );
+		}
+
+		if( ! mixVoice( voice, buffer, offset, numFrames - offset ) )
+			finishVoice( i );
+	}
+}
+
+bool VoicePoolNode::mixVoice( VoiceState &voice, Buffer *buffer, size_t offset, size_t numFrames )
+{
+	const Buffer *source = voice.mBuffer;
+	const size_t sourceFrames = source->getNumFrames();
+	const bool sourceIsStereo = source->getNumChannels() > 1;
+
+	float gains[2];
+	if( sourceIsStereo ) {
+		// balance, which leaves both channels at full gain when centered
+		gains[0] = voice.mGain * math<float>::min( 1, 2 * ( 1 - voice.mPan ) );
+		gains[1] = voice.mGain * math<float>::min( 1, 2 * voice.mPan );
+	}
+	else {
+		// equal power panning, see Pan2dNode
+		const float posRadians = voice.mPan * float( M_PI / 2.0 );
+		gains[0] = voice.mGain * math<float>::cos( posRadians );
+		gains[1] = voice.mGain * math<float>::sin( posRadians );
+	}
+
+	if( voice.mPitch == 1 && voice.mReadPos == math<double>::floor( voice.mReadPos ) ) {
+		const size_t readPos = size_t( voice.mReadPos );
+		const size_t numToMix = readPos < sourceFrames ? min( numFrames, sourceFrames - readPos ) : 0;
+		for( size_t ch = 0; ch < 2; ch++ ) {
+			const float *sourceChannel = source->getChannel( sourceIsStereo ? ch : 0 ) + readPos;
+			float *destChannel = buffer->getChannel( ch ) + offset;
+			dsp::mulAdd( sourceChannel, gains[ch], destChannel, destChannel, numToMix );
+		}
+
+		voice.mReadPos += numToMix;
+		return readPos + numToMix < sourceFrames;
+	}
+
+	const float *sourceChannels[2] = { source->getChannel( 0 ), source->getChannel( sourceIsStereo ? 1 : 0 ) };
+	float *destChannels[2] = { buffer->getChannel( 0 ) + offset, buffer->getChannel( 1 ) + offset };
+	const double rate = math<double>::max( voice.mPitch, 0 );
+
+	double readPos = voice.mReadPos;
+	for( size_t i = 0; i < numFrames; i++ ) {
+		const size_t index = size_t( readPos );
+		if( index >= sourceFrames ) {
+			voice.mReadPos = readPos;
+			return false;
+		}
+
+		const float frac = float( readPos - index );
+		for( size_t ch = 0; ch < 2; ch++ ) {
+			const float current = sourceChannels[ch][index];
+			const float next = index + 1 < sourceFrames ? sourceChannels[ch][index + 1] : 0;
+			destChannels[ch][i] += ( current + ( next - current ) * frac ) * gains[ch];
+		}
+
+		readPos += rate;
+	}
+
+	voice.mReadPos = readPos;
+	return size_t( readPos ) < sourceFrames;
+}
+
+} } // namespace cinder::audio
@@ -136,6 +136,15 @@ void Biquad::process( const float *source, float *dest, size_t framesToProcess )
 #endif
 }
 
+void Biquad::getCoefficients( double *b0, double *b1, double *b2, double *a1, double *a2 ) const
+{
+	*b0 = mB0;
+	*b1 = mB1;
+	*b2 = mB2;
+	*a1 = mA1;
+	*a2 = mA2;
+}
+
 void Biquad::getFrequencyResponse( int nFrequencies, const float *frequency, float *magResponse, float *phaseResponse )
 {
     // Evaluate the Z-transform of the filter at given normalized
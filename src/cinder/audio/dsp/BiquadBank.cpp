@@ -0,0 +1,177 @@
+/*
+ Copyright (c) 2016, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "cinder/audio/dsp/BiquadBank.h"
+#include "cinder/audio/dsp/Biquad.h"
+#include "cinder/CinderAssert.h"
+#include "DspKernels.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+namespace cinder { namespace audio { namespace dsp {
+
+namespace {
+
+// Frames of a group processed per kernel call, which bounds the scratch buffer.
+const size_t CHUNK_FRAMES = 256;
+
+} // anonymous namespace
+
+BiquadBank::Coefficients::Coefficients( const Biquad &biquad )
+{
+	double db0, db1, db2, da1, da2;
+	biquad.getCoefficients( &db0, &db1, &db2, &da1, &da2 );
+
+	b0 = float( db0 );
+	b1 = float( db1 );
+	b2 = float( db2 );
+	a1 = float( da1 );
+	a2 = float( da2 );
+}
+
+BiquadBank::BiquadBank( size_t numChannels, size_t numSections )
+	: mNumChannels( 0 ), mNumSections( 0 ), mCoefficientsDirty( false ), mInterpolationEnabled( false ), mHasProcessed( false )
+{
+	setSize( numChannels, numSections );
+}
+
+void BiquadBank::setSize( size_t numChannels, size_t numSections )
+{
+	mNumChannels = numChannels;
+	mNumSections = numSections;
+
+	const size_t numGroups = ( numChannels + detail::BIQUAD_LANES - 1 ) / detail::BIQUAD_LANES;
+	mCoefficients.assign( numChannels * numSections, Coefficients() );
+	mLanes.resize( numGroups * numSections );
+	mFrames.assign( CHUNK_FRAMES * detail::BIQUAD_LANES, 0 );
+
+	// unused lanes of the last group stay pass-through and process silence
+	for( auto &lanes : mLanes ) {
+		memset( &lanes, 0, sizeof( lanes ) );
+		std::fill( begin( lanes.b0 ), end( lanes.b0 ), 1.0f );
+	}
+
+	mCoefficientsDirty = false;
+	mHasProcessed = false;
+}
+
+void BiquadBank::setCoefficients( size_t channel, size_t section, const Coefficients &coefficients )
+{
+	CI_ASSERT( channel < mNumChannels && section < mNumSections );
+
+	mCoefficients[channel * mNumSections + section] = coefficients;
+	mCoefficientsDirty = true;
+}
+
+void BiquadBank::setCoefficients( size_t section, const Coefficients &coefficients )
+{
+	for( size_t ch = 0; ch < mNumChannels; ch++ )
+		setCoefficients( ch, section, coefficients );
+}
+
+void BiquadBank::reset()
+{
+	for( auto &lanes : mLanes ) {
+		std::fill( begin( lanes.z1 ), end( lanes.z1 ), 0.0f );
+		std::fill( begin( lanes.z2 ), end( lanes.z2 ), 0.0f );
+	}
+
+	mHasProcessed = false;
+}
+
+void BiquadBank::updateLanes( bool interpolate, size_t numFrames )
+{
+	const float framesInv = interpolate ? 1.0f / float( numFrames ) : 0;
+
+	for( size_t ch = 0; ch < mNumChannels; ch++ ) {
+		const size_t group = ch / detail::BIQUAD_LANES;
+		const size_t l = ch % detail::BIQUAD_LANES;
+		for( size_t s = 0; s < mNumSections; s++ ) {
+			const auto &target = mCoefficients[ch * mNumSections + s];
+			auto &lanes = mLanes[group * mNumSections + s];
+			if( interpolate ) {
+				lanes.db0[l] = ( target.b0 - lanes.b0[l] ) * framesInv;
+				lanes.db1[l] = ( target.b1 - lanes.b1[l] ) * framesInv;
+				lanes.db2[l] = ( target.b2 - lanes.b2[l] ) * framesInv;
+				lanes.da1[l] = ( target.a1 - lanes.a1[l] ) * framesInv;
+				lanes.da2[l] = ( target.a2 - lanes.a2[l] ) * framesInv;
+			}
+			else {
+				lanes.b0[l] = target.b0;
+				lanes.b1[l] = target.b1;
+				lanes.b2[l] = target.b2;
+				lanes.a1[l] = target.a1;
+				lanes.a2[l] = target.a2;
+			}
+		}
+	}
+}
+
+void BiquadBank::process( Buffer *buffer )
+{
+	CI_ASSERT( buffer->getNumChannels() == mNumChannels );
+
+	const size_t numFrames = buffer->getNumFrames();
+	const bool interpolate = mCoefficientsDirty && mInterpolationEnabled && mHasProcessed && numFrames > 0;
+	if( mCoefficientsDirty )
+		updateLanes( interpolate, numFrames );
+
+	const auto &kernels = detail::getKernels();
+
+	for( size_t group = 0; group * detail::BIQUAD_LANES < mNumChannels; group++ ) {
+		const size_t firstChannel = group * detail::BIQUAD_LANES;
+		const size_t numGroupChannels = min( detail::BIQUAD_LANES, mNumChannels - firstChannel );
+		detail::BiquadLanes *sections = &mLanes[group * mNumSections];
+
+		for( size_t offset = 0; offset < numFrames; offset += CHUNK_FRAMES ) {
+			const size_t chunkFrames = min( CHUNK_FRAMES, numFrames - offset );
+
+			for( size_t l = 0; l < numGroupChannels; l++ ) {
+				const float *channel = buffer->getChannel( firstChannel + l ) + offset;
+				for( size_t i = 0; i < chunkFrames; i++ )
+					mFrames[i * detail::BIQUAD_LANES + l] = channel[i];
+			}
+
+			kernels.biquadLanes( mFrames.data(), chunkFrames, sections, mNumSections, interpolate );
+
+			for( size_t l = 0; l < numGroupChannels; l++ ) {
+				float *channel = buffer->getChannel( firstChannel + l ) + offset;
+				for( size_t i = 0; i < chunkFrames; i++ )
+					channel[i] = mFrames[i * detail::BIQUAD_LANES + l];
+			}
+		}
+	}
+
+	// land exactly on the targets, which the accumulated increments only approximate
+	if( interpolate )
+		updateLanes( false, 0 );
+
+	mCoefficientsDirty = false;
+	mHasProcessed = true;
+}
+
+} } } // namespace cinder::audio::dsp
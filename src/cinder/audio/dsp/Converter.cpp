@@ -23,6 +23,8 @@
 
 #include "cinder/audio/dsp/Converter.h"
 #include "cinder/audio/dsp/Dsp.h"
+#include "DspKernels.h"
+#include "cinder/audio/dsp/ConverterPolyphase.h"
 #include "cinder/audio/dsp/ConverterR8brain.h"
 #include "cinder/CinderAssert.h"
 
@@ -31,14 +33,18 @@
 #endif
 
 #include <algorithm>
+#include <cstring>
 
 using namespace ci;
 using namespace std;
 
 namespace cinder { namespace audio { namespace dsp {
 
-unique_ptr<Converter> Converter::create( size_t sourceSampleRate, size_t destSampleRate, size_t sourceNumChannels, size_t destNumChannels, size_t sourceMaxFramesPerBlock )
+unique_ptr<Converter> Converter::create( size_t sourceSampleRate, size_t destSampleRate, size_t sourceNumChannels, size_t destNumChannels, size_t sourceMaxFramesPerBlock, ConverterType type )
 {
+	if( type != ConverterType::DEFAULT )
+		return unique_ptr<Converter>( new ConverterImplPolyphase( sourceSampleRate, destSampleRate, sourceNumChannels, destNumChannels, sourceMaxFramesPerBlock, type ) );
+
 #if defined( CINDER_COCOA )
 	return unique_ptr<Converter>( new cocoa::ConverterImplCoreAudio( sourceSampleRate, destSampleRate, sourceNumChannels, destNumChannels, sourceMaxFramesPerBlock ) );
 #else
@@ -59,6 +65,78 @@ Converter::Converter( size_t sourceSampleRate, size_t destSampleRate, size_t sou
 	mDestMaxFramesPerBlock = (size_t)ceil( (float)mSourceMaxFramesPerBlock * (float)mDestSampleRate / (float)mSourceSampleRate );
 }
 
+// ----------------------------------------------------------------------------------------------------
+// float specializations, which use the SIMD kernels for the current SimdLevel when the layout is mono or stereo
+// ----------------------------------------------------------------------------------------------------
+
+void convert( const float *sourceArray, int16_t *destArray, size_t length )
+{
+	detail::getKernels().floatToInt16( sourceArray, destArray, length );
+}
+
+void convert( const int16_t *sourceArray, float *destArray, size_t length )
+{
+	detail::getKernels().int16ToFloat( sourceArray, destArray, length );
+}
+
+void convertInt24ToFloat( const char *sourceArray, float *destArray, size_t length )
+{
+	detail::getKernels().int24ToFloat( sourceArray, destArray, length );
+}
+
+void convertFloatToInt24( const float *sourceArray, char *destArray, size_t length )
+{
+	detail::getKernels().floatToInt24( sourceArray, destArray, length );
+}
+
+void interleave( const float *nonInterleavedSourceArray, float *interleavedDestArray, size_t numFramesPerChannel, size_t numChannels, size_t numCopyFrames )
+{
+	if( numChannels == 1 )
+		memmove( interleavedDestArray, nonInterleavedSourceArray, numCopyFrames * sizeof( float ) );
+	else if( numChannels == 2 )
+		detail::getKernels().interleaveStereo( nonInterleavedSourceArray, nonInterleavedSourceArray + numFramesPerChannel, interleavedDestArray, numCopyFrames );
+	else
+		interleave<float>( nonInterleavedSourceArray, interleavedDestArray, numFramesPerChannel, numChannels, numCopyFrames );
+}
+
+void interleave( const float *nonInterleavedFloatSourceArray, int16_t *interleavedInt16DestArray, size_t numFramesPerChannel, size_t numChannels, size_t numCopyFrames )
+{
+	if( numChannels == 1 )
+		detail::getKernels().floatToInt16( nonInterleavedFloatSourceArray, interleavedInt16DestArray, numCopyFrames );
+	else if( numChannels == 2 )
+		detail::getKernels().interleaveStereoInt16( nonInterleavedFloatSourceArray, nonInterleavedFloatSourceArray + numFramesPerChannel, interleavedInt16DestArray, numCopyFrames );
+	else
+		interleave<float>( nonInterleavedFloatSourceArray, interleavedInt16DestArray, numFramesPerChannel, numChannels, numCopyFrames );
+}
+
+void deinterleave( const float *interleavedSourceArray, float *nonInterleavedDestArray, size_t numFramesPerChannel, size_t numChannels, size_t numCopyFrames )
+{
+	if( numChannels == 1 )
+		memmove( nonInterleavedDestArray, interleavedSourceArray, numCopyFrames * sizeof( float ) );
+	else if( numChannels == 2 )
+		detail::getKernels().deinterleaveStereo( interleavedSourceArray, nonInterleavedDestArray, nonInterleavedDestArray + numFramesPerChannel, numCopyFrames );
+	else
+		deinterleave<float>( interleavedSourceArray, nonInterleavedDestArray, numFramesPerChannel, numChannels, numCopyFrames );
+}
+
+void deinterleave( const int16_t *interleavedInt16SourceArray, float *nonInterleavedFloatDestArray, size_t numFramesPerChannel, size_t numChannels, size_t numCopyFrames )
+{
+	if( numChannels == 1 )
+		detail::getKernels().int16ToFloat( interleavedInt16SourceArray, nonInterleavedFloatDestArray, numCopyFrames );
+	else if( numChannels == 2 )
+		detail::getKernels().deinterleaveStereoInt16( interleavedInt16SourceArray, nonInterleavedFloatDestArray, nonInterleavedFloatDestArray + numFramesPerChannel, numCopyFrames );
+	else
+		deinterleave<float>( interleavedInt16SourceArray, nonInterleavedFloatDestArray, numFramesPerChannel, numChannels, numCopyFrames );
+}
+
+void deinterleaveInt24ToFloat( const char *interleavedInt24SourceArray, float *nonInterleavedFloatDestArray, size_t numFramesPerChannel, size_t numChannels, size_t numCopyFrames )
+{
+	if( numChannels == 1 )
+		detail::getKernels().int24ToFloat( interleavedInt24SourceArray, nonInterleavedFloatDestArray, numCopyFrames );
+	else
+		deinterleaveInt24ToFloat<float>( interleavedInt24SourceArray, nonInterleavedFloatDestArray, numFramesPerChannel, numChannels, numCopyFrames );
+}
+
 void mixBuffers( const Buffer *sourceBuffer, Buffer *destBuffer, size_t numFrames )
 {
 	size_t sourceChannels = sourceBuffer->getNumChannels();
@@ -0,0 +1,292 @@
+/*
+ Copyright (c) 2016, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cinder/audio/dsp/ConverterPolyphase.h"
+#include "cinder/audio/dsp/Dsp.h"
+#include "cinder/CinderAssert.h"
+#include "cinder/CinderMath.h"
+
+#include <cstring>
+
+using namespace std;
+
+namespace cinder { namespace audio { namespace dsp {
+
+namespace {
+
+struct PolyphasePreset {
+	size_t	mHalfLength;	// in source frames, when upsampling
+	float	mKaiserBeta;
+	float	mCutoff;		// as a fraction of the lower Nyquist frequency
+};
+
+// Kaiser's estimate of the stopband attenuation for a given beta is 8.7 + beta / 0.1102 dB.
+PolyphasePreset getPreset( ConverterType type )
+{
+	switch( type ) {
+		case ConverterType::POLYPHASE_FAST:		return { 8, 5.0f, 0.8f };
+		case ConverterType::POLYPHASE_MEDIUM:	return { 16, 7.0f, 0.88f };
+		case ConverterType::POLYPHASE_HIGH:		return { 32, 9.0f, 0.92f };
+		default: break;
+	}
+
+	CI_ASSERT_NOT_REACHABLE();
+	return { 16, 7.0f, 0.88f };
+}
+
+size_t gcd( size_t a, size_t b )
+{
+	while( b ) {
+		size_t t = a % b;
+		a = b;
+		b = t;
+	}
+
+	return a;
+}
+
+// Zeroth order modified Bessel function of the first kind, for the Kaiser window.
+double besselI0( double x )
+{
+	double result = 1;
+	double term = 1;
+	for( int k = 1; k < 50; k++ ) {
+		term *= ( x / ( 2 * k ) ) * ( x / ( 2 * k ) );
+		result += term;
+		if( term < result * 1e-12 )
+			break;
+	}
+
+	return result;
+}
+
+} // anonymous namespace
+
+ConverterImplPolyphase::ConverterImplPolyphase( size_t sourceSampleRate, size_t destSampleRate, size_t sourceNumChannels, size_t destNumChannels, size_t sourceMaxFramesPerBlock, ConverterType type )
+	: Converter( sourceSampleRate, destSampleRate, sourceNumChannels, destNumChannels, sourceMaxFramesPerBlock )
+{
+	size_t divisor = gcd( mSourceSampleRate, mDestSampleRate );
+	mUpsampleFactor = mDestSampleRate / divisor;
+	mDownsampleFactor = mSourceSampleRate / divisor;
+
+	// When downsampling the cutoff moves down, so the filter is stretched by the same ratio to keep its transition band in proportion.
+	// Rounding to a multiple of 8 taps keeps the dot products on whole SIMD registers.
+	auto preset = getPreset( type );
+	float downsampleRatio = max( 1.0f, (float)mDownsampleFactor / (float)mUpsampleFactor );
+	size_t halfLength = (size_t)ceil( preset.mHalfLength * downsampleRatio );
+	halfLength = ( halfLength + 3 ) & ~size_t( 3 );
+	designFilter( halfLength, preset.mKaiserBeta, preset.mCutoff / downsampleRatio );
+
+	size_t numResamplers;
+	if( mSourceNumChannels > mDestNumChannels ) {
+		// downmixing, resample dest channels -> source channels
+		numResamplers = mDestNumChannels;
+		mMixingBuffer = Buffer( mSourceMaxFramesPerBlock, mDestNumChannels );
+	}
+	else if( mSourceNumChannels < mDestNumChannels ) {
+		// upmixing, resample source channels
+		numResamplers = mSourceNumChannels;
+		mMixingBuffer = Buffer( mDestMaxFramesPerBlock, mSourceNumChannels );
+	}
+	else
+		numResamplers = mSourceNumChannels;
+
+	// after compactHistory() there are always less than mNumTaps frames left, so this fits one more block
+	mHistory = Buffer( mNumTaps + mSourceMaxFramesPerBlock, numResamplers );
+	clear();
+}
+
+void ConverterImplPolyphase::designFilter( size_t halfLength, float beta, float cutoff )
+{
+	mHalfLength = halfLength;
+	mNumTaps = halfLength * 2;
+	mNumPhases = min( mUpsampleFactor, MAX_NUM_PHASES );
+
+	// Row r holds the filter for an output that is r / mNumPhases source frames past the frame at tap mHalfLength - 1. The extra last
+	// row (a whole frame past) is only read when interpolating between rows.
+	mCoefficients.resize( ( mNumPhases + 1 ) * mNumTaps );
+	const double i0Beta = besselI0( beta );
+	for( size_t r = 0; r <= mNumPhases; r++ ) {
+		float *row = &mCoefficients[r * mNumTaps];
+		double rowSum = 0;
+		for( size_t j = 0; j < mNumTaps; j++ ) {
+			double t = (double)r / (double)mNumPhases + (double)mHalfLength - 1 - (double)j;
+			double x = M_PI * cutoff * t;
+			double sinc = fabs( x ) < 1e-9 ? 1 : sin( x ) / x;
+			double edge = t / (double)mHalfLength;
+			double window = besselI0( beta * sqrt( max( 0.0, 1 - edge * edge ) ) ) / i0Beta;
+
+			row[j] = float( cutoff * sinc * window );
+			rowSum += row[j];
+		}
+
+		// unity gain at DC for every phase, so that the truncated filter doesn't add a ripple at the upsampling rate
+		for( size_t j = 0; j < mNumTaps; j++ )
+			row[j] = float( row[j] / rowSum );
+	}
+}
+
+void ConverterImplPolyphase::clear()
+{
+	// Start with half a filter of silence, so that the first output is centered on the first source frame.
+	mHistory.zero();
+	mNumHistoryFrames = mHalfLength - 1;
+	mHistoryPos = 0;
+	mPhase = 0;
+	mFlushing = false;
+	mFlushEndPos = 0;
+}
+
+pair<size_t, size_t> ConverterImplPolyphase::convert( const Buffer *sourceBuffer, Buffer *destBuffer )
+{
+	CI_ASSERT( sourceBuffer->getNumChannels() == mSourceNumChannels && destBuffer->getNumChannels() == mDestNumChannels );
+	CI_ASSERT_MSG( ! mFlushing, "clear() must be called after flush()" );
+
+	size_t readCount = min( sourceBuffer->getNumFrames(), mSourceMaxFramesPerBlock );
+
+	// debug ensure that destBuffer is large enough
+	CI_ASSERT( destBuffer->getNumFrames() >= ( readCount * (float)mDestSampleRate / (float)mSourceSampleRate ) );
+
+	if( mSourceSampleRate == mDestSampleRate ) {
+		mixBuffers( sourceBuffer, destBuffer, readCount );
+		return make_pair( readCount, readCount );
+	}
+
+	// The history has room for a full source block on top of what a filter needs. If destBuffer couldn't take every output of a previous call,
+	// the frames they depend on are still held, so only as many source frames are read as fit. The caller sees this in the returned read count.
+	readCount = min( readCount, mHistory.getNumFrames() - mNumHistoryFrames );
+
+	size_t outCount;
+	if( mSourceNumChannels > mDestNumChannels ) {
+		mixBuffers( sourceBuffer, &mMixingBuffer, readCount );
+		appendHistory( &mMixingBuffer, readCount );
+		outCount = resample( destBuffer, destBuffer->getNumFrames(), numeric_limits<size_t>::max() );
+	}
+	else if( mSourceNumChannels < mDestNumChannels ) {
+		appendHistory( sourceBuffer, readCount );
+		outCount = resample( &mMixingBuffer, min( mMixingBuffer.getNumFrames(), destBuffer->getNumFrames() ), numeric_limits<size_t>::max() );
+		mixBuffers( &mMixingBuffer, destBuffer, outCount );
+	}
+	else {
+		appendHistory( sourceBuffer, readCount );
+		outCount = resample( destBuffer, destBuffer->getNumFrames(), numeric_limits<size_t>::max() );
+	}
+
+	compactHistory();
+	return make_pair( readCount, outCount );
+}
+
+size_t ConverterImplPolyphase::flush( Buffer *destBuffer )
+{
+	CI_ASSERT( destBuffer->getNumChannels() == mDestNumChannels );
+
+	if( mSourceSampleRate == mDestSampleRate )
+		return 0;
+
+	if( ! mFlushing ) {
+		// Outputs that are centered (at history frame mHistoryPos + mHalfLength - 1) before the end of the source are still owed. The furthest
+		// one reaches half a filter past the end, which is padded with silence.
+		mFlushing = true;
+		mFlushEndPos = mNumHistoryFrames + 1 > mHalfLength ? mNumHistoryFrames + 1 - mHalfLength : 0;
+		for( size_t ch = 0; ch < mHistory.getNumChannels(); ch++ )
+			fill( 0.0f, mHistory.getChannel( ch ) + mNumHistoryFrames, mHalfLength );
+
+		mNumHistoryFrames += mHalfLength;
+	}
+
+	size_t outCount;
+	if( mSourceNumChannels < mDestNumChannels ) {
+		outCount = resample( &mMixingBuffer, min( mMixingBuffer.getNumFrames(), destBuffer->getNumFrames() ), mFlushEndPos );
+		mixBuffers( &mMixingBuffer, destBuffer, outCount );
+	}
+	else
+		outCount = resample( destBuffer, destBuffer->getNumFrames(), mFlushEndPos );
+
+	compactHistory();
+	return outCount;
+}
+
+void ConverterImplPolyphase::appendHistory( const Buffer *buffer, size_t numFrames )
+{
+	// convert() limits numFrames to the space that is left
+	CI_ASSERT( mNumHistoryFrames + numFrames <= mHistory.getNumFrames() );
+
+	for( size_t ch = 0; ch < mHistory.getNumChannels(); ch++ )
+		memcpy( mHistory.getChannel( ch ) + mNumHistoryFrames, buffer->getChannel( ch ), numFrames * sizeof( float ) );
+
+	mNumHistoryFrames += numFrames;
+}
+
+size_t ConverterImplPolyphase::resample( Buffer *destBuffer, size_t maxFrames, size_t endPos )
+{
+	const size_t numChannels = mHistory.getNumChannels();
+	const bool interpolate = mNumPhases != mUpsampleFactor;
+
+	size_t numFrames = 0;
+	while( numFrames < maxFrames && mHistoryPos + mNumTaps <= mNumHistoryFrames && mHistoryPos < endPos ) {
+		if( ! interpolate ) {
+			const float *coefficients = &mCoefficients[mPhase * mNumTaps];
+			for( size_t ch = 0; ch < numChannels; ch++ )
+				destBuffer->getChannel( ch )[numFrames] = dot( mHistory.getChannel( ch ) + mHistoryPos, coefficients, mNumTaps );
+		}
+		else {
+			uint64_t tablePos = mPhase * mNumPhases;
+			size_t row = size_t( tablePos / mUpsampleFactor );
+			float frac = float( tablePos % mUpsampleFactor ) / (float)mUpsampleFactor;
+			const float *coefficients = &mCoefficients[row * mNumTaps];
+			for( size_t ch = 0; ch < numChannels; ch++ ) {
+				const float *history = mHistory.getChannel( ch ) + mHistoryPos;
+				float a = dot( history, coefficients, mNumTaps );
+				float b = dot( history, coefficients + mNumTaps, mNumTaps );
+				destBuffer->getChannel( ch )[numFrames] = a + frac * ( b - a );
+			}
+		}
+
+		numFrames++;
+		mPhase += mDownsampleFactor;
+		mHistoryPos += size_t( mPhase / mUpsampleFactor );
+		mPhase %= mUpsampleFactor;
+	}
+
+	return numFrames;
+}
+
+void ConverterImplPolyphase::compactHistory()
+{
+	// When downsampling, the next output can start past the end of the history. The difference stays in mHistoryPos, so that frames are skipped as they arrive.
+	size_t shift = min( mHistoryPos, mNumHistoryFrames );
+	if( shift == 0 )
+		return;
+
+	size_t numRemaining = mNumHistoryFrames - shift;
+	for( size_t ch = 0; ch < mHistory.getNumChannels(); ch++ ) {
+		float *channel = mHistory.getChannel( ch );
+		memmove( channel, channel + shift, numRemaining * sizeof( float ) );
+	}
+
+	mNumHistoryFrames = numRemaining;
+	mHistoryPos -= shift;
+	mFlushEndPos -= min( shift, mFlushEndPos );
+}
+
+} } } // namespace cinder::audio::dsp
@@ -22,6 +22,7 @@
 */
 
 #include "cinder/audio/dsp/Dsp.h"
+#include "DspKernels.h"
 
 #include "cinder/CinderMath.h"
 
@@ -111,6 +112,13 @@ float sum( const float *array, size_t length )
 	return result;
 }
 
+float dot( const float *arrayA, const float *arrayB, size_t length )
+{
+	float result;
+	vDSP_dotpr( arrayA, 1, arrayB, 1, &result, length );
+	return result;
+}
+
 void add( const float *array, float scalar, float *result, size_t length )
 {
 	vDSP_vsadd( const_cast<float *>( array ), 1, &scalar, result, 1, length );
@@ -164,67 +172,72 @@ void addMul( const float *arrayA, const float *arrayB, float scalar, float *resu
 	vDSP_vasm( const_cast<float *>( arrayA ), 1, const_cast<float *>( arrayB ), 1, &scalar, result, 1, length );
 }
 
+void mulAdd( const float *array, float scalar, const float *addend, float *result, size_t length )
+{
+	vDSP_vsma( array, 1, &scalar, addend, 1, result, 1, length );
+}
+
+void complexMulAdd( const float *realA, const float *imagA, const float *realB, const float *imagB, float *realResult, float *imagResult, size_t length )
+{
+	DSPSplitComplex a = { const_cast<float *>( realA ), const_cast<float *>( imagA ) };
+	DSPSplitComplex b = { const_cast<float *>( realB ), const_cast<float *>( imagB ) };
+	DSPSplitComplex result = { realResult, imagResult };
+	vDSP_zvma( &a, 1, &b, 1, &result, 1, &result, 1, length );
+}
+
 #else // ! defined( CINDER_AUDIO_VDSP )
 
+// These dispatch to the SIMD implementations for the current SimdLevel, see DspKernels.cpp.
+
 void fill( float value, float *array, size_t length )
 {
-	for( size_t i = 0; i < length; i++ )
-		array[i] = value;
+	detail::getKernels().fill( value, array, length );
 }
 
 float sum( const float *array, size_t length )
 {
-	float result( 0.0f );
-	for( size_t i = 0; i < length; i++ )
-		result += array[i];
-	return result;
+	return detail::getKernels().sum( array, length );
+}
+
+float dot( const float *arrayA, const float *arrayB, size_t length )
+{
+	return detail::getKernels().dot( arrayA, arrayB, length );
 }
 
 void add( const float *array, float scalar, float *result, size_t length )
 {
-	for( size_t i = 0; i < length; i++ )
-		result[i] = array[i] + scalar;
+	detail::getKernels().addScalar( array, scalar, result, length );
 }
 
 void add( const float *arrayA, const float *arrayB, float *result, size_t length )
 {
-	for( size_t i = 0; i < length; i++ )
-		result[i] = arrayA[i] + arrayB[i];
+	detail::getKernels().add( arrayA, arrayB, result, length );
 }
 
 void sub( const float *array, float scalar, float *result, size_t length )
 {
-	for( size_t i = 0; i < length; i++ )
-		result[i] = array[i] - scalar;
+	detail::getKernels().addScalar( array, -scalar, result, length );
 }
 
 void sub( const float *arrayA, const float *arrayB, float *result, size_t length )
 {
-	for( size_t i = 0; i < length; i++ )
-		result[i] = arrayA[i] - arrayB[i];
+	detail::getKernels().sub( arrayA, arrayB, result, length );
 }
 
 float rms( const float *array, size_t length )
 {
-	float sumSquared( 0.0f );
-	for( size_t i = 0; i < length; i++ ) {
-		float val = array[i];
-		sumSquared += val * val;
-	}
-
+	float sumSquared = detail::getKernels().sumOfSquares( array, length );
 	return math<float>::sqrt( sumSquared / (float)length );
 }
 
 void mul( const float *array, float scalar, float *result, size_t length )
 {
-	for( size_t i = 0; i < length; i++ )
-		result[i] = array[i] * scalar;
+	detail::getKernels().mulScalar( array, scalar, result, length );
 }
 
 void mul( const float *arrayA, const float *arrayB, float *result, size_t length )
 {
-	for( size_t i = 0; i < length; i++ )
-		result[i] = arrayA[i] * arrayB[i];
+	detail::getKernels().mul( arrayA, arrayB, result, length );
 }
 
 void divide( const float *array, float scalar, float *result, size_t length )
@@ -240,20 +253,24 @@ void divide( const float *arrayA, const float *arrayB, float *result, size_t len
 
 void addMul( const float *arrayA, const float *arrayB, float scalar, float *result, size_t length )
 {
-	for( size_t i = 0; i < length; i++ )
-		result[i] = ( arrayA[i] + arrayB[i] ) * scalar;
+	detail::getKernels().addMul( arrayA, arrayB, scalar, result, length );
+}
+
+void mulAdd( const float *array, float scalar, const float *addend, float *result, size_t length )
+{
+	detail::getKernels().mulAdd( array, scalar, addend, result, length );
+}
+
+void complexMulAdd( const float *realA, const float *imagA, const float *realB, const float *imagB, float *realResult, float *imagResult, size_t length )
+{
+	detail::getKernels().complexMulAdd( realA, imagA, realB, imagB, realResult, imagResult, length );
 }
 
 #endif // ! defined( CINDER_AUDIO_VDSP )
 
 void normalize( float *array, size_t length, float maxValue )
 {
-	float max = 0;
-	for( size_t i = 0; i < length; i++ ) {
-		if( max < array[i] )
-			max = array[i];
-	}
-
+	float max = detail::getKernels().max( array, length );
 	if( max > 0.00001f ) {
 		mul( array, maxValue / max, array, length );
 	}
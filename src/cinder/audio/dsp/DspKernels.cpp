@@ -0,0 +1,1296 @@
+/*
+ Copyright (c) 2016, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "DspKernels.h"
+#include "cinder/System.h"
+
+#include <algorithm>
+#include <atomic>
+
+#if defined( __i386__ ) || defined( __x86_64__ ) || defined( _M_IX86 ) || defined( _M_X64 )
+	#define CINDER_DSP_X86
+	#include <immintrin.h>
+#elif defined( __ARM_NEON ) || defined( __ARM_NEON__ ) || defined( _M_ARM64 )
+	#define CINDER_DSP_NEON
+	#include <arm_neon.h>
+#endif
+
+// The x86 kernels are selected at runtime, so rather than enabling AVX2 (or SSE2 on 32-bit x86) for the whole build, it is enabled per function.
+#if defined( CINDER_DSP_X86 ) && ( defined( __GNUC__ ) || defined( __clang__ ) )
+	#define CINDER_DSP_TARGET_SSE2 __attribute__(( target( "sse2" ) ))
+	#define CINDER_DSP_TARGET_AVX2 __attribute__(( target( "avx2" ) ))
+#else
+	#define CINDER_DSP_TARGET_SSE2
+	#define CINDER_DSP_TARGET_AVX2
+#endif
+
+using namespace std;
+
+namespace cinder { namespace audio { namespace dsp {
+
+namespace {
+
+const float FLOAT_TO_INT16 = 32768;
+const float INT16_TO_FLOAT = 3.0517578125e-05f;	// 1.0 / 32768.0
+const float INT16_MAX_FLOAT = 32767;
+const float FLOAT_TO_INT24 = 8388607;
+const float INT24_TO_FLOAT = 1.0f / 8388607.0f;
+
+// ----------------------------------------------------------------------------------------------------
+// Scalar reference
+// ----------------------------------------------------------------------------------------------------
+
+namespace scalar {
+
+struct AddOp { static float apply( float a, float b ) { return a + b; } };
+struct SubOp { static float apply( float a, float b ) { return a - b; } };
+struct MulOp { static float apply( float a, float b ) { return a * b; } };
+
+template <typename OpT>
+void binary( const float *arrayA, const float *arrayB, float *result, size_t length )
+{
+	for( size_t i = 0; i < length; i++ )
+		result[i] = OpT::apply( arrayA[i], arrayB[i] );
+}
+
+template <typename OpT>
+void binaryScalar( const float *array, float scalar, float *result, size_t length )
+{
+	for( size_t i = 0; i < length; i++ )
+		result[i] = OpT::apply( array[i], scalar );
+}
+
+void fill( float value, float *array, size_t length )
+{
+	for( size_t i = 0; i < length; i++ )
+		array[i] = value;
+}
+
+void addMul( const float *arrayA, const float *arrayB, float scalar, float *result, size_t length )
+{
+	for( size_t i = 0; i < length; i++ )
+		result[i] = ( arrayA[i] + arrayB[i] ) * scalar;
+}
+
+void mulAdd( const float *array, float scalar, const float *addend, float *result, size_t length )
+{
+	for( size_t i = 0; i < length; i++ )
+		result[i] = array[i] * scalar + addend[i];
+}
+
+float sum( const float *array, size_t length )
+{
+	float result = 0;
+	for( size_t i = 0; i < length; i++ )
+		result += array[i];
+	return result;
+}
+
+float sumOfSquares( const float *array, size_t length )
+{
+	float result = 0;
+	for( size_t i = 0; i < length; i++ )
+		result += array[i] * array[i];
+	return result;
+}
+
+float dot( const float *arrayA, const float *arrayB, size_t length )
+{
+	float result = 0;
+	for( size_t i = 0; i < length; i++ )
+		result += arrayA[i] * arrayB[i];
+	return result;
+}
+
+float max( const float *array, size_t length )
+{
+	float result = 0;
+	for( size_t i = 0; i < length; i++ ) {
+		if( result < array[i] )
+			result = array[i];
+	}
+	return result;
+}
+
+inline int16_t floatToInt16( float sample )
+{
+	return int16_t( std::max( std::min( sample * FLOAT_TO_INT16, INT16_MAX_FLOAT ), -FLOAT_TO_INT16 ) );
+}
+
+inline int32_t int24ToInt32( const char *sample )
+{
+	return (int32_t)( ( (int32_t)(int8_t)sample[2] ) << 16 ) | ( ( (int32_t)(uint8_t)sample[1] ) << 8 ) | ( (int32_t)(uint8_t)sample[0] );
+}
+
+void floatToInt16( const float *sourceArray, int16_t *destArray, size_t length )
+{
+	for( size_t i = 0; i < length; i++ )
+		destArray[i] = floatToInt16( sourceArray[i] );
+}
+
+void int16ToFloat( const int16_t *sourceArray, float *destArray, size_t length )
+{
+	for( size_t i = 0; i < length; i++ )
+		destArray[i] = (float)sourceArray[i] * INT16_TO_FLOAT;
+}
+
+void floatToInt24( const float *sourceArray, char *destArray, size_t length )
+{
+	for( size_t i = 0; i < length; i++ ) {
+		int32_t sample = int32_t( sourceArray[i] * FLOAT_TO_INT24 );
+		*(destArray++) = (char)( sample & 255 );
+		*(destArray++) = (char)( ( sample >> 8 ) & 255 );
+		*(destArray++) = (char)( ( sample >> 16 ) & 255 );
+	}
+}
+
+void int24ToFloat( const char *sourceArray, float *destArray, size_t length )
+{
+	for( size_t i = 0; i < length; i++ )
+		destArray[i] = (float)int24ToInt32( sourceArray + i * 3 ) * INT24_TO_FLOAT;
+}
+
+void interleaveStereo( const float *left, const float *right, float *interleaved, size_t numFrames )
+{
+	for( size_t i = 0; i < numFrames; i++ ) {
+		interleaved[i * 2] = left[i];
+		interleaved[i * 2 + 1] = right[i];
+	}
+}
+
+void deinterleaveStereo( const float *interleaved, float *left, float *right, size_t numFrames )
+{
+	for( size_t i = 0; i < numFrames; i++ ) {
+		left[i] = interleaved[i * 2];
+		right[i] = interleaved[i * 2 + 1];
+	}
+}
+
+void interleaveStereoInt16( const float *left, const float *right, int16_t *interleaved, size_t numFrames )
+{
+	for( size_t i = 0; i < numFrames; i++ ) {
+		interleaved[i * 2] = floatToInt16( left[i] );
+		interleaved[i * 2 + 1] = floatToInt16( right[i] );
+	}
+}
+
+void deinterleaveStereoInt16( const int16_t *interleaved, float *left, float *right, size_t numFrames )
+{
+	for( size_t i = 0; i < numFrames; i++ ) {
+		left[i] = (float)interleaved[i * 2] * INT16_TO_FLOAT;
+		right[i] = (float)interleaved[i * 2 + 1] * INT16_TO_FLOAT;
+	}
+}
+
+void complexMulAdd( const float *realA, const float *imagA, const float *realB, const float *imagB, float *realResult, float *imagResult, size_t length )
+{
+	for( size_t i = 0; i < length; i++ ) {
+		const float ar = realA[i], ai = imagA[i], br = realB[i], bi = imagB[i];
+		realResult[i] += ar * br - ai * bi;
+		imagResult[i] += ar * bi + ai * br;
+	}
+}
+
+void biquadLanes( float *frames, size_t numFrames, detail::BiquadLanes *sections, size_t numSections, bool interpolate )
+{
+	const size_t lanes = detail::BIQUAD_LANES;
+
+	// sections are processed one at a time over the whole chunk, so that each one's coefficients and state stay in registers
+	for( size_t s = 0; s < numSections; s++ ) {
+		auto &section = sections[s];
+		for( size_t i = 0; i < numFrames; i++ ) {
+			float *frame = frames + i * lanes;
+			for( size_t l = 0; l < lanes; l++ ) {
+				float x = frame[l];
+				float y = section.b0[l] * x + section.z1[l];
+				section.z1[l] = section.b1[l] * x - section.a1[l] * y + section.z2[l];
+				section.z2[l] = section.b2[l] * x - section.a2[l] * y;
+				frame[l] = y;
+			}
+
+			if( interpolate ) {
+				for( size_t l = 0; l < lanes; l++ ) {
+					section.b0[l] += section.db0[l];
+					section.b1[l] += section.db1[l];
+					section.b2[l] += section.db2[l];
+					section.a1[l] += section.da1[l];
+					section.a2[l] += section.da2[l];
+				}
+			}
+		}
+	}
+}
+
+} // namespace scalar
+
+#if defined( CINDER_DSP_X86 )
+
+// ----------------------------------------------------------------------------------------------------
+// SSE2
+// ----------------------------------------------------------------------------------------------------
+
+namespace sse2 {
+
+struct AddOp { typedef scalar::AddOp ScalarOp; CINDER_DSP_TARGET_SSE2 static __m128 apply( __m128 a, __m128 b ) { return _mm_add_ps( a, b ); } };
+struct SubOp { typedef scalar::SubOp ScalarOp; CINDER_DSP_TARGET_SSE2 static __m128 apply( __m128 a, __m128 b ) { return _mm_sub_ps( a, b ); } };
+struct MulOp { typedef scalar::MulOp ScalarOp; CINDER_DSP_TARGET_SSE2 static __m128 apply( __m128 a, __m128 b ) { return _mm_mul_ps( a, b ); } };
+
+CINDER_DSP_TARGET_SSE2 inline float horizontalSum( __m128 v )
+{
+	__m128 shuffled = _mm_shuffle_ps( v, v, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+	__m128 sums = _mm_add_ps( v, shuffled );
+	shuffled = _mm_movehl_ps( shuffled, sums );
+	return _mm_cvtss_f32( _mm_add_ss( sums, shuffled ) );
+}
+
+CINDER_DSP_TARGET_SSE2 inline float horizontalMax( __m128 v )
+{
+	__m128 shuffled = _mm_shuffle_ps( v, v, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+	__m128 maxes = _mm_max_ps( v, shuffled );
+	shuffled = _mm_movehl_ps( shuffled, maxes );
+	return _mm_cvtss_f32( _mm_max_ss( maxes, shuffled ) );
+}
+
+// scales, clamps and truncates 4 samples to int32, ready to be packed to int16 with saturation
+CINDER_DSP_TARGET_SSE2 inline __m128i floatToInt16( __m128 samples )
+{
+	__m128 scaled = _mm_mul_ps( samples, _mm_set1_ps( FLOAT_TO_INT16 ) );
+	scaled = _mm_max_ps( _mm_min_ps( scaled, _mm_set1_ps( INT16_MAX_FLOAT ) ), _mm_set1_ps( -FLOAT_TO_INT16 ) );
+	return _mm_cvttps_epi32( scaled );
+}
+
+template <typename OpT>
+CINDER_DSP_TARGET_SSE2 void binary( const float *arrayA, const float *arrayB, float *result, size_t length )
+{
+	size_t i = 0;
+	for( ; i + 4 <= length; i += 4 )
+		_mm_storeu_ps( result + i, OpT::apply( _mm_loadu_ps( arrayA + i ), _mm_loadu_ps( arrayB + i ) ) );
+
+	scalar::binary<typename OpT::ScalarOp>( arrayA + i, arrayB + i, result + i, length - i );
+}
+
+template <typename OpT>
+CINDER_DSP_TARGET_SSE2 void binaryScalar( const float *array, float scalar, float *result, size_t length )
+{
+	const __m128 scalarVec = _mm_set1_ps( scalar );
+	size_t i = 0;
+	for( ; i + 4 <= length; i += 4 )
+		_mm_storeu_ps( result + i, OpT::apply( _mm_loadu_ps( array + i ), scalarVec ) );
+
+	scalar::binaryScalar<typename OpT::ScalarOp>( array + i, scalar, result + i, length - i );
+}
+
+CINDER_DSP_TARGET_SSE2 void fill( float value, float *array, size_t length )
+{
+	const __m128 valueVec = _mm_set1_ps( value );
+	size_t i = 0;
+	for( ; i + 4 <= length; i += 4 )
+		_mm_storeu_ps( array + i, valueVec );
+
+	scalar::fill( value, array + i, length - i );
+}
+
+CINDER_DSP_TARGET_SSE2 void addMul( const float *arrayA, const float *arrayB, float scalar, float *result, size_t length )
+{
+	const __m128 scalarVec = _mm_set1_ps( scalar );
+	size_t i = 0;
+	for( ; i + 4 <= length; i += 4 )
+		_mm_storeu_ps( result + i, _mm_mul_ps( _mm_add_ps( _mm_loadu_ps( arrayA + i ), _mm_loadu_ps( arrayB + i ) ), scalarVec ) );
+
+	scalar::addMul( arrayA + i, arrayB + i, scalar, result + i, length - i );
+}
+
+CINDER_DSP_TARGET_SSE2 void mulAdd( const float *array, float scalar, const float *addend, float *result, size_t length )
+{
+	const __m128 scalarVec = _mm_set1_ps( scalar );
+	size_t i = 0;
+	for( ; i + 4 <= length; i += 4 )
+		_mm_storeu_ps( result + i, _mm_add_ps( _mm_mul_ps( _mm_loadu_ps( array + i ), scalarVec ), _mm_loadu_ps( addend + i ) ) );
+
+	scalar::mulAdd( array + i, scalar, addend + i, result + i, length - i );
+}
+
+CINDER_DSP_TARGET_SSE2 float sum( const float *array, size_t length )
+{
+	__m128 sums = _mm_setzero_ps();
+	size_t i = 0;
+	for( ; i + 4 <= length; i += 4 )
+		sums = _mm_add_ps( sums, _mm_loadu_ps( array + i ) );
+
+	return horizontalSum( sums ) + scalar::sum( array + i, length - i );
+}
+
+CINDER_DSP_TARGET_SSE2 float sumOfSquares( const float *array, size_t length )
+{
+	__m128 sums = _mm_setzero_ps();
+	size_t i = 0;
+	for( ; i + 4 <= length; i += 4 ) {
+		__m128 v = _mm_loadu_ps( array + i );
+		sums = _mm_add_ps( sums, _mm_mul_ps( v, v ) );
+	}
+
+	return horizontalSum( sums ) + scalar::sumOfSquares( array + i, length - i );
+}
+
+CINDER_DSP_TARGET_SSE2 float dot( const float *arrayA, const float *arrayB, size_t length )
+{
+	// two accumulators hide the latency of the adds
+	__m128 sums0 = _mm_setzero_ps();
+	__m128 sums1 = _mm_setzero_ps();
+	size_t i = 0;
+	for( ; i + 8 <= length; i += 8 ) {
+		sums0 = _mm_add_ps( sums0, _mm_mul_ps( _mm_loadu_ps( arrayA + i ), _mm_loadu_ps( arrayB + i ) ) );
+		sums1 = _mm_add_ps( sums1, _mm_mul_ps( _mm_loadu_ps( arrayA + i + 4 ), _mm_loadu_ps( arrayB + i + 4 ) ) );
+	}
+	for( ; i + 4 <= length; i += 4 )
+		sums0 = _mm_add_ps( sums0, _mm_mul_ps( _mm_loadu_ps( arrayA + i ), _mm_loadu_ps( arrayB + i ) ) );
+
+	return horizontalSum( _mm_add_ps( sums0, sums1 ) ) + scalar::dot( arrayA + i, arrayB + i, length - i );
+}
+
+CINDER_DSP_TARGET_SSE2 float max( const float *array, size_t length )
+{
+	__m128 maxes = _mm_setzero_ps();
+	size_t i = 0;
+	for( ; i + 4 <= length; i += 4 )
+		maxes = _mm_max_ps( maxes, _mm_loadu_ps( array + i ) );
+
+	return std::max( horizontalMax( maxes ), scalar::max( array + i, length - i ) );
+}
+
+CINDER_DSP_TARGET_SSE2 void floatToInt16( const float *sourceArray, int16_t *destArray, size_t length )
+{
+	size_t i = 0;
+	for( ; i + 8 <= length; i += 8 ) {
+		__m128i low = floatToInt16( _mm_loadu_ps( sourceArray + i ) );
+		__m128i high = floatToInt16( _mm_loadu_ps( sourceArray + i + 4 ) );
+		_mm_storeu_si128( (__m128i *)( destArray + i ), _mm_packs_epi32( low, high ) );
+	}
+
+	scalar::floatToInt16( sourceArray + i, destArray + i, length - i );
+}
+
+CINDER_DSP_TARGET_SSE2 void int16ToFloat( const int16_t *sourceArray, float *destArray, size_t length )
+{
+	const __m128 normalizer = _mm_set1_ps( INT16_TO_FLOAT );
+	size_t i = 0;
+	for( ; i + 8 <= length; i += 8 ) {
+		__m128i samples = _mm_loadu_si128( (const __m128i *)( sourceArray + i ) );
+		// sign extend by placing each sample in the high half of a 32-bit lane, then shifting it down
+		__m128i low = _mm_srai_epi32( _mm_unpacklo_epi16( samples, samples ), 16 );
+		__m128i high = _mm_srai_epi32( _mm_unpackhi_epi16( samples, samples ), 16 );
+		_mm_storeu_ps( destArray + i, _mm_mul_ps( _mm_cvtepi32_ps( low ), normalizer ) );
+		_mm_storeu_ps( destArray + i + 4, _mm_mul_ps( _mm_cvtepi32_ps( high ), normalizer ) );
+	}
+
+	scalar::int16ToFloat( sourceArray + i, destArray + i, length - i );
+}
+
+CINDER_DSP_TARGET_SSE2 void interleaveStereo( const float *left, const float *right, float *interleaved, size_t numFrames )
+{
+	size_t i = 0;
+	for( ; i + 4 <= numFrames; i += 4 ) {
+		__m128 l = _mm_loadu_ps( left + i );
+		__m128 r = _mm_loadu_ps( right + i );
+		_mm_storeu_ps( interleaved + i * 2, _mm_unpacklo_ps( l, r ) );
+		_mm_storeu_ps( interleaved + i * 2 + 4, _mm_unpackhi_ps( l, r ) );
+	}
+
+	scalar::interleaveStereo( left + i, right + i, interleaved + i * 2, numFrames - i );
+}
+
+CINDER_DSP_TARGET_SSE2 void deinterleaveStereo( const float *interleaved, float *left, float *right, size_t numFrames )
+{
+	size_t i = 0;
+	for( ; i + 4 <= numFrames; i += 4 ) {
+		__m128 a = _mm_loadu_ps( interleaved + i * 2 );
+		__m128 b = _mm_loadu_ps( interleaved + i * 2 + 4 );
+		_mm_storeu_ps( left + i, _mm_shuffle_ps( a, b, _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+		_mm_storeu_ps( right + i, _mm_shuffle_ps( a, b, _MM_SHUFFLE( 3, 1, 3, 1 ) ) );
+	}
+
+	scalar::deinterleaveStereo( interleaved + i * 2, left + i, right + i, numFrames - i );
+}
+
+CINDER_DSP_TARGET_SSE2 void interleaveStereoInt16( const float *left, const float *right, int16_t *interleaved, size_t numFrames )
+{
+	size_t i = 0;
+	for( ; i + 8 <= numFrames; i += 8 ) {
+		__m128i l = _mm_packs_epi32( floatToInt16( _mm_loadu_ps( left + i ) ), floatToInt16( _mm_loadu_ps( left + i + 4 ) ) );
+		__m128i r = _mm_packs_epi32( floatToInt16( _mm_loadu_ps( right + i ) ), floatToInt16( _mm_loadu_ps( right + i + 4 ) ) );
+		_mm_storeu_si128( (__m128i *)( interleaved + i * 2 ), _mm_unpacklo_epi16( l, r ) );
+		_mm_storeu_si128( (__m128i *)( interleaved + i * 2 + 8 ), _mm_unpackhi_epi16( l, r ) );
+	}
+
+	scalar::interleaveStereoInt16( left + i, right + i, interleaved + i * 2, numFrames - i );
+}
+
+CINDER_DSP_TARGET_SSE2 void deinterleaveStereoInt16( const int16_t *interleaved, float *left, float *right, size_t numFrames )
+{
+	const __m128 normalizer = _mm_set1_ps( INT16_TO_FLOAT );
+	size_t i = 0;
+	for( ; i + 4 <= numFrames; i += 4 ) {
+		// each 32-bit lane holds one frame, left in the low half and right in the high half
+		__m128i frames = _mm_loadu_si128( (const __m128i *)( interleaved + i * 2 ) );
+		__m128i l = _mm_srai_epi32( _mm_slli_epi32( frames, 16 ), 16 );
+		__m128i r = _mm_srai_epi32( frames, 16 );
+		_mm_storeu_ps( left + i, _mm_mul_ps( _mm_cvtepi32_ps( l ), normalizer ) );
+		_mm_storeu_ps( right + i, _mm_mul_ps( _mm_cvtepi32_ps( r ), normalizer ) );
+	}
+
+	scalar::deinterleaveStereoInt16( interleaved + i * 2, left + i, right + i, numFrames - i );
+}
+
+CINDER_DSP_TARGET_SSE2 void complexMulAdd( const float *realA, const float *imagA, const float *realB, const float *imagB, float *realResult, float *imagResult, size_t length )
+{
+	size_t i = 0;
+	for( ; i + 4 <= length; i += 4 ) {
+		__m128 ar = _mm_loadu_ps( realA + i ), ai = _mm_loadu_ps( imagA + i );
+		__m128 br = _mm_loadu_ps( realB + i ), bi = _mm_loadu_ps( imagB + i );
+		__m128 real = _mm_sub_ps( _mm_mul_ps( ar, br ), _mm_mul_ps( ai, bi ) );
+		__m128 imag = _mm_add_ps( _mm_mul_ps( ar, bi ), _mm_mul_ps( ai, br ) );
+		_mm_storeu_ps( realResult + i, _mm_add_ps( _mm_loadu_ps( realResult + i ), real ) );
+		_mm_storeu_ps( imagResult + i, _mm_add_ps( _mm_loadu_ps( imagResult + i ), imag ) );
+	}
+
+	scalar::complexMulAdd( realA + i, imagA + i, realB + i, imagB + i, realResult + i, imagResult + i, length - i );
+}
+
+CINDER_DSP_TARGET_SSE2 void biquadLanes( float *frames, size_t numFrames, detail::BiquadLanes *sections, size_t numSections, bool interpolate )
+{
+	const size_t lanes = detail::BIQUAD_LANES;
+
+	for( size_t s = 0; s < numSections; s++ ) {
+		auto &section = sections[s];
+		// each half of the lanes is processed separately, as the registers won't hold both
+		for( size_t h = 0; h < lanes; h += 4 ) {
+			__m128 b0 = _mm_loadu_ps( section.b0 + h ), b1 = _mm_loadu_ps( section.b1 + h ), b2 = _mm_loadu_ps( section.b2 + h );
+			__m128 a1 = _mm_loadu_ps( section.a1 + h ), a2 = _mm_loadu_ps( section.a2 + h );
+			__m128 z1 = _mm_loadu_ps( section.z1 + h ), z2 = _mm_loadu_ps( section.z2 + h );
+
+			for( size_t i = 0; i < numFrames; i++ ) {
+				float *frame = frames + i * lanes + h;
+				__m128 x = _mm_loadu_ps( frame );
+				__m128 y = _mm_add_ps( _mm_mul_ps( b0, x ), z1 );
+				z1 = _mm_add_ps( _mm_sub_ps( _mm_mul_ps( b1, x ), _mm_mul_ps( a1, y ) ), z2 );
+				z2 = _mm_sub_ps( _mm_mul_ps( b2, x ), _mm_mul_ps( a2, y ) );
+				_mm_storeu_ps( frame, y );
+
+				if( interpolate ) {
+					b0 = _mm_add_ps( b0, _mm_loadu_ps( section.db0 + h ) );
+					b1 = _mm_add_ps( b1, _mm_loadu_ps( section.db1 + h ) );
+					b2 = _mm_add_ps( b2, _mm_loadu_ps( section.db2 + h ) );
+					a1 = _mm_add_ps( a1, _mm_loadu_ps( section.da1 + h ) );
+					a2 = _mm_add_ps( a2, _mm_loadu_ps( section.da2 + h ) );
+				}
+			}
+
+			_mm_storeu_ps( section.b0 + h, b0 );
+			_mm_storeu_ps( section.b1 + h, b1 );
+			_mm_storeu_ps( section.b2 + h, b2 );
+			_mm_storeu_ps( section.a1 + h, a1 );
+			_mm_storeu_ps( section.a2 + h, a2 );
+			_mm_storeu_ps( section.z1 + h, z1 );
+			_mm_storeu_ps( section.z2 + h, z2 );
+		}
+	}
+}
+
+} // namespace sse2
+
+// ----------------------------------------------------------------------------------------------------
+// AVX2
+// ----------------------------------------------------------------------------------------------------
+
+namespace avx2 {
+
+// The scalar tails are compiled without AVX, so the upper halves of the registers are cleared before reaching them to avoid the
+// AVX to SSE transition penalty (compilers don't reliably do this before a tail call).
+
+struct AddOp { typedef scalar::AddOp ScalarOp; CINDER_DSP_TARGET_AVX2 static __m256 apply( __m256 a, __m256 b ) { return _mm256_add_ps( a, b ); } };
+struct SubOp { typedef scalar::SubOp ScalarOp; CINDER_DSP_TARGET_AVX2 static __m256 apply( __m256 a, __m256 b ) { return _mm256_sub_ps( a, b ); } };
+struct MulOp { typedef scalar::MulOp ScalarOp; CINDER_DSP_TARGET_AVX2 static __m256 apply( __m256 a, __m256 b ) { return _mm256_mul_ps( a, b ); } };
+
+CINDER_DSP_TARGET_AVX2 inline __m256i floatToInt16( __m256 samples )
+{
+	__m256 scaled = _mm256_mul_ps( samples, _mm256_set1_ps( FLOAT_TO_INT16 ) );
+	scaled = _mm256_max_ps( _mm256_min_ps( scaled, _mm256_set1_ps( INT16_MAX_FLOAT ) ), _mm256_set1_ps( -FLOAT_TO_INT16 ) );
+	return _mm256_cvttps_epi32( scaled );
+}
+
+// packs 16 samples to int16 with saturation. _mm256_packs_epi32 works within 128-bit lanes, so the 64-bit blocks are put back in order.
+CINDER_DSP_TARGET_AVX2 inline __m256i packInt16( __m256i low, __m256i high )
+{
+	return _mm256_permute4x64_epi64( _mm256_packs_epi32( low, high ), _MM_SHUFFLE( 3, 1, 2, 0 ) );
+}
+
+template <typename OpT>
+CINDER_DSP_TARGET_AVX2 void binary( const float *arrayA, const float *arrayB, float *result, size_t length )
+{
+	size_t i = 0;
+	for( ; i + 8 <= length; i += 8 )
+		_mm256_storeu_ps( result + i, OpT::apply( _mm256_loadu_ps( arrayA + i ), _mm256_loadu_ps( arrayB + i ) ) );
+
+	_mm256_zeroupper();
+	scalar::binary<typename OpT::ScalarOp>( arrayA + i, arrayB + i, result + i, length - i );
+}
+
+template <typename OpT>
+CINDER_DSP_TARGET_AVX2 void binaryScalar( const float *array, float scalar, float *result, size_t length )
+{
+	const __m256 scalarVec = _mm256_set1_ps( scalar );
+	size_t i = 0;
+	for( ; i + 8 <= length; i += 8 )
+		_mm256_storeu_ps( result + i, OpT::apply( _mm256_loadu_ps( array + i ), scalarVec ) );
+
+	_mm256_zeroupper();
+	scalar::binaryScalar<typename OpT::ScalarOp>( array + i, scalar, result + i, length - i );
+}
+
+CINDER_DSP_TARGET_AVX2 void fill( float value, float *array, size_t length )
+{
+	const __m256 valueVec = _mm256_set1_ps( value );
+	size_t i = 0;
+	for( ; i + 8 <= length; i += 8 )
+		_mm256_storeu_ps( array + i, valueVec );
+
+	_mm256_zeroupper();
+	scalar::fill( value, array + i, length - i );
+}
+
+CINDER_DSP_TARGET_AVX2 void addMul( const float *arrayA, const float *arrayB, float scalar, float *result, size_t length )
+{
+	const __m256 scalarVec = _mm256_set1_ps( scalar );
+	size_t i = 0;
+	for( ; i + 8 <= length; i += 8 )
+		_mm256_storeu_ps( result + i, _mm256_mul_ps( _mm256_add_ps( _mm256_loadu_ps( arrayA + i ), _mm256_loadu_ps( arrayB + i ) ), scalarVec ) );
+
+	_mm256_zeroupper();
+	scalar::addMul( arrayA + i, arrayB + i, scalar, result + i, length - i );
+}
+
+CINDER_DSP_TARGET_AVX2 void mulAdd( const float *array, float scalar, const float *addend, float *result, size_t length )
+{
+	// FMA isn't used, so that results match the other levels exactly
+	const __m256 scalarVec = _mm256_set1_ps( scalar );
+	size_t i = 0;
+	for( ; i + 8 <= length; i += 8 )
+		_mm256_storeu_ps( result + i, _mm256_add_ps( _mm256_mul_ps( _mm256_loadu_ps( array + i ), scalarVec ), _mm256_loadu_ps( addend + i ) ) );
+
+	_mm256_zeroupper();
+	scalar::mulAdd( array + i, scalar, addend + i, result + i, length - i );
+}
+
+CINDER_DSP_TARGET_AVX2 float sum( const float *array, size_t length )
+{
+	__m256 sums = _mm256_setzero_ps();
+	size_t i = 0;
+	for( ; i + 8 <= length; i += 8 )
+		sums = _mm256_add_ps( sums, _mm256_loadu_ps( array + i ) );
+
+	__m128 halves = _mm_add_ps( _mm256_castps256_ps128( sums ), _mm256_extractf128_ps( sums, 1 ) );
+	_mm256_zeroupper();
+	return sse2::horizontalSum( halves ) + scalar::sum( array + i, length - i );
+}
+
+CINDER_DSP_TARGET_AVX2 float sumOfSquares( const float *array, size_t length )
+{
+	__m256 sums = _mm256_setzero_ps();
+	size_t i = 0;
+	for( ; i + 8 <= length; i += 8 ) {
+		__m256 v = _mm256_loadu_ps( array + i );
+		sums = _mm256_add_ps( sums, _mm256_mul_ps( v, v ) );
+	}
+
+	__m128 halves = _mm_add_ps( _mm256_castps256_ps128( sums ), _mm256_extractf128_ps( sums, 1 ) );
+	_mm256_zeroupper();
+	return sse2::horizontalSum( halves ) + scalar::sumOfSquares( array + i, length - i );
+}
+
+CINDER_DSP_TARGET_AVX2 float dot( const float *arrayA, const float *arrayB, size_t length )
+{
+	__m256 sums0 = _mm256_setzero_ps();
+	__m256 sums1 = _mm256_setzero_ps();
+	size_t i = 0;
+	for( ; i + 16 <= length; i += 16 ) {
+		sums0 = _mm256_add_ps( sums0, _mm256_mul_ps( _mm256_loadu_ps( arrayA + i ), _mm256_loadu_ps( arrayB + i ) ) );
+		sums1 = _mm256_add_ps( sums1, _mm256_mul_ps( _mm256_loadu_ps( arrayA + i + 8 ), _mm256_loadu_ps( arrayB + i + 8 ) ) );
+	}
+	for( ; i + 8 <= length; i += 8 )
+		sums0 = _mm256_add_ps( sums0, _mm256_mul_ps( _mm256_loadu_ps( arrayA + i ), _mm256_loadu_ps( arrayB + i ) ) );
+
+	__m256 sums = _mm256_add_ps( sums0, sums1 );
+	__m128 halves = _mm_add_ps( _mm256_castps256_ps128( sums ), _mm256_extractf128_ps( sums, 1 ) );
+	_mm256_zeroupper();
+	return sse2::horizontalSum( halves ) + scalar::dot( arrayA + i, arrayB + i, length - i );
+}
+
+CINDER_DSP_TARGET_AVX2 float max( const float *array, size_t length )
+{
+	__m256 maxes = _mm256_setzero_ps();
+	size_t i = 0;
+	for( ; i + 8 <= length; i += 8 )
+		maxes = _mm256_max_ps( maxes, _mm256_loadu_ps( array + i ) );
+
+	__m128 halves = _mm_max_ps( _mm256_castps256_ps128( maxes ), _mm256_extractf128_ps( maxes, 1 ) );
+	_mm256_zeroupper();
+	return std::max( sse2::horizontalMax( halves ), scalar::max( array + i, length - i ) );
+}
+
+CINDER_DSP_TARGET_AVX2 void floatToInt16( const float *sourceArray, int16_t *destArray, size_t length )
+{
+	size_t i = 0;
+	for( ; i + 16 <= length; i += 16 ) {
+		__m256i low = floatToInt16( _mm256_loadu_ps( sourceArray + i ) );
+		__m256i high = floatToInt16( _mm256_loadu_ps( sourceArray + i + 8 ) );
+		_mm256_storeu_si256( (__m256i *)( destArray + i ), packInt16( low, high ) );
+	}
+
+	_mm256_zeroupper();
+	scalar::floatToInt16( sourceArray + i, destArray + i, length - i );
+}
+
+CINDER_DSP_TARGET_AVX2 void int16ToFloat( const int16_t *sourceArray, float *destArray, size_t length )
+{
+	const __m256 normalizer = _mm256_set1_ps( INT16_TO_FLOAT );
+	size_t i = 0;
+	for( ; i + 8 <= length; i += 8 ) {
+		__m256i samples = _mm256_cvtepi16_epi32( _mm_loadu_si128( (const __m128i *)( sourceArray + i ) ) );
+		_mm256_storeu_ps( destArray + i, _mm256_mul_ps( _mm256_cvtepi32_ps( samples ), normalizer ) );
+	}
+
+	_mm256_zeroupper();
+	scalar::int16ToFloat( sourceArray + i, destArray + i, length - i );
+}
+
+CINDER_DSP_TARGET_AVX2 void floatToInt24( const float *sourceArray, char *destArray, size_t length )
+{
+	// moves the low 3 bytes of each 32-bit sample to the low 12 bytes
+	const __m128i packMask = _mm_setr_epi8( 0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1 );
+	const __m128 normalizer = _mm_set1_ps( FLOAT_TO_INT24 );
+
+	// each store writes 16 bytes, of which the last 4 are overwritten by the next store, so stop while there's room
+	size_t i = 0;
+	for( ; i + 6 <= length; i += 4 ) {
+		__m128i samples = _mm_cvttps_epi32( _mm_mul_ps( _mm_loadu_ps( sourceArray + i ), normalizer ) );
+		_mm_storeu_si128( (__m128i *)( destArray + i * 3 ), _mm_shuffle_epi8( samples, packMask ) );
+	}
+
+	_mm256_zeroupper();
+	scalar::floatToInt24( sourceArray + i, destArray + i * 3, length - i );
+}
+
+CINDER_DSP_TARGET_AVX2 void int24ToFloat( const char *sourceArray, float *destArray, size_t length )
+{
+	// moves each 3 byte sample into the high 3 bytes of a 32-bit lane, so that an arithmetic shift sign extends it
+	const __m256i unpackMask = _mm256_setr_epi8( -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11,
+												 -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11 );
+	const __m256 normalizer = _mm256_set1_ps( INT24_TO_FLOAT );
+
+	// each load reads 16 bytes for 12 bytes of samples, so stop while the last one stays within the array
+	size_t i = 0;
+	for( ; i + 10 <= length; i += 8 ) {
+		const char *source = sourceArray + i * 3;
+		__m256i bytes = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( (const __m128i *)source ) ), _mm_loadu_si128( (const __m128i *)( source + 12 ) ), 1 );
+		__m256i samples = _mm256_srai_epi32( _mm256_shuffle_epi8( bytes, unpackMask ), 8 );
+		_mm256_storeu_ps( destArray + i, _mm256_mul_ps( _mm256_cvtepi32_ps( samples ), normalizer ) );
+	}
+
+	_mm256_zeroupper();
+	scalar::int24ToFloat( sourceArray + i * 3, destArray + i, length - i );
+}
+
+CINDER_DSP_TARGET_AVX2 void interleaveStereo( const float *left, const float *right, float *interleaved, size_t numFrames )
+{
+	size_t i = 0;
+	for( ; i + 8 <= numFrames; i += 8 ) {
+		__m256 l = _mm256_loadu_ps( left + i );
+		__m256 r = _mm256_loadu_ps( right + i );
+		// unpacking works within 128-bit lanes: low = frames 0, 1, 4, 5 and high = frames 2, 3, 6, 7
+		__m256 low = _mm256_unpacklo_ps( l, r );
+		__m256 high = _mm256_unpackhi_ps( l, r );
+		_mm256_storeu_ps( interleaved + i * 2, _mm256_permute2f128_ps( low, high, 0x20 ) );
+		_mm256_storeu_ps( interleaved + i * 2 + 8, _mm256_permute2f128_ps( low, high, 0x31 ) );
+	}
+
+	_mm256_zeroupper();
+	scalar::interleaveStereo( left + i, right + i, interleaved + i * 2, numFrames - i );
+}
+
+CINDER_DSP_TARGET_AVX2 void deinterleaveStereo( const float *interleaved, float *left, float *right, size_t numFrames )
+{
+	size_t i = 0;
+	for( ; i + 8 <= numFrames; i += 8 ) {
+		__m256 a = _mm256_loadu_ps( interleaved + i * 2 );
+		__m256 b = _mm256_loadu_ps( interleaved + i * 2 + 8 );
+		// shuffling works within 128-bit lanes, giving frames 0, 1, 4, 5, 2, 3, 6, 7 which are put back in order by 64-bit blocks
+		__m256 l = _mm256_shuffle_ps( a, b, _MM_SHUFFLE( 2, 0, 2, 0 ) );
+		__m256 r = _mm256_shuffle_ps( a, b, _MM_SHUFFLE( 3, 1, 3, 1 ) );
+		_mm256_storeu_ps( left + i, _mm256_castpd_ps( _mm256_permute4x64_pd( _mm256_castps_pd( l ), _MM_SHUFFLE( 3, 1, 2, 0 ) ) ) );
+		_mm256_storeu_ps( right + i, _mm256_castpd_ps( _mm256_permute4x64_pd( _mm256_castps_pd( r ), _MM_SHUFFLE( 3, 1, 2, 0 ) ) ) );
+	}
+
+	_mm256_zeroupper();
+	scalar::deinterleaveStereo( interleaved + i * 2, left + i, right + i, numFrames - i );
+}
+
+CINDER_DSP_TARGET_AVX2 void deinterleaveStereoInt16( const int16_t *interleaved, float *left, float *right, size_t numFrames )
+{
+	const __m256 normalizer = _mm256_set1_ps( INT16_TO_FLOAT );
+	size_t i = 0;
+	for( ; i + 8 <= numFrames; i += 8 ) {
+		__m256i frames = _mm256_loadu_si256( (const __m256i *)( interleaved + i * 2 ) );
+		__m256i l = _mm256_srai_epi32( _mm256_slli_epi32( frames, 16 ), 16 );
+		__m256i r = _mm256_srai_epi32( frames, 16 );
+		_mm256_storeu_ps( left + i, _mm256_mul_ps( _mm256_cvtepi32_ps( l ), normalizer ) );
+		_mm256_storeu_ps( right + i, _mm256_mul_ps( _mm256_cvtepi32_ps( r ), normalizer ) );
+	}
+
+	_mm256_zeroupper();
+	scalar::deinterleaveStereoInt16( interleaved + i * 2, left + i, right + i, numFrames - i );
+}
+
+CINDER_DSP_TARGET_AVX2 void complexMulAdd( const float *realA, const float *imagA, const float *realB, const float *imagB, float *realResult, float *imagResult, size_t length )
+{
+	size_t i = 0;
+	for( ; i + 8 <= length; i += 8 ) {
+		__m256 ar = _mm256_loadu_ps( realA + i ), ai = _mm256_loadu_ps( imagA + i );
+		__m256 br = _mm256_loadu_ps( realB + i ), bi = _mm256_loadu_ps( imagB + i );
+		__m256 real = _mm256_sub_ps( _mm256_mul_ps( ar, br ), _mm256_mul_ps( ai, bi ) );
+		__m256 imag = _mm256_add_ps( _mm256_mul_ps( ar, bi ), _mm256_mul_ps( ai, br ) );
+		_mm256_storeu_ps( realResult + i, _mm256_add_ps( _mm256_loadu_ps( realResult + i ), real ) );
+		_mm256_storeu_ps( imagResult + i, _mm256_add_ps( _mm256_loadu_ps( imagResult + i ), imag ) );
+	}
+
+	_mm256_zeroupper();
+	scalar::complexMulAdd( realA + i, imagA + i, realB + i, imagB + i, realResult + i, imagResult + i, length - i );
+}
+
+CINDER_DSP_TARGET_AVX2 void biquadLanes( float *frames, size_t numFrames, detail::BiquadLanes *sections, size_t numSections, bool interpolate )
+{
+	static_assert( detail::BIQUAD_LANES == 8, "expected one AVX register of lanes" );
+
+	for( size_t s = 0; s < numSections; s++ ) {
+		auto &section = sections[s];
+		__m256 b0 = _mm256_loadu_ps( section.b0 ), b1 = _mm256_loadu_ps( section.b1 ), b2 = _mm256_loadu_ps( section.b2 );
+		__m256 a1 = _mm256_loadu_ps( section.a1 ), a2 = _mm256_loadu_ps( section.a2 );
+		__m256 z1 = _mm256_loadu_ps( section.z1 ), z2 = _mm256_loadu_ps( section.z2 );
+
+		for( size_t i = 0; i < numFrames; i++ ) {
+			float *frame = frames + i * 8;
+			__m256 x = _mm256_loadu_ps( frame );
+			__m256 y = _mm256_add_ps( _mm256_mul_ps( b0, x ), z1 );
+			z1 = _mm256_add_ps( _mm256_sub_ps( _mm256_mul_ps( b1, x ), _mm256_mul_ps( a1, y ) ), z2 );
+			z2 = _mm256_sub_ps( _mm256_mul_ps( b2, x ), _mm256_mul_ps( a2, y ) );
+			_mm256_storeu_ps( frame, y );
+
+			if( interpolate ) {
+				b0 = _mm256_add_ps( b0, _mm256_loadu_ps( section.db0 ) );
+				b1 = _mm256_add_ps( b1, _mm256_loadu_ps( section.db1 ) );
+				b2 = _mm256_add_ps( b2, _mm256_loadu_ps( section.db2 ) );
+				a1 = _mm256_add_ps( a1, _mm256_loadu_ps( section.da1 ) );
+				a2 = _mm256_add_ps( a2, _mm256_loadu_ps( section.da2 ) );
+			}
+		}
+
+		_mm256_storeu_ps( section.b0, b0 );
+		_mm256_storeu_ps( section.b1, b1 );
+		_mm256_storeu_ps( section.b2, b2 );
+		_mm256_storeu_ps( section.a1, a1 );
+		_mm256_storeu_ps( section.a2, a2 );
+		_mm256_storeu_ps( section.z1, z1 );
+		_mm256_storeu_ps( section.z2, z2 );
+	}
+
+	_mm256_zeroupper();
+}
+
+} // namespace avx2
+
+#endif // defined( CINDER_DSP_X86 )
+
+#if defined( CINDER_DSP_NEON )
+
+// ----------------------------------------------------------------------------------------------------
+// NEON
+// ----------------------------------------------------------------------------------------------------
+
+namespace neon {
+
+struct AddOp { typedef scalar::AddOp ScalarOp; static float32x4_t apply( float32x4_t a, float32x4_t b ) { return vaddq_f32( a, b ); } };
+struct SubOp { typedef scalar::SubOp ScalarOp; static float32x4_t apply( float32x4_t a, float32x4_t b ) { return vsubq_f32( a, b ); } };
+struct MulOp { typedef scalar::MulOp ScalarOp; static float32x4_t apply( float32x4_t a, float32x4_t b ) { return vmulq_f32( a, b ); } };
+
+inline float horizontalSum( float32x4_t v )
+{
+	float32x2_t sums = vadd_f32( vget_low_f32( v ), vget_high_f32( v ) );
+	return vget_lane_f32( vpadd_f32( sums, sums ), 0 );
+}
+
+inline float horizontalMax( float32x4_t v )
+{
+	float32x2_t maxes = vmax_f32( vget_low_f32( v ), vget_high_f32( v ) );
+	return vget_lane_f32( vpmax_f32( maxes, maxes ), 0 );
+}
+
+inline int16x4_t floatToInt16( float32x4_t samples )
+{
+	float32x4_t scaled = vmulq_n_f32( samples, FLOAT_TO_INT16 );
+	scaled = vmaxq_f32( vminq_f32( scaled, vdupq_n_f32( INT16_MAX_FLOAT ) ), vdupq_n_f32( -FLOAT_TO_INT16 ) );
+	return vqmovn_s32( vcvtq_s32_f32( scaled ) );
+}
+
+inline float32x4_t int16ToFloat( int16x4_t samples )
+{
+	return vmulq_n_f32( vcvtq_f32_s32( vmovl_s16( samples ) ), INT16_TO_FLOAT );
+}
+
+template <typename OpT>
+void binary( const float *arrayA, const float *arrayB, float *result, size_t length )
+{
+	size_t i = 0;
+	for( ; i + 4 <= length; i += 4 )
+		vst1q_f32( result + i, OpT::apply( vld1q_f32( arrayA + i ), vld1q_f32( arrayB + i ) ) );
+
+	scalar::binary<typename OpT::ScalarOp>( arrayA + i, arrayB + i, result + i, length - i );
+}
+
+template <typename OpT>
+void binaryScalar( const float *array, float scalar, float *result, size_t length )
+{
+	const float32x4_t scalarVec = vdupq_n_f32( scalar );
+	size_t i = 0;
+	for( ; i + 4 <= length; i += 4 )
+		vst1q_f32( result + i, OpT::apply( vld1q_f32( array + i ), scalarVec ) );
+
+	scalar::binaryScalar<typename OpT::ScalarOp>( array + i, scalar, result + i, length - i );
+}
+
+void fill( float value, float *array, size_t length )
+{
+	const float32x4_t valueVec = vdupq_n_f32( value );
+	size_t i = 0;
+	for( ; i + 4 <= length; i += 4 )
+		vst1q_f32( array + i, valueVec );
+
+	scalar::fill( value, array + i, length - i );
+}
+
+void addMul( const float *arrayA, const float *arrayB, float scalar, float *result, size_t length )
+{
+	size_t i = 0;
+	for( ; i + 4 <= length; i += 4 )
+		vst1q_f32( result + i, vmulq_n_f32( vaddq_f32( vld1q_f32( arrayA + i ), vld1q_f32( arrayB + i ) ), scalar ) );
+
+	scalar::addMul( arrayA + i, arrayB + i, scalar, result + i, length - i );
+}
+
+void mulAdd( const float *array, float scalar, const float *addend, float *result, size_t length )
+{
+	size_t i = 0;
+	for( ; i + 4 <= length; i += 4 )
+		vst1q_f32( result + i, vaddq_f32( vmulq_n_f32( vld1q_f32( array + i ), scalar ), vld1q_f32( addend + i ) ) );
+
+	scalar::mulAdd( array + i, scalar, addend + i, result + i, length - i );
+}
+
+float sum( const float *array, size_t length )
+{
+	float32x4_t sums = vdupq_n_f32( 0 );
+	size_t i = 0;
+	for( ; i + 4 <= length; i += 4 )
+		sums = vaddq_f32( sums, vld1q_f32( array + i ) );
+
+	return horizontalSum( sums ) + scalar::sum( array + i, length - i );
+}
+
+float sumOfSquares( const float *array, size_t length )
+{
+	float32x4_t sums = vdupq_n_f32( 0 );
+	size_t i = 0;
+	for( ; i + 4 <= length; i += 4 ) {
+		float32x4_t v = vld1q_f32( array + i );
+		sums = vaddq_f32( sums, vmulq_f32( v, v ) );
+	}
+
+	return horizontalSum( sums ) + scalar::sumOfSquares( array + i, length - i );
+}
+
+float dot( const float *arrayA, const float *arrayB, size_t length )
+{
+	float32x4_t sums0 = vdupq_n_f32( 0 );
+	float32x4_t sums1 = vdupq_n_f32( 0 );
+	size_t i = 0;
+	for( ; i + 8 <= length; i += 8 ) {
+		sums0 = vmlaq_f32( sums0, vld1q_f32( arrayA + i ), vld1q_f32( arrayB + i ) );
+		sums1 = vmlaq_f32( sums1, vld1q_f32( arrayA + i + 4 ), vld1q_f32( arrayB + i + 4 ) );
+	}
+	for( ; i + 4 <= length; i += 4 )
+		sums0 = vmlaq_f32( sums0, vld1q_f32( arrayA + i ), vld1q_f32( arrayB + i ) );
+
+	return horizontalSum( vaddq_f32( sums0, sums1 ) ) + scalar::dot( arrayA + i, arrayB + i, length - i );
+}
+( const float *array, size_t length )
+{
+	float32x4_t maxes = vdupq_n_f32( 0 );
+	size_t i = 0;
+	for( ; i + 4 <= length; i += 4 )
+		maxes = vmaxq_f32( maxes, vld1q_f32( array + i ) );
+
+	return std::max( horizontalMax( maxes ), scalar::max( array + i, length - i ) );
+}
+
+void floatToInt16( const float *sourceArray, int16_t *destArray, size_t length )
+{
+	size_t i = 0;
+	for( ; i + 4 <= length; i += 4 )
+		vst1_s16( destArray + i, floatToInt16( vld1q_f32( sourceArray + i ) ) );
+
+	scalar::floatToInt16( sourceArray + i, destArray + i, length - i );
+}
+
+void int16ToFloat( const int16_t *sourceArray, float *destArray, size_t length )
+{
+	size_t i = 0;
+	for( ; i + 4 <= length; i += 4 )
+		vst1q_f32( destArray + i, int16ToFloat( vld1_s16( sourceArray + i ) ) );
+
+	scalar::int16ToFloat( sourceArray + i, destArray + i, length - i );
+}
+
+void interleaveStereo( const float *left, const float *right, float *interleaved, size_t numFrames )
+{
+	size_t i = 0;
+	for( ; i + 4 <= numFrames; i += 4 ) {
+		float32x4x2_t frames;
+		frames.val[0] = vld1q_f32( left + i );
+		frames.val[1] = vld1q_f32( right + i );
+		vst2q_f32( interleaved + i * 2, frames );
+	}
+
+	scalar::interleaveStereo( left + i, right + i, interleaved + i * 2, numFrames - i );
+}
+
+void deinterleaveStereo( const float *interleaved, float *left, float *right, size_t numFrames )
+{
+	size_t i = 0;
+	for( ; i + 4 <= numFrames; i += 4 ) {
+		float32x4x2_t frames = vld2q_f32( interleaved + i * 2 );
+		vst1q_f32( left + i, frames.val[0] );
+		vst1q_f32( right + i, frames.val[1] );
+	}
+
+	scalar::deinterleaveStereo( interleaved + i * 2, left + i, right + i, numFrames - i );
+}
+
+void interleaveStereoInt16( const float *left, const float *right, int16_t *interleaved, size_t numFrames )
+{
+	size_t i = 0;
+	for( ; i + 4 <= numFrames; i += 4 ) {
+		int16x4x2_t frames;
+		frames.val[0] = floatToInt16( vld1q_f32( left + i ) );
+		frames.val[1] = floatToInt16( vld1q_f32( right + i ) );
+		vst2_s16( interleaved + i * 2, frames );
+	}
+
+	scalar::interleaveStereoInt16( left + i, right + i, interleaved + i * 2, numFrames - i );
+}
+
+void deinterleaveStereoInt16( const int16_t *interleaved, float *left, float *right, size_t numFrames )
+{
+	size_t i = 0;
+	for( ; i + 4 <= numFrames; i += 4 ) {
+		int16x4x2_t frames = vld2_s16( interleaved + i * 2 );
+		vst1q_f32( left + i, int16ToFloat( frames.val[0] ) );
+		vst1q_f32( right + i, int16ToFloat( frames.val[1] ) );
+	}
+
+	scalar::deinterleaveStereoInt16( interleaved + i * 2, left + i, right + i, numFrames - i );
+}
+
+void complexMulAdd( const float *realA, const float *imagA, const float *realB, const float *imagB, float *realResult, float *imagResult, size_t length )
+{
+	size_t i = 0;
+	for( ; i + 4 <= length; i += 4 ) {
+		float32x4_t ar = vld1q_f32( realA + i ), ai = vld1q_f32( imagA + i );
+		float32x4_t br = vld1q_f32( realB + i ), bi = vld1q_f32( imagB + i );
+		float32x4_t real = vsubq_f32( vmulq_f32( ar, br ), vmulq_f32( ai, bi ) );
+		float32x4_t imag = vaddq_f32( vmulq_f32( ar, bi ), vmulq_f32( ai, br ) );
+		vst1q_f32( realResult + i, vaddq_f32( vld1q_f32( realResult + i ), real ) );
+		vst1q_f32( imagResult + i, vaddq_f32( vld1q_f32( imagResult + i ), imag ) );
+	}
+
+	scalar::complexMulAdd( realA + i, imagA + i, realB + i, imagB + i, realResult + i, imagResult + i, length - i );
+}
+
+void biquadLanes( float *frames, size_t numFrames, detail::BiquadLanes *sections, size_t numSections, bool interpolate )
+{
+	const size_t lanes = detail::BIQUAD_LANES;
+
+	for( size_t s = 0; s < numSections; s++ ) {
+		auto &section = sections[s];
+		for( size_t h = 0; h < lanes; h += 4 ) {
+			float32x4_t b0 = vld1q_f32( section.b0 + h ), b1 = vld1q_f32( section.b1 + h ), b2 = vld1q_f32( section.b2 + h );
+			float32x4_t a1 = vld1q_f32( section.a1 + h ), a2 = vld1q_f32( section.a2 + h );
+			float32x4_t z1 = vld1q_f32( section.z1 + h ), z2 = vld1q_f32( section.z2 + h );
+
+			for( size_t i = 0; i < numFrames; i++ ) {
+				float *frame = frames + i * lanes + h;
+				float32x4_t x = vld1q_f32( frame );
+				float32x4_t y = vaddq_f32( vmulq_f32( b0, x ), z1 );
+				z1 = vaddq_f32( vsubq_f32( vmulq_f32( b1, x ), vmulq_f32( a1, y ) ), z2 );
+				z2 = vsubq_f32( vmulq_f32( b2, x ), vmulq_f32( a2, y ) );
+				vst1q_f32( frame, y );
+
+				if( interpolate ) {
+					b0 = vaddq_f32( b0, vld1q_f32( section.db0 + h ) );
+					b1 = vaddq_f32( b1, vld1q_f32( section.db1 + h ) );
+					b2 = vaddq_f32( b2, vld1q_f32( section.db2 + h ) );
+					a1 = vaddq_f32( a1, vld1q_f32( section.da1 + h ) );
+					a2 = vaddq_f32( a2, vld1q_f32( section.da2 + h ) );
+				}
+			}
+
+			vst1q_f32( section.b0 + h, b0 );
+			vst1q_f32( section.b1 + h, b1 );
+			vst1q_f32( section.b2 + h, b2 );
+			vst1q_f32( section.a1 + h, a1 );
+			vst1q_f32( section.a2 + h, a2 );
+			vst1q_f32( section.z1 + h, z1 );
+			vst1q_f32( section.z2 + h, z2 );
+		}
+	}
+}
+
+} // namespace neon
+
+#endif // defined( CINDER_DSP_NEON )
+
+// ----------------------------------------------------------------------------------------------------
+// Dispatch
+// ----------------------------------------------------------------------------------------------------
+
+detail::Kernels makeScalarKernels()
+{
+	detail::Kernels result;
+	result.fill = scalar::fill;
+	result.addScalar = scalar::binaryScalar<scalar::AddOp>;
+	result.add = scalar::binary<scalar::AddOp>;
+	result.sub = scalar::binary<scalar::SubOp>;
+	result.mulScalar = scalar::binaryScalar<scalar::MulOp>;
+	result.mul = scalar::binary<scalar::MulOp>;
+	result.addMul = scalar::addMul;
+	result.mulAdd = scalar::mulAdd;
+	result.sum = scalar::sum;
+	result.sumOfSquares = scalar::sumOfSquares;
+	result.dot = scalar::dot;
+	result.max = scalar::max;
+	result.floatToInt16 = scalar::floatToInt16;
+	result.int16ToFloat = scalar::int16ToFloat;
+	result.floatToInt24 = scalar::floatToInt24;
+	result.int24ToFloat = scalar::int24ToFloat;
+	result.interleaveStereo = scalar::interleaveStereo;
+	result.deinterleaveStereo = scalar::deinterleaveStereo;
+	result.interleaveStereoInt16 = scalar::interleaveStereoInt16;
+	result.deinterleaveStereoInt16 = scalar::deinterleaveStereoInt16;
+	result.complexMulAdd = scalar::complexMulAdd;
+	result.biquadLanes = scalar::biquadLanes;
+	return result;
+}
+
+#if defined( CINDER_DSP_X86 )
+
+detail::Kernels makeSse2Kernels()
+{
+	detail::Kernels result = makeScalarKernels();
+	result.fill = sse2::fill;
+	result.addScalar = sse2::binaryScalar<sse2::AddOp>;
+	result.add = sse2::binary<sse2::AddOp>;
+	result.sub = sse2::binary<sse2::SubOp>;
+	result.mulScalar = sse2::binaryScalar<sse2::MulOp>;
+	result.mul = sse2::binary<sse2::MulOp>;
+	result.addMul = sse2::addMul;
+	result.mulAdd = sse2::mulAdd;
+	result.sum = sse2::sum;
+	result.sumOfSquares = sse2::sumOfSquares;
+	result.dot = sse2::dot;
+	result.max = sse2::max;
+	result.floatToInt16 = sse2::floatToInt16;
+	result.int16ToFloat = sse2::int16ToFloat;
+	result.interleaveStereo = sse2::interleaveStereo;
+	result.deinterleaveStereo = sse2::deinterleaveStereo;
+	result.interleaveStereoInt16 = sse2::interleaveStereoInt16;
+	result.deinterleaveStereoInt16 = sse2::deinterleaveStereoInt16;
+	result.complexMulAdd = sse2::complexMulAdd;
+	result.biquadLanes = sse2::biquadLanes;
+	return result;
+}
+
+detail::Kernels makeAvx2Kernels()
+{
+	// interleaveStereoInt16 stays with SSE2, where the packing doesn't need reordering across lanes
+	detail::Kernels result = makeSse2Kernels();
+	result.fill = avx2::fill;
+	result.addScalar = avx2::binaryScalar<avx2::AddOp>;
+	result.add = avx2::binary<avx2::AddOp>;
+	result.sub = avx2::binary<avx2::SubOp>;
+	result.mulScalar = avx2::binaryScalar<avx2::MulOp>;
+	result.mul = avx2::binary<avx2::MulOp>;
+	result.addMul = avx2::addMul;
+	result.mulAdd = avx2::mulAdd;
+	result.sum = avx2::sum;
+	result.sumOfSquares = avx2::sumOfSquares;
+	result.dot = avx2::dot;
+	result.max = avx2::max;
+	result.floatToInt16 = avx2::floatToInt16;
+	result.int16ToFloat = avx2::int16ToFloat;
+	result.floatToInt24 = avx2::floatToInt24;
+	result.int24ToFloat = avx2::int24ToFloat;
+	result.interleaveStereo = avx2::interleaveStereo;
+	result.deinterleaveStereo = avx2::deinterleaveStereo;
+	result.deinterleaveStereoInt16 = avx2::deinterleaveStereoInt16;
+	result.complexMulAdd = avx2::complexMulAdd;
+	result.biquadLanes = avx2::biquadLanes;
+	return result;
+}
+
+#endif // defined( CINDER_DSP_X86 )
+
+#if defined( CINDER_DSP_NEON )
+
+detail::Kernels makeNeonKernels()
+{
+	// the 24-bit conversions stay scalar
+	detail::Kernels result = makeScalarKernels();
+	result.fill = neon::fill;
+	result.addScalar = neon::binaryScalar<neon::AddOp>;
+	result.add = neon::binary<neon::AddOp>;
+	result.sub = neon::binary<neon::SubOp>;
+	result.mulScalar = neon::binaryScalar<neon::MulOp>;
+	result.mul = neon::binary<neon::MulOp>;
+	result.addMul = neon::addMul;
+	result.mulAdd = neon::mulAdd;
+	result.sum = neon::sum;
+	result.sumOfSquares = neon::sumOfSquares;
+	result.dot = neon::dot;
+	result.max = neon::max;
+	result.floatToInt16 = neon::floatToInt16;
+	result.int16ToFloat = neon::int16ToFloat;
+	result.interleaveStereo = neon::interleaveStereo;
+	result.deinterleaveStereo = neon::deinterleaveStereo;
+	result.interleaveStereoInt16 = neon::interleaveStereoInt16;
+	result.deinterleaveStereoInt16 = neon::deinterleaveStereoInt16;
+	result.complexMulAdd = neon::complexMulAdd;
+	result.biquadLanes = neon::biquadLanes;
+	return result;
+}
+
+#endif // defined( CINDER_DSP_NEON )
+
+// Returns the Kernels for level, or null if it isn't compiled in.
+const detail::Kernels* findKernels( SimdLevel level )
+{
+	static const detail::Kernels sScalarKernels = makeScalarKernels();
+#if defined( CINDER_DSP_X86 )
+	static const detail::Kernels sSse2Kernels = makeSse2Kernels();
+	static const detail::Kernels sAvx2Kernels = makeAvx2Kernels();
+#elif defined( CINDER_DSP_NEON )
+	static const detail::Kernels sNeonKernels = makeNeonKernels();
+#endif
+
+	switch( level ) {
+		case SimdLevel::SCALAR:	return &sScalarKernels;
+#if defined( CINDER_DSP_X86 )
+		case SimdLevel::SSE2:	return &sSse2Kernels;
+		case SimdLevel::AVX2:	return &sAvx2Kernels;
+#elif defined( CINDER_DSP_NEON )
+		case SimdLevel::NEON:	return &sNeonKernels;
+#endif
+		default:				return nullptr;
+	}
+}
+
+SimdLevel findBestLevel()
+{
+	for( SimdLevel level : { SimdLevel::AVX2, SimdLevel::NEON, SimdLevel::SSE2 } ) {
+		if( isSimdLevelSupported( level ) )
+			return level;
+	}
+
+	return SimdLevel::SCALAR;
+}
+
+struct CurrentKernels {
+	CurrentKernels()
+		: mLevel( findBestLevel() ), mKernels( findKernels( mLevel ) )
+	{}
+
+	std::atomic<SimdLevel>					mLevel;
+	std::atomic<const detail::Kernels *>	mKernels;
+};
+
+CurrentKernels& getCurrentKernels()
+{
+	static CurrentKernels sCurrentKernels;
+	return sCurrentKernels;
+}
+
+} // anonymous namespace
+
+const detail::Kernels& detail::getKernels()
+{
+	return *getCurrentKernels().mKernels.load( memory_order_relaxed );
+}
+
+SimdLevel getSimdLevel()
+{
+	return getCurrentKernels().mLevel;
+}
+
+bool setSimdLevel( SimdLevel level )
+{
+	if( ! isSimdLevelSupported( level ) )
+		return false;
+
+	auto &current = getCurrentKernels();
+	current.mLevel = level;
+	current.mKernels = findKernels( level );
+	return true;
+}
+
+bool isSimdLevelSupported( SimdLevel level )
+{
+	if( ! findKernels( level ) )
+		return false;
+
+	switch( level ) {
+#if defined( CINDER_DSP_X86 )
+		case SimdLevel::SSE2:	return System::hasSse2();
+		case SimdLevel::AVX2:	return System::hasAvx2();
+#endif
+		default:				return true;
+	}
+}
+
+} } } // namespace cinder::audio::dsp
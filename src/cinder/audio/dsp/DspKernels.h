@@ -0,0 +1,73 @@
+/*
+ Copyright (c) 2016, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include "cinder/audio/dsp/Dsp.h"
+#include "cinder/audio/dsp/BiquadBank.h"
+
+#include <cstdint>
+
+namespace cinder { namespace audio { namespace dsp { namespace detail {
+
+//! Table of the vector routines that have SIMD implementations, with every entry filled in for one SimdLevel. Entries that a level doesn't
+//! accelerate point to the implementation of the next lower level.
+struct Kernels {
+	void	(*fill)( float value, float *array, size_t length );
+	void	(*addScalar)( const float *array, float scalar, float *result, size_t length );
+	void	(*add)( const float *arrayA, const float *arrayB, float *result, size_t length );
+	void	(*sub)( const float *arrayA, const float *arrayB, float *result, size_t length );
+	void	(*mulScalar)( const float *array, float scalar, float *result, size_t length );
+	void	(*mul)( const float *arrayA, const float *arrayB, float *result, size_t length );
+	void	(*addMul)( const float *arrayA, const float *arrayB, float scalar, float *result, size_t length );
+	void	(*mulAdd)( const float *array, float scalar, const float *addend, float *result, size_t length );
+	float	(*sum)( const float *array, size_t length );
+	float	(*sumOfSquares)( const float *array, size_t length );
+	float	(*dot)( const float *arrayA, const float *arrayB, size_t length );
+	//! Returns the largest element of \a array, or 0 if they are all negative.
+	float	(*max)( const float *array, size_t length );
+
+	//! Values outside of [-1, 1) are clamped.
+	void	(*floatToInt16)( const float *sourceArray, int16_t *destArray, size_t length );
+	void	(*int16ToFloat)( const int16_t *sourceArray, float *destArray, size_t length );
+	void	(*floatToInt24)( const float *sourceArray, char *destArray, size_t length );
+	void	(*int24ToFloat)( const char *sourceArray, float *destArray, size_t length );
+
+	void	(*interleaveStereo)( const float *left, const float *right, float *interleaved, size_t numFrames );
+	void	(*deinterleaveStereo)( const float *interleaved, float *left, float *right, size_t numFrames );
+	void	(*interleaveStereoInt16)( const float *left, const float *right, int16_t *interleaved, size_t numFrames );
+	void	(*deinterleaveStereoInt16)( const int16_t *interleaved, float *left, float *right, size_t numFrames );
+
+	//! Adds the element-wise products of the split complex arrays A and B to the split complex result.
+	void	(*complexMulAdd)( const float *realA, const float *imagA, const float *realB, const float *imagB, float *realResult, float *imagResult, size_t length );
+
+	//! Processes \a frames, which hold BIQUAD_LANES channels per frame, through \a numSections sections in series. If \a interpolate is true,
+	//! each section's increments are added to its coefficients after every frame.
+	void	(*biquadLanes)( float *frames, size_t numFrames, BiquadLanes *sections, size_t numSections, bool interpolate );
+};
+
+//! Returns the Kernels for the current getSimdLevel().
+const Kernels& getKernels();
+
+} } } } // namespace cinder::audio::dsp::detail
@@ -546,6 +546,7 @@ void SourceFileAudioLoader::init()
 SourceFileRef SourceFileAudioLoader::cloneWithSampleRate( size_t sampleRate ) const
 {
 	auto result = std::make_shared<SourceFileAudioLoader>( mDataSource, sampleRate );
+	result->setConverterType( mConverterType );
 	result->setupSampleRateConversion();
 
 	return result;
@@ -104,6 +104,7 @@ SourceFileRef SourceFileMediaFoundation::cloneWithSampleRate( size_t sampleRate
 {
 	auto result = make_shared<SourceFileMediaFoundation>( mDataSource, sampleRate );
 	result->initReader();
+	result->setConverterType( mConverterType );
 	result->setupSampleRateConversion();
 
 	return result;
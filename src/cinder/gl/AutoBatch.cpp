@@ -0,0 +1,336 @@
+/*
+ Copyright (c) 2016, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "cinder/gl/AutoBatch.h"
+#include "cinder/gl/Context.h"
+#include "cinder/gl/GlslProg.h"
+#include "cinder/gl/Vao.h"
+#include "cinder/gl/Vbo.h"
+#include "cinder/gl/scoped.h"
+#include "cinder/CinderAssert.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+using namespace std;
+
+namespace cinder { namespace gl {
+
+namespace {
+
+// Size of the ring buffer that flushed vertices are streamed into. Pending vertices are flushed when they would fill it.
+const size_t RING_BUFFER_SIZE = 4 * 1024 * 1024;
+
+inline vec3 toVec3( const vec2 &v )	{ return vec3( v, 0 ); }
+inline vec3 toVec3( const vec3 &v )	{ return v; }
+
+inline bool isLinePrimitive( GLenum mode )
+{
+	return mode == GL_LINES || mode == GL_LINE_STRIP || mode == GL_LINE_LOOP;
+}
+
+} // anonymous namespace
+
+AutoBatch::AutoBatch()
+	: mHasNormals( false ), mVboOffset( 0 ), mFlushing( false ), mNumDrawsIssued( 0 ), mNumDrawsMerged( 0 )
+{
+}
+
+bool AutoBatch::State::operator==( const State &rhs ) const
+{
+	return mGlslProg == rhs.mGlslProg && equal( mTextures2d, mTextures2d + NUM_TEXTURE_UNITS, rhs.mTextures2d ) && mFramebuffer == rhs.mFramebuffer
+		&& mBlend == rhs.mBlend && mDepthTest == rhs.mDepthTest && mDepthMask == rhs.mDepthMask && mCullFace == rhs.mCullFace && mScissorTest == rhs.mScissorTest
+		&& mStencilTest == rhs.mStencilTest
+		&& mBlendSrcRgb == rhs.mBlendSrcRgb && mBlendDstRgb == rhs.mBlendDstRgb && mBlendSrcAlpha == rhs.mBlendSrcAlpha && mBlendDstAlpha == rhs.mBlendDstAlpha
+		&& mDepthFunc == rhs.mDepthFunc && mCullFaceMode == rhs.mCullFaceMode && mFrontFace == rhs.mFrontFace
+#if ! defined( CINDER_GL_ES )
+		&& mPolygonMode == rhs.mPolygonMode
+#endif
+		&& mViewport == rhs.mViewport && mScissor == rhs.mScissor && mLineWidth == rhs.mLineWidth
+		&& mViewMatrix == rhs.mViewMatrix && mProjectionMatrix == rhs.mProjectionMatrix;
+}
+
+void AutoBatch::captureState( Context *ctx, State *result ) const
+{
+	result->mGlslProg = ctx->getGlslProg();
+	for( uint8_t unit = 0; unit < NUM_TEXTURE_UNITS; unit++ )
+		result->mTextures2d[unit] = ctx->getTextureBinding( GL_TEXTURE_2D, unit );
+	result->mFramebuffer = ctx->getFramebuffer();
+	result->mBlend = ctx->getBoolState( GL_BLEND );
+	result->mDepthTest = ctx->getBoolState( GL_DEPTH_TEST );
+	result->mDepthMask = ctx->getDepthMask();
+	result->mCullFace = ctx->getBoolState( GL_CULL_FACE );
+	result->mScissorTest = ctx->getBoolState( GL_SCISSOR_TEST );
+	result->mStencilTest = ctx->getBoolState( GL_STENCIL_TEST );
+	ctx->getBlendFuncSeparate( &result->mBlendSrcRgb, &result->mBlendDstRgb, &result->mBlendSrcAlpha, &result->mBlendDstAlpha );
+	result->mDepthFunc = ctx->getDepthFunc();
+	result->mCullFaceMode = ctx->getCullFace();
+	result->mFrontFace = ctx->getFrontFace();
+#if ! defined( CINDER_GL_ES )
+	result->mPolygonMode = ctx->getPolygonMode( GL_FRONT_AND_BACK );
+#endif
+	result->mViewport = ctx->getViewport();
+	result->mScissor = ctx->getScissor();
+	result->mLineWidth = ctx->getLineWidth();
+	result->mViewMatrix = gl::getViewMatrix();
+	result->mProjectionMatrix = gl::getProjectionMatrix();
+}
+
+void AutoBatch::append( GLenum mode, const vec2 *positions, const vec2 *texCoords, const vec3 *normals, size_t numVertices )
+{
+	appendImpl( mode, positions, texCoords, normals, numVertices );
+}
+
+void AutoBatch::append( GLenum mode, const vec3 *positions, const vec2 *texCoords, const vec3 *normals, size_t numVertices )
+{
+	appendImpl( mode, positions, texCoords, normals, numVertices );
+}
+
+template<typename VecT>
+void AutoBatch::appendImpl( GLenum mode, const VecT *positions, const vec2 *texCoords, const vec3 *normals, size_t numVertices )
+{
+	auto ctx = context();
+	State state;
+	captureState( ctx, &state );
+	const bool hasNormals = normals != nullptr;
+	if( ! mVertices.empty() && ( state != mState || hasNormals != mHasNormals ) )
+		flush();
+
+	if( mVertices.empty() ) {
+		mState = state;
+		mHasNormals = hasNormals;
+	}
+
+	// consecutive draws of the same primitive class share a draw call
+	const GLenum primitive = isLinePrimitive( mode ) ? GL_LINES : GL_TRIANGLES;
+	if( mRuns.empty() || mRuns.back().mPrimitive != primitive )
+		mRuns.push_back( { primitive, 0 } );
+	else
+		++mNumDrawsMerged;
+	const size_t prevNumVertices = mVertices.size();
+
+	// bake the model matrix and current color into the vertices, since they can differ between merged draws
+	const mat4 modelMatrix = gl::getModelMatrix();
+	const mat3 normalMatrix = transpose( inverse( mat3( modelMatrix ) ) );
+	const ColorAf &color = ctx->getCurrentColor();
+
+	mTransformed.resize( numVertices );
+	for( size_t i = 0; i < numVertices; i++ ) {
+		Vertex &v = mTransformed[i];
+		v.mPosition = vec3( modelMatrix * vec4( toVec3( positions[i] ), 1 ) );
+		v.mColor = color;
+		v.mTexCoord = texCoords ? texCoords[i] : vec2( 0 );
+		v.mNormal = hasNormals ? normalMatrix * normals[i] : vec3( 0 );
+	}
+
+	// convert strips, fans and loops to lists, so that separate draws can share a single draw call
+	auto emit = [this]( size_t i ) { mVertices.push_back( mTransformed[i] ); };
+	switch( mode ) {
+		case GL_TRIANGLES:
+		case GL_LINES:
+			mVertices.insert( mVertices.end(), mTransformed.begin(), mTransformed.end() );
+		break;
+		case GL_TRIANGLE_STRIP:
+			// every other triangle has its first two vertices swapped, which keeps the winding of the strip
+			for( size_t i = 0; i + 2 < numVertices; i++ ) {
+				emit( i + ( i % 2 ) );
+				emit( i + 1 - ( i % 2 ) );
+				emit( i + 2 );
+			}
+		break;
+		case GL_TRIANGLE_FAN:
+			for( size_t i = 1; i + 1 < numVertices; i++ ) {
+				emit( 0 );
+				emit( i );
+				emit( i + 1 );
+			}
+		break;
+		case GL_LINE_STRIP:
+		case GL_LINE_LOOP:
+			for( size_t i = 0; i + 1 < numVertices; i++ ) {
+				emit( i );
+				emit( i + 1 );
+			}
+			if( mode == GL_LINE_LOOP && numVertices > 1 ) {
+				emit( numVertices - 1 );
+				emit( 0 );
+			}
+		break;
+		default:
+			CI_ASSERT_MSG( false, "AutoBatch only supports triangle and line primitives" );
+	}
+	mRuns.back().mCount += GLsizei( mVertices.size() - prevNumVertices );
+
+	if( mVertices.size() * sizeof( Vertex ) >= RING_BUFFER_SIZE )
+		flush();
+}
+
+bool AutoBatch::flushIfUsing( const GlslProg *glslProg )
+{
+	if( mVertices.empty() || mFlushing || mState.mGlslProg != glslProg )
+		return false;
+
+	flush();
+	return true;
+}
+
+void AutoBatch::flush()
+{
+	if( mVertices.empty() || mFlushing )
+		return;
+
+	// the draw below goes through the Context, which would otherwise flush again
+	mFlushing = true;
+	auto ctx = context();
+
+	// restore the state the pending draws were appended with, unless it hasn't changed since
+	State current;
+	captureState( ctx, &current );
+	const bool restoreState = current != mState;
+	if( restoreState ) {
+		ctx->pushGlslProg( mState.mGlslProg );
+		for( uint8_t unit = 0; unit < NUM_TEXTURE_UNITS; unit++ )
+			ctx->pushTextureBinding( GL_TEXTURE_2D, mState.mTextures2d[unit], unit );
+		ctx->pushFramebuffer( GL_FRAMEBUFFER, mState.mFramebuffer );
+		ctx->pushBoolState( GL_BLEND, mState.mBlend );
+		ctx->pushBlendFuncSeparate( mState.mBlendSrcRgb, mState.mBlendDstRgb, mState.mBlendSrcAlpha, mState.mBlendDstAlpha );
+		ctx->pushBoolState( GL_DEPTH_TEST, mState.mDepthTest );
+		ctx->pushDepthMask( mState.mDepthMask );
+		ctx->pushDepthFunc( mState.mDepthFunc );
+		ctx->pushBoolState( GL_CULL_FACE, mState.mCullFace );
+		ctx->pushCullFace( mState.mCullFaceMode );
+		ctx->pushFrontFace( mState.mFrontFace );
+#if ! defined( CINDER_GL_ES )
+		ctx->pushPolygonMode( GL_FRONT_AND_BACK, mState.mPolygonMode );
+#endif
+		ctx->pushBoolState( GL_STENCIL_TEST, mState.mStencilTest );
+		ctx->pushBoolState( GL_SCISSOR_TEST, mState.mScissorTest );
+		ctx->pushScissor( mState.mScissor );
+		ctx->pushViewport( mState.mViewport );
+		ctx->pushLineWidth( mState.mLineWidth );
+	}
+	// positions were already transformed by the model matrix
+	ctx->getModelMatrixStack().push_back( mat4() );
+	ctx->getViewMatrixStack().push_back( mState.mViewMatrix );
+	ctx->getProjectionMatrixStack().push_back( mState.mProjectionMatrix );
+
+	GLint first = upload();
+	{
+		// a VAO of its own, since a draw that flushes may have already specified its attribs on the default VAO
+		if( ! mVao )
+			mVao = Vao::create();
+		ctx->pushVao( mVao );
+		mVao->replacementBindBegin();
+		ScopedBuffer bufferBindScp( mVbo );
+
+		const pair<geom::Attrib, pair<int, size_t>> attribs[] = {
+			{ geom::Attrib::POSITION, { 3, offsetof( Vertex, mPosition ) } },
+			{ geom::Attrib::COLOR, { 4, offsetof( Vertex, mColor ) } },
+			{ geom::Attrib::TEX_COORD_0, { 2, offsetof( Vertex, mTexCoord ) } },
+			{ geom::Attrib::NORMAL, { 3, offsetof( Vertex, mNormal ) } }
+		};
+		for( const auto &attrib : attribs ) {
+			// without normals the attribute keeps its current value, as it would for the same draws unbatched
+			if( attrib.first == geom::Attrib::NORMAL && ! mHasNormals )
+				continue;
+			int loc = mState.mGlslProg->getAttribSemanticLocation( attrib.first );
+			if( loc >= 0 ) {
+				enableVertexAttribArray( loc );
+				vertexAttribPointer( loc, attrib.second.first, GL_FLOAT, GL_FALSE, sizeof( Vertex ), (const GLvoid*)attrib.second.second );
+			}
+		}
+		mVao->replacementBindEnd();
+		ctx->setDefaultShaderVars();
+		for( const auto &run : mRuns ) {
+			ctx->drawArrays( run.mPrimitive, first, run.mCount );
+			first += run.mCount;
+		}
+		ctx->popVao();
+	}
+
+	ctx->getProjectionMatrixStack().pop_back();
+	ctx->getViewMatrixStack().pop_back();
+	ctx->getModelMatrixStack().pop_back();
+	if( restoreState ) {
+		ctx->popLineWidth();
+		ctx->popViewport();
+		ctx->popScissor();
+		ctx->popBoolState( GL_SCISSOR_TEST );
+		ctx->popBoolState( GL_STENCIL_TEST );
+#if ! defined( CINDER_GL_ES )
+		ctx->popPolygonMode( GL_FRONT_AND_BACK );
+#endif
+		ctx->popFrontFace();
+		ctx->popCullFace();
+		ctx->popBoolState( GL_CULL_FACE );
+		ctx->popDepthFunc();
+		ctx->popDepthMask();
+		ctx->popBoolState( GL_DEPTH_TEST );
+		ctx->popBlendFuncSeparate();
+		ctx->popBoolState( GL_BLEND );
+		ctx->popFramebuffer( GL_FRAMEBUFFER );
+		for( uint8_t unit = 0; unit < NUM_TEXTURE_UNITS; unit++ )
+			ctx->popTextureBinding( GL_TEXTURE_2D, unit );
+		ctx->popGlslProg();
+	}
+
+	mNumDrawsIssued += mRuns.size();
+	mVertices.clear();
+	mRuns.clear();
+	mFlushing = false;
+}
+
+GLint AutoBatch::upload()
+{
+	const size_t size = mVertices.size() * sizeof( Vertex );
+	if( ! mVbo || size > mVbo->getSize() ) {
+		mVbo = Vbo::create( GL_ARRAY_BUFFER, std::max( size, RING_BUFFER_SIZE ), nullptr, GL_STREAM_DRAW );
+		mVboOffset = 0;
+	}
+	else if( mVboOffset + size > mVbo->getSize() ) {
+		// orphan the storage the GPU may still be reading from, rather than waiting for it
+		mVbo->bufferData( mVbo->getSize(), nullptr, GL_STREAM_DRAW );
+		mVboOffset = 0;
+	}
+
+#if defined( CINDER_GL_HAS_MAP_BUFFER_RANGE )
+	// nothing issued since the storage was last orphaned reads past mVboOffset, so there is no need to synchronize
+	void *dest = mVbo->mapBufferRange( mVboOffset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT );
+	if( dest ) {
+		memcpy( dest, mVertices.data(), size );
+		mVbo->unmap();
+	}
+	else
+		mVbo->bufferSubData( mVboOffset, size, mVertices.data() );
+#else
+	mVbo->bufferSubData( mVboOffset, size, mVertices.data() );
+#endif
+
+	const GLint first = GLint( mVboOffset / sizeof( Vertex ) );
+	mVboOffset += size;
+	return first;
+}
+
+} } // namespace cinder::gl
@@ -167,13 +167,11 @@ void* BufferObj::mapBufferRange( GLintptr offset, GLsizeiptr length, GLbitfield
 #endif
 
 #if defined( CINDER_GL_HAS_MAP_BUFFER ) || defined( CINDER_GL_HAS_MAP_BUFFER_RANGE )
-void BufferObj::unmap() const
+bool BufferObj::unmap() const
 {
 	ScopedBuffer bufferBind( mTarget, mId );
-    GLboolean result = glUnmapBuffer( mTarget );
-    if ( GL_TRUE != result ) {
-        //throw BufferFailedUnmapExc();
-    }
+	// GL_FALSE means the data store was corrupted while mapped, for example by a display mode change
+	return glUnmapBuffer( mTarget ) == GL_TRUE;
 }
 #endif
 
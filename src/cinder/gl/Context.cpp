@@ -28,6 +28,7 @@
 #include "cinder/gl/Vbo.h"
 #include "cinder/gl/TransformFeedbackObj.h"
 #include "cinder/gl/Fbo.h"
+#include "cinder/gl/AutoBatch.h"
 #include "cinder/gl/Batch.h"
 #include "cinder/gl/ConstantConversions.h"
 #include "cinder/gl/scoped.h"
@@ -37,6 +38,8 @@
 
 #include "cinder/app/AppBase.h"
 
+#include <atomic>
+
 #if defined( CINDER_MSW )
 	#include <Windows.h>
 #elif defined( CINDER_ANDROID )
@@ -56,6 +59,44 @@ namespace cinder { namespace gl {
 	thread_local Context *sThreadSpecificCurrentContext = NULL;
 #endif
 
+// shared by all Contexts, since a GlslProg can be used with more than one
+static std::atomic<uint64_t> sMatrixGeneration( 0 );
+
+namespace {
+
+enum { MODEL_MATRIX_BIT = 1, VIEW_MATRIX_BIT = 2, PROJECTION_MATRIX_BIT = 4 };
+
+// Returns which of the model, view and projection matrices the uniform \a semantic is derived from, or 0 if it's not a matrix uniform
+uint32_t getMatrixDependencies( UniformSemantic semantic )
+{
+	switch( semantic ) {
+		case UNIFORM_MODEL_MATRIX:
+		case UNIFORM_MODEL_MATRIX_INVERSE:
+		case UNIFORM_MODEL_MATRIX_INVERSE_TRANSPOSE:
+			return MODEL_MATRIX_BIT;
+		case UNIFORM_VIEW_MATRIX:
+		case UNIFORM_VIEW_MATRIX_INVERSE:
+			return VIEW_MATRIX_BIT;
+		case UNIFORM_MODEL_VIEW:
+		case UNIFORM_MODEL_VIEW_INVERSE:
+		case UNIFORM_MODEL_VIEW_INVERSE_TRANSPOSE:
+		case UNIFORM_NORMAL_MATRIX:
+			return MODEL_MATRIX_BIT | VIEW_MATRIX_BIT;
+		case UNIFORM_MODEL_VIEW_PROJECTION:
+		case UNIFORM_MODEL_VIEW_PROJECTION_INVERSE:
+			return MODEL_MATRIX_BIT | VIEW_MATRIX_BIT | PROJECTION_MATRIX_BIT;
+		case UNIFORM_PROJECTION_MATRIX:
+		case UNIFORM_PROJECTION_MATRIX_INVERSE:
+			return PROJECTION_MATRIX_BIT;
+		case UNIFORM_VIEW_PROJECTION:
+			return VIEW_MATRIX_BIT | PROJECTION_MATRIX_BIT;
+		default:
+			return 0;
+	}
+}
+
+} // anonymous namespace
+
 Context::Context( const std::shared_ptr<PlatformData> &platformData )
 	: mPlatformData( platformData ),
 	mColor( ColorAf::white() ),
@@ -86,6 +127,10 @@ Context::Context( const std::shared_ptr<PlatformData> &platformData )
 	mFramebufferStack.push_back( 0 );
 #endif
 	mDefaultArrayVboIdx = 0;
+	mAutoBatchDepth = 0;
+	mModelMatrixChanged = mViewMatrixChanged = mProjectionMatrixChanged = true;
+	mDerivedMatricesValid = 0;
+	mNumMatrixUniformsSet = 0;
 
 	// initial state for depth mask is enabled
 	mBoolStateStack[GL_DEPTH_WRITEMASK] = vector<GLboolean>();
@@ -862,6 +907,9 @@ void Context::glslProgCreated( const GlslProg *glslProg )
 
 void Context::glslProgDeleted( const GlslProg *glslProg )
 {
+	if( mAutoBatch )
+		mAutoBatch->flushIfUsing( glslProg );
+
 	if( mObjectTrackingEnabled )
 		mLiveGlslProgs.erase( glslProg );
 }
@@ -880,6 +928,9 @@ void Context::bindTexture( GLenum target, GLuint textureId, uint8_t textureUnit
 
 	GLuint prevValue = getTextureBinding( target, textureUnit );
 	if( prevValue != textureId ) {
+		// pending batched draws may sample this binding without the AutoBatch having captured it
+		if( ! AutoBatch::capturesTextureBinding( target, textureUnit ) )
+			flushAutoBatch();
 		mTextureBindingStack[textureUnit][target].back() = textureId;
 		ScopedActiveTexture actScp( textureUnit );
 		glBindTexture( target, textureId );
@@ -931,6 +982,8 @@ void Context::popTextureBinding( GLenum target, uint8_t textureUnit, bool forceR
 		cached->second.pop_back();
 		if( ! cached->second.empty() ) {
 			if( forceRestore || ( cached->second.back() != prevValue ) ) {
+				if( ! AutoBatch::capturesTextureBinding( target, textureUnit ) )
+					flushAutoBatch();
 				ScopedActiveTexture actScp( textureUnit );
 				glBindTexture( target, cached->second.back() );
 			}
@@ -978,6 +1031,9 @@ void Context::textureDeleted( const TextureBase *texture )
 	GLenum target = texture->getTarget();
 	GLuint textureId = texture->getId();
 
+	// pending batched draws may sample it
+	flushAutoBatch();
+
 	// remove from object tracking
 	if( mObjectTrackingEnabled )
 		mLiveTextures.erase( texture );
@@ -1232,6 +1288,9 @@ void Context::framebufferCreated( const Fbo *fbo )
 
 void Context::framebufferDeleted( const Fbo *fbo )
 {
+	// pending batched draws may render to it
+	flushAutoBatch();
+
 	// remove from object tracking
 	if( mObjectTrackingEnabled )
 		mLiveFbos.erase( fbo );
@@ -1824,11 +1883,13 @@ void Context::vertexAttrib4f( GLuint index, float v0, float v1, float v2, float
 // draw*
 void Context::drawArrays( GLenum mode, GLint first, GLsizei count )
 {
+	flushAutoBatch();
 	glDrawArrays( mode, first, count );
 }
 
 void Context::drawElements( GLenum mode, GLsizei count, GLenum type, const GLvoid *indices )
 {
+	flushAutoBatch();
 	glDrawElements( mode, count, type, indices );
 }
 
@@ -1836,11 +1897,13 @@ void Context::drawElements( GLenum mode, GLsizei count, GLenum type, const GLvoi
 
 void Context::multiDrawArrays( GLenum mode, GLint *first, GLsizei *count, GLsizei primcount )
 {
+	flushAutoBatch();
 	glMultiDrawArrays( mode, first, count, primcount );
 }
 
 void Context::multiDrawElements( GLenum mode, GLsizei *count, GLenum type, const GLvoid * const *indices, GLsizei primcount )
 {
+	flushAutoBatch();
 	glMultiDrawElements( mode, count, type, indices, primcount );
 }
 
@@ -1850,6 +1913,7 @@ void Context::multiDrawElements( GLenum mode, GLsizei *count, GLenum type, const
 
 void Context::drawArraysInstanced( GLenum mode, GLint first, GLsizei count, GLsizei primcount )
 {
+	flushAutoBatch();
 #if defined( CINDER_GL_ANGLE )
 	glDrawArraysInstancedANGLE( mode, first, count, primcount );
 #elif defined( CINDER_GL_ES_2 ) && defined( CINDER_COCOA_TOUCH )
@@ -1861,6 +1925,7 @@ void Context::drawArraysInstanced( GLenum mode, GLint first, GLsizei count, GLsi
 
 void Context::drawElementsInstanced( GLenum mode, GLsizei count, GLenum type, const GLvoid *indices, GLsizei primcount )
 {
+	flushAutoBatch();
 #if defined( CINDER_GL_ANGLE )
 	glDrawElementsInstancedANGLE( mode, count, type, indices, primcount );
 #elif defined( CINDER_GL_ES_2 ) && defined( CINDER_COCOA_TOUCH )
@@ -1876,11 +1941,13 @@ void Context::drawElementsInstanced( GLenum mode, GLsizei count, GLenum type, co
 
 void Context::drawArraysIndirect( GLenum mode, const GLvoid *indirect )
 {
+	flushAutoBatch();
 	glDrawArraysIndirect( mode, indirect );
 }
 
 void Context::drawElementsIndirect( GLenum mode, GLenum type, const GLvoid *indirect )
 {
+	flushAutoBatch();
 	glDrawElementsIndirect( mode, type, indirect );
 }
 
@@ -1890,11 +1957,13 @@ void Context::drawElementsIndirect( GLenum mode, GLenum type, const GLvoid *indi
 
 void Context::multiDrawArraysIndirect( GLenum mode, const GLvoid *indirect, GLsizei drawcount, GLsizei stride )
 {
+	flushAutoBatch();
 	glMultiDrawArraysIndirect( mode, indirect, drawcount, stride );
 }
 
 void Context::multiDrawElementsIndirect( GLenum mode, GLenum type, const GLvoid *indirect, GLsizei drawcount, GLsizei stride )
 {
+	flushAutoBatch();
 	glMultiDrawElementsIndirect( mode, type, indirect, drawcount, stride );
 }
 
@@ -1931,82 +2000,46 @@ GlslProgRef& Context::getStockShader( const ShaderDef &shaderDef )
 
 void Context::setDefaultShaderVars()
 {
-	const auto &ctx = gl::context();
-	const auto &glslProg = ctx->getGlslProg();
+	// pending batched draws rely on the uniforms that are about to be replaced
+	flushAutoBatch();
+
+	const auto &glslProg = getGlslProg();
 	if( glslProg ) {
+		// give the matrix stacks that have changed since the last draw a new generation
+		bool *changed[3] = { &mModelMatrixChanged, &mViewMatrixChanged, &mProjectionMatrixChanged };
+		for( int i = 0; i < 3; i++ ) {
+			if( *changed[i] ) {
+				mMatrixGenerations[i] = ++sMatrixGeneration;
+				*changed[i] = false;
+				for( int semantic = 0; semantic < UNIFORM_USER_DEFINED; semantic++ ) {
+					if( getMatrixDependencies( (UniformSemantic)semantic ) & ( 1 << i ) )
+						mDerivedMatricesValid &= ~( 1 << semantic );
+				}
+			}
+		}
+
+		// only the matrices derived from stacks that have changed since this GlslProg last received them need setting
+		uint32_t changedMatrices = 0;
+		for( int i = 0; i < 3; i++ ) {
+			if( glslProg->mDefaultMatrixGenerations[i] != mMatrixGenerations[i] )
+				changedMatrices |= 1 << i;
+		}
+
 		const auto &uniforms = glslProg->getActiveUniforms();
 		for( const auto &uniform : uniforms ) {
-			switch( uniform.getUniformSemantic() ) {
-				case UNIFORM_MODEL_MATRIX: {
-					auto model = gl::getModelMatrix();
-					glslProg->uniform( uniform.getLocation(), model );
-				}
-				break;
-				case UNIFORM_MODEL_MATRIX_INVERSE: {
-					auto inverseModel = glm::inverse( gl::getModelMatrix() );
-					glslProg->uniform( uniform.getLocation(), inverseModel );
-				}
-				break;
-				case UNIFORM_MODEL_MATRIX_INVERSE_TRANSPOSE: {
-					auto modelInverseTranspose = gl::calcModelMatrixInverseTranspose();
-					glslProg->uniform( uniform.getLocation(), modelInverseTranspose );
-				}
-				break;
-				case UNIFORM_VIEW_MATRIX: {
-					auto view = gl::getViewMatrix();
-					glslProg->uniform( uniform.getLocation(), view );
-				}
-				break;
-				case UNIFORM_VIEW_MATRIX_INVERSE: {
-					auto viewInverse = gl::calcViewMatrixInverse();
-					glslProg->uniform( uniform.getLocation(), viewInverse );
-				}
-				break;
-				case UNIFORM_MODEL_VIEW: {
-					auto modelView = gl::getModelView();
-					glslProg->uniform( uniform.getLocation(), modelView );
-				}
-				break;
-				case UNIFORM_MODEL_VIEW_INVERSE: {
-					auto modelViewInverse = glm::inverse( gl::getModelView() );
-					glslProg->uniform( uniform.getLocation(), modelViewInverse );
-				}
-				break;
-				case UNIFORM_MODEL_VIEW_INVERSE_TRANSPOSE: {
-					auto normalMatrix = gl::calcNormalMatrix();
-					glslProg->uniform( uniform.getLocation(), normalMatrix );
+			const auto semantic = uniform.getUniformSemantic();
+			if( uint32_t dependencies = getMatrixDependencies( semantic ) ) {
+				if( dependencies & changedMatrices ) {
+					if( semantic == UNIFORM_MODEL_MATRIX_INVERSE_TRANSPOSE || semantic == UNIFORM_MODEL_VIEW_INVERSE_TRANSPOSE || semantic == UNIFORM_NORMAL_MATRIX )
+						glslProg->uniform( uniform.getLocation(), mat3( getDerivedMatrix( semantic ) ) );
+					else
+						glslProg->uniform( uniform.getLocation(), getDerivedMatrix( semantic ) );
+					++mNumMatrixUniformsSet;
 				}
-				break;
-				case UNIFORM_MODEL_VIEW_PROJECTION: {
-					auto modelViewProjection = gl::getModelViewProjection();
-					glslProg->uniform( uniform.getLocation(), modelViewProjection );
-				}
-				break;
-				case UNIFORM_MODEL_VIEW_PROJECTION_INVERSE: {
-					auto modelViewProjectionInverse = glm::inverse( gl::getModelViewProjection() );
-					glslProg->uniform( uniform.getLocation(), modelViewProjectionInverse );
-				}
-				break;
-				case UNIFORM_PROJECTION_MATRIX: {
-					auto projection = gl::getProjectionMatrix();
-					glslProg->uniform( uniform.getLocation(), projection );
-				}
-				break;
-				case UNIFORM_PROJECTION_MATRIX_INVERSE: {
-					auto projectionInverse = glm::inverse( gl::getProjectionMatrix() );
-					glslProg->uniform( uniform.getLocation(), projectionInverse );
-				}
-				break;
-				case UNIFORM_VIEW_PROJECTION: {
-					auto viewProjection = gl::getProjectionMatrix() * gl::getViewMatrix();
-					glslProg->uniform( uniform.getLocation(), viewProjection );
-				}
-				break;
-				case UNIFORM_NORMAL_MATRIX: {
-					auto normalMatrix = gl::calcNormalMatrix();
-					glslProg->uniform( uniform.getLocation(), normalMatrix );
-				}
-				break;
+				continue;
+			}
+
+			switch( semantic ) {
 				case UNIFORM_VIEWPORT_MATRIX: {
 					auto viewport = gl::calcViewportMatrix();
 					glslProg->uniform( uniform.getLocation(), viewport );
@@ -2027,11 +2060,13 @@ void Context::setDefaultShaderVars()
 			}
 		}
 
+		std::copy( std::begin( mMatrixGenerations ), std::end( mMatrixGenerations ), glslProg->mDefaultMatrixGenerations );
+
 		const auto &attribs = glslProg->getActiveAttributes();
 		for( const auto &attrib : attribs ) {
 			switch( attrib.getSemantic() ) {
 				case geom::Attrib::COLOR: {
-					ColorA c = ctx->getCurrentColor();
+					ColorA c = getCurrentColor();
 					gl::vertexAttrib4f( attrib.getLocation(), c.r, c.g, c.b, c.a );
 				}
 				break;
@@ -2042,6 +2077,38 @@ void Context::setDefaultShaderVars()
 	}
 }
 
+const mat4& Context::getDerivedMatrix( UniformSemantic semantic )
+{
+	mat4 &result = mDerivedMatrices[semantic];
+	if( mDerivedMatricesValid & ( 1 << semantic ) )
+		return result;
+
+	const mat4 &model = mModelMatrixStack.back();
+	const mat4 &view = mViewMatrixStack.back();
+	const mat4 &projection = mProjectionMatrixStack.back();
+	switch( semantic ) {
+		case UNIFORM_MODEL_MATRIX:						result = model; break;
+		case UNIFORM_MODEL_MATRIX_INVERSE:				result = glm::inverse( model ); break;
+		case UNIFORM_MODEL_MATRIX_INVERSE_TRANSPOSE:	result = mat4( mat3( glm::inverseTranspose( model ) ) ); break;
+		case UNIFORM_VIEW_MATRIX:						result = view; break;
+		case UNIFORM_VIEW_MATRIX_INVERSE:				result = glm::inverse( view ); break;
+		case UNIFORM_MODEL_VIEW:						result = view * model; break;
+		case UNIFORM_MODEL_VIEW_INVERSE:				result = glm::inverse( getDerivedMatrix( UNIFORM_MODEL_VIEW ) ); break;
+		case UNIFORM_MODEL_VIEW_INVERSE_TRANSPOSE:
+		case UNIFORM_NORMAL_MATRIX:						result = mat4( glm::inverseTranspose( mat3( getDerivedMatrix( UNIFORM_MODEL_VIEW ) ) ) ); break;
+		case UNIFORM_MODEL_VIEW_PROJECTION:				result = projection * view * model; break;
+		case UNIFORM_MODEL_VIEW_PROJECTION_INVERSE:		result = glm::inverse( getDerivedMatrix( UNIFORM_MODEL_VIEW_PROJECTION ) ); break;
+		case UNIFORM_PROJECTION_MATRIX:					result = projection; break;
+		case UNIFORM_PROJECTION_MATRIX_INVERSE:			result = glm::inverse( projection ); break;
+		case UNIFORM_VIEW_PROJECTION:					result = projection * view; break;
+		default:
+			CI_ASSERT_NOT_REACHABLE();
+	}
+
+	mDerivedMatricesValid |= 1 << semantic;
+	return result;
+}
+
 Vao* Context::getDefaultVao()
 {
 	if( ! mDefaultVao ) {
@@ -2111,6 +2178,30 @@ VboRef Context::getDefaultArrayVbo( size_t requiredSize )
 	return mDefaultArrayVbo[mDefaultArrayVboIdx];
 }
 
+void Context::pushAutoBatch()
+{
+	if( ! mAutoBatch )
+		mAutoBatch = make_shared<AutoBatch>();
+
+	++mAutoBatchDepth;
+}
+
+void Context::popAutoBatch()
+{
+	CI_ASSERT_MSG( mAutoBatchDepth > 0, "popAutoBatch() without a matching pushAutoBatch()" );
+	if( mAutoBatchDepth == 1 )
+		mAutoBatch->flush();
+
+	--mAutoBatchDepth;
+}
+
+void Context::flushAutoBatch()
+{
+	// AutoBatch::flush() returns immediately when there is nothing pending, or when it is the one drawing
+	if( mAutoBatch )
+		mAutoBatch->flush();
+}
+
 VboRef Context::getDefaultElementVbo( size_t requiredSize )
 {
 	if( ! mDefaultElementVbo || ( requiredSize > mDefaultElementVbo->getSize() ) ) {
@@ -23,6 +23,7 @@
 */
 
 #include "cinder/gl/GlslProg.h"
+#include "cinder/gl/AutoBatch.h"
 #include "cinder/gl/Context.h"
 #include "cinder/gl/ConstantConversions.h"
 #include "cinder/gl/Environment.h"
@@ -33,6 +34,7 @@
 
 #include "glm/gtc/type_ptr.hpp"
 
+#include <algorithm>
 #include <type_traits>
 
 // For stoi and std:;to_string
@@ -485,7 +487,7 @@ GlslProg::~GlslProg()
 // GlslProg
 
 GlslProg::GlslProg( const Format &format )
-	: mUniformValueCache( nullptr )
+	: mUniformValueCache( nullptr ), mDefaultMatrixGenerations()
 #if defined( CINDER_GL_HAS_TRANSFORM_FEEDBACK )
 		, mTransformFeedbackFormat( -1 )
 #endif
@@ -1014,6 +1016,11 @@ void GlslProg::logMissingUniform( int location ) const
 	}
 }
 	
+void GlslProg::logMissingUniform( const UniformHandle &/*handle*/ ) const
+{
+	// invalid handles were already logged by name in getUniformHandle()
+}
+	
 void GlslProg::logUniformWrongType( const std::string &name, GLenum uniformType, const std::string &userType ) const
 {
 	if( mLoggedUniformNames.count( name ) == 0 ) {
@@ -1051,6 +1058,22 @@ GLint GlslProg::getUniformLocation( const std::string &name ) const
 		return -1;
 }
 	
+GlslProg::UniformHandle GlslProg::getUniformHandle( const std::string &name ) const
+{
+	UniformHandle result;
+	int uniformLocation;
+	const Uniform *uniform = findUniform( name, &uniformLocation );
+	if( uniform ) {
+		result.mUniformIndex = int32_t( uniform - mUniforms.data() );
+		result.mLocation = uniformLocation;
+		result.mProgramHandle = mHandle;
+	}
+	else
+		logMissingUniform( name );
+
+	return result;
+}
+	
 GlslProg::Attribute* GlslProg::findAttrib( const std::string &name )
 {
 	Attribute *ret = nullptr;
@@ -1163,6 +1186,18 @@ const GlslProg::Uniform* GlslProg::findUniform( const std::string &name, int *re
 	return resultUniform;
 }
 
+const GlslProg::Uniform* GlslProg::findUniform( const UniformHandle &handle, int *resultLocation ) const
+{
+	if( ! handle.isValid() )
+		return nullptr;
+
+	CI_ASSERT_MSG( handle.mProgramHandle == mHandle && handle.mUniformIndex < (int32_t)mUniforms.size(), "UniformHandle belongs to a different GlslProg" );
+	if( resultLocation )
+		*resultLocation = handle.mLocation;
+
+	return &mUniforms[handle.mUniformIndex];
+}
+
 const GlslProg::Uniform* GlslProg::findUniform( int location, int *resultLocation ) const
 {
 	const Uniform* ret = nullptr;
@@ -1320,10 +1355,23 @@ GlslProg::TransformFeedbackVaryings* GlslProg::findTransformFeedbackVaryings( co
 
 bool GlslProg::checkUniformValueCache( const Uniform &uniform, int location, const void *val, int count ) const
 {
+	bool changed = true; // no uniform cache means we've disabled it
 	if( mUniformValueCache )
-		return mUniformValueCache->shouldBuffer( uniform.mBytePointer, uniform.mTypeSize, location - uniform.mLoc, count, val );
-	else // no uniform cache means we've disabled it
-		return true;
+		changed = mUniformValueCache->shouldBuffer( uniform.mBytePointer, uniform.mTypeSize, location - uniform.mLoc, count, val );
+
+	// draws pending in an AutoBatch expect the previous value. Flushing sets the default uniforms, so cache this value again afterwards
+	if( changed ) {
+		auto autoBatch = gl::context()->getAutoBatch();
+		if( autoBatch && autoBatch->flushIfUsing( this ) && mUniformValueCache )
+			mUniformValueCache->shouldBuffer( uniform.mBytePointer, uniform.mTypeSize, location - uniform.mLoc, count, val );
+	}
+
+	// a matrix uniform set by hand no longer holds what setDefaultShaderVars() last set, so have it set them all again
+	const auto semantic = uniform.mSemantic;
+	if( changed && semantic != UNIFORM_USER_DEFINED && semantic != UNIFORM_VIEWPORT_MATRIX && semantic != UNIFORM_WINDOW_SIZE && semantic != UNIFORM_ELAPSED_SECONDS )
+		std::fill( std::begin( mDefaultMatrixGenerations ), std::end( mDefaultMatrixGenerations ), 0 );
+
+	return changed;
 }
 	
 template<typename LookUp, typename T>
@@ -1511,6 +1559,11 @@ void GlslProg::uniform( int location, bool data ) const
 {
 	uniformImpl( location, data );
 }
+
+void GlslProg::uniform( const UniformHandle &handle, bool data ) const
+{
+	uniformImpl( handle, data );
+}
 	
 template<>
 void GlslProg::uniformFunc<bool>( int location, const bool &data ) const
@@ -1531,6 +1584,11 @@ void GlslProg::uniform( int location, uint32_t data ) const
 	uniformImpl( location, data );
 }
 
+void GlslProg::uniform( const UniformHandle &handle, uint32_t data ) const
+{
+	uniformImpl( handle, data );
+}
+
 template<>
 void GlslProg::uniformFunc( int location, const uint32_t &data ) const
 {
@@ -1549,6 +1607,11 @@ void GlslProg::uniform( int location, const uvec2 &data ) const
 	uniformImpl( location, data );
 }
 
+void GlslProg::uniform( const UniformHandle &handle, const uvec2 &data ) const
+{
+	uniformImpl( handle, data );
+}
+
 template<>
 void GlslProg::uniformFunc( int location, const uvec2 &data ) const
 {
@@ -1566,6 +1629,11 @@ void GlslProg::uniform( int location, const uvec3 &data ) const
 {
 	uniformImpl( location, data );
 }
+
+void GlslProg::uniform( const UniformHandle &handle, const uvec3 &data ) const
+{
+	uniformImpl( handle, data );
+}
 	
 template<>
 void GlslProg::uniformFunc( int location, const uvec3 &data ) const
@@ -1585,6 +1653,11 @@ void GlslProg::uniform( int location, const uvec4 &data ) const
 	uniformImpl( location, data );
 }
 
+void GlslProg::uniform( const UniformHandle &handle, const uvec4 &data ) const
+{
+	uniformImpl( handle, data );
+}
+
 template<>
 void GlslProg::uniformFunc( int location, const uvec4 &data ) const
 {
@@ -1602,6 +1675,11 @@ void GlslProg::uniform( int location, const uint32_t *data, int count ) const
 	uniformImpl( location, data, count );
 }
 
+void GlslProg::uniform( const UniformHandle &handle, const uint32_t *data, int count ) const
+{
+	uniformImpl( handle, data, count );
+}
+
 template<>
 void GlslProg::uniformFunc( int location, const uint32_t *data, int count ) const
 {
@@ -1622,6 +1700,11 @@ void GlslProg::uniform( int location, int data ) const
 	uniformImpl( location, data );
 }
 
+void GlslProg::uniform( const UniformHandle &handle, int data ) const
+{
+	uniformImpl( handle, data );
+}
+
 template<>
 void GlslProg::uniformFunc( int location, const int &data ) const
 {
@@ -1640,6 +1723,11 @@ void GlslProg::uniform( int location, const ivec2 &data ) const
 	uniformImpl( location, data );
 }
 
+void GlslProg::uniform( const UniformHandle &handle, const ivec2 &data ) const
+{
+	uniformImpl( handle, data );
+}
+
 template<>
 void GlslProg::uniformFunc( int location, const ivec2 &data ) const
 {
@@ -1657,6 +1745,11 @@ void GlslProg::uniform( int location, const ivec3 &data ) const
 {
 	uniformImpl( location, data );
 }
+
+void GlslProg::uniform( const UniformHandle &handle, const ivec3 &data ) const
+{
+	uniformImpl( handle, data );
+}
 	
 template<>
 void GlslProg::uniformFunc( int location, const ivec3 &data ) const
@@ -1676,6 +1769,11 @@ void GlslProg::uniform( int location, const ivec4 &data ) const
 	uniformImpl( location, data );
 }
 
+void GlslProg::uniform( const UniformHandle &handle, const ivec4 &data ) const
+{
+	uniformImpl( handle, data );
+}
+
 template<>
 void GlslProg::uniformFunc( int location, const ivec4 &data ) const
 {
@@ -1693,6 +1791,11 @@ void GlslProg::uniform( int location, const int *data, int count ) const
 {
 	uniformImpl( location, data, count );
 }
+
+void GlslProg::uniform( const UniformHandle &handle, const int *data, int count ) const
+{
+	uniformImpl( handle, data, count );
+}
 	
 template<>
 void GlslProg::uniformFunc( int location, const int *data, int count ) const
@@ -1711,6 +1814,11 @@ void GlslProg::uniform( int location, const ivec2 *data, int count ) const
 {
 	uniformImpl( location, data, count );
 }
+
+void GlslProg::uniform( const UniformHandle &handle, const ivec2 *data, int count ) const
+{
+	uniformImpl( handle, data, count );
+}
 	
 template<>
 void GlslProg::uniformFunc( int location, const ivec2 *data, int count ) const
@@ -1729,6 +1837,11 @@ void GlslProg::uniform( int location, float data ) const
 {
 	uniformImpl( location, data );
 }
+
+void GlslProg::uniform( const UniformHandle &handle, float data ) const
+{
+	uniformImpl( handle, data );
+}
 	
 template<>
 void GlslProg::uniformFunc( int location, const float &data ) const
@@ -1747,6 +1860,11 @@ void GlslProg::uniform( int location, const vec2 &data ) const
 {
 	uniformImpl( location, data );
 }
+
+void GlslProg::uniform( const UniformHandle &handle, const vec2 &data ) const
+{
+	uniformImpl( handle, data );
+}
 	
 template<>
 void GlslProg::uniformFunc( int location, const vec2 &data ) const
@@ -1766,6 +1884,11 @@ void GlslProg::uniform( int location, const vec3 &data ) const
 	uniformImpl( location, data );
 }
 
+void GlslProg::uniform( const UniformHandle &handle, const vec3 &data ) const
+{
+	uniformImpl( handle, data );
+}
+
 template<>
 void GlslProg::uniformFunc( int location, const vec3 &data ) const
 {
@@ -1783,6 +1906,11 @@ void GlslProg::uniform( int location, const vec4 &data ) const
 {
 	uniformImpl( location, data );
 }
+
+void GlslProg::uniform( const UniformHandle &handle, const vec4 &data ) const
+{
+	uniformImpl( handle, data );
+}
 	
 template<>
 void GlslProg::uniformFunc( int location, const vec4 &data ) const
@@ -1801,6 +1929,11 @@ void GlslProg::uniform( int location, const mat2 &data, bool transpose ) const
 {
 	uniformMatImpl( location, data, transpose );
 }
+
+void GlslProg::uniform( const UniformHandle &handle, const mat2 &data, bool transpose ) const
+{
+	uniformMatImpl( handle, data, transpose );
+}
 	
 template<>
 void GlslProg::uniformMatFunc( int location, const mat2 &data, bool transpose ) const
@@ -1819,6 +1952,11 @@ void GlslProg::uniform( int location, const mat3 &data, bool transpose ) const
 {
 	uniformMatImpl( location, data, transpose );
 }
+
+void GlslProg::uniform( const UniformHandle &handle, const mat3 &data, bool transpose ) const
+{
+	uniformMatImpl( handle, data, transpose );
+}
 	
 template<>
 void GlslProg::uniformMatFunc( int location, const mat3 &data, bool transpose ) const
@@ -1838,6 +1976,11 @@ void GlslProg::uniform( int location, const mat4 &data, bool transpose ) const
 	uniformMatImpl( location, data, transpose );
 }
 
+void GlslProg::uniform( const UniformHandle &handle, const mat4 &data, bool transpose ) const
+{
+	uniformMatImpl( handle, data, transpose );
+}
+
 template<>
 void GlslProg::uniformMatFunc( int location, const mat4 &data, bool transpose ) const
 {
@@ -1855,6 +1998,11 @@ void GlslProg::uniform( int location, const float *data, int count ) const
 {
 	uniformImpl( location, data, count );
 }
+
+void GlslProg::uniform( const UniformHandle &handle, const float *data, int count ) const
+{
+	uniformImpl( handle, data, count );
+}
 	
 template<>
 void GlslProg::uniformFunc( int location, const float *data, int count ) const
@@ -1874,6 +2022,11 @@ void GlslProg::uniform( int location, const vec2 *data, int count ) const
 	uniformImpl( location, data, count );
 }
 
+void GlslProg::uniform( const UniformHandle &handle, const vec2 *data, int count ) const
+{
+	uniformImpl( handle, data, count );
+}
+
 template<>
 void GlslProg::uniformFunc( int location, const vec2 *data, int count ) const
 {
@@ -1892,6 +2045,11 @@ void GlslProg::uniform( int location, const vec3 *data, int count ) const
 	uniformImpl( location, data, count );
 }
 
+void GlslProg::uniform( const UniformHandle &handle, const vec3 *data, int count ) const
+{
+	uniformImpl( handle, data, count );
+}
+
 template<>
 void GlslProg::uniformFunc( int location, const vec3 *data, int count ) const
 {
@@ -1910,6 +2068,11 @@ void GlslProg::uniform( int location, const vec4 *data, int count ) const
 	uniformImpl( location, data, count );
 }
 
+void GlslProg::uniform( const UniformHandle &handle, const vec4 *data, int count ) const
+{
+	uniformImpl( handle, data, count );
+}
+
 template<>
 void GlslProg::uniformFunc( int location, const vec4 *data, int count ) const
 {
@@ -1927,6 +2090,11 @@ void GlslProg::uniform( int location, const mat2 *data, int count, bool transpos
 {
 	uniformMatImpl( location, data, count, transpose );
 }
+
+void GlslProg::uniform( const UniformHandle &handle, const mat2 *data, int count, bool transpose ) const
+{
+	uniformMatImpl( handle, data, count, transpose );
+}
 	
 template<>
 void GlslProg::uniformMatFunc( int location, const mat2 *data, int count, bool transpose ) const
@@ -1945,6 +2113,11 @@ void GlslProg::uniform( int location, const mat3 *data, int count, bool transpos
 {
 	uniformMatImpl( location, data, count, transpose );
 }
+
+void GlslProg::uniform( const UniformHandle &handle, const mat3 *data, int count, bool transpose ) const
+{
+	uniformMatImpl( handle, data, count, transpose );
+}
 	
 template<>
 void GlslProg::uniformMatFunc( int location, const mat3 *data, int count, bool transpose ) const
@@ -1963,6 +2136,11 @@ void GlslProg::uniform( int location, const mat4 *data, int count, bool transpos
 {
 	uniformMatImpl( location, data, count, transpose );
 }
+
+void GlslProg::uniform( const UniformHandle &handle, const mat4 *data, int count, bool transpose ) const
+{
+	uniformMatImpl( handle, data, count, transpose );
+}
 	
 template<>
 void GlslProg::uniformMatFunc( int location, const mat4 *data, int count, bool transpose ) const
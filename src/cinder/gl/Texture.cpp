@@ -856,6 +856,7 @@ void Texture1d::update( const Surface8u &surface, int mipLevel )
 	if( surface.getSize() != mipMapSize )
 		throw TextureResizeExc( "Invalid Texture1d::update() surface dimensions", surface.getSize(), mipMapSize );
 
+	context()->flushAutoBatch();
 	ScopedTextureBind tbs( mTarget, mTextureId );
 	glTexSubImage1D( mTarget, mipLevel, 0, // offsets
 				mipMapSize.x, dataFormat, type, surface.getData() );
@@ -863,6 +864,7 @@ void Texture1d::update( const Surface8u &surface, int mipLevel )
 
 void Texture1d::update( const void *data, GLenum dataFormat, GLenum dataType, int mipLevel, int width, int offset )
 {
+	context()->flushAutoBatch();
 	ScopedTextureBind tbs( mTarget, mTextureId );
 	glTexSubImage1D( mTarget, mipLevel, offset, width, dataFormat, dataType, data );
 }
@@ -1230,6 +1232,8 @@ void Texture2d::setData( const SurfaceT<T> &original, bool createStorage, int mi
 	GLenum type;
 	SurfaceChannelOrderToDataFormatAndType<T>( source.getChannelOrder(), &dataFormat, &type );
 
+	if( ! createStorage )
+		context()->flushAutoBatch();
 	ScopedTextureBind tbs( mTarget, mTextureId );
 
 	glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
@@ -1269,6 +1273,8 @@ void Texture2d::setData( const ChannelT<T> &original, bool createStorage, int mi
 	else if( std::is_same<float,T>::value )
 		type = GL_FLOAT;
 
+	if( ! createStorage )
+		context()->flushAutoBatch();
 	ScopedTextureBind tbs( mTarget, mTextureId );
 
 	glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
@@ -1415,6 +1421,8 @@ void Texture2d::initData( const ImageSourceRef &imageSource, const Format &forma
 
 void Texture2d::update( const void *data, GLenum dataFormat, GLenum dataType, int mipLevel, int width, int height, const ivec2 &destLowerLeftOffset )
 {
+	// draws pending in an AutoBatch may sample the previous contents
+	context()->flushAutoBatch();
 	ScopedTextureBind tbs( mTarget, mTextureId );
 	glTexSubImage2D( mTarget, mipLevel, destLowerLeftOffset.x, destLowerLeftOffset.y, width, height, dataFormat, dataType, data );
 }
@@ -1462,6 +1470,7 @@ void Texture2d::update( const PboRef &pbo, GLenum format, GLenum type, const Are
 	CI_ASSERT_ERROR( pbo->getTarget() == GL_PIXEL_UNPACK_BUFFER )
 	*/
 
+	context()->flushAutoBatch();
 	ScopedBuffer bufScp( (BufferObjRef)( pbo ) );
 	ScopedTextureBind tbs( mTarget, mTextureId );
 	glTexSubImage2D( mTarget, mipLevel, destArea.getX1(), mActualSize.y - destArea.getY2(), destArea.getWidth(), destArea.getHeight(), format, type, reinterpret_cast<const GLvoid*>( pboByteOffset ) );
@@ -1768,6 +1777,7 @@ void Texture3d::update( const Surface8u &surface, int depth, int mipLevel )
 
 void Texture3d::update( const void *data, GLenum dataFormat, GLenum dataType, int mipLevel, int width, int height, int depth, int xOffset, int yOffset, int zOffset )
 {
+	context()->flushAutoBatch();
 	ScopedTextureBind tbs( mTarget, mTextureId );
 	glTexSubImage3D( mTarget, mipLevel, xOffset, yOffset, zOffset, width, height, depth, dataFormat, dataType, data );
 }
@@ -2076,6 +2086,7 @@ void TextureCubeMap::replace( const TextureData &textureData )
 	mWidth = textureData.getWidth();
 	mHeight = textureData.getHeight();
 
+	context()->flushAutoBatch();
 	ScopedTextureBind bindScope( mTarget, mTextureId );
 	if( textureData.getUnpackAlignment() != 0 )
 		glPixelStorei( GL_UNPACK_ALIGNMENT, textureData.getUnpackAlignment() );
@@ -2295,6 +2306,7 @@ void Texture2d::update( const TextureData &textureData )
 	if( textureData.getWidth() != mActualSize.x || textureData.getHeight() != mActualSize.y )
 		replace( textureData );
 	else {
+		context()->flushAutoBatch();
 		ScopedTextureBind bindScope( mTarget, mTextureId );
 		if( textureData.getUnpackAlignment() != 0 )
 			glPixelStorei( GL_UNPACK_ALIGNMENT, textureData.getUnpackAlignment() );
@@ -2319,6 +2331,7 @@ void Texture2d::replace( const TextureData &textureData )
 	mCleanBounds = Area( 0, 0, mActualSize.x, mActualSize.y );
 	mInternalFormat = textureData.getInternalFormat();
 
+	context()->flushAutoBatch();
 	ScopedTextureBind bindScope( mTarget, mTextureId );
 	if( textureData.getUnpackAlignment() != 0 )
 		glPixelStorei( GL_UNPACK_ALIGNMENT, textureData.getUnpackAlignment() );
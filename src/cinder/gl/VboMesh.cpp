@@ -25,7 +25,9 @@
 #include "cinder/gl/Context.h"
 #include "cinder/gl/ConstantConversions.h"
 #include "cinder/gl/Environment.h"
+#include "cinder/gl/scoped.h"
 #include "cinder/Log.h"
+#include "cinder/ThreadPool.h"
 
 using namespace std;
 
@@ -61,42 +63,81 @@ class VboMeshGeomTarget : public geom::Target {
   public:
 	struct BufferData {
 		BufferData( const geom::BufferLayout &layout, uint8_t *data, size_t dataSize )
-			: mLayout( layout ), mData( data ), mDataSize( dataSize )
+			: mLayout( layout ), mOwnedData( data ), mData( data ), mDataSize( dataSize )
+		{}
+		BufferData( const geom::BufferLayout &layout, const VboRef &mappedVbo, uint8_t *mappedData, size_t dataSize )
+			: mLayout( layout ), mData( mappedData ), mDataSize( dataSize ), mMappedVbo( mappedVbo )
 		{}
 		BufferData( BufferData &&rhs )
-			: mLayout( rhs.mLayout ), mData( std::move( rhs.mData ) ), mDataSize( rhs.mDataSize )
+			: mLayout( rhs.mLayout ), mOwnedData( std::move( rhs.mOwnedData ) ), mData( rhs.mData ), mDataSize( rhs.mDataSize ), mMappedVbo( std::move( rhs.mMappedVbo ) )
 		{}
 	
 		geom::BufferLayout			mLayout;
-		std::unique_ptr<uint8_t[]>	mData;
+		std::unique_ptr<uint8_t[]>	mOwnedData;
+		// points to either 'mOwnedData' or the mapped storage of 'mMappedVbo'
+		uint8_t						*mData;
 		size_t						mDataSize;
+		VboRef						mMappedVbo;
 	};
 
-	VboMeshGeomTarget( geom::Primitive prim, VboMesh *vboMesh )
-		: mPrimitive( prim ), mVboMesh( vboMesh )
+	//! Maps \a writeVbos, which parallel the VboMesh's vertex arrays and are either its own VBOs or staging buffers, so that the Source writes straight into them.
+	//! Any that are null or can't be mapped use temporary storage instead. \a deferIndices postpones uploading the indices to copyBuffers(), so that loadInto() makes no GL calls and can run on another thread.
+	VboMeshGeomTarget( geom::Primitive prim, VboMesh *vboMesh, const std::vector<VboRef> &writeVbos, bool deferIndices )
+		: mPrimitive( prim ), mVboMesh( vboMesh ), mDeferIndices( deferIndices ), mHasIndexData( false ), mIndexDataSize( 0 )
 	{
 		mVboMesh->mNumIndices = 0; // this may be replaced later with a copyIndices call
-		// create a vector of temporary data that parallels the VboMesh's vertexData
-		for( const auto &vertexArrayBuffer : mVboMesh->getVertexArrayLayoutVbos() ) {
-			size_t requiredBytes = vertexArrayBuffer.first.calcRequiredStorage( mVboMesh->mNumVertices );
-			mBufferData.push_back( BufferData( vertexArrayBuffer.first, new uint8_t[requiredBytes], requiredBytes ) );
+		// create a vector of data that parallels the VboMesh's vertexData
+		const auto &vertexArrayBuffers = mVboMesh->getVertexArrayLayoutVbos();
+		for( size_t i = 0; i < vertexArrayBuffers.size(); ++i ) {
+			const geom::BufferLayout &layout = vertexArrayBuffers[i].first;
+			size_t requiredBytes = layout.calcRequiredStorage( mVboMesh->mNumVertices );
+			uint8_t *mappedData = nullptr;
+#if defined( CINDER_GL_HAS_MAP_BUFFER_RANGE )
+			const VboRef &vbo = ( i < writeVbos.size() ) ? writeVbos[i] : VboRef();
+			if( vbo && requiredBytes > 0 && vbo->getSize() >= requiredBytes ) {
+				// only invalidate what we're about to replace, since a user-supplied VBO may hold more than this mesh
+				GLbitfield access = GL_MAP_WRITE_BIT | ( ( vbo->getSize() == requiredBytes ) ? GL_MAP_INVALIDATE_BUFFER_BIT : GL_MAP_INVALIDATE_RANGE_BIT );
+				mappedData = reinterpret_cast<uint8_t*>( vbo->mapBufferRange( 0, requiredBytes, access ) );
+				if( mappedData )
+					mBufferData.push_back( BufferData( layout, vbo, mappedData, requiredBytes ) );
+			}
+#endif
+			if( ! mappedData )
+				mBufferData.push_back( BufferData( layout, new uint8_t[requiredBytes], requiredBytes ) );
 		}
 	}
+
+	~VboMeshGeomTarget();
 	
 	virtual geom::Primitive	getPrimitive() const;
 	uint8_t	getAttribDims( geom::Attrib attr ) const override;
 	void	copyAttrib( geom::Attrib attr, uint8_t dims, size_t strideBytes, const float *srcData, size_t count ) override;
 	void	copyIndices( geom::Primitive primitive, const uint32_t *source, size_t numIndices, uint8_t requiredBytesPerIndex ) override;
+	float*	acquireAttribBuffer( geom::Attrib attr, uint8_t dims, size_t count, size_t *resultStrideBytes ) override;
 	
-	//! Must be called in order to upload temporary 'mBufferData' to VBOs
-	void	copyBuffers();
+	//! Must be called in order to upload temporary 'mBufferData' to VBOs, or to unmap them when they were written directly. Copies staging buffers into the VboMesh's VBOs.
+	//! Returns \c false if the contents of a mapped buffer were lost before it was unmapped, in which case the Source has to be loaded again.
+	bool	copyBuffers();
 	
   protected:
+	//! Creates or fills the VboMesh's index VBO from the indices converted by copyIndices()
+	void	uploadIndices();
+	//! Unmaps any buffers still mapped, which is only the case when copyBuffers() wasn't reached
+	void	unmapBuffers();
+
 	geom::Primitive				mPrimitive;
 	std::vector<BufferData>		mBufferData;
 	VboMesh						*mVboMesh;
+	bool						mDeferIndices, mHasIndexData;
+	std::unique_ptr<uint8_t[]>	mIndexData;
+	size_t						mIndexDataSize;
 };
 
+VboMeshGeomTarget::~VboMeshGeomTarget()
+{
+	unmapBuffers();
+}
+
 geom::Primitive	VboMeshGeomTarget::getPrimitive() const
 {
 	return mPrimitive;
@@ -122,7 +163,7 @@ void VboMeshGeomTarget::copyAttrib( geom::Attrib attr, uint8_t dims, size_t /*st
 			auto attrInfo = bufferData.mLayout.getAttribInfo( attr );
 			dstDims = attrInfo.getDims();
 			dstStride = attrInfo.getStride();
-			dstData = bufferData.mData.get() + attrInfo.getOffset();
+			dstData = bufferData.mData + attrInfo.getOffset();
 			dstDataSize = bufferData.mDataSize;
 			break;
 		}
@@ -146,6 +187,29 @@ void VboMeshGeomTarget::copyAttrib( geom::Attrib attr, uint8_t dims, size_t /*st
 		geom::copyData( dims, srcData, count, dstDims, dstStride, reinterpret_cast<float*>( dstData ) );
 }
 
+float* VboMeshGeomTarget::acquireAttribBuffer( geom::Attrib attr, uint8_t dims, size_t count, size_t *resultStrideBytes )
+{
+	// the Source writes straight into 'mBufferData' when no conversion is needed, so copyBuffers() uploads it as usual
+	if( count == 0 || count != mVboMesh->mNumVertices )
+		return nullptr;
+
+	for( const auto &bufferData : mBufferData ) {
+		if( bufferData.mLayout.hasAttrib( attr ) ) {
+			auto attrInfo = bufferData.mLayout.getAttribInfo( attr );
+			if( attrInfo.getDims() != dims || attrInfo.getDataType() != geom::DataType::FLOAT )
+				return nullptr;
+
+			*resultStrideBytes = attrInfo.getStride() ? attrInfo.getStride() : ( dims * sizeof(float) );
+			if( bufferData.mDataSize < attrInfo.getOffset() + ( count - 1 ) * *resultStrideBytes + dims * sizeof(float) )
+				return nullptr;
+
+			return reinterpret_cast<float*>( bufferData.mData + attrInfo.getOffset() );
+		}
+	}
+
+	return nullptr;
+}
+
 void VboMeshGeomTarget::copyIndices( geom::Primitive /*primitive*/, const uint32_t *source, size_t numIndices, uint8_t requiredBytesPerIndex )
 {
 // @TODO: Find a better way to handle this
@@ -158,35 +222,80 @@ void VboMeshGeomTarget::copyIndices( geom::Primitive /*primitive*/, const uint32
 
 	mVboMesh->mNumIndices = (uint32_t)numIndices;
 	if( mVboMesh->mNumIndices == 0 ) {
-		mVboMesh->mIndices.reset();
+		mIndexDataSize = 0;
 	}
 	else if( requiredBytesPerIndex <= 2 ) {
 		mVboMesh->mIndexType = GL_UNSIGNED_SHORT;
-		std::unique_ptr<uint16_t[]> indices( new uint16_t[numIndices] );
-		copyIndexData( source, numIndices, indices.get() );
-		if( ! mVboMesh->mIndices )
-			mVboMesh->mIndices = Vbo::create( GL_ELEMENT_ARRAY_BUFFER, numIndices * sizeof(uint16_t), indices.get() );
-		else
-			mVboMesh->mIndices->copyData( numIndices * sizeof(uint16_t), indices.get() );
+		mIndexDataSize = numIndices * sizeof(uint16_t);
+		mIndexData.reset( new uint8_t[mIndexDataSize] );
+		copyIndexData( source, numIndices, reinterpret_cast<uint16_t*>( mIndexData.get() ) );
 	}
 	else {
 		mVboMesh->mIndexType = GL_UNSIGNED_INT;
-		std::unique_ptr<uint32_t[]> indices( new uint32_t[numIndices] );
-		copyIndexData( source, numIndices, indices.get() );
-		if( ! mVboMesh->mIndices )
-			mVboMesh->mIndices = Vbo::create( GL_ELEMENT_ARRAY_BUFFER, numIndices * sizeof(uint32_t), indices.get() );
-		else
-			mVboMesh->mIndices->copyData( numIndices * sizeof(uint32_t), indices.get() );
+		mIndexDataSize = numIndices * sizeof(uint32_t);
+		mIndexData.reset( new uint8_t[mIndexDataSize] );
+		copyIndexData( source, numIndices, reinterpret_cast<uint32_t*>( mIndexData.get() ) );
 	}
+	mHasIndexData = true;
+
+	if( ! mDeferIndices )
+		uploadIndices();
 }
 
-void VboMeshGeomTarget::copyBuffers()
+void VboMeshGeomTarget::uploadIndices()
 {
+	if( mVboMesh->mNumIndices == 0 )
+		mVboMesh->mIndices.reset();
+	else if( ! mVboMesh->mIndices )
+		mVboMesh->mIndices = Vbo::create( GL_ELEMENT_ARRAY_BUFFER, mIndexDataSize, mIndexData.get() );
+	else
+		mVboMesh->mIndices->copyData( mIndexDataSize, mIndexData.get() );
+
+	mIndexData.reset();
+	mHasIndexData = false;
+}
+
+bool VboMeshGeomTarget::copyBuffers()
+{
+	bool succeeded = true;
 	// iterate all the buffers in mBufferData and upload them to the corresponding VBO in the VboMesh
 	for( auto bufferDataIt = mBufferData.begin(); bufferDataIt != mBufferData.end(); ++bufferDataIt ) {
 		auto vertexArrayIt = mVboMesh->mVertexArrayVbos.begin() + std::distance( mBufferData.begin(), bufferDataIt );
-		vertexArrayIt->second->copyData( bufferDataIt->mDataSize, bufferDataIt->mData.get() );
+		if( bufferDataIt->mMappedVbo ) {
+#if defined( CINDER_GL_HAS_MAP_BUFFER_RANGE )
+			if( ! bufferDataIt->mMappedVbo->unmap() )
+				succeeded = false;
+#endif
+#if ! defined( CINDER_GL_ES ) || defined( CINDER_GL_ES_3 )
+			// a staging buffer, which the GPU copies without another trip through client memory
+			if( succeeded && bufferDataIt->mMappedVbo != vertexArrayIt->second ) {
+				ScopedBuffer readBufferScp( GL_COPY_READ_BUFFER, bufferDataIt->mMappedVbo->getId() );
+				ScopedBuffer writeBufferScp( GL_COPY_WRITE_BUFFER, vertexArrayIt->second->getId() );
+				glCopyBufferSubData( GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, bufferDataIt->mDataSize );
+			}
+#endif
+			bufferDataIt->mMappedVbo.reset();
+		}
+		else
+			vertexArrayIt->second->copyData( bufferDataIt->mDataSize, bufferDataIt->mData );
 	}
+
+	if( mHasIndexData )
+		uploadIndices();
+
+	return succeeded;
+}
+
+void VboMeshGeomTarget::unmapBuffers()
+{
+#if defined( CINDER_GL_HAS_MAP_BUFFER_RANGE )
+	for( auto &bufferData : mBufferData ) {
+		if( bufferData.mMappedVbo ) {
+			bufferData.mMappedVbo->unmap();
+			bufferData.mMappedVbo.reset();
+		}
+	}
+#endif
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -253,6 +362,93 @@ void VboMesh::Layout::allocate( size_t numVertices, geom::BufferLayout *resultBu
 	}
 }
 
+///////////////////////////////////////////////////////////////////////////////////////
+// VboMesh::AsyncLoad
+#if ! defined( CINDER_GL_ES ) || defined( CINDER_GL_ES_3 )
+VboMesh::AsyncLoad::AsyncLoad( const geom::Source &source, std::vector<pair<Layout,VboRef>> vertexArrayBuffers )
+	: mSource( source.clone() ), mVboMesh( new VboMesh )
+{
+	// everything that needs the GL context happens here or in finishUpload(); the worker thread only runs the Source
+	mRequestedAttribs = mVboMesh->allocateVertexArrayVbos( *mSource, std::move( vertexArrayBuffers ) );
+	for( const auto &vertexArrayVbo : mVboMesh->mVertexArrayVbos ) {
+		size_t requiredBytes = vertexArrayVbo.first.calcRequiredStorage( mVboMesh->mNumVertices );
+		mStagingVbos.push_back( Vbo::create( GL_COPY_READ_BUFFER, requiredBytes, nullptr, GL_STREAM_DRAW ) );
+	}
+	mTarget.reset( new VboMeshGeomTarget( mSource->getPrimitive(), mVboMesh.get(), mStagingVbos, true ) );
+
+	auto loaded = make_shared<promise<void>>();
+	mLoaded = loaded->get_future();
+	ThreadPool::get()->submit( [this, loaded] {
+		try {
+			mSource->loadInto( mTarget.get(), mRequestedAttribs );
+			loaded->set_value();
+		}
+		catch( ... ) {
+			loaded->set_exception( current_exception() );
+		}
+	} );
+}
+
+VboMesh::AsyncLoad::~AsyncLoad()
+{
+	// the worker thread references 'this', and the staging buffers must be unmapped on this thread
+	if( mLoaded.valid() )
+		mLoaded.wait();
+	mTarget.reset();
+}
+
+bool VboMesh::AsyncLoad::isReady()
+{
+	if( mTarget ) {
+		if( mLoaded.wait_for( chrono::seconds( 0 ) ) != future_status::ready )
+			return false;
+		finishUpload();
+	}
+
+	if( mException )
+		return false;
+	// once the GPU is done copying, the staging buffers can be released
+	if( mFence && mFence->clientWaitSync() == GL_TIMEOUT_EXPIRED )
+		return false;
+	mFence.reset();
+	mStagingVbos.clear();
+	return true;
+}
+
+VboMeshRef VboMesh::AsyncLoad::getVboMesh()
+{
+	if( mTarget )
+		finishUpload();
+
+	if( mException )
+		rethrow_exception( mException );
+	return mVboMesh;
+}
+
+void VboMesh::AsyncLoad::finishUpload()
+{
+	try {
+		mLoaded.get();
+	}
+	catch( ... ) {
+		// the Source may have stopped partway through, so none of what it wrote is uploaded
+		mException = current_exception();
+		mTarget.reset();
+		mStagingVbos.clear();
+		return;
+	}
+
+	if( ! mTarget->copyBuffers() ) {
+		// the staging buffers' contents were lost while mapped, so run the Source again on this thread and upload from client memory
+		mTarget.reset( new VboMeshGeomTarget( mSource->getPrimitive(), mVboMesh.get(), vector<VboRef>(), false ) );
+		mSource->loadInto( mTarget.get(), mRequestedAttribs );
+		mTarget->copyBuffers();
+	}
+	mTarget.reset();
+	mFence = Sync::create();
+}
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////////////
 // VboMesh
 VboMeshRef VboMesh::create( const geom::Source &source )
@@ -295,7 +491,47 @@ VboMeshRef VboMesh::create( uint32_t numVertices, GLenum glPrimitive, const std:
 	return VboMeshRef( new VboMesh( numVertices, numIndices, glPrimitive, indexType, vertexArrayLayouts, indexVbo ) );
 }
 
+#if ! defined( CINDER_GL_ES ) || defined( CINDER_GL_ES_3 )
+VboMesh::AsyncLoadRef VboMesh::createAsync( const geom::Source &source )
+{
+	return AsyncLoadRef( new AsyncLoad( source, std::vector<pair<Layout,VboRef>>() ) );
+}
+
+VboMesh::AsyncLoadRef VboMesh::createAsync( const geom::Source &source, const std::vector<VboMesh::Layout> &vertexArrayLayouts )
+{
+	std::vector<std::pair<VboMesh::Layout,VboRef>> layoutVbos;
+	for( const auto &vertexArrayLayout : vertexArrayLayouts )
+		layoutVbos.push_back( std::make_pair( vertexArrayLayout, (VboRef)nullptr ) );
+
+	return AsyncLoadRef( new AsyncLoad( source, layoutVbos ) );
+}
+#endif
+
 VboMesh::VboMesh( const geom::Source &source, std::vector<pair<Layout,VboRef>> vertexArrayBuffers, const VboRef &indexArrayVbo )
+{
+	geom::AttribSet requestedAttribs = allocateVertexArrayVbos( source, std::move( vertexArrayBuffers ) );
+
+	// Set our indices VBO to indexArrayVBO, which may well be empty, so that the target doesn't blow it away. Must do this before we loadInto().
+	mIndices = indexArrayVbo;
+
+	// where buffers can be mapped, the Source writes straight into our VBOs rather than into temporary storage that is uploaded afterwards
+	vector<VboRef> writeVbos;
+#if defined( CINDER_GL_HAS_MAP_BUFFER_RANGE )
+	for( const auto &vertexArrayVbo : mVertexArrayVbos )
+		writeVbos.push_back( vertexArrayVbo.second );
+#endif
+	VboMeshGeomTarget target( source.getPrimitive(), this, writeVbos, false );
+	source.loadInto( &target, requestedAttribs );
+	// we need to let the target know it can copy from its internal buffers to our vertexData VBOs
+	if( ! target.copyBuffers() ) {
+		// the mapped contents were lost, so load them again into client memory and upload that instead
+		VboMeshGeomTarget reloadTarget( source.getPrimitive(), this, vector<VboRef>(), false );
+		source.loadInto( &reloadTarget, requestedAttribs );
+		reloadTarget.copyBuffers();
+	}
+}
+
+geom::AttribSet VboMesh::allocateVertexArrayVbos( const geom::Source &source, std::vector<pair<Layout,VboRef>> vertexArrayBuffers )
 {
 	// An empty vertexArrayBuffers implies we should just pull whatever attribs the Source is pushing. We arrived here from VboMesh::create( Source& )
 	if( vertexArrayBuffers.empty() ) {
@@ -334,14 +570,8 @@ VboMesh::VboMesh( const geom::Source &source, std::vector<pair<Layout,VboRef>> v
 		vertexArrayBuffer.first.allocate( mNumVertices, &bufferLayout, &vbo );
 		mVertexArrayVbos.push_back( make_pair( bufferLayout, vbo ) );
 	}
-	
-	// Set our indices VBO to indexArrayVBO, which may well be empty, so that the target doesn't blow it away. Must do this before we loadInto().
-	mIndices = indexArrayVbo;
-	
-	VboMeshGeomTarget target( source.getPrimitive(), this );
-	source.loadInto( &target, requestedAttribs );
-	// we need to let the target know it can copy from its internal buffers to our vertexData VBOs
-	target.copyBuffers();
+
+	return requestedAttribs;
 }
 
 VboMesh::VboMesh( uint32_t numVertices, uint32_t numIndices, GLenum glPrimitive, GLenum indexType, const std::vector<pair<geom::BufferLayout,VboRef>> &vertexArrayBuffers, const VboRef &indexVbo )
@@ -507,14 +737,15 @@ void VboMesh::buildVao( const GlslProg* shader, const AttribGlslMap &attributeMa
 
 void VboMesh::drawImpl( GLint first, GLsizei count )
 {
+	auto ctx = gl::context();
 	if( mIndices ) {
 		size_t firstByteOffset = first;
 		if( mIndexType == GL_UNSIGNED_INT ) firstByteOffset *= 4;
 		else if( mIndexType == GL_UNSIGNED_SHORT ) firstByteOffset *= 2;
-		glDrawElements( mGlPrimitive, ( count < 0 ) ? ( mNumIndices - first ) : count, mIndexType, (GLvoid*)( firstByteOffset ) );
+		ctx->drawElements( mGlPrimitive, ( count < 0 ) ? ( mNumIndices - first ) : count, mIndexType, (GLvoid*)( firstByteOffset ) );
 	}
 	else
-		glDrawArrays( mGlPrimitive, first, ( count < 0 ) ? ( mNumVertices - first ) : count );
+		ctx->drawArrays( mGlPrimitive, first, ( count < 0 ) ? ( mNumVertices - first ) : count );
 }
 
 #if defined( CINDER_GL_HAS_DRAW_INSTANCED )
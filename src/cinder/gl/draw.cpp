@@ -22,6 +22,7 @@
  */
 
 #include "cinder/gl/draw.h"
+#include "cinder/gl/AutoBatch.h"
 #include "cinder/gl/Context.h"
 #include "cinder/gl/Vao.h"
 #include "cinder/gl/VboMesh.h"
@@ -431,6 +432,11 @@ void drawLine( const vec3 &a, const vec3 &b )
 		return;
 	}
 
+	if( auto autoBatch = ctx->getAutoBatch() ) {
+		autoBatch->append( GL_LINES, points.data(), nullptr, nullptr, points.size() );
+		return;
+	}
+
 	ctx->pushVao();
 	ctx->getDefaultVao()->replacementBindBegin();
 
@@ -461,6 +467,11 @@ void drawLine( const vec2 &a, const vec2 &b )
 		return;
 	}
 
+	if( auto autoBatch = ctx->getAutoBatch() ) {
+		autoBatch->append( GL_LINES, points.data(), nullptr, nullptr, points.size() );
+		return;
+	}
+
 	ctx->pushVao();
 	ctx->getDefaultVao()->replacementBindBegin();
 
@@ -943,6 +954,11 @@ void drawSolidRect( const Rectf &r, const vec2 &upperLeftTexCoord, const vec2 &l
 	verts[3*2+0] = r.getX1(); texs[3*2+0] = upperLeftTexCoord.x;
 	verts[3*2+1] = r.getY2(); texs[3*2+1] = lowerRightTexCoord.y;
 
+	if( auto autoBatch = ctx->getAutoBatch() ) {
+		autoBatch->append( GL_TRIANGLE_STRIP, reinterpret_cast<const vec2*>( verts ), reinterpret_cast<const vec2*>( texs ), nullptr, 4 );
+		return;
+	}
+
 	ctx->pushVao();
 	ctx->getDefaultVao()->replacementBindBegin();
 	VboRef defaultVbo = ctx->getDefaultArrayVbo( sizeof(float)*16 );
@@ -985,6 +1001,11 @@ void drawStrokedRect( const Rectf &rect )
 		return;
 	}
 
+	if( auto autoBatch = ctx->getAutoBatch() ) {
+		autoBatch->append( GL_LINE_LOOP, reinterpret_cast<const vec2*>( verts ), nullptr, nullptr, 4 );
+		return;
+	}
+
 	ctx->pushVao();
 	ctx->getDefaultVao()->replacementBindBegin();
 
@@ -1032,6 +1053,11 @@ void drawStrokedRect( const Rectf &rect, float lineWidth )
 		return;
 	}
 
+	if( auto autoBatch = ctx->getAutoBatch() ) {
+		autoBatch->append( GL_TRIANGLE_STRIP, reinterpret_cast<const vec2*>( verts ), nullptr, nullptr, 16 );
+		return;
+	}
+
 	ctx->pushVao();
 	ctx->getDefaultVao()->replacementBindBegin();
 
@@ -1096,6 +1122,10 @@ void drawStrokedEllipse( const vec2 &center, float radiusX, float radiusY, int n
 		pos += unit * vec2( radiusX, radiusY );	// push out from center
 		t += tDelta;
 	}
+	if( auto autoBatch = ctx->getAutoBatch() ) {
+		autoBatch->append( GL_LINE_LOOP, positions.data(), nullptr, nullptr, positions.size() );
+		return;
+	}
 	// copy data to GPU
 	const size_t size = positions.size() * sizeof( vec2 );
 	auto arrayVbo = ctx->getDefaultArrayVbo( size );
@@ -1126,14 +1156,29 @@ void drawSolidCircle( const vec2 &center, float radius, int numSegments )
 		return;
 	}
 
-	ctx->pushVao();
-	ctx->getDefaultVao()->replacementBindBegin();
-
 	if( numSegments <= 0 )
 		numSegments = (int)math<double>::floor( radius * M_PI * 2 );
 	if( numSegments < 3 ) numSegments = 3;
 	size_t numVertices = numSegments + 2;
 
+	if( auto autoBatch = ctx->getAutoBatch() ) {
+		vector<vec2> verts( numVertices ), texCoords( numVertices );
+		vector<vec3> normals( numVertices, vec3( 0, 0, 1 ) );
+		verts[0] = center;
+		texCoords[0] = vec2( 0.5f, 0.5f );
+		const float tDelta = 1.0f / numSegments * 2 * (float)M_PI;
+		for( int s = 0; s <= numSegments; s++ ) {
+			const vec2 unit( math<float>::cos( s * tDelta ), math<float>::sin( s * tDelta ) );
+			verts[s+1] = center + unit * radius;
+			texCoords[s+1] = unit * 0.5f + vec2( 0.5f, 0.5f );
+		}
+		autoBatch->append( GL_TRIANGLE_FAN, verts.data(), texCoords.data(), normals.data(), numVertices );
+		return;
+	}
+
+	ctx->pushVao();
+	ctx->getDefaultVao()->replacementBindBegin();
+
 	size_t worstCaseSize = numVertices * sizeof(float) * ( 2 + 2 + 3 );
 	VboRef defaultVbo = ctx->getDefaultArrayVbo( worstCaseSize );
 	ScopedBuffer vboScp( defaultVbo );
@@ -1201,14 +1246,31 @@ void drawSolidEllipse( const vec2 &center, float radiusX, float radiusY, int num
 		return;
 	}
 
-	ctx->pushVao();
-	ctx->getDefaultVao()->replacementBindBegin();
-
 	if( numSegments <= 0 ) {
 		numSegments = (int)math<double>::floor( std::max(radiusX,radiusY) * M_PI * 2 );
 	}
 	if( numSegments < 2 ) numSegments = 2;
 	size_t numVertices = (numSegments+2)*2;
+
+	if( auto autoBatch = ctx->getAutoBatch() ) {
+		vector<vec2> verts( numSegments + 2 ), texCoords( numSegments + 2 );
+		vector<vec3> normals( numSegments + 2, vec3( 0, 0, 1 ) );
+		verts[0] = center;
+		texCoords[0] = vec2( 0.5f, 0.5f );
+		const float tDelta = 1.0f / numSegments * 2 * (float)M_PI;
+		float t = 0;
+		for( int s = 0; s <= numSegments; s++ ) {
+			const vec2 unit( math<float>::cos( t ), math<float>::sin( t ) );
+			verts[s+1] = center + unit * vec2( radiusX, radiusY );
+			texCoords[s+1] = unit * 0.5f + vec2( 0.5f, 0.5f );
+			t += tDelta;
+		}
+		autoBatch->append( GL_TRIANGLE_FAN, verts.data(), texCoords.data(), normals.data(), verts.size() );
+		return;
+	}
+
+	ctx->pushVao();
+	ctx->getDefaultVao()->replacementBindBegin();
 	
 	size_t worstCaseSize = numVertices * sizeof(float) * ( 2 + 2 + 3 );
 	VboRef defaultVbo = ctx->getDefaultArrayVbo( worstCaseSize );
@@ -1306,6 +1368,11 @@ void drawSolidTriangle( const vec2 pts[3], const vec2 texCoord[3] )
 		return;
 	}
 
+	if( auto autoBatch = ctx->getAutoBatch() ) {
+		autoBatch->append( GL_TRIANGLES, pts, texCoord, nullptr, 3 );
+		return;
+	}
+
 	GLfloat data[3*2+3*2]; // both verts and texCoords
 	memcpy( data, pts, sizeof(float) * 3 * 2 );
 	if( texCoord )
@@ -1358,6 +1425,11 @@ void drawSolidTriangle( const vec3 pts[3], const vec2 texCoord[3] )
 		return;
 	}
 
+	if( auto autoBatch = ctx->getAutoBatch() ) {
+		autoBatch->append( GL_TRIANGLES, pts, texCoord, nullptr, 3 );
+		return;
+	}
+
 	GLfloat data[3*3+3*2]; // both verts and texCoords
 	memcpy( data, pts, sizeof(float) * 3 * 3 );
 	if( texCoord )
@@ -22,6 +22,7 @@
  */
 
 #include "cinder/gl/scoped.h"
+#include "cinder/gl/AutoBatch.h"
 #include "cinder/gl/Context.h"
 #include "cinder/gl/BufferObj.h"
 #include "cinder/gl/Fbo.h"
@@ -513,6 +514,36 @@ ScopedFrontFace::~ScopedFrontFace()
 	mCtx->popFrontFace();
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////
+// ScopedAutoBatch
+ScopedAutoBatch::ScopedAutoBatch()
+	: mCtx( gl::context() )
+{
+	mCtx->pushAutoBatch();
+	mNumDrawsIssuedStart = mCtx->getAutoBatch()->getNumDrawsIssued();
+	mNumDrawsMergedStart = mCtx->getAutoBatch()->getNumDrawsMerged();
+}
+
+ScopedAutoBatch::~ScopedAutoBatch()
+{
+	mCtx->popAutoBatch();
+}
+
+void ScopedAutoBatch::flush()
+{
+	mCtx->flushAutoBatch();
+}
+
+size_t ScopedAutoBatch::getNumDrawsIssued() const
+{
+	return mCtx->getAutoBatch()->getNumDrawsIssued() - mNumDrawsIssuedStart;
+}
+
+size_t ScopedAutoBatch::getNumDrawsMerged() const
+{
+	return mCtx->getAutoBatch()->getNumDrawsMerged() - mNumDrawsMergedStart;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 // ScopedDebugGroup
 #if defined( CINDER_GL_HAS_KHR_DEBUG )
@@ -218,6 +218,8 @@ void clear( const ColorA& color, bool clearDepthBuffer )
 
 void clear( GLbitfield mask )
 {
+	// pending batched draws were made before the clear
+	context()->flushAutoBatch();
     glClear( mask );
 }
 
@@ -247,6 +249,8 @@ void clearStencil( const int s )
 
 void colorMask( GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha )
 {
+	// the Context doesn't track the color mask or stencil state, so pending batched draws are issued with the previous values first
+	context()->flushAutoBatch();
     glColorMask( red, green, blue, alpha );
 }
 
@@ -258,16 +262,19 @@ void depthMask( GLboolean flag )
 
 void stencilFunc( GLenum func, GLint ref, GLuint mask )
 {
+	context()->flushAutoBatch();
     glStencilFunc( func, ref, mask );
 }
 
 void stencilOp( GLenum fail, GLenum zfail, GLenum zpass )
 {
+	context()->flushAutoBatch();
     glStencilOp( fail, zfail, zpass );
 }
 
 void stencilMask( GLuint mask )
 {
+	context()->flushAutoBatch();
 	glStencilMask( mask );
 }
 
@@ -509,31 +516,31 @@ void multProjectionMatrix( const ci::mat4& mtx )
 
 mat4 getModelMatrix()
 {
-	auto ctx = gl::context();
+	const Context *ctx = gl::context();
 	return ctx->getModelMatrixStack().back();
 }
 
 mat4 getViewMatrix()
 {
-	auto ctx = gl::context();
+	const Context *ctx = gl::context();
 	return ctx->getViewMatrixStack().back();
 }
 
 mat4 getProjectionMatrix()
 {
-	auto ctx = gl::context();
+	const Context *ctx = gl::context();
 	return ctx->getProjectionMatrixStack().back();
 }
 
 mat4 getModelView()
 {
-	auto ctx = context();
+	const Context *ctx = context();
 	return ctx->getViewMatrixStack().back() * ctx->getModelMatrixStack().back();
 }
 
 mat4 getModelViewProjection()
 {
-	auto ctx = context();
+	const Context *ctx = context();
 	return ctx->getProjectionMatrixStack().back() * ctx->getViewMatrixStack().back() * ctx->getModelMatrixStack().back();
 }
 
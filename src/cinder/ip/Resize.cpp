@@ -25,8 +25,11 @@
 #include "cinder/Filter.h"
 #include "cinder/Rect.h"
 #include "cinder/ChanTraits.h"
+#include "cinder/System.h"
+#include "cinder/ThreadPool.h"
 
 #include <math.h>
+#include <string.h>
 #include <vector>
 using std::vector;
 using std::pair;
@@ -35,6 +38,24 @@ using std::unique_ptr;
 #include <fstream>
 #include <algorithm>
 
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+	#define CINDER_RESIZE_SSE2
+	#include <emmintrin.h>
+	#if defined( __SSE4_1__ )
+		#include <smmintrin.h>
+	#endif
+	// AVX2 is selected at runtime, so rather than enabling it for the whole build, it is enabled per function
+	#include <immintrin.h>
+	#if defined( __GNUC__ ) || defined( __clang__ )
+		#define CINDER_RESIZE_TARGET_AVX2 __attribute__(( target( "avx2" ) ))
+	#else
+		#define CINDER_RESIZE_TARGET_AVX2
+	#endif
+#elif defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+	#define CINDER_RESIZE_NEON
+	#include <arm_neon.h>
+#endif
+
 namespace cinder { namespace ip {
 
 template<typename T>
@@ -60,6 +81,24 @@ struct SCALETRAIT<uint8_t> {
 	static int32_t CHANNELTOBUFFER( const int32_t in ) { return in >> 8; }
 };
 
+// 16-bit channels accumulate in float; 16 bits of input times WEIGHTBITS of weight leaves no headroom in an int32_t for negative filter lobes
+template<>
+struct SCALETRAIT<uint16_t> {
+	typedef float SUMT;
+	static const float WEIGHTONE;		// filter weight of one
+	static uint16_t ACCUMTOCHANNEL( const float in ) {
+		float result = in + 0.5f;
+		if ( result < 0 )
+			result = 0;
+		else if ( result > 65535.0f )
+			result = 65535.0f;
+		return static_cast<uint16_t>( result );
+	}
+	static float CHANNELTOBUFFER( const float in ) { return in; }
+};
+
+const float SCALETRAIT<uint16_t>::WEIGHTONE = 1.0f;
+
 template<>
 struct SCALETRAIT<float> {
 	typedef float SUMT;
@@ -92,73 +131,336 @@ class WeightTable {		/* SAMPLED FILTER WEIGHT TABLE */
     T		*weight;		/* weight[i] goes with pixel at start+i */
 };
 
-template<typename LT, typename AT>
-void scanlineAccumulate( LT weight, LT *lineBuffer, int32_t lineBufferWidth, AT *accum );
+// A strided view of one or more interleaved components: either a single Channel, or every channel of an interleaved Surface
+template<typename T>
+struct PixelPlane {
+	PixelPlane( T *data, ptrdiff_t rowBytes, int32_t increment, int32_t numComponents )
+		: data( data ), rowBytes( rowBytes ), increment( increment ), numComponents( numComponents )
+	{}
+
+	T*	getData( int32_t x, int32_t y ) const	{ return (T*)( (const uint8_t*)data + y * rowBytes ) + x * increment; }
+
+	T			*data;
+	ptrdiff_t	rowBytes;
+	int32_t		increment;		// in units of T
+	int32_t		numComponents;	// filtered together, starting at each pixel's first element
+};
+
+// Everything about a resample that is shared by all row bands
+template<typename T>
+struct ResampleParams {
+	typedef typename SCALETRAIT<T>::SUMT SUMT;
+
+	const FilterBase				*filter;
+	FilterParams					filterParamsY;
+	Mapping							m;
+	int32_t							dstX, dstY, dstWidth, dstHeight;
+	int32_t							srcOffsetX, srcOffsetY, srcHeight;
+	vector<WeightTable<SUMT>>		xWeights;
+	unique_ptr<SUMT[]>				xWeightBuffer;
+	bool							xWeightsFitInt16;	// enables the 16-bit multiply-add SSE2 kernel
+};
+
 template<typename T, typename WT>
-void makeWeightTable( int32_t b, float cen, const FilterBase &filter, const FilterParams *params, int32_t len, bool trimzeros, WeightTable<WT> *wtab );
+void makeWeightTable( float cen, const FilterBase &filter, const FilterParams *params, int32_t len, bool trimzeros, WeightTable<WT> *wtab );
 
 template<typename AT, typename T>
-void scanlineShiftAccumToChannel( AT *accum, int32_t x1, int32_t y, int32_t width, ChannelT<T> *channel )
+void scanlineShiftAccumToPlane( const AT *accum, T *dst, int32_t pixelStride, int32_t numComponents, int32_t width )
 {
-	AT result;
-	T *dst;
-
-	dst = channel->getData( x1, y );
-	int8_t pixelStride = channel->getIncrement();
-
 	for( int32_t i = 0; i < width; i++ ) {
-		result = SCALETRAIT<T>::ACCUMTOCHANNEL( *accum++ );
-		*dst = static_cast<T>( result );
+		for( int32_t c = 0; c < numComponents; c++ )
+			dst[c] = static_cast<T>( SCALETRAIT<T>::ACCUMTOCHANNEL( *accum++ ) );
 		dst += pixelStride;
 	}
 }
 
 template<typename T, typename WT, typename AT>
-void scanlineFilterChannelToBuffer( WeightTable<WT> *weights, int32_t x, int32_t y, const ChannelT<T> &channel, AT *lineBuffer, int32_t width )
+void scanlineFilterToBuffer( const WeightTable<WT> *weights, const T *srcLine, int32_t pixelStride, int32_t numComponents, AT *lineBuffer, int32_t width )
 {
 	int32_t b, af;
 	AT sum;
-	AT *wp;
-	const T *srcLine, *src;
-
-	srcLine = channel.getData( x, y );
+	const WT *wp;
+	const T *src;
 
-	int8_t pixelStride = channel.getIncrement();
 	for ( b = 0; b < width; b++ ) {
-		if( std::numeric_limits<AT>::is_integer )
-			sum = 1 << 7;
-		else
-			sum = 0;
-		src = srcLine + weights->start * pixelStride;
-		wp = weights->weight;
-		for ( af = weights->start; af < weights->end; af++ ) {
-			sum += *wp++ * *src;
-			src += pixelStride;
+		for( int32_t c = 0; c < numComponents; c++ ) {
+			if( std::numeric_limits<AT>::is_integer )
+				sum = 1 << 7;
+			else
+				sum = 0;
+			src = srcLine + weights->start * pixelStride + c;
+			wp = weights->weight;
+			for ( af = weights->start; af < weights->end; af++ ) {
+				sum += *wp++ * *src;
+				src += pixelStride;
+			}
+			*lineBuffer++ = SCALETRAIT<T>::CHANNELTOBUFFER( sum );
 		}
-		*lineBuffer++ = SCALETRAIT<T>::CHANNELTOBUFFER( sum );
 		weights++;
 	}	
 }
 
-// assumes channels are of same dimensions
+#if defined( CINDER_RESIZE_SSE2 )
+
+// Low 32 bits of a 32x32 multiply; identical for signed and unsigned operands
+inline __m128i mullo32( __m128i a, __m128i b )
+{
+#if defined( __SSE4_1__ )
+	return _mm_mullo_epi32( a, b );
+#else
+	const __m128i even = _mm_mul_epu32( a, b );
+	const __m128i odd = _mm_mul_epu32( _mm_srli_epi64( a, 32 ), _mm_srli_epi64( b, 32 ) );
+	return _mm_unpacklo_epi32( _mm_shuffle_epi32( even, _MM_SHUFFLE( 0, 0, 2, 0 ) ), _mm_shuffle_epi32( odd, _MM_SHUFFLE( 0, 0, 2, 0 ) ) );
+#endif
+}
+
+// Filters all four components of a 4-byte pixel at once. Two source pixels are consumed per step by pairing them
+// up for _mm_madd_epi16(), which requires every weight to fit in an int16_t. Integer sums are exact, so the result
+// matches scanlineFilterToBuffer() bit for bit.
+void scanlineFilterRgba8( const WeightTable<int32_t> *weights, const uint8_t *srcLine, int32_t *lineBuffer, int32_t width )
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i rounding = _mm_set1_epi32( 1 << 7 );
+
+	for( int32_t b = 0; b < width; b++, weights++, lineBuffer += 4 ) {
+		const uint8_t *src = srcLine + weights->start * 4;
+		const int32_t *wp = weights->weight;
+		const int32_t n = weights->end - weights->start;
+
+		__m128i sum = rounding;
+		int32_t i = 0;
+		for( ; i + 1 < n; i += 2 ) {
+			__m128i px = _mm_unpacklo_epi8( _mm_loadl_epi64( (const __m128i*)( src + i * 4 ) ), zero );	// r0 g0 b0 a0 r1 g1 b1 a1
+			px = _mm_unpacklo_epi16( px, _mm_srli_si128( px, 8 ) );										// r0 r1 g0 g1 b0 b1 a0 a1
+			const uint32_t w = (uint32_t)(uint16_t)wp[i] | ( (uint32_t)(uint16_t)wp[i + 1] << 16 );
+			sum = _mm_add_epi32( sum, _mm_madd_epi16( px, _mm_set1_epi32( (int32_t)w ) ) );
+		}
+		if( i < n ) {
+			int32_t last;
+			memcpy( &last, src + i * 4, 4 );
+			const __m128i px = _mm_unpacklo_epi16( _mm_unpacklo_epi8( _mm_cvtsi32_si128( last ), zero ), zero );	// r 0 g 0 b 0 a 0
+			sum = _mm_add_epi32( sum, _mm_madd_epi16( px, _mm_set1_epi32( (uint16_t)wp[i] ) ) );
+		}
+
+		_mm_storeu_si128( (__m128i*)lineBuffer, _mm_srai_epi32( sum, 8 ) );
+	}
+}
+
+void scanlineFilterRgba32f( const WeightTable<float> *weights, const float *srcLine, float *lineBuffer, int32_t width )
+{
+	for( int32_t b = 0; b < width; b++, weights++, lineBuffer += 4 ) {
+		const float *src = srcLine + weights->start * 4;
+		const float *wp = weights->weight;
+		const int32_t n = weights->end - weights->start;
+
+		__m128 sum = _mm_setzero_ps();
+		for( int32_t i = 0; i < n; i++ )
+			sum = _mm_add_ps( sum, _mm_mul_ps( _mm_set1_ps( wp[i] ), _mm_loadu_ps( src + i * 4 ) ) );
+
+		_mm_storeu_ps( lineBuffer, sum );
+	}
+}
+
+// Cached, since System::hasAvx2() isn't safe to call from several threads at once
+bool cpuHasAvx2()
+{
+	static const bool sHasAvx2 = System::hasAvx2();
+	return sHasAvx2;
+}
+
+// The AVX2 parts of scanlineAccumulate(), which return how many elements they handled
+CINDER_RESIZE_TARGET_AVX2 int32_t scanlineAccumulateAvx2( int32_t weight, const int32_t *lineBuffer, int32_t width, int32_t *accum )
+{
+	int32_t x = 0;
+	const __m256i w8 = _mm256_set1_epi32( weight );
+	for( ; x + 8 <= width; x += 8 ) {
+		const __m256i product = _mm256_mullo_epi32( _mm256_loadu_si256( (const __m256i*)( lineBuffer + x ) ), w8 );
+		_mm256_storeu_si256( (__m256i*)( accum + x ), _mm256_add_epi32( _mm256_loadu_si256( (const __m256i*)( accum + x ) ), product ) );
+	}
+	return x;
+}
+
+CINDER_RESIZE_TARGET_AVX2 int32_t scanlineAccumulateAvx2( float weight, const float *lineBuffer, int32_t width, float *accum )
+{
+	int32_t x = 0;
+	const __m256 w8 = _mm256_set1_ps( weight );
+	for( ; x + 8 <= width; x += 8 )
+		_mm256_storeu_ps( accum + x, _mm256_add_ps( _mm256_loadu_ps( accum + x ), _mm256_mul_ps( _mm256_loadu_ps( lineBuffer + x ), w8 ) ) );
+	return x;
+}
+
+#elif defined( CINDER_RESIZE_NEON )
+
+void scanlineFilterRgba8( const WeightTable<int32_t> *weights, const uint8_t *srcLine, int32_t *lineBuffer, int32_t width )
+{
+	for( int32_t b = 0; b < width; b++, weights++, lineBuffer += 4 ) {
+		const uint8_t *src = srcLine + weights->start * 4;
+		const int32_t *wp = weights->weight;
+		const int32_t n = weights->end - weights->start;
+
+		int32x4_t sum = vdupq_n_s32( 1 << 7 );
+		for( int32_t i = 0; i < n; i++ ) {
+			uint32_t pixel;
+			memcpy( &pixel, src + i * 4, 4 );
+			const int32x4_t px = vreinterpretq_s32_u32( vmovl_u16( vget_low_u16( vmovl_u8( vcreate_u8( pixel ) ) ) ) );
+			sum = vmlaq_n_s32( sum, px, wp[i] );
+		}
+
+		vst1q_s32( lineBuffer, vshrq_n_s32( sum, 8 ) );
+	}
+}
+
+void scanlineFilterRgba32f( const WeightTable<float> *weights, const float *srcLine, float *lineBuffer, int32_t width )
+{
+	for( int32_t b = 0; b < width; b++, weights++, lineBuffer += 4 ) {
+		const float *src = srcLine + weights->start * 4;
+		const float *wp = weights->weight;
+		const int32_t n = weights->end - weights->start;
+
+		float32x4_t sum = vdupq_n_f32( 0 );
+		for( int32_t i = 0; i < n; i++ )
+			sum = vaddq_f32( sum, vmulq_n_f32( vld1q_f32( src + i * 4 ), wp[i] ) );
+
+		vst1q_f32( lineBuffer, sum );
+	}
+}
+
+#endif
+
+// Runs the horizontal pass for source row \a srcLine, choosing a vectorized kernel for 4-component interleaved pixels when available
+template<typename T>
+void filterScanline( const ResampleParams<T> &params, const T *srcLine, const PixelPlane<const T> &src, typename SCALETRAIT<T>::SUMT *lineBuffer )
+{
+	scanlineFilterToBuffer( params.xWeights.data(), srcLine, src.increment, src.numComponents, lineBuffer, params.dstWidth );
+}
+
+template<>
+void filterScanline<uint8_t>( const ResampleParams<uint8_t> &params, const uint8_t *srcLine, const PixelPlane<const uint8_t> &src, int32_t *lineBuffer )
+{
+#if defined( CINDER_RESIZE_SSE2 ) || defined( CINDER_RESIZE_NEON )
+	if( src.numComponents == 4 && src.increment == 4 && params.xWeightsFitInt16 ) {
+		scanlineFilterRgba8( params.xWeights.data(), srcLine, lineBuffer, params.dstWidth );
+		return;
+	}
+#endif
+	scanlineFilterToBuffer( params.xWeights.data(), srcLine, src.increment, src.numComponents, lineBuffer, params.dstWidth );
+}
+
+template<>
+void filterScanline<float>( const ResampleParams<float> &params, const float *srcLine, const PixelPlane<const float> &src, float *lineBuffer )
+{
+#if defined( CINDER_RESIZE_SSE2 ) || defined( CINDER_RESIZE_NEON )
+	if( src.numComponents == 4 && src.increment == 4 ) {
+		scanlineFilterRgba32f( params.xWeights.data(), srcLine, lineBuffer, params.dstWidth );
+		return;
+	}
+#endif
+	scanlineFilterToBuffer( params.xWeights.data(), srcLine, src.increment, src.numComponents, lineBuffer, params.dstWidth );
+}
+
+void scanlineAccumulate( int32_t weight, const int32_t *lineBuffer, int32_t width, int32_t *accum )
+{
+	int32_t x = 0;
+#if defined( CINDER_RESIZE_SSE2 )
+	if( cpuHasAvx2() )
+		x = scanlineAccumulateAvx2( weight, lineBuffer, width, accum );
+	const __m128i w4 = _mm_set1_epi32( weight );
+	for( ; x + 4 <= width; x += 4 ) {
+		const __m128i product = mullo32( _mm_loadu_si128( (const __m128i*)( lineBuffer + x ) ), w4 );
+		_mm_storeu_si128( (__m128i*)( accum + x ), _mm_add_epi32( _mm_loadu_si128( (const __m128i*)( accum + x ) ), product ) );
+	}
+#elif defined( CINDER_RESIZE_NEON )
+	for( ; x + 4 <= width; x += 4 )
+		vst1q_s32( accum + x, vmlaq_n_s32( vld1q_s32( accum + x ), vld1q_s32( lineBuffer + x ), weight ) );
+#endif
+	for( ; x < width; x++ )
+		accum[x] += lineBuffer[x] * weight;
+}
+
+void scanlineAccumulate( float weight, const float *lineBuffer, int32_t width, float *accum )
+{
+	int32_t x = 0;
+#if defined( CINDER_RESIZE_SSE2 )
+	if( cpuHasAvx2() )
+		x = scanlineAccumulateAvx2( weight, lineBuffer, width, accum );
+	const __m128 w4 = _mm_set1_ps( weight );
+	for( ; x + 4 <= width; x += 4 )
+		_mm_storeu_ps( accum + x, _mm_add_ps( _mm_loadu_ps( accum + x ), _mm_mul_ps( _mm_loadu_ps( lineBuffer + x ), w4 ) ) );
+#elif defined( CINDER_RESIZE_NEON )
+	for( ; x + 4 <= width; x += 4 )
+		vst1q_f32( accum + x, vaddq_f32( vld1q_f32( accum + x ), vmulq_n_f32( vld1q_f32( lineBuffer + x ), weight ) ) );
+#endif
+	for( ; x < width; x++ )
+		accum[x] += lineBuffer[x] * weight;
+}
+
+// Resamples destination rows [dstYBegin, dstYEnd). Each call owns its line cache, so bands can run concurrently;
+// source rows under the filter support at a band's edges are simply filtered once by each neighbouring band.
 template<typename T>
-void resample( const vector<const ChannelT<T>*> &srcChannels, const FilterBase &filter, const Area &srcArea, const Area &dstArea, const vector<ChannelT<T>*> &dstChannels )
+void resampleRows( const ResampleParams<T> &params, const PixelPlane<const T> &src, const PixelPlane<T> &dst, int32_t dstYBegin, int32_t dstYEnd )
 {
+	typedef typename SCALETRAIT<T>::SUMT SUMT;
+
+	const int32_t lineWidth = params.dstWidth * src.numComponents;
+	const int32_t filterWidthY = params.filterParamsY.width;
+
+	vector<pair<int32_t,unique_ptr<SUMT[]>>> linesBuffer;
+	for( int32_t i = 0; i < filterWidthY; i++ )
+		linesBuffer.push_back( std::make_pair( -1, unique_ptr<SUMT[]>( new SUMT[lineWidth] ) ) );
+
+	unique_ptr<SUMT[]> yWeightBuffer( new SUMT[filterWidthY] );
+	unique_ptr<SUMT[]> accum( new SUMT[lineWidth] );
+	WeightTable<SUMT> yWeights;
+	yWeights.weight = yWeightBuffer.get();
+
+	for ( int32_t dstY = dstYBegin; dstY < dstYEnd; ++dstY ) {     // loop over dest scanlines
+		// prepare a weight table for dest y position by
+		makeWeightTable<T,SUMT>( MAP(dstY, params.m.sy, params.m.uy), *params.filter, &params.filterParamsY, params.srcHeight, false, &yWeights );
+
+		memset( accum.get(), 0, sizeof(SUMT) * lineWidth );
+
+		// loop over source scanlines that influence this dest scanline
+		for ( int32_t ayf = yWeights.start; ayf < yWeights.end; ayf++ ) {
+			auto &cachedLine = linesBuffer[ayf % filterWidthY];
+			if( cachedLine.first != ayf ) {
+				filterScanline( params, src.getData( params.srcOffsetX, params.srcOffsetY + ayf ), src, cachedLine.second.get() );
+				cachedLine.first = ayf;
+			}
+			scanlineAccumulate( yWeights.weight[ayf - yWeights.start], cachedLine.second.get(), lineWidth, accum.get() );
+		}
+
+		scanlineShiftAccumToPlane( accum.get(), dst.getData( params.dstX, params.dstY + dstY ), dst.increment, dst.numComponents, params.dstWidth );
+	}
+}
+
+// assumes planes are of same dimensions
+template<typename T>
+void resample( const vector<PixelPlane<const T>> &srcPlanes, const Area &srcBounds, const FilterBase &filter, const Area &srcArea, const Area &dstArea, const vector<PixelPlane<T>> &dstPlanes, const Area &dstBounds )
+{
+	typedef typename SCALETRAIT<T>::SUMT SUMT;
+
 	Rectf clippedSrcRect;
 	Area clippedDstArea;
-	getClippedScaledRects( srcChannels[0]->getBounds(), Rectf( srcArea ), dstChannels[0]->getBounds(), dstArea, &clippedSrcRect, &clippedDstArea );
+	getClippedScaledRects( srcBounds, Rectf( srcArea ), dstBounds, dstArea, &clippedSrcRect, &clippedDstArea );
 	
 	if ( ( clippedSrcRect.getWidth() <= 0 ) || ( clippedDstArea.getWidth() <= 0 ) 
 		|| ( clippedSrcRect.getHeight() <= 0 ) || ( clippedDstArea.getHeight() <= 0 ) )
 		return;
 	
-	FilterParams filterParamsX, filterParamsY;
-	Mapping m;
+	ResampleParams<T> params;
+	FilterParams filterParamsX;
+	Mapping &m = params.m;
 	int32_t dstWidth = (int32_t)clippedDstArea.getWidth(), dstHeight = (int32_t)clippedDstArea.getHeight();
 	int32_t srcWidth = (int32_t)clippedSrcRect.getWidth(), srcHeight = (int32_t)clippedSrcRect.getHeight();
-	int32_t srcOffsetX = static_cast<int32_t>( floor( clippedSrcRect.getX1() ) );
-	int32_t srcOffsetY = static_cast<int32_t>( floor( clippedSrcRect.getY1() ) );
-	vector<pair<int32_t,unique_ptr<typename SCALETRAIT<T>::SUMT[]>>> linesBuffer;
+
+	params.filter = &filter;
+	params.dstX = clippedDstArea.getX1();
+	params.dstY = clippedDstArea.getY1();
+	params.dstWidth = dstWidth;
+	params.dstHeight = dstHeight;
+	params.srcOffsetX = static_cast<int32_t>( floor( clippedSrcRect.getX1() ) );
+	params.srcOffsetY = static_cast<int32_t>( floor( clippedSrcRect.getY1() ) );
+	params.srcHeight = srcHeight;
 
 	m.sx = dstWidth / (float)srcWidth;
 	m.sy = dstHeight / (float)srcHeight;
@@ -171,60 +473,36 @@ void resample( const vector<const ChannelT<T>*> &srcChannels, const FilterBase &
 	filterParamsX.supp = std::max( 0.5f, filterParamsX.scale * filter.getSupport() );
 	filterParamsX.width = (int32_t)ceil( 2.0f * filterParamsX.supp );
 
-	filterParamsY.scale = std::max( 1.0f, 1.0f / m.sy );
-	filterParamsY.supp = std::max( 0.5f, filterParamsY.scale * filter.getSupport() );
-	filterParamsY.width = (int32_t)ceil( 2.0f * filterParamsY.supp );
-
-	for( int32_t i = 0; i < filterParamsY.width; i++ )
-		linesBuffer.push_back( std::make_pair( -1, unique_ptr<typename SCALETRAIT<T>::SUMT[]>( new typename SCALETRAIT<T>::SUMT[dstWidth] ) ) );
+	params.filterParamsY.scale = std::max( 1.0f, 1.0f / m.sy );
+	params.filterParamsY.supp = std::max( 0.5f, params.filterParamsY.scale * filter.getSupport() );
+	params.filterParamsY.width = (int32_t)ceil( 2.0f * params.filterParamsY.supp );
 
-	WeightTable<typename SCALETRAIT<T>::SUMT> *xWeights, yWeights;
-	typename SCALETRAIT<T>::SUMT *xWeightBuffer, *xWeightPtr;
-	xWeights = (WeightTable<typename SCALETRAIT<T>::SUMT>*)malloc( sizeof(WeightTable<int32_t>) * dstWidth );
-	xWeightBuffer = (typename SCALETRAIT<T>::SUMT*)malloc( sizeof(typename SCALETRAIT<T>::SUMT) * dstWidth * filterParamsX.width );
-	yWeights.weight = (typename SCALETRAIT<T>::SUMT*)malloc( sizeof(typename SCALETRAIT<T>::SUMT) * filterParamsY.width );
-	unique_ptr<typename SCALETRAIT<T>::SUMT[]> accum = unique_ptr<typename SCALETRAIT<T>::SUMT[]>( new typename SCALETRAIT<T>::SUMT[dstWidth] );
+	params.xWeights.resize( dstWidth );
+	params.xWeightBuffer = unique_ptr<SUMT[]>( new SUMT[dstWidth * filterParamsX.width] );
+	params.xWeightsFitInt16 = true;
 
-	xWeightPtr = xWeightBuffer;
+	SUMT *xWeightPtr = params.xWeightBuffer.get();
 	for ( int32_t bx = 0; bx < dstWidth; bx++, xWeightPtr += filterParamsX.width ) {
-		xWeights[bx].weight = xWeightPtr;
-		makeWeightTable<T,typename SCALETRAIT<T>::SUMT>( MAP(bx, m.sx, m.ux), filter, &filterParamsX, srcWidth, true, &xWeights[bx] );
-	}
-
-	for( size_t chan = 0; chan < srcChannels.size(); ++chan ) {
-		for ( int32_t dstY = 0; dstY < dstHeight; ++dstY ) {     // loop over dest scanlines
-			// prepare a weight table for dest y position by
-			makeWeightTable<T,typename SCALETRAIT<T>::SUMT>( MAP(dstY, m.sy, m.uy), filter, &filterParamsY, srcHeight, false, &yWeights );
-
-			memset( accum.get(), 0, sizeof(int32_t) * dstWidth );
-
-			// loop over source scanlines that influence this dest scanline
-			for ( int32_t ayf = yWeights.start; ayf < yWeights.end; ayf++ ) {
-				typename SCALETRAIT<T>::SUMT *line = linesBuffer[ayf % filterParamsY.width].second.get();
-				if( linesBuffer[ayf % filterParamsY.width].first != ayf ) {
-					scanlineFilterChannelToBuffer( xWeights, srcOffsetX, srcOffsetY + ayf, *(srcChannels[chan]), line, dstWidth );
-					linesBuffer[ayf % filterParamsY.width].first = ayf;
-				}
-				scanlineAccumulate<typename SCALETRAIT<T>::SUMT,typename SCALETRAIT<T>::SUMT>( yWeights.weight[ayf - yWeights.start], line, dstWidth, accum.get() );
-			}
-
-			scanlineShiftAccumToChannel( accum.get(), clippedDstArea.getX1(), clippedDstArea.getY1() + dstY, dstWidth, dstChannels[chan] );
+		WeightTable<SUMT> &xWeights = params.xWeights[bx];
+		xWeights.weight = xWeightPtr;
+		makeWeightTable<T,SUMT>( MAP(bx, m.sx, m.ux), filter, &filterParamsX, srcWidth, true, &xWeights );
+		for( int32_t i = 0; i < xWeights.end - xWeights.start; i++ ) {
+			if( xWeights.weight[i] < std::numeric_limits<int16_t>::min() || xWeights.weight[i] > std::numeric_limits<int16_t>::max() )
+				params.xWeightsFitInt16 = false;
 		}
 	}
 
-	free( xWeights );
-	free( xWeightBuffer );
-	free( yWeights.weight );
-}
-
-template<typename LT, typename AT>
-void scanlineAccumulate( LT weight, LT *lineBuffer, int32_t width, AT *accum )
-{
-	AT *dest = accum;
-	int32_t x;
-
-	for ( x = 0; x < width; x++ )
-		*dest++ += *lineBuffer++ * weight;
+	auto resampleBand = [&]( size_t dstYBegin, size_t dstYEnd ) {
+		for( size_t plane = 0; plane < srcPlanes.size(); ++plane )
+			resampleRows( params, srcPlanes[plane], dstPlanes[plane], (int32_t)dstYBegin, (int32_t)dstYEnd );
+	};
+
+	// split the destination into bands of rows across the shared ThreadPool once there is enough work to amortize the hand-off
+	const int32_t minRowsPerBand = 16;
+	if( dstWidth * dstHeight >= 256 * 256 && dstHeight >= 2 * minRowsPerBand )
+		ThreadPool::get()->parallelFor( 0, dstHeight, minRowsPerBand, resampleBand );
+	else
+		resampleBand( 0, dstHeight );
 }
 
 template<typename T, typename WT>
@@ -307,36 +585,61 @@ void makeWeightTable( float cen, const FilterBase &filter, const FilterParams *p
 	}   
 }
 
+namespace {
+
+template<typename T>
+PixelPlane<T> channelPlane( ChannelT<T> &channel )
+{
+	return PixelPlane<T>( channel.getData(), channel.getRowBytes(), channel.getIncrement(), 1 );
+}
+
+template<typename T>
+PixelPlane<const T> channelPlane( const ChannelT<T> &channel )
+{
+	return PixelPlane<const T>( channel.getData(), channel.getRowBytes(), channel.getIncrement(), 1 );
+}
+
+} // anonymous namespace
+
 template<typename T>
 void resize( const SurfaceT<T> &srcSurface, const Area &srcArea, SurfaceT<T> *dstSurface, const Area &dstArea, const FilterBase &filter )
 {
-	vector<const ChannelT<T>*> srcChannels;
-	vector<ChannelT<T>*> dstChannels;
-
-	srcChannels.push_back( &srcSurface.getChannelRed() );
-	dstChannels.push_back( &dstSurface->getChannelRed() );
-	srcChannels.push_back( &srcSurface.getChannelGreen() );
-	dstChannels.push_back( &dstSurface->getChannelGreen() );
-	srcChannels.push_back( &srcSurface.getChannelBlue() );
-	dstChannels.push_back( &dstSurface->getChannelBlue() );
-	if ( srcSurface.hasAlpha() && dstSurface->hasAlpha() ) {
-		srcChannels.push_back( &srcSurface.getChannelAlpha() );
-		dstChannels.push_back( &dstSurface->getChannelAlpha() );	
+	vector<PixelPlane<const T>> srcPlanes;
+	vector<PixelPlane<T>> dstPlanes;
+
+	const bool sameLayout = srcSurface.getChannelOrder() == dstSurface->getChannelOrder() && srcSurface.hasAlpha() == dstSurface->hasAlpha();
+	if( sameLayout && srcSurface.getPixelInc() == ( srcSurface.hasAlpha() ? 4 : 3 ) ) {
+		// every element of a pixel is a channel we want, so filter whole pixels in a single pass over each row
+		const int32_t numComponents = srcSurface.getPixelInc();
+		srcPlanes.push_back( PixelPlane<const T>( srcSurface.getData(), srcSurface.getRowBytes(), numComponents, numComponents ) );
+		dstPlanes.push_back( PixelPlane<T>( dstSurface->getData(), dstSurface->getRowBytes(), numComponents, numComponents ) );
+	}
+	else {
+		srcPlanes.push_back( channelPlane( srcSurface.getChannelRed() ) );
+		dstPlanes.push_back( channelPlane( dstSurface->getChannelRed() ) );
+		srcPlanes.push_back( channelPlane( srcSurface.getChannelGreen() ) );
+		dstPlanes.push_back( channelPlane( dstSurface->getChannelGreen() ) );
+		srcPlanes.push_back( channelPlane( srcSurface.getChannelBlue() ) );
+		dstPlanes.push_back( channelPlane( dstSurface->getChannelBlue() ) );
+		if ( srcSurface.hasAlpha() && dstSurface->hasAlpha() ) {
+			srcPlanes.push_back( channelPlane( srcSurface.getChannelAlpha() ) );
+			dstPlanes.push_back( channelPlane( dstSurface->getChannelAlpha() ) );
+		}
 	}
 
-	resample( srcChannels, filter, srcArea, dstArea, dstChannels );
+	resample( srcPlanes, srcSurface.getBounds(), filter, srcArea, dstArea, dstPlanes, dstSurface->getBounds() );
 }
 
 template<typename T>
 void resize( const ChannelT<T> &srcChannel, const Area &srcArea, ChannelT<T> *dstChannel, const Area &dstArea, const FilterBase &filter )
 {
-	vector<const ChannelT<T>*> srcChannels;
-	vector<ChannelT<T>*> dstChannels;
+	vector<PixelPlane<const T>> srcPlanes;
+	vector<PixelPlane<T>> dstPlanes;
 	
-	srcChannels.push_back( &srcChannel );
-	dstChannels.push_back( dstChannel );
+	srcPlanes.push_back( channelPlane( srcChannel ) );
+	dstPlanes.push_back( channelPlane( *dstChannel ) );
 	
-	resample( srcChannels, filter, srcArea, dstArea, dstChannels );
+	resample( srcPlanes, srcChannel.getBounds(), filter, srcArea, dstArea, dstPlanes, dstChannel->getBounds() );
 }
 
 template<typename T>
@@ -366,8 +669,8 @@ void resize( const ChannelT<T> &srcChannel, ChannelT<T> *dstChannel, const Filte
 	template CI_API SurfaceT<T> resizeCopy( const SurfaceT<T> &srcSurface, const Area &srcArea, const ivec2 &dstSize, const FilterBase &filter ); \
 	template CI_API void resize( const ChannelT<T> &srcChannel, const Area &srcArea, ChannelT<T> *dstChannel, const Area &dstArea, const FilterBase &filter );
 
-// These should match CHANNEL_TYPES
 resize_PROTOTYPES(uint8_t)
+resize_PROTOTYPES(uint16_t)
 resize_PROTOTYPES(float)
 
 } } // namespace cinder::ip
@@ -0,0 +1,117 @@
+// Measures throughput of ConcurrentCircularBuffer, which locks a mutex on every call, against LockFreeConcurrentCircularBuffer
+// with 1 to 16 producer threads and as many consumer threads passing items through blocking pushFront() / popBack(). Each
+// configuration also checks that every item came out exactly once. Results are printed to the console and drawn.
+
+#include "cinder/app/App.h"
+#include "cinder/app/RendererGl.h"
+#include "cinder/gl/gl.h"
+
+#include "cinder/ConcurrentCircularBuffer.h"
+#include "cinder/Timer.h"
+
+#include <atomic>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+const size_t	CAPACITY = 1024;
+const size_t	NUM_ITEMS = 2000000;
+const size_t	NUM_ITERATIONS = 3;
+
+class ConcurrentCircularBufferBenchmarkApp : public App {
+  public:
+	void setup() override;
+	void draw() override;
+
+	//! Pushes NUM_ITEMS through a BufferT with \a numThreads producers and \a numThreads consumers, returning the best
+	//! items per second over NUM_ITERATIONS runs. \a valid is set to false if any run loses or duplicates items.
+	template<typename BufferT>
+	double measure( size_t numThreads, bool *valid );
+
+	vector<string>	mResults;
+};
+
+void ConcurrentCircularBufferBenchmarkApp::setup()
+{
+	mResults.push_back( to_string( NUM_ITEMS ) + " items through a buffer of capacity " + to_string( CAPACITY ) + ", " + to_string( thread::hardware_concurrency() ) + " hardware threads" );
+	for( size_t numThreads : { 1, 2, 4, 8, 16 } ) {
+		bool valid = true;
+		double mutexRate = measure<ConcurrentCircularBuffer<uint64_t>>( numThreads, &valid );
+		double lockFreeRate = measure<LockFreeConcurrentCircularBuffer<uint64_t>>( numThreads, &valid );
+
+		ostringstream line;
+		line << setw( 2 ) << numThreads << " producers, " << setw( 2 ) << numThreads << " consumers   " << fixed << setprecision( 2 );
+		line << "mutex: " << setw( 6 ) << mutexRate / 1e6 << " M items/s   ";
+		line << "lock-free: " << setw( 6 ) << lockFreeRate / 1e6 << " M items/s (" << lockFreeRate / mutexRate << "x)";
+		if( ! valid )
+			line << "   ITEMS LOST OR DUPLICATED";
+		mResults.push_back( line.str() );
+	}
+
+	for( const auto &result : mResults )
+		console() << result << endl;
+}
+
+template<typename BufferT>
+double ConcurrentCircularBufferBenchmarkApp::measure( size_t numThreads, bool *valid )
+{
+	const size_t numItemsPerThread = NUM_ITEMS / numThreads;
+	const uint64_t numItems = numItemsPerThread * numThreads;
+
+	double result = 0;
+	for( size_t iteration = 0; iteration < NUM_ITERATIONS; iteration++ ) {
+		BufferT buffer( CAPACITY );
+		atomic<uint64_t> sum( 0 );
+
+		Timer timer( true );
+		vector<thread> threads;
+		for( size_t i = 0; i < numThreads; i++ ) {
+			threads.emplace_back( [&, i] {
+				for( size_t j = 0; j < numItemsPerThread; j++ )
+					buffer.pushFront( i * numItemsPerThread + j + 1 );
+			} );
+			threads.emplace_back( [&] {
+				uint64_t threadSum = 0;
+				for( size_t j = 0; j < numItemsPerThread; j++ ) {
+					uint64_t item;
+					buffer.popBack( &item );
+					threadSum += item;
+				}
+				sum += threadSum;
+			} );
+		}
+		for( auto &thread : threads )
+			thread.join();
+
+		result = max( result, numItems / timer.getSeconds() );
+		if( sum != numItems * ( numItems + 1 ) / 2 )
+			*valid = false;
+	}
+
+	return result;
+}
+
+void ConcurrentCircularBufferBenchmarkApp::draw()
+{
+	gl::clear();
+	gl::setMatricesWindow( getWindowSize() );
+
+	vec2 pos( 20, 20 );
+	for( const auto &result : mResults ) {
+		gl::drawString( result, pos );
+		pos.y += 20;
+	}
+}
+
+auto settingsFunc = []( App::Settings *settings ) {
+	settings->setWindowSize( 900, 200 );
+#if defined( CINDER_MSW )
+	settings->setConsoleWindowEnabled();
+#endif
+};
+
+CINDER_APP( ConcurrentCircularBufferBenchmarkApp, RendererGl, settingsFunc )
@@ -0,0 +1,102 @@
+// Compares a chain of cinder::ip operations (grayscale, stackBlur, edgeDetectSobel, threshold) run as sequential
+// full-image passes against the same chain run by ip::Executor, which processes cache-sized bands in parallel.
+// Drop an image on the window to benchmark it, otherwise a generated 4096x4096 image is used.
+
+#include "cinder/app/App.h"
+#include "cinder/app/RendererGl.h"
+#include "cinder/gl/gl.h"
+#include "cinder/ImageIo.h"
+#include "cinder/Rand.h"
+#include "cinder/Timer.h"
+#include "cinder/ip/Executor.h"
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+const int		BLUR_RADIUS = 4;
+const uint8_t	EDGE_THRESHOLD = 40;
+
+class IpExecutorBenchmarkApp : public App {
+  public:
+	void setup() override;
+	void fileDrop( FileDropEvent event ) override;
+	void draw() override;
+
+	void runBenchmark( const Surface8u &source );
+
+	vector<string>		mResults;
+	gl::Texture2dRef	mTexture;
+};
+
+void IpExecutorBenchmarkApp::setup()
+{
+	Surface8u source( 4096, 4096, false );
+	Rand rnd( 1234 );
+	auto iter = source.getIter();
+	while( iter.line() ) {
+		while( iter.pixel() ) {
+			iter.r() = uint8_t( ( iter.x() ^ iter.y() ) & 0xff );
+			iter.g() = uint8_t( rnd.nextUint( 256 ) );
+			iter.b() = uint8_t( ( iter.x() * iter.y() ) >> 6 );
+		}
+	}
+
+	runBenchmark( source );
+}
+
+void IpExecutorBenchmarkApp::fileDrop( FileDropEvent event )
+{
+	runBenchmark( Surface8u( loadImage( event.getFile( 0 ) ) ) );
+}
+
+void IpExecutorBenchmarkApp::runBenchmark( const Surface8u &source )
+{
+	mResults.clear();
+	mResults.push_back( to_string( source.getWidth() ) + "x" + to_string( source.getHeight() ) + ", " + to_string( ThreadPool::get()->getNumThreads() + 1 ) + " threads" );
+
+	Surface8u sequential = source.clone();
+	Timer timer( true );
+	ip::grayscale( sequential, &sequential );
+	ip::stackBlur( &sequential, BLUR_RADIUS );
+	Surface8u edges = sequential.clone();
+	ip::edgeDetectSobel( sequential, &edges );
+	ip::threshold( edges, EDGE_THRESHOLD, &edges );
+	double sequentialSeconds = timer.getSeconds();
+
+	ip::Executor<Surface8u> executor;
+	executor.grayscale().stackBlur( BLUR_RADIUS ).edgeDetectSobel().threshold( EDGE_THRESHOLD );
+	Surface8u chained = source.clone();
+	timer.start();
+	executor.run( &chained );
+	double chainedSeconds = timer.getSeconds();
+
+	bool identical = true;
+	for( int32_t y = 0; y < edges.getHeight() && identical; ++y )
+		identical = memcmp( edges.getData( ivec2( 0, y ) ), chained.getData( ivec2( 0, y ) ), edges.getWidth() * edges.getPixelInc() ) == 0;
+
+	mResults.push_back( "sequential passes: " + to_string( sequentialSeconds * 1000 ) + " ms" );
+	mResults.push_back( "ip::Executor: " + to_string( chainedSeconds * 1000 ) + " ms (" + to_string( sequentialSeconds / chainedSeconds ) + "x)" );
+	mResults.push_back( identical ? "results identical" : "RESULTS DIFFER" );
+	for( const auto &result : mResults )
+		console() << result << endl;
+
+	mTexture = gl::Texture2d::create( chained );
+}
+
+void IpExecutorBenchmarkApp::draw()
+{
+	gl::clear();
+	gl::setMatricesWindow( getWindowSize() );
+
+	if( mTexture )
+		gl::draw( mTexture, Rectf( mTexture->getBounds() ).getCenteredFit( getWindowBounds(), true ) );
+
+	vec2 pos( 20, 20 );
+	for( const auto &result : mResults ) {
+		gl::drawString( result, pos );
+		pos.y += 20;
+	}
+}
+
+CINDER_APP( IpExecutorBenchmarkApp, RendererGl )
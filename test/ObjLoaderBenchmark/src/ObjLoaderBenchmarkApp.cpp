@@ -0,0 +1,108 @@
+// Compares the line-by-line stream path of ObjLoader with the in-place path used for DataSources,
+// which memory-maps the file and parses it in parallel chunks. Drop an .obj file on the window to benchmark it,
+// otherwise a generated grid mesh is used.
+
+#include "cinder/app/App.h"
+#include "cinder/app/RendererGl.h"
+#include "cinder/gl/gl.h"
+#include "cinder/Log.h"
+#include "cinder/ObjLoader.h"
+#include "cinder/Rand.h"
+#include "cinder/Timer.h"
+#include "cinder/TriMesh.h"
+
+#include <fstream>
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+class ObjLoaderBenchmarkApp : public App {
+  public:
+	void setup() override;
+	void fileDrop( FileDropEvent event ) override;
+	void draw() override;
+
+	void generateObj( const fs::path &path, int gridSize );
+	void runBenchmark( const fs::path &path );
+
+	vector<string>	mResults;
+};
+
+void ObjLoaderBenchmarkApp::setup()
+{
+	fs::path path = fs::temp_directory_path() / "ObjLoaderBenchmark.obj";
+	generateObj( path, 1000 );
+	runBenchmark( path );
+}
+
+void ObjLoaderBenchmarkApp::fileDrop( FileDropEvent event )
+{
+	runBenchmark( event.getFile( 0 ) );
+}
+
+void ObjLoaderBenchmarkApp::generateObj( const fs::path &path, int gridSize )
+{
+	ofstream out( path.string().c_str() );
+	Rand rnd( 1234 );
+
+	out << "# " << gridSize << "x" << gridSize << " grid" << endl;
+	for( int y = 0; y < gridSize; y++ ) {
+		for( int x = 0; x < gridSize; x++ ) {
+			out << "v " << x << " " << rnd.nextFloat( -0.5f, 0.5f ) << " " << y << "\n";
+			out << "vt " << x / float( gridSize - 1 ) << " " << y / float( gridSize - 1 ) << "\n";
+			vec3 n = rnd.nextVec3();
+			out << "vn " << n.x << " " << n.y << " " << n.z << "\n";
+		}
+	}
+
+	for( int y = 0; y < gridSize - 1; y++ ) {
+		for( int x = 0; x < gridSize - 1; x++ ) {
+			int i = y * gridSize + x + 1;
+			out << "f " << i << "/" << i << "/" << i << " " << i + 1 << "/" << i + 1 << "/" << i + 1 << " "
+				<< i + gridSize + 1 << "/" << i + gridSize + 1 << "/" << i + gridSize + 1 << "\n";
+		}
+	}
+}
+
+void ObjLoaderBenchmarkApp::runBenchmark( const fs::path &path )
+{
+	mResults.clear();
+	mResults.push_back( path.filename().string() + ", " + to_string( fs::file_size( path ) / ( 1024 * 1024 ) ) + " MB" );
+
+	Timer timer( true );
+	ObjLoader streamed( loadFile( path )->createStream() );
+	TriMeshRef streamedMesh = TriMesh::create( streamed );
+	double streamedSeconds = timer.getSeconds();
+
+	timer.start();
+	ObjLoader mapped( loadFile( path ) );
+	TriMeshRef mappedMesh = TriMesh::create( mapped );
+	double mappedSeconds = timer.getSeconds();
+
+	bool identical = streamedMesh->getNumVertices() == mappedMesh->getNumVertices()
+					&& streamedMesh->getIndices() == mappedMesh->getIndices()
+					&& equal( streamedMesh->getPositions<3>(), streamedMesh->getPositions<3>() + streamedMesh->getNumVertices(), mappedMesh->getPositions<3>() )
+					&& streamedMesh->getNormals() == mappedMesh->getNormals();
+
+	mResults.push_back( to_string( mappedMesh->getNumVertices() ) + " vertices, " + to_string( mappedMesh->getNumTriangles() ) + " triangles" );
+	mResults.push_back( "stream: " + to_string( streamedSeconds * 1000 ) + " ms" );
+	mResults.push_back( "mapped: " + to_string( mappedSeconds * 1000 ) + " ms (" + to_string( streamedSeconds / mappedSeconds ) + "x)" );
+	mResults.push_back( identical ? "output is identical" : "OUTPUT DIFFERS" );
+
+	for( const auto &result : mResults )
+		CI_LOG_I( result );
+}
+
+void ObjLoaderBenchmarkApp::draw()
+{
+	gl::clear();
+
+	vec2 pos( 20, 20 );
+	for( const auto &result : mResults ) {
+		gl::drawString( result, pos );
+		pos.y += 20;
+	}
+}
+
+CINDER_APP( ObjLoaderBenchmarkApp, RendererGl )
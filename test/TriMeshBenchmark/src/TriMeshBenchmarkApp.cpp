@@ -0,0 +1,107 @@
+// Times TriMesh::recalculateNormals( smooth = true ), recalculateTangents() and weld() on subdivided Icospheres and Teapots of
+// growing size, to show how they scale with the number of vertices. For the smaller meshes, the O(n^2) search for coincident
+// vertices that smooth normals used to do is timed as well. Triangles are split across the ThreadPool once a mesh is large
+// enough. Results are printed to the console and drawn.
+
+#include "cinder/app/App.h"
+#include "cinder/app/RendererGl.h"
+#include "cinder/gl/gl.h"
+
+#include "cinder/ThreadPool.h"
+#include "cinder/Timer.h"
+#include "cinder/TriMesh.h"
+
+#include <iomanip>
+#include <sstream>
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+// The brute force search is skipped for meshes with more vertices than this, it would take minutes
+const size_t MAX_BRUTE_FORCE_VERTICES = 50000;
+
+class TriMeshBenchmarkApp : public App {
+  public:
+	void setup() override;
+	void draw() override;
+
+	void benchmark( const string &name, const geom::Source &source );
+
+	vector<string>	mResults;
+};
+
+void TriMeshBenchmarkApp::setup()
+{
+	mResults.push_back( to_string( ThreadPool::get()->getNumThreads() ) + " pool threads, times in ms" );
+	for( int subdivisions = 3; subdivisions <= 8; subdivisions++ )
+		benchmark( "Icosphere, " + to_string( subdivisions ) + " subdivisions", geom::Icosphere().subdivisions( subdivisions ) );
+	for( int subdivisions : { 8, 32, 64, 128 } )
+		benchmark( "Teapot, " + to_string( subdivisions ) + " subdivisions", geom::Teapot().subdivisions( subdivisions ) );
+
+	for( const auto &result : mResults )
+		console() << result << endl;
+}
+
+void TriMeshBenchmarkApp::benchmark( const string &name, const geom::Source &source )
+{
+	TriMesh mesh( source, TriMesh::Format().positions().normals().texCoords() );
+	const size_t numVertices = mesh.getNumVertices();
+
+	Timer timer( true );
+	mesh.recalculateNormals( true );
+	double normalsSeconds = timer.getSeconds();
+
+	timer.start();
+	mesh.recalculateTangents();
+	double tangentsSeconds = timer.getSeconds();
+
+	TriMesh positionsOnly( source, TriMesh::Format().positions() );
+	timer.start();
+	size_t numWelded = positionsOnly.weld();
+	double weldSeconds = timer.getSeconds();
+
+	ostringstream line;
+	line << setw( 30 ) << left << name << setw( 9 ) << right << numVertices << " vertices   " << fixed << setprecision( 2 );
+	line << "smooth normals: " << setw( 8 ) << normalsSeconds * 1000 << "   tangents: " << setw( 8 ) << tangentsSeconds * 1000;
+	line << "   weld: " << setw( 8 ) << weldSeconds * 1000 << " (" << numWelded << " removed)";
+
+	if( numVertices <= MAX_BRUTE_FORCE_VERTICES ) {
+		const vec3 *positions = mesh.getPositions<3>();
+		vector<uint32_t> uniquePositions( numVertices, 0 );
+		timer.start();
+		for( uint32_t i = 0; i < numVertices; ++i ) {
+			if( uniquePositions[i] == 0 ) {
+				uniquePositions[i] = i + 1;
+				for( size_t j = i + 1; j < numVertices; ++j ) {
+					if( length2( positions[j] - positions[i] ) < FLT_EPSILON )
+						uniquePositions[j] = uniquePositions[i];
+				}
+			}
+		}
+		line << "   brute force search: " << setw( 8 ) << timer.getSeconds() * 1000;
+	}
+
+	mResults.push_back( line.str() );
+}
+
+void TriMeshBenchmarkApp::draw()
+{
+	gl::clear();
+	gl::setMatricesWindow( getWindowSize() );
+
+	vec2 pos( 20, 20 );
+	for( const auto &result : mResults ) {
+		gl::drawString( result, pos );
+		pos.y += 20;
+	}
+}
+
+auto settingsFunc = []( App::Settings *settings ) {
+	settings->setWindowSize( 1200, 300 );
+#if defined( CINDER_MSW )
+	settings->setConsoleWindowEnabled();
+#endif
+};
+
+CINDER_APP( TriMeshBenchmarkApp, RendererGl, settingsFunc )
@@ -0,0 +1,150 @@
+// Compares the samplerate converters that can be selected with audio::dsp::ConverterType: the platform default (r8brain on Windows and
+// Linux) and the three polyphase presets. For each samplerate pair it reports throughput converting stereo noise in blocks the size
+// of a SourceFile read, latency (how many source frames go in before the first output frame comes out), and how much of a 20 kHz
+// sine aliases into the output when downsampling. Results are printed to the console and drawn.
+
+#include "cinder/app/App.h"
+#include "cinder/app/RendererGl.h"
+#include "cinder/gl/gl.h"
+
+#include "cinder/audio/dsp/Converter.h"
+#include "cinder/CinderMath.h"
+#include "cinder/Rand.h"
+#include "cinder/Timer.h"
+
+#include <iomanip>
+#include <sstream>
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+const size_t	FRAMES_PER_BLOCK = 4096;
+const double	CONVERT_SECONDS = 60;
+
+class ConverterBenchmarkApp : public App {
+  public:
+	void setup() override;
+	void draw() override;
+
+	//! Returns how many times faster than realtime \a converter converts CONVERT_SECONDS of stereo noise.
+	double	measureThroughput( audio::dsp::Converter *converter );
+	//! Returns how many source frames \a converter consumes before it writes its first frame.
+	size_t	measureLatency( audio::dsp::Converter *converter );
+	//! Returns the level in dB of what remains of a full scale 20 kHz sine after conversion, which is all aliasing when 20 kHz is above the dest nyquist.
+	double	measureAliasing( audio::dsp::Converter *converter );
+
+	vector<string>	mResults;
+};
+
+void ConverterBenchmarkApp::setup()
+{
+	const vector<pair<string, audio::dsp::ConverterType>> types = {
+		{ "default", audio::dsp::ConverterType::DEFAULT },
+		{ "polyphase fast", audio::dsp::ConverterType::POLYPHASE_FAST },
+		{ "polyphase medium", audio::dsp::ConverterType::POLYPHASE_MEDIUM },
+		{ "polyphase high", audio::dsp::ConverterType::POLYPHASE_HIGH }
+	};
+	const vector<pair<size_t, size_t>> rates = { { 44100, 48000 }, { 48000, 44100 }, { 96000, 32000 } };
+
+	mResults.push_back( to_string( int( CONVERT_SECONDS ) ) + " seconds of stereo in blocks of " + to_string( FRAMES_PER_BLOCK ) + " frames" );
+	for( const auto &rate : rates ) {
+		mResults.push_back( to_string( rate.first ) + " Hz to " + to_string( rate.second ) + " Hz" );
+		for( const auto &type : types ) {
+			auto throughputConverter = audio::dsp::Converter::create( rate.first, rate.second, 2, 2, FRAMES_PER_BLOCK, type.second );
+			auto latencyConverter = audio::dsp::Converter::create( rate.first, rate.second, 1, 1, FRAMES_PER_BLOCK, type.second );
+			auto aliasingConverter = audio::dsp::Converter::create( rate.first, rate.second, 1, 1, FRAMES_PER_BLOCK, type.second );
+
+			ostringstream line;
+			line << "    " << setw( 20 ) << left << type.first << fixed << setprecision( 0 );
+			line << "throughput: " << measureThroughput( throughputConverter.get() ) << "x realtime   ";
+			line << "latency: " << measureLatency( latencyConverter.get() ) << " frames   ";
+			if( rate.second < 40000 )
+				line << "20 kHz aliasing: " << measureAliasing( aliasingConverter.get() ) << " dB";
+			mResults.push_back( line.str() );
+		}
+	}
+
+	for( const auto &result : mResults )
+		console() << result << endl;
+}
+
+double ConverterBenchmarkApp::measureThroughput( audio::dsp::Converter *converter )
+{
+	Rand rand( 1 );
+	audio::Buffer source( FRAMES_PER_BLOCK, 2 );
+	for( size_t i = 0; i < source.getSize(); i++ )
+		source[i] = rand.nextFloat( -1, 1 );
+
+	audio::Buffer dest( converter->getDestMaxFramesPerBlock(), 2 );
+	const size_t numBlocks = size_t( CONVERT_SECONDS * converter->getSourceSampleRate() / FRAMES_PER_BLOCK );
+
+	Timer timer( true );
+	for( size_t i = 0; i < numBlocks; i++ )
+		converter->convert( &source, &dest );
+
+	return CONVERT_SECONDS / timer.getSeconds();
+}
+
+size_t ConverterBenchmarkApp::measureLatency( audio::dsp::Converter *converter )
+{
+	audio::Buffer frame( 1 );
+	audio::Buffer dest( converter->getDestMaxFramesPerBlock() );
+
+	size_t result = 0;
+	while( result < converter->getSourceSampleRate() ) {
+		frame[0] = result == 0 ? 1.0f : 0.0f;
+		result++;
+		if( converter->convert( &frame, &dest ).second )
+			break;
+	}
+
+	return result - 1;
+}
+
+double ConverterBenchmarkApp::measureAliasing( audio::dsp::Converter *converter )
+{
+	const double freq = 20000;
+	const size_t sourceSampleRate = converter->getSourceSampleRate();
+	audio::Buffer source( FRAMES_PER_BLOCK );
+	audio::Buffer dest( converter->getDestMaxFramesPerBlock() );
+
+	// skip the first second, so that the filter's response to the sine starting has passed
+	double sumOfSquares = 0;
+	size_t numFrames = 0;
+	for( size_t block = 0; block * FRAMES_PER_BLOCK < 4 * sourceSampleRate; block++ ) {
+		for( size_t i = 0; i < FRAMES_PER_BLOCK; i++ )
+			source[i] = (float)sin( 2 * M_PI * freq * ( block * FRAMES_PER_BLOCK + i ) / sourceSampleRate );
+
+		size_t count = converter->convert( &source, &dest ).second;
+		if( block * FRAMES_PER_BLOCK > sourceSampleRate ) {
+			for( size_t i = 0; i < count; i++ )
+				sumOfSquares += dest[i] * dest[i];
+			numFrames += count;
+		}
+	}
+
+	double rms = sqrt( sumOfSquares / numFrames );
+	return 20 * log10( max( rms, 1e-12 ) / sqrt( 0.5 ) );
+}
+
+void ConverterBenchmarkApp::draw()
+{
+	gl::clear();
+	gl::setMatricesWindow( getWindowSize() );
+
+	vec2 pos( 20, 20 );
+	for( const auto &result : mResults ) {
+		gl::drawString( result, pos );
+		pos.y += 20;
+	}
+}
+
+auto settingsFunc = []( App::Settings *settings ) {
+	settings->setWindowSize( 1000, 400 );
+#if defined( CINDER_MSW )
+	settings->setConsoleWindowEnabled();
+#endif
+};
+
+CINDER_APP( ConverterBenchmarkApp, RendererGl, settingsFunc )
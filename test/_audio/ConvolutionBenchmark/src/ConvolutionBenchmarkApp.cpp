@@ -0,0 +1,134 @@
+// Measures the CPU time ConvolutionNode takes per processing block against the length of its impulse response, with a stereo
+// response at 64 frames per block. Each block is timed separately through ContextOffline. Blocks do different work depending on their
+// position in the period of the tail partitions (see ConvolutionNode::TAIL_PARTITION_RATIO), so the average of the most expensive
+// position is reported along with the overall average, both as a percentage of the block's duration. Every length is run with the
+// scalar kernels and with the default SimdLevel. Results are printed to the console and drawn.
+
+#include "cinder/app/App.h"
+#include "cinder/app/RendererGl.h"
+#include "cinder/gl/gl.h"
+
+#include "cinder/audio/ContextOffline.h"
+#include "cinder/audio/ConvolutionNode.h"
+#include "cinder/audio/GenNode.h"
+#include "cinder/audio/dsp/Dsp.h"
+#include "cinder/Rand.h"
+#include "cinder/Timer.h"
+
+#include <iomanip>
+#include <sstream>
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+const size_t	SAMPLE_RATE = 48000;
+const size_t	FRAMES_PER_BLOCK = 64;
+const size_t	NUM_CHANNELS = 2;
+const double	RENDER_SECONDS = 5;
+
+class ConvolutionBenchmarkApp : public App {
+  public:
+	void setup() override;
+	void draw() override;
+
+	//! Renders noise through a ConvolutionNode applying \a impulseResponse, returning the average seconds spent on a block, overall and at the most expensive position in the tail period.
+	void measure( const audio::BufferRef &impulseResponse, double *averageSeconds, double *slowestPositionSeconds );
+
+	vector<string>	mResults;
+};
+
+void ConvolutionBenchmarkApp::setup()
+{
+	const double blockSeconds = double( FRAMES_PER_BLOCK ) / SAMPLE_RATE;
+	const auto defaultLevel = audio::dsp::getSimdLevel();
+	const vector<pair<string, audio::dsp::SimdLevel>> levels = {
+		{ "scalar", audio::dsp::SimdLevel::SCALAR },
+		{ "default", defaultLevel }
+	};
+
+	mResults.push_back( to_string( NUM_CHANNELS ) + " channels, " + to_string( FRAMES_PER_BLOCK ) + " frames per block at " + to_string( SAMPLE_RATE )
+						+ " Hz, CPU per block as % of its " + to_string( blockSeconds * 1000 ) + " ms (average / slowest position)" );
+
+	Rand rand( 1 );
+	for( double irSeconds : { 0.1, 0.5, 1.0, 2.0, 5.0, 10.0 } ) {
+		// decaying noise, like the tail of a reverb
+		const size_t irFrames = size_t( irSeconds * SAMPLE_RATE );
+		auto impulseResponse = make_shared<audio::Buffer>( irFrames, NUM_CHANNELS );
+		const float scale = 1 / sqrtf( float( irFrames ) );
+		for( size_t ch = 0; ch < NUM_CHANNELS; ch++ ) {
+			float *channel = impulseResponse->getChannel( ch );
+			for( size_t i = 0; i < irFrames; i++ )
+				channel[i] = rand.nextFloat( -1, 1 ) * scale * expf( -6.0f * i / irFrames );
+		}
+
+		ostringstream line;
+		line << setw( 8 ) << left << ( to_string( irSeconds ).substr( 0, 4 ) + " s" );
+		for( const auto &level : levels ) {
+			if( ! audio::dsp::setSimdLevel( level.second ) )
+				continue;
+
+			double averageSeconds, slowestPositionSeconds;
+			measure( impulseResponse, &averageSeconds, &slowestPositionSeconds );
+			line << level.first << ": " << fixed << setprecision( 1 ) << averageSeconds / blockSeconds * 100 << "% / " << slowestPositionSeconds / blockSeconds * 100 << "%   ";
+		}
+		mResults.push_back( line.str() );
+	}
+	audio::dsp::setSimdLevel( defaultLevel );
+
+	for( const auto &result : mResults )
+		console() << result << endl;
+}
+
+void ConvolutionBenchmarkApp::measure( const audio::BufferRef &impulseResponse, double *averageSeconds, double *slowestPositionSeconds )
+{
+	auto ctx = make_shared<audio::ContextOffline>( SAMPLE_RATE, FRAMES_PER_BLOCK, NUM_CHANNELS );
+	auto noise = ctx->makeNode( new audio::GenNoiseNode );
+	auto convolution = ctx->makeNode( new audio::ConvolutionNode( impulseResponse, audio::Node::Format().channels( NUM_CHANNELS ) ) );
+	noise >> convolution >> ctx->getOutput();
+	noise->enable();
+	ctx->enable();
+
+	const size_t numPositions = audio::ConvolutionNode::TAIL_PARTITION_RATIO;
+	const size_t numPeriods = size_t( RENDER_SECONDS * SAMPLE_RATE / ( FRAMES_PER_BLOCK * numPositions ) );
+	vector<double> positionSeconds( numPositions, 0 );
+
+	Timer timer;
+	for( size_t i = 0; i < numPeriods * numPositions; i++ ) {
+		timer.start();
+		ctx->render( FRAMES_PER_BLOCK );
+		timer.stop();
+
+		positionSeconds[i % numPositions] += timer.getSeconds();
+	}
+
+	double totalSeconds = 0;
+	*slowestPositionSeconds = 0;
+	for( double seconds : positionSeconds ) {
+		totalSeconds += seconds;
+		*slowestPositionSeconds = max( *slowestPositionSeconds, seconds / numPeriods );
+	}
+
+	*averageSeconds = totalSeconds / ( numPeriods * numPositions );
+}
+
+void ConvolutionBenchmarkApp::draw()
+{
+	gl::clear();
+	gl::setMatricesWindow( getWindowSize() );
+
+	vec2 pos( 20, 20 );
+	for( const auto &result : mResults ) {
+		gl::drawString( result, pos );
+		pos.y += 20;
+	}
+}
+
+auto settingsFunc = []( App::Settings *settings ) {
+	settings->setWindowSize( 900, 200 );
+#if defined( CINDER_MSW )
+	settings->setConsoleWindowEnabled();
+#endif
+};
+
+CINDER_APP( ConvolutionBenchmarkApp, RendererGl, settingsFunc )
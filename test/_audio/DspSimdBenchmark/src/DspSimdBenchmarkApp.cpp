@@ -0,0 +1,131 @@
+// Times the audio::dsp vector routines at each SimdLevel supported by this machine (see audio::dsp::setSimdLevel()), processing
+// blocks the size of a typical audio callback. Times are relative to the scalar kernels. Results are printed to the console and drawn.
+
+#include "cinder/app/App.h"
+#include "cinder/app/RendererGl.h"
+#include "cinder/gl/gl.h"
+
+#include "cinder/audio/dsp/Converter.h"
+#include "cinder/audio/dsp/Dsp.h"
+#include "cinder/Rand.h"
+#include "cinder/Timer.h"
+
+#include <functional>
+#include <iomanip>
+#include <sstream>
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+const size_t	FRAMES_PER_BLOCK = 512;
+const size_t	NUM_ITERATIONS = 200000;
+
+class DspSimdBenchmarkApp : public App {
+  public:
+	void setup() override;
+	void draw() override;
+
+	//! Returns the seconds it takes to call \a fn NUM_ITERATIONS times.
+	double time( const function<void ()> &fn );
+
+	vector<float>	mLeft, mRight, mInterleaved, mResult;
+	vector<int16_t>	mInt16;
+	float			mSink;
+	vector<string>	mResults;
+};
+
+void DspSimdBenchmarkApp::setup()
+{
+	mLeft.resize( FRAMES_PER_BLOCK );
+	mRight.resize( FRAMES_PER_BLOCK );
+	mResult.resize( FRAMES_PER_BLOCK * 2 );
+	mInterleaved.resize( FRAMES_PER_BLOCK * 2 );
+	mInt16.resize( FRAMES_PER_BLOCK * 2 );
+	mSink = 0;
+
+	Rand rand( 1 );
+	for( size_t i = 0; i < FRAMES_PER_BLOCK; i++ ) {
+		mLeft[i] = rand.nextFloat( -1, 1 );
+		mRight[i] = rand.nextFloat( -1, 1 );
+	}
+
+	const vector<pair<string, function<void ()>>> routines = {
+		{ "add", [this] { audio::dsp::add( mLeft.data(), mRight.data(), mResult.data(), FRAMES_PER_BLOCK ); } },
+		{ "mul (scalar)", [this] { audio::dsp::mul( mLeft.data(), 0.5f, mResult.data(), FRAMES_PER_BLOCK ); } },
+		{ "mulAdd", [this] { audio::dsp::mulAdd( mLeft.data(), 0.5f, mRight.data(), mResult.data(), FRAMES_PER_BLOCK ); } },
+		{ "sum", [this] { mSink += audio::dsp::sum( mLeft.data(), FRAMES_PER_BLOCK ); } },
+		{ "rms", [this] { mSink += audio::dsp::rms( mLeft.data(), FRAMES_PER_BLOCK ); } },
+		{ "float to int16", [this] { audio::dsp::convert( mLeft.data(), mInt16.data(), FRAMES_PER_BLOCK ); } },
+		{ "int16 to float", [this] { audio::dsp::convert( mInt16.data(), mResult.data(), FRAMES_PER_BLOCK ); } },
+		{ "interleave stereo", [this] { audio::dsp::interleave( mLeft.data(), mInterleaved.data(), FRAMES_PER_BLOCK, 2, FRAMES_PER_BLOCK ); } },
+		{ "deinterleave stereo", [this] { audio::dsp::deinterleave( mInterleaved.data(), mResult.data(), FRAMES_PER_BLOCK, 2, FRAMES_PER_BLOCK ); } },
+		{ "interleave stereo int16", [this] { audio::dsp::interleave( mLeft.data(), mInt16.data(), FRAMES_PER_BLOCK, 2, FRAMES_PER_BLOCK ); } },
+		{ "deinterleave stereo int16", [this] { audio::dsp::deinterleave( mInt16.data(), mResult.data(), FRAMES_PER_BLOCK, 2, FRAMES_PER_BLOCK ); } }
+	};
+
+	const vector<pair<string, audio::dsp::SimdLevel>> levels = {
+		{ "scalar", audio::dsp::SimdLevel::SCALAR },
+		{ "sse2", audio::dsp::SimdLevel::SSE2 },
+		{ "avx2", audio::dsp::SimdLevel::AVX2 },
+		{ "neon", audio::dsp::SimdLevel::NEON }
+	};
+
+	const auto defaultLevel = audio::dsp::getSimdLevel();
+	mResults.push_back( to_string( NUM_ITERATIONS ) + " iterations of " + to_string( FRAMES_PER_BLOCK ) + " frames, ms (speedup)" );
+	for( const auto &routine : routines ) {
+		ostringstream line;
+		line << setw( 28 ) << left << routine.first;
+
+		double scalarSeconds = 0;
+		for( const auto &level : levels ) {
+			if( ! audio::dsp::setSimdLevel( level.second ) )
+				continue;
+
+			double seconds = time( routine.second );
+			if( level.second == audio::dsp::SimdLevel::SCALAR )
+				scalarSeconds = seconds;
+
+			line << level.first << ": " << fixed << setprecision( 1 ) << seconds * 1000 << " (" << setprecision( 2 ) << scalarSeconds / seconds << "x)   ";
+		}
+		mResults.push_back( line.str() );
+	}
+	audio::dsp::setSimdLevel( defaultLevel );
+
+	for( const auto &result : mResults )
+		console() << result << endl;
+}
+
+double DspSimdBenchmarkApp::time( const function<void ()> &fn )
+{
+	// warm up caches before timing
+	for( size_t i = 0; i < NUM_ITERATIONS / 100; i++ )
+		fn();
+
+	Timer timer( true );
+	for( size_t i = 0; i < NUM_ITERATIONS; i++ )
+		fn();
+
+	return timer.getSeconds();
+}
+
+void DspSimdBenchmarkApp::draw()
+{
+	gl::clear();
+	gl::setMatricesWindow( getWindowSize() );
+
+	vec2 pos( 20, 20 );
+	for( const auto &result : mResults ) {
+		gl::drawString( result, pos );
+		pos.y += 20;
+	}
+}
+
+auto settingsFunc = []( App::Settings *settings ) {
+	settings->setWindowSize( 1200, 300 );
+#if defined( CINDER_MSW )
+	settings->setConsoleWindowEnabled();
+#endif
+};
+
+CINDER_APP( DspSimdBenchmarkApp, RendererGl, settingsFunc )
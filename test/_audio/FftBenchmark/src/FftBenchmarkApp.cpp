@@ -0,0 +1,134 @@
+// Computes the short-time Fourier transform of a long signal three ways: one frame at a time with forward( const Buffer *, BufferSpectral * )
+// as MonitorSpectralNode does, with the batched forward() on the calling thread, and with the batched forward() spread across the
+// ThreadPool. Also times constructing an Fft, which reuses cached tables after the first one of each size. Results are printed to
+// the console and drawn.
+
+#include "cinder/app/App.h"
+#include "cinder/app/RendererGl.h"
+#include "cinder/gl/gl.h"
+
+#include "cinder/audio/dsp/Dsp.h"
+#include "cinder/audio/dsp/Fft.h"
+#include "cinder/Rand.h"
+#include "cinder/ThreadPool.h"
+#include "cinder/Timer.h"
+
+#include <cstring>
+#include <functional>
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+const size_t	SAMPLE_RATE = 48000;
+const double	SIGNAL_SECONDS = 60;
+const size_t	NUM_ITERATIONS = 5;
+const size_t	NUM_CONSTRUCTIONS = 1000;
+
+class FftBenchmarkApp : public App {
+  public:
+	void setup() override;
+	void draw() override;
+
+	//! Returns the average seconds it takes to call \a fn, over NUM_ITERATIONS calls.
+	double time( const function<void ()> &fn );
+	void benchmark( size_t fftSize, size_t hop );
+
+	vector<float>	mSignal;
+	vector<string>	mResults;
+};
+
+void FftBenchmarkApp::setup()
+{
+	Rand rand( 1 );
+	mSignal.resize( size_t( SIGNAL_SECONDS * SAMPLE_RATE ) );
+	for( auto &sample : mSignal )
+		sample = rand.nextFloat( -1, 1 );
+
+	mResults.push_back( to_string( int( SIGNAL_SECONDS ) ) + " seconds at " + to_string( SAMPLE_RATE ) + " Hz, " + to_string( ThreadPool::get()->getNumThreads() ) + " pool threads" );
+	benchmark( 512, 128 );
+	benchmark( 2048, 512 );
+	benchmark( 8192, 2048 );
+
+	for( const auto &result : mResults )
+		console() << result << endl;
+}
+
+void FftBenchmarkApp::benchmark( size_t fftSize, size_t hop )
+{
+	const size_t count = ( mSignal.size() - fftSize ) / hop + 1;
+	vector<float> window( fftSize );
+	audio::dsp::generateWindow( audio::dsp::WindowType::HANN, window.data(), fftSize );
+
+	audio::dsp::Fft fft( fftSize );
+	vector<float> spectrogram( count * fftSize );
+
+	double perFrameSeconds = time( [&] {
+		audio::Buffer frame( fftSize );
+		audio::BufferSpectral spectral( fftSize );
+		for( size_t i = 0; i < count; i++ ) {
+			audio::dsp::mul( mSignal.data() + i * hop, window.data(), frame.getData(), fftSize );
+			fft.forward( &frame, &spectral );
+			memcpy( spectrogram.data() + i * fftSize, spectral.getData(), fftSize * sizeof( float ) );
+		}
+	} );
+	double batchSeconds = time( [&] {
+		fft.forward( mSignal.data(), hop, count, spectrogram.data(), window.data() );
+	} );
+	double threadedSeconds = time( [&] {
+		fft.forward( mSignal.data(), hop, count, spectrogram.data(), window.data(), ThreadPool::get() );
+	} );
+
+	Timer timer( true );
+	for( size_t i = 0; i < NUM_CONSTRUCTIONS; i++ )
+		audio::dsp::Fft cached( fftSize );
+	double constructSeconds = timer.getSeconds() / NUM_CONSTRUCTIONS;
+
+	double uncachedSeconds = 0;
+	for( size_t i = 0; i < NUM_CONSTRUCTIONS; i++ ) {
+		audio::dsp::Fft::clearPlanCache();
+		timer.start();
+		audio::dsp::Fft uncached( fftSize );
+		uncachedSeconds += timer.getSeconds();
+	}
+	uncachedSeconds /= NUM_CONSTRUCTIONS;
+
+	mResults.push_back( "fft size " + to_string( fftSize ) + ", hop " + to_string( hop ) + ", " + to_string( count ) + " frames" );
+	mResults.push_back( "    per frame forward(): " + to_string( perFrameSeconds * 1000 ) + " ms" );
+	mResults.push_back( "    batched forward(): " + to_string( batchSeconds * 1000 ) + " ms (" + to_string( perFrameSeconds / batchSeconds ) + "x)" );
+	mResults.push_back( "    batched forward() on ThreadPool: " + to_string( threadedSeconds * 1000 ) + " ms (" + to_string( perFrameSeconds / threadedSeconds ) + "x)" );
+	mResults.push_back( "    construction: " + to_string( constructSeconds * 1e6 ) + " us cached, " + to_string( uncachedSeconds * 1e6 ) + " us uncached" );
+}
+
+double FftBenchmarkApp::time( const function<void ()> &fn )
+{
+	// warm up caches before timing
+	fn();
+
+	Timer timer( true );
+	for( size_t i = 0; i < NUM_ITERATIONS; i++ )
+		fn();
+
+	return timer.getSeconds() / NUM_ITERATIONS;
+}
+
+void FftBenchmarkApp::draw()
+{
+	gl::clear();
+	gl::setMatricesWindow( getWindowSize() );
+
+	vec2 pos( 20, 20 );
+	for( const auto &result : mResults ) {
+		gl::drawString( result, pos );
+		pos.y += 20;
+	}
+}
+
+auto settingsFunc = []( App::Settings *settings ) {
+	settings->setWindowSize( 800, 400 );
+#if defined( CINDER_MSW )
+	settings->setConsoleWindowEnabled();
+#endif
+};
+
+CINDER_APP( FftBenchmarkApp, RendererGl, settingsFunc )
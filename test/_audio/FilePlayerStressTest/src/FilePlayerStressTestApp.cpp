@@ -0,0 +1,165 @@
+// Plays a growing number of looping FilePlayerNodes that all stream from disk through the shared StreamScheduler, while
+// randomly stopping, cueing and restarting some of them. Underruns reported by FilePlayerNode::getLastUnderrun() are
+// counted per player count, which shows how many streams the scheduler's worker threads can keep fed.
+// Press up / down to add or remove players, 'o' to choose a different file. Results are printed to the console and drawn.
+
+#include "cinder/app/App.h"
+#include "cinder/app/RendererGl.h"
+#include "cinder/gl/gl.h"
+#include "cinder/Rand.h"
+
+#include "cinder/audio/Context.h"
+#include "cinder/audio/GainNode.h"
+#include "cinder/audio/SamplePlayerNode.h"
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+const size_t	PLAYERS_PER_STEP = 16;
+const double	RESTART_INTERVAL_SECONDS = 0.1;
+
+class FilePlayerStressTestApp : public App {
+  public:
+	void setup() override;
+	void update() override;
+	void draw() override;
+	void keyDown( KeyEvent event ) override;
+
+	void loadSourceFile( const DataSourceRef &dataSource );
+	void addPlayers( size_t count );
+	void removePlayers( size_t count );
+	void resetCounters();
+
+	audio::SourceFileRef					mSourceFile;
+	audio::GainNodeRef						mGain;
+	vector<audio::FilePlayerNodeRef>		mPlayers;
+
+	size_t		mNumUnderruns, mNumRestarts;
+	double		mCountStartTime, mLastRestartTime;
+};
+
+void FilePlayerStressTestApp::setup()
+{
+	auto ctx = audio::master();
+	mGain = ctx->makeNode( new audio::GainNode );
+	mGain >> ctx->getOutput();
+
+	// the audio test data lives outside of an assets folder, so point at it relative to this source file
+	addAssetDirectory( fs::path( __FILE__ ).parent_path() / "../../data" );
+	loadSourceFile( loadAsset( "tone440L220R.wav" ) );
+
+	addPlayers( PLAYERS_PER_STEP );
+	ctx->enable();
+}
+
+void FilePlayerStressTestApp::loadSourceFile( const DataSourceRef &dataSource )
+{
+	removePlayers( mPlayers.size() );
+	mSourceFile = audio::load( dataSource, audio::master()->getSampleRate() );
+	console() << "loaded " << dataSource->getFilePath() << ", " << mSourceFile->getNumSeconds() << " seconds" << endl;
+}
+
+void FilePlayerStressTestApp::addPlayers( size_t count )
+{
+	auto ctx = audio::master();
+	for( size_t i = 0; i < count; i++ ) {
+		auto player = ctx->makeNode( new audio::FilePlayerNode( mSourceFile->clone() ) );
+		player->setLoopEnabled();
+		player->seek( randInt( (int)player->getNumFrames() ) );
+		player >> mGain;
+		player->enable();
+		mPlayers.push_back( player );
+	}
+
+	mGain->setValue( 1.0f / mPlayers.size() );
+	resetCounters();
+}
+
+void FilePlayerStressTestApp::removePlayers( size_t count )
+{
+	count = min( count, mPlayers.size() );
+	for( size_t i = 0; i < count; i++ ) {
+		mPlayers.back()->disconnectAll();
+		mPlayers.pop_back();
+	}
+
+	if( ! mPlayers.empty() )
+		mGain->setValue( 1.0f / mPlayers.size() );
+
+	resetCounters();
+}
+
+void FilePlayerStressTestApp::resetCounters()
+{
+	for( auto &player : mPlayers )
+		player->getLastUnderrun();
+
+	mNumUnderruns = mNumRestarts = 0;
+	mCountStartTime = mLastRestartTime = getElapsedSeconds();
+}
+
+void FilePlayerStressTestApp::update()
+{
+	for( auto &player : mPlayers ) {
+		if( player->getLastUnderrun() )
+			mNumUnderruns++;
+	}
+
+	// stop a random player, which cues it at the beginning of the file, and restart it elsewhere so that its cue is discarded
+	if( ! mPlayers.empty() && getElapsedSeconds() - mLastRestartTime > RESTART_INTERVAL_SECONDS ) {
+		auto &player = mPlayers[randInt( (int)mPlayers.size() )];
+		player->stop();
+		player->seek( randInt( (int)player->getNumFrames() ) );
+		player->enable();
+
+		mNumRestarts++;
+		mLastRestartTime = getElapsedSeconds();
+	}
+
+	if( getElapsedFrames() % 300 == 0 )
+		console() << mPlayers.size() << " players: " << mNumUnderruns << " underruns in " << getElapsedSeconds() - mCountStartTime << " seconds" << endl;
+}
+
+void FilePlayerStressTestApp::draw()
+{
+	gl::clear();
+	gl::setMatricesWindow( getWindowSize() );
+
+	auto scheduler = audio::StreamScheduler::get();
+	vector<string> lines = {
+		to_string( mPlayers.size() ) + " players, " + to_string( scheduler->getNumThreads() ) + " stream threads",
+		to_string( mNumUnderruns ) + " underruns, " + to_string( mNumRestarts ) + " restarts in " + to_string( getElapsedSeconds() - mCountStartTime ) + " seconds",
+		"up / down: add or remove " + to_string( PLAYERS_PER_STEP ) + " players, o: open file"
+	};
+
+	vec2 pos( 20, 20 );
+	for( const auto &line : lines ) {
+		gl::drawString( line, pos );
+		pos.y += 20;
+	}
+}
+
+void FilePlayerStressTestApp::keyDown( KeyEvent event )
+{
+	if( event.getCode() == KeyEvent::KEY_UP )
+		addPlayers( PLAYERS_PER_STEP );
+	else if( event.getCode() == KeyEvent::KEY_DOWN )
+		removePlayers( PLAYERS_PER_STEP );
+	else if( event.getChar() == 'o' ) {
+		auto filePath = getOpenFilePath( "", audio::SourceFile::getSupportedExtensions() );
+		if( ! filePath.empty() ) {
+			size_t numPlayers = mPlayers.size();
+			loadSourceFile( loadFile( filePath ) );
+			addPlayers( numPlayers );
+		}
+	}
+}
+
+auto settingsFunc = []( App::Settings *settings ) {
+#if defined( CINDER_MSW )
+	settings->setConsoleWindowEnabled();
+#endif
+};
+
+CINDER_APP( FilePlayerStressTestApp, RendererGl, settingsFunc )
@@ -0,0 +1,124 @@
+// Renders a graph of 256 independent effect chains through ContextOffline, once pulled serially on the calling thread and
+// once with worker threads processing the chains in parallel (see Context::setNumWorkerThreads()). Chains are summed pairwise,
+// so that the result doesn't depend on the order inputs are stored in and the two renders can be compared sample for sample.
+// Results are printed to the console and drawn.
+
+#include "cinder/app/App.h"
+#include "cinder/app/RendererGl.h"
+#include "cinder/gl/gl.h"
+
+#include "cinder/audio/ContextOffline.h"
+#include "cinder/audio/FilterNode.h"
+#include "cinder/audio/GainNode.h"
+#include "cinder/audio/GenNode.h"
+#include "cinder/audio/PanNode.h"
+#include "cinder/Timer.h"
+
+#include <cstring>
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+const size_t	NUM_CHAINS = 256;
+const size_t	SAMPLE_RATE = 48000;
+const size_t	FRAMES_PER_BLOCK = 512;
+const double	RENDER_SECONDS = 10;
+
+class GraphSchedulerBenchmarkApp : public App {
+  public:
+	void setup() override;
+	void draw() override;
+
+	//! Renders the graph with \a numWorkerThreads, returning the rendered samples and the time it took in \a seconds.
+	audio::BufferRef render( size_t numWorkerThreads, double *seconds );
+
+	vector<string>	mResults;
+};
+
+void GraphSchedulerBenchmarkApp::setup()
+{
+	size_t numWorkerThreads = max<size_t>( thread::hardware_concurrency(), 2 ) - 1;
+
+	double serialSeconds, parallelSeconds;
+	auto serial = render( 0, &serialSeconds );
+	auto parallel = render( numWorkerThreads, &parallelSeconds );
+	bool identical = serial->getSize() == parallel->getSize() && memcmp( serial->getData(), parallel->getData(), serial->getSize() * sizeof( float ) ) == 0;
+
+	mResults.push_back( to_string( NUM_CHAINS ) + " chains, " + to_string( RENDER_SECONDS ) + " seconds at " + to_string( SAMPLE_RATE ) + " Hz, " + to_string( FRAMES_PER_BLOCK ) + " frames per block" );
+	mResults.push_back( "serial: " + to_string( serialSeconds * 1000 ) + " ms (" + to_string( RENDER_SECONDS / serialSeconds ) + "x realtime)" );
+	mResults.push_back( to_string( numWorkerThreads ) + " worker threads: " + to_string( parallelSeconds * 1000 ) + " ms (" + to_string( RENDER_SECONDS / parallelSeconds ) + "x realtime, "
+						+ to_string( serialSeconds / parallelSeconds ) + "x speedup)" );
+	mResults.push_back( identical ? "output is identical" : "OUTPUT DIFFERS" );
+
+	for( const auto &result : mResults )
+		console() << result << endl;
+}
+
+audio::BufferRef GraphSchedulerBenchmarkApp::render( size_t numWorkerThreads, double *seconds )
+{
+	auto ctx = make_shared<audio::ContextOffline>( SAMPLE_RATE, FRAMES_PER_BLOCK, 2 );
+	ctx->setNumWorkerThreads( numWorkerThreads );
+
+	vector<audio::NodeRef> mixes;
+	for( size_t i = 0; i < NUM_CHAINS; i++ ) {
+		float freq = 50.0f + 10.0f * i;
+		audio::NodeRef gen;
+		if( i % 2 )
+			gen = ctx->makeNode( new audio::GenPhasorNode( freq ) );
+		else
+			gen = ctx->makeNode( new audio::GenTriangleNode( freq ) );
+
+		auto lowPass = ctx->makeNode( new audio::FilterLowPassNode );
+		lowPass->setCutoffFreq( 500.0f + 20.0f * i );
+		auto highPass = ctx->makeNode( new audio::FilterHighPassNode );
+		highPass->setCutoffFreq( 40.0f );
+		auto pan = ctx->makeNode( new audio::Pan2dNode );
+		pan->setPos( i / float( NUM_CHAINS - 1 ) );
+
+		gen >> lowPass >> highPass >> pan;
+		gen->enable();
+		mixes.push_back( pan );
+	}
+
+	while( mixes.size() > 1 ) {
+		vector<audio::NodeRef> nextMixes;
+		for( size_t i = 0; i < mixes.size(); i += 2 ) {
+			auto mix = ctx->makeNode( new audio::GainNode( 0.7f ) );
+			mixes[i] >> mix;
+			mixes[i + 1] >> mix;
+			nextMixes.push_back( mix );
+		}
+		mixes.swap( nextMixes );
+	}
+	mixes[0] >> ctx->getOutput();
+
+	ctx->getOutputOffline()->setRecordingEnabled();
+	ctx->enable();
+
+	Timer timer( true );
+	ctx->renderSeconds( RENDER_SECONDS );
+	*seconds = timer.getSeconds();
+
+	return ctx->getOutputOffline()->getRecordedCopy();
+}
+
+void GraphSchedulerBenchmarkApp::draw()
+{
+	gl::clear();
+	gl::setMatricesWindow( getWindowSize() );
+
+	vec2 pos( 20, 20 );
+	for( const auto &result : mResults ) {
+		gl::drawString( result, pos );
+		pos.y += 20;
+	}
+}
+
+auto settingsFunc = []( App::Settings *settings ) {
+#if defined( CINDER_MSW )
+	settings->setConsoleWindowEnabled();
+#endif
+};
+
+CINDER_APP( GraphSchedulerBenchmarkApp, RendererGl, settingsFunc )
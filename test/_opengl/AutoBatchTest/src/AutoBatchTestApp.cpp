@@ -0,0 +1,168 @@
+// Checks that an AutoBatch is flushed by each change to the state its pending draws depend on, and that batched draws
+// see the same normals as unbatched ones. Prints its results to the console and quits, so it can be run with a headless
+// renderer (CINDER_HEADLESS_GL=osmesa or egl).
+
+#include "cinder/app/App.h"
+#include "cinder/app/RendererGl.h"
+#include "cinder/gl/gl.h"
+#include "cinder/gl/AutoBatch.h"
+
+#include <functional>
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+typedef function<void ()> StateChange;
+
+class AutoBatchTestApp : public App {
+  public:
+	void setup() override;
+
+	//! Returns whether applying \a change between two draws keeps them from sharing a draw call. \a restore undoes \a change.
+	bool splitsBatch( const StateChange &change, const StateChange &restore );
+	//! Returns whether applying \a change flushes a pending draw immediately. \a restore undoes \a change.
+	bool flushesBatch( const StateChange &change, const StateChange &restore );
+	//! Calls \a draw with \a glsl bound, batched or not, and returns the color of the Fbo's center.
+	ColorA8u drawCenter( const gl::GlslProgRef &glsl, bool batched, const function<void ()> &draw );
+
+	void check( const string &what, bool condition );
+
+	gl::FboRef		mFbo;
+	gl::Texture2dRef	mTexture;
+	bool			mPassed;
+};
+
+void AutoBatchTestApp::setup()
+{
+	mPassed = true;
+	mFbo = gl::Fbo::create( 32, 32, gl::Fbo::Format().stencilBuffer() );
+	mTexture = gl::Texture2d::create( 4, 4 );
+
+	gl::ScopedFramebuffer fboScp( mFbo );
+	gl::ScopedViewport viewportScp( mFbo->getSize() );
+	gl::ScopedMatrices matricesScp;
+	gl::setMatricesWindow( mFbo->getSize() );
+	gl::ScopedGlslProg glslScp( gl::getStockShader( gl::ShaderDef().color() ) );
+	auto ctx = gl::context();
+
+	check( "draws with the same state share a draw call", ! splitsBatch( []{}, []{} ) );
+
+	// captured with each draw
+	check( "depth func splits", splitsBatch( [=] { ctx->pushDepthFunc( GL_LEQUAL ); }, [=] { ctx->popDepthFunc(); } ) );
+	check( "cull face splits", splitsBatch( [=] { ctx->pushCullFace( GL_FRONT ); }, [=] { ctx->popCullFace(); } ) );
+	check( "front face splits", splitsBatch( [=] { ctx->pushFrontFace( GL_CW ); }, [=] { ctx->popFrontFace(); } ) );
+#if ! defined( CINDER_GL_ES )
+	check( "polygon mode splits", splitsBatch( [=] { ctx->pushPolygonMode( GL_FRONT_AND_BACK, GL_LINE ); }, [=] { ctx->popPolygonMode( GL_FRONT_AND_BACK ); } ) );
+#endif
+	check( "stencil test splits", splitsBatch( [=] { ctx->pushBoolState( GL_STENCIL_TEST, GL_TRUE ); }, [=] { ctx->popBoolState( GL_STENCIL_TEST ); } ) );
+	check( "texture on unit 1 splits", splitsBatch( [=] { ctx->pushTextureBinding( GL_TEXTURE_2D, mTexture->getId(), 1 ); }, [=] { ctx->popTextureBinding( GL_TEXTURE_2D, 1 ); } ) );
+
+	// not captured, so flushed as soon as they change
+	const uint8_t uncapturedUnit = gl::AutoBatch::NUM_TEXTURE_UNITS;
+	check( "texture on an uncaptured unit flushes", flushesBatch( [=] { ctx->pushTextureBinding( GL_TEXTURE_2D, mTexture->getId(), uncapturedUnit ); }, [=] { ctx->popTextureBinding( GL_TEXTURE_2D, uncapturedUnit ); } ) );
+	{
+		// the binding is popped while the second draw is pending
+		gl::ScopedAutoBatch batchScp;
+		ctx->pushTextureBinding( GL_TEXTURE_2D, mTexture->getId(), uncapturedUnit );
+		gl::drawSolidRect( Rectf( 0, 0, 8, 8 ) );
+		ctx->popTextureBinding( GL_TEXTURE_2D, uncapturedUnit );
+		check( "popping a texture on an uncaptured unit flushes", batchScp.getNumDrawsIssued() == 1 );
+	}
+	check( "colorMask flushes", flushesBatch( [] { gl::colorMask( GL_FALSE, GL_TRUE, GL_TRUE, GL_TRUE ); }, [] { gl::colorMask( GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE ); } ) );
+	check( "stencilFunc flushes", flushesBatch( [] { gl::stencilFunc( GL_EQUAL, 1, 0xFF ); }, [] { gl::stencilFunc( GL_ALWAYS, 0, 0xFF ); } ) );
+	check( "stencilOp flushes", flushesBatch( [] { gl::stencilOp( GL_KEEP, GL_KEEP, GL_REPLACE ); }, [] { gl::stencilOp( GL_KEEP, GL_KEEP, GL_KEEP ); } ) );
+	check( "stencilMask flushes", flushesBatch( [] { gl::stencilMask( 0 ); }, [] { gl::stencilMask( 0xFF ); } ) );
+	check( "clear flushes", flushesBatch( [] { gl::clear(); }, []{} ) );
+	{
+		// the texture stays bound while its contents change
+		gl::ScopedTextureBind texScp( mTexture );
+		check( "Texture update flushes", flushesBatch( [=] { mTexture->update( Surface8u( 4, 4, true ) ); }, []{} ) );
+	}
+
+	// the pending draw should be issued with the color mask it was made with
+	gl::clear( Color::black() );
+	{
+		gl::ScopedAutoBatch batchScp;
+		gl::ScopedColor colorScp( Color( 1, 0, 0 ) );
+		gl::drawSolidRect( mFbo->getBounds() );
+		gl::colorMask( GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE );
+	}
+	gl::colorMask( GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE );
+	check( "draws pending before colorMask are written", mFbo->readPixels8u( Area( 16, 16, 17, 17 ) ).getPixel( ivec2( 0 ) ) == ColorA8u( 255, 0, 0, 255 ) );
+
+	string vert = CI_GLSL( 150,
+		uniform mat4	ciModelViewProjection;
+		in vec4			ciPosition;
+		in vec3			ciNormal;
+		out vec3		vNormal;
+
+		void main() {
+			vNormal = ciNormal;
+			gl_Position = ciModelViewProjection * ciPosition;
+		}
+	);
+	string frag = CI_GLSL( 150,
+		in vec3		vNormal;
+		out vec4	oColor;
+
+		void main() {
+			oColor = vec4( abs( vNormal ), 1 );
+		}
+	);
+	auto normalGlsl = gl::GlslProg::create( vert, frag );
+	auto drawRect = [=] { gl::drawSolidRect( mFbo->getBounds() ); };
+	check( "batched rects without normals match unbatched ones", drawCenter( normalGlsl, true, drawRect ) == drawCenter( normalGlsl, false, drawRect ) );
+	auto drawCircle = [=] { gl::drawSolidCircle( mFbo->getBounds().getCenter(), 8 ); };
+	check( "batched circles have the same normals as unbatched ones", drawCenter( normalGlsl, true, drawCircle ) == drawCenter( normalGlsl, false, drawCircle ) );
+	auto drawEllipse = [=] { gl::drawSolidEllipse( mFbo->getBounds().getCenter(), 8, 4 ); };
+	check( "batched ellipses have the same normals as unbatched ones", drawCenter( normalGlsl, true, drawEllipse ) == drawCenter( normalGlsl, false, drawEllipse ) );
+
+	console() << "AutoBatch verification " << ( mPassed ? "passed" : "FAILED" ) << endl;
+	quit();
+}
+
+bool AutoBatchTestApp::splitsBatch( const StateChange &change, const StateChange &restore )
+{
+	gl::ScopedAutoBatch batchScp;
+	gl::drawSolidRect( Rectf( 0, 0, 8, 8 ) );
+	change();
+	gl::drawSolidRect( Rectf( 8, 0, 16, 8 ) );
+	batchScp.flush();
+	restore();
+	return batchScp.getNumDrawsIssued() == 2;
+}
+
+bool AutoBatchTestApp::flushesBatch( const StateChange &change, const StateChange &restore )
+{
+	gl::ScopedAutoBatch batchScp;
+	gl::drawSolidRect( Rectf( 0, 0, 8, 8 ) );
+	change();
+	bool flushed = batchScp.getNumDrawsIssued() == 1;
+	restore();
+	return flushed;
+}
+
+ColorA8u AutoBatchTestApp::drawCenter( const gl::GlslProgRef &glsl, bool batched, const function<void ()> &draw )
+{
+	gl::ScopedGlslProg glslScp( glsl );
+	gl::clear( Color::black() );
+	if( batched ) {
+		gl::ScopedAutoBatch batchScp;
+		draw();
+	}
+	else
+		draw();
+
+	return mFbo->readPixels8u( Area( 16, 16, 17, 17 ) ).getPixel( ivec2( 0 ) );
+}
+
+void AutoBatchTestApp::check( const string &what, bool condition )
+{
+	if( ! condition ) {
+		console() << "failed: " << what << endl;
+		mPassed = false;
+	}
+}
+
+CINDER_APP( AutoBatchTestApp, RendererGl )
@@ -0,0 +1,137 @@
+// Measures how long it takes to generate each geom::Source primitive into a Target that only implements copyAttrib(), into a TriMesh
+// and into a gl::VboMesh, the latter two of which hand the Source their own storage through acquireAttribBuffer(). Each primitive is
+// loaded once with all of its attributes and once with positions only, since Sources now skip the attributes that weren't requested.
+// Reports the average time per load in microseconds; results are printed to the console and drawn.
+
+#include "cinder/app/App.h"
+#include "cinder/app/RendererGl.h"
+#include "cinder/gl/gl.h"
+
+#include "cinder/GeomIo.h"
+#include "cinder/TriMesh.h"
+#include "cinder/Timer.h"
+
+#include <functional>
+#include <iomanip>
+#include <sstream>
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+const int	NUM_ITERATIONS = 50;
+
+//! Stores every attribute in a separate vector, which is how Targets without acquireAttribBuffer() receive their data.
+class CopyingTarget : public geom::Target {
+  public:
+	CopyingTarget( const geom::Source &source )
+		: mSource( source )
+	{}
+
+	uint8_t	getAttribDims( geom::Attrib attr ) const override	{ return mSource.getAttribDims( attr ); }
+
+	void copyAttrib( geom::Attrib attr, uint8_t dims, size_t strideBytes, const float *srcData, size_t count ) override
+	{
+		auto &data = mAttribs[attr];
+		data.resize( dims * count );
+		geom::copyData( dims, strideBytes, srcData, count, dims, 0, data.data() );
+	}
+
+	void copyIndices( geom::Primitive /*primitive*/, const uint32_t *source, size_t numIndices, uint8_t /*requiredBytesPerIndex*/ ) override
+	{
+		mIndices.assign( source, source + numIndices );
+	}
+
+	const geom::Source				&mSource;
+	map<geom::Attrib, vector<float>>	mAttribs;
+	vector<uint32_t>				mIndices;
+};
+
+class GeomIoBenchmarkApp : public App {
+  public:
+	void setup() override;
+	void draw() override;
+
+	//! Returns the average number of microseconds \a fn takes over NUM_ITERATIONS runs.
+	double measure( const function<void ()> &fn );
+
+	vector<string>	mResults;
+};
+
+void GeomIoBenchmarkApp::setup()
+{
+	vector<pair<string, geom::SourceRef>> sources = {
+		{ "Cube", geom::SourceRef( geom::Cube().subdivisions( 32 ).colors().clone() ) },
+		{ "Icosphere", geom::SourceRef( geom::Icosphere().subdivisions( 5 ).clone() ) },
+		{ "Teapot", geom::SourceRef( geom::Teapot().subdivisions( 16 ).clone() ) },
+		{ "Circle", geom::SourceRef( geom::Circle().subdivisions( 4096 ).clone() ) },
+		{ "Ring", geom::SourceRef( geom::Ring().subdivisions( 4096 ).clone() ) },
+		{ "Sphere", geom::SourceRef( geom::Sphere().subdivisions( 256 ).colors().clone() ) },
+		{ "Capsule", geom::SourceRef( geom::Capsule().subdivisionsAxis( 128 ).subdivisionsHeight( 64 ).colors().clone() ) },
+		{ "Torus", geom::SourceRef( geom::Torus().subdivisionsAxis( 256 ).subdivisionsHeight( 128 ).colors().clone() ) },
+		{ "TorusKnot", geom::SourceRef( geom::TorusKnot().subdivisionsAxis( 1024 ).subdivisionsHeight( 32 ).colors().clone() ) },
+		{ "Cylinder", geom::SourceRef( geom::Cylinder().subdivisionsAxis( 256 ).subdivisionsHeight( 64 ).subdivisionsCap( 16 ).colors().clone() ) },
+		{ "Plane", geom::SourceRef( geom::Plane().subdivisions( ivec2( 256 ) ).clone() ) }
+	};
+
+	mResults.push_back( "microseconds per load, all attributes / positions only:" );
+	for( const auto &entry : sources ) {
+		const geom::Source &source = *entry.second;
+		geom::AttribSet all = source.getAvailableAttribs();
+		geom::AttribSet positions = { geom::Attrib::POSITION };
+
+		double copiedAll = measure( [&] { CopyingTarget target( source ); source.loadInto( &target, all ); } );
+		double copiedPositions = measure( [&] { CopyingTarget target( source ); source.loadInto( &target, positions ); } );
+		// TriMesh can only hold triangle lists
+		bool triangles = source.getPrimitive() == geom::Primitive::TRIANGLES;
+		double triMeshAll = triangles ? measure( [&] { TriMesh mesh( source ); } ) : 0;
+		double triMeshPositions = triangles ? measure( [&] { TriMesh mesh( source, TriMesh::Format().positions( source.getAttribDims( geom::Attrib::POSITION ) ) ); } ) : 0;
+		double vboMeshAll = measure( [&] { gl::VboMesh::create( source, all ); } );
+		double vboMeshPositions = measure( [&] { gl::VboMesh::create( source, positions ); } );
+
+		ostringstream ss;
+		ss << fixed << setprecision( 1 );
+		ss << entry.first << " (" << source.getNumVertices() << " vertices): copyAttrib " << copiedAll << " / " << copiedPositions;
+		if( triangles )
+			ss << ", TriMesh " << triMeshAll << " / " << triMeshPositions;
+		ss << ", VboMesh " << vboMeshAll << " / " << vboMeshPositions;
+		mResults.push_back( ss.str() );
+	}
+
+	for( const auto &result : mResults )
+		console() << result << endl;
+}
+
+double GeomIoBenchmarkApp::measure( const function<void ()> &fn )
+{
+	// warm up the allocator and the Sources' caches
+	fn();
+
+	Timer timer( true );
+	for( int i = 0; i < NUM_ITERATIONS; i++ )
+		fn();
+	// include the time the driver takes to finish the buffer uploads
+	glFinish();
+	return timer.getSeconds() * 1000000 / NUM_ITERATIONS;
+}
+
+void GeomIoBenchmarkApp::draw()
+{
+	gl::clear();
+	gl::setMatricesWindow( getWindowSize() );
+
+	vec2 pos( 20, 20 );
+	for( const auto &result : mResults ) {
+		gl::drawString( result, pos );
+		pos.y += 20;
+	}
+}
+
+auto settingsFunc = []( App::Settings *settings ) {
+	settings->setWindowSize( 900, 300 );
+#if defined( CINDER_MSW )
+	settings->setConsoleWindowEnabled();
+#endif
+};
+
+CINDER_APP( GeomIoBenchmarkApp, RendererGl, settingsFunc )
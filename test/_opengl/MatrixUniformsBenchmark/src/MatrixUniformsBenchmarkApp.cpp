@@ -0,0 +1,133 @@
+// Draws a Batch 10,000 times into an Fbo, once with static transforms and once with the model matrix changing before every draw,
+// using a GlslProg that declares every default matrix uniform. Reports the average CPU time per frame and how many matrix uniforms
+// Context::setDefaultShaderVars() set, which only happens for the matrices whose stacks changed since the GlslProg last received them.
+// Build Cinder with CINDER_HEADLESS_GL_OSMESA to run it headless. Results are printed to the console and drawn.
+
+#include "cinder/app/App.h"
+#include "cinder/app/RendererGl.h"
+#include "cinder/gl/gl.h"
+
+#include "cinder/Timer.h"
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+const int	NUM_DRAWS = 10000;
+const int	NUM_FRAMES = 20;
+
+const char *VERTEX_SHADER = R"(
+	#version 150
+	uniform mat4 ciModelMatrix, ciModelMatrixInverse, ciViewMatrix, ciViewMatrixInverse;
+	uniform mat4 ciModelView, ciModelViewInverse, ciModelViewProjection, ciModelViewProjectionInverse;
+	uniform mat4 ciProjectionMatrix, ciProjectionMatrixInverse, ciViewProjection;
+	uniform mat3 ciModelMatrixInverseTranspose, ciModelViewInverseTranspose, ciNormalMatrix;
+
+	in vec4 ciPosition;
+	out vec4 vColor;
+
+	void main()
+	{
+		// use every matrix, so that none of them are optimized out
+		mat4 sum = ciModelMatrix + ciModelMatrixInverse + ciViewMatrix + ciViewMatrixInverse + ciModelView + ciModelViewInverse
+				+ ciModelViewProjectionInverse + ciProjectionMatrix + ciProjectionMatrixInverse + ciViewProjection;
+		mat3 sum3 = ciModelMatrixInverseTranspose + ciModelViewInverseTranspose + ciNormalMatrix;
+		vColor = vec4( 0.5 + 0.001 * ( sum[0].xyz + sum3[0] ), 1 );
+		gl_Position = ciModelViewProjection * ciPosition;
+	}
+)";
+
+const char *FRAGMENT_SHADER = R"(
+	#version 150
+	in vec4 vColor;
+	out vec4 oColor;
+
+	void main()
+	{
+		oColor = vColor;
+	}
+)";
+
+class MatrixUniformsBenchmarkApp : public App {
+  public:
+	void setup() override;
+	void draw() override;
+
+	//! Draws \a numFrames frames into mFbo, returning the number of matrix uniforms that were set.
+	size_t drawFrames( bool staticTransforms, int numFrames );
+
+	gl::FboRef		mFbo;
+	gl::BatchRef	mBatch;
+	vector<string>	mResults;
+};
+
+void MatrixUniformsBenchmarkApp::setup()
+{
+	mFbo = gl::Fbo::create( 512, 512 );
+	auto glsl = gl::GlslProg::create( gl::GlslProg::Format().vertex( VERTEX_SHADER ).fragment( FRAGMENT_SHADER ) );
+	mBatch = gl::Batch::create( geom::Rect( Rectf( 0, 0, 8, 8 ) ), glsl );
+
+	mResults.push_back( to_string( NUM_DRAWS ) + " draws per frame, " + to_string( glsl->getActiveUniforms().size() ) + " matrix uniforms" );
+	for( bool staticTransforms : { true, false } ) {
+		// warm up before timing
+		drawFrames( staticTransforms, 1 );
+
+		Timer timer( true );
+		size_t numMatrixUniformsSet = drawFrames( staticTransforms, NUM_FRAMES );
+		double seconds = timer.getSeconds() / NUM_FRAMES;
+
+		mResults.push_back( staticTransforms ? "static transforms:" : "model matrix changes every draw:" );
+		mResults.push_back( "    " + to_string( seconds * 1000 ) + " ms, " + to_string( numMatrixUniformsSet / NUM_FRAMES ) + " matrix uniforms set per frame" );
+	}
+
+	for( const auto &result : mResults )
+		console() << result << endl;
+}
+
+size_t MatrixUniformsBenchmarkApp::drawFrames( bool staticTransforms, int numFrames )
+{
+	gl::ScopedFramebuffer fboScp( mFbo );
+	gl::ScopedViewport viewportScp( mFbo->getSize() );
+	gl::ScopedMatrices matricesScp;
+	gl::setMatricesWindowPersp( mFbo->getSize() );
+
+	auto ctx = gl::context();
+	const size_t startNumMatrixUniformsSet = ctx->getNumMatrixUniformsSet();
+	for( int frame = 0; frame < numFrames; frame++ ) {
+		gl::clear();
+		for( int i = 0; i < NUM_DRAWS; i++ ) {
+			if( staticTransforms )
+				mBatch->draw();
+			else {
+				gl::ScopedModelMatrix modelScp;
+				gl::translate( ( i * 37 ) % 500, ( i * 53 ) % 500 );
+				mBatch->draw();
+			}
+		}
+	}
+
+	// include the time the driver takes to finish the frames
+	glFinish();
+	return ctx->getNumMatrixUniformsSet() - startNumMatrixUniformsSet;
+}
+
+void MatrixUniformsBenchmarkApp::draw()
+{
+	gl::clear();
+	gl::setMatricesWindow( getWindowSize() );
+
+	vec2 pos( 20, 20 );
+	for( const auto &result : mResults ) {
+		gl::drawString( result, pos );
+		pos.y += 20;
+	}
+}
+
+auto settingsFunc = []( App::Settings *settings ) {
+	settings->setWindowSize( 800, 200 );
+#if defined( CINDER_MSW )
+	settings->setConsoleWindowEnabled();
+#endif
+};
+
+CINDER_APP( MatrixUniformsBenchmarkApp, RendererGl, settingsFunc )
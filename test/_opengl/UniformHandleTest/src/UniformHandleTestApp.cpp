@@ -0,0 +1,137 @@
+// Checks that uniforms set through GlslProg::UniformHandle land at the same locations as the name variants and
+// compares the cost of both paths. Prints its results to the console and quits, so it can be run with a headless
+// renderer (CINDER_HEADLESS_GL=osmesa or egl).
+
+#include "cinder/app/App.h"
+#include "cinder/app/RendererGl.h"
+#include "cinder/gl/gl.h"
+#include "cinder/Timer.h"
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+const int NUM_UNIFORMS = 40;
+const int NUM_DRAWS = 20000;
+
+class UniformHandleTestApp : public App {
+  public:
+	void setup() override;
+
+	bool verify();
+	void benchmark();
+
+	gl::GlslProgRef		mGlsl;
+	vector<string>		mNames;
+};
+
+void UniformHandleTestApp::setup()
+{
+	string vert = CI_GLSL( 150,
+		uniform mat4	ciModelViewProjection;
+		uniform vec4	uValues[40];
+		uniform vec3	uOffsets[4];
+		in vec4			ciPosition;
+		out vec4		vColor;
+
+		void main() {
+			vec4 sum = vec4( 0 );
+			for( int i = 0; i < 40; i++ )
+				sum += uValues[i];
+			vColor = sum + vec4( uOffsets[0] + uOffsets[3], 0 );
+			gl_Position = ciModelViewProjection * ciPosition;
+		}
+	);
+	string frag = CI_GLSL( 150,
+		uniform float	uScale;
+		in vec4			vColor;
+		out vec4		oColor;
+
+		void main() {
+			oColor = vColor * uScale;
+		}
+	);
+
+	mGlsl = gl::GlslProg::create( vert, frag );
+	for( int i = 0; i < NUM_UNIFORMS; i++ )
+		mNames.push_back( "uValues[" + to_string( i ) + "]" );
+
+	bool passed = verify();
+	console() << "UniformHandle verification " << ( passed ? "passed" : "FAILED" ) << endl;
+	benchmark();
+
+	quit();
+}
+
+bool UniformHandleTestApp::verify()
+{
+	bool passed = true;
+	auto check = [&]( const string &name, const gl::GlslProg::UniformHandle &handle ) {
+		if( ! handle || handle.getLocation() != mGlsl->getUniformLocation( name ) ) {
+			console() << "mismatched location for " << name << endl;
+			passed = false;
+		}
+	};
+
+	for( const auto &name : mNames )
+		check( name, mGlsl->getUniformHandle( name ) );
+	check( "uOffsets[3]", mGlsl->getUniformHandle( "uOffsets[3]" ) );
+	check( "uScale", mGlsl->getUniformHandle( "uScale" ) );
+
+	if( mGlsl->getUniformHandle( "uMissing" ) ) {
+		console() << "handle for missing uniform is valid" << endl;
+		passed = false;
+	}
+
+	// values set through a handle should be readable from the program
+	auto offsetHandle = mGlsl->getUniformHandle( "uOffsets[3]" );
+	mGlsl->uniform( offsetHandle, vec3( 1, 2, 3 ) );
+	vec3 readBack;
+	glGetUniformfv( mGlsl->getHandle(), offsetHandle.getLocation(), &readBack.x );
+	if( readBack != vec3( 1, 2, 3 ) ) {
+		console() << "uOffsets[3] read back as " << readBack << endl;
+		passed = false;
+	}
+
+	auto scaleHandle = mGlsl->getUniformHandle( "uScale" );
+	mGlsl->uniform( scaleHandle, 0.5f );
+	mGlsl->uniform( "uScale", 0.25f );
+	float scale;
+	glGetUniformfv( mGlsl->getHandle(), scaleHandle.getLocation(), &scale );
+	if( scale != 0.25f ) {
+		console() << "uScale read back as " << scale << endl;
+		passed = false;
+	}
+
+	return passed;
+}
+
+void UniformHandleTestApp::benchmark()
+{
+	vector<gl::GlslProg::UniformHandle> handles;
+	for( const auto &name : mNames )
+		handles.push_back( mGlsl->getUniformHandle( name ) );
+
+	gl::ScopedGlslProg glslScope( mGlsl );
+
+	// values alternate per draw so that the value cache doesn't skip the GL calls
+	Timer timer( true );
+	for( int d = 0; d < NUM_DRAWS; d++ ) {
+		for( int i = 0; i < NUM_UNIFORMS; i++ )
+			mGlsl->uniform( mNames[i], vec4( float( d & 1 ) ) );
+	}
+	double nameSeconds = timer.getSeconds();
+
+	timer.start();
+	for( int d = 0; d < NUM_DRAWS; d++ ) {
+		for( int i = 0; i < NUM_UNIFORMS; i++ )
+			mGlsl->uniform( handles[i], vec4( float( d & 1 ) ) );
+	}
+	double handleSeconds = timer.getSeconds();
+
+	console() << NUM_DRAWS << " draws x " << NUM_UNIFORMS << " uniforms" << endl;
+	console() << "  by name:   " << nameSeconds * 1000 << " ms" << endl;
+	console() << "  by handle: " << handleSeconds * 1000 << " ms (" << nameSeconds / handleSeconds << "x)" << endl;
+}
+
+CINDER_APP( UniformHandleTestApp, RendererGl )
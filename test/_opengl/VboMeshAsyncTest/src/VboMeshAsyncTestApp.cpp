@@ -0,0 +1,102 @@
+// Checks that VboMesh::createAsync() produces the same buffers as VboMesh::create(), that a Source which throws leaves the
+// AsyncLoad failed rather than ready, and that an AsyncLoad can be destroyed while its Source is still running. Prints its
+// results to the console and quits, so it can be run with a headless renderer (CINDER_HEADLESS_GL=osmesa or egl).
+
+#include "cinder/app/App.h"
+#include "cinder/app/RendererGl.h"
+#include "cinder/gl/gl.h"
+
+#include <stdexcept>
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+//! Writes the vertices of the wrapped Source, then throws.
+class ThrowingSource : public geom::Source {
+  public:
+	ThrowingSource( const geom::Source &source )
+		: mSource( source.clone() )
+	{}
+
+	size_t				getNumVertices() const override						{ return mSource->getNumVertices(); }
+	size_t				getNumIndices() const override						{ return mSource->getNumIndices(); }
+	geom::Primitive		getPrimitive() const override						{ return mSource->getPrimitive(); }
+	uint8_t				getAttribDims( geom::Attrib attr ) const override	{ return mSource->getAttribDims( attr ); }
+	geom::AttribSet		getAvailableAttribs() const override				{ return mSource->getAvailableAttribs(); }
+	ThrowingSource*		clone() const override								{ return new ThrowingSource( *mSource ); }
+
+	void loadInto( geom::Target *target, const geom::AttribSet &requestedAttribs ) const override
+	{
+		mSource->loadInto( target, requestedAttribs );
+		throw runtime_error( "ThrowingSource" );
+	}
+
+	geom::SourceRef		mSource;
+};
+
+class VboMeshAsyncTestApp : public App {
+  public:
+	void setup() override;
+
+	void check( const string &what, bool condition );
+
+	bool	mPassed;
+};
+
+//! Returns the contents of \a vbo, or an empty vector if it is null.
+vector<uint8_t> readBack( const gl::VboRef &vbo )
+{
+	vector<uint8_t> result;
+	if( vbo ) {
+		result.resize( vbo->getSize() );
+		vbo->getBufferSubData( 0, vbo->getSize(), result.data() );
+	}
+	return result;
+}
+
+void VboMeshAsyncTestApp::setup()
+{
+	mPassed = true;
+
+	geom::Teapot teapot = geom::Teapot().subdivisions( 12 );
+	auto expected = gl::VboMesh::create( teapot );
+	auto asyncLoad = gl::VboMesh::createAsync( teapot );
+	while( ! asyncLoad->isReady() )
+		;
+	auto loaded = asyncLoad->getVboMesh();
+	check( "async load succeeded", ! asyncLoad->hasFailed() );
+	check( "same number of vertices", loaded->getNumVertices() == expected->getNumVertices() );
+	check( "same number of indices", loaded->getNumIndices() == expected->getNumIndices() );
+	check( "same vertex data", readBack( loaded->getVertexArrayLayoutVbos()[0].second ) == readBack( expected->getVertexArrayLayoutVbos()[0].second ) );
+	check( "same index data", readBack( loaded->getIndexVbo() ) == readBack( expected->getIndexVbo() ) );
+
+	auto failedLoad = gl::VboMesh::createAsync( ThrowingSource( teapot ) );
+	while( ! failedLoad->hasFailed() )
+		check( "a Source that throws is never ready", ! failedLoad->isReady() );
+	check( "a failed load stays failed", ! failedLoad->isReady() );
+	bool rethrown = false;
+	try {
+		failedLoad->getVboMesh();
+	}
+	catch( const runtime_error & ) {
+		rethrown = true;
+	}
+	check( "getVboMesh() rethrows the Source's exception", rethrown );
+
+	// blocks until the worker thread is done with the Source
+	gl::VboMesh::createAsync( geom::Sphere().subdivisions( 512 ) ).reset();
+
+	console() << "VboMesh::AsyncLoad verification " << ( mPassed ? "passed" : "FAILED" ) << endl;
+	quit();
+}
+
+void VboMeshAsyncTestApp::check( const string &what, bool condition )
+{
+	if( ! condition ) {
+		console() << "failed: " << what << endl;
+		mPassed = false;
+	}
+}
+
+CINDER_APP( VboMeshAsyncTestApp, RendererGl )
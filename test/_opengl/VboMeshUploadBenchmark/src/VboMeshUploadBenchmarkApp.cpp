@@ -0,0 +1,98 @@
+// Measures how long it takes to build a gl::VboMesh from large Teapot, Icosphere and Sphere geom::Sources, once with
+// VboMesh::create(), which writes the vertex data straight into the mapped VBO, and once with VboMesh::createAsync(), which fills
+// mapped staging buffers on a worker thread. For the latter it reports both the total time until the mesh is ready and how much of
+// that the main thread spent in createAsync() and AsyncLoad::isReady(), which is what a frame pays when a mesh streams in while
+// drawing. Results are printed to the console and drawn.
+
+#include "cinder/app/App.h"
+#include "cinder/app/RendererGl.h"
+#include "cinder/gl/gl.h"
+
+#include "cinder/Timer.h"
+
+#include <sstream>
+#include <thread>
+
+using namespace ci;
+using namespace ci::app;
+using namespace std;
+
+const int	NUM_ITERATIONS = 10;
+
+class VboMeshUploadBenchmarkApp : public App {
+  public:
+	void setup() override;
+	void draw() override;
+
+	vector<string>	mResults;
+};
+
+void VboMeshUploadBenchmarkApp::setup()
+{
+	vector<pair<string, geom::SourceRef>> sources = {
+		{ "Teapot( 64 )", geom::SourceRef( geom::Teapot().subdivisions( 64 ).clone() ) },
+		{ "Icosphere( 6 )", geom::SourceRef( geom::Icosphere().subdivisions( 6 ).clone() ) },
+		{ "Sphere( 1024 )", geom::SourceRef( geom::Sphere().subdivisions( 1024 ).clone() ) }
+	};
+
+	for( const auto &entry : sources ) {
+		const geom::Source &source = *entry.second;
+		// the first load warms up the driver and Icosphere's cache
+		gl::VboMesh::create( source );
+		glFinish();
+
+		Timer timer( true );
+		for( int i = 0; i < NUM_ITERATIONS; i++ )
+			gl::VboMesh::create( source );
+		glFinish();
+		double createMs = timer.getSeconds() * 1000 / NUM_ITERATIONS;
+
+		double asyncMs = 0, asyncMainThreadMs = 0;
+		for( int i = 0; i < NUM_ITERATIONS; i++ ) {
+			Timer totalTimer( true ), mainThreadTimer( true );
+			auto asyncLoad = gl::VboMesh::createAsync( source );
+			asyncMainThreadMs += mainThreadTimer.getSeconds() * 1000;
+			while( true ) {
+				mainThreadTimer.start();
+				bool ready = asyncLoad->isReady();
+				asyncMainThreadMs += mainThreadTimer.getSeconds() * 1000;
+				if( ready )
+					break;
+				// stands in for the rest of a frame
+				this_thread::sleep_for( chrono::microseconds( 500 ) );
+			}
+			asyncMs += totalTimer.getSeconds() * 1000;
+		}
+		asyncMs /= NUM_ITERATIONS;
+		asyncMainThreadMs /= NUM_ITERATIONS;
+
+		ostringstream ss;
+		ss << entry.first << ", " << source.getNumVertices() << " vertices: create() " << createMs << " ms, createAsync() "
+			<< asyncMs << " ms of which " << asyncMainThreadMs << " ms on the main thread";
+		mResults.push_back( ss.str() );
+	}
+
+	for( const auto &result : mResults )
+		console() << result << endl;
+}
+
+void VboMeshUploadBenchmarkApp::draw()
+{
+	gl::clear();
+	gl::setMatricesWindow( getWindowSize() );
+
+	vec2 pos( 20, 20 );
+	for( const auto &result : mResults ) {
+		gl::drawString( result, pos );
+		pos.y += 20;
+	}
+}
+
+auto settingsFunc = []( App::Settings *settings ) {
+	settings->setWindowSize( 900, 200 );
+#if defined( CINDER_MSW )
+	settings->setConsoleWindowEnabled();
+#endif
+};
+
+CINDER_APP( VboMeshUploadBenchmarkApp, RendererGl, settingsFunc )
@@ -0,0 +1,74 @@
+#include "cinder/DataSource.h"
+
+#include "catch.hpp"
+
+#include <cstring>
+#include <fstream>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+fs::path writeTemporaryFile( const string &name, const string &contents )
+{
+	fs::path path = fs::temp_directory_path() / name;
+	ofstream( path.string(), ios::binary ) << contents;
+	return path;
+}
+
+} // anonymous namespace
+
+TEST_CASE( "DataSource" )
+{
+	SECTION( "DataSourceMapped" )
+	{
+		const string contents = "mapped\nfile\ncontents";
+		fs::path path = writeTemporaryFile( "cinder_DataSourceMapped.txt", contents );
+
+		BufferRef buffer;
+		IStreamRef stream;
+		{
+			DataSourceMappedRef source = DataSourceMapped::create( path, DataSourceMapped::RANDOM );
+			REQUIRE( source->isFilePath() );
+			REQUIRE( source->getFilePath() == path );
+			REQUIRE( source->getSize() == contents.size() );
+			source->prefetch();
+			source->prefetch( 4, 1000 );
+			source->setAccessPattern( DataSourceMapped::SEQUENTIAL );
+
+			buffer = source->getBuffer();
+			REQUIRE( buffer->getData() == source->getData() );
+			stream = source->createStream();
+		}
+
+		// both outlive the DataSource
+		REQUIRE( string( static_cast<const char*>( buffer->getData() ), buffer->getSize() ) == contents );
+		REQUIRE( stream->readLine() == "mapped" );
+		REQUIRE( stream->readLine() == "file" );
+		REQUIRE( stream->getFileName() == path );
+
+		// writes are private to the process
+		memcpy( buffer->getData(), "MAPPED", 6 );
+		REQUIRE( string( static_cast<const char*>( loadFile( path )->getBuffer()->getData() ), 6 ) == "mapped" );
+
+		stream.reset();
+		buffer.reset();
+		fs::remove( path );
+	}
+
+	SECTION( "DataSourceMapped empty file" )
+	{
+		fs::path path = writeTemporaryFile( "cinder_DataSourceMapped_empty.txt", "" );
+		DataSourceRef source = loadFileMapped( path );
+		REQUIRE( source->getBuffer()->getSize() == 0 );
+		REQUIRE( source->createStream()->isEof() );
+		source.reset();
+		fs::remove( path );
+	}
+
+	SECTION( "DataSourceMapped missing file" )
+	{
+		REQUIRE_THROWS_AS( DataSourceMapped::create( fs::temp_directory_path() / "cinder_DataSourceMapped_missing" ), StreamExc );
+	}
+}
@@ -0,0 +1,160 @@
+#include "cinder/GeomIo.h"
+#include "cinder/TriMesh.h"
+
+#include "catch.hpp"
+
+#include <functional>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+// Records everything passed to copyAttrib(), which is all a Source can do with a Target that doesn't implement acquireAttribBuffer().
+class RecordingTarget : public geom::Target {
+  public:
+	RecordingTarget( const geom::Source &source )
+		: mSource( source )
+	{}
+
+	uint8_t	getAttribDims( geom::Attrib attr ) const override	{ return mSource.getAttribDims( attr ); }
+
+	void copyAttrib( geom::Attrib attr, uint8_t dims, size_t strideBytes, const float *srcData, size_t count ) override
+	{
+		auto &data = mAttribs[attr];
+		data.resize( dims * count );
+		geom::copyData( dims, strideBytes, srcData, count, dims, 0, data.data() );
+	}
+
+	void copyIndices( geom::Primitive /*primitive*/, const uint32_t *source, size_t numIndices, uint8_t /*requiredBytesPerIndex*/ ) override
+	{
+		mIndices.assign( source, source + numIndices );
+	}
+
+	const geom::Source				&mSource;
+	map<geom::Attrib, vector<float>>	mAttribs;
+	vector<uint32_t>				mIndices;
+};
+
+// Hands out interleaved storage with a padding float after each element, so that Sources have to respect the stride.
+class AcquiringTarget : public RecordingTarget {
+  public:
+	AcquiringTarget( const geom::Source &source )
+		: RecordingTarget( source )
+	{}
+
+	float* acquireAttribBuffer( geom::Attrib attr, uint8_t dims, size_t count, size_t *resultStrideBytes ) override
+	{
+		mAcquired[attr] = make_pair( dims, vector<float>( ( dims + 1 ) * count, -1234.0f ) );
+		*resultStrideBytes = ( dims + 1 ) * sizeof(float);
+		return mAcquired[attr].second.data();
+	}
+
+	//! Adds the attributes written into acquired storage to the recorded ones.
+	void finish()
+	{
+		for( auto &acquired : mAcquired ) {
+			uint8_t dims = acquired.second.first;
+			const auto &storage = acquired.second.second;
+			size_t count = storage.size() / ( dims + 1 );
+			// the padding must be untouched
+			for( size_t i = 0; i < count; ++i )
+				REQUIRE( storage[i * ( dims + 1 ) + dims] == -1234.0f );
+			RecordingTarget::copyAttrib( acquired.first, dims, ( dims + 1 ) * sizeof(float), storage.data(), count );
+		}
+	}
+
+	map<geom::Attrib, pair<uint8_t, vector<float>>>	mAcquired;
+};
+
+vector<pair<string, function<geom::SourceRef ()>>> allSources()
+{
+	return {
+		{ "Rect", [] { return geom::SourceRef( geom::Rect( Rectf( 0, 0, 2, 1 ) ).colors().clone() ); } },
+		{ "RoundedRect", [] { return geom::SourceRef( geom::RoundedRect( Rectf( 0, 0, 2, 1 ), 0.2f ).colors( Color( 1, 0, 0 ), Color( 0, 1, 0 ), Color( 0, 0, 1 ), Color( 1, 1, 1 ) ).clone() ); } },
+		{ "Cube", [] { return geom::SourceRef( geom::Cube().subdivisionsX( 2 ).subdivisionsY( 3 ).subdivisionsZ( 4 ).colors().clone() ); } },
+		{ "Icosahedron", [] { return geom::SourceRef( geom::Icosahedron().colors().clone() ); } },
+		{ "Icosphere", [] { return geom::SourceRef( geom::Icosphere().colors().clone() ); } },
+		{ "Teapot", [] { return geom::SourceRef( geom::Teapot().subdivisions( 4 ).clone() ); } },
+		{ "Circle", [] { return geom::SourceRef( geom::Circle().subdivisions( 20 ).clone() ); } },
+		{ "Ring", [] { return geom::SourceRef( geom::Ring().subdivisions( 20 ).clone() ); } },
+		{ "Sphere", [] { return geom::SourceRef( geom::Sphere().colors().clone() ); } },
+		{ "Capsule", [] { return geom::SourceRef( geom::Capsule().subdivisionsHeight( 6 ).colors().clone() ); } },
+		{ "Torus", [] { return geom::SourceRef( geom::Torus().colors().clone() ); } },
+		{ "TorusKnot", [] { return geom::SourceRef( geom::TorusKnot().colors().clone() ); } },
+		{ "Cylinder", [] { return geom::SourceRef( geom::Cylinder().subdivisionsHeight( 3 ).subdivisionsCap( 2 ).colors().clone() ); } },
+		{ "Cone", [] { return geom::SourceRef( geom::Cone().colors().clone() ); } },
+		{ "Plane", [] { return geom::SourceRef( geom::Plane().subdivisions( ivec2( 3, 5 ) ).clone() ); } }
+	};
+}
+
+} // anonymous namespace
+
+TEST_CASE( "GeomIo" )
+{
+	SECTION( "Sources only emit the requested attributes" )
+	{
+		for( const auto &entry : allSources() ) {
+			INFO( entry.first );
+			auto source = entry.second();
+			for( auto attr : source->getAvailableAttribs() ) {
+				RecordingTarget target( *source );
+				source->loadInto( &target, { attr } );
+				for( const auto &recorded : target.mAttribs )
+					REQUIRE( recorded.first == attr );
+			}
+		}
+	}
+
+	SECTION( "writing into acquired storage matches copyAttrib()" )
+	{
+		for( const auto &entry : allSources() ) {
+			INFO( entry.first );
+			auto source = entry.second();
+			geom::AttribSet requested = source->getAvailableAttribs();
+			// with and without tangents, since those need the other attributes to be readable
+			for( int withTangents = 0; withTangents < 2; ++withTangents ) {
+				if( ! withTangents )
+					requested.erase( geom::Attrib::TANGENT );
+
+				RecordingTarget copied( *source );
+				source->loadInto( &copied, requested );
+				AcquiringTarget acquired( *source );
+				source->loadInto( &acquired, requested );
+				acquired.finish();
+
+				REQUIRE( ! copied.mAttribs.empty() );
+				REQUIRE( acquired.mAttribs == copied.mAttribs );
+				REQUIRE( acquired.mIndices == copied.mIndices );
+				for( const auto &recorded : copied.mAttribs )
+					REQUIRE( recorded.second.size() == source->getNumVertices() * source->getAttribDims( recorded.first ) );
+			}
+		}
+	}
+
+	SECTION( "TriMesh and modifiers are filled through acquired storage" )
+	{
+		for( const auto &entry : allSources() ) {
+			INFO( entry.first );
+			auto source = entry.second();
+			// TriMesh only accepts triangle lists
+			if( source->getPrimitive() != geom::Primitive::TRIANGLES )
+				continue;
+			RecordingTarget copied( *source );
+			source->loadInto( &copied, { geom::Attrib::POSITION, geom::Attrib::NORMAL } );
+
+			TriMesh mesh( *source, TriMesh::Format().positions( source->getAttribDims( geom::Attrib::POSITION ) ).normals() );
+			REQUIRE( mesh.getBufferPositions() == copied.mAttribs[geom::Attrib::POSITION] );
+			REQUIRE( mesh.getNumVertices() == source->getNumVertices() );
+			for( size_t i = 0; i < mesh.getNormals().size(); ++i )
+				REQUIRE( mesh.getNormals()[i] == *reinterpret_cast<const vec3*>( &copied.mAttribs[geom::Attrib::NORMAL][i * 3] ) );
+
+			// SourceModsContext hands its own storage to the Source before the modifier runs
+			TriMesh translated( *source >> geom::Translate( 1, 2, 3 ), TriMesh::Format().positions().normals() );
+			REQUIRE( translated.getNumVertices() == source->getNumVertices() );
+			for( size_t i = 0; i < translated.getNormals().size(); ++i )
+				REQUIRE( distance( translated.getNormals()[i], mesh.getNormals()[i] ) < 0.0001f );
+			REQUIRE( translated.getPositions<3>()[0] == mesh.getPositions<3>()[0] + vec3( 1, 2, 3 ) );
+		}
+	}
+}
@@ -0,0 +1,123 @@
+#include "cinder/ip/Executor.h"
+#include "cinder/Rand.h"
+
+#include "catch.hpp"
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+template<typename T>
+void fillNoise( SurfaceT<T> *surface, uint32_t seed )
+{
+	Rand rnd( seed );
+	for( int32_t y = 0; y < surface->getHeight(); y++ ) {
+		T *row = surface->getData( ivec2( 0, y ) );
+		for( int32_t x = 0; x < surface->getWidth() * surface->getPixelInc(); x++ )
+			row[x] = (T)rnd.nextUint( 256 );
+	}
+}
+
+void fillNoise( Channel8u *channel, uint32_t seed )
+{
+	Rand rnd( seed );
+	for( int32_t y = 0; y < channel->getHeight(); y++ ) {
+		for( int32_t x = 0; x < channel->getWidth(); x++ )
+			*channel->getData( ivec2( x, y ) ) = (uint8_t)rnd.nextUint( 256 );
+	}
+}
+
+bool sameRows( const Surface8u &a, const Surface8u &b )
+{
+	for( int32_t y = 0; y < a.getHeight(); y++ ) {
+		if( memcmp( a.getData( ivec2( 0, y ) ), b.getData( ivec2( 0, y ) ), a.getWidth() * a.getPixelInc() ) != 0 )
+			return false;
+	}
+	return true;
+}
+
+bool sameRows( const Channel8u &a, const Channel8u &b )
+{
+	for( int32_t y = 0; y < a.getHeight(); y++ ) {
+		for( int32_t x = 0; x < a.getWidth(); x++ ) {
+			if( *a.getData( ivec2( x, y ) ) != *b.getData( ivec2( x, y ) ) )
+				return false;
+		}
+	}
+	return true;
+}
+
+} // anonymous namespace
+
+TEST_CASE( "ip::Executor" )
+{
+	// Band heights below, equal to and above the chain's halo, so that every op reads across tile seams. 0 picks the height automatically.
+	const int32_t bandHeights[] = { 1, 5, 16, 0 };
+
+	SECTION( "Surface chain matches serial calls" )
+	{
+		Surface8u src( 123, 97, false );
+		fillNoise( &src, 1 );
+
+		Surface8u serial = src.clone();
+		ip::grayscale( serial, &serial );
+		ip::stackBlur( &serial, 3 );
+		Surface8u edges = serial.clone();
+		ip::edgeDetectSobel( serial, &edges );
+		ip::threshold( edges, (uint8_t)40, &edges );
+
+		ip::Executor<Surface8u> executor;
+		executor.grayscale().stackBlur( 3 ).edgeDetectSobel().threshold( (uint8_t)40 );
+		REQUIRE( executor.getHalo() == 5 );
+		for( int32_t bandHeight : bandHeights ) {
+			executor.setBandHeight( bandHeight );
+			Surface8u result = src.clone();
+			executor.run( &result );
+			REQUIRE( sameRows( result, edges ) );
+		}
+	}
+
+	SECTION( "blend matches serial calls" )
+	{
+		Surface8u background( 101, 83, true, SurfaceChannelOrder::RGBA );
+		fillNoise( &background, 2 );
+		Surface8u foreground( background.getWidth(), background.getHeight(), true, SurfaceChannelOrder::RGBA );
+		fillNoise( &foreground, 3 );
+
+		// blurring first gives the blend a halo to read across
+		Surface8u serial = background.clone();
+		ip::stackBlur( &serial, 2 );
+		ip::blend( &serial, foreground );
+		ip::premultiply( &serial );
+
+		ip::Executor<Surface8u> executor;
+		executor.stackBlur( 2 ).blend( foreground ).premultiply();
+		for( int32_t bandHeight : bandHeights ) {
+			executor.setBandHeight( bandHeight );
+			Surface8u result = background.clone();
+			executor.run( &result );
+			REQUIRE( sameRows( result, serial ) );
+		}
+	}
+
+	SECTION( "Channel chain with adaptiveThreshold matches serial calls" )
+	{
+		Channel8u src( 211, 149 );
+		fillNoise( &src, 4 );
+
+		Channel8u serial = src.clone();
+		ip::stackBlur( &serial, 2 );
+		ip::adaptiveThreshold( &serial, 15, 0.15f );
+
+		ip::Executor<Channel8u> executor;
+		executor.stackBlur( 2 ).adaptiveThreshold( 15, 0.15f );
+		REQUIRE( executor.getHalo() == 10 );
+		for( int32_t bandHeight : bandHeights ) {
+			executor.setBandHeight( bandHeight );
+			Channel8u result = src.clone();
+			executor.run( &result );
+			REQUIRE( sameRows( result, serial ) );
+		}
+	}
+}
@@ -0,0 +1,133 @@
+#include "catch.hpp"
+#include "cinder/Log.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+// Records everything it is asked to write. Optionally stalls writing, to fill up the asynchronous queues.
+class LoggerCapture : public log::Logger {
+  public:
+	LoggerCapture() : mStalled( false ) {}
+
+	void write( const log::Metadata & /*meta*/, const string &text ) override
+	{
+		while( mStalled )
+			this_thread::yield();
+
+		mTexts.push_back( text );
+	}
+
+	atomic<bool>	mStalled;
+	vector<string>	mTexts;
+};
+
+} // anonymous namespace
+
+TEST_CASE( "Log" )
+{
+	auto logger = make_shared<LoggerCapture>();
+	log::manager()->resetLogger( logger );
+
+	SECTION( "async logging writes all records of each thread in order" )
+	{
+		log::manager()->enableAsync( 64 );
+		REQUIRE( log::manager()->isAsyncEnabled() );
+
+		const int numThreads = 4;
+		const int numRecords = 1000;
+		vector<thread> threads;
+		for( int t = 0; t < numThreads; t++ ) {
+			threads.emplace_back( [t] {
+				for( int i = 0; i < numRecords; i++ )
+					CI_LOG_I( t << " " << i );
+			} );
+		}
+		for( auto &thread : threads )
+			thread.join();
+
+		log::manager()->flush();
+		REQUIRE( logger->mTexts.size() == numThreads * numRecords );
+
+		vector<int> nextRecord( numThreads, 0 );
+		bool inOrder = true;
+		for( const auto &text : logger->mTexts ) {
+			int t, i;
+			stringstream( text ) >> t >> i;
+			inOrder = inOrder && ( nextRecord[t]++ == i );
+		}
+		REQUIRE( inOrder );
+
+		log::manager()->disableAsync();
+		REQUIRE_FALSE( log::manager()->isAsyncEnabled() );
+	}
+
+	SECTION( "async logging drops records when the queue is full" )
+	{
+		log::manager()->enableAsync( 4, log::LogManager::QueueFullPolicy::DROP );
+		const uint64_t droppedBefore = log::manager()->getNumDroppedRecords();
+
+		logger->mStalled = true;
+		const int numRecords = 100;
+		for( int i = 0; i < numRecords; i++ )
+			CI_LOG_I( i );
+		logger->mStalled = false;
+
+		log::manager()->flush();
+		const uint64_t numDropped = log::manager()->getNumDroppedRecords() - droppedBefore;
+		REQUIRE( numDropped > 0 );
+		REQUIRE( logger->mTexts.size() + numDropped == numRecords );
+
+		log::manager()->disableAsync();
+	}
+
+	SECTION( "disableAsync() writes pending records" )
+	{
+		log::manager()->enableAsync( 16 );
+
+		logger->mStalled = true;
+		for( int i = 0; i < 10; i++ )
+			CI_LOG_I( i );
+
+		thread unstall( [logger] {
+			this_thread::sleep_for( chrono::milliseconds( 10 ) );
+			logger->mStalled = false;
+		} );
+		log::manager()->disableAsync();
+		unstall.join();
+
+		REQUIRE( logger->mTexts.size() == 10 );
+
+		// synchronous again
+		CI_LOG_I( "sync" );
+		REQUIRE( logger->mTexts.back() == "sync" );
+	}
+
+	SECTION( "concurrent enableAsync() calls don't lose records" )
+	{
+		const int numThreads = 4;
+		const int numRounds = 50;
+		const int numRecords = 20;
+		vector<thread> threads;
+		for( int t = 0; t < numThreads; t++ ) {
+			threads.emplace_back( [] {
+				for( int r = 0; r < numRounds; r++ ) {
+					log::manager()->enableAsync( 8 );
+					for( int i = 0; i < numRecords; i++ )
+						CI_LOG_I( i );
+				}
+			} );
+		}
+		for( auto &thread : threads )
+			thread.join();
+
+		log::manager()->disableAsync();
+		REQUIRE( logger->mTexts.size() == numThreads * numRounds * numRecords );
+	}
+
+	log::manager()->restoreToDefault();
+}
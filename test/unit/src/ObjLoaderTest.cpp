@@ -3,6 +3,9 @@
 #include "cinder/ObjLoader.h"
 #include "cinder/TriMesh.h"
 
+#include <fstream>
+#include <sstream>
+
 using namespace cinder;
 
 TEST_CASE( "ObjLoader" )
@@ -94,4 +97,122 @@ SECTION( "ObjLoader successfully parses faces with line continuations." )
 	REQUIRE( matchesExpectedPositions( mesh->getPositions<3>() ) );
 }
 
+SECTION( "ObjLoader parses DataSources in place." )
+{
+	auto source = DataSourceBuffer::create( Buffer::create( (void*)planeDataNewlinesInFaces.data(), planeDataNewlinesInFaces.size() ) );
+	auto obj = ObjLoader( source );
+	auto mesh = TriMesh::create( obj );
+	REQUIRE( mesh->getNumTriangles() == 2 );
+	REQUIRE( matchesExpectedPositions( mesh->getPositions<3>() ) );
+}
+
+SECTION( "ObjLoader ignores a continuation followed by an empty line." )
+{
+	const auto data = planeData + "\\\n\n";
+	const auto material = std::string( "newmtl plane\n\\\n\nKd 1 0 0\n" );
+	auto obj = ObjLoader( DataSourceBuffer::create( Buffer::create( (void*)data.data(), data.size() ) ),
+						  DataSourceBuffer::create( Buffer::create( (void*)material.data(), material.size() ) ) );
+	auto mesh = TriMesh::create( obj );
+	REQUIRE( mesh->getNumTriangles() == 2 );
+	REQUIRE( matchesExpectedPositions( mesh->getPositions<3>() ) );
+}
+
+SECTION( "ObjLoader keeps faces with less than three vertices." )
+{
+	// the point comes first, so it decides that the group has no tex coords
+	const auto data = std::string( R"obj(
+v 1 1 -1
+v 1 1 1
+v -1.0 1.0 1.0
+v -1.0 1.0 -1.0
+vt 0 0
+f 1
+f 1/1 4/1 3/1 2/1
+f 2/1 3/1
+)obj" );
+
+	auto obj = ObjLoader( IStreamMem::create( data.c_str(), data.size() ) );
+	REQUIRE( obj.getGroups()[0].mFaces.size() == 3 );
+	REQUIRE( obj.getGroups()[0].mFaces[0].mNumVertices == 1 );
+	REQUIRE( obj.getGroups()[0].mFaces[2].mNumVertices == 2 );
+	REQUIRE_FALSE( obj.getGroups()[0].mHasTexCoords );
+
+	// there are no normals, so they are derived from each face's edges, which points and lines don't have
+	auto mesh = TriMesh::create( obj );
+	REQUIRE( mesh->getNumTriangles() == 2 );
+}
+
+SECTION( "ObjLoader parses floats like std::istream." )
+{
+	const auto values = std::vector<std::string> { "0.1", "-1.5e-3", "+2.5E+2", "3.", ".25", "123456.789012", "0.0000001234567", "1e30", "-0", "16777217", "1.00000005960464477539062", "0.123456789012345678901234567" };
+	std::string data;
+	for( const auto &value : values )
+		data += "v " + value + " 0 0\n";
+	for( size_t i = 1; i <= values.size(); ++i )
+		data += "f " + std::to_string( i ) + " " + std::to_string( i ) + " " + std::to_string( i ) + "\n";
+
+	auto obj = ObjLoader( IStreamMem::create( data.c_str(), data.size() ) );
+	auto mesh = TriMesh::create( obj );
+	REQUIRE( mesh->getNumVertices() == values.size() );
+	for( size_t i = 0; i < values.size(); ++i ) {
+		float expected = 0;
+		std::istringstream( values[i] ) >> expected;
+		REQUIRE( mesh->getPositions<3>()[i].x == expected );
+	}
+}
+
+SECTION( "ObjLoader produces the same output for streamed and in place parsing." )
+{
+	// large enough to be split into multiple chunks when parsed in place
+	std::ostringstream ss;
+	const int gridSize = 300;
+	for( int group = 0; group < 3; ++group ) {
+		ss << "g group" << group << "\r\n";
+		for( int y = 0; y < gridSize; ++y ) {
+			for( int x = 0; x < gridSize; ++x ) {
+				ss << "v " << x * 0.1f << " " << ( x * y % 7 ) * 0.01f << " " << y * -0.3f << "\r\n";
+				ss << "vt " << x / float( gridSize ) << " " << y / float( gridSize ) << "\r\n";
+				ss << "vn " << ( x % 3 ) - 1 << " 1 " << ( y % 5 ) * 0.25f << "\r\n";
+			}
+		}
+		const int base = group * gridSize * gridSize;
+		for( int y = 0; y < gridSize - 1; ++y ) {
+			for( int x = 0; x < gridSize - 1; ++x ) {
+				int i = base + y * gridSize + x + 1;
+				ss << "f " << i << "/" << i << "/" << i << " " << i + 1 << "/" << i + 1 << "/" << i + 1 << " \\\r\n "
+					<< i + gridSize + 1 << "/" << i + gridSize + 1 << "/" << i + gridSize + 1 << " " << i + gridSize << "/" << i + gridSize << "/" << i + gridSize << "\r\n";
+			}
+		}
+		if( group > 0 ) // negative indices are relative to the start of the group
+			ss << "f -1/-1/-1 -2/-2/-2 -3/-3/-3\r\n";
+	}
+	const std::string data = ss.str();
+
+	const fs::path path = fs::temp_directory_path() / "ObjLoaderTest.obj";
+	{
+		std::ofstream file( path.string().c_str(), std::ios::binary );
+		file.write( data.data(), data.size() );
+	}
+
+	auto streamed = ObjLoader( loadFile( path )->createStream() );
+	auto mapped = ObjLoader( loadFile( path ) );
+	auto inMemory = ObjLoader( IStreamMem::create( data.data(), data.size() ) );
+	fs::remove( path );
+
+	REQUIRE( streamed.getNumGroups() == 3 );
+	REQUIRE( mapped.getNumGroups() == 3 );
+	REQUIRE( mapped.getGroups()[2].mName == "group2" );
+	REQUIRE( mapped.getGroups()[2].mFaces.back().mVertexIndices == streamed.getGroups()[2].mFaces.back().mVertexIndices );
+
+	auto streamedMesh = TriMesh::create( streamed );
+	for( auto other : { &mapped, &inMemory } ) {
+		auto mesh = TriMesh::create( *other );
+		REQUIRE( mesh->getNumVertices() == streamedMesh->getNumVertices() );
+		REQUIRE( mesh->getIndices() == streamedMesh->getIndices() );
+		REQUIRE( std::equal( mesh->getPositions<3>(), mesh->getPositions<3>() + mesh->getNumVertices(), streamedMesh->getPositions<3>() ) );
+		REQUIRE( mesh->getNormals() == streamedMesh->getNormals() );
+		REQUIRE( std::equal( mesh->getTexCoords0<2>(), mesh->getTexCoords0<2>() + mesh->getNumVertices(), streamedMesh->getTexCoords0<2>() ) );
+	}
+}
+
 } // ObjLoader tests
@@ -0,0 +1,93 @@
+#include "cinder/Stream.h"
+
+#include "catch.hpp"
+
+#include <cstdio>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+const string TEXT = "first line\nsecond\r\nthird\r\rfifth\n\nseventh without ending";
+const vector<string> EXPECTED_LINES = { "first line", "second", "third", "", "fifth", "", "seventh without ending" };
+
+vector<string> readAllLines( IStreamCinder &stream )
+{
+	vector<string> result;
+	string line;
+	while( stream.readLine( line ) )
+		result.push_back( line );
+	return result;
+}
+
+IStreamFileRef createFileStream( const string &contents, int32_t bufferSize )
+{
+	FILE *file = tmpfile();
+	fwrite( contents.data(), 1, contents.size(), file );
+	rewind( file );
+	return IStreamFile::create( file, true, bufferSize );
+}
+
+} // anonymous namespace
+
+TEST_CASE( "Stream" )
+{
+	SECTION( "readLine IStreamMem" )
+	{
+		auto stream = IStreamMem::create( TEXT.data(), TEXT.size() );
+		REQUIRE( readAllLines( *stream ) == EXPECTED_LINES );
+		REQUIRE( stream->isEof() );
+
+		string line = "unchanged";
+		REQUIRE_FALSE( stream->readLine( line ) );
+		REQUIRE( line.empty() );
+	}
+
+	SECTION( "readLine IStreamFile" )
+	{
+		// small buffers put line endings, including the two bytes of "\r\n", across buffer refills
+		for( int32_t bufferSize : { 1, 2, 3, 7, 2048 } ) {
+			auto stream = createFileStream( TEXT, bufferSize );
+			REQUIRE( readAllLines( *stream ) == EXPECTED_LINES );
+		}
+	}
+
+	SECTION( "readLine interleaved with reads" )
+	{
+		auto stream = createFileStream( "header\r\n\x01\x02\x03\x04tail", 4 );
+		REQUIRE( stream->readLine() == "header" );
+		uint32_t value;
+		stream->readLittle( &value );
+		REQUIRE( value == 0x04030201 );
+		REQUIRE( stream->tell() == 12 );
+		REQUIRE( stream->readLine() == "tail" );
+	}
+
+	SECTION( "read null-terminated string" )
+	{
+		const char data[] = "abc\0defghij\0";
+		auto stream = createFileStream( string( data, sizeof( data ) - 1 ), 3 );
+		string s;
+		stream->read( &s );
+		REQUIRE( s == "abc" );
+		stream->read( &s );
+		REQUIRE( s == "defghij" );
+	}
+
+	SECTION( "LineRange" )
+	{
+		vector<string> lines;
+		for( const auto &line : LineRange( TEXT.data(), TEXT.size() ) )
+			lines.push_back( line.str() );
+		REQUIRE( lines == EXPECTED_LINES );
+
+		REQUIRE( LineRange( TEXT.data(), 0 ).begin() == LineRange( TEXT.data(), 0 ).end() );
+
+		const string trailing = "a\n";
+		LineRange range( trailing.data(), trailing.size() );
+		auto it = range.begin();
+		REQUIRE( it->str() == "a" );
+		REQUIRE( ++it == range.end() );
+	}
+}
@@ -0,0 +1,77 @@
+#include "cinder/ThreadPool.h"
+
+#include "catch.hpp"
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+
+using namespace ci;
+using namespace std;
+
+TEST_CASE( "ThreadPool" )
+{
+	SECTION( "parallelFor covers the range once" )
+	{
+		ThreadPool pool( 3 );
+		vector<atomic<int>> counts( 1000 );
+		for( auto &count : counts )
+			count = 0;
+
+		pool.parallelFor( 0, counts.size(), 10, [&]( size_t begin, size_t end ) {
+			for( size_t i = begin; i < end; i++ )
+				++counts[i];
+		} );
+
+		int numWrong = 0;
+		for( const auto &count : counts ) {
+			if( count != 1 )
+				++numWrong;
+		}
+		REQUIRE( numWrong == 0 );
+	}
+
+	SECTION( "exceptions are rethrown on the calling thread" )
+	{
+		ThreadPool pool( 3 );
+		// whichever thread runs the chunks, both the first and the last one
+		for( size_t throwingIndex : { size_t( 0 ), size_t( 999 ) } ) {
+			REQUIRE_THROWS_AS( pool.parallelFor( 0, 1000, 10, [=]( size_t begin, size_t end ) {
+				if( throwingIndex >= begin && throwingIndex < end )
+					throw runtime_error( "chunk" );
+			} ), runtime_error );
+		}
+
+		// every chunk throws
+		REQUIRE_THROWS_AS( pool.parallelFor( 0, 1000, 10, []( size_t, size_t ) { throw runtime_error( "chunk" ); } ), runtime_error );
+
+		// the pool is still usable afterwards
+		atomic<size_t> sum( 0 );
+		pool.parallelFor( 0, 100, 1, [&]( size_t begin, size_t end ) { sum += end - begin; } );
+		REQUIRE( sum == 100 );
+	}
+
+	SECTION( "waiting doesn't run other queued tasks" )
+	{
+		ThreadPool pool( 1 );
+
+		// occupy the only worker, so that everything submitted after this stays queued
+		promise<void> started, release;
+		shared_future<void> released = release.get_future().share();
+		pool.submit( [&, released] {
+			started.set_value();
+			released.wait();
+		} );
+		started.get_future().wait();
+
+		promise<thread::id> otherTaskThread;
+		pool.submit( [&] { otherTaskThread.set_value( this_thread::get_id() ); } );
+
+		atomic<size_t> sum( 0 );
+		pool.parallelFor( 0, 100, 1, [&]( size_t begin, size_t end ) { sum += end - begin; } );
+		REQUIRE( sum == 100 );
+
+		release.set_value();
+		REQUIRE( otherTaskThread.get_future().get() != this_thread::get_id() );
+	}
+}
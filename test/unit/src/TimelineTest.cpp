@@ -0,0 +1,148 @@
+#include "cinder/Timeline.h"
+#include "cinder/Rand.h"
+
+#include "catch.hpp"
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+// Steps a Timeline holding regular tweens and one holding batched tweens in lock-step, requiring equal values after each step.
+struct TweenComparison {
+	TweenComparison( size_t count )
+		: mTimeline( Timeline::create() ), mBatchedTimeline( Timeline::create() ), mAnims( count, Anim<float>( 0.0f ) ), mBatchedAnims( count, Anim<float>( 0.0f ) )
+	{}
+
+	void stepAndCompare( float timestep, int numSteps )
+	{
+		for( int s = 0; s < numSteps; s++ ) {
+			mTimeline->step( timestep );
+			mBatchedTimeline->step( timestep );
+			for( size_t i = 0; i < mAnims.size(); i++ )
+				REQUIRE( mBatchedAnims[i]() == Approx( mAnims[i]() ) );
+		}
+	}
+
+	TimelineRef				mTimeline, mBatchedTimeline;
+	vector<Anim<float>>		mAnims, mBatchedAnims;
+};
+
+float customEase( float t )
+{
+	return t * t * ( 3 - 2 * t );
+}
+
+} // anonymous namespace
+
+TEST_CASE( "Timeline" )
+{
+	SECTION( "findEaseArrayFn" )
+	{
+		REQUIRE( detail::findEaseArrayFn( easeInOutCubic ) != nullptr );
+		REQUIRE( detail::findEaseArrayFn( EaseInOutCubic() ) == detail::findEaseArrayFn( easeInOutCubic ) );
+		REQUIRE( detail::findEaseArrayFn( EaseInOutCubic() ) != detail::findEaseArrayFn( easeInCubic ) );
+		REQUIRE( detail::findEaseArrayFn( customEase ) == nullptr );
+		REQUIRE( detail::findEaseArrayFn( EaseOutBack() ) == nullptr );
+	}
+
+	SECTION( "applyBatched matches apply" )
+	{
+		const vector<EaseFn> easeFns = { easeNone, easeInQuad, EaseOutCubic(), easeInOutQuint, easeInOutSine, EaseOutBack(), customEase };
+
+		Rand rand( 1 );
+		TweenComparison comparison( 500 );
+		for( size_t i = 0; i < comparison.mAnims.size(); i++ ) {
+			float startValue = rand.nextFloat( -10, 10 ), endValue = rand.nextFloat( -10, 10 ), duration = rand.nextFloat( 0.1f, 2 );
+			const EaseFn &easeFn = easeFns[i % easeFns.size()];
+			comparison.mTimeline->apply( &comparison.mAnims[i], startValue, endValue, duration, easeFn );
+			comparison.mBatchedTimeline->applyBatched( &comparison.mBatchedAnims[i], startValue, endValue, duration, easeFn );
+		}
+
+		REQUIRE( comparison.mBatchedTimeline->getNumBatchedTweens() == 500 );
+		comparison.stepAndCompare( 1 / 60.0f, 150 );
+		REQUIRE( comparison.mBatchedTimeline->getNumBatchedTweens() == 0 );
+		REQUIRE( comparison.mBatchedTimeline->empty() );
+		REQUIRE( comparison.mBatchedAnims[0].isComplete() );
+	}
+
+	SECTION( "appendToBatched matches appendTo" )
+	{
+		Rand rand( 2 );
+		TweenComparison comparison( 100 );
+		for( size_t i = 0; i < comparison.mAnims.size(); i++ ) {
+			for( int a = 0; a < 4; a++ ) {
+				float endValue = rand.nextFloat( -10, 10 ), duration = rand.nextFloat( 0, 0.5f );
+				// alternate easings so that consecutive tweens on a target live in different batches
+				EaseFn easeFn = ( a % 2 ) ? EaseFn( easeOutQuad ) : EaseFn( easeInOutCubic );
+				comparison.mTimeline->appendTo( &comparison.mAnims[i], endValue, duration, easeFn );
+				comparison.mBatchedTimeline->appendToBatched( &comparison.mBatchedAnims[i], endValue, duration, easeFn );
+			}
+			REQUIRE( comparison.mBatchedTimeline->findEndTimeOf( comparison.mBatchedAnims[i].ptr() ) == Approx( comparison.mTimeline->findEndTimeOf( comparison.mAnims[i].ptr() ) ) );
+		}
+
+		REQUIRE( comparison.mBatchedTimeline->getDuration() == Approx( comparison.mTimeline->getDuration() ) );
+		comparison.stepAndCompare( 1 / 30.0f, 70 );
+		REQUIRE( comparison.mBatchedTimeline->empty() );
+	}
+
+	SECTION( "applyBatched replaces existing tweens" )
+	{
+		TimelineRef timeline = Timeline::create();
+		Anim<float> anim( 0.0f );
+		timeline->applyBatched( &anim, 10.0f, 1.0f );
+		timeline->step( 0.5f );
+		REQUIRE( anim() == Approx( 5 ) );
+
+		timeline->applyBatched( &anim, 0.0f, 1.0f );
+		REQUIRE( timeline->getNumBatchedTweens() == 1 );
+		timeline->step( 0.5f );
+		REQUIRE( anim() == Approx( 2.5f ) );
+		REQUIRE_FALSE( anim.isComplete() );
+
+		anim.stop();
+		REQUIRE( timeline->empty() );
+	}
+
+	SECTION( "zero duration" )
+	{
+		TimelineRef timeline = Timeline::create();
+		Anim<vec2> anim( vec2( 0 ) );
+		timeline->applyBatched( &anim, vec2( 3, 4 ), 0.0f, easeInQuad );
+		timeline->step( 0 );
+		REQUIRE( anim() == vec2( 3, 4 ) );
+		REQUIRE( timeline->empty() );
+	}
+
+	SECTION( "Anim lifetime" )
+	{
+		TimelineRef timeline = Timeline::create();
+		{
+			Anim<float> anim( 0.0f );
+			timeline->applyBatched( &anim, 1.0f, 1.0f );
+		}
+		REQUIRE( timeline->empty() );
+
+		Anim<float> anim( 0.0f );
+		timeline->applyBatched( &anim, 1.0f, 1.0f );
+		timeline->appendToBatched( &anim, 3.0f, 1.0f );
+		timeline->step( 0.5f );
+
+		Anim<float> copied( anim );
+		REQUIRE( timeline->getNumBatchedTweens() == 4 );
+
+		vector<Anim<float>> moved;
+		moved.push_back( std::move( anim ) );
+		REQUIRE( timeline->getNumBatchedTweens() == 4 );
+
+		timeline->step( 1.0f );
+		REQUIRE( copied() == Approx( 2 ) );
+		REQUIRE( moved[0]() == Approx( 2 ) );
+		REQUIRE( anim() == Approx( 0.5f ) );
+
+		timeline->step( 1.0f );
+		REQUIRE( copied() == Approx( 3 ) );
+		REQUIRE( moved[0]() == Approx( 3 ) );
+		REQUIRE( timeline->empty() );
+	}
+}
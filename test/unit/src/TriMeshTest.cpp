@@ -0,0 +1,181 @@
+#include "cinder/TriMesh.h"
+#include "cinder/ThreadPool.h"
+
+#include "catch.hpp"
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+// A bumpy grid of numCells x numCells quads, with texture coordinates that are skewed so that the tangents vary as well.
+TriMesh makeBumpyGrid( uint32_t numCells )
+{
+	TriMesh result( TriMesh::Format().positions().normals().texCoords() );
+	for( uint32_t y = 0; y <= numCells; ++y ) {
+		for( uint32_t x = 0; x <= numCells; ++x ) {
+			float height = 0.1f * sin( x * 0.37f ) * cos( y * 0.23f ) + 0.05f * sin( ( x + y ) * 1.3f );
+			result.appendPosition( vec3( x, height, y ) );
+			result.appendTexCoord0( vec2( x + 0.3f * sin( y * 0.5f ), y + 0.2f * x ) / float( numCells ) );
+		}
+	}
+
+	for( uint32_t y = 0; y < numCells; ++y ) {
+		for( uint32_t x = 0; x < numCells; ++x ) {
+			uint32_t corner = y * ( numCells + 1 ) + x;
+			result.appendTriangle( corner, corner + numCells + 1, corner + 1 );
+			result.appendTriangle( corner + 1, corner + numCells + 1, corner + numCells + 2 );
+		}
+	}
+
+	return result;
+}
+
+// Serial versions of the parallel loops in TriMesh::recalculateNormals() and geom::calculateTangents(), for a mesh without degenerate triangles.
+vector<vec3> calcNormalsSerial( const TriMesh &mesh, bool weighted )
+{
+	vector<vec3> result( mesh.getNumVertices(), vec3( 0 ) );
+	const auto &indices = mesh.getIndices();
+	for( size_t i = 0; i < mesh.getNumTriangles(); ++i ) {
+		vec3 a, b, c;
+		mesh.getTriangleVertices( i, &a, &b, &c );
+		vec3 normal = cross( b - a, c - a );
+		if( ! weighted )
+			normal = normalize( normal );
+
+		for( size_t k = 0; k < 3; ++k )
+			result[indices[i * 3 + k]] += normal;
+	}
+
+	for( auto &normal : result )
+		normal = normalize( normal );
+
+	return result;
+}
+
+vector<vec3> calcTangentsSerial( const TriMesh &mesh )
+{
+	const vec3 *positions = mesh.getPositions<3>();
+	const vec2 *texCoords = mesh.getTexCoords0<2>();
+	const auto &indices = mesh.getIndices();
+
+	vector<vec3> result( mesh.getNumVertices(), vec3( 0 ) );
+	for( size_t i = 0; i < mesh.getNumTriangles(); ++i ) {
+		uint32_t index0 = indices[i * 3], index1 = indices[i * 3 + 1], index2 = indices[i * 3 + 2];
+		vec3 e1 = positions[index1] - positions[index0];
+		vec3 e2 = positions[index2] - positions[index0];
+		vec2 w1 = texCoords[index1] - texCoords[index0];
+		vec2 w2 = texCoords[index2] - texCoords[index0];
+
+		float r = w1.x * w2.y - w2.x * w1.y;
+		if( r != 0 )
+			r = 1 / r;
+
+		vec3 tangent = ( e1 * w2.y - e2 * w1.y ) * r;
+		result[index0] += tangent;
+		result[index1] += tangent;
+		result[index2] += tangent;
+	}
+
+	for( size_t i = 0; i < result.size(); ++i ) {
+		const vec3 &normal = mesh.getNormals()[i];
+		result[i] = normalize( result[i] - normal * dot( normal, result[i] ) );
+	}
+
+	return result;
+}
+
+float maxDistance( const vector<vec3> &a, const vector<vec3> &b )
+{
+	float result = 0;
+	for( size_t i = 0; i < a.size(); ++i )
+		result = std::max( result, distance( a[i], b[i] ) );
+
+	return result;
+}
+
+} // anonymous namespace
+
+TEST_CASE( "TriMesh" )
+{
+	SECTION( "smooth recalculateNormals() averages across seams" )
+	{
+		// the Icosphere's texture seam duplicates positions, which smoothing should treat as one vertex
+		TriMesh mesh( geom::Icosphere().subdivisions( 5 ), TriMesh::Format().positions().normals() );
+		REQUIRE( mesh.recalculateNormals( true ) );
+
+		float minCosine = 1;
+		for( size_t i = 0; i < mesh.getNumVertices(); ++i ) {
+			const vec3 &position = mesh.getPositions<3>()[i];
+			minCosine = std::min( minCosine, dot( mesh.getNormals()[i], normalize( position ) ) );
+		}
+		REQUIRE( minCosine > 0.999f );
+	}
+
+	SECTION( "weld() merges vertices at the same position" )
+	{
+		// geom::Cube has four vertices per face, so each corner is shared by three faces
+		TriMesh positionsOnly( geom::Cube(), TriMesh::Format().positions() );
+		const size_t numTriangles = positionsOnly.getNumTriangles();
+		vector<vec3> expected( numTriangles * 3 );
+		for( size_t i = 0; i < numTriangles; ++i )
+			positionsOnly.getTriangleVertices( i, &expected[i * 3], &expected[i * 3 + 1], &expected[i * 3 + 2] );
+
+		REQUIRE( positionsOnly.weld() == 16 );
+		REQUIRE( positionsOnly.getNumVertices() == 8 );
+		REQUIRE( positionsOnly.getNumTriangles() == numTriangles );
+		for( size_t i = 0; i < numTriangles; ++i ) {
+			vec3 a, b, c;
+			positionsOnly.getTriangleVertices( i, &a, &b, &c );
+			REQUIRE( a == expected[i * 3] );
+			REQUIRE( b == expected[i * 3 + 1] );
+			REQUIRE( c == expected[i * 3 + 2] );
+		}
+
+		// vertices whose normals differ are kept apart
+		TriMesh withNormals( geom::Cube(), TriMesh::Format().positions().normals() );
+		REQUIRE( withNormals.weld() == 0 );
+		REQUIRE( withNormals.getNumVertices() == 24 );
+
+		// positions further apart than epsilon aren't merged
+		TriMesh scaled( geom::Cube().size( vec3( 1e-3f ) ), TriMesh::Format().positions() );
+		REQUIRE( scaled.weld( 1e-4f ) == 16 );
+		TriMesh merged( geom::Cube().size( vec3( 1e-3f ) ), TriMesh::Format().positions() );
+		REQUIRE( merged.weld( 1e-2f ) == 23 );
+	}
+
+	SECTION( "recalculateTangents() is orthogonal to the normals" )
+	{
+		TriMesh mesh( geom::Sphere().subdivisions( 64 ), TriMesh::Format().positions().normals().texCoords() );
+		REQUIRE( mesh.recalculateTangents() );
+		REQUIRE( mesh.getTangents().size() == mesh.getNumVertices() );
+
+		for( size_t i = 0; i < mesh.getNumVertices(); ++i ) {
+			const vec3 &tangent = mesh.getTangents()[i];
+			if( length2( tangent ) == 0 )
+				continue; // the poles have no defined tangent
+
+			REQUIRE( fabs( length( tangent ) - 1 ) < 1e-4f );
+			REQUIRE( fabs( dot( tangent, mesh.getNormals()[i] ) ) < 1e-4f );
+		}
+	}
+
+	SECTION( "large meshes split into chunks match a serial reference" )
+	{
+		// 80000 triangles and 40401 vertices, enough for up to four triangle chunks and several vertex chunks. The ThreadPool
+		// always has at least one worker, so there are at least two.
+		TriMesh mesh = makeBumpyGrid( 200 );
+		REQUIRE( mesh.getNumTriangles() == 80000 );
+		REQUIRE( detail::calcNumTriangleChunks( mesh.getNumTriangles() ) == std::min<size_t>( 4, ThreadPool::get()->getNumThreads() + 1 ) );
+
+		for( bool weighted : { false, true } ) {
+			REQUIRE( mesh.recalculateNormals( false, weighted ) );
+			REQUIRE( mesh.getNormals().size() == mesh.getNumVertices() );
+			REQUIRE( maxDistance( mesh.getNormals(), calcNormalsSerial( mesh, weighted ) ) < 1e-5f );
+		}
+
+		REQUIRE( mesh.recalculateTangents() );
+		REQUIRE( mesh.getTangents().size() == mesh.getNumVertices() );
+		REQUIRE( maxDistance( mesh.getTangents(), calcTangentsSerial( mesh ) ) < 1e-4f );
+	}
+}
@@ -5,6 +5,7 @@
 #include "cinder/ConcurrentCircularBuffer.h"
 #include "cinder/app/App.h"
 
+#include <atomic>
 #include <iostream>
 
 using namespace std;
@@ -53,6 +54,72 @@ TEST_CASE( "Utilities" )
 		REQUIRE( ccb.isNotFull() );
 	}
 
+	SECTION( "LockFreeConcurrentCircularBuffer" )
+	{
+		LockFreeConcurrentCircularBuffer<int> ccb( 10 );
+		REQUIRE( ccb.getCapacity() == 10 );
+		// go around the ring a few times, so that slots are reused
+		for( int lap = 0; lap < 3; ++lap ) {
+			for( int i = 0; i < 10; ++i )
+				ccb.pushFront( i );
+
+			REQUIRE( ccb.getSize() == 10 );
+			REQUIRE( ccb.isNotEmpty() );
+			REQUIRE( ! ccb.isNotFull() );
+			int temp;
+			REQUIRE( ! ccb.tryPushFront( 11 ) );
+			for( int i = 0; i < 10; ++i ) {
+				ccb.popBack( &temp );
+				REQUIRE( temp == i );
+			}
+			REQUIRE( ! ccb.tryPopBack( &temp ) );
+			REQUIRE( ! ccb.isNotEmpty() );
+			REQUIRE( ccb.isNotFull() );
+		}
+	}
+
+	SECTION( "LockFreeConcurrentCircularBuffer with several producers and consumers" )
+	{
+		const int numThreads = 4;
+		const int numItemsPerProducer = 10000;
+
+		// small enough that both producers and consumers end up waiting
+		LockFreeConcurrentCircularBuffer<int> ccb( 7 );
+		std::atomic<int64_t> sum( 0 );
+		vector<thread> threads;
+		for( int t = 0; t < numThreads; ++t ) {
+			threads.emplace_back( [&, t] {
+				for( int i = 0; i < numItemsPerProducer; ++i )
+					ccb.pushFront( t * numItemsPerProducer + i + 1 );
+			} );
+			threads.emplace_back( [&] {
+				for( int i = 0; i < numItemsPerProducer; ++i ) {
+					int item;
+					ccb.popBack( &item );
+					sum += item;
+				}
+			} );
+		}
+		for( auto &thread : threads )
+			thread.join();
+
+		const int64_t numItems = numThreads * numItemsPerProducer;
+		REQUIRE( sum == numItems * ( numItems + 1 ) / 2 );
+		REQUIRE( ! ccb.isNotEmpty() );
+
+		// cancel() releases a consumer waiting on an empty buffer
+		thread consumer( [&] {
+			int item;
+			ccb.popBack( &item );
+		} );
+		ccb.cancel();
+		consumer.join();
+
+		// and once canceled, pushFront() returns without pushing
+		ccb.pushFront( 1 );
+		REQUIRE( ! ccb.isNotEmpty() );
+	}
+
 	SECTION( "swapEndian" )
 	{
 		// 8-bit; should be no-op
@@ -0,0 +1,200 @@
+#include "catch.hpp"
+
+#include "cinder/audio/ContextOffline.h"
+#include "cinder/audio/FilterNode.h"
+#include "cinder/audio/GainNode.h"
+#include "cinder/audio/GenNode.h"
+#include "cinder/audio/dsp/Biquad.h"
+#include "cinder/audio/dsp/BiquadBank.h"
+#include "cinder/Rand.h"
+
+#include <cmath>
+
+using namespace std;
+using namespace ci;
+using namespace ci::audio;
+
+namespace {
+
+const size_t NUM_CHANNELS = 11;	// one full group of lanes and one partial
+const size_t NUM_SECTIONS = 3;
+// process() sizes, including ones that span more than one internal chunk
+const size_t BLOCK_SIZES[] = { 64, 300, 17, 512, 1 };
+
+// Single precision transposed direct form II against double precision direct form I.
+const float TOLERANCE = 0.0001f;
+
+// Gives each channel and section a different response.
+void setParams( dsp::Biquad *biquad, size_t channel, size_t section )
+{
+	const double freq = 0.01 + 0.04 * channel + 0.1 * section;
+	switch( section % 3 ) {
+		case 0: biquad->setLowpassParams( freq, 2.0 ); break;
+		case 1: biquad->setPeakingParams( freq, 0.7, 6.0 ); break;
+		default: biquad->setHighpassParams( freq, 0.0 ); break;
+	}
+}
+
+audio::Buffer makeNoise( size_t numFrames, size_t numChannels, uint32_t seed )
+{
+	Rand rand( seed );
+	audio::Buffer result( numFrames, numChannels );
+	for( size_t i = 0; i < result.getSize(); i++ )
+		result[i] = rand.nextFloat( -0.5f, 0.5f );
+
+	return result;
+}
+
+// Processes noise block by block through bank, returning every block concatenated per channel.
+audio::Buffer processBlocks( dsp::BiquadBank *bank, const audio::Buffer &input )
+{
+	audio::Buffer result( input.getNumFrames(), input.getNumChannels() );
+	size_t offset = 0;
+	for( size_t blockSize : BLOCK_SIZES ) {
+		audio::Buffer block( blockSize, input.getNumChannels() );
+		for( size_t ch = 0; ch < input.getNumChannels(); ch++ )
+			copy( input.getChannel( ch ) + offset, input.getChannel( ch ) + offset + blockSize, block.getChannel( ch ) );
+
+		bank->process( &block );
+
+		for( size_t ch = 0; ch < input.getNumChannels(); ch++ )
+			copy( block.getChannel( ch ), block.getChannel( ch ) + blockSize, result.getChannel( ch ) + offset );
+		offset += blockSize;
+	}
+
+	return result;
+}
+
+size_t getTotalBlockFrames()
+{
+	size_t result = 0;
+	for( size_t blockSize : BLOCK_SIZES )
+		result += blockSize;
+
+	return result;
+}
+
+} // anonymous namespace
+
+TEST_CASE( "audio/BiquadBank" )
+{
+
+SECTION( "matches cascaded Biquad's" )
+{
+	const auto input = makeNoise( getTotalBlockFrames(), NUM_CHANNELS, 1 );
+
+	// reference: each channel through NUM_SECTIONS scalar Biquad's in series
+	audio::Buffer expected( input );
+	dsp::BiquadBank bank( NUM_CHANNELS, NUM_SECTIONS );
+	for( size_t ch = 0; ch < NUM_CHANNELS; ch++ ) {
+		for( size_t s = 0; s < NUM_SECTIONS; s++ ) {
+			dsp::Biquad biquad;
+			setParams( &biquad, ch, s );
+			biquad.process( expected.getChannel( ch ), expected.getChannel( ch ), expected.getNumFrames() );
+			bank.setCoefficients( ch, s, dsp::BiquadBank::Coefficients( biquad ) );
+		}
+	}
+
+	const auto defaultLevel = dsp::getSimdLevel();
+	REQUIRE( dsp::setSimdLevel( dsp::SimdLevel::SCALAR ) );
+	const auto scalarResult = processBlocks( &bank, input );
+	for( size_t i = 0; i < expected.getSize(); i++ )
+		REQUIRE( fabs( scalarResult[i] - expected[i] ) < TOLERANCE );
+
+	// every SIMD level computes exactly what the scalar kernel does
+	for( auto level : { dsp::SimdLevel::SSE2, dsp::SimdLevel::AVX2, dsp::SimdLevel::NEON } ) {
+		if( ! dsp::setSimdLevel( level ) )
+			continue;
+
+		bank.reset();
+		const auto result = processBlocks( &bank, input );
+		for( size_t i = 0; i < expected.getSize(); i++ )
+			REQUIRE( result[i] == scalarResult[i] );
+	}
+	dsp::setSimdLevel( defaultLevel );
+}
+
+SECTION( "coefficient interpolation" )
+{
+	dsp::BiquadBank bank( 1, 1 );
+	bank.setInterpolationEnabled();
+
+	// the first coefficients are applied immediately
+	bank.setCoefficients( 0, dsp::BiquadBank::Coefficients( 2, 0, 0, 0, 0 ) );
+	audio::Buffer block( 100, 1 );
+	block.getChannel( 0 )[0] = 1;
+	bank.process( &block );
+	REQUIRE( block[0] == 2 );
+
+	// a change in gain ramps linearly across the next block, then holds
+	bank.setCoefficients( 0, dsp::BiquadBank::Coefficients( 1, 0, 0, 0, 0 ) );
+	for( size_t i = 0; i < block.getSize(); i++ )
+		block[i] = 1;
+	bank.process( &block );
+	for( size_t i = 0; i < block.getSize(); i++ )
+		REQUIRE( block[i] == Approx( 2.0f - i / 100.0f ) );
+
+	for( size_t i = 0; i < block.getSize(); i++ )
+		block[i] = 1;
+	bank.process( &block );
+	for( size_t i = 0; i < block.getSize(); i++ )
+		REQUIRE( block[i] == 1 );
+
+	// without interpolation, changes apply at the start of the block
+	bank.setInterpolationEnabled( false );
+	bank.setCoefficients( 0, dsp::BiquadBank::Coefficients( 0.5f, 0, 0, 0, 0 ) );
+	bank.process( &block );
+	REQUIRE( block[0] == 0.5f );
+}
+
+SECTION( "FilterBiquadNode cascade mode" )
+{
+	// renders a three channel filter once with a Biquad per channel and once through a single section cascade
+	auto render = []( bool cascade ) {
+		auto ctx = make_shared<ContextOffline>( 48000, 128, 2 );
+		auto gen = ctx->makeNode( new GenNoiseNode );
+		auto filter = ctx->makeNode( new FilterLowPassNode( Node::Format().channels( 3 ) ) );
+		auto gain = ctx->makeNode( new GainNode( 0.2f ) );
+		filter->setCutoffFreq( 1500 );
+		filter->setResonance( 3 );
+		if( cascade )
+			filter->enableCascade();
+
+		gen >> filter >> gain >> ctx->getOutput();
+		gen->enable();
+		ctx->getOutputOffline()->setRecordingEnabled();
+		ctx->enable();
+		ctx->render( 2048 );
+		REQUIRE( filter->isCascadeEnabled() == cascade );
+		return ctx->getOutputOffline()->getRecordedCopy();
+	};
+
+	Rand::randSeed( 2 );
+	auto expected = render( false );
+	Rand::randSeed( 2 );
+	auto cascaded = render( true );
+
+	REQUIRE( cascaded->getSize() == expected->getSize() );
+	for( size_t i = 0; i < expected->getSize(); i++ )
+		REQUIRE( fabs( ( *cascaded )[i] - ( *expected )[i] ) < TOLERANCE );
+
+	// while the Context is enabled, changes are posted to the next block
+	auto ctx = make_shared<ContextOffline>( 48000, 128, 2 );
+	auto gen = ctx->makeNode( new GenNoiseNode );
+	auto filter = ctx->makeNode( new FilterLowPassNode );
+	gen >> filter >> ctx->getOutput();
+	gen->enable();
+	ctx->enable();
+	ctx->render( 256 );
+
+	filter->enableCascade( 2 );
+	REQUIRE( ! filter->isCascadeEnabled() );
+	ctx->render( 256 );
+	REQUIRE( filter->getNumCascadeSections() == 2 );
+
+	filter->disableCascade();
+	ctx->render( 256 );
+	REQUIRE( ! filter->isCascadeEnabled() );
+}
+
+}
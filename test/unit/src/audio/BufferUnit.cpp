@@ -3,7 +3,6 @@
 #include "cinder/audio/dsp/Converter.h"
 #include "utils.h"
 
-using namespace ci;
 using namespace ci::audio;
 
 TEST_CASE( "audio/Buffer" )
@@ -0,0 +1,91 @@
+#include "catch.hpp"
+
+#include "cinder/audio/CommandQueue.h"
+
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace ci;
+using namespace ci::audio;
+
+TEST_CASE( "audio/CommandQueue" )
+{
+
+SECTION( "commands are called in order" )
+{
+	CommandQueue commands;
+	REQUIRE( commands.isEmpty() );
+	REQUIRE( commands.process() == 0 );
+
+	vector<int> called;
+	for( int i = 0; i < 10; i++ )
+		commands.post( [&called, i] { called.push_back( i ); } );
+
+	REQUIRE_FALSE( commands.isEmpty() );
+	REQUIRE( commands.process() == 10 );
+	REQUIRE( commands.isEmpty() );
+	REQUIRE( commands.process() == 0 );
+
+	for( int i = 0; i < 10; i++ )
+		REQUIRE( called[i] == i );
+}
+
+SECTION( "called commands are destroyed by post()" )
+{
+	auto captured = make_shared<int>( 0 );
+	{
+		CommandQueue commands;
+		commands.post( [captured] { ( *captured )++; } );
+		commands.process();
+		REQUIRE( *captured == 1 );
+		REQUIRE( captured.use_count() == 2 );
+
+		commands.post( [] {} );
+		REQUIRE( captured.use_count() == 1 );
+
+		// commands that were never called are destroyed with the queue
+		commands.post( [captured] { ( *captured )++; } );
+	}
+	REQUIRE( *captured == 1 );
+	REQUIRE( captured.use_count() == 1 );
+}
+
+SECTION( "threaded stress" )
+{
+	const size_t kNumProducers = 4;
+	const size_t kNumCommandsPerProducer = 20000;
+
+	CommandQueue commands;
+	vector<size_t> lastCalled( kNumProducers, 0 );
+	size_t numCalled = 0;
+	bool inOrder = true;
+
+	vector<thread> producers;
+	for( size_t p = 0; p < kNumProducers; p++ ) {
+		producers.emplace_back( [&, p] {
+			for( size_t i = 1; i <= kNumCommandsPerProducer; i++ ) {
+				commands.post( [&, p, i] {
+					inOrder = inOrder && lastCalled[p] + 1 == i;
+					lastCalled[p] = i;
+					numCalled++;
+				} );
+			}
+		} );
+	}
+
+	const size_t kTotalCommands = kNumProducers * kNumCommandsPerProducer;
+	size_t numProcessed = 0;
+	while( numProcessed < kTotalCommands )
+		numProcessed += commands.process();
+
+	for( auto &producer : producers )
+		producer.join();
+
+	REQUIRE( numProcessed == kTotalCommands );
+	REQUIRE( numCalled == kTotalCommands );
+	REQUIRE( inOrder );
+	REQUIRE( commands.isEmpty() );
+}
+
+} // audio/CommandQueue
@@ -0,0 +1,245 @@
+#include "catch.hpp"
+#include "utils.h"
+
+#include "cinder/audio/ContextOffline.h"
+#include "cinder/audio/FilterNode.h"
+#include "cinder/audio/GenNode.h"
+#include "cinder/audio/GainNode.h"
+#include "cinder/audio/MonitorNode.h"
+#include "cinder/audio/PanNode.h"
+
+#include <cmath>
+#include <cstring>
+
+using namespace std;
+using namespace ci;
+using namespace ci::audio;
+
+TEST_CASE( "audio/ContextOffline" )
+{
+
+SECTION( "render frames" )
+{
+	auto ctx = make_shared<ContextOffline>( 48000, 256, 2 );
+	auto gen = ctx->makeNode( new GenSineNode( 440 ) );
+	gen >> ctx->getOutput();
+	gen->enable();
+	ctx->getOutputOffline()->setRecordingEnabled();
+
+	// nothing is rendered until the context is enabled
+	REQUIRE( ctx->render( 1000 ) == 0 );
+
+	ctx->enable();
+	REQUIRE( ctx->render( 1000 ) == 1000 );
+	REQUIRE( ctx->getOutputOffline()->getNumRecordedFrames() == 1000 );
+	REQUIRE( ctx->getNumRenderedFrames() == 1000 );
+
+	REQUIRE( ctx->renderSeconds( 1.0 ) == 48000 );
+	auto recorded = ctx->getOutputOffline()->getRecordedCopy();
+	REQUIRE( recorded->getNumFrames() == 49000 );
+	REQUIRE( recorded->getNumChannels() == 2 );
+}
+
+SECTION( "partial blocks carry over to the next render" )
+{
+	auto renderSine = []( const vector<size_t> &frameCounts ) {
+		auto ctx = make_shared<ContextOffline>( 48000, 256, 1 );
+		auto gen = ctx->makeNode( new GenSineNode( 440 ) );
+		gen >> ctx->getOutput();
+		gen->enable();
+		ctx->getOutputOffline()->setRecordingEnabled();
+		ctx->enable();
+		for( size_t numFrames : frameCounts )
+			REQUIRE( ctx->render( numFrames ) == numFrames );
+
+		return ctx->getOutputOffline()->getRecordedCopy();
+	};
+
+	// 1000 frames leave 24 of the fourth block over, which is more than the next render() asks for
+	auto pieces = renderSine( { 1000, 10, 1, 300, 0, 689 } );
+	auto whole = renderSine( { 2000 } );
+	REQUIRE( pieces->getNumFrames() == 2000 );
+	REQUIRE( maxError( *pieces, *whole ) == 0.0f );
+}
+
+SECTION( "rendering is deterministic" )
+{
+	auto renderSine = [] {
+		auto ctx = make_shared<ContextOffline>( 44100, 128, 1 );
+		auto gen = ctx->makeNode( new GenSineNode( 1000 ) );
+		auto gain = ctx->makeNode( new GainNode( 0.5f ) );
+		gen >> gain >> ctx->getOutput();
+		gen->enable();
+		ctx->getOutputOffline()->setRecordingEnabled();
+		ctx->enable();
+		ctx->render( 44100 );
+		return ctx->getOutputOffline()->getRecordedCopy();
+	};
+
+	auto a = renderSine();
+	auto b = renderSine();
+	REQUIRE( maxError( *a, *b ) == 0.0f );
+}
+
+SECTION( "scheduled events use virtual time" )
+{
+	auto ctx = make_shared<ContextOffline>( 48000, 512, 2 );
+	auto gen = ctx->makeNode( new GenSineNode( 440 ) );
+	gen >> ctx->getOutput();
+
+	double enabledSeconds = -1;
+	ctx->scheduleEvent( 2.0, gen, true, [&] {
+		enabledSeconds = ctx->getNumProcessedSeconds();
+	} );
+
+	ctx->enable();
+	ctx->renderSeconds( 1.5 );
+	REQUIRE( enabledSeconds < 0 );
+
+	ctx->renderSeconds( 1.0 );
+	REQUIRE( enabledSeconds > 1.9 );
+	REQUIRE( enabledSeconds <= 2.0 );
+}
+
+SECTION( "worker threads render identical output" )
+{
+	// Every summing Node has two inputs. Floating point addition is commutative, so the output doesn't depend on the
+	// order that inputs are stored in, which differs between the two graphs.
+	auto renderTree = []( size_t numWorkerThreads ) {
+		auto ctx = make_shared<ContextOffline>( 44100, 256, 2 );
+		ctx->setNumWorkerThreads( numWorkerThreads );
+
+		vector<NodeRef> generators, mixes;
+		for( int c = 0; c < 16; c++ ) {
+			float freq = 100.0f + 50.0f * c;
+			NodeRef gen = ( c % 2 ) ? NodeRef( ctx->makeNode( new GenTriangleNode( freq ) ) ) : NodeRef( ctx->makeNode( new GenSineNode( freq ) ) );
+			auto lowPass = ctx->makeNode( new FilterLowPassNode );
+			lowPass->setCutoffFreq( 1000.0f + 200.0f * c );
+			auto pan = ctx->makeNode( new Pan2dNode );
+			pan->setPos( c / 15.0f );
+
+			gen >> lowPass >> pan;
+			gen->enable();
+			generators.push_back( gen );
+			mixes.push_back( pan );
+		}
+
+		// sum pairs until one is left, which gives the schedule several levels
+		while( mixes.size() > 1 ) {
+			vector<NodeRef> nextMixes;
+			for( size_t i = 0; i < mixes.size(); i += 2 ) {
+				auto mix = ctx->makeNode( new GainNode( 0.7f ) );
+				mixes[i] >> mix;
+				mixes[i + 1] >> mix;
+				nextMixes.push_back( mix );
+			}
+			mixes.swap( nextMixes );
+		}
+		mixes[0] >> ctx->getOutput();
+
+		// auto-pulled branch
+		auto monitor = ctx->makeNode( new MonitorNode );
+		generators[0] >> monitor;
+
+		ctx->getOutputOffline()->setRecordingEnabled();
+		ctx->enable();
+		ctx->render( 10000 );
+
+		// changing connections between renders rebuilds the schedule
+		NodeRef lowPass = generators[5]->getOutputs()[0];
+		generators[5]->disconnectAll();
+		auto replacement = ctx->makeNode( new GenSineNode( 3000 ) );
+		replacement >> lowPass;
+		replacement->enable();
+		ctx->render( 10000 );
+
+		return ctx->getOutputOffline()->getRecordedCopy();
+	};
+
+	auto serial = renderTree( 0 );
+	auto parallel = renderTree( 3 );
+	REQUIRE( parallel->getSize() == serial->getSize() );
+	REQUIRE( memcmp( parallel->getData(), serial->getData(), serial->getSize() * sizeof( float ) ) == 0 );
+}
+
+SECTION( "changes made between renders apply at the next block" )
+{
+	auto ctx = make_shared<ContextOffline>( 48000, 256, 1 );
+	auto gen = ctx->makeNode( new GenSineNode( 440 ) );
+	auto gain = ctx->makeNode( new GainNode( 1.0f ) );
+	gen >> gain >> ctx->getOutput();
+	gen->enable();
+	ctx->getOutputOffline()->setRecordingEnabled();
+	ctx->enable();
+	ctx->render( 256 );
+
+	// render() only treats this thread as the audio thread while it runs, so the change is posted rather than applied immediately
+	REQUIRE( ! ctx->isAudioThread() );
+	gain->setValue( 0 );
+	REQUIRE( gain->getValue() == 0 );
+	ctx->render( 256 );
+
+	auto recorded = ctx->getOutputOffline()->getRecordedCopy();
+	float firstBlockPeak = 0;
+	float secondBlockPeak = 0;
+	for( size_t i = 0; i < 256; i++ ) {
+		firstBlockPeak = max( firstBlockPeak, fabsf( recorded->getData()[i] ) );
+		secondBlockPeak = max( secondBlockPeak, fabsf( recorded->getData()[256 + i] ) );
+	}
+	REQUIRE( firstBlockPeak > 0.1f );
+	REQUIRE( secondBlockPeak == 0 );
+
+	auto param = gain->getParam();
+	param->applyRamp( 1.0f, 1.0 );
+	param->appendRamp( 0.5f, 0.5 );
+	REQUIRE( param->findEndTimeAndValue().second == 0.5f );
+	REQUIRE( param->findDuration() == Approx( 1.5 ) );
+	REQUIRE( param->getNumEvents() == 2 );
+
+	ctx->renderSeconds( 2.0 );
+	REQUIRE( param->getNumEvents() == 0 );
+	REQUIRE( param->getValue() == 0.5f );
+}
+
+SECTION( "canceled events and called commands don't keep Nodes alive" )
+{
+	auto ctx = make_shared<ContextOffline>( 48000, 256, 1 );
+	auto gen = ctx->makeNode( new GenSineNode( 440 ) );
+	gen >> ctx->getOutput();
+	ctx->enable();
+	ctx->render( 256 );
+	const long useCount = gen.use_count();
+
+	bool fired = false;
+	ctx->scheduleEvent( 1.0, gen, true, [&] { fired = true; } );
+	gen->setPhase( 0 );
+	REQUIRE( gen.use_count() > useCount );
+
+	// once the commands have been called, only the scheduled event holds on to the Node
+	ctx->render( 256 );
+	REQUIRE( gen.use_count() == useCount + 1 );
+
+	// the event is canceled before disable() returns, rather than at the next block
+	gen->disable();
+	REQUIRE( gen.use_count() == useCount );
+
+	ctx->renderSeconds( 2.0 );
+	REQUIRE( ! fired );
+}
+
+SECTION( "render() only treats the calling thread as the audio thread while it runs" )
+{
+	auto ctx = make_shared<ContextOffline>( 48000, 256, 1 );
+	auto gen = ctx->makeNode( new GenSineNode( 440 ) );
+	gen >> ctx->getOutput();
+	gen->enable();
+	ctx->enable();
+
+	bool wasAudioThread = false;
+	ctx->scheduleEvent( 0.001, gen, true, [&] { wasAudioThread = ctx->isAudioThread(); } );
+	ctx->render( 1024 );
+	REQUIRE( wasAudioThread );
+	REQUIRE( ! ctx->isAudioThread() );
+}
+
+} // "audio/ContextOffline"
@@ -0,0 +1,173 @@
+#include "catch.hpp"
+#include "utils.h"
+
+#include "cinder/audio/dsp/ConverterPolyphase.h"
+#include "cinder/audio/dsp/Dsp.h"
+#include "cinder/audio/Source.h"
+#include "cinder/CinderMath.h"
+
+#include <cmath>
+
+using namespace ci::audio;
+using namespace std;
+
+namespace {
+
+const dsp::ConverterType POLYPHASE_TYPES[] = { dsp::ConverterType::POLYPHASE_FAST, dsp::ConverterType::POLYPHASE_MEDIUM, dsp::ConverterType::POLYPHASE_HIGH };
+
+BufferRef makeSine( size_t numFrames, size_t numChannels, double freq, double sampleRate )
+{
+	auto result = make_shared<Buffer>( numFrames, numChannels );
+	for( size_t ch = 0; ch < numChannels; ch++ ) {
+		for( size_t i = 0; i < numFrames; i++ )
+			result->getChannel( ch )[i] = (float)sin( 2 * M_PI * freq * i / sampleRate );
+	}
+
+	return result;
+}
+
+// Converts all of source in blocks whose sizes cycle through blockSizes, then flushes the converter. Returns everything that was written.
+Buffer convertInBlocks( dsp::Converter *converter, const Buffer &source, const vector<size_t> &blockSizes )
+{
+	Buffer result( 0, converter->getDestNumChannels() );
+	Buffer destBuffer( converter->getDestMaxFramesPerBlock(), converter->getDestNumChannels() );
+	auto append = [&]( size_t numFrames ) {
+		Buffer appended( result.getNumFrames() + numFrames, result.getNumChannels() );
+		appended.copyOffset( result, result.getNumFrames(), 0, 0 );
+		appended.copyOffset( destBuffer, numFrames, result.getNumFrames(), 0 );
+		result = move( appended );
+	};
+
+	size_t pos = 0;
+	for( size_t block = 0; pos < source.getNumFrames(); block++ ) {
+		size_t numFrames = min( blockSizes[block % blockSizes.size()], source.getNumFrames() - pos );
+		Buffer sourceBlock( numFrames, source.getNumChannels() );
+		sourceBlock.copyOffset( source, numFrames, 0, pos );
+
+		auto count = converter->convert( &sourceBlock, &destBuffer );
+		REQUIRE( count.first == numFrames );
+		append( count.second );
+		pos += numFrames;
+	}
+
+	while( size_t numFlushed = converter->flush( &destBuffer ) )
+		append( numFlushed );
+
+	return result;
+}
+
+// Returns the largest difference between a and b, ignoring \a margin frames at either end.
+float maxErrorInside( const Buffer &a, const Buffer &b, size_t margin )
+{
+	float result = 0;
+	for( size_t ch = 0; ch < a.getNumChannels(); ch++ ) {
+		for( size_t i = margin; i + margin < a.getNumFrames(); i++ )
+			result = max( result, fabs( a.getChannel( ch )[i] - b.getChannel( ch )[i] ) );
+	}
+
+	return result;
+}
+
+} // anonymous namespace
+
+TEST_CASE( "audio/Converter" )
+{
+
+SECTION( "polyphase output doesn't depend on block size" )
+{
+	// the last pair doesn't reduce to a small ratio, so it interpolates between stored phases
+	const vector<pair<size_t, size_t>> rates = { { 44100, 48000 }, { 48000, 44100 }, { 22050, 48000 }, { 48000, 8000 }, { 44100, 44101 } };
+
+	Buffer source( 5000, 2 );
+	fillRandom( &source );
+
+	for( auto type : POLYPHASE_TYPES ) {
+		for( const auto &rate : rates ) {
+			auto converter = dsp::Converter::create( rate.first, rate.second, 2, 2, 512, type );
+			auto expected = convertInBlocks( converter.get(), source, { 512 } );
+
+			// the output is as long as the source, in dest frames
+			REQUIRE( expected.getNumFrames() == (size_t)ceil( 5000.0 * rate.second / rate.first ) );
+
+			converter->clear();
+			auto result = convertInBlocks( converter.get(), source, { 1, 7, 64, 300, 512, 3 } );
+			REQUIRE( result.getNumFrames() == expected.getNumFrames() );
+			REQUIRE( maxError( result, expected ) == 0 );
+		}
+	}
+}
+
+SECTION( "polyphase reproduces a sine" )
+{
+	const float maxErrors[] = { 1e-2f, 1e-3f, 1e-4f };
+	for( size_t i = 0; i < 3; i++ ) {
+		auto converter = dsp::Converter::create( 44100, 48000, 1, 1, 512, POLYPHASE_TYPES[i] );
+		auto result = convertInBlocks( converter.get(), *makeSine( 44100, 1, 1000, 44100 ), { 512 } );
+		auto expected = makeSine( result.getNumFrames(), 1, 1000, 48000 );
+
+		// the edges are filtered against the silence before and after the source
+		REQUIRE( maxErrorInside( result, *expected, 100 ) < maxErrors[i] );
+	}
+}
+
+SECTION( "polyphase removes frequencies above the dest nyquist" )
+{
+	// 20 kHz would alias to 12 kHz at 32 kHz
+	const float maxRms[] = { 1e-2f, 1e-3f, 1e-4f };
+	for( size_t i = 0; i < 3; i++ ) {
+		auto converter = dsp::Converter::create( 48000, 32000, 1, 1, 512, POLYPHASE_TYPES[i] );
+		auto result = convertInBlocks( converter.get(), *makeSine( 48000, 1, 20000, 48000 ), { 512 } );
+
+		const size_t margin = 200;
+		float rms = dsp::rms( result.getData() + margin, result.getNumFrames() - 2 * margin );
+		REQUIRE( rms < maxRms[i] );
+	}
+}
+
+SECTION( "polyphase channel mixing" )
+{
+	Buffer mono( 3000 );
+	fillRandom( &mono );
+	Buffer stereo( 3000, 2 );
+	stereo.copyChannel( 0, mono.getData() );
+	stereo.copyChannel( 1, mono.getData() );
+
+	auto monoConverter = dsp::Converter::create( 44100, 48000, 1, 1, 256, dsp::ConverterType::POLYPHASE_MEDIUM );
+	auto expected = convertInBlocks( monoConverter.get(), mono, { 256 } );
+
+	auto upMixer = dsp::Converter::create( 44100, 48000, 1, 2, 256, dsp::ConverterType::POLYPHASE_MEDIUM );
+	auto upMixed = convertInBlocks( upMixer.get(), mono, { 256 } );
+	REQUIRE( upMixed.getNumFrames() == expected.getNumFrames() );
+	for( size_t ch = 0; ch < 2; ch++ ) {
+		for( size_t i = 0; i < expected.getNumFrames(); i++ )
+			REQUIRE( upMixed.getChannel( ch )[i] == expected[i] );
+	}
+
+	// down-mixing happens before resampling, the same way as mixBuffers()
+	Buffer mixed( 3000 );
+	dsp::mixBuffers( &stereo, &mixed );
+	monoConverter->clear();
+	auto expectedDownMixed = convertInBlocks( monoConverter.get(), mixed, { 256 } );
+
+	auto downMixer = dsp::Converter::create( 44100, 48000, 2, 1, 256, dsp::ConverterType::POLYPHASE_MEDIUM );
+	auto downMixed = convertInBlocks( downMixer.get(), stereo, { 256 } );
+	REQUIRE( downMixed.getNumFrames() == expectedDownMixed.getNumFrames() );
+	REQUIRE( maxError( downMixed, expectedDownMixed ) == 0 );
+}
+
+SECTION( "SourceFile::loadBuffer with a polyphase converter" )
+{
+	auto source = make_shared<SourceFileBuffer>( makeSine( 22050, 1, 440, 22050 ), 22050 );
+	source->setConverterType( dsp::ConverterType::POLYPHASE_HIGH );
+	auto resampled = source->cloneWithSampleRate( 48000 );
+	REQUIRE( resampled->getConverterType() == dsp::ConverterType::POLYPHASE_HIGH );
+	REQUIRE( resampled->getNumFrames() == 48000 );
+
+	// every frame is written, including the ones the converter holds back until the end
+	auto result = resampled->loadBuffer();
+	auto expected = makeSine( 48000, 1, 440, 48000 );
+	REQUIRE( maxErrorInside( *result, *expected, 100 ) < 1e-4f );
+	REQUIRE( fabs( result->getData()[47990] ) > 0.01f );
+}
+
+} // "audio/Converter"
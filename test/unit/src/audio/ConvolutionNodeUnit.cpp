@@ -0,0 +1,208 @@
+#include "catch.hpp"
+#include "utils.h"
+
+#include "cinder/audio/ContextOffline.h"
+#include "cinder/audio/ConvolutionNode.h"
+#include "cinder/audio/SamplePlayerNode.h"
+#include "cinder/audio/dsp/Dsp.h"
+#include "cinder/Rand.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace std;
+using namespace ci;
+using namespace ci::audio;
+
+namespace {
+
+const size_t SAMPLE_RATE = 48000;
+const size_t FRAMES_PER_BLOCK = 64;
+
+// Decaying noise, scaled so that convolving it with noise in [-0.5, 0.5] stays well clear of clipping.
+audio::BufferRef makeImpulseResponse( size_t numFrames, size_t numChannels, uint32_t seed )
+{
+	Rand rand( seed );
+	auto result = make_shared<audio::Buffer>( numFrames, numChannels );
+	const float scale = 1.0f / sqrtf( float( numFrames ) );
+	for( size_t ch = 0; ch < numChannels; ch++ ) {
+		for( size_t i = 0; i < numFrames; i++ )
+			result->getChannel( ch )[i] = rand.nextFloat( -1, 1 ) * scale * expf( -3.0f * i / numFrames );
+	}
+
+	return result;
+}
+
+audio::BufferRef makeNoise( size_t numFrames, size_t numChannels, uint32_t seed )
+{
+	Rand rand( seed );
+	auto result = make_shared<audio::Buffer>( numFrames, numChannels );
+	for( size_t i = 0; i < result->getSize(); i++ )
+		result->getData()[i] = rand.nextFloat( -0.5f, 0.5f );
+
+	return result;
+}
+
+// Direct convolution of one channel, truncated to the length of the input.
+vector<float> convolveDirect( const float *input, size_t numFrames, const float *impulseResponse, size_t impulseResponseFrames )
+{
+	vector<float> result( numFrames, 0 );
+	for( size_t i = 0; i < numFrames; i++ ) {
+		double sum = 0;
+		for( size_t k = 0; k < impulseResponseFrames && k <= i; k++ )
+			sum += double( input[i - k] ) * impulseResponse[k];
+		result[i] = float( sum );
+	}
+
+	return result;
+}
+
+struct ConvolutionFixture {
+	ConvolutionFixture( const audio::BufferRef &input )
+		: mContext( make_shared<ContextOffline>( SAMPLE_RATE, FRAMES_PER_BLOCK, input->getNumChannels() ) )
+	{
+		auto player = mContext->makeNode( new BufferPlayerNode( input ) );
+		mConvolution = mContext->makeNode( new ConvolutionNode );
+		player >> mConvolution >> mContext->getOutput();
+		player->start();
+		mContext->getOutputOffline()->setRecordingEnabled();
+		mContext->enable();
+	}
+
+	audio::BufferRef render( size_t numFrames )
+	{
+		mContext->getOutputOffline()->clearRecording();
+		mContext->render( numFrames );
+		return mContext->getOutputOffline()->getRecordedCopy();
+	}
+
+	shared_ptr<ContextOffline>	mContext;
+	ConvolutionNodeRef			mConvolution;
+};
+
+// Returns the largest difference between the rendered output and direct convolution of input with impulseResponse.
+float maxConvolutionError( const audio::Buffer &input, const audio::Buffer &impulseResponse, const audio::Buffer &output )
+{
+	float result = 0;
+	for( size_t ch = 0; ch < output.getNumChannels(); ch++ ) {
+		const size_t irChannel = min( ch, impulseResponse.getNumChannels() - 1 );
+		auto expected = convolveDirect( input.getChannel( ch ), output.getNumFrames(), impulseResponse.getChannel( irChannel ), impulseResponse.getNumFrames() );
+		for( size_t i = 0; i < output.getNumFrames(); i++ )
+			result = max( result, fabsf( output.getChannel( ch )[i] - expected[i] ) );
+	}
+
+	return result;
+}
+
+} // anonymous namespace
+
+TEST_CASE( "audio/ConvolutionNode" )
+{
+
+SECTION( "passes input through without an impulse response" )
+{
+	auto input = makeNoise( 1024, 1, 1 );
+	ConvolutionFixture fixture( input );
+	REQUIRE_FALSE( fixture.mConvolution->getImpulseResponse() );
+
+	auto output = fixture.render( 1024 );
+	for( size_t i = 0; i < 1024; i++ )
+		REQUIRE( output->getData()[i] == input->getData()[i] );
+}
+
+SECTION( "short impulse response matches direct convolution" )
+{
+	// shorter than the head, and not a multiple of the block size
+	auto input = makeNoise( 2048, 1, 2 );
+	auto impulseResponse = makeImpulseResponse( 300, 1, 3 );
+	ConvolutionFixture fixture( input );
+	fixture.mConvolution->setImpulseResponse( impulseResponse );
+
+	auto output = fixture.render( 2048 );
+	REQUIRE( maxConvolutionError( *input, *impulseResponse, *output ) < 1e-5f );
+}
+
+SECTION( "long impulse response matches direct convolution" )
+{
+	// covers the head and several tail partitions, over many tail periods
+	const size_t headFrames = FRAMES_PER_BLOCK * ConvolutionNode::TAIL_PARTITION_RATIO * 2;
+	const size_t numFrames = 16384;
+	auto input = makeNoise( numFrames, 2, 4 );
+	auto impulseResponse = makeImpulseResponse( headFrames + 5000, 2, 5 );
+	ConvolutionFixture fixture( input );
+	fixture.mConvolution->setImpulseResponse( impulseResponse );
+
+	auto output = fixture.render( numFrames );
+	REQUIRE( maxConvolutionError( *input, *impulseResponse, *output ) < 1e-4f );
+}
+
+SECTION( "mono impulse response is applied to every channel" )
+{
+	auto input = makeNoise( 4096, 2, 6 );
+	auto impulseResponse = makeImpulseResponse( 3000, 1, 7 );
+	ConvolutionFixture fixture( input );
+	fixture.mConvolution->setImpulseResponse( impulseResponse );
+
+	auto output = fixture.render( 4096 );
+	REQUIRE( maxConvolutionError( *input, *impulseResponse, *output ) < 1e-4f );
+}
+
+SECTION( "result is the same at every SimdLevel" )
+{
+	auto input = makeNoise( 8192, 1, 8 );
+	auto impulseResponse = makeImpulseResponse( 6000, 1, 9 );
+
+	const auto originalLevel = dsp::getSimdLevel();
+	for( auto level : { dsp::SimdLevel::SCALAR, dsp::SimdLevel::SSE2, dsp::SimdLevel::AVX2, dsp::SimdLevel::NEON } ) {
+		if( ! dsp::setSimdLevel( level ) )
+			continue;
+
+		ConvolutionFixture fixture( input );
+		fixture.mConvolution->setImpulseResponse( impulseResponse );
+		auto output = fixture.render( 8192 );
+		REQUIRE( maxConvolutionError( *input, *impulseResponse, *output ) < 1e-4f );
+	}
+	dsp::setSimdLevel( originalLevel );
+}
+
+SECTION( "loadImpulseResponse replaces the response without blocking" )
+{
+	auto input = makeNoise( 8192, 1, 10 );
+	auto first = makeImpulseResponse( 200, 1, 11 );
+	auto second = makeImpulseResponse( 4000, 1, 12 );
+	ConvolutionFixture fixture( input );
+	fixture.mConvolution->setImpulseResponse( first );
+	fixture.render( 1024 );
+
+	fixture.mConvolution->loadImpulseResponse( make_shared<SourceFileBuffer>( second, SAMPLE_RATE ) );
+	for( int i = 0; i < 1000 && fixture.mConvolution->isLoading(); i++ )
+		this_thread::sleep_for( chrono::milliseconds( 5 ) );
+
+	REQUIRE_FALSE( fixture.mConvolution->isLoading() );
+	REQUIRE( fixture.mConvolution->getImpulseResponse()->getNumFrames() == 4000 );
+
+	// the new response starts from a clean state, so the output is the convolution of the input that follows the swap
+	auto output = fixture.render( 4096 );
+	audio::Buffer remainingInput( 4096, 1 );
+	remainingInput.copyOffset( *input, 4096, 0, 1024 );
+	REQUIRE( maxConvolutionError( remainingInput, *second, *output ) < 1e-4f );
+}
+
+SECTION( "a response set after a load has started is kept" )
+{
+	auto input = makeNoise( 1024, 1, 13 );
+	auto loaded = makeImpulseResponse( 100, 1, 14 );
+	auto set = makeImpulseResponse( 50, 1, 15 );
+	ConvolutionFixture fixture( input );
+
+	fixture.mConvolution->loadImpulseResponse( make_shared<SourceFileBuffer>( loaded, SAMPLE_RATE ) );
+	fixture.mConvolution->setImpulseResponse( set );
+	for( int i = 0; i < 1000 && fixture.mConvolution->isLoading(); i++ )
+		this_thread::sleep_for( chrono::milliseconds( 5 ) );
+
+	REQUIRE( fixture.mConvolution->getImpulseResponse() == set );
+	auto output = fixture.render( 1024 );
+	REQUIRE( maxConvolutionError( *input, *set, *output ) < 1e-5f );
+}
+
+} // audio/ConvolutionNode
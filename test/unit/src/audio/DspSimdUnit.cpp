@@ -0,0 +1,267 @@
+#include "catch.hpp"
+
+#include "cinder/audio/dsp/Dsp.h"
+#include "cinder/audio/dsp/Converter.h"
+#include "cinder/Rand.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace std;
+using namespace ci;
+using namespace ci::audio;
+
+namespace {
+
+// Odd, so that every kernel finishes with a scalar tail.
+const size_t LENGTH = 1031;
+
+// Restores the SimdLevel that was current when it was constructed.
+struct ScopedSimdLevel {
+	ScopedSimdLevel() : mLevel( dsp::getSimdLevel() )	{}
+	~ScopedSimdLevel()									{ dsp::setSimdLevel( mLevel ); }
+
+	dsp::SimdLevel mLevel;
+};
+
+vector<dsp::SimdLevel> getSupportedSimdLevels()
+{
+	vector<dsp::SimdLevel> result;
+	for( auto level : { dsp::SimdLevel::SSE2, dsp::SimdLevel::AVX2, dsp::SimdLevel::NEON } ) {
+		if( dsp::isSimdLevelSupported( level ) )
+			result.push_back( level );
+	}
+
+	return result;
+}
+
+// Returns length random samples in [-amplitude, amplitude], with one extra leading sample so that the data can be read from a misaligned pointer.
+vector<float> makeSignal( size_t length, float amplitude, uint32_t seed )
+{
+	Rand rand( seed );
+	vector<float> result( length + 1 );
+	for( auto &sample : result )
+		sample = rand.nextFloat( -amplitude, amplitude );
+
+	return result;
+}
+
+// Runs fn with the scalar kernels and then with each supported SIMD level, requiring the results to be identical.
+template <typename FnT>
+void requireMatchesScalar( FnT fn )
+{
+	ScopedSimdLevel scopedLevel;
+
+	REQUIRE( dsp::setSimdLevel( dsp::SimdLevel::SCALAR ) );
+	const auto expected = fn();
+	for( auto level : getSupportedSimdLevels() ) {
+		INFO( "SimdLevel: " << int( level ) );
+		REQUIRE( dsp::setSimdLevel( level ) );
+		REQUIRE( fn() == expected );
+	}
+}
+
+} // anonymous namespace
+
+TEST_CASE( "audio/DspSimd" )
+{
+	const auto a = makeSignal( LENGTH, 1, 1 );
+	const auto b = makeSignal( LENGTH, 1, 2 );
+
+	SECTION( "levels" )
+	{
+		ScopedSimdLevel scopedLevel;
+
+		REQUIRE( dsp::isSimdLevelSupported( dsp::SimdLevel::SCALAR ) );
+		REQUIRE( dsp::setSimdLevel( dsp::SimdLevel::SCALAR ) );
+		REQUIRE( dsp::getSimdLevel() == dsp::SimdLevel::SCALAR );
+
+		for( auto level : { dsp::SimdLevel::SSE2, dsp::SimdLevel::AVX2, dsp::SimdLevel::NEON } ) {
+			REQUIRE( dsp::setSimdLevel( level ) == dsp::isSimdLevelSupported( level ) );
+			if( ! dsp::isSimdLevelSupported( level ) )
+				REQUIRE( dsp::getSimdLevel() != level );
+		}
+	}
+
+	SECTION( "arithmetic" )
+	{
+		// results are written to misaligned pointers as well as read from them
+		requireMatchesScalar( [&] {
+			vector<float> result( LENGTH * 8 + 1 );
+			float *out = result.data() + 1;
+			dsp::fill( 0.25f, out, LENGTH );
+			dsp::add( a.data() + 1, 0.5f, out + LENGTH, LENGTH );
+			dsp::add( a.data() + 1, b.data(), out + LENGTH * 2, LENGTH );
+			dsp::sub( a.data(), 0.5f, out + LENGTH * 3, LENGTH );
+			dsp::sub( a.data() + 1, b.data() + 1, out + LENGTH * 4, LENGTH );
+			dsp::mul( a.data(), b.data() + 1, out + LENGTH * 5, LENGTH );
+			dsp::addMul( a.data(), b.data(), 0.7f, out + LENGTH * 6, LENGTH );
+			dsp::mulAdd( a.data() + 1, 0.3f, b.data(), out + LENGTH * 7, LENGTH );
+			return result;
+		} );
+	}
+
+	SECTION( "in-place" )
+	{
+		requireMatchesScalar( [&] {
+			vector<float> result( a );
+			dsp::mul( result.data(), 2.0f, result.data(), LENGTH );
+			dsp::add( result.data(), b.data(), result.data(), LENGTH );
+			dsp::normalize( result.data(), LENGTH, 0.9f );
+			return result;
+		} );
+	}
+
+	SECTION( "complexMulAdd" )
+	{
+		// accumulates into the result, which starts out with a and b as its real and imaginary parts
+		requireMatchesScalar( [&] {
+			vector<float> result( a );
+			result.insert( result.end(), b.begin(), b.end() );
+			float *real = result.data() + 1;
+			float *imag = result.data() + LENGTH + 2;
+			dsp::complexMulAdd( a.data(), b.data(), b.data() + 1, a.data() + 1, real, imag, LENGTH );
+			return result;
+		} );
+
+		vector<float> real( 1, 1 ), imag( 1, 2 );
+		const float ar = 3, ai = 4, br = 5, bi = 6;
+		dsp::complexMulAdd( &ar, &ai, &br, &bi, real.data(), imag.data(), 1 );
+		REQUIRE( real[0] == 1 + 3 * 5 - 4 * 6 );
+		REQUIRE( imag[0] == 2 + 3 * 6 + 4 * 5 );
+	}
+
+	SECTION( "reductions" )
+	{
+		ScopedSimdLevel scopedLevel;
+
+		// SIMD reductions sum in a different order, so they only match approximately
+		for( size_t length : { size_t( 0 ), size_t( 3 ), size_t( 8 ), size_t( 24 ), LENGTH } ) {
+			dsp::setSimdLevel( dsp::SimdLevel::SCALAR );
+			const float expectedSum = dsp::sum( a.data() + 1, length );
+			const float expectedRms = length ? dsp::rms( a.data() + 1, length ) : 0;
+			const float expectedDot = dsp::dot( a.data() + 1, b.data(), length );
+			for( auto level : getSupportedSimdLevels() ) {
+				dsp::setSimdLevel( level );
+				REQUIRE( dsp::sum( a.data() + 1, length ) == Approx( expectedSum ).epsilon( 0.0001 ) );
+				REQUIRE( dsp::dot( a.data() + 1, b.data(), length ) == Approx( expectedDot ).epsilon( 0.0001 ) );
+				if( length )
+					REQUIRE( dsp::rms( a.data() + 1, length ) == Approx( expectedRms ).epsilon( 0.0001 ) );
+			}
+		}
+	}
+
+	SECTION( "int16 conversion" )
+	{
+		// out of range values are clamped
+		const auto loud = makeSignal( LENGTH, 1.5f, 3 );
+		requireMatchesScalar( [&] {
+			vector<int16_t> result( LENGTH );
+			dsp::convert( loud.data() + 1, result.data(), LENGTH );
+			return result;
+		} );
+
+		vector<int16_t> ints( LENGTH );
+		dsp::convert( loud.data() + 1, ints.data(), LENGTH );
+		for( size_t i = 0; i < LENGTH; i++ ) {
+			if( loud[i + 1] >= 1 )
+				REQUIRE( ints[i] == 32767 );
+			else if( loud[i + 1] <= -1 )
+				REQUIRE( ints[i] == -32768 );
+		}
+
+		requireMatchesScalar( [&] {
+			vector<float> result( LENGTH );
+			dsp::convert( ints.data(), result.data(), LENGTH );
+			return result;
+		} );
+	}
+
+	SECTION( "int24 conversion" )
+	{
+		vector<char> ints( LENGTH * 3 );
+		requireMatchesScalar( [&] {
+			dsp::convertFloatToInt24( a.data() + 1, ints.data(), LENGTH );
+			return ints;
+		} );
+
+		requireMatchesScalar( [&] {
+			vector<float> result( LENGTH );
+			dsp::convertInt24ToFloat( ints.data(), result.data(), LENGTH );
+			return result;
+		} );
+
+		vector<float> roundTrip( LENGTH );
+		dsp::convertInt24ToFloat( ints.data(), roundTrip.data(), LENGTH );
+		for( size_t i = 0; i < LENGTH; i++ )
+			REQUIRE( fabs( roundTrip[i] - a[i + 1] ) < 0.000001f );
+	}
+
+	SECTION( "interleave" )
+	{
+		for( size_t numChannels : { 1, 2, 3 } ) {
+			INFO( "numChannels: " << numChannels );
+			// frames per channel is larger than the number copied, to check that channels are found with numFramesPerChannel
+			const size_t numFramesPerChannel = LENGTH / numChannels;
+			const size_t numCopyFrames = numFramesPerChannel - 2;
+
+			requireMatchesScalar( [&] {
+				vector<float> result( numCopyFrames * numChannels );
+				dsp::interleave( a.data() + 1, result.data(), numFramesPerChannel, numChannels, numCopyFrames );
+				return result;
+			} );
+
+			requireMatchesScalar( [&] {
+				vector<float> result( numFramesPerChannel * numChannels );
+				dsp::deinterleave( a.data() + 1, result.data(), numFramesPerChannel, numChannels, numCopyFrames );
+				return result;
+			} );
+
+			vector<int16_t> ints( numCopyFrames * numChannels );
+			requireMatchesScalar( [&] {
+				dsp::interleave( a.data() + 1, ints.data(), numFramesPerChannel, numChannels, numCopyFrames );
+				return ints;
+			} );
+
+			requireMatchesScalar( [&] {
+				vector<float> result( numFramesPerChannel * numChannels );
+				dsp::deinterleave( ints.data(), result.data(), numFramesPerChannel, numChannels, numCopyFrames );
+				return result;
+			} );
+
+			// the double versions are always scalar
+			vector<double> doubles( a.begin() + 1, a.end() );
+			vector<int16_t> expectedInts( numCopyFrames * numChannels );
+			dsp::interleave( doubles.data(), expectedInts.data(), numFramesPerChannel, numChannels, numCopyFrames );
+			REQUIRE( ints == expectedInts );
+
+			vector<float> interleaved( numCopyFrames * numChannels ), deinterleaved( numFramesPerChannel * numChannels );
+			dsp::interleave( a.data() + 1, interleaved.data(), numFramesPerChannel, numChannels, numCopyFrames );
+			dsp::deinterleave( interleaved.data(), deinterleaved.data(), numFramesPerChannel, numChannels, numCopyFrames );
+			for( size_t ch = 0; ch < numChannels; ch++ ) {
+				for( size_t i = 0; i < numCopyFrames; i++ )
+					REQUIRE( deinterleaved[ch * numFramesPerChannel + i] == a[1 + ch * numFramesPerChannel + i] );
+			}
+		}
+	}
+
+	SECTION( "deinterleaveInt24ToFloat" )
+	{
+		for( size_t numChannels : { 1, 2 } ) {
+			const size_t numFrames = LENGTH / numChannels;
+			vector<float> interleaved( numFrames * numChannels );
+			dsp::interleave( a.data() + 1, interleaved.data(), numFrames, numChannels, numFrames );
+			vector<char> ints( interleaved.size() * 3 );
+			dsp::convertFloatToInt24( interleaved.data(), ints.data(), interleaved.size() );
+
+			vector<float> result( numFrames * numChannels );
+			requireMatchesScalar( [&] {
+				dsp::deinterleaveInt24ToFloat( ints.data(), result.data(), numFrames, numChannels, numFrames );
+				return result;
+			} );
+
+			for( size_t i = 0; i < result.size(); i++ )
+				REQUIRE( fabs( result[i] - a[i + 1] ) < 0.000001f );
+		}
+	}
+}
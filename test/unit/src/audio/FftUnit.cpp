@@ -1,14 +1,12 @@
-#include "cinder/Cinder.h"
-
-// FIXME: OOURA roundtrip FFT seems to be broken on windows for sizeFft = 4 (https://github.com/cinder/Cinder/issues/1263)
-#if defined( CINDER_MAC )
-
 #include "catch.hpp"
 #include "utils.h"
 
 #include "cinder/Log.h"
 #include "cinder/audio/dsp/Fft.h"
+#include "cinder/audio/dsp/Dsp.h"
+#include "cinder/ThreadPool.h"
 
+#include <cstring>
 #include <iostream>
 
 using namespace ci::audio;
@@ -43,6 +41,23 @@ void computeRoundTrip( size_t sizeFft )
 	REQUIRE( maxErr < ACCEPTABLE_FLOAT_ERROR );
 }
 
+// Transforms each frame of signal with forward( const Buffer *, BufferSpectral * ), writing the results contiguously like the batched forward() does.
+std::vector<float> computeFramesSeparately( size_t sizeFft, const Buffer &signal, size_t hop, size_t count, const Buffer &window )
+{
+	dsp::Fft fft( sizeFft );
+	Buffer frame( sizeFft );
+	BufferSpectral spectral( sizeFft );
+
+	std::vector<float> result( count * sizeFft );
+	for( size_t i = 0; i < count; i++ ) {
+		dsp::mul( signal.getData() + i * hop, window.getData(), frame.getData(), sizeFft );
+		fft.forward( &frame, &spectral );
+		memcpy( result.data() + i * sizeFft, spectral.getData(), sizeFft * sizeof( float ) );
+	}
+
+	return result;
+}
+
 }
 
 TEST_CASE( "audio/Fft" )
@@ -55,6 +70,49 @@ SECTION( "round trip error" )
 		computeRoundTrip( 2 << i );
 }
 
-} // "audio/Fft"
+SECTION( "batched forward matches per frame forward" )
+{
+	for( size_t sizeFft : { 2, 16, 512, 2048 } ) {
+		const size_t hop = std::max<size_t>( 1, sizeFft / 4 );
+		const size_t count = 37;
+		Buffer signal( hop * ( count - 1 ) + sizeFft );
+		fillRandom( &signal );
+		Buffer window( sizeFft );
+		dsp::generateWindow( dsp::WindowType::HANN, window.getData(), sizeFft );
+
+		auto expected = computeFramesSeparately( sizeFft, signal, hop, count, window );
+
+		dsp::Fft fft( sizeFft );
+		std::vector<float> spectrogram( count * sizeFft );
+		fft.forward( signal.getData(), hop, count, spectrogram.data(), window.getData() );
+		REQUIRE( spectrogram == expected );
+
+		// frames are transformed independently, so splitting them across threads gives identical results
+		std::vector<float> spectrogramThreaded( count * sizeFft );
+		ci::ThreadPool threadPool( 3 );
+		fft.forward( signal.getData(), hop, count, spectrogramThreaded.data(), window.getData(), &threadPool );
+		REQUIRE( spectrogramThreaded == expected );
+	}
+}
+
+SECTION( "plan cache" )
+{
+	// Fft's of the same size share tables, which must outlive the cache
+	auto first = std::make_shared<dsp::Fft>( 1024 );
+	dsp::Fft::clearPlanCache();
+	dsp::Fft second( 1024 );
 
-#endif // ! defined( CINDER_MSW )
+	Buffer waveform( 1024 );
+	fillRandom( &waveform );
+	BufferSpectral spectralFirst( 1024 ), spectralSecond( 1024 );
+	first->forward( &waveform, &spectralFirst );
+	second.forward( &waveform, &spectralSecond );
+	REQUIRE( maxError( spectralFirst, spectralSecond ) == 0 );
+
+	first.reset();
+	Buffer waveformCopy( 1024 );
+	second.inverse( &spectralSecond, &waveformCopy );
+	REQUIRE( maxError( waveform, waveformCopy ) < ACCEPTABLE_FLOAT_ERROR );
+}
+
+} // "audio/Fft"
@@ -0,0 +1,170 @@
+#include "catch.hpp"
+
+#include "cinder/audio/StreamScheduler.h"
+
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace ci;
+using namespace ci::audio;
+
+namespace {
+
+// Polls pred until it returns true or a generous timeout expires, returning the last result.
+template <typename PredT>
+bool waitFor( PredT pred )
+{
+	auto timeout = chrono::steady_clock::now() + chrono::seconds( 5 );
+	while( ! pred() && chrono::steady_clock::now() < timeout )
+		this_thread::sleep_for( chrono::milliseconds( 1 ) );
+
+	return pred();
+}
+
+StreamScheduler::Clock::time_point inMilliseconds( int ms )
+{
+	return StreamScheduler::Clock::now() + chrono::milliseconds( ms );
+}
+
+// Occupies the worker of a single threaded StreamScheduler until release() is called, so that requests queue up behind it.
+struct BlockingStream {
+	BlockingStream( StreamScheduler &scheduler )
+		: mScheduler( scheduler ), mStarted( false ), mIsReleased( false ), mReleased( mReleasePromise.get_future().share() )
+	{
+		mStream = scheduler.addStream( [this] {
+			mStarted = true;
+			mReleased.wait();
+		} );
+
+		mStream->requestRead( inMilliseconds( 0 ) );
+		REQUIRE( waitFor( [this] { return mStarted.load(); } ) );
+	}
+
+	~BlockingStream()
+	{
+		// avoid hanging in removeStream() if a REQUIRE failed before release() was called
+		if( ! mIsReleased )
+			release();
+
+		mScheduler.removeStream( mStream );
+	}
+
+	void release()
+	{
+		mIsReleased = true;
+		mReleasePromise.set_value();
+	}
+
+	StreamScheduler&			mScheduler;
+	StreamScheduler::StreamRef	mStream;
+	atomic<bool>				mStarted;
+	bool						mIsReleased;
+	promise<void>				mReleasePromise;
+	shared_future<void>			mReleased;
+};
+
+} // anonymous namespace
+
+TEST_CASE( "audio/StreamScheduler" )
+{
+
+SECTION( "requested streams are read" )
+{
+	StreamScheduler scheduler( 2 );
+	REQUIRE( scheduler.getNumThreads() == 2 );
+
+	atomic<int> numReads0( 0 ), numReads1( 0 );
+	auto stream0 = scheduler.addStream( [&] { numReads0++; } );
+	auto stream1 = scheduler.addStream( [&] { numReads1++; } );
+	REQUIRE( scheduler.getNumStreams() == 2 );
+
+	stream0->requestRead( inMilliseconds( 10 ) );
+	REQUIRE( waitFor( [&] { return numReads0 == 1; } ) );
+	REQUIRE( numReads1 == 0 );
+
+	stream1->requestRead( inMilliseconds( 10 ) );
+	REQUIRE( waitFor( [&] { return numReads1 == 1; } ) );
+
+	stream0->requestRead( inMilliseconds( 10 ) );
+	REQUIRE( waitFor( [&] { return numReads0 == 2; } ) );
+
+	scheduler.removeStream( stream0 );
+	scheduler.removeStream( stream1 );
+	REQUIRE( scheduler.getNumStreams() == 0 );
+}
+
+SECTION( "pending requests are coalesced" )
+{
+	StreamScheduler scheduler( 1 );
+	BlockingStream blocker( scheduler );
+
+	atomic<int> numReads( 0 );
+	auto stream = scheduler.addStream( [&] { numReads++; } );
+	for( int i = 0; i < 10; i++ )
+		stream->requestRead( inMilliseconds( 100 - i ) );
+
+	blocker.release();
+	REQUIRE( waitFor( [&] { return numReads == 1; } ) );
+	this_thread::sleep_for( chrono::milliseconds( 20 ) );
+	REQUIRE( numReads == 1 );
+
+	scheduler.removeStream( stream );
+}
+
+SECTION( "earliest deadline is read first" )
+{
+	StreamScheduler scheduler( 1 );
+	BlockingStream blocker( scheduler );
+
+	mutex orderMutex;
+	string order;
+	auto appendFn = [&]( char c ) {
+		return [&, c] {
+			lock_guard<mutex> lock( orderMutex );
+			order += c;
+		};
+	};
+
+	auto streamA = scheduler.addStream( appendFn( 'A' ) );
+	auto streamB = scheduler.addStream( appendFn( 'B' ) );
+	auto streamC = scheduler.addStream( appendFn( 'C' ) );
+
+	streamA->requestRead( inMilliseconds( 100 ) );
+	streamB->requestRead( inMilliseconds( 200 ) );
+	streamC->requestRead( inMilliseconds( 50 ) );
+	// a later request with an earlier deadline moves B ahead
+	streamB->requestRead( inMilliseconds( 10 ) );
+
+	blocker.release();
+	REQUIRE( waitFor( [&] { lock_guard<mutex> lock( orderMutex ); return order.size() == 3; } ) );
+	REQUIRE( order == "BCA" );
+
+	scheduler.removeStream( streamA );
+	scheduler.removeStream( streamB );
+	scheduler.removeStream( streamC );
+}
+
+SECTION( "removeStream waits for an in-progress read" )
+{
+	StreamScheduler scheduler( 1 );
+
+	atomic<bool> started( false ), finished( false );
+	auto stream = scheduler.addStream( [&] {
+		started = true;
+		this_thread::sleep_for( chrono::milliseconds( 50 ) );
+		finished = true;
+	} );
+
+	stream->requestRead( inMilliseconds( 0 ) );
+	REQUIRE( waitFor( [&] { return started.load(); } ) );
+
+	scheduler.removeStream( stream );
+	REQUIRE( finished );
+	REQUIRE( scheduler.getNumStreams() == 0 );
+}
+
+} // audio/StreamScheduler
@@ -0,0 +1,207 @@
+#include "catch.hpp"
+#include "utils.h"
+
+#include "cinder/audio/ContextOffline.h"
+#include "cinder/audio/Voice.h"
+#include "cinder/audio/VoicePoolNode.h"
+
+#include <cmath>
+
+using namespace std;
+using namespace ci;
+using namespace ci::audio;
+
+namespace {
+
+const size_t SAMPLE_RATE = 48000;
+const size_t FRAMES_PER_BLOCK = 64;
+
+// mono Buffer holding 0.001, 0.002, ...
+audio::BufferRef makeRamp( size_t numFrames )
+{
+	auto result = make_shared<audio::Buffer>( numFrames, 1 );
+	for( size_t i = 0; i < numFrames; i++ )
+		result->getData()[i] = ( i + 1 ) * 0.001f;
+
+	return result;
+}
+
+struct PoolFixture {
+	PoolFixture( size_t numVoices )
+		: mContext( make_shared<ContextOffline>( SAMPLE_RATE, FRAMES_PER_BLOCK, 2 ) )
+	{
+		mPool = mContext->makeNode( new VoicePoolNode( numVoices ) );
+		mPool >> mContext->getOutput();
+		mContext->getOutputOffline()->setRecordingEnabled();
+		mContext->enable();
+	}
+
+	audio::BufferRef render( size_t numFrames )
+	{
+		mContext->getOutputOffline()->clearRecording();
+		mContext->render( numFrames );
+		return mContext->getOutputOffline()->getRecordedCopy();
+	}
+
+	shared_ptr<ContextOffline>	mContext;
+	VoicePoolNodeRef			mPool;
+};
+
+} // anonymous namespace
+
+TEST_CASE( "audio/VoicePoolNode" )
+{
+
+SECTION( "mono voice is panned with equal power" )
+{
+	PoolFixture fixture( 4 );
+	REQUIRE( fixture.mPool->getNumVoices() == 4 );
+	REQUIRE( fixture.mPool->getNumChannels() == 2 );
+
+	auto ramp = makeRamp( 100 );
+	auto id = fixture.mPool->play( ramp, 0.5f );
+	REQUIRE( fixture.mPool->isPlaying( id ) );
+	REQUIRE( fixture.mPool->getNumPlayingVoices() == 1 );
+
+	auto recorded = fixture.render( 256 );
+	const float centerGain = 0.5f * cos( float( M_PI / 4 ) );
+	for( size_t i = 0; i < 100; i++ ) {
+		REQUIRE( recorded->getChannel( 0 )[i] == Approx( ramp->getData()[i] * centerGain ) );
+		REQUIRE( recorded->getChannel( 1 )[i] == Approx( ramp->getData()[i] * centerGain ) );
+	}
+	for( size_t i = 100; i < 256; i++ )
+		REQUIRE( recorded->getChannel( 0 )[i] == 0 );
+
+	// the voice finished at the end of the Buffer
+	REQUIRE_FALSE( fixture.mPool->isPlaying( id ) );
+	REQUIRE( fixture.mPool->getNumPlayingVoices() == 0 );
+}
+
+SECTION( "stereo voice is balanced" )
+{
+	PoolFixture fixture( 1 );
+	auto stereo = make_shared<audio::Buffer>( 16, 2 );
+	stereo->getChannel( 0 )[0] = 0.25f;
+	stereo->getChannel( 1 )[0] = 0.5f;
+
+	fixture.mPool->play( stereo, 1, 0.75f );
+	auto recorded = fixture.render( FRAMES_PER_BLOCK );
+	REQUIRE( recorded->getChannel( 0 )[0] == Approx( 0.125f ) );
+	REQUIRE( recorded->getChannel( 1 )[0] == Approx( 0.5f ) );
+}
+
+SECTION( "play is sample accurate" )
+{
+	PoolFixture fixture( 2 );
+	fixture.render( FRAMES_PER_BLOCK );
+
+	// starts in the middle of the third block
+	const uint64_t startFrame = 2 * FRAMES_PER_BLOCK + 10;
+	fixture.mPool->play( makeRamp( 20 ), 1, 0, 1, double( startFrame ) / SAMPLE_RATE );
+
+	auto recorded = fixture.render( 3 * FRAMES_PER_BLOCK );
+	const float *left = recorded->getChannel( 0 );
+	const size_t offset = startFrame - FRAMES_PER_BLOCK;
+	for( size_t i = 0; i < offset; i++ )
+		REQUIRE( left[i] == 0 );
+
+	REQUIRE( left[offset] == Approx( 0.001f ) );
+	REQUIRE( left[offset + 19] == Approx( 0.020f ) );
+	REQUIRE( left[offset + 20] == 0 );
+	// panned hard left
+	REQUIRE( fabs( recorded->getChannel( 1 )[offset] ) < 1e-6f );
+}
+
+SECTION( "pitch resamples the Buffer" )
+{
+	PoolFixture fixture( 1 );
+	fixture.mPool->play( makeRamp( 100 ), 1, 0, 2 );
+
+	auto recorded = fixture.render( FRAMES_PER_BLOCK );
+	const float *left = recorded->getChannel( 0 );
+	for( size_t i = 0; i < 50; i++ )
+		REQUIRE( left[i] == Approx( ( 2 * i + 1 ) * 0.001f ) );
+	for( size_t i = 50; i < FRAMES_PER_BLOCK; i++ )
+		REQUIRE( left[i] == 0 );
+
+	fixture.mPool->play( makeRamp( 4 ), 1, 0, 0.5f );
+	recorded = fixture.render( FRAMES_PER_BLOCK );
+	left = recorded->getChannel( 0 );
+	REQUIRE( left[0] == Approx( 0.001f ) );
+	REQUIRE( left[1] == Approx( 0.0015f ) );
+	REQUIRE( left[2] == Approx( 0.002f ) );
+}
+
+SECTION( "oldest voice is stolen" )
+{
+	PoolFixture fixture( 2 );
+	auto ramp = makeRamp( 10000 );
+
+	auto first = fixture.mPool->play( ramp );
+	auto second = fixture.mPool->play( ramp );
+	REQUIRE( fixture.mPool->getNumStolenVoices() == 0 );
+
+	auto third = fixture.mPool->play( ramp );
+	REQUIRE( fixture.mPool->getNumStolenVoices() == 1 );
+	REQUIRE( first != third );
+	REQUIRE_FALSE( fixture.mPool->isPlaying( first ) );
+	REQUIRE( fixture.mPool->isPlaying( second ) );
+	REQUIRE( fixture.mPool->isPlaying( third ) );
+	REQUIRE( fixture.mPool->getNumPlayingVoices() == 2 );
+
+	// controls for a stolen sound are ignored
+	fixture.mPool->stop( first );
+	fixture.render( FRAMES_PER_BLOCK );
+	REQUIRE( fixture.mPool->isPlaying( third ) );
+}
+
+SECTION( "stop" )
+{
+	PoolFixture fixture( 4 );
+	auto ramp = makeRamp( 10000 );
+	auto a = fixture.mPool->play( ramp );
+	auto b = fixture.mPool->play( ramp );
+	fixture.render( FRAMES_PER_BLOCK );
+
+	// stopping takes effect at the next block
+	fixture.mPool->stop( a );
+	fixture.render( FRAMES_PER_BLOCK );
+	REQUIRE_FALSE( fixture.mPool->isPlaying( a ) );
+	REQUIRE( fixture.mPool->isPlaying( b ) );
+
+	fixture.mPool->stopAll();
+	auto recorded = fixture.render( FRAMES_PER_BLOCK );
+	REQUIRE( fixture.mPool->getNumPlayingVoices() == 0 );
+	REQUIRE( recorded->getChannel( 0 )[0] == 0 );
+}
+
+SECTION( "SourceFiles are loaded once per samplerate" )
+{
+	PoolFixture fixture( 2 );
+	auto source = make_shared<SourceFileBuffer>( makeRamp( 1000 ), 44100 );
+	// the default converter holds back more frames than this short file has
+	source->setConverterType( dsp::ConverterType::POLYPHASE_HIGH );
+	fixture.mPool->play( source );
+	fixture.mPool->play( source );
+	auto recorded = fixture.render( 4 * FRAMES_PER_BLOCK );
+	REQUIRE( fixture.mPool->getNumPlayingVoices() == 2 );
+	float peak = 0;
+	for( size_t i = 0; i < recorded->getNumFrames(); i++ )
+		peak = max( peak, recorded->getChannel( 0 )[i] );
+	REQUIRE( peak > 0.1f );
+
+	// play() resamples to the Context's samplerate, but the cache holds on to the SourceFile that was passed in
+	auto resampled = Voice::loadBuffer( source, SAMPLE_RATE );
+	REQUIRE( Voice::loadBuffer( source, SAMPLE_RATE ) == resampled );
+	REQUIRE( resampled->getNumFrames() > 1000 );
+
+	auto native = Voice::loadBuffer( source );
+	REQUIRE( native != resampled );
+	REQUIRE( native->getNumFrames() == 1000 );
+
+	Voice::clearBufferCache();
+	REQUIRE( Voice::loadBuffer( source, SAMPLE_RATE ) != resampled );
+	Voice::clearBufferCache();
+}
+
+} // audio/VoicePoolNode
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "cinder/audio/Buffer.h"
+#include "cinder/audio/Source.h"
 #include "cinder/CinderAssert.h"
 #include "cinder/Rand.h"
 
@@ -21,4 +22,41 @@ inline float maxError( const ci::audio::Buffer &a, const ci::audio::Buffer &b )
 		error = std::max( error, std::fabs( a[i] - b[i]) );
 
 	return error;
-}
\ No newline at end of file
+}
+
+// A SourceFile that reads from a Buffer, pretending that it was recorded at nativeSampleRate, so that loading and resampling
+// can be tested without decoding a file. A sampleRate of 0 reads at nativeSampleRate.
+class SourceFileBuffer : public ci::audio::SourceFile {
+  public:
+	SourceFileBuffer( const ci::audio::BufferRef &buffer, size_t nativeSampleRate, size_t sampleRate = 0 )
+		: SourceFile( sampleRate ? sampleRate : nativeSampleRate ), mBuffer( buffer ), mNativeSampleRate( nativeSampleRate ), mFileReadPos( 0 )
+	{
+		mNumFrames = mFileNumFrames = buffer->getNumFrames();
+	}
+
+	size_t						getNumChannels() const override				{ return mBuffer->getNumChannels(); }
+	size_t						getSampleRateNative() const override		{ return mNativeSampleRate; }
+	ci::audio::SourceFileRef	cloneWithSampleRate( size_t sampleRate ) const override
+	{
+		auto result = std::make_shared<SourceFileBuffer>( mBuffer, mNativeSampleRate, sampleRate );
+		result->setConverterType( mConverterType );
+		result->setupSampleRateConversion();
+		return result;
+	}
+
+  protected:
+	size_t performRead( ci::audio::Buffer *buffer, size_t bufferFrameOffset, size_t numFramesNeeded ) override
+	{
+		buffer->copyOffset( *mBuffer, numFramesNeeded, bufferFrameOffset, mFileReadPos );
+		mFileReadPos += numFramesNeeded;
+		return numFramesNeeded;
+	}
+
+	void performSeek( size_t readPositionFrames ) override
+	{
+		mFileReadPos = readPositionFrames;
+	}
+
+	ci::audio::BufferRef	mBuffer;
+	size_t					mNativeSampleRate, mFileReadPos;
+};